@@ -878,6 +878,10 @@ CCostModelGPDB::CostHashJoin
 	CColRefSet *pcrsUsed = CDrvdPropScalar::Pdpscalar(pexprJoinCond->PdpDerive())->PcrsUsed();
 	const ULONG ulColsUsed = pcrsUsed->CElements();
 
+	// a runtime filter drops outer tuples without a match before they reach the join;
+	// hash keys of all outer tuples are still computed to probe the filter
+	const DOUBLE dRowsOuterFed = dRowsOuter * pci->DRuntimeFilterSelectivity();
+
 	// TODO 2014-03-14
 	// currently, we hard coded a spilling memory threshold for judging whether hash join spills or not
 	// In the future, we should calculate it based on the number of memory-intensive operators and statement memory available
@@ -902,7 +906,7 @@ CCostModelGPDB::CostHashJoin
 			+
 			// cost of feeding outer tuples
 			ulColsUsed * dRowsOuter * dJoinFeedingTupColumnCostUnit
-				+ dWidthOuter * dRowsOuter * dJoinFeedingTupWidthCostUnit
+				+ dWidthOuter * dRowsOuterFed * dJoinFeedingTupWidthCostUnit
 			+
 			// cost of matching inner tuples
 			dWidthInner * dRowsInner * dHJHashingTupWidthCostUnit
@@ -924,7 +928,7 @@ CCostModelGPDB::CostHashJoin
 				dWidthInner * dHJHashTableWidthCostUnit)
 			+
 			ulColsUsed * dRowsOuter * dHJFeedingTupColumnSpillingCostUnit
-				+ dWidthOuter * dRowsOuter * dHJFeedingTupWidthSpillingCostUnit
+				+ dWidthOuter * dRowsOuterFed * dHJFeedingTupWidthSpillingCostUnit
 			+
 			dWidthInner * dRowsInner * dHJHashingTupWidthSpillingCostUnit
 			+
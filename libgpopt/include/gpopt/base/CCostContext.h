@@ -101,9 +101,17 @@ namespace gpopt
 			// stats of owner group expression
 			IStatistics *m_pstats;
 
+			// selectivity of a runtime filter applied to the outer child,
+			// 1.0 if no runtime filter is planned
+			CDouble m_dRuntimeFilterSelectivity;
+
 			// derive stats of owner group expression
 			void DeriveStats();
 
+			// check if the best plan of the outer child is a motion, possibly
+			// below a chain of compute scalar and filter operators
+			BOOL FOuterChildMotion() const;
+
 			// return the number of rows per host
 			CDouble DRowsPerHost() const;
 
@@ -192,6 +200,12 @@ namespace gpopt
 				return m_pstats;
 			}
 
+			// runtime filter selectivity decided when computing cost
+			CDouble DRuntimeFilterSelectivity() const
+			{
+				return m_dRuntimeFilterSelectivity;
+			}
+
 			// check if we need to derive stats for this context
 			BOOL FNeedsNewStats() const;
 
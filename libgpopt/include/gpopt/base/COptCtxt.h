@@ -20,6 +20,8 @@
 #include "gpopt/base/IComparator.h"
 #include "gpopt/mdcache/CMDAccessor.h"
 
+#include "naucrates/statistics/CStatsFilterCache.h"
+
 namespace gpopt
 {
 	using namespace gpos;
@@ -79,6 +81,9 @@ namespace gpopt
 			// whether or not we are optimizing a DML query
 			BOOL m_fDMLQuery;
 
+			// statistics derived for filters
+			CStatsFilterCache *m_pstatsfcache;
+
 			// value for the first valid part id
 			static
 			ULONG m_ulFirstValidPartId;
@@ -162,6 +167,12 @@ namespace gpopt
 				return m_pcteinfo;
 			}
 
+			// filter statistics cache
+			CStatsFilterCache *Pstatsfcache() const
+			{
+				return m_pstatsfcache;
+			}
+
 			// return a new part index id
 			ULONG UlPartIndexNextVal()
 			{
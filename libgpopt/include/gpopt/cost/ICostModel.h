@@ -144,6 +144,10 @@ namespace gpopt
 					// computed cost of child operators
 					DOUBLE *m_pdCostChildren;
 
+					// selectivity of a runtime filter applied to the outer child of root,
+					// 1.0 if no runtime filter is planned
+					DOUBLE m_dRuntimeFilterSelectivity;
+
 				public:
 
 					// ctor
@@ -168,7 +172,8 @@ namespace gpopt
 						m_pdRowsChildren(pdRowsChildren),
 						m_pdWidthChildren(pdWidthChildren),
 						m_pdRebindsChildren(pdRebindsChildren),
-						m_pdCostChildren(pdCostChildren)
+						m_pdCostChildren(pdCostChildren),
+						m_dRuntimeFilterSelectivity(1.0)
 					{
 						GPOS_ASSERT(NULL != pcstats);
 					};
@@ -189,7 +194,8 @@ namespace gpopt
 						m_pdRowsChildren(NULL),
 						m_pdWidthChildren(NULL),
 						m_pdRebindsChildren(NULL),
-						m_pdCostChildren(NULL)
+						m_pdCostChildren(NULL),
+						m_dRuntimeFilterSelectivity(1.0)
 					{
 						GPOS_ASSERT(NULL != pcstats);
 						if (0 < ulChildren)
@@ -268,6 +274,23 @@ namespace gpopt
 						m_dRebinds = dRebinds;
 					}
 
+					// runtime filter selectivity accessor
+					DOUBLE DRuntimeFilterSelectivity() const
+					{
+						return m_dRuntimeFilterSelectivity;
+					}
+
+					// runtime filter selectivity setter
+					void SetRuntimeFilterSelectivity
+						(
+						DOUBLE dRuntimeFilterSelectivity
+						)
+					{
+						GPOS_ASSERT(0 <= dRuntimeFilterSelectivity && 1.0 >= dRuntimeFilterSelectivity);
+
+						m_dRuntimeFilterSelectivity = dRuntimeFilterSelectivity;
+					}
+
 					// children rows accessor
 					DOUBLE *PdRows() const
 					{
@@ -15,6 +15,8 @@
 #include "gpos/sync/CMutex.h"
 
 #include "gpopt/xforms/CXform.h"
+#include "gpopt/xforms/CXformProfile.h"
+#include "gpopt/xforms/CXformUtility.h"
 #include "gpopt/search/CMemo.h"
 #include "gpopt/search/CSearchStage.h"
 
@@ -77,9 +79,21 @@ namespace gpopt
 			// time consumed by each xform
 			DrgPulp *m_pdrgpulpXformTimes;
 
+			// number of times each xform was applied to a group expression
+			DrgPulp *m_pdrgpulpXformAttempts;
+
+			// number of times each xform was skipped since its pattern cannot be bound
+			DrgPulp *m_pdrgpulpXformPruned;
+
 			// mutex for locking shared data structures when updating optimization statistics
 			CMutex m_mutexOptStats;
 
+			// per-xform profile of current optimization
+			CXformProfile *m_pxfprof;
+
+			// query class used for maintaining xform utility statistics
+			CXformUtility::EQueryClass m_eqc;
+
 #ifdef GPOS_DEBUG
 
 			// a set of internal debugging function used for recursive
@@ -258,6 +272,13 @@ namespace gpopt
 				return m_pmemo->PgroupRoot();
 			}
 
+			// xform profile of the current optimization, NULL unless xforms
+			// are profiled
+			const CXformProfile *Pxfprof() const
+			{
+				return m_pxfprof;
+			}
+
 			// check if a group is the root one
 			BOOL FRoot(CGroup *pgroup) const
 			{
@@ -281,7 +302,16 @@ namespace gpopt
 				CXformResult *pxfres,
 				CXform::EXformId exfidOrigin,
 				CGroupExpression *pgexprOrigin,
-				ULONG ulXformTime
+				ULONG ulXformTime,
+				ULONG ulNumberOfBindings
+				);
+
+			// compute the xforms to apply to a group expression in current stage
+			CXformSet *PxfsApplicable
+				(
+				IMemoryPool *pmp,
+				CGroupExpression *pgexpr,
+				CXformSet *pxfsRequired
 				);
 
 			// add enforcers to the memo
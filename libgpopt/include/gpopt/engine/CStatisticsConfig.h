@@ -50,6 +50,13 @@ namespace gpopt
 			// damping factor for group by
 			CDouble m_dDampingFactorGroupBy;
 
+			// number of column histograms from which an operator derives
+			// histograms on the worker pool
+			ULONG m_ulParallelHistogramsThreshold;
+
+			// maximum number of buckets of a derived histogram
+			ULONG m_ulMaxHistogramBuckets;
+
 			// hash set of md ids for columns with missing statistics
 			HSMDId *m_phsmdidcolinfo;
 
@@ -58,13 +65,23 @@ namespace gpopt
 
 		public:
 
+			// default number of column histograms from which histograms are derived in parallel
+			static
+			const ULONG ulParallelHistogramsThresholdDefault;
+
+			// default maximum number of buckets of a derived histogram
+			static
+			const ULONG ulMaxHistogramBucketsDefault;
+
 			// ctor
 			CStatisticsConfig
 				(
 				IMemoryPool *pmp,
 				CDouble dDampingFactorFilter,
 				CDouble dDampingFactorJoin,
-				CDouble dDampingFactorGroupBy
+				CDouble dDampingFactorGroupBy,
+				ULONG ulParallelHistogramsThreshold = ulParallelHistogramsThresholdDefault,
+				ULONG ulMaxHistogramBuckets = ulMaxHistogramBucketsDefault
 				);
 
 			// dtor
@@ -88,6 +105,18 @@ namespace gpopt
 				return m_dDampingFactorGroupBy;
 			}
 
+			// number of column histograms from which histograms are derived in parallel
+			ULONG UlParallelHistogramsThreshold() const
+			{
+				return m_ulParallelHistogramsThreshold;
+			}
+
+			// maximum number of buckets of a derived histogram
+			ULONG UlMaxHistogramBuckets() const
+			{
+				return m_ulMaxHistogramBuckets;
+			}
+
 			// add the information about the column with the missing statistics
 			void AddMissingStatsColumn(CMDIdColStats *pmdidCol);
 
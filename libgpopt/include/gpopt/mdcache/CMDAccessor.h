@@ -29,6 +29,7 @@
 #include "naucrates/md/IMDFunction.h"
 #include "naucrates/md/CSystemId.h"
 #include "naucrates/statistics/IStatistics.h"
+#include "naucrates/statistics/CHLLSketch.h"
 
 // fwd declarations
 namespace gpdxl
@@ -224,6 +225,18 @@ namespace gpopt
 			// interface to a MD cache object
 			const IMDCacheObject *Pimdobj(IMDId *pmdid);
 
+			// insert an object allocated in the pool of the given cache accessor into the MD cache
+			void CacheObject(CacheAccessorMD *pmdcacc, IMemoryPool *pmp, IMDCacheObject *pmdobj);
+
+			// store an object in the local hashtable
+			void StoreObject(IMDCacheObject *pmdobj);
+
+			// is the object with the given mdid neither in the local hashtable, nor in the MD cache or its snapshot
+			BOOL FMissing(IMDId *pmdid);
+
+			// fetch the given objects of a single provider in one request
+			void FetchObjects(IMDProvider *pmdp, DrgPmdid *pdrgpmdid);
+
 			// return the type corresponding to the given type info and source system id
 			const IMDType *Pmdtype(CSystemId sysid, IMDType::ETypeInfo eti);
 
@@ -247,7 +260,7 @@ namespace gpopt
 			// return the column statistics meta data object for a given column of a table
 			const IMDColStats *Pmdcolstats(IMemoryPool *pmp, IMDId *pmdidRel, ULONG ulPos);
 
-			// record histogram and width information for a given column of a table
+			// record histogram, width and sketch information for a given column of a table
 			void RecordColumnStats
 					(
 					IMemoryPool *pmp,
@@ -258,6 +271,7 @@ namespace gpopt
 					BOOL fEmptyTable,
 					HMUlHist *phmulhist,
 					HMUlDouble *phmuldoubleWidth,
+					HMUlHLL *phmulhll,
 					CStatisticsConfig *pstatsconf
 					);
 
@@ -291,6 +305,10 @@ namespace gpopt
 			// register given MD providers
 			void RegisterProviders(const DrgPsysid *pdrgpsysid, const DrgPmdp *pdrgpmdp);
 
+			// fetch the objects with the given mdids that are not cached yet,
+			// batching the requests to each provider
+			void Prefetch(const DrgPmdid *pdrgpmdid);
+
 			// interface to a relation object from the MD cache
 			const IMDRelation *Pmdrel(IMDId *pmdid);
 
@@ -24,6 +24,9 @@ namespace gpopt
 	using namespace gpos;
 	using namespace gpmd;
 
+	// fwd declarations
+	class CMDSnapshot;
+
 
 	//---------------------------------------------------------------------------
 	//	@class:
@@ -45,6 +48,40 @@ namespace gpopt
 			// the maximum size of the cache
 			static ULLONG m_ullCacheQuota;
 
+			// snapshot of the cache saved by an earlier process, if any
+			static CMDSnapshot *m_pmdsnap;
+
+			// relation whose entries are invalidated
+			struct SRelationArg
+			{
+				// mdid of the relation
+				IMDId *m_pmdidRel;
+
+				// cached relation object, NULL if the relation is not cached
+				const IMDRelation *m_pmdrel;
+			};
+
+			// do the given mdids identify the same object, possibly in different versions
+			static
+			BOOL FSameObject(const IMDId *pmdidFst, const IMDId *pmdidSnd);
+
+			// does the mdid identify the relation or statistics of the relation
+			static
+			BOOL FRelationOrStats(const IMDId *pmdid, const IMDId *pmdidRel);
+
+			// match functions for invalidation
+			static
+			BOOL FMatchMdid(CMDKey *pmdkey, const void *pvArg);
+
+			static
+			BOOL FMatchStale(CMDKey *pmdkey, const void *pvArg);
+
+			static
+			BOOL FMatchRelation(CMDKey *pmdkey, const void *pvArg);
+
+			static
+			BOOL FMatchSystem(CMDKey *pmdkey, const void *pvArg);
+
 			// private ctor
 			CMDCache()
 			{};
@@ -96,6 +133,45 @@ namespace gpopt
 				return m_pcache;
 			}
 
+			// invalidate the object with the given mdid
+			static
+			ULONG UlInvalidate(IMDId *pmdid);
+
+			// invalidate the versions of the object with the given mdid other
+			// than the given one, and statistics derived from them
+			static
+			ULONG UlInvalidateStale(IMDId *pmdid);
+
+			// invalidate all versions of a relation with their statistics, and
+			// the indexes, triggers and check constraints of the relation
+			static
+			ULONG UlInvalidateRelation(IMDId *pmdidRel);
+
+			// invalidate the objects of the given source system
+			static
+			ULONG UlInvalidateSystem(CSystemId sysid);
+
+			// load a snapshot of the cache saved by an earlier process; objects
+			// are restored from it when first looked up. Returns false if there
+			// is no snapshot file or it was written in another format
+			static
+			BOOL FLoadSnapshot(const CHAR *szFileName);
+
+			// save the objects of the cache in a snapshot file
+			static
+			void SaveSnapshot(const CHAR *szFileName);
+
+			// drop the loaded snapshot
+			static
+			void DropSnapshot();
+
+			// loaded snapshot, NULL if there is none
+			static
+			const CMDSnapshot *Psnapshot()
+			{
+				return m_pmdsnap;
+			}
+
 	}; // class CMDCache
 
 }  // namespace gpopt
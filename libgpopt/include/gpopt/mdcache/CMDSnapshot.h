@@ -0,0 +1,244 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMDSnapshot.h
+//
+//	@doc:
+//		Snapshot of the metadata cache persisted across processes
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CMDSnapshot_H
+#define GPOPT_CMDSnapshot_H
+
+#include "gpos/base.h"
+#include "gpos/common/CHashMap.h"
+#include "gpos/common/CHashMapIter.h"
+#include "gpos/sync/atomic.h"
+#include "gpos/io/CFileWriter.h"
+#include "gpos/string/CWStringBase.h"
+
+#include "gpopt/mdcache/CMDAccessor.h"
+
+namespace gpopt
+{
+	using namespace gpos;
+	using namespace gpmd;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CMDSnapshot
+	//
+	//	@doc:
+	//		Metadata objects of a cache saved in a file so that a later process
+	//		can restore them without asking the metadata provider. The file
+	//		starts with a header identifying the snapshot and binary DXL
+	//		formats, followed by a record for each object holding the string
+	//		of its mdid and the object as a binary DXL document with its
+	//		checksum.
+	//
+	//		Loading a snapshot only indexes its records; an object is parsed
+	//		when it is first looked up. Mdids include the version of their
+	//		object, so a record of an object changed since the snapshot was
+	//		saved is never found and a current copy is fetched instead. A
+	//		record that fails to restore is invalidated, and its object is
+	//		fetched from the provider as well.
+	//
+	//---------------------------------------------------------------------------
+	class CMDSnapshot
+	{
+		private:
+
+			// position of a record in the snapshot
+			struct SRecord
+			{
+				// offset of the binary DXL document
+				ULONG m_ulOffset;
+
+				// length of the binary DXL document
+				ULONG m_ulLength;
+
+				// checksum of the binary DXL document
+				ULONG m_ulChecksum;
+
+				// mdid of the object, NULL if the mdid string is not of a
+				// relation, statistics or other GPDB object
+				IMDId *m_pmdid;
+
+				// is the record invalidated; set once, without a lock, as
+				// records are looked up concurrently
+				mutable volatile ULONG m_ulInvalid;
+
+				// ctor
+				SRecord(ULONG ulOffset, ULONG ulLength, ULONG ulChecksum, IMDId *pmdid)
+					:
+					m_ulOffset(ulOffset),
+					m_ulLength(ulLength),
+					m_ulChecksum(ulChecksum),
+					m_pmdid(pmdid),
+					m_ulInvalid(0)
+				{}
+
+				// dtor
+				~SRecord()
+				{
+					CRefCount::SafeRelease(m_pmdid);
+				}
+
+				// is the record valid
+				BOOL FValid() const
+				{
+					return 0 == m_ulInvalid;
+				}
+
+				// invalidate the record; returns false if it was invalid
+				BOOL FInvalidate() const
+				{
+					return FCompareSwap(&m_ulInvalid, 0, 1);
+				}
+			};
+
+			// hash function for mdid strings
+			static
+			ULONG UlHashMdid(const CWStringBase *pstr);
+
+			// equality function for mdid strings
+			static
+			BOOL FEqualMdids(const CWStringBase *pstrFst, const CWStringBase *pstrSnd);
+
+			// map of mdid strings to records
+			typedef CHashMap<CWStringBase, SRecord, UlHashMdid, FEqualMdids,
+							CleanupDelete<CWStringBase>, CleanupDelete<SRecord> > HMStrRecord;
+
+			// iterator over the records
+			typedef CHashMapIter<CWStringBase, SRecord, UlHashMdid, FEqualMdids,
+							CleanupDelete<CWStringBase>, CleanupDelete<SRecord> > HMStrRecordIter;
+
+			// arguments of writing the objects of a cache
+			struct SWriteArg
+			{
+				// memory pool
+				IMemoryPool *m_pmp;
+
+				// snapshot file
+				CFileWriter *m_pfw;
+			};
+
+			// file header
+			enum EHeader
+			{
+				EhdrMagic0 = 'M',
+				EhdrMagic1 = 'D',
+				EhdrMagic2 = 'S',
+				EhdrMagic3 = 'S',
+
+				// version of the record layout
+				EhdrVersion = 2,
+
+				// size of the header: magic, snapshot and binary DXL format
+				// versions, and hash of the DXL token table
+				EhdrSize = 16
+			};
+
+			// memory pool
+			IMemoryPool *m_pmp;
+
+			// content of the snapshot file
+			BYTE *m_pba;
+
+			// size of the snapshot file
+			ULONG m_ulLength;
+
+			// records of the snapshot
+			HMStrRecord *m_phmstrrec;
+
+			// private copy ctor
+			CMDSnapshot(const CMDSnapshot &);
+
+			// ctor
+			CMDSnapshot(IMemoryPool *pmp, BYTE *pba, ULONG ulLength);
+
+			// write an unsigned integer
+			static
+			void WriteUl(CFileWriter *pfw, ULONG ul);
+
+			// read an unsigned integer; returns false at the end of the snapshot
+			BOOL FReadUl(ULONG *pulPos, ULONG *pul) const;
+
+			// checksum of a binary DXL document
+			static
+			ULONG UlChecksum(const BYTE *pba, ULONG ulLength);
+
+			// parse the binary DXL document of a record; returns NULL if the
+			// document is corrupt or holds an object with another mdid
+			IMDCacheObject *PimdobjParse(IMemoryPool *pmp, const SRecord *prec, IMDId *pmdid) const;
+
+			// check the file header
+			BOOL FValidHeader() const;
+
+			// index the records of the snapshot
+			void IndexRecords();
+
+			// mdid of a relation, statistics or other GPDB object from its
+			// string; returns NULL for mdids of other types
+			static
+			IMDId *PmdidParse(IMemoryPool *pmp, const CHAR *szMdid);
+
+			// write the record of a cached object
+			static
+			void WriteObject(IMDCacheObject *pmdobj, void *pvArg);
+
+		public:
+
+			// dtor
+			~CMDSnapshot();
+
+			// memory pool
+			IMemoryPool *Pmp() const
+			{
+				return m_pmp;
+			}
+
+			// number of objects in the snapshot, including invalidated ones
+			ULONG UlObjects() const
+			{
+				return m_phmstrrec->UlEntries();
+			}
+
+			// does the snapshot have an object with the given mdid
+			BOOL FContains(IMDId *pmdid) const;
+
+			// parse the object with the given mdid into the given memory pool;
+			// returns NULL if the snapshot has no such object or its record
+			// cannot be restored
+			IMDCacheObject *Pimdobj(IMemoryPool *pmp, IMDId *pmdid) const;
+
+			// invalidate the record of the object with the given mdid; returns
+			// the number of records invalidated
+			ULONG UlInvalidate(IMDId *pmdid);
+
+			// invalidate the records whose mdids match; records whose mdid
+			// type is not known are invalidated if fMatchUnknown is set
+			ULONG UlInvalidate
+				(
+				CMDAccessor::MDCache::MatchFuncPtr pfuncMatch,
+				const void *pvArg,
+				BOOL fMatchUnknown
+				);
+
+			// load a snapshot file; returns NULL if the file was written in
+			// another format or is too large
+			static
+			CMDSnapshot *PmdsnapLoad(IMemoryPool *pmp, const CHAR *szFileName);
+
+			// save the objects of the given cache in a snapshot file, replacing
+			// any existing file at once
+			static
+			void Save(IMemoryPool *pmp, CMDAccessor::MDCache *pcache, const CHAR *szFileName);
+
+	}; // class CMDSnapshot
+}
+
+#endif // !GPOPT_CMDSnapshot_H
+
+// EOF
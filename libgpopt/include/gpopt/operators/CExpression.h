@@ -86,6 +86,10 @@ namespace gpopt
 			// cost of physical expression node when copied out of the memo
 			CCost m_cost;
 
+			// selectivity of a runtime filter decided when costing the node in the memo,
+			// 1.0 if no runtime filter is planned
+			CDouble m_dRuntimeFilterSelectivity;
+
 			// id of origin group, used for debugging expressions extracted from memo
 			ULONG m_ulOriginGrpId;
 
@@ -175,7 +179,8 @@ namespace gpopt
 				CGroupExpression *pgexpr,
 				DrgPexpr *pdrgpexpr,
 				IStatistics *pstatsInput,
-				CCost cost = GPOPT_INVALID_COST
+				CCost cost = GPOPT_INVALID_COST,
+				CDouble dRuntimeFilterSelectivity = CDouble(1.0)
 				);
 
 			// ctor for expression with derived properties
@@ -245,6 +250,12 @@ namespace gpopt
 				return m_cost;
 			}
 
+			// runtime filter selectivity accessor
+			CDouble DRuntimeFilterSelectivity() const
+			{
+				return m_dRuntimeFilterSelectivity;
+			}
+
 			// get the suitable derived property type based on operator
 			CDrvdProp::EPropType Ept() const;
 
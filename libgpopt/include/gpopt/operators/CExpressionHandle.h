@@ -117,6 +117,9 @@ namespace gpopt
 			// stat derivation at root operator where handle is attached
 			void DeriveRootStats(DrgPstat *pdrgpstatCtxt);
 
+			// drop histograms of columns that are not required stat columns
+			IStatistics *PstatsPruneHistograms(IStatistics *pstats);
+
 		public:
 		
 			// ctor
@@ -142,6 +142,18 @@ namespace gpopt
 				return m_pdrgpexprOuterKeys;
 			}
 
+			// selectivity of a runtime filter built from inner keys and applied
+			// to the outer child, 1.0 if no runtime filter is planned
+			static
+			CDouble DRuntimeFilterSelectivity
+				(
+				COperator *popJoin,
+				BOOL fOuterMotion,
+				DOUBLE dRowsOuter,
+				DOUBLE dRowsInner,
+				DOUBLE dRows
+				);
+
 			//-------------------------------------------------------------------------------------
 			// Required Plan Properties
 			//-------------------------------------------------------------------------------------
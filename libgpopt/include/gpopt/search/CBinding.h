@@ -14,12 +14,14 @@
 #include "gpopt/operators/CExpression.h"
 
 #include "gpos/base.h"
+#include "gpos/common/CHashMap.h"
 
 namespace gpopt
 {
 	using namespace gpos;
 
 	// fwd declaration
+	class CBindingHandle;
 	class CGroupExpression;
 	class CGroup;
 	
@@ -37,7 +39,64 @@ namespace gpopt
 	{
 	
 		private:
-					
+
+			//---------------------------------------------------------------------------
+			//	@struct:
+			//		SBindingKey
+			//
+			//	@doc:
+			//		Key of a cached binding: a group and the pattern bound to it
+			//
+			//---------------------------------------------------------------------------
+			struct SBindingKey
+			{
+				// group
+				CGroup *m_pgroup;
+
+				// pattern
+				CExpression *m_pexprPattern;
+
+				// ctor
+				SBindingKey
+					(
+					CGroup *pgroup,
+					CExpression *pexprPattern
+					)
+					:
+					m_pgroup(pgroup),
+					m_pexprPattern(pexprPattern)
+				{}
+
+				// hash function
+				static
+				ULONG UlHash(const SBindingKey *pbk);
+
+				// equality function
+				static
+				BOOL FEqual(const SBindingKey *pbkFst, const SBindingKey *pbkSnd);
+
+			}; // struct SBindingKey
+
+			// map of group and pattern to the first binding extracted from group
+			typedef CHashMap<SBindingKey, CExpression, SBindingKey::UlHash, SBindingKey::FEqual,
+						CleanupDelete<SBindingKey>, CleanupRelease<CExpression> > HMBindingExpr;
+
+			// first bindings of child groups, shared by all bindings extracted
+			// by this object since child cursors are reset to their first
+			// binding each time a sibling cursor advances
+			HMBindingExpr *m_phmbe;
+
+			// share first bindings of child groups within a sequence of bindings
+			BOOL m_fShareFirstBindings;
+
+			// extract first binding from a group, re-using a previous extraction
+			CExpression *PexprExtractFirst
+				(
+				IMemoryPool *pmp,
+				CGroup *pgroup,
+				CExpression *pexprPattern
+				);
+
 			// initialize cursors of child expressions
 			BOOL FInitChildCursors
 				(
@@ -80,7 +139,16 @@ namespace gpopt
 				CExpression *pexpr,
 				ULONG ulPos,
 				ULONG ulArity
-				);
+				)
+				const;
+
+			// check if given group has an expression matching the root of given pattern
+			BOOL FMatchGroup
+				(
+				CGroup *pgroup,
+				CExpression *pexprPattern
+				)
+				const;
 			
 			// get binding for children
 			BOOL FExtractChildren
@@ -100,7 +168,40 @@ namespace gpopt
 				CExpression *pexprPattern,
 				CExpression *pexprLast
 				);
+
+			// extract binding from group expression within current sequence of bindings
+			CExpression *PexprExtractFromGExpr
+				(
+				IMemoryPool *pmp,
+				CGroupExpression *pgexpr,
+				CExpression *pexprPattern,
+				CExpression *pexprLast
+				);
 			
+			// bind handle to the first binding of a group expression
+			BOOL FBindGExpr
+				(
+				CBindingHandle *pbh,
+				CGroupExpression *pgexpr,
+				CExpression *pexprPattern
+				)
+				const;
+
+			// bind handle to the first binding of a group
+			BOOL FBindGroup
+				(
+				CBindingHandle *pbh,
+				CGroup *pgroup,
+				CExpression *pexprPattern
+				)
+				const;
+
+			// advance handle to the next binding within its group
+			BOOL FAdvanceGroup(CBindingHandle *pbh) const;
+
+			// advance child handles to the next binding of their parent
+			BOOL FAdvanceChildHandles(CBindingHandle *pbh) const;
+
 			// build expression
 			CExpression *PexprFinalize
 				(
@@ -114,15 +215,26 @@ namespace gpopt
 						
 		public:
 		
-			// ctor
-			CBinding()
+			// ctor; without sharing, the first binding of a child group is
+			// extracted again whenever a child cursor is reset
+			explicit
+			CBinding
+				(
+				BOOL fShareFirstBindings = true
+				)
+				:
+				m_phmbe(NULL),
+				m_fShareFirstBindings(fShareFirstBindings)
 			{}
 			
 			// dtor
 			~CBinding()
-			{}
+			{
+				CRefCount::SafeRelease(m_phmbe);
+			}
 			
-			// extract binding from group expression
+			// extract binding from group expression; a NULL last binding starts
+			// a new sequence of bindings
 			CExpression *PexprExtract
 				(
 				IMemoryPool *pmp,
@@ -131,6 +243,28 @@ namespace gpopt
 				CExpression *pexprLast
 				);
 
+			// bind handle to the first binding of group expression without
+			// extracting any expression; pattern leaves and trees bind to
+			// their group as a whole
+			BOOL FBindFirst
+				(
+				CGroupExpression *pgexpr,
+				CExpression *pexprPattern,
+				CBindingHandle *pbh
+				)
+				const;
+
+			// advance handle to the next binding of its group expression
+			BOOL FBindNext(CBindingHandle *pbh) const;
+
+			// check if a binding may exist without extracting any expression
+			BOOL FPossibleBinding
+				(
+				CGroupExpression *pgexpr,
+				CExpression *pexprPattern
+				)
+				const;
+
 	}; // class CBinding
 	
 }
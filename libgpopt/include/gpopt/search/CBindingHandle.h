@@ -0,0 +1,137 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CBindingHandle.h
+//
+//	@doc:
+//		Lazy binding of a pattern to group expressions in the memo
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CBindingHandle_H
+#define GPOPT_CBindingHandle_H
+
+#include "gpos/base.h"
+#include "gpos/common/CDynamicPtrArray.h"
+
+#include "gpopt/operators/CExpression.h"
+
+namespace gpopt
+{
+	using namespace gpos;
+
+	// fwd declaration
+	class CBinding;
+	class CDrvdPropRelational;
+	class CDrvdPropScalar;
+	class CGroup;
+	class CGroupExpression;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CBindingHandle
+	//
+	//	@doc:
+	//		Binding of a pattern to the memo that is advanced by CBinding
+	//		without building expressions; each node of the handle points to
+	//		the group expression bound to the corresponding pattern node,
+	//		pattern leaves and trees bind to their group as a whole;
+	//		operators and derived properties of the binding are inspected
+	//		through the memo, and an expression is built only on request
+	//
+	//---------------------------------------------------------------------------
+	class CBindingHandle
+	{
+		friend class CBinding;
+
+		private:
+
+			// array of child handles
+			typedef CDynamicPtrArray<CBindingHandle, CleanupDelete> DrgPbh;
+
+			// memory pool
+			IMemoryPool *m_pmp;
+
+			// bound pattern node
+			CExpression *m_pexprPattern;
+
+			// bound group expression; the first expression of the group
+			// when the pattern node is a leaf or a tree
+			CGroupExpression *m_pgexpr;
+
+			// handles of children, kept across bindings to be re-bound
+			DrgPbh *m_pdrgpbh;
+
+			// number of bound children
+			ULONG m_ulArity;
+
+			// bind to group expression, child handles are bound by caller
+			void Bind
+				(
+				CExpression *pexprPattern,
+				CGroupExpression *pgexpr,
+				ULONG ulArity
+				);
+
+			// n-th child handle, created on first use
+			CBindingHandle *PbhChild(ULONG ulPos);
+
+			// private copy ctor
+			CBindingHandle(const CBindingHandle &);
+
+		public:
+
+			// ctor
+			explicit
+			CBindingHandle(IMemoryPool *pmp);
+
+			// dtor
+			~CBindingHandle();
+
+			// is handle bound
+			BOOL FBound() const
+			{
+				return NULL != m_pgexpr;
+			}
+
+			// bound group expression
+			CGroupExpression *Pgexpr() const
+			{
+				return m_pgexpr;
+			}
+
+			// bound group
+			CGroup *Pgroup() const;
+
+			// operator of bound group expression
+			COperator *Pop() const;
+
+			// is the group bound as a whole by a pattern leaf or tree
+			BOOL FGroupBound() const;
+
+			// number of bound children
+			ULONG UlArity() const
+			{
+				return m_ulArity;
+			}
+
+			// n-th bound child
+			const CBindingHandle &operator[](ULONG ulPos) const;
+
+			// relational properties of bound group
+			CDrvdPropRelational *Pdprel() const;
+
+			// scalar properties of bound group
+			CDrvdPropScalar *Pdpscalar() const;
+
+			// build expression of binding; groups bound as a whole are
+			// represented by leaves pointing to their first expression
+			CExpression *Pexpr(IMemoryPool *pmp) const;
+
+	}; // class CBindingHandle
+
+}
+
+#endif // !GPOPT_CBindingHandle_H
+
+// EOF
@@ -157,6 +157,16 @@ namespace gpopt
 				CXformResult *pxfres
 				);
 
+			// apply transformation to lazy bindings of group expression
+			void TransformBindings
+				(
+				IMemoryPool *pmp,
+				CXform *pxform,
+				CXformContext *pxfctxt,
+				CXformResult *pxfres,
+				ULONG *pulNumberOfBindings
+				);
+
 			// preprocessing before applying transformation
 			void PreprocessTransform
 				(
@@ -389,7 +399,8 @@ namespace gpopt
 				IMemoryPool *pmpLocal,
 				CXform *pxform,
 				CXformResult *pxfres,
-				ULONG *pulElapsedTime
+				ULONG *pulElapsedTime,
+				ULONG *pulNumberOfBindings
 				);
 
 			// set group expression state
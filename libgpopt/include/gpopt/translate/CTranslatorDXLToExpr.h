@@ -13,6 +13,7 @@
 #define GPOPT_CTranslatorDXLToExpr_H
 
 #include "gpos/base.h"
+#include "gpos/common/CBitSet.h"
 #include "gpos/common/CHashMap.h"
 #include "gpos/sync/CAtomicCounter.h"
 
@@ -353,6 +354,21 @@ namespace gpopt
 			
 			// translate a dxl node into an expression tree
 			CExpression *Pexpr(const CDXLNode *pdxln);
+
+			// append a valid mdid to the given array
+			static
+			void AppendMdid(DrgPmdid *pdrgpmdid, IMDId *pmdid);
+
+			// collect the mdids of the metadata objects referenced by a DXL tree
+			// and the ids of the columns referenced by its scalar expressions
+			void CollectMdids(const CDXLNode *pdxln, DrgPmdid *pdrgpmdid, CBitSet *pbsColIds);
+
+			// collect the mdids of the column statistics of the given columns
+			// of the relations scanned in a DXL tree
+			void CollectColStatsMdids(const CDXLNode *pdxln, DrgPmdid *pdrgpmdid, const CBitSet *pbsColIds);
+
+			// fetch the metadata objects referenced by a query in batched requests
+			void PrefetchMetadata(const CDXLNode *pdxln, const DrgPdxln *pdrgpdxlnCTE);
 			
 			// update table descriptor's distribution columns from the MD cache object 
 			void AddDistributionColumns
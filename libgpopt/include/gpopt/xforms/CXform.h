@@ -38,6 +38,9 @@
 namespace gpopt
 {
 	using namespace gpos;
+
+	// fwd declaration
+	class CBindingHandle;
 	
 	//---------------------------------------------------------------------------
 	//	@class:
@@ -269,6 +272,24 @@ namespace gpopt
 					CXformResult *pxfres,
 					CExpression *pexpr
 					) const = 0;
+
+			// does xform transform lazy bindings, where pattern leaves and
+			// trees bind to their groups as a whole
+			virtual
+			BOOL FLazyBinding() const
+			{
+				return false;
+			}
+
+			// transform a lazy binding; expressions should be built only for
+			// results, by default the binding is built and transformed
+			virtual
+			void TransformBinding
+					(
+					CXformContext *pxfctxt,
+					CXformResult *pxfres,
+					const CBindingHandle &bh
+					) const;
 			
 			// accessor
 			CExpression *PexprPattern() const
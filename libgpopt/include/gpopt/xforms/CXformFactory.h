@@ -50,6 +50,9 @@ namespace gpopt
 			// bitset of implementation xforms
 			CXformSet *m_pxfsImplementation;
 
+			// xforms indexed by the operator id of their pattern root
+			CXformSet *m_rgpxfsPatternRoot[COperator::EopSentinel];
+
 			// global instance
 			static CXformFactory* m_pxff;
 
@@ -63,6 +66,9 @@ namespace gpopt
 			// actual adding of xform
 			void Add(CXform *pxform);
 
+			// index xform by the operator id of its pattern root
+			void IndexPatternRoot(CXform *pxform);
+
 
 		public:
 
@@ -90,6 +96,18 @@ namespace gpopt
 				return m_pxfsImplementation;
 			}
 
+			// accessor of xforms whose pattern root matches the given operator
+			CXformSet *PxfsPatternRoot
+				(
+				COperator::EOperatorId eopid
+				)
+				const
+			{
+				GPOS_ASSERT(COperator::EopSentinel > eopid);
+
+				return m_rgpxfsPatternRoot[eopid];
+			}
+
 			// global accessor
 			static
 			CXformFactory *Pxff()
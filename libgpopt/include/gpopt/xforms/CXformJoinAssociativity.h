@@ -44,6 +44,19 @@ namespace gpopt
 				) 
 				const;
 
+			// distribute conjuncts of a predicate group between upper and
+			// lower join, conjuncts are only counted if no arrays are given
+			static
+			void CollectConjuncts
+				(
+				IMemoryPool *pmp,
+				CGroupExpression *pgexprPred,
+				CColRefSet *pcrsLower,
+				ULONG *pulLower,
+				DrgPexpr *pdrgpexprLower,
+				DrgPexpr *pdrgpexprUpper
+				);
+
 		public:
 
 			// ctor
@@ -80,6 +93,22 @@ namespace gpopt
 					CExpression *pexpr
 					) const;
 
+			// xform inspects bindings through the memo
+			virtual
+			BOOL FLazyBinding() const
+			{
+				return true;
+			}
+
+			// transform a lazy binding
+			virtual
+			void TransformBinding
+					(
+					CXformContext *pxfctxt,
+					CXformResult *pxfres,
+					const CBindingHandle &bh
+					) const;
+
 	}; // class CXformJoinAssociativity
 
 }
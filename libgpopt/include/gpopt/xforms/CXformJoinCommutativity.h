@@ -80,6 +80,22 @@ namespace gpopt
 					CExpression *pexpr
 					) const;
 
+			// xform inspects bindings through the memo
+			virtual
+			BOOL FLazyBinding() const
+			{
+				return true;
+			}
+
+			// transform a lazy binding
+			virtual
+			void TransformBinding
+					(
+					CXformContext *pxfctxt,
+					CXformResult *pxfres,
+					const CBindingHandle &bh
+					) const;
+
 	}; // class CXformJoinCommutativity
 
 }
@@ -0,0 +1,169 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CXformProfile.h
+//
+//	@doc:
+//		Per-xform cost accounting of an optimization session
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CXformProfile_H
+#define GPOPT_CXformProfile_H
+
+#include "gpos/base.h"
+
+#include "gpopt/xforms/CXform.h"
+
+namespace gpopt
+{
+	using namespace gpos;
+
+	// fwd declarations
+	class CGroupExpression;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CXformProfile
+	//
+	//	@doc:
+	//		Counters of xform activity, maintained by the engine when
+	//		EopttracePrintXformProfile or EopttraceEnableAdaptiveXformBudget is
+	//		set; per-query profiles are merged into a process-wide aggregate so
+	//		that a corpus of minidumps can be profiled in one run; all counters
+	//		are 64-bit and updated atomically
+	//
+	//---------------------------------------------------------------------------
+	class CXformProfile
+	{
+		private:
+
+			// number of times xform was applied to a group expression
+			ULLONG m_rgullAttempts[CXform::ExfSentinel];
+
+			// number of applications that produced at least one result
+			ULLONG m_rgullCalls[CXform::ExfSentinel];
+
+			// number of bindings extracted from the memo
+			ULLONG m_rgullBindings[CXform::ExfSentinel];
+
+			// number of expressions produced
+			ULLONG m_rgullResults[CXform::ExfSentinel];
+
+			// number of new group expressions inserted into the memo
+			ULLONG m_rgullMemoGexprs[CXform::ExfSentinel];
+
+			// time consumed in msec
+			ULLONG m_rgullTime[CXform::ExfSentinel];
+
+			// number of final plans containing a group expression derived by xform
+			ULLONG m_rgullPlans[CXform::ExfSentinel];
+
+			// number of final plans profiled
+			ULLONG m_ullPlans;
+
+			// process-wide aggregate of all profiles
+			static
+			CXformProfile m_xfprofAggregate;
+
+			// mark xforms that derived the given group expression
+			static
+			void MarkLineage(CXformSet *pxfs, CGroupExpression *pgexpr);
+
+			// private copy ctor
+			CXformProfile(const CXformProfile &);
+
+		public:
+
+			// ctor
+			CXformProfile();
+
+			// reset all counters
+			void Reset();
+
+			// record one application of an xform to a group expression
+			void RecordTransform
+				(
+				CXform::EXformId exfid,
+				ULONG ulBindings,
+				ULONG ulResults,
+				ULONG ulTime
+				);
+
+			// record a new group expression inserted into the memo by an xform
+			void RecordMemoInsert(CXform::EXformId exfid);
+
+			// record the xforms that contributed to the final plan
+			void RecordPlan(IMemoryPool *pmp, CExpression *pexprPlan);
+
+			// add counters of another profile to this one
+			void Merge(const CXformProfile &xfprof);
+
+			// print profile, one line per xform that was applied
+			IOstream &OsPrint(IOstream &os) const;
+
+			// number of applications of given xform
+			ULLONG UllAttempts
+				(
+				CXform::EXformId exfid
+				)
+				const
+			{
+				return m_rgullAttempts[exfid];
+			}
+
+			// number of bindings extracted for given xform
+			ULLONG UllBindings
+				(
+				CXform::EXformId exfid
+				)
+				const
+			{
+				return m_rgullBindings[exfid];
+			}
+
+			// number of applications of given xform that produced results
+			ULLONG UllCalls
+				(
+				CXform::EXformId exfid
+				)
+				const
+			{
+				return m_rgullCalls[exfid];
+			}
+
+			// number of final plans given xform contributed to
+			ULLONG UllPlans
+				(
+				CXform::EXformId exfid
+				)
+				const
+			{
+				return m_rgullPlans[exfid];
+			}
+
+			// is xform profiling required by any trace flag
+			static
+			BOOL FEnabled();
+
+			// process-wide aggregate accessor
+			static
+			CXformProfile *PxfprofAggregate()
+			{
+				return &m_xfprofAggregate;
+			}
+
+	}; // class CXformProfile
+
+	// shorthand for printing
+	inline
+	IOstream &operator << (IOstream &os, const CXformProfile &xfprof)
+	{
+		return xfprof.OsPrint(os);
+	}
+}
+
+
+#endif // !GPOPT_CXformProfile_H
+
+// EOF
@@ -0,0 +1,141 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CXformUtility.h
+//
+//	@doc:
+//		Utility statistics of xforms maintained across optimizations,
+//		used to skip xforms that rarely contribute to final plans
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CXformUtility_H
+#define GPOPT_CXformUtility_H
+
+#include "gpos/base.h"
+
+#include "gpopt/search/CSearchStage.h"
+#include "gpopt/xforms/CXform.h"
+
+// minimum number of optimizations in which an xform fired before its utility is trusted
+#define GPOPT_XFORM_UTILITY_MIN_SAMPLES 50
+
+// fraction of firing optimizations an xform must contribute to final plan to be kept
+#define GPOPT_XFORM_UTILITY_THRESHOLD 0.02
+
+// every n-th optimization of a query class keeps all xforms to refresh statistics
+#define GPOPT_XFORM_UTILITY_REFRESH_PERIOD 16
+
+namespace gpopt
+{
+	using namespace gpos;
+
+	// fwd declarations
+	class CXformProfile;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CXformUtility
+	//
+	//	@doc:
+	//		Process-wide per-xform utility statistics, keyed by a coarse query
+	//		class; only join reordering xforms are eligible for skipping since
+	//		skipping them never prevents finding a plan; low-utility xforms are
+	//		deferred to a fallback search stage that runs only if no plan was
+	//		found without them
+	//
+	//---------------------------------------------------------------------------
+	class CXformUtility
+	{
+		public:
+
+			// coarse query class, based on number of joins in the query
+			enum EQueryClass
+			{
+				EqcNoJoins = 0,		// no joins
+				EqcSmallJoins,		// up to 3 joins
+				EqcMediumJoins,		// up to 8 joins
+				EqcLargeJoins,		// more than 8 joins
+
+				EqcSentinel
+			};
+
+		private:
+
+			// number of optimizations per query class
+			ULONG_PTR m_rgulpOptimizations[EqcSentinel];
+
+			// number of optimizations in which xform produced results
+			ULONG_PTR m_rgrgulpFired[EqcSentinel][CXform::ExfSentinel];
+
+			// number of optimizations in which xform contributed to final plan
+			ULONG_PTR m_rgrgulpUseful[EqcSentinel][CXform::ExfSentinel];
+
+			// global instance
+			static
+			CXformUtility m_xfutil;
+
+			// count joins in given expression
+			static
+			ULONG UlJoins(CExpression *pexpr);
+
+			// can given xform be skipped
+			static
+			BOOL FEligible(CXform::EXformId exfid);
+
+			// does a stage after the given one apply the given xform
+			static
+			BOOL FAppliedLater(const DrgPss *pdrgpss, ULONG ulStage, CXform::EXformId exfid);
+
+			// private copy ctor
+			CXformUtility(const CXformUtility &);
+
+		public:
+
+			// ctor
+			CXformUtility();
+
+			// reset all statistics
+			void Reset();
+
+			// is the search strategy adapted to xform utility statistics
+			static
+			BOOL FEnabled();
+
+			// classify given query expression
+			static
+			EQueryClass Eqc(CExpression *pexpr);
+
+			// check if xform has low utility for given query class
+			BOOL FLowUtility(EQueryClass eqc, CXform::EXformId exfid) const;
+
+			// copy of given search stages with low-utility xforms deprioritized
+			DrgPss *PdrgpssDeprioritize(IMemoryPool *pmp, EQueryClass eqc, const DrgPss *pdrgpss) const;
+
+			// update statistics with profile of a completed optimization
+			void Update(EQueryClass eqc, const CXformProfile &xfprof);
+
+			// export statistics, one line per eligible xform and query class
+			IOstream &OsPrint(IOstream &os) const;
+
+			// global accessor
+			static
+			CXformUtility *Pxfutil()
+			{
+				return &m_xfutil;
+			}
+
+	}; // class CXformUtility
+
+	// shorthand for printing
+	inline
+	IOstream &operator << (IOstream &os, const CXformUtility &xfutil)
+	{
+		return xfutil.OsPrint(os);
+	}
+}
+
+
+#endif // !GPOPT_CXformUtility_H
+
+// EOF
@@ -23,6 +23,7 @@
 #include "gpopt/operators/CExpressionHandle.h"
 #include "gpopt/operators/CPhysicalDynamicTableScan.h"
 #include "gpopt/operators/CPhysicalDynamicIndexScan.h"
+#include "gpopt/operators/CPhysicalHashJoin.h"
 
 #include "gpopt/optimizer/COptimizerConfig.h"
 #include "gpopt/search/CGroupExpression.h"
@@ -60,6 +61,7 @@ CCostContext::CCostContext
 	m_ulOptReq(ulOptReq),
 	m_fPruned(false),
 	m_pstats(NULL),
+	m_dRuntimeFilterSelectivity(1.0),
 	m_poc(poc)
 {
 	GPOS_ASSERT(NULL != poc);
@@ -555,10 +557,63 @@ CCostContext::CostCompute
 		ci.SetChildCost(ul, dCostChild);
 	}
 
+	// decide on a runtime filter once here, the decision is carried
+	// to the extracted plan and read by the DXL translator
+	if (CUtils::FHashJoin(m_pgexpr->Pop()))
+	{
+		m_dRuntimeFilterSelectivity = CPhysicalHashJoin::DRuntimeFilterSelectivity
+										(
+										m_pgexpr->Pop(),
+										FOuterChildMotion(),
+										ci.PdRows()[0],
+										ci.PdRows()[1],
+										dRows
+										);
+		ci.SetRuntimeFilterSelectivity(m_dRuntimeFilterSelectivity.DVal());
+	}
+
 	// compute cost using the underlying cost model
 	return pcm->Cost(exprhdl, &ci);
 }
 
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostContext::FOuterChildMotion
+//
+//	@doc:
+//		Check if the best plan of the outer child is a motion; compute
+//		scalar and filter operators are skipped since they run in the
+//		same slice as their child
+//
+//---------------------------------------------------------------------------
+BOOL
+CCostContext::FOuterChildMotion() const
+{
+	GPOS_ASSERT(NULL != m_pdrgpoc && 0 < m_pdrgpoc->UlLength());
+
+	CCostContext *pcc = (*m_pdrgpoc)[0]->PccBest();
+	while (NULL != pcc)
+	{
+		COperator *pop = pcc->Pgexpr()->Pop();
+		if (CUtils::FPhysicalMotion(pop))
+		{
+			return true;
+		}
+
+		if (COperator::EopPhysicalComputeScalar != pop->Eopid() &&
+			COperator::EopPhysicalFilter != pop->Eopid())
+		{
+			return false;
+		}
+
+		GPOS_ASSERT(NULL != pcc->Pdrgpoc() && 0 < pcc->Pdrgpoc()->UlLength());
+		pcc = (*pcc->Pdrgpoc())[0]->PccBest();
+	}
+
+	return false;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CCostContext::DRowsPerHost
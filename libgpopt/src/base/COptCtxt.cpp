@@ -53,7 +53,8 @@ COptCtxt::COptCtxt
 	m_pcteinfo(NULL),
 	m_pdrgpcrSystemCols(NULL),
 	m_poconf(poconf),
-	m_fDMLQuery(false)
+	m_fDMLQuery(false),
+	m_pstatsfcache(NULL)
 {
 	GPOS_ASSERT(NULL != pmp);
 	GPOS_ASSERT(NULL != pcf);
@@ -64,6 +65,7 @@ COptCtxt::COptCtxt
 	GPOS_ASSERT(NULL != poconf->Pcm());
 	
 	m_pcteinfo = GPOS_NEW(m_pmp) CCTEInfo(m_pmp);
+	m_pstatsfcache = GPOS_NEW(m_pmp) CStatsFilterCache(m_pmp);
 	m_pcm = poconf->Pcm();
 }
 
@@ -81,6 +83,7 @@ COptCtxt::~COptCtxt()
 {
 	GPOS_DELETE(m_pcf);
 	GPOS_DELETE(m_pcomp);
+	GPOS_DELETE(m_pstatsfcache);
 	m_pceeval->Release();
 	m_pcteinfo->Release();
 	m_poconf->Release();
@@ -39,6 +39,7 @@
 #include "gpopt/operators/CPhysicalSort.h"
 #include "gpopt/optimizer/COptimizerConfig.h"
 
+#include "gpopt/search/CBinding.h"
 #include "gpopt/search/CGroup.h"
 #include "gpopt/search/CGroupExpression.h"
 #include "gpopt/search/CGroupProxy.h"
@@ -48,6 +49,7 @@
 #include "gpopt/search/CScheduler.h"
 #include "gpopt/search/CSchedulerContext.h"
 #include "gpopt/xforms/CXformFactory.h"
+#include "gpopt/xforms/CXformUtility.h"
 
 #include "naucrates/traceflags/traceflags.h"
 
@@ -83,13 +85,24 @@ CEngine::CEngine
 	m_pexprEnforcerPattern(NULL),
 	m_pxfs(NULL),
 	m_pdrgpulpXformCalls(NULL),
-	m_pdrgpulpXformTimes(NULL)
+	m_pdrgpulpXformTimes(NULL),
+	m_pdrgpulpXformAttempts(NULL),
+	m_pdrgpulpXformPruned(NULL),
+	m_pxfprof(NULL),
+	m_eqc(CXformUtility::EqcNoJoins)
 {
 	m_pmemo = GPOS_NEW(pmp) CMemo(pmp);
 	m_pexprEnforcerPattern = GPOS_NEW(pmp) CExpression(pmp, GPOS_NEW(pmp) CPatternLeaf(pmp));
 	m_pxfs = GPOS_NEW(pmp) CXformSet(pmp);
 	m_pdrgpulpXformCalls = GPOS_NEW(pmp) DrgPulp(pmp);
 	m_pdrgpulpXformTimes = GPOS_NEW(pmp) DrgPulp(pmp);
+	m_pdrgpulpXformAttempts = GPOS_NEW(pmp) DrgPulp(pmp);
+	m_pdrgpulpXformPruned = GPOS_NEW(pmp) DrgPulp(pmp);
+	if (CXformProfile::FEnabled())
+	{
+		// xform activity is profiled only when a trace flag requires it
+		m_pxfprof = GPOS_NEW(pmp) CXformProfile();
+	}
 }
 
 
@@ -111,6 +124,9 @@ CEngine::~CEngine()
 	CRefCount::SafeRelease(m_pxfs);
 	m_pdrgpulpXformCalls->Release();
 	m_pdrgpulpXformTimes->Release();
+	m_pdrgpulpXformAttempts->Release();
+	m_pdrgpulpXformPruned->Release();
+	GPOS_DELETE(m_pxfprof);
 	m_pexprEnforcerPattern->Release();
 	CRefCount::SafeRelease(m_pdrgpss);
 #endif // GPOS_DEBUG
@@ -170,6 +186,16 @@ CEngine::Init
 	}
 	GPOS_ASSERT(0 < m_pdrgpss->UlLength());
 
+	if (CXformUtility::FEnabled())
+	{
+		// defer xforms that rarely contributed to plans of similar queries;
+		// the search stages of the caller are left unchanged
+		m_eqc = CXformUtility::Eqc(pqc->Pexpr());
+		DrgPss *pdrgpss = CXformUtility::Pxfutil()->PdrgpssDeprioritize(m_pmp, m_eqc, m_pdrgpss);
+		m_pdrgpss->Release();
+		m_pdrgpss = pdrgpss;
+	}
+
 	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
 	{
 		// initialize per-stage xform calls array
@@ -178,13 +204,19 @@ CEngine::Init
 		{
 			ULONG_PTR *pulpXformCalls = GPOS_NEW_ARRAY(m_pmp, ULONG_PTR, CXform::ExfSentinel);
 			ULONG_PTR *pulpXformTimes = GPOS_NEW_ARRAY(m_pmp, ULONG_PTR, CXform::ExfSentinel);
+			ULONG_PTR *pulpXformAttempts = GPOS_NEW_ARRAY(m_pmp, ULONG_PTR, CXform::ExfSentinel);
+			ULONG_PTR *pulpXformPruned = GPOS_NEW_ARRAY(m_pmp, ULONG_PTR, CXform::ExfSentinel);
 			for (ULONG ulXform = 0; ulXform < CXform::ExfSentinel; ulXform++)
 			{
 				pulpXformCalls[ulXform] = 0;
 				pulpXformTimes[ulXform] = 0;
+				pulpXformAttempts[ulXform] = 0;
+				pulpXformPruned[ulXform] = 0;
 			}
 			m_pdrgpulpXformCalls->Append(pulpXformCalls);
 			m_pdrgpulpXformTimes->Append(pulpXformTimes);
+			m_pdrgpulpXformAttempts->Append(pulpXformAttempts);
+			m_pdrgpulpXformPruned->Append(pulpXformPruned);
 		}
 	}
 
@@ -339,6 +371,10 @@ CEngine::PgroupInsert
 		// insertion failed, release created group expression
 		pgexpr->Release();
 	}
+	else if (NULL != m_pxfprof)
+	{
+		m_pxfprof->RecordMemoInsert(exfidOrigin);
+	}
 
 	return pgroupContainer;
 }	
@@ -359,7 +395,8 @@ CEngine::InsertXformResult
 	CXformResult *pxfres,
 	CXform::EXformId exfidOrigin,
 	CGroupExpression *pgexprOrigin,
-	ULONG ulXformTime // time consumed by transformation in msec
+	ULONG ulXformTime, // time consumed by transformation in msec
+	ULONG ulNumberOfBindings // number of bindings extracted by transformation
 	)
 {
 	GPOS_ASSERT(NULL != pxfres);
@@ -367,6 +404,16 @@ CEngine::InsertXformResult
 	GPOS_ASSERT(CXform::ExfInvalid != exfidOrigin);
 	GPOS_ASSERT(NULL != pgexprOrigin);
 
+	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
+	{
+		(void) UlpExchangeAdd(&(*m_pdrgpulpXformAttempts)[m_ulCurrSearchStage][exfidOrigin], 1);
+	}
+
+	if (NULL != m_pxfprof)
+	{
+		m_pxfprof->RecordTransform(exfidOrigin, ulNumberOfBindings, pxfres->Pdrgpexpr()->UlLength(), ulXformTime);
+	}
+
 	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics) && 0 < pxfres->Pdrgpexpr()->UlLength())
 	{
 		(void) m_pxfs->FExchangeSet(exfidOrigin);
@@ -392,6 +439,65 @@ CEngine::InsertXformResult
 	}
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::PxfsApplicable
+//
+//	@doc:
+//		Compute the set of xforms to apply to a given group expression in
+//		the current stage; candidate xforms of the operator are intersected
+//		with the required xforms and the xforms of current stage, then
+//		xforms whose pattern cannot be bound to the group expression are
+//		dropped using the pattern index of the xform factory;
+//		caller takes ownership of the returned set
+//
+//---------------------------------------------------------------------------
+CXformSet *
+CEngine::PxfsApplicable
+	(
+	IMemoryPool *pmp,
+	CGroupExpression *pgexpr,
+	CXformSet *pxfsRequired
+	)
+{
+	GPOS_ASSERT(NULL != pgexpr);
+	GPOS_ASSERT(NULL != pxfsRequired);
+
+	// get all candidate xforms of the operator
+	COperator *pop = pgexpr->Pop();
+	CXformSet *pxfsCandidates = CLogical::PopConvert(pop)->PxfsCandidates(pmp);
+
+	// intersect them with required xforms and xforms of current stage
+	pxfsCandidates->Intersection(pxfsRequired);
+	pxfsCandidates->Intersection(PxfsCurrentStage());
+
+	// keep xforms whose pattern can be bound to the group expression
+	CXformSet *pxfs = GPOS_NEW(pmp) CXformSet(pmp, *pxfsCandidates);
+	pxfs->Intersection(CXformFactory::Pxff()->PxfsPatternRoot(pop->Eopid()));
+
+	CBinding binding;
+	const BOOL fStats = GPOS_FTRACE(EopttracePrintOptimizationStatistics);
+	CXformSetIter xsi(*pxfsCandidates);
+	while (xsi.FAdvance())
+	{
+		CXform::EXformId exfid = xsi.TBit();
+		if (pxfs->FBit(exfid) &&
+			!binding.FPossibleBinding(pgexpr, CXformFactory::Pxff()->Pxf(exfid)->PexprPattern()))
+		{
+			(void) pxfs->FExchangeClear(exfid);
+		}
+
+		if (fStats && !pxfs->FBit(exfid))
+		{
+			(void) UlpExchangeAdd(&(*m_pdrgpulpXformPruned)[m_ulCurrSearchStage][exfid], 1);
+		}
+	}
+	pxfsCandidates->Release();
+
+	return pxfs;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CEngine::FPossibleDuplicateGroups
@@ -738,8 +844,9 @@ CEngine::ApplyTransformations
 		// transform group expression, and insert results to memo
 		CXformResult *pxfres = GPOS_NEW(m_pmp) CXformResult(m_pmp);
 		ULONG ulElapsedTime = 0;
-		pgexpr->Transform(m_pmp, pmpLocal, pxform, pxfres, &ulElapsedTime);
-		InsertXformResult(pgexpr->Pgroup(), pxfres, pxform->Exfid(), pgexpr, ulElapsedTime);
+		ULONG ulNumberOfBindings = 0;
+		pgexpr->Transform(m_pmp, pmpLocal, pxform, pxfres, &ulElapsedTime, &ulNumberOfBindings);
+		InsertXformResult(pgexpr->Pgroup(), pxfres, pxform->Exfid(), pgexpr, ulElapsedTime, ulNumberOfBindings);
 		pxfres->Release();
 
 		if (PssCurrent()->FTimedOut())
@@ -800,13 +907,8 @@ CEngine::TransitionGroupExpression
 		pxfs = CXformFactory::Pxff()->PxfsImplementation();
 	}
 
-	// get all applicable xforms
-	COperator *pop = pgexpr->Pop();
-	CXformSet *pxfsCandidates = CLogical::PopConvert(pop)->PxfsCandidates(m_pmp);
-
-	// intersect them with the required set of xforms, then apply transformations
-	pxfsCandidates->Intersection(pxfs);
-	pxfsCandidates->Intersection(PxfsCurrentStage());
+	// get all applicable xforms, then apply transformations
+	CXformSet *pxfsCandidates = PxfsApplicable(m_pmp, pgexpr, pxfs);
 	ApplyTransformations(pmpLocal, pxfsCandidates, pgexpr);
 	pxfsCandidates->Release();
 
@@ -1567,9 +1669,11 @@ CEngine::PrintActivatedXforms
 			CXform *pxform = CXformFactory::Pxff()->Pxf(xsi.TBit());
 			ULONG ulCalls = (ULONG) (*m_pdrgpulpXformCalls)[m_ulCurrSearchStage][pxform->Exfid()];
 			ULONG ulTime = (ULONG) (*m_pdrgpulpXformTimes)[m_ulCurrSearchStage][pxform->Exfid()];
+			ULONG ulAttempts = (ULONG) (*m_pdrgpulpXformAttempts)[m_ulCurrSearchStage][pxform->Exfid()];
 			os
 				<< pxform->SzId() << ": "
 				<< ulCalls << " calls, "
+				<< ulAttempts << " attempts, "
 				<< ulTime << "ms"<< std::endl;
 		}
 		os << "[OPT]: <End Xforms - stage " << m_ulCurrSearchStage << ">" << std::endl;
@@ -1642,6 +1746,31 @@ CEngine::ProcessTraceFlags()
 			<< ", " << m_pmemo->UlGrpExprs() << " group expressions"
 			<< ", " << m_pxfs->CElements() << " activated xforms]";
 
+		ULLONG ullCalls = 0;
+		ULLONG ullAttempts = 0;
+		ULLONG ullPruned = 0;
+		for (ULONG ul = 0; ul < CXform::ExfSentinel; ul++)
+		{
+			ullCalls += (*m_pdrgpulpXformCalls)[m_ulCurrSearchStage][ul];
+			ullAttempts += (*m_pdrgpulpXformAttempts)[m_ulCurrSearchStage][ul];
+			ullPruned += (*m_pdrgpulpXformPruned)[m_ulCurrSearchStage][ul];
+		}
+
+		at.Os()
+			<< std::endl << "[OPT]: Xforms (stage "<< m_ulCurrSearchStage << "): ["
+			<< ullAttempts << " attempts"
+			<< ", " << ullCalls << " successful calls"
+			<< ", " << ullPruned << " attempts pruned by pattern]";
+
+		at.Os()
+			<< std::endl << "[OPT]: Filter statistics cache (stage "<< m_ulCurrSearchStage << "): [";
+		CStatsFilterCache *pstatsfcache = COptCtxt::PoctxtFromTLS()->Pstatsfcache();
+		(void) pstatsfcache->OsPrint(at.Os());
+		at.Os() << "]";
+
+		// count lookups of the next stage only
+		pstatsfcache->ResetCounters();
+
 		at.Os()
 			<< std::endl << "[OPT]: stage "<< m_ulCurrSearchStage << " completed in "
 			<< PssCurrent()->UlElapsedTime() << " msec, ";
@@ -1960,6 +2089,24 @@ CEngine::PexprExtractPlan()
 		GPOS_RAISE(gpopt::ExmaGPOPT, gpopt::ExmiNoPlanFound);
 	}
 
+	if (NULL != m_pxfprof)
+	{
+		m_pxfprof->RecordPlan(m_pmp, pexpr);
+	}
+
+	if (NULL != m_pxfprof && GPOS_FTRACE(EopttracePrintXformProfile))
+	{
+		CXformProfile::PxfprofAggregate()->Merge(*m_pxfprof);
+
+		CAutoTrace at(m_pmp);
+		at.Os() << std::endl << *m_pxfprof;
+	}
+
+	if (NULL != m_pxfprof && CXformUtility::FEnabled())
+	{
+		CXformUtility::Pxfutil()->Update(m_eqc, *m_pxfprof);
+	}
+
 	return pexpr;
 }
 
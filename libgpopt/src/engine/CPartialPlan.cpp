@@ -16,6 +16,7 @@
 #include "gpopt/engine/CPartialPlan.h"
 #include "gpopt/search/CGroupExpression.h"
 #include "gpopt/operators/CExpressionHandle.h"
+#include "gpopt/operators/CPhysicalHashJoin.h"
 #include "gpopt/operators/CPhysicalMotion.h"
 #include "gpopt/search/CGroup.h"
 
@@ -247,6 +248,15 @@ CPartialPlan::CostCompute
 	DOUBLE dRebinds = m_pgexpr->Pgroup()->Pstats()->DRebinds().DVal();
 	ci.SetRebinds(dRebinds);
 
+	if (CUtils::FHashJoin(pop))
+	{
+		// outer child plan may not be known yet, we assume no motion feeds the
+		// outer side since a runtime filter lowers the cost of the join
+		DOUBLE dRuntimeFilterSelectivity =
+			CPhysicalHashJoin::DRuntimeFilterSelectivity(pop, false /*fOuterMotion*/, ci.PdRows()[0], ci.PdRows()[1], dRows).DVal();
+		ci.SetRuntimeFilterSelectivity(dRuntimeFilterSelectivity);
+	}
+
 	// compute partial plan cost
 	CCost cost = pcm->Cost(exprhdl, &ci);
 
@@ -21,6 +21,12 @@
 
 using namespace gpopt;
 
+// default number of column histograms from which histograms are derived in parallel
+const ULONG CStatisticsConfig::ulParallelHistogramsThresholdDefault = 128;
+
+// default maximum number of buckets of a derived histogram
+const ULONG CStatisticsConfig::ulMaxHistogramBucketsDefault = 1000;
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CStatisticsConfig::CStatisticsConfig
@@ -34,18 +40,23 @@ CStatisticsConfig::CStatisticsConfig
 	IMemoryPool *pmp,
 	CDouble dDampingFactorFilter,
 	CDouble dDampingFactorJoin,
-	CDouble dDampingFactorGroupBy
+	CDouble dDampingFactorGroupBy,
+	ULONG ulParallelHistogramsThreshold,
+	ULONG ulMaxHistogramBuckets
 	)
 	:
 	m_pmp(pmp),
 	m_dDampingFactorFilter(dDampingFactorFilter),
 	m_dDampingFactorJoin(dDampingFactorJoin),
 	m_dDampingFactorGroupBy(dDampingFactorGroupBy),
+	m_ulParallelHistogramsThreshold(ulParallelHistogramsThreshold),
+	m_ulMaxHistogramBuckets(ulMaxHistogramBuckets),
 	m_phsmdidcolinfo(NULL)
 {
 	GPOS_ASSERT(CDouble(0.0) < dDampingFactorFilter);
 	GPOS_ASSERT(CDouble(0.0) < dDampingFactorJoin);
 	GPOS_ASSERT(CDouble(0.0) < dDampingFactorGroupBy);
+	GPOS_ASSERT(0 < ulMaxHistogramBuckets);
 
 	//m_phmmdidcolinfo = New(m_pmp) HMMDIdMissingstatscol(m_pmp);
 	m_phsmdidcolinfo = GPOS_NEW(m_pmp) HSMDId(m_pmp);
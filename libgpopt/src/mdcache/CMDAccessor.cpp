@@ -22,6 +22,8 @@
 #include "gpopt/exception.h"
 #include "gpopt/mdcache/CMDAccessor.h"
 #include "gpopt/mdcache/CMDAccessorUtils.h"
+#include "gpopt/mdcache/CMDCache.h"
+#include "gpopt/mdcache/CMDSnapshot.h"
 
 
 #include "naucrates/exception.h"
@@ -50,6 +52,7 @@
 #include "naucrates/md/CMDIdScCmp.h"
 
 #include "naucrates/md/IMDProvider.h"
+#include "naucrates/md/CMDRequest.h"
 #include "naucrates/md/CMDProviderGeneric.h"
 
 using namespace gpos;
@@ -540,6 +543,78 @@ CMDAccessor::Pmdp
 
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessor::CacheObject
+//
+//	@doc:
+//		Inserts an object allocated in the memory pool created by the given
+//		cache accessor into the MD cache; the accessor pins the object
+//		independent of whether the insertion succeeded or the object was
+//		already cached
+//
+//---------------------------------------------------------------------------
+void
+CMDAccessor::CacheObject
+	(
+	CacheAccessorMD *pmdcacc,
+	IMemoryPool *pmp,
+	IMDCacheObject *pmdobj
+	)
+{
+	GPOS_ASSERT(NULL != pmdcacc);
+	GPOS_ASSERT(NULL != pmdobj);
+
+	CAutoP<CMDKey> a_pmdkeyCache;
+	// ref count of the new object is set to one and optimizer becomes its owner
+	a_pmdkeyCache = GPOS_NEW(pmp) CMDKey(pmdobj->Pmdid());
+
+#ifdef GPOS_DEBUG
+	IMDCacheObject *pmdobjInserted =
+#endif
+	pmdcacc->PtInsert(a_pmdkeyCache.Pt(), pmdobj);
+
+	GPOS_ASSERT(NULL != pmdobjInserted);
+
+	// safely inserted
+	(void) a_pmdkeyCache.PtReset();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessor::StoreObject
+//
+//	@doc:
+//		Stores an object in the local hashtable unless an object with the same
+//		mdid has been stored in the meantime
+//
+//---------------------------------------------------------------------------
+void
+CMDAccessor::StoreObject
+	(
+	IMDCacheObject *pmdobj
+	)
+{
+	GPOS_ASSERT(NULL != pmdobj);
+	IMDId *pmdid = pmdobj->Pmdid();
+	pmdid->AddRef();
+
+	CAutoP<SMDAccessorElem> a_pmdaccelem;
+	a_pmdaccelem = GPOS_NEW(m_pmp) SMDAccessorElem(pmdobj, pmdid);
+
+	MDHTAccessor mdhtacc(m_shtCacheAccessors, a_pmdaccelem->Pmdid());
+
+	if (NULL == mdhtacc.PtLookup())
+	{
+		// object has not been inserted in the meantime
+		mdhtacc.Insert(a_pmdaccelem.Pt());
+
+		// add deletion lock for mdid
+		a_pmdaccelem->Pmdid()->AddDeletionLock();
+		a_pmdaccelem.PtReset();
+	}
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDAccessor::Pimdobj
@@ -588,19 +663,51 @@ CMDAccessor::Pimdobj
 		{
 			// object not found in MD cache: retrieve it from MD provider
 			CTimerUser timerFetch;  // timer to measure fetch time
-			CAutoP<CWStringBase> a_pstr;
-			a_pstr = pmdp->PstrObject(m_pmp, this, pmdid);
-			
-			GPOS_ASSERT(NULL != a_pstr.Pt());
 			IMemoryPool *pmp = m_pmp;
-			
-			if (IMDId::EmdidGPDBCtas != pmdid->Emdidt())
+
+			BOOL fCache = (IMDId::EmdidGPDBCtas != pmdid->Emdidt());
+
+			// objects cached by an earlier process are restored from the
+			// snapshot of the MD cache without asking the provider
+			const CMDSnapshot *pmdsnap = CMDCache::Psnapshot();
+			if (fCache && NULL != pmdsnap && CMDCache::Pcache() == m_pcache)
 			{
 				// create the accessor memory pool
 				pmp = a_pmdcacc->Pmp();
+				pmdobjNew = pmdsnap->Pimdobj(pmp, pmdid);
 			}
 
-			pmdobjNew = gpdxl::CDXLUtils::PimdobjParseDXL(pmp, a_pstr.Pt(), NULL /* XSD path */);
+			if (NULL == pmdobjNew)
+			{
+				const BOOL fShared = pmdp->FSharesObjects();
+				if (fCache && !fShared && m_pmp == pmp)
+				{
+					// create the accessor memory pool
+					pmp = a_pmdcacc->Pmp();
+				}
+
+				// objects shared with the provider bypass the MD cache, like
+				// CTAS objects; other objects are built in the accessor
+				// memory pool and cached without a DXL string round trip
+				pmdobjNew = pmdp->Pimdobj(fShared ? m_pmp : pmp, this, pmdid);
+				fCache = (fCache && !(fShared && NULL != pmdobjNew));
+			}
+
+			if (NULL == pmdobjNew)
+			{
+				CAutoP<CWStringBase> a_pstr;
+				a_pstr = pmdp->PstrObject(m_pmp, this, pmdid);
+
+				GPOS_ASSERT(NULL != a_pstr.Pt());
+
+				if (fCache && m_pmp == pmp)
+				{
+					// create the accessor memory pool
+					pmp = a_pmdcacc->Pmp();
+				}
+
+				pmdobjNew = gpdxl::CDXLUtils::PimdobjParseDXL(pmp, a_pstr.Pt(), NULL /* XSD path */);
+			}
 			GPOS_ASSERT(NULL != pmdobjNew);
 
 			if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
@@ -617,49 +724,13 @@ CMDAccessor::Pimdobj
 			// so for such objects, we bypass the MD cache, getting them from the
 			// MD provider, directly to the local hash table
 
-			if (IMDId::EmdidGPDBCtas != pmdid->Emdidt())
+			if (fCache)
 			{
-				// add to MD cache
-				CAutoP<CMDKey> a_pmdkeyCache;
-				// ref count of the new object is set to one and optimizer becomes its owner
-				a_pmdkeyCache = GPOS_NEW(pmp) CMDKey(pmdobjNew->Pmdid());
-
-				// object gets pinned independent of whether insertion succeeded or
-				// failed because object was already in cache
-
-#ifdef GPOS_DEBUG
-				IMDCacheObject *pmdobjInserted =
-#endif
-				a_pmdcacc->PtInsert(a_pmdkeyCache.Pt(), pmdobjNew);
-
-				GPOS_ASSERT(NULL != pmdobjInserted);
-
-				// safely inserted
-				(void) a_pmdkeyCache.PtReset();
+				CacheObject(a_pmdcacc.Pt(), pmp, pmdobjNew);
 			}
 		}
 
-		{
-			// store in local hashtable
-			GPOS_ASSERT(NULL != pmdobjNew);
-			IMDId *pmdidNew = pmdobjNew->Pmdid();
-			pmdidNew->AddRef();
-
-			CAutoP<SMDAccessorElem> a_pmdaccelem;
-			a_pmdaccelem = GPOS_NEW(m_pmp) SMDAccessorElem(pmdobjNew, pmdidNew);
-
-			MDHTAccessor mdhtacc(m_shtCacheAccessors, a_pmdaccelem->Pmdid());
-
-			if (NULL == mdhtacc.PtLookup())
-			{
-				// object has not been inserted in the meantime
-				mdhtacc.Insert(a_pmdaccelem.Pt());
-
-				// add deletion lock for mdid
-				a_pmdaccelem->Pmdid()->AddDeletionLock();
-				a_pmdaccelem.PtReset();
-			}
-		}
+		StoreObject(pmdobjNew);
 	}
 	
 	// requested object must be in local hashtable already: retrieve it
@@ -681,6 +752,170 @@ CMDAccessor::Pimdobj
 	return pimdobj;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessor::FMissing
+//
+//	@doc:
+//		Checks whether the object with the given mdid has to be fetched from
+//		its provider, i.e., it is neither in the local hashtable, nor in the
+//		MD cache or its snapshot; CTAS objects bypass the MD cache and are
+//		never prefetched
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDAccessor::FMissing
+	(
+	IMDId *pmdid
+	)
+{
+	if (!IMDId::FValid(pmdid) || IMDId::EmdidGPDBCtas == pmdid->Emdidt())
+	{
+		return false;
+	}
+
+	{
+		// scope for ht accessor
+		MDHTAccessor mdhtacc(m_shtCacheAccessors, pmdid);
+		if (NULL != mdhtacc.PtLookup())
+		{
+			return false;
+		}
+	}
+
+	CMDKey mdkey(pmdid);
+	CacheAccessorMD mdcacc(m_pcache);
+	mdcacc.Lookup(&mdkey);
+	if (NULL != mdcacc.PtVal())
+	{
+		return false;
+	}
+
+	// objects in the snapshot of the MD cache are restored on lookup
+	const CMDSnapshot *pmdsnap = CMDCache::Psnapshot();
+
+	return NULL == pmdsnap || CMDCache::Pcache() != m_pcache || !pmdsnap->FContains(pmdid);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessor::FetchObjects
+//
+//	@doc:
+//		Requests the given objects from their provider in a single round
+//		trip and stores them in the MD cache and the local hashtable. Objects
+//		the provider does not supply in the batch, or all objects if the
+//		provider does not batch requests, are fetched when first used.
+//		Takes ownership of the mdid array.
+//
+//---------------------------------------------------------------------------
+void
+CMDAccessor::FetchObjects
+	(
+	IMDProvider *pmdp,
+	DrgPmdid *pdrgpmdid
+	)
+{
+	GPOS_ASSERT(NULL != pmdp);
+
+	CAutoRef<CMDRequest> a_pmdr;
+	a_pmdr = GPOS_NEW(m_pmp) CMDRequest(m_pmp, pdrgpmdid, GPOS_NEW(m_pmp) CMDRequest::DrgPtr(m_pmp));
+
+	CTimerUser timerFetch;  // timer to measure fetch time
+
+	CAutoRef<DrgPstr> a_pdrgpstr;
+	a_pdrgpstr = pmdp->PdrgpstrObjects(m_pmp, this, a_pmdr.Pt());
+	if (NULL == a_pdrgpstr.Pt())
+	{
+		return;
+	}
+
+	const ULONG ulObjects = a_pdrgpstr->UlLength();
+	GPOS_ASSERT(ulObjects == pdrgpmdid->UlLength());
+
+	for (ULONG ul = 0; ul < ulObjects; ul++)
+	{
+		const CWStringBase *pstr = (*a_pdrgpstr)[ul];
+		if (0 == pstr->UlLength())
+		{
+			continue;
+		}
+
+		CAutoP<CacheAccessorMD> a_pmdcacc;
+		a_pmdcacc = GPOS_NEW(m_pmp) CacheAccessorMD(m_pcache);
+
+		// create the accessor memory pool
+		IMemoryPool *pmp = a_pmdcacc->Pmp();
+		IMDCacheObject *pmdobj = gpdxl::CDXLUtils::PimdobjParseDXL(pmp, pstr, NULL /* XSD path */);
+		GPOS_ASSERT(pmdobj->Pmdid()->FEquals((*pdrgpmdid)[ul]));
+
+		CacheObject(a_pmdcacc.Pt(), pmp, pmdobj);
+		StoreObject(pmdobj);
+	}
+
+	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
+	{
+		// add fetch time in msec
+		CDouble dFetch(timerFetch.UlElapsedUS() / CDouble(GPOS_USEC_IN_MSEC));
+		m_dFetchTime = CDouble(m_dFetchTime.DVal() + dFetch.DVal());
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessor::Prefetch
+//
+//	@doc:
+//		Fetches the objects with the given mdids which are not cached yet,
+//		sending a single request to the provider of each source system
+//		instead of one request per object when the objects are first used
+//
+//---------------------------------------------------------------------------
+void
+CMDAccessor::Prefetch
+	(
+	const DrgPmdid *pdrgpmdid
+	)
+{
+	GPOS_ASSERT(NULL != pdrgpmdid);
+
+	const ULONG ulMdids = pdrgpmdid->UlLength();
+
+	// mdids already assigned to a request
+	CAutoRef<HSMDId> a_phsmdid;
+	a_phsmdid = GPOS_NEW(m_pmp) HSMDId(m_pmp);
+
+	for (ULONG ul = 0; ul < ulMdids; ul++)
+	{
+		IMDId *pmdid = (*pdrgpmdid)[ul];
+		if (!FMissing(pmdid) || a_phsmdid->FExists(pmdid))
+		{
+			continue;
+		}
+
+		// collect the missing objects of the same source system
+		CSystemId sysid = pmdid->Sysid();
+		DrgPmdid *pdrgpmdidMissing = GPOS_NEW(m_pmp) DrgPmdid(m_pmp);
+		for (ULONG ulOther = ul; ulOther < ulMdids; ulOther++)
+		{
+			IMDId *pmdidOther = (*pdrgpmdid)[ulOther];
+			if (!FMissing(pmdidOther) ||
+				!pmdidOther->Sysid().FEquals(sysid) ||
+				a_phsmdid->FExists(pmdidOther))
+			{
+				continue;
+			}
+
+			pmdidOther->AddRef();
+			(void) a_phsmdid->FInsert(pmdidOther);
+			pmdidOther->AddRef();
+			pdrgpmdidMissing->Append(pmdidOther);
+		}
+
+		FetchObjects(Pmdp(sysid), pdrgpmdidMissing);
+	}
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDAccessor::Pmdrel
@@ -1101,12 +1336,14 @@ CMDAccessor::RecordColumnStats
 	BOOL fEmptyTable,
 	HMUlHist *phmulhist,
 	HMUlDouble *phmuldoubleWidth,
+	HMUlHLL *phmulhll,
 	CStatisticsConfig *pstatsconf
 	)
 {
 	GPOS_ASSERT(NULL != pmdidRel);
 	GPOS_ASSERT(NULL != phmulhist);
 	GPOS_ASSERT(NULL != phmuldoubleWidth);
+	GPOS_ASSERT(NULL != phmulhll);
 
 	// get the column statistics
 	const IMDColStats *pmdcolstats = Pmdcolstats(pmp, pmdidRel, ulPos);
@@ -1121,6 +1358,27 @@ CMDAccessor::RecordColumnStats
 	IMDId *pmdidType = pmdrel->Pmdcol(ulPos)->PmdidType();
 	CHistogram *phist = Phist(pmp, pmdidType, pmdcolstats);
 	GPOS_ASSERT(NULL != phist);
+
+	// a sketch of the column values gives a more accurate number of distinct
+	// values than the sampled histogram, and is kept to merge with the
+	// sketches of other relations
+	const CDXLHLLSketch *pdxlhllsketch = pmdcolstats->Pdxlhllsketch();
+	if (NULL != pdxlhllsketch && !phist->FColStatsMissing())
+	{
+		const ULONG ulRegisters = pdxlhllsketch->UlRegisters();
+		BYTE *pbaRegisters = GPOS_NEW_ARRAY(pmp, BYTE, ulRegisters);
+		(void) clib::PvMemCpy(pbaRegisters, pdxlhllsketch->PbaRegisters(), ulRegisters);
+		CHLLSketch *phll = GPOS_NEW(pmp) CHLLSketch(pdxlhllsketch->UlPrecision(), pbaRegisters);
+
+		phist->ScaleNDVs(phll->DDistinct());
+		phmulhll->FInsert(GPOS_NEW(pmp) ULONG(ulColId), phll);
+	}
+
+	// base table histograms are filtered and joined by many alternatives and
+	// shared by the statistics derived from them; build their compact buckets
+	// once the NDVs are final and while the histogram is not shared yet
+	phist->BuildCompact(pmp);
+
 	phmulhist->FInsert(GPOS_NEW(pmp) ULONG(ulColId), phist);
 
 	BOOL fGuc = GPOS_FTRACE(EopttracePrintColsWithMissingStats);
@@ -1191,6 +1449,11 @@ CMDAccessor::Pstats
 
 	HMUlHist *phmulhist = GPOS_NEW(pmp) HMUlHist(pmp);
 	HMUlDouble *phmuldoubleWidth = GPOS_NEW(pmp) HMUlDouble(pmp);
+	HMUlHLL *phmulhll = GPOS_NEW(pmp) HMUlHLL(pmp);
+
+	// attribute numbers of the columns with histograms and their column ids
+	DrgPi *pdrgpiAttnoHist = GPOS_NEW(pmp) DrgPi(pmp);
+	DrgPul *pdrgpulColIdHist = GPOS_NEW(pmp) DrgPul(pmp);
 
 	CColRefSetIter crsiHist(*pcrsHist);
 	while (crsiHist.FAdvance())
@@ -1205,6 +1468,9 @@ CMDAccessor::Pstats
 		INT iAttno = pcrtable->IAttno();
 		ULONG ulPos = pmdrel->UlPosFromAttno(iAttno);
 
+		pdrgpiAttnoHist->Append(GPOS_NEW(pmp) INT(iAttno));
+		pdrgpulColIdHist->Append(GPOS_NEW(pmp) ULONG(ulColId));
+
 		RecordColumnStats
 			(
 			pmp,
@@ -1215,6 +1481,7 @@ CMDAccessor::Pstats
 			fEmptyTable,
 			phmulhist,
 			phmuldoubleWidth,
+			phmulhll,
 			pstatsconf
 			);
 	}
@@ -1240,7 +1507,7 @@ CMDAccessor::Pstats
 
 	CDouble dRows = std::max(DOUBLE(1.0), pmdRelStats->DRows().DVal());
 
-	return GPOS_NEW(pmp) CStatistics
+	CStatistics *pstats = GPOS_NEW(pmp) CStatistics
 							(
 							pmp,
 							phmulhist,
@@ -1248,6 +1515,54 @@ CMDAccessor::Pstats
 							dRows,
 							fEmptyTable
 							);
+
+	HMIterUlHLL hmiterulhll(phmulhll);
+	while (hmiterulhll.FAdvance())
+	{
+		CHLLSketch *phll = const_cast<CHLLSketch *>(hmiterulhll.Pt());
+		phll->AddRef();
+		pstats->AddHLLSketch(pmp, *(hmiterulhll.Pk()), phll);
+	}
+	phmulhll->Release();
+
+	// add the extended statistics whose columns all have histograms
+	const ULONG ulExtendedStats = pmdRelStats->UlExtendedStats();
+	for (ULONG ul = 0; ul < ulExtendedStats; ul++)
+	{
+		const CDXLExtendedStats *pdxlextstats = pmdRelStats->Pdxlextstats(ul);
+		const DrgPi *pdrgpiAttno = pdxlextstats->PdrgpiAttno();
+
+		DrgPul *pdrgpulColId = GPOS_NEW(pmp) DrgPul(pmp);
+		const ULONG ulCols = pdrgpiAttno->UlLength();
+		for (ULONG ulCol = 0; ulCol < ulCols; ulCol++)
+		{
+			INT iAttno = *(*pdrgpiAttno)[ulCol];
+			for (ULONG ulHist = 0; ulHist < pdrgpiAttnoHist->UlLength(); ulHist++)
+			{
+				if (iAttno == *(*pdrgpiAttnoHist)[ulHist])
+				{
+					pdrgpulColId->Append(GPOS_NEW(pmp) ULONG(*(*pdrgpulColIdHist)[ulHist]));
+					break;
+				}
+			}
+		}
+
+		if (ulCols != pdrgpulColId->UlLength())
+		{
+			pdrgpulColId->Release();
+			continue;
+		}
+
+		pstats->AddMultiColumnStats
+				(
+				GPOS_NEW(pmp) CMultiColumnStats(pmp, pdrgpulColId, pdxlextstats->DDistinct(), pdxlextstats->DDependency())
+				);
+	}
+
+	pdrgpiAttnoHist->Release();
+	pdrgpulColIdHist->Release();
+
+	return pstats;
 }
 
 
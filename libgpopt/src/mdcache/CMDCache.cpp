@@ -9,9 +9,18 @@
 //		 Function implementation of CMDCache
 //---------------------------------------------------------------------------
 
+#include "gpos/common/CAutoRef.h"
+#include "gpos/io/ioutils.h"
+#include "gpos/memory/CAutoMemoryPool.h"
 #include "gpos/task/CAutoTraceFlag.h"
 
 #include "gpopt/mdcache/CMDCache.h"
+#include "gpopt/mdcache/CMDSnapshot.h"
+
+#include "naucrates/md/CMDIdColStats.h"
+#include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/md/CMDIdRelStats.h"
+#include "naucrates/md/IMDRelation.h"
 
 using namespace gpos;
 using namespace gpmd;
@@ -24,6 +33,9 @@ CMDAccessor::MDCache *CMDCache::m_pcache = NULL;
 // maximum size of the cache
 ULLONG CMDCache::m_ullCacheQuota = UNLIMITED_CACHE_QUOTA;
 
+// loaded snapshot of the cache
+CMDSnapshot *CMDCache::m_pmdsnap = NULL;
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDCache::Init
@@ -58,6 +70,8 @@ CMDCache::Init()
 void
 CMDCache::Shutdown()
 {
+	DropSnapshot();
+
 	GPOS_DELETE(m_pcache);
 	m_pcache = NULL;
 }
@@ -132,4 +146,439 @@ CMDCache::Reset()
 	Init();
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::FSameObject
+//
+//	@doc:
+//		Do the given mdids identify the same object, possibly in different
+//		versions; statistics are the same object if they are derived from
+//		the same relation
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDCache::FSameObject
+	(
+	const IMDId *pmdidFst,
+	const IMDId *pmdidSnd
+	)
+{
+	if (pmdidFst->Emdidt() != pmdidSnd->Emdidt())
+	{
+		return false;
+	}
+
+	switch (pmdidFst->Emdidt())
+	{
+		case IMDId::EmdidGPDB:
+			return pmdidFst->Sysid().FEquals(pmdidSnd->Sysid()) &&
+					CMDIdGPDB::PmdidConvert(pmdidFst)->OidObjectId() == CMDIdGPDB::PmdidConvert(pmdidSnd)->OidObjectId();
+
+		case IMDId::EmdidRelStats:
+			return FSameObject
+					(
+					CMDIdRelStats::PmdidConvert(pmdidFst)->PmdidRel(),
+					CMDIdRelStats::PmdidConvert(pmdidSnd)->PmdidRel()
+					);
+
+		case IMDId::EmdidColStats:
+			return CMDIdColStats::PmdidConvert(pmdidFst)->UlPos() == CMDIdColStats::PmdidConvert(pmdidSnd)->UlPos() &&
+					FSameObject
+					(
+					CMDIdColStats::PmdidConvert(pmdidFst)->PmdidRel(),
+					CMDIdColStats::PmdidConvert(pmdidSnd)->PmdidRel()
+					);
+
+		default:
+			return pmdidFst->FEquals(pmdidSnd);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::FRelationOrStats
+//
+//	@doc:
+//		Does the mdid identify a version of the given relation or statistics
+//		of a version of the relation
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDCache::FRelationOrStats
+	(
+	const IMDId *pmdid,
+	const IMDId *pmdidRel
+	)
+{
+	switch (pmdid->Emdidt())
+	{
+		case IMDId::EmdidRelStats:
+			return FSameObject(CMDIdRelStats::PmdidConvert(pmdid)->PmdidRel(), pmdidRel);
+
+		case IMDId::EmdidColStats:
+			return FSameObject(CMDIdColStats::PmdidConvert(pmdid)->PmdidRel(), pmdidRel);
+
+		default:
+			return FSameObject(pmdid, pmdidRel);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::FMatchMdid
+//
+//	@doc:
+//		Match the entry of the object with the given mdid
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDCache::FMatchMdid
+	(
+	CMDKey *pmdkey,
+	const void *pvArg
+	)
+{
+	return pmdkey->Pmdid()->FEquals(static_cast<const IMDId *>(pvArg));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::FMatchStale
+//
+//	@doc:
+//		Match the entries of the versions of an object other than the given
+//		one, and of statistics derived from those versions
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDCache::FMatchStale
+	(
+	CMDKey *pmdkey,
+	const void *pvArg
+	)
+{
+	const IMDId *pmdid = pmdkey->Pmdid();
+	const IMDId *pmdidCurrent = static_cast<const IMDId *>(pvArg);
+
+	if (FSameObject(pmdid, pmdidCurrent))
+	{
+		return !pmdid->FEquals(pmdidCurrent);
+	}
+
+	// statistics of another version of a relation
+	const IMDId *pmdidRel = NULL;
+	if (IMDId::EmdidRelStats == pmdid->Emdidt())
+	{
+		pmdidRel = CMDIdRelStats::PmdidConvert(pmdid)->PmdidRel();
+	}
+	else if (IMDId::EmdidColStats == pmdid->Emdidt())
+	{
+		pmdidRel = CMDIdColStats::PmdidConvert(pmdid)->PmdidRel();
+	}
+
+	return NULL != pmdidRel && FSameObject(pmdidRel, pmdidCurrent) && !pmdidRel->FEquals(pmdidCurrent);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::FMatchRelation
+//
+//	@doc:
+//		Match the entries of the versions of a relation, their statistics,
+//		and the indexes, triggers and check constraints of the relation
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDCache::FMatchRelation
+	(
+	CMDKey *pmdkey,
+	const void *pvArg
+	)
+{
+	const IMDId *pmdid = pmdkey->Pmdid();
+	const SRelationArg *pra = static_cast<const SRelationArg *>(pvArg);
+
+	if (FRelationOrStats(pmdid, pra->m_pmdidRel))
+	{
+		return true;
+	}
+
+	const IMDRelation *pmdrel = pra->m_pmdrel;
+	if (NULL == pmdrel)
+	{
+		return false;
+	}
+
+	const ULONG ulIndices = pmdrel->UlIndices();
+	for (ULONG ul = 0; ul < ulIndices; ul++)
+	{
+		if (pmdid->FEquals(pmdrel->PmdidIndex(ul)))
+		{
+			return true;
+		}
+	}
+
+	const ULONG ulTriggers = pmdrel->UlTriggers();
+	for (ULONG ul = 0; ul < ulTriggers; ul++)
+	{
+		if (pmdid->FEquals(pmdrel->PmdidTrigger(ul)))
+		{
+			return true;
+		}
+	}
+
+	const ULONG ulCheckConstraints = pmdrel->UlCheckConstraints();
+	for (ULONG ul = 0; ul < ulCheckConstraints; ul++)
+	{
+		if (pmdid->FEquals(pmdrel->PmdidCheckConstraint(ul)))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::FMatchSystem
+//
+//	@doc:
+//		Match the entries of the objects of a source system
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDCache::FMatchSystem
+	(
+	CMDKey *pmdkey,
+	const void *pvArg
+	)
+{
+	return pmdkey->Pmdid()->Sysid().FEquals(*static_cast<const CSystemId *>(pvArg));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::UlInvalidate
+//
+//	@doc:
+//		Invalidate the object with the given mdid; sessions using the object
+//		keep it until they release it, later lookups fetch it again from the
+//		provider rather than the loaded snapshot. Returns the number of
+//		cache entries invalidated.
+//
+//---------------------------------------------------------------------------
+ULONG
+CMDCache::UlInvalidate
+	(
+	IMDId *pmdid
+	)
+{
+	GPOS_ASSERT(NULL != m_pcache && "Metadata cache was not created");
+	GPOS_ASSERT(NULL != pmdid);
+
+	if (NULL != m_pmdsnap)
+	{
+		(void) m_pmdsnap->UlInvalidate(pmdid);
+	}
+
+	return m_pcache->UlInvalidate(FMatchMdid, pmdid);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::UlInvalidateStale
+//
+//	@doc:
+//		Invalidate the versions of an object other than the given one, and
+//		statistics derived from them. Lookups only match the exact version
+//		of an object, so outdated entries are never used; this releases the
+//		memory they hold once a new version is known.
+//
+//---------------------------------------------------------------------------
+ULONG
+CMDCache::UlInvalidateStale
+	(
+	IMDId *pmdid
+	)
+{
+	GPOS_ASSERT(NULL != m_pcache && "Metadata cache was not created");
+	GPOS_ASSERT(NULL != pmdid);
+
+	if (NULL != m_pmdsnap)
+	{
+		(void) m_pmdsnap->UlInvalidate(FMatchStale, pmdid, false /*fMatchUnknown*/);
+	}
+
+	return m_pcache->UlInvalidate(FMatchStale, pmdid);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::UlInvalidateRelation
+//
+//	@doc:
+//		Invalidate all versions of a relation with their statistics; the
+//		indexes, triggers and check constraints of the relation are taken
+//		from the relation with the given mdid in the cache or, failing that,
+//		in the loaded snapshot
+//
+//---------------------------------------------------------------------------
+ULONG
+CMDCache::UlInvalidateRelation
+	(
+	IMDId *pmdidRel
+	)
+{
+	GPOS_ASSERT(NULL != m_pcache && "Metadata cache was not created");
+	GPOS_ASSERT(NULL != pmdidRel);
+
+	// pin the cached relation while its dependent objects are matched; its
+	// entry is removed when the accessor releases it
+	CCacheAccessor<IMDCacheObject*, CMDKey*> mdcacc(m_pcache);
+	CMDKey mdkey(pmdidRel);
+	mdcacc.Lookup(&mdkey);
+
+	// a relation only in the snapshot is restored to find its dependent objects
+	CAutoMemoryPool amp;
+	CAutoRef<IMDCacheObject> a_pmdobj;
+	const IMDCacheObject *pmdobj = mdcacc.PtVal();
+	if (NULL == pmdobj && NULL != m_pmdsnap)
+	{
+		a_pmdobj = m_pmdsnap->Pimdobj(amp.Pmp(), pmdidRel);
+		pmdobj = a_pmdobj.Pt();
+	}
+
+	SRelationArg ra;
+	ra.m_pmdidRel = pmdidRel;
+	ra.m_pmdrel = dynamic_cast<const IMDRelation *>(pmdobj);
+
+	if (NULL != m_pmdsnap)
+	{
+		(void) m_pmdsnap->UlInvalidate(FMatchRelation, &ra, false /*fMatchUnknown*/);
+	}
+
+	return m_pcache->UlInvalidate(FMatchRelation, &ra);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::UlInvalidateSystem
+//
+//	@doc:
+//		Invalidate the objects of the given source system; snapshot records
+//		whose mdids carry no known system are invalidated as well
+//
+//---------------------------------------------------------------------------
+ULONG
+CMDCache::UlInvalidateSystem
+	(
+	CSystemId sysid
+	)
+{
+	GPOS_ASSERT(NULL != m_pcache && "Metadata cache was not created");
+
+	if (NULL != m_pmdsnap)
+	{
+		(void) m_pmdsnap->UlInvalidate(FMatchSystem, &sysid, true /*fMatchUnknown*/);
+	}
+
+	return m_pcache->UlInvalidate(FMatchSystem, &sysid);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::FLoadSnapshot
+//
+//	@doc:
+//		Load a snapshot of the cache, replacing a loaded one; like
+//		initializing the cache, this must not overlap with optimization
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDCache::FLoadSnapshot
+	(
+	const CHAR *szFileName
+	)
+{
+	GPOS_ASSERT(NULL != szFileName);
+
+	DropSnapshot();
+
+	if (!ioutils::FPathExist(szFileName))
+	{
+		return false;
+	}
+
+	IMemoryPool *pmp = CMemoryPoolManager::Pmpm()->PmpCreate
+							(
+							CMemoryPoolManager::EatTracker,
+							true /*fThreadSafe*/,
+							ULLONG_MAX
+							);
+	GPOS_TRY
+	{
+		m_pmdsnap = CMDSnapshot::PmdsnapLoad(pmp, szFileName);
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		// destroy memory pool if snapshot was not loaded
+		CMemoryPoolManager::Pmpm()->Destroy(pmp);
+
+		GPOS_RETHROW(ex);
+	}
+	GPOS_CATCH_END;
+
+	if (NULL == m_pmdsnap)
+	{
+		CMemoryPoolManager::Pmpm()->Destroy(pmp);
+		return false;
+	}
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::SaveSnapshot
+//
+//	@doc:
+//		Save the objects of the cache in a snapshot file
+//
+//---------------------------------------------------------------------------
+void
+CMDCache::SaveSnapshot
+	(
+	const CHAR *szFileName
+	)
+{
+	GPOS_ASSERT(NULL != m_pcache && "Metadata cache was not created");
+
+	CAutoMemoryPool amp;
+	CMDSnapshot::Save(amp.Pmp(), m_pcache, szFileName);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::DropSnapshot
+//
+//	@doc:
+//		Drop the loaded snapshot of the cache
+//
+//---------------------------------------------------------------------------
+void
+CMDCache::DropSnapshot()
+{
+	if (NULL == m_pmdsnap)
+	{
+		return;
+	}
+
+	IMemoryPool *pmp = m_pmdsnap->Pmp();
+	GPOS_DELETE(m_pmdsnap);
+	m_pmdsnap = NULL;
+
+	CMemoryPoolManager::Pmpm()->Destroy(pmp);
+}
+
 // EOF
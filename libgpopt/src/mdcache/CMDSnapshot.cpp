@@ -0,0 +1,693 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMDSnapshot.cpp
+//
+//	@doc:
+//		Implementation of snapshots of the metadata cache
+//---------------------------------------------------------------------------
+
+#include "gpos/common/CAutoP.h"
+#include "gpos/common/CAutoRef.h"
+#include "gpos/common/CAutoRg.h"
+#include "gpos/io/ioutils.h"
+#include "gpos/io/CFileReader.h"
+#include "gpos/string/CStringStatic.h"
+#include "gpos/string/CWStringConst.h"
+
+#include "gpopt/mdcache/CMDKey.h"
+#include "gpopt/mdcache/CMDSnapshot.h"
+
+#include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/xml/CDXLBinaryFormat.h"
+#include "naucrates/dxl/xml/dxltokens.h"
+#include "naucrates/exception.h"
+#include "naucrates/md/CMDIdColStats.h"
+#include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/md/CMDIdRelStats.h"
+#include "naucrates/md/IMDCacheObject.h"
+
+using namespace gpos;
+using namespace gpmd;
+using namespace gpopt;
+using namespace gpdxl;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDSnapshot::CMDSnapshot
+//
+//	@doc:
+//		Ctor; takes ownership of the file content
+//
+//---------------------------------------------------------------------------
+CMDSnapshot::CMDSnapshot
+	(
+	IMemoryPool *pmp,
+	BYTE *pba,
+	ULONG ulLength
+	)
+	:
+	m_pmp(pmp),
+	m_pba(pba),
+	m_ulLength(ulLength),
+	m_phmstrrec(NULL)
+{
+	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(NULL != pba);
+
+	m_phmstrrec = GPOS_NEW(pmp) HMStrRecord(pmp);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDSnapshot::~CMDSnapshot
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CMDSnapshot::~CMDSnapshot()
+{
+	m_phmstrrec->Release();
+	GPOS_DELETE_ARRAY(m_pba);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDSnapshot::UlHashMdid
+//
+//	@doc:
+//		Hash function for mdid strings
+//
+//---------------------------------------------------------------------------
+ULONG
+CMDSnapshot::UlHashMdid
+	(
+	const CWStringBase *pstr
+	)
+{
+	return gpos::UlHashByteArray((const BYTE *) pstr->Wsz(), pstr->UlLength() * GPOS_SIZEOF(WCHAR));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDSnapshot::FEqualMdids
+//
+//	@doc:
+//		Equality function for mdid strings
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDSnapshot::FEqualMdids
+	(
+	const CWStringBase *pstrFst,
+	const CWStringBase *pstrSnd
+	)
+{
+	return pstrFst->FEquals(pstrSnd);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDSnapshot::WriteUl
+//
+//	@doc:
+//		Write an unsigned integer as four bytes, least significant first
+//
+//---------------------------------------------------------------------------
+void
+CMDSnapshot::WriteUl
+	(
+	CFileWriter *pfw,
+	ULONG ul
+	)
+{
+	BYTE rgb[4];
+	for (ULONG ulByte = 0; ulByte < GPOS_ARRAY_SIZE(rgb); ulByte++)
+	{
+		rgb[ulByte] = (BYTE) (ul >> (8 * ulByte));
+	}
+
+	pfw->Write(rgb, GPOS_ARRAY_SIZE(rgb));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDSnapshot::FReadUl
+//
+//	@doc:
+//		Read an unsigned integer at the given position and advance it;
+//		returns false if the snapshot ends before the integer
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDSnapshot::FReadUl
+	(
+	ULONG *pulPos,
+	ULONG *pul
+	)
+	const
+{
+	if (4 > m_ulLength - *pulPos)
+	{
+		return false;
+	}
+
+	*pul = 0;
+	for (ULONG ulByte = 0; ulByte < 4; ulByte++)
+	{
+		*pul |= ((ULONG) m_pba[*pulPos + ulByte]) << (8 * ulByte);
+	}
+	*pulPos += 4;
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDSnapshot::UlChecksum
+//
+//	@doc:
+//		Checksum of a binary DXL document, written with its record
+//
+//---------------------------------------------------------------------------
+ULONG
+CMDSnapshot::UlChecksum
+	(
+	const BYTE *pba,
+	ULONG ulLength
+	)
+{
+	return gpos::UlHashByteArray(pba, ulLength);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDSnapshot::FValidHeader
+//
+//	@doc:
+//		Check that the snapshot was written in this snapshot format, with
+//		binary DXL documents of this format version and token table
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDSnapshot::FValidHeader() const
+{
+	if (EhdrSize > m_ulLength ||
+		EhdrMagic0 != m_pba[0] ||
+		EhdrMagic1 != m_pba[1] ||
+		EhdrMagic2 != m_pba[2] ||
+		EhdrMagic3 != m_pba[3])
+	{
+		return false;
+	}
+
+	ULONG ulPos = 4;
+	ULONG ulVersion = 0;
+	ULONG ulBinaryVersion = 0;
+	ULONG ulTokensHash = 0;
+
+	return FReadUl(&ulPos, &ulVersion) &&
+			FReadUl(&ulPos, &ulBinaryVersion) &&
+			FReadUl(&ulPos, &ulTokensHash) &&
+			EhdrVersion == ulVersion &&
+			CDXLBinaryFormat::EhdrVersion == ulBinaryVersion &&
+			CDXLTokens::UlTokensHash() == ulTokensHash;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDSnapshot::IndexRecords
+//
+//	@doc:
+//		Map the mdid strings of the records to their binary DXL documents;
+//		a record cut short, e.g., by a failure while saving, ends the index
+//
+//---------------------------------------------------------------------------
+void
+CMDSnapshot::IndexRecords()
+{
+	ULONG ulPos = EhdrSize;
+	ULONG ulMdidLength = 0;
+	while (FReadUl(&ulPos, &ulMdidLength) && ulMdidLength <= m_ulLength - ulPos)
+	{
+		CAutoRg<CHAR> a_szMdid(GPOS_NEW_ARRAY(m_pmp, CHAR, ulMdidLength + 1));
+		(void) clib::PvMemCpy(a_szMdid.Rgt(), m_pba + ulPos, ulMdidLength);
+		a_szMdid[ulMdidLength] = '\0';
+		ulPos += ulMdidLength;
+
+		ULONG ulLength = 0;
+		ULONG ulChecksum = 0;
+		if (!FReadUl(&ulPos, &ulLength) ||
+			!FReadUl(&ulPos, &ulChecksum) ||
+			ulLength > m_ulLength - ulPos)
+		{
+			break;
+		}
+
+		CWStringBase *pstrMdid = CDXLUtils::PstrFromSz(m_pmp, a_szMdid.Rgt());
+		if (NULL == m_phmstrrec->PtLookup(pstrMdid))
+		{
+			IMDId *pmdid = PmdidParse(m_pmp, a_szMdid.Rgt());
+			(void) m_phmstrrec->FInsert(pstrMdid, GPOS_NEW(m_pmp) SRecord(ulPos, ulLength, ulChecksum, pmdid));
+		}
+		else
+		{
+			GPOS_DELETE(pstrMdid);
+		}
+		ulPos += ulLength;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDSnapshot::PmdidParse
+//
+//	@doc:
+//		Mdid of a relation, statistics or other GPDB object from the string
+//		written for it, i.e., SystemType.Oid.Major.Minor, followed by the
+//		attno for column statistics; returns NULL for other mdids
+//
+//---------------------------------------------------------------------------
+IMDId *
+CMDSnapshot::PmdidParse
+	(
+	IMemoryPool *pmp,
+	const CHAR *szMdid
+	)
+{
+	const ULONG ulMaxParts = 5;
+	ULONG rgul[ulMaxParts];
+	ULONG ulParts = 0;
+
+	const CHAR *sz = szMdid;
+	while (ulParts < ulMaxParts)
+	{
+		CHAR *szEnd = NULL;
+		LINT l = clib::LStrToL(sz, &szEnd, 10 /*ulBase*/);
+		if (szEnd == sz)
+		{
+			return NULL;
+		}
+
+		// parts are written as signed integers
+		rgul[ulParts++] = (ULONG) l;
+		sz = szEnd;
+		if ('\0' == *sz)
+		{
+			break;
+		}
+
+		if ('.' != *sz)
+		{
+			return NULL;
+		}
+		sz++;
+	}
+
+	if ('\0' != *sz)
+	{
+		return NULL;
+	}
+
+	switch (rgul[0])
+	{
+		case IMDId::EmdidGPDB:
+			if (4 == ulParts)
+			{
+				return GPOS_NEW(pmp) CMDIdGPDB(rgul[1], rgul[2], rgul[3]);
+			}
+			break;
+
+		case IMDId::EmdidRelStats:
+			if (4 == ulParts)
+			{
+				return GPOS_NEW(pmp) CMDIdRelStats(GPOS_NEW(pmp) CMDIdGPDB(rgul[1], rgul[2], rgul[3]));
+			}
+			break;
+
+		case IMDId::EmdidColStats:
+			if (5 == ulParts)
+			{
+				return GPOS_NEW(pmp) CMDIdColStats(GPOS_NEW(pmp) CMDIdGPDB(rgul[1], rgul[2], rgul[3]), rgul[4]);
+			}
+			break;
+
+		default:
+			break;
+	}
+
+	return NULL;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDSnapshot::FContains
+//
+//	@doc:
+//		Does the snapshot have an object with the given mdid
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDSnapshot::FContains
+	(
+	IMDId *pmdid
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pmdid);
+
+	CWStringConst strMdid(pmdid->Wsz());
+	const SRecord *prec = m_phmstrrec->PtLookup(&strMdid);
+
+	return NULL != prec && prec->FValid();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDSnapshot::PimdobjParse
+//
+//	@doc:
+//		Parse the binary DXL document of a record into the given memory
+//		pool; returns NULL if the document does not match its checksum,
+//		fails to parse, or does not hold exactly the object with the given
+//		mdid
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+CMDSnapshot::PimdobjParse
+	(
+	IMemoryPool *pmp,
+	const SRecord *prec,
+	IMDId *pmdid
+	)
+	const
+{
+	const BYTE *pba = m_pba + prec->m_ulOffset;
+	if (prec->m_ulChecksum != UlChecksum(pba, prec->m_ulLength))
+	{
+		return NULL;
+	}
+
+	CAutoRef<DrgPimdobj> a_pdrgpmdobj;
+	GPOS_TRY
+	{
+		a_pdrgpmdobj = CDXLUtils::PdrgpmdobjParseBinaryDXL(pmp, pba, prec->m_ulLength);
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		// errors other than those of a malformed document are not
+		// caused by the record
+		if (gpdxl::ExmaDXL != ex.UlMajor() && gpdxl::ExmaMD != ex.UlMajor())
+		{
+			GPOS_RETHROW(ex);
+		}
+
+		GPOS_RESET_EX;
+
+		return NULL;
+	}
+	GPOS_CATCH_END;
+
+	if (1 != a_pdrgpmdobj->UlLength() || !(*a_pdrgpmdobj)[0]->Pmdid()->FEquals(pmdid))
+	{
+		return NULL;
+	}
+
+	IMDCacheObject *pmdobj = (*a_pdrgpmdobj)[0];
+	pmdobj->AddRef();
+
+	return pmdobj;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDSnapshot::Pimdobj
+//
+//	@doc:
+//		Parse the object with the given mdid into the given memory pool;
+//		returns NULL if the snapshot has no object with this mdid, or if
+//		its record is corrupt, in which case the record is invalidated so
+//		that the object is fetched from its provider
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+CMDSnapshot::Pimdobj
+	(
+	IMemoryPool *pmp,
+	IMDId *pmdid
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pmdid);
+
+	CWStringConst strMdid(pmdid->Wsz());
+	const SRecord *prec = m_phmstrrec->PtLookup(&strMdid);
+	if (NULL == prec || !prec->FValid())
+	{
+		return NULL;
+	}
+
+	IMDCacheObject *pmdobj = PimdobjParse(pmp, prec, pmdid);
+	if (NULL == pmdobj)
+	{
+		(void) prec->FInvalidate();
+	}
+
+	return pmdobj;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDSnapshot::UlInvalidate
+//
+//	@doc:
+//		Invalidate the record of the object with the given mdid, so that
+//		the object is no longer restored from the snapshot. Records are
+//		only marked, the index is not changed, so this may overlap with
+//		lookups.
+//
+//---------------------------------------------------------------------------
+ULONG
+CMDSnapshot::UlInvalidate
+	(
+	IMDId *pmdid
+	)
+{
+	GPOS_ASSERT(NULL != pmdid);
+
+	CWStringConst strMdid(pmdid->Wsz());
+	const SRecord *prec = m_phmstrrec->PtLookup(&strMdid);
+	if (NULL != prec && prec->FInvalidate())
+	{
+		return 1;
+	}
+
+	return 0;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDSnapshot::UlInvalidate
+//
+//	@doc:
+//		Invalidate the records whose mdids match, using the match functions
+//		of the MD cache; the mdid of a record whose type is not known
+//		cannot be matched, its record is invalidated if fMatchUnknown is set
+//
+//---------------------------------------------------------------------------
+ULONG
+CMDSnapshot::UlInvalidate
+	(
+	CMDAccessor::MDCache::MatchFuncPtr pfuncMatch,
+	const void *pvArg,
+	BOOL fMatchUnknown
+	)
+{
+	GPOS_ASSERT(NULL != pfuncMatch);
+
+	ULONG ulInvalidated = 0;
+
+	HMStrRecordIter hmstrrecit(m_phmstrrec);
+	while (hmstrrecit.FAdvance())
+	{
+		const SRecord *prec = hmstrrecit.Pt();
+		if (!prec->FValid())
+		{
+			continue;
+		}
+
+		BOOL fMatch = fMatchUnknown;
+		if (NULL != prec->m_pmdid)
+		{
+			CMDKey mdkey(prec->m_pmdid);
+			fMatch = pfuncMatch(&mdkey, pvArg);
+		}
+
+		if (fMatch && prec->FInvalidate())
+		{
+			ulInvalidated++;
+		}
+	}
+
+	return ulInvalidated;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDSnapshot::PmdsnapLoad
+//
+//	@doc:
+//		Read a snapshot file and index its records; returns NULL if the file
+//		was written in another snapshot or binary DXL format, e.g., by
+//		another version of the optimizer
+//
+//---------------------------------------------------------------------------
+CMDSnapshot *
+CMDSnapshot::PmdsnapLoad
+	(
+	IMemoryPool *pmp,
+	const CHAR *szFileName
+	)
+{
+	GPOS_ASSERT(NULL != szFileName);
+
+	CFileReader fr;
+	fr.Open(szFileName);
+
+	// records are addressed by 32-bit offsets
+	const ULLONG ullSize = fr.UllSize();
+	if (ullSize >= (ULLONG) ULONG_MAX)
+	{
+		fr.Close();
+		return NULL;
+	}
+
+	const ULONG ulLength = (ULONG) ullSize;
+	CAutoRg<BYTE> a_pba(GPOS_NEW_ARRAY(pmp, BYTE, ulLength + 1));
+
+	const ULONG ulRead = (ULONG) fr.UlpRead(a_pba.Rgt(), ulLength);
+	fr.Close();
+
+	CAutoP<CMDSnapshot> a_pmdsnap;
+	a_pmdsnap = GPOS_NEW(pmp) CMDSnapshot(pmp, a_pba.RgtReset(), ulRead);
+	if (!a_pmdsnap->FValidHeader())
+	{
+		return NULL;
+	}
+
+	a_pmdsnap->IndexRecords();
+
+	return a_pmdsnap.PtReset();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDSnapshot::WriteObject
+//
+//	@doc:
+//		Write the record of a cached object to the snapshot file
+//
+//---------------------------------------------------------------------------
+void
+CMDSnapshot::WriteObject
+	(
+	IMDCacheObject *pmdobj,
+	void *pvArg
+	)
+{
+	GPOS_ASSERT(NULL != pmdobj);
+	GPOS_ASSERT(NULL != pvArg);
+
+	SWriteArg *pwa = static_cast<SWriteArg *>(pvArg);
+	IMemoryPool *pmp = pwa->m_pmp;
+
+	CAutoRef<DrgPimdobj> a_pdrgpmdobj;
+	a_pdrgpmdobj = GPOS_NEW(pmp) DrgPimdobj(pmp);
+	pmdobj->AddRef();
+	a_pdrgpmdobj->Append(pmdobj);
+
+	ULONG ulLength = 0;
+	CAutoRg<BYTE> a_pba(CDXLUtils::PbaSerializeMetadata(pmp, a_pdrgpmdobj.Pt(), &ulLength));
+	CAutoRg<CHAR> a_szMdid(CDXLUtils::SzFromWsz(pmp, pmdobj->Pmdid()->Wsz()));
+	const ULONG ulMdidLength = clib::UlStrLen(a_szMdid.Rgt());
+
+	WriteUl(pwa->m_pfw, ulMdidLength);
+	pwa->m_pfw->Write((const BYTE *) a_szMdid.Rgt(), ulMdidLength);
+	WriteUl(pwa->m_pfw, ulLength);
+	WriteUl(pwa->m_pfw, UlChecksum(a_pba.Rgt(), ulLength));
+	pwa->m_pfw->Write(a_pba.Rgt(), ulLength);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDSnapshot::Save
+//
+//	@doc:
+//		Save the objects of the given cache in a snapshot file; entries are
+//		only pinned while their object is written, so the cache can be used
+//		concurrently. The snapshot is written to a new file in a temporary
+//		directory next to the given path and then renamed over it, so that
+//		processes loading the snapshot never see a partially written file.
+//
+//---------------------------------------------------------------------------
+void
+CMDSnapshot::Save
+	(
+	IMemoryPool *pmp,
+	CMDAccessor::MDCache *pcache,
+	const CHAR *szFileName
+	)
+{
+	GPOS_ASSERT(NULL != pcache);
+	GPOS_ASSERT(NULL != szFileName);
+
+	CHAR szDir[GPOS_FILE_NAME_BUF_SIZE];
+	CStringStatic strDir(szDir, GPOS_ARRAY_SIZE(szDir));
+	strDir.AppendFormat("%s.XXXXXX", szFileName);
+	ioutils::SzMkDTemp(szDir);
+
+	CHAR szTmpFile[GPOS_FILE_NAME_BUF_SIZE];
+	CStringStatic strTmpFile(szTmpFile, GPOS_ARRAY_SIZE(szTmpFile));
+	strTmpFile.AppendFormat("%s/snapshot", szDir);
+
+	GPOS_TRY
+	{
+		const ULONG ulWrPerms = S_IRUSR | S_IWUSR;
+
+		CFileWriter fw;
+		fw.Open(szTmpFile, ulWrPerms);
+
+		const BYTE rgbMagic[] = {EhdrMagic0, EhdrMagic1, EhdrMagic2, EhdrMagic3};
+		fw.Write(rgbMagic, GPOS_ARRAY_SIZE(rgbMagic));
+		WriteUl(&fw, EhdrVersion);
+		WriteUl(&fw, CDXLBinaryFormat::EhdrVersion);
+		WriteUl(&fw, CDXLTokens::UlTokensHash());
+
+		SWriteArg wa;
+		wa.m_pmp = pmp;
+		wa.m_pfw = &fw;
+		pcache->Visit(WriteObject, &wa);
+
+		fw.Close();
+
+		ioutils::Rename(szTmpFile, szFileName);
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		if (ioutils::FPathExist(szTmpFile))
+		{
+			ioutils::Unlink(szTmpFile);
+		}
+		ioutils::RmDir(szDir);
+
+		GPOS_RETHROW(ex);
+	}
+	GPOS_CATCH_END;
+
+	ioutils::RmDir(szDir);
+}
+
+// EOF
@@ -12,6 +12,7 @@
 #include "gpos/base.h"
 #include "gpos/common/CAutoTimer.h"
 #include "gpos/common/CAutoRef.h"
+#include "gpos/common/CAutoRg.h"
 #include "gpos/common/CBitSet.h"
 #include "gpos/common/syslibwrapper.h"
 #include "gpos/error/CAutoTrace.h"
@@ -26,6 +27,7 @@
 
 #include "naucrates/traceflags/traceflags.h"
 #include "naucrates/dxl/parser/CParseHandlerDXL.h"
+#include "naucrates/dxl/CDXLParallelParser.h"
 #include "naucrates/dxl/CDXLUtils.h"
 #include "naucrates/md/CMDProviderMemory.h"
 
@@ -73,7 +75,14 @@ CMinidumperUtils::PdxlmdLoad
 		at.Os() << "parsing DXL File " << szFileName;
 	}
 	
-	CParseHandlerDXL *pphdxl = CDXLUtils::PphdxlParseDXLFile(pmp, szFileName, NULL /*szXSDPath*/);
+	// minidumps of large queries carry many metadata objects, which are
+	// parsed on worker tasks
+	CParseHandlerDXL *pphdxl = NULL;
+	{
+		CAutoRg<CHAR> a_szDXL;
+		a_szDXL = CDXLUtils::SzRead(pmp, szFileName);
+		pphdxl = CDXLParallelParser::PphdxlParse(pmp, a_szDXL.Rgt(), CDXLParallelParser::ulParallelElementsMin);
+	}
 
 	CBitSet *pbs = pphdxl->Pbs();
 	COptimizerConfig *poconf = pphdxl->Poconf();
@@ -378,6 +387,10 @@ CMinidumperUtils::PdxlnExecuteMinidump
 		GPOS_UNSET_TRACE(EopttraceEnableConstantExpressionEvaluation);
 	}
 
+	// xform utility statistics of the replaying process do not apply to the
+	// dumped query, which was optimized with the full search strategy
+	GPOS_UNSET_TRACE(EopttraceEnableAdaptiveXformBudget);
+
 	CErrorHandlerStandard errhdl;
 	GPOS_TRY_HDL(&errhdl)
 	{
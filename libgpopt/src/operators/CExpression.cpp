@@ -68,6 +68,7 @@ CExpression::CExpression
 	m_pdpscalar(NULL),
 	m_pgexpr(pgexpr),
 	m_cost(GPOPT_INVALID_COST),
+	m_dRuntimeFilterSelectivity(1.0),
 	m_ulOriginGrpId(ULONG_MAX),
 	m_ulOriginGrpExprId(ULONG_MAX)
 {
@@ -106,6 +107,7 @@ CExpression::CExpression
 	m_pdpscalar(NULL),
 	m_pgexpr(NULL),
 	m_cost(GPOPT_INVALID_COST),
+	m_dRuntimeFilterSelectivity(1.0),
 	m_ulOriginGrpId(ULONG_MAX),
 	m_ulOriginGrpExprId(ULONG_MAX)
 {
@@ -146,6 +148,7 @@ CExpression::CExpression
 	m_pdpscalar(NULL),
 	m_pgexpr(NULL),
 	m_cost(GPOPT_INVALID_COST),
+	m_dRuntimeFilterSelectivity(1.0),
 	m_ulOriginGrpId(ULONG_MAX),
 	m_ulOriginGrpExprId(ULONG_MAX)
 {
@@ -190,6 +193,7 @@ CExpression::CExpression
 	m_pdpscalar(NULL),
 	m_pgexpr(NULL),
 	m_cost(GPOPT_INVALID_COST),
+	m_dRuntimeFilterSelectivity(1.0),
 	m_ulOriginGrpId(ULONG_MAX),
 	m_ulOriginGrpExprId(ULONG_MAX)
 {
@@ -234,6 +238,7 @@ CExpression::CExpression
 	m_pdpscalar(NULL),
 	m_pgexpr(NULL),
 	m_cost(GPOPT_INVALID_COST),
+	m_dRuntimeFilterSelectivity(1.0),
 	m_ulOriginGrpId(ULONG_MAX),
 	m_ulOriginGrpExprId(ULONG_MAX)
 {
@@ -258,7 +263,8 @@ CExpression::CExpression
 	CGroupExpression *pgexpr,
 	DrgPexpr *pdrgpexpr,
 	IStatistics *pstatsInput,
-	CCost cost
+	CCost cost,
+	CDouble dRuntimeFilterSelectivity
 	)
 	:
 	m_pmp(pmp),
@@ -271,6 +277,7 @@ CExpression::CExpression
 	m_pdpscalar(NULL),
 	m_pgexpr(pgexpr),
 	m_cost(cost),
+	m_dRuntimeFilterSelectivity(dRuntimeFilterSelectivity),
 	m_ulOriginGrpId(ULONG_MAX),
 	m_ulOriginGrpExprId(ULONG_MAX)
 {
@@ -1391,7 +1398,7 @@ CExpression::PexprRehydrate
 		pdrgpcost->Release();
 	}
 	CExpression *pexpr = GPOS_NEW(pmp) CExpression(pmp, pop, pgexpr, pdrgpexpr,
-                                              pcc->Pstats(), CCost(cost));
+                                              pcc->Pstats(), CCost(cost), pcc->DRuntimeFilterSelectivity());
 
 	// set the number of expected partition selectors in the context
 	pdpctxtplan->SetExpectedPartitionSelectors(pop, pcc);
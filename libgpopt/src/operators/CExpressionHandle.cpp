@@ -550,6 +550,10 @@ CExpressionHandle::DeriveRootStats
 	{
 		// otherwise, derive stats using root operator
 		pstatsRoot = popLogical->PstatsDerive(m_pmp, *this, pdrgpstatCtxt);
+		if (0 < UlArity())
+		{
+			pstatsRoot = PstatsPruneHistograms(pstatsRoot);
+		}
 	}
 	GPOS_ASSERT(NULL != pstatsRoot);
 
@@ -557,6 +561,45 @@ CExpressionHandle::DeriveRootStats
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CExpressionHandle::PstatsPruneHistograms
+//
+//	@doc:
+//		Operators carry over the histograms of their children, including
+//		histograms of columns only used by the operator itself or by its
+//		descendants; drop histograms of columns that are not in the required
+//		stat columns, which hold all columns referenced by ancestors, and
+//		keep their widths only; stats of leaf operators are not pruned since
+//		they may load histograms for their own use, e.g. distribution columns
+//
+//---------------------------------------------------------------------------
+IStatistics *
+CExpressionHandle::PstatsPruneHistograms
+	(
+	IStatistics *pstats
+	)
+{
+	GPOS_ASSERT(NULL != pstats);
+	GPOS_ASSERT(NULL != m_prp);
+
+	CColRefSet *pcrsStat = CReqdPropRelational::Prprel(m_prp)->PcrsStat();
+	CColRefSet *pcrsHist = pstats->Pcrs(m_pmp);
+	BOOL fPrune = !pcrsStat->FSubset(pcrsHist);
+	pcrsHist->Release();
+
+	if (!fPrune)
+	{
+		return pstats;
+	}
+
+	IStatistics *pstatsPruned = pstats->PstatsPruneHistograms(m_pmp, pcrsStat);
+	pstats->Release();
+
+	return pstatsPruned;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CExpressionHandle::DeriveStats
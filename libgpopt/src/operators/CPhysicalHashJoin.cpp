@@ -27,6 +27,8 @@
 #include "gpopt/operators/CScalarIdent.h"
 #include "gpopt/operators/CScalarConst.h"
 
+#include "naucrates/traceflags/traceflags.h"
+
 using namespace gpopt;
 
 // number of non-redistribute requests created by hash join
@@ -35,6 +37,12 @@ using namespace gpopt;
 // maximum number of redistribute requests on single hash join keys
 #define GPOPT_MAX_HASH_DIST_REQUESTS	6
 
+// maximum fraction of outer rows passing a runtime filter for the filter to be planned
+#define GPOPT_RUNTIME_FILTER_MAX_SELECTIVITY	0.5
+
+// maximum ratio of inner to outer rows for a runtime filter to be planned
+#define GPOPT_RUNTIME_FILTER_MAX_BUILD_RATIO	0.1
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CPhysicalHashJoin::CPhysicalHashJoin
@@ -801,4 +809,51 @@ CPhysicalHashJoin::FNullableHashKey
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CPhysicalHashJoin::DRuntimeFilterSelectivity
+//
+//	@doc:
+//		Selectivity of a runtime filter built from the inner keys while
+//		building the hash table and applied to the outer child before its
+//		tuples reach the join; the fraction of outer rows having a match is
+//		derived from the join cardinality estimated using join histograms;
+//		a filter is planned for inner and semi joins with a small inner
+//		side and a selective join, when the outer child is in the same
+//		slice as the join, i.e., no motion feeds the outer side;
+//		return 1.0 if no runtime filter is planned
+//
+//---------------------------------------------------------------------------
+CDouble
+CPhysicalHashJoin::DRuntimeFilterSelectivity
+	(
+	COperator *popJoin,
+	BOOL fOuterMotion,
+	DOUBLE dRowsOuter,
+	DOUBLE dRowsInner,
+	DOUBLE dRows
+	)
+{
+	GPOS_ASSERT(NULL != popJoin);
+
+	COperator::EOperatorId eopid = popJoin->Eopid();
+	if (!GPOS_FTRACE(EopttraceEnableRuntimeFilter) ||
+		(COperator::EopPhysicalInnerHashJoin != eopid && COperator::EopPhysicalLeftSemiHashJoin != eopid) ||
+		fOuterMotion ||
+		0.0 >= dRowsOuter ||
+		dRowsInner > GPOPT_RUNTIME_FILTER_MAX_BUILD_RATIO * dRowsOuter)
+	{
+		return CDouble(1.0);
+	}
+
+	// an outer row passes the filter if it has at least one match
+	DOUBLE dSelectivity = std::min(1.0, dRows / dRowsOuter);
+	if (GPOPT_RUNTIME_FILTER_MAX_SELECTIVITY < dSelectivity)
+	{
+		return CDouble(1.0);
+	}
+
+	return CDouble(dSelectivity);
+}
+
 // EOF
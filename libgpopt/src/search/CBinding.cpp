@@ -11,6 +11,7 @@
 
 #include "gpopt/operators/CPattern.h"
 #include "gpopt/search/CBinding.h"
+#include "gpopt/search/CBindingHandle.h"
 #include "gpopt/search/CGroupProxy.h"
 #include "gpopt/search/CMemo.h"
 
@@ -19,6 +20,57 @@
 
 using namespace gpopt;
 
+// initial number of buckets of first bindings map
+#define GPOPT_BINDING_HT_BUCKETS 31
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBinding::SBindingKey::UlHash
+//
+//	@doc:
+//		Hash function
+//
+//---------------------------------------------------------------------------
+ULONG
+CBinding::SBindingKey::UlHash
+	(
+	const SBindingKey *pbk
+	)
+{
+	GPOS_ASSERT(NULL != pbk);
+
+	return gpos::UlCombineHashes
+			(
+			gpos::UlHashPtr<CGroup>(pbk->m_pgroup),
+			gpos::UlHashPtr<CExpression>(pbk->m_pexprPattern)
+			);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBinding::SBindingKey::FEqual
+//
+//	@doc:
+//		Equality function
+//
+//---------------------------------------------------------------------------
+BOOL
+CBinding::SBindingKey::FEqual
+	(
+	const SBindingKey *pbkFst,
+	const SBindingKey *pbkSnd
+	)
+{
+	GPOS_ASSERT(NULL != pbkFst);
+	GPOS_ASSERT(NULL != pbkSnd);
+
+	return pbkFst->m_pgroup == pbkSnd->m_pgroup &&
+			pbkFst->m_pexprPattern == pbkSnd->m_pexprPattern;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CBinding::PgexprNext
@@ -70,6 +122,7 @@ CBinding::PexprExpandPattern
 	ULONG ulPos,
 	ULONG ulArity
 	)
+	const
 {
 	GPOS_ASSERT_IMP
 		(
@@ -136,7 +189,10 @@ CBinding::PexprFinalize
 //
 //	@doc:
 //		Extract a binding according to a given pattern;
-//		Keep root node fixed;
+//		Keep root node fixed; extracting the first binding of a group
+//		expression starts a new sequence of bindings, the memo may have
+//		changed since the previous sequence, so the first bindings of child
+//		groups shared within a sequence are discarded
 //
 //---------------------------------------------------------------------------
 CExpression *
@@ -147,6 +203,34 @@ CBinding::PexprExtract
 	CExpression *pexprPattern,
 	CExpression *pexprLast
 	)
+{
+	if (NULL == pexprLast && NULL != m_phmbe)
+	{
+		m_phmbe->Release();
+		m_phmbe = NULL;
+	}
+
+	return PexprExtractFromGExpr(pmp, pgexpr, pexprPattern, pexprLast);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBinding::PexprExtractFromGExpr
+//
+//	@doc:
+//		Extract a binding of a group expression according to a given
+//		pattern within the current sequence of bindings
+//
+//---------------------------------------------------------------------------
+CExpression *
+CBinding::PexprExtractFromGExpr
+	(
+	IMemoryPool *pmp,
+	CGroupExpression *pgexpr,
+	CExpression *pexprPattern,
+	CExpression *pexprLast
+	)
 {
 	GPOS_CHECK_ABORT;
 
@@ -192,6 +276,70 @@ CBinding::PexprExtract
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CBinding::PexprExtractFirst
+//
+//	@doc:
+//		Extract first binding from a group; a transformation does not add
+//		to the memo while its bindings are extracted, and other jobs only
+//		append group expressions to groups, so the first binding of a group
+//		for a given pattern does not change within a sequence of bindings
+//		and is shared instead of being materialized again whenever a child
+//		cursor is reset
+//
+//---------------------------------------------------------------------------
+CExpression *
+CBinding::PexprExtractFirst
+	(
+	IMemoryPool *pmp,
+	CGroup *pgroup,
+	CExpression *pexprPattern
+	)
+{
+	GPOS_ASSERT(NULL != pgroup);
+	GPOS_ASSERT(NULL != pexprPattern);
+
+	if (!m_fShareFirstBindings)
+	{
+		return PexprExtract(pmp, pgroup, pexprPattern, NULL /*pexprLast*/);
+	}
+
+	SBindingKey bk(pgroup, pexprPattern);
+	CExpression *pexpr = NULL;
+	if (NULL != m_phmbe)
+	{
+		pexpr = m_phmbe->PtLookup(&bk);
+	}
+
+	if (NULL != pexpr)
+	{
+		pexpr->AddRef();
+		return pexpr;
+	}
+
+	pexpr = PexprExtract(pmp, pgroup, pexprPattern, NULL /*pexprLast*/);
+	if (NULL == pexpr)
+	{
+		return NULL;
+	}
+
+	if (NULL == m_phmbe)
+	{
+		m_phmbe = GPOS_NEW(pmp) HMBindingExpr(pmp, GPOPT_BINDING_HT_BUCKETS);
+	}
+
+	pexpr->AddRef();
+#ifdef GPOS_DEBUG
+	BOOL fInserted =
+#endif // GPOS_DEBUG
+		m_phmbe->FInsert(GPOS_NEW(pmp) SBindingKey(pgroup, pexprPattern), pexpr);
+	GPOS_ASSERT(fInserted);
+
+	return pexpr;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CBinding::FInitChildCursors
@@ -219,8 +367,7 @@ CBinding::FInitChildCursors
 	{
 		CGroup *pgroup = (*pgexpr)[ul];
 		CExpression *pexprPatternChild = PexprExpandPattern(pexprPattern, ul, ulArity);
-		CExpression *pexprNewChild =
-			PexprExtract(pmp, pgroup, pexprPatternChild, NULL /*pexprLastChild*/);
+		CExpression *pexprNewChild = PexprExtractFirst(pmp, pgroup, pexprPatternChild);
 
 		if (NULL == pexprNewChild)
 		{
@@ -293,7 +440,7 @@ CBinding::FAdvanceChildCursors
 			if (NULL == pexprNewChild)
 			{
 				// cursor is exhausted, we need to reset it
-				pexprNewChild = PexprExtract(pmp, pgroup, pexprPatternChild, NULL /*pexprLastChild*/);
+				pexprNewChild = PexprExtractFirst(pmp, pgroup, pexprPatternChild);
 				ulExhaustedCursors++;
 			}
 			else
@@ -410,7 +557,7 @@ CBinding::PexprExtract
 			return NULL;
 		}
 
-		return PexprExtract(pmp, pgexpr, pexprPattern, pexprLast);
+		return PexprExtractFromGExpr(pmp, pgexpr, pexprPattern, pexprLast);
 	}
 
 	// start position for next binding
@@ -420,7 +567,7 @@ CBinding::PexprExtract
 		if (pexprPattern->FMatchPattern(pgexpr))
 		{
 			CExpression *pexprResult =
-				PexprExtract(pmp, pgexpr, pexprPattern, pexprStart);
+				PexprExtractFromGExpr(pmp, pgexpr, pexprPattern, pexprStart);
 			if (NULL != pexprResult)
 			{
 				return pexprResult;
@@ -440,4 +587,342 @@ CBinding::PexprExtract
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CBinding::FBindGExpr
+//
+//	@doc:
+//		Bind handle to the first binding of the given group expression;
+//		pattern leaves and trees bind to the group as a whole, tree patterns
+//		therefore yield a single binding of their group
+//
+//---------------------------------------------------------------------------
+BOOL
+CBinding::FBindGExpr
+	(
+	CBindingHandle *pbh,
+	CGroupExpression *pgexpr,
+	CExpression *pexprPattern
+	)
+	const
+{
+	GPOS_CHECK_STACK_SIZE;
+	GPOS_ASSERT(NULL != pbh);
+	GPOS_ASSERT(NULL != pgexpr);
+	GPOS_ASSERT(NULL != pexprPattern);
+
+	if (!pexprPattern->FMatchPattern(pgexpr))
+	{
+		// shallow matching fails
+		return false;
+	}
+
+	if (pexprPattern->Pop()->FPattern())
+	{
+		pbh->Bind(pexprPattern, pgexpr, 0 /*ulArity*/);
+		return true;
+	}
+
+	const ULONG ulArity = pgexpr->UlArity();
+	if (ulArity < pexprPattern->UlArity())
+	{
+		// does not have enough children
+		return false;
+	}
+
+	pbh->Bind(pexprPattern, pgexpr, ulArity);
+	for (ULONG ul = 0; ul < ulArity; ul++)
+	{
+		CExpression *pexprPatternChild = PexprExpandPattern(pexprPattern, ul, ulArity);
+		if (!FBindGroup(pbh->PbhChild(ul), (*pgexpr)[ul], pexprPatternChild))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBinding::FBindGroup
+//
+//	@doc:
+//		Bind handle to the first binding of the given group
+//
+//---------------------------------------------------------------------------
+BOOL
+CBinding::FBindGroup
+	(
+	CBindingHandle *pbh,
+	CGroup *pgroup,
+	CExpression *pexprPattern
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pgroup);
+
+	CGroupExpression *pgexpr = PgexprNext(pgroup, NULL);
+	GPOS_ASSERT(NULL != pgexpr);
+
+	if (pexprPattern->Pop()->FPattern())
+	{
+		// for leaves and trees, we do not iterate on group expressions
+		return FBindGExpr(pbh, pgexpr, pexprPattern);
+	}
+
+	while (NULL != pgexpr)
+	{
+		if (FBindGExpr(pbh, pgexpr, pexprPattern))
+		{
+			return true;
+		}
+
+		pgexpr = PgexprNext(pgroup, pgexpr);
+
+		GPOS_CHECK_ABORT;
+	}
+
+	// group exhausted
+	return false;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBinding::FAdvanceGroup
+//
+//	@doc:
+//		Advance handle to the next binding within its group; advance the
+//		children of the bound group expression first, then move on to the
+//		next group expression, as PexprExtract does
+//
+//---------------------------------------------------------------------------
+BOOL
+CBinding::FAdvanceGroup
+	(
+	CBindingHandle *pbh
+	)
+	const
+{
+	GPOS_CHECK_STACK_SIZE;
+	GPOS_ASSERT(NULL != pbh);
+
+	if (pbh->FGroupBound())
+	{
+		// leaves and trees have a single binding
+		return false;
+	}
+
+	if (FAdvanceChildHandles(pbh))
+	{
+		return true;
+	}
+
+	CGroup *pgroup = pbh->Pgroup();
+	CExpression *pexprPattern = pbh->m_pexprPattern;
+	CGroupExpression *pgexpr = PgexprNext(pgroup, pbh->Pgexpr());
+	while (NULL != pgexpr)
+	{
+		if (FBindGExpr(pbh, pgexpr, pexprPattern))
+		{
+			return true;
+		}
+
+		pgexpr = PgexprNext(pgroup, pgexpr);
+
+		GPOS_CHECK_ABORT;
+	}
+
+	// group exhausted
+	return false;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBinding::FAdvanceChildHandles
+//
+//	@doc:
+//		Advance the first child handle that is not exhausted and reset the
+//		exhausted ones before it to their first binding
+//
+//---------------------------------------------------------------------------
+BOOL
+CBinding::FAdvanceChildHandles
+	(
+	CBindingHandle *pbh
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pbh);
+
+	const ULONG ulArity = pbh->UlArity();
+	for (ULONG ul = 0; ul < ulArity; ul++)
+	{
+		CBindingHandle *pbhChild = pbh->PbhChild(ul);
+		if (FAdvanceGroup(pbhChild))
+		{
+			return true;
+		}
+
+		// cursor is exhausted, we need to reset it
+#ifdef GPOS_DEBUG
+		BOOL fBound =
+#endif // GPOS_DEBUG
+			FBindGroup(pbhChild, (*pbh->Pgexpr())[ul], pbhChild->m_pexprPattern);
+		GPOS_ASSERT(fBound);
+	}
+
+	return false;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBinding::FBindFirst
+//
+//	@doc:
+//		Bind handle to the first binding of the given group expression;
+//		root node is kept fixed by subsequent bindings
+//
+//---------------------------------------------------------------------------
+BOOL
+CBinding::FBindFirst
+	(
+	CGroupExpression *pgexpr,
+	CExpression *pexprPattern,
+	CBindingHandle *pbh
+	)
+	const
+{
+	GPOS_CHECK_ABORT;
+
+	return FBindGExpr(pbh, pgexpr, pexprPattern);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBinding::FBindNext
+//
+//	@doc:
+//		Advance handle to the next binding of its group expression; no
+//		expression is built and the handle is re-bound in place
+//
+//---------------------------------------------------------------------------
+BOOL
+CBinding::FBindNext
+	(
+	CBindingHandle *pbh
+	)
+	const
+{
+	GPOS_CHECK_ABORT;
+	GPOS_ASSERT(pbh->FBound());
+
+	if (pbh->FGroupBound())
+	{
+		return false;
+	}
+
+	return FAdvanceChildHandles(pbh);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBinding::FMatchGroup
+//
+//	@doc:
+//		Check if given group has an expression that shallowly matches the
+//		root of given pattern
+//
+//---------------------------------------------------------------------------
+BOOL
+CBinding::FMatchGroup
+	(
+	CGroup *pgroup,
+	CExpression *pexprPattern
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pgroup);
+	GPOS_ASSERT(NULL != pexprPattern);
+
+	if (pexprPattern->Pop()->FPattern())
+	{
+		// pattern operators match any group expression
+		return true;
+	}
+
+	CGroupExpression *pgexpr = PgexprNext(pgroup, NULL);
+	while (NULL != pgexpr)
+	{
+		if (pexprPattern->FMatchPattern(pgexpr))
+		{
+			return true;
+		}
+
+		pgexpr = PgexprNext(pgroup, pgexpr);
+	}
+
+	return false;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBinding::FPossibleBinding
+//
+//	@doc:
+//		Check if a binding of the given pattern may exist for the given
+//		group expression; only the root of the pattern and the roots of
+//		its children are matched, and no expression is extracted;
+//		a false result guarantees that PexprExtract finds no binding
+//
+//---------------------------------------------------------------------------
+BOOL
+CBinding::FPossibleBinding
+	(
+	CGroupExpression *pgexpr,
+	CExpression *pexprPattern
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pgexpr);
+	GPOS_ASSERT(NULL != pexprPattern);
+
+	if (!pexprPattern->FMatchPattern(pgexpr))
+	{
+		return false;
+	}
+
+	COperator *popPattern = pexprPattern->Pop();
+	if (popPattern->FPattern() && CPattern::PopConvert(popPattern)->FLeaf())
+	{
+		return true;
+	}
+
+	const ULONG ulArity = pgexpr->UlArity();
+	if (ulArity < pexprPattern->UlArity())
+	{
+		// does not have enough children
+		return false;
+	}
+
+	for (ULONG ul = 0; ul < ulArity; ul++)
+	{
+		CExpression *pexprPatternChild = PexprExpandPattern(pexprPattern, ul, ulArity);
+		if (!FMatchGroup((*pgexpr)[ul], pexprPatternChild))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
 // EOF
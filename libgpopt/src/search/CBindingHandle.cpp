@@ -0,0 +1,259 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CBindingHandle.cpp
+//
+//	@doc:
+//		Implementation of lazy binding of a pattern to the memo
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+
+#include "gpopt/base/CDrvdPropRelational.h"
+#include "gpopt/base/CDrvdPropScalar.h"
+#include "gpopt/search/CBindingHandle.h"
+#include "gpopt/search/CGroup.h"
+#include "gpopt/search/CGroupExpression.h"
+
+using namespace gpopt;
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBindingHandle::CBindingHandle
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CBindingHandle::CBindingHandle
+	(
+	IMemoryPool *pmp
+	)
+	:
+	m_pmp(pmp),
+	m_pexprPattern(NULL),
+	m_pgexpr(NULL),
+	m_pdrgpbh(NULL),
+	m_ulArity(0)
+{
+	GPOS_ASSERT(NULL != pmp);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBindingHandle::~CBindingHandle
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CBindingHandle::~CBindingHandle()
+{
+	CRefCount::SafeRelease(m_pdrgpbh);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBindingHandle::Bind
+//
+//	@doc:
+//		Bind handle to a group expression; the expression is not ref-counted
+//		since the memo outlives the binding of a transformation
+//
+//---------------------------------------------------------------------------
+void
+CBindingHandle::Bind
+	(
+	CExpression *pexprPattern,
+	CGroupExpression *pgexpr,
+	ULONG ulArity
+	)
+{
+	GPOS_ASSERT(NULL != pexprPattern);
+	GPOS_ASSERT(NULL != pgexpr);
+	GPOS_ASSERT(ulArity <= pgexpr->UlArity());
+
+	m_pexprPattern = pexprPattern;
+	m_pgexpr = pgexpr;
+	m_ulArity = ulArity;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBindingHandle::PbhChild
+//
+//	@doc:
+//		Return n-th child handle, child handles are allocated once and
+//		re-bound by subsequent bindings
+//
+//---------------------------------------------------------------------------
+CBindingHandle *
+CBindingHandle::PbhChild
+	(
+	ULONG ulPos
+	)
+{
+	if (NULL == m_pdrgpbh)
+	{
+		m_pdrgpbh = GPOS_NEW(m_pmp) DrgPbh(m_pmp);
+	}
+
+	while (m_pdrgpbh->UlLength() <= ulPos)
+	{
+		m_pdrgpbh->Append(GPOS_NEW(m_pmp) CBindingHandle(m_pmp));
+	}
+
+	return (*m_pdrgpbh)[ulPos];
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBindingHandle::Pgroup
+//
+//	@doc:
+//		Bound group
+//
+//---------------------------------------------------------------------------
+CGroup *
+CBindingHandle::Pgroup() const
+{
+	GPOS_ASSERT(FBound());
+
+	return m_pgexpr->Pgroup();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBindingHandle::Pop
+//
+//	@doc:
+//		Operator of bound group expression
+//
+//---------------------------------------------------------------------------
+COperator *
+CBindingHandle::Pop() const
+{
+	GPOS_ASSERT(FBound());
+
+	return m_pgexpr->Pop();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBindingHandle::FGroupBound
+//
+//	@doc:
+//		Is the group bound as a whole by a pattern leaf or tree
+//
+//---------------------------------------------------------------------------
+BOOL
+CBindingHandle::FGroupBound() const
+{
+	GPOS_ASSERT(FBound());
+
+	return m_pexprPattern->Pop()->FPattern();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBindingHandle::operator[]
+//
+//	@doc:
+//		N-th bound child
+//
+//---------------------------------------------------------------------------
+const CBindingHandle &
+CBindingHandle::operator[]
+	(
+	ULONG ulPos
+	)
+	const
+{
+	GPOS_ASSERT(ulPos < m_ulArity);
+
+	return *(*m_pdrgpbh)[ulPos];
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBindingHandle::Pdprel
+//
+//	@doc:
+//		Relational properties of bound group
+//
+//---------------------------------------------------------------------------
+CDrvdPropRelational *
+CBindingHandle::Pdprel() const
+{
+	GPOS_ASSERT(!Pgroup()->FScalar());
+
+	return CDrvdPropRelational::Pdprel(Pgroup()->Pdp());
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBindingHandle::Pdpscalar
+//
+//	@doc:
+//		Scalar properties of bound group
+//
+//---------------------------------------------------------------------------
+CDrvdPropScalar *
+CBindingHandle::Pdpscalar() const
+{
+	GPOS_ASSERT(Pgroup()->FScalar());
+
+	return CDrvdPropScalar::Pdpscalar(Pgroup()->Pdp());
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBindingHandle::Pexpr
+//
+//	@doc:
+//		Build expression of binding; a group bound as a whole becomes a leaf
+//		that carries the properties of its group, as leaf patterns do
+//
+//---------------------------------------------------------------------------
+CExpression *
+CBindingHandle::Pexpr
+	(
+	IMemoryPool *pmp
+	)
+	const
+{
+	GPOS_CHECK_STACK_SIZE;
+	GPOS_ASSERT(FBound());
+
+	COperator *pop = m_pgexpr->Pop();
+	pop->AddRef();
+
+	if (FGroupBound())
+	{
+		return GPOS_NEW(pmp) CExpression(pmp, pop, m_pgexpr);
+	}
+
+	DrgPexpr *pdrgpexpr = GPOS_NEW(pmp) DrgPexpr(pmp);
+	for (ULONG ul = 0; ul < m_ulArity; ul++)
+	{
+		pdrgpexpr->Append((*this)[ul].Pexpr(pmp));
+	}
+
+	return GPOS_NEW(pmp) CExpression(pmp, pop, m_pgexpr, pdrgpexpr, NULL /*pstatsInput*/);
+}
+
+
+// EOF
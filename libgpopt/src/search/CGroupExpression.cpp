@@ -17,6 +17,7 @@
 #include "gpopt/base/CUtils.h"
 #include "gpopt/base/COptimizationContext.h"
 #include "gpopt/operators/ops.h"
+#include "gpopt/search/CBindingHandle.h"
 #include "gpopt/search/CGroupExpression.h"
 #include "gpopt/search/CGroupProxy.h"
 
@@ -805,6 +806,60 @@ CGroupExpression::PostprocessTransform
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CGroupExpression::TransformBindings
+//
+//	@doc:
+//		Apply transformation to lazy bindings of group expression; the
+//		xform inspects each binding through the memo and builds expressions
+//		only for its results
+//
+//---------------------------------------------------------------------------
+void
+CGroupExpression::TransformBindings
+	(
+	IMemoryPool *pmp,
+	CXform *pxform,
+	CXformContext *pxfctxt,
+	CXformResult *pxfres,
+	ULONG *pulNumberOfBindings
+	)
+{
+	GPOS_ASSERT(pxform->FLazyBinding());
+	GPOS_ASSERT(!CXformUtils::FSubqueryDecorrelation(pxform));
+
+	CBinding binding;
+	CBindingHandle bh(pmp);
+
+	BOOL fBound = binding.FBindFirst(this, pxform->PexprPattern(), &bh);
+	while (fBound)
+	{
+		++(*pulNumberOfBindings);
+		pxform->TransformBinding(pxfctxt, pxfres, bh);
+
+		if (GPOS_FTRACE(EopttracePrintXform) && GPOS_FTRACE(EopttracePrintXformResults))
+		{
+			CExpression *pexpr = bh.Pexpr(pmp);
+			PrintXform(pmp, pxform, pexpr, pxfres);
+			pexpr->Release();
+		}
+
+		if (CXformUtils::FApplyOnce(pxform->Exfid()) ||
+			(0 < pxfres->Pdrgpexpr()->UlLength() &&
+			!CXformUtils::FApplyToNextBinding(pxform, NULL /*pexprLastBinding*/)))
+		{
+			// do not apply xform to other possible patterns
+			break;
+		}
+
+		fBound = binding.FBindNext(&bh);
+
+		GPOS_CHECK_ABORT;
+	}
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CGroupExpression::Transform
@@ -820,19 +875,22 @@ CGroupExpression::Transform
 	IMemoryPool *pmpLocal,
 	CXform *pxform,
 	CXformResult *pxfres,
-	ULONG *pulElapsedTime // output: elapsed time in millisecond
+	ULONG *pulElapsedTime, // output: elapsed time in millisecond
+	ULONG *pulNumberOfBindings // output: number of bindings extracted from the memo
 	)
 {
 	GPOS_ASSERT(NULL != pulElapsedTime);
+	GPOS_ASSERT(NULL != pulNumberOfBindings);
 	GPOS_CHECK_ABORT;
 
 	CTimerUser timer;
 
 	*pulElapsedTime = 0;
+	*pulNumberOfBindings = 0;
 	// check traceflag and compatibility with origin xform
 	if (GPOPT_FDISABLED_XFORM(pxform->Exfid())|| !pxform->FCompatible(m_exfidOrigin))
 	{
-		if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
+		if (GPOS_FTRACE(EopttracePrintOptimizationStatistics) || GPOS_FTRACE(EopttracePrintXformProfile))
 		{
 			*pulElapsedTime = timer.UlElapsedMS();
 		}
@@ -845,7 +903,7 @@ CGroupExpression::Transform
 	exprhdl.DeriveProps(NULL /*pdpctxt*/);
 	if (CXform::ExfpNone == pxform->Exfp(exprhdl))
 	{
-		if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
+		if (GPOS_FTRACE(EopttracePrintOptimizationStatistics) || GPOS_FTRACE(EopttracePrintXformProfile))
 		{
 			*pulElapsedTime = timer.UlElapsedMS();
 		}
@@ -860,9 +918,19 @@ CGroupExpression::Transform
 	CXformContext *pxfctxt = GPOS_NEW(pmp) CXformContext(pmp);
 
 	CExpression *pexprPattern = pxform->PexprPattern();
-	CExpression *pexpr = binding.PexprExtract(pmp, this, pexprPattern , NULL);
+	CExpression *pexpr = NULL;
+	if (pxform->FLazyBinding())
+	{
+		TransformBindings(pmp, pxform, pxfctxt, pxfres, pulNumberOfBindings);
+	}
+	else
+	{
+		pexpr = binding.PexprExtract(pmp, this, pexprPattern , NULL);
+	}
+
 	while (NULL != pexpr)
 	{
+		++(*pulNumberOfBindings);
 		pxform->Transform(pxfctxt, pxfres, pexpr);
 		PrintXform(pmp, pxform, pexpr, pxfres);
 
@@ -888,7 +956,7 @@ CGroupExpression::Transform
 	// post-prcoessing before applying xform to group expression
 	PostprocessTransform(pmpLocal, pmp, pxform);
 
-	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
+	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics) || GPOS_FTRACE(EopttracePrintXformProfile))
 	{
 		*pulElapsedTime = timer.UlElapsedMS();
 	}
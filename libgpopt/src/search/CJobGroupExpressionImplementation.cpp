@@ -133,13 +133,13 @@ CJobGroupExpressionImplementation::ScheduleApplicableTransformations
 {
 	GPOS_ASSERT(!FXformsScheduled());
 
-	// get all applicable xforms
-	COperator *pop = m_pgexpr->Pop();
-	CXformSet *pxfs = CLogical::PopConvert(pop)->PxfsCandidates(psc->PmpGlobal());
-
-	// intersect them with required xforms and schedule jobs
-	pxfs->Intersection(CXformFactory::Pxff()->PxfsImplementation());
-	pxfs->Intersection(psc->Peng()->PxfsCurrentStage());
+	// get all applicable xforms and schedule jobs
+	CXformSet *pxfs = psc->Peng()->PxfsApplicable
+								(
+								psc->PmpGlobal(),
+								m_pgexpr,
+								CXformFactory::Pxff()->PxfsImplementation()
+								);
 	ScheduleTransformations(psc, pxfs);
 	pxfs->Release();
 
@@ -335,6 +335,7 @@ CMemo::PexprExtractPlan
 	CGroupExpression *pgexprBest = NULL;
 	COptimizationContext *poc = NULL;
 	CCost cost = GPOPT_INVALID_COST;
+	CDouble dRuntimeFilterSelectivity(1.0);
 	IStatistics *pstats = NULL;
 	if (pgroupRoot->FScalar())
 	{
@@ -359,6 +360,7 @@ CMemo::PexprExtractPlan
 		if (NULL != pgexprBest)
 		{
 			cost = poc->PccBest()->Cost();
+			dRuntimeFilterSelectivity = poc->PccBest()->DRuntimeFilterSelectivity();
 			pstats = poc->PccBest()->Pstats();
 		}
 	}
@@ -425,7 +427,8 @@ CMemo::PexprExtractPlan
 							pgexprBest,
 							pdrgpexpr,
 							pstats,
-							cost
+							cost,
+							dRuntimeFilterSelectivity
 							);
 
 	if (pexpr->Pop()->FPhysical() && !poc->PccBest()->FValid(pmp))
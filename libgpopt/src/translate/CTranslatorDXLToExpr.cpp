@@ -19,6 +19,8 @@
 #include "naucrates/md/IMDScalarOp.h"
 #include "naucrates/md/IMDAggregate.h"
 #include "naucrates/md/IMDCast.h"
+#include "naucrates/md/CMDIdColStats.h"
+#include "naucrates/md/CMDIdRelStats.h"
 #include "naucrates/md/CMDArrayCoerceCastGPDB.h"
 #include "naucrates/md/CMDRelationCtasGPDB.h"
 #include "naucrates/md/CMDProviderMemory.h"
@@ -348,9 +350,239 @@ CTranslatorDXLToExpr::PexprTranslateQuery
 {
 	CAutoTimer at("\n[OPT]: DXL To Expr Translation Time", GPOS_FTRACE(EopttracePrintOptimizationStatistics));
 
+	PrefetchMetadata(pdxln, pdrgpdxlnCTE);
+
 	return Pexpr(pdxln, pdrgpdxlnQueryOutput, pdrgpdxlnCTE);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorDXLToExpr::AppendMdid
+//
+//	@doc:
+//		Append the given mdid to the array unless it is invalid
+//
+//---------------------------------------------------------------------------
+void
+CTranslatorDXLToExpr::AppendMdid
+	(
+	DrgPmdid *pdrgpmdid,
+	IMDId *pmdid
+	)
+{
+	if (IMDId::FValid(pmdid))
+	{
+		pmdid->AddRef();
+		pdrgpmdid->Append(pmdid);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorDXLToExpr::CollectMdids
+//
+//	@doc:
+//		Collect the mdids of the relations, relation statistics, column types,
+//		operators, functions, aggregates, casts and constant types referenced
+//		by a DXL tree, and the ids of the columns its scalar expressions refer to
+//
+//---------------------------------------------------------------------------
+void
+CTranslatorDXLToExpr::CollectMdids
+	(
+	const CDXLNode *pdxln,
+	DrgPmdid *pdrgpmdid,
+	CBitSet *pbsColIds
+	)
+{
+	GPOS_CHECK_STACK_SIZE;
+
+	CDXLOperator *pdxlop = pdxln->Pdxlop();
+	switch (pdxlop->Edxlop())
+	{
+		case EdxlopLogicalGet:
+		case EdxlopLogicalExternalGet:
+		{
+			const CDXLTableDescr *pdxltabdesc = CDXLLogicalGet::PdxlopConvert(pdxlop)->Pdxltabdesc();
+			IMDId *pmdidRel = pdxltabdesc->Pmdid();
+			AppendMdid(pdrgpmdid, pmdidRel);
+			if (IMDId::EmdidGPDBCtas != pmdidRel->Emdidt())
+			{
+				pmdidRel->AddRef();
+				CMDIdRelStats *pmdidRelStats = GPOS_NEW(m_pmp) CMDIdRelStats(CMDIdGPDB::PmdidConvert(pmdidRel));
+				pdrgpmdid->Append(pmdidRelStats);
+			}
+
+			const ULONG ulCols = pdxltabdesc->UlArity();
+			for (ULONG ul = 0; ul < ulCols; ul++)
+			{
+				AppendMdid(pdrgpmdid, pdxltabdesc->Pdxlcd(ul)->PmdidType());
+			}
+			break;
+		}
+		case EdxlopScalarIdent:
+		{
+			CDXLScalarIdent *pdxlopIdent = CDXLScalarIdent::PdxlopConvert(pdxlop);
+			(void) pbsColIds->FExchangeSet(pdxlopIdent->Pdxlcr()->UlID());
+			AppendMdid(pdrgpmdid, pdxlopIdent->PmdidType());
+			break;
+		}
+		case EdxlopScalarOpExpr:
+		{
+			CDXLScalarOpExpr *pdxlopOpExpr = CDXLScalarOpExpr::PdxlopConvert(pdxlop);
+			AppendMdid(pdrgpmdid, pdxlopOpExpr->Pmdid());
+			AppendMdid(pdrgpmdid, pdxlopOpExpr->PmdidReturnType());
+			break;
+		}
+		case EdxlopScalarCmp:
+		case EdxlopScalarDistinct:
+		case EdxlopScalarArrayComp:
+		{
+			AppendMdid(pdrgpmdid, CDXLScalarComp::PdxlopConvert(pdxlop)->Pmdid());
+			break;
+		}
+		case EdxlopScalarFuncExpr:
+		{
+			CDXLScalarFuncExpr *pdxlopFuncExpr = CDXLScalarFuncExpr::PdxlopConvert(pdxlop);
+			AppendMdid(pdrgpmdid, pdxlopFuncExpr->PmdidFunc());
+			AppendMdid(pdrgpmdid, pdxlopFuncExpr->PmdidRetType());
+			break;
+		}
+		case EdxlopScalarAggref:
+		{
+			CDXLScalarAggref *pdxlopAggref = CDXLScalarAggref::PdxlopConvert(pdxlop);
+			AppendMdid(pdrgpmdid, pdxlopAggref->PmdidAgg());
+			AppendMdid(pdrgpmdid, pdxlopAggref->PmdidResolvedRetType());
+			break;
+		}
+		case EdxlopScalarWindowRef:
+		{
+			CDXLScalarWindowRef *pdxlopWindowRef = CDXLScalarWindowRef::PdxlopConvert(pdxlop);
+			AppendMdid(pdrgpmdid, pdxlopWindowRef->PmdidFunc());
+			AppendMdid(pdrgpmdid, pdxlopWindowRef->PmdidRetType());
+			break;
+		}
+		case EdxlopScalarCast:
+		{
+			CDXLScalarCast *pdxlopCast = CDXLScalarCast::PdxlopConvert(pdxlop);
+			AppendMdid(pdrgpmdid, pdxlopCast->PmdidType());
+			AppendMdid(pdrgpmdid, pdxlopCast->PmdidFunc());
+			break;
+		}
+		case EdxlopScalarConstValue:
+		{
+			AppendMdid(pdrgpmdid, CDXLScalarConstValue::PdxlopConvert(pdxlop)->Pdxldatum()->Pmdid());
+			break;
+		}
+		default:
+			break;
+	}
+
+	const ULONG ulArity = pdxln->UlArity();
+	for (ULONG ul = 0; ul < ulArity; ul++)
+	{
+		CollectMdids((*pdxln)[ul], pdrgpmdid, pbsColIds);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorDXLToExpr::CollectColStatsMdids
+//
+//	@doc:
+//		Collect the mdids of the column statistics of the given user columns
+//		of the relations scanned in a DXL tree; the position of a column in
+//		its relation is needed for the mdid, so the relations must have been
+//		fetched before
+//
+//---------------------------------------------------------------------------
+void
+CTranslatorDXLToExpr::CollectColStatsMdids
+	(
+	const CDXLNode *pdxln,
+	DrgPmdid *pdrgpmdid,
+	const CBitSet *pbsColIds
+	)
+{
+	GPOS_CHECK_STACK_SIZE;
+
+	CDXLOperator *pdxlop = pdxln->Pdxlop();
+	if (EdxlopLogicalGet == pdxlop->Edxlop() || EdxlopLogicalExternalGet == pdxlop->Edxlop())
+	{
+		const CDXLTableDescr *pdxltabdesc = CDXLLogicalGet::PdxlopConvert(pdxlop)->Pdxltabdesc();
+		IMDId *pmdidRel = pdxltabdesc->Pmdid();
+		if (IMDId::EmdidGPDBCtas != pmdidRel->Emdidt())
+		{
+			const IMDRelation *pmdrel = m_pmda->Pmdrel(pmdidRel);
+			const ULONG ulCols = pdxltabdesc->UlArity();
+			for (ULONG ul = 0; ul < ulCols; ul++)
+			{
+				const CDXLColDescr *pdxlcd = pdxltabdesc->Pdxlcd(ul);
+				if (0 >= pdxlcd->IAttno() || !pbsColIds->FBit(pdxlcd->UlID()))
+				{
+					continue;
+				}
+
+				pmdidRel->AddRef();
+				CMDIdColStats *pmdidColStats = GPOS_NEW(m_pmp) CMDIdColStats
+													(
+													CMDIdGPDB::PmdidConvert(pmdidRel),
+													pmdrel->UlPosFromAttno(pdxlcd->IAttno())
+													);
+				pdrgpmdid->Append(pmdidColStats);
+			}
+		}
+	}
+
+	const ULONG ulArity = pdxln->UlArity();
+	for (ULONG ul = 0; ul < ulArity; ul++)
+	{
+		CollectColStatsMdids((*pdxln)[ul], pdrgpmdid, pbsColIds);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorDXLToExpr::PrefetchMetadata
+//
+//	@doc:
+//		Fetch the metadata objects referenced by a query and its CTEs in
+//		batched requests before translating it, instead of one request per
+//		object on first use. Column statistics are fetched in a second batch
+//		as their mdids depend on the relations fetched in the first one.
+//
+//---------------------------------------------------------------------------
+void
+CTranslatorDXLToExpr::PrefetchMetadata
+	(
+	const CDXLNode *pdxln,
+	const DrgPdxln *pdrgpdxlnCTE
+	)
+{
+	const ULONG ulCTEs = (NULL == pdrgpdxlnCTE) ? 0 : pdrgpdxlnCTE->UlLength();
+
+	CBitSet *pbsColIds = GPOS_NEW(m_pmp) CBitSet(m_pmp);
+	DrgPmdid *pdrgpmdid = GPOS_NEW(m_pmp) DrgPmdid(m_pmp);
+	CollectMdids(pdxln, pdrgpmdid, pbsColIds);
+	for (ULONG ul = 0; ul < ulCTEs; ul++)
+	{
+		CollectMdids((*pdrgpdxlnCTE)[ul], pdrgpmdid, pbsColIds);
+	}
+	m_pmda->Prefetch(pdrgpmdid);
+	pdrgpmdid->Release();
+
+	pdrgpmdid = GPOS_NEW(m_pmp) DrgPmdid(m_pmp);
+	CollectColStatsMdids(pdxln, pdrgpmdid, pbsColIds);
+	for (ULONG ul = 0; ul < ulCTEs; ul++)
+	{
+		CollectColStatsMdids((*pdrgpdxlnCTE)[ul], pdrgpmdid, pbsColIds);
+	}
+	m_pmda->Prefetch(pdrgpmdid);
+
+	pdrgpmdid->Release();
+	pbsColIds->Release();
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CTranslatorDXLToExpr::PexprTranslateScalar
@@ -3884,8 +3884,11 @@ CTranslatorExprToDXL::PdxlnHashJoin
 		pdrgpexprRemainingPredicates->Release();
 	}
 
+	// request a runtime filter on the outer side if it was accounted for when costing the join
+	BOOL fRuntimeFilter = 1.0 > pexprHJ->DRuntimeFilterSelectivity();
+
 	// construct a hash join node
-	CDXLPhysicalHashJoin *pdxlopHJ = GPOS_NEW(m_pmp) CDXLPhysicalHashJoin(m_pmp, edxljt);
+	CDXLPhysicalHashJoin *pdxlopHJ = GPOS_NEW(m_pmp) CDXLPhysicalHashJoin(m_pmp, edxljt, fRuntimeFilter);
 
 	// construct projection list from required columns
 	GPOS_ASSERT(NULL != pexprHJ->Prpp());
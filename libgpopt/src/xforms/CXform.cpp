@@ -11,6 +11,7 @@
 
 #include "gpos/base.h"
 #include "gpopt/operators/CExpressionHandle.h"
+#include "gpopt/search/CBindingHandle.h"
 #include "gpopt/xforms/CXform.h"
 
 
@@ -51,6 +52,29 @@ CXform::~CXform()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CXform::TransformBinding
+//
+//	@doc:
+//		Transform a lazy binding by building its expression
+//
+//---------------------------------------------------------------------------
+void
+CXform::TransformBinding
+	(
+	CXformContext *pxfctxt,
+	CXformResult *pxfres,
+	const CBindingHandle &bh
+	)
+	const
+{
+	CExpression *pexpr = bh.Pexpr(pxfctxt->Pmp());
+	Transform(pxfctxt, pxfres, pexpr);
+	pexpr->Release();
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CXform::OsPrint
@@ -47,6 +47,11 @@ CXformFactory::CXformFactory
 	m_phmszxform = GPOS_NEW(pmp) HMSzXform(pmp);
 	m_pxfsExploration = GPOS_NEW(pmp) CXformSet(pmp);
 	m_pxfsImplementation = GPOS_NEW(pmp) CXformSet(pmp);
+
+	for (ULONG ul = 0; ul < COperator::EopSentinel; ul++)
+	{
+		m_rgpxfsPatternRoot[ul] = GPOS_NEW(pmp) CXformSet(pmp);
+	}
 }
 
 
@@ -79,6 +84,11 @@ CXformFactory::~CXformFactory()
 	m_phmszxform->Release();
 	m_pxfsExploration->Release();
 	m_pxfsImplementation->Release();
+
+	for (ULONG ul = 0; ul < COperator::EopSentinel; ul++)
+	{
+		m_rgpxfsPatternRoot[ul]->Release();
+	}
 }
 
 
@@ -130,6 +140,39 @@ CXformFactory::Add
 		pxfs->FExchangeSet(exfid);
 
 	GPOS_ASSERT(!fSet);
+
+	IndexPatternRoot(pxform);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformFactory::IndexPatternRoot
+//
+//	@doc:
+//		Register a given xform with the operators its pattern root can match;
+//		a pattern operator at the root matches any operator
+//
+//---------------------------------------------------------------------------
+void
+CXformFactory::IndexPatternRoot
+	(
+	CXform *pxform
+	)
+{
+	GPOS_ASSERT(NULL != pxform);
+
+	COperator *popRoot = pxform->PexprPattern()->Pop();
+	if (!popRoot->FPattern())
+	{
+		(void) m_rgpxfsPatternRoot[popRoot->Eopid()]->FExchangeSet(pxform->Exfid());
+		return;
+	}
+
+	for (ULONG ul = 0; ul < COperator::EopSentinel; ul++)
+	{
+		(void) m_rgpxfsPatternRoot[ul]->FExchangeSet(pxform->Exfid());
+	}
 }
 
 
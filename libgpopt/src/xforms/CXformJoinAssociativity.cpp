@@ -14,6 +14,8 @@
 
 #include "gpopt/operators/ops.h"
 #include "gpopt/metadata/CTableDescriptor.h"
+#include "gpopt/search/CBindingHandle.h"
+#include "gpopt/search/CGroupProxy.h"
 
 using namespace gpopt;
 using namespace gpmd;
@@ -242,5 +244,156 @@ CXformJoinAssociativity::Transform
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformJoinAssociativity::CollectConjuncts
+//
+//	@doc:
+//		Distribute conjuncts of a predicate group between upper and lower
+//		join using the used columns derived on their groups; a conjunct is
+//		a leaf pointing to its group expression
+//
+//---------------------------------------------------------------------------
+void
+CXformJoinAssociativity::CollectConjuncts
+	(
+	IMemoryPool *pmp,
+	CGroupExpression *pgexprPred,
+	CColRefSet *pcrsLower,
+	ULONG *pulLower,
+	DrgPexpr *pdrgpexprLower,
+	DrgPexpr *pdrgpexprUpper
+	)
+{
+	GPOS_CHECK_STACK_SIZE;
+	GPOS_ASSERT(NULL != pgexprPred);
+	GPOS_ASSERT(NULL != pulLower);
+	GPOS_ASSERT((NULL == pdrgpexprLower) == (NULL == pdrgpexprUpper));
+
+	COperator *pop = pgexprPred->Pop();
+	if (COperator::EopScalarBoolOp == pop->Eopid() &&
+		CScalarBoolOp::EboolopAnd == CScalarBoolOp::PopConvert(pop)->Eboolop())
+	{
+		const ULONG ulArity = pgexprPred->UlArity();
+		for (ULONG ul = 0; ul < ulArity; ul++)
+		{
+			CGroupExpression *pgexprChild = NULL;
+			{
+				CGroupProxy gp((*pgexprPred)[ul]);
+				pgexprChild = gp.PgexprFirst();
+			}
+			CollectConjuncts(pmp, pgexprChild, pcrsLower, pulLower, pdrgpexprLower, pdrgpexprUpper);
+		}
+
+		return;
+	}
+
+	CColRefSet *pcrsUsed = CDrvdPropScalar::Pdpscalar(pgexprPred->Pgroup()->Pdp())->PcrsUsed();
+	const BOOL fLower = pcrsLower->FSubset(pcrsUsed);
+	if (fLower)
+	{
+		(*pulLower)++;
+	}
+
+	if (NULL == pdrgpexprLower)
+	{
+		return;
+	}
+
+	pop->AddRef();
+	CExpression *pexprConj = GPOS_NEW(pmp) CExpression(pmp, pop, pgexprPred);
+	if (fLower)
+	{
+		pdrgpexprLower->Append(pexprConj);
+	}
+	else
+	{
+		pdrgpexprUpper->Append(pexprConj);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformJoinAssociativity::TransformBinding
+//
+//	@doc:
+//		Transformation of a lazy binding: (RS)T ==> (RT)S; conjuncts are
+//		distributed through the memo first, so that bindings resulting
+//		in a cross product build no expression
+//
+//---------------------------------------------------------------------------
+void
+CXformJoinAssociativity::TransformBinding
+	(
+	CXformContext *pxfctxt,
+	CXformResult *pxfres,
+	const CBindingHandle &bh
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pxfctxt);
+
+	IMemoryPool *pmp = pxfctxt->Pmp();
+
+	// bind operators
+	const CBindingHandle &bhLeft = bh[0];
+	const CBindingHandle &bhLeftLeft = bhLeft[0];
+	const CBindingHandle &bhLeftRight = bhLeft[1];
+	const CBindingHandle &bhRight = bh[1];
+
+	// predicates of lower and upper join
+	CGroupExpression *rgpgexprPred[] = {bhLeft[2].Pgexpr(), bh[2].Pgexpr()};
+
+	// columns for new lower join
+	CColRefSet *pcrsLower = GPOS_NEW(pmp) CColRefSet(pmp);
+	pcrsLower->Union(bhLeftLeft.Pdprel()->PcrsOutput());
+	pcrsLower->Union(bhRight.Pdprel()->PcrsOutput());
+
+	ULONG ulLower = 0;
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgpgexprPred); ul++)
+	{
+		CollectConjuncts(pmp, rgpgexprPred[ul], pcrsLower, &ulLower, NULL /*pdrgpexprLower*/, NULL /*pdrgpexprUpper*/);
+	}
+
+	// build join only if it does not result in a cross product
+	if (0 == ulLower)
+	{
+		pcrsLower->Release();
+		return;
+	}
+
+	// create new predicates
+	DrgPexpr *pdrgpexprLower = GPOS_NEW(pmp) DrgPexpr(pmp);
+	DrgPexpr *pdrgpexprUpper = GPOS_NEW(pmp) DrgPexpr(pmp);
+	ulLower = 0;
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgpgexprPred); ul++)
+	{
+		CollectConjuncts(pmp, rgpgexprPred[ul], pcrsLower, &ulLower, pdrgpexprLower, pdrgpexprUpper);
+	}
+	pcrsLower->Release();
+
+	// build new joins
+	CExpression *pexprBottomJoin = CUtils::PexprLogicalJoin<CLogicalInnerJoin>
+									(
+									pmp,
+									bhLeftLeft.Pexpr(pmp),
+									bhRight.Pexpr(pmp),
+									CPredicateUtils::PexprConjunction(pmp, pdrgpexprLower)
+									);
+
+	CExpression *pexprResult = CUtils::PexprLogicalJoin<CLogicalInnerJoin>
+								(
+								pmp,
+								pexprBottomJoin,
+								bhLeftRight.Pexpr(pmp),
+								CPredicateUtils::PexprConjunction(pmp, pdrgpexprUpper)
+								);
+
+	// add alternative to transformation result
+	pxfres->Add(pexprResult);
+}
+
+
 // EOF
 
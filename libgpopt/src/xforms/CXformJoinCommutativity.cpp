@@ -14,6 +14,7 @@
 
 #include "gpopt/operators/ops.h"
 #include "gpopt/metadata/CTableDescriptor.h"
+#include "gpopt/search/CBindingHandle.h"
 
 using namespace gpopt;
 
@@ -112,4 +113,33 @@ CXformJoinCommutativity::Transform
 	pxfres->Add(pexprAlt);
 }
 
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformJoinCommutativity::TransformBinding
+//
+//	@doc:
+//		Transformation of a lazy binding; only the result is built
+//
+//---------------------------------------------------------------------------
+void
+CXformJoinCommutativity::TransformBinding
+	(
+	CXformContext *pxfctxt,
+	CXformResult *pxfres,
+	const CBindingHandle &bh
+	) const
+{
+	GPOS_ASSERT(NULL != pxfctxt);
+
+	IMemoryPool *pmp = pxfctxt->Pmp();
+
+	// assemble transformed expression
+	CExpression *pexprAlt =
+		CUtils::PexprLogicalJoin<CLogicalInnerJoin>(pmp, bh[1].Pexpr(pmp), bh[0].Pexpr(pmp), bh[2].Pexpr(pmp));
+
+	// add alternative to transformation result
+	pxfres->Add(pexprAlt);
+}
+
 // EOF
@@ -0,0 +1,285 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CXformProfile.cpp
+//
+//	@doc:
+//		Implementation of per-xform cost accounting
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/sync/atomic.h"
+
+#include "gpopt/search/CGroupExpression.h"
+#include "gpopt/xforms/CXformFactory.h"
+#include "gpopt/xforms/CXformProfile.h"
+#include "gpopt/xforms/CXformUtility.h"
+
+#include "naucrates/traceflags/traceflags.h"
+
+using namespace gpopt;
+
+// process-wide aggregate
+CXformProfile CXformProfile::m_xfprofAggregate;
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformProfile::CXformProfile
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CXformProfile::CXformProfile()
+{
+	Reset();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformProfile::Reset
+//
+//	@doc:
+//		Reset all counters
+//
+//---------------------------------------------------------------------------
+void
+CXformProfile::Reset()
+{
+	for (ULONG ul = 0; ul < CXform::ExfSentinel; ul++)
+	{
+		m_rgullAttempts[ul] = 0;
+		m_rgullCalls[ul] = 0;
+		m_rgullBindings[ul] = 0;
+		m_rgullResults[ul] = 0;
+		m_rgullMemoGexprs[ul] = 0;
+		m_rgullTime[ul] = 0;
+		m_rgullPlans[ul] = 0;
+	}
+	m_ullPlans = 0;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformProfile::FEnabled
+//
+//	@doc:
+//		Is xform profiling required, either for printing or for maintaining
+//		xform utility statistics
+//
+//---------------------------------------------------------------------------
+BOOL
+CXformProfile::FEnabled()
+{
+	return GPOS_FTRACE(EopttracePrintXformProfile) ||
+			CXformUtility::FEnabled();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformProfile::RecordTransform
+//
+//	@doc:
+//		Record one application of an xform to a group expression
+//
+//---------------------------------------------------------------------------
+void
+CXformProfile::RecordTransform
+	(
+	CXform::EXformId exfid,
+	ULONG ulBindings,
+	ULONG ulResults,
+	ULONG ulTime
+	)
+{
+	GPOS_ASSERT(CXform::ExfSentinel > exfid);
+
+	(void) UllExchangeAdd(&m_rgullAttempts[exfid], 1);
+	(void) UllExchangeAdd(&m_rgullBindings[exfid], ulBindings);
+	(void) UllExchangeAdd(&m_rgullResults[exfid], ulResults);
+	(void) UllExchangeAdd(&m_rgullTime[exfid], ulTime);
+	if (0 < ulResults)
+	{
+		(void) UllExchangeAdd(&m_rgullCalls[exfid], 1);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformProfile::RecordMemoInsert
+//
+//	@doc:
+//		Record a new group expression inserted into the memo by an xform
+//
+//---------------------------------------------------------------------------
+void
+CXformProfile::RecordMemoInsert
+	(
+	CXform::EXformId exfid
+	)
+{
+	if (CXform::ExfInvalid == exfid)
+	{
+		// group expression was not produced by an xform
+		return;
+	}
+
+	(void) UllExchangeAdd(&m_rgullMemoGexprs[exfid], 1);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformProfile::MarkLineage
+//
+//	@doc:
+//		Mark the xforms that derived the given group expression by following
+//		the chain of origin group expressions
+//
+//---------------------------------------------------------------------------
+void
+CXformProfile::MarkLineage
+	(
+	CXformSet *pxfs,
+	CGroupExpression *pgexpr
+	)
+{
+	GPOS_ASSERT(NULL != pxfs);
+
+	while (NULL != pgexpr)
+	{
+		if (CXform::ExfInvalid != pgexpr->ExfidOrigin())
+		{
+			(void) pxfs->FExchangeSet(pgexpr->ExfidOrigin());
+		}
+		pgexpr = pgexpr->PgexprOrigin();
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformProfile::RecordPlan
+//
+//	@doc:
+//		Record the xforms that contributed to the final plan; an xform
+//		contributes if it derived, directly or through the origin of a
+//		group expression, any node of the plan
+//
+//---------------------------------------------------------------------------
+void
+CXformProfile::RecordPlan
+	(
+	IMemoryPool *pmp,
+	CExpression *pexprPlan
+	)
+{
+	GPOS_ASSERT(NULL != pexprPlan);
+
+	CXformSet *pxfs = GPOS_NEW(pmp) CXformSet(pmp);
+
+	// traverse plan iteratively using an explicit stack of nodes
+	DrgPexpr *pdrgpexpr = GPOS_NEW(pmp) DrgPexpr(pmp);
+	pexprPlan->AddRef();
+	pdrgpexpr->Append(pexprPlan);
+	for (ULONG ul = 0; ul < pdrgpexpr->UlLength(); ul++)
+	{
+		CExpression *pexpr = (*pdrgpexpr)[ul];
+		MarkLineage(pxfs, pexpr->Pgexpr());
+
+		const ULONG ulArity = pexpr->UlArity();
+		for (ULONG ulChild = 0; ulChild < ulArity; ulChild++)
+		{
+			(*pexpr)[ulChild]->AddRef();
+			pdrgpexpr->Append((*pexpr)[ulChild]);
+		}
+	}
+	pdrgpexpr->Release();
+
+	CXformSetIter xsi(*pxfs);
+	while (xsi.FAdvance())
+	{
+		(void) UllExchangeAdd(&m_rgullPlans[xsi.TBit()], 1);
+	}
+	(void) UllExchangeAdd(&m_ullPlans, 1);
+
+	pxfs->Release();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformProfile::Merge
+//
+//	@doc:
+//		Add counters of another profile to this one
+//
+//---------------------------------------------------------------------------
+void
+CXformProfile::Merge
+	(
+	const CXformProfile &xfprof
+	)
+{
+	for (ULONG ul = 0; ul < CXform::ExfSentinel; ul++)
+	{
+		(void) UllExchangeAdd(&m_rgullAttempts[ul], xfprof.m_rgullAttempts[ul]);
+		(void) UllExchangeAdd(&m_rgullCalls[ul], xfprof.m_rgullCalls[ul]);
+		(void) UllExchangeAdd(&m_rgullBindings[ul], xfprof.m_rgullBindings[ul]);
+		(void) UllExchangeAdd(&m_rgullResults[ul], xfprof.m_rgullResults[ul]);
+		(void) UllExchangeAdd(&m_rgullMemoGexprs[ul], xfprof.m_rgullMemoGexprs[ul]);
+		(void) UllExchangeAdd(&m_rgullTime[ul], xfprof.m_rgullTime[ul]);
+		(void) UllExchangeAdd(&m_rgullPlans[ul], xfprof.m_rgullPlans[ul]);
+	}
+	(void) UllExchangeAdd(&m_ullPlans, xfprof.m_ullPlans);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformProfile::OsPrint
+//
+//	@doc:
+//		Print profile as comma-separated values with a header line,
+//		one line per xform that was applied
+//
+//---------------------------------------------------------------------------
+IOstream &
+CXformProfile::OsPrint
+	(
+	IOstream &os
+	)
+	const
+{
+	os << "[OPT]: <Begin Xform Profile - " << m_ullPlans << " plans>" << std::endl;
+	os << "xform,attempts,calls,bindings,results,memo_gexprs,time_ms,plans" << std::endl;
+	for (ULONG ul = 0; ul < CXform::ExfSentinel; ul++)
+	{
+		if (0 == m_rgullAttempts[ul])
+		{
+			continue;
+		}
+
+		os
+			<< CXformFactory::Pxff()->Pxf((CXform::EXformId) ul)->SzId() << ","
+			<< m_rgullAttempts[ul] << ","
+			<< m_rgullCalls[ul] << ","
+			<< m_rgullBindings[ul] << ","
+			<< m_rgullResults[ul] << ","
+			<< m_rgullMemoGexprs[ul] << ","
+			<< m_rgullTime[ul] << ","
+			<< m_rgullPlans[ul] << std::endl;
+	}
+	os << "[OPT]: <End Xform Profile>" << std::endl;
+
+	return os;
+}
+
+// EOF
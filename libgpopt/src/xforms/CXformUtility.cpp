@@ -0,0 +1,402 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CXformUtility.cpp
+//
+//	@doc:
+//		Implementation of xform utility statistics
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/sync/atomic.h"
+
+#include "gpopt/base/CCostContext.h"
+#include "gpopt/base/CUtils.h"
+#include "gpopt/xforms/CXformFactory.h"
+#include "gpopt/xforms/CXformProfile.h"
+#include "gpopt/xforms/CXformUtility.h"
+
+#include "naucrates/traceflags/traceflags.h"
+
+using namespace gpopt;
+
+// global instance
+CXformUtility CXformUtility::m_xfutil;
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformUtility::CXformUtility
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CXformUtility::CXformUtility()
+{
+	Reset();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformUtility::Reset
+//
+//	@doc:
+//		Reset all statistics
+//
+//---------------------------------------------------------------------------
+void
+CXformUtility::Reset()
+{
+	for (ULONG ulClass = 0; ulClass < EqcSentinel; ulClass++)
+	{
+		m_rgulpOptimizations[ulClass] = 0;
+		for (ULONG ul = 0; ul < CXform::ExfSentinel; ul++)
+		{
+			m_rgrgulpFired[ulClass][ul] = 0;
+			m_rgrgulpUseful[ulClass][ul] = 0;
+		}
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformUtility::FEnabled
+//
+//	@doc:
+//		Is the search strategy adapted to xform utility statistics; the
+//		statistics depend on earlier optimizations of the process, so they
+//		are not used when capturing a minidump, which then reproduces with
+//		the full search strategy
+//
+//---------------------------------------------------------------------------
+BOOL
+CXformUtility::FEnabled()
+{
+	return GPOS_FTRACE(EopttraceEnableAdaptiveXformBudget) &&
+			!GPOS_FTRACE(EopttraceMinidump);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformUtility::UlJoins
+//
+//	@doc:
+//		Count joins in given expression; an n-ary join of k relations
+//		counts as k - 1 joins
+//
+//---------------------------------------------------------------------------
+ULONG
+CXformUtility::UlJoins
+	(
+	CExpression *pexpr
+	)
+{
+	GPOS_CHECK_STACK_SIZE;
+	GPOS_ASSERT(NULL != pexpr);
+
+	ULONG ulJoins = 0;
+	const ULONG ulArity = pexpr->UlArity();
+	if (CUtils::FLogicalJoin(pexpr->Pop()) && 2 < ulArity)
+	{
+		// last child of a join is the join predicate
+		ulJoins += ulArity - 2;
+	}
+
+	for (ULONG ul = 0; ul < ulArity; ul++)
+	{
+		ulJoins += UlJoins((*pexpr)[ul]);
+	}
+
+	return ulJoins;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformUtility::Eqc
+//
+//	@doc:
+//		Classify given query expression
+//
+//---------------------------------------------------------------------------
+CXformUtility::EQueryClass
+CXformUtility::Eqc
+	(
+	CExpression *pexpr
+	)
+{
+	ULONG ulJoins = UlJoins(pexpr);
+	if (0 == ulJoins)
+	{
+		return EqcNoJoins;
+	}
+
+	if (3 >= ulJoins)
+	{
+		return EqcSmallJoins;
+	}
+
+	if (8 >= ulJoins)
+	{
+		return EqcMediumJoins;
+	}
+
+	return EqcLargeJoins;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformUtility::FEligible
+//
+//	@doc:
+//		Check if given xform can be skipped; join reordering xforms only
+//		produce alternatives of expressions that can be implemented as is
+//
+//---------------------------------------------------------------------------
+BOOL
+CXformUtility::FEligible
+	(
+	CXform::EXformId exfid
+	)
+{
+	switch (exfid)
+	{
+		case CXform::ExfJoinCommutativity:
+		case CXform::ExfJoinAssociativity:
+		case CXform::ExfSemiJoinSemiJoinSwap:
+		case CXform::ExfSemiJoinAntiSemiJoinSwap:
+		case CXform::ExfSemiJoinAntiSemiJoinNotInSwap:
+		case CXform::ExfSemiJoinInnerJoinSwap:
+		case CXform::ExfAntiSemiJoinAntiSemiJoinSwap:
+		case CXform::ExfAntiSemiJoinAntiSemiJoinNotInSwap:
+		case CXform::ExfAntiSemiJoinSemiJoinSwap:
+		case CXform::ExfAntiSemiJoinInnerJoinSwap:
+		case CXform::ExfAntiSemiJoinNotInAntiSemiJoinSwap:
+		case CXform::ExfAntiSemiJoinNotInAntiSemiJoinNotInSwap:
+		case CXform::ExfAntiSemiJoinNotInSemiJoinSwap:
+		case CXform::ExfAntiSemiJoinNotInInnerJoinSwap:
+		case CXform::ExfInnerJoinSemiJoinSwap:
+		case CXform::ExfInnerJoinAntiSemiJoinSwap:
+		case CXform::ExfInnerJoinAntiSemiJoinNotInSwap:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformUtility::FLowUtility
+//
+//	@doc:
+//		Check if xform has low utility for given query class, i.e., it fired
+//		in enough optimizations but rarely contributed to the final plan
+//
+//---------------------------------------------------------------------------
+BOOL
+CXformUtility::FLowUtility
+	(
+	EQueryClass eqc,
+	CXform::EXformId exfid
+	)
+	const
+{
+	GPOS_ASSERT(EqcSentinel > eqc);
+
+	if (!FEligible(exfid))
+	{
+		return false;
+	}
+
+	ULONG_PTR ulpFired = m_rgrgulpFired[eqc][exfid];
+	if (GPOPT_XFORM_UTILITY_MIN_SAMPLES > ulpFired)
+	{
+		return false;
+	}
+
+	return (DOUBLE) m_rgrgulpUseful[eqc][exfid] < GPOPT_XFORM_UTILITY_THRESHOLD * (DOUBLE) ulpFired;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformUtility::PdrgpssDeprioritize
+//
+//	@doc:
+//		Copy the given search stages with low-utility xforms deferred. An
+//		xform is removed from a stage if a later stage still applies it.
+//		The last stage, which is the only stage of the default strategy, is
+//		split into a stage without low-utility xforms, which ends the search
+//		once it finds any plan, followed by the full last stage, which only
+//		runs if no plan was found without them. Periodically all xforms are
+//		kept to refresh their statistics. The given stages are not changed,
+//		as they may be reused for other optimizations.
+//
+//---------------------------------------------------------------------------
+DrgPss *
+CXformUtility::PdrgpssDeprioritize
+	(
+	IMemoryPool *pmp,
+	EQueryClass eqc,
+	const DrgPss *pdrgpss
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pdrgpss);
+	GPOS_ASSERT(0 < pdrgpss->UlLength());
+
+	const BOOL fRefresh = (0 == m_rgulpOptimizations[eqc] % GPOPT_XFORM_UTILITY_REFRESH_PERIOD);
+
+	DrgPss *pdrgpssNew = GPOS_NEW(pmp) DrgPss(pmp);
+	const ULONG ulStages = pdrgpss->UlLength();
+	for (ULONG ulStage = 0; ulStage < ulStages; ulStage++)
+	{
+		CSearchStage *pss = (*pdrgpss)[ulStage];
+		const BOOL fLast = (ulStages == ulStage + 1);
+		CXformSet *pxfs = GPOS_NEW(pmp) CXformSet(pmp, *pss->Pxfs());
+
+		BOOL fDeferred = false;
+		for (ULONG ul = 0; !fRefresh && ul < CXform::ExfSentinel; ul++)
+		{
+			CXform::EXformId exfid = (CXform::EXformId) ul;
+			if (pxfs->FBit(exfid) && (fLast || FAppliedLater(pdrgpss, ulStage, exfid)) && FLowUtility(eqc, exfid))
+			{
+				(void) pxfs->FExchangeClear(exfid);
+				fDeferred = true;
+			}
+		}
+
+		if (!fLast || !fDeferred)
+		{
+			pdrgpssNew->Append(GPOS_NEW(pmp) CSearchStage(pxfs, pss->UlTimeThreshold(), pss->CostThreshold()));
+			continue;
+		}
+
+		// any plan found without the deferred xforms ends the search; the
+		// full stage is the fallback, so the search remains complete
+		pdrgpssNew->Append(GPOS_NEW(pmp) CSearchStage(pxfs, pss->UlTimeThreshold(), GPOPT_INFINITE_COST));
+
+		CXformSet *pxfsFull = GPOS_NEW(pmp) CXformSet(pmp, *pss->Pxfs());
+		pdrgpssNew->Append(GPOS_NEW(pmp) CSearchStage(pxfsFull, pss->UlTimeThreshold(), pss->CostThreshold()));
+	}
+
+	return pdrgpssNew;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformUtility::FAppliedLater
+//
+//	@doc:
+//		Does a stage after the given one apply the given xform
+//
+//---------------------------------------------------------------------------
+BOOL
+CXformUtility::FAppliedLater
+	(
+	const DrgPss *pdrgpss,
+	ULONG ulStage,
+	CXform::EXformId exfid
+	)
+{
+	const ULONG ulStages = pdrgpss->UlLength();
+	for (ULONG ul = ulStage + 1; ul < ulStages; ul++)
+	{
+		if ((*pdrgpss)[ul]->Pxfs()->FBit(exfid))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformUtility::Update
+//
+//	@doc:
+//		Update statistics with profile of a completed optimization
+//
+//---------------------------------------------------------------------------
+void
+CXformUtility::Update
+	(
+	EQueryClass eqc,
+	const CXformProfile &xfprof
+	)
+{
+	GPOS_ASSERT(EqcSentinel > eqc);
+
+	(void) UlpExchangeAdd(&m_rgulpOptimizations[eqc], 1);
+	for (ULONG ul = 0; ul < CXform::ExfSentinel; ul++)
+	{
+		CXform::EXformId exfid = (CXform::EXformId) ul;
+		if (0 < xfprof.UllCalls(exfid))
+		{
+			(void) UlpExchangeAdd(&m_rgrgulpFired[eqc][exfid], 1);
+		}
+
+		if (0 < xfprof.UllPlans(exfid))
+		{
+			(void) UlpExchangeAdd(&m_rgrgulpUseful[eqc][exfid], 1);
+		}
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformUtility::OsPrint
+//
+//	@doc:
+//		Export statistics as comma-separated values, one line per eligible
+//		xform and query class
+//
+//---------------------------------------------------------------------------
+IOstream &
+CXformUtility::OsPrint
+	(
+	IOstream &os
+	)
+	const
+{
+	os << "[OPT]: <Begin Xform Utility>" << std::endl;
+	os << "class,optimizations,xform,fired,useful,low_utility" << std::endl;
+	for (ULONG ulClass = 0; ulClass < EqcSentinel; ulClass++)
+	{
+		EQueryClass eqc = (EQueryClass) ulClass;
+		for (ULONG ul = 0; ul < CXform::ExfSentinel; ul++)
+		{
+			CXform::EXformId exfid = (CXform::EXformId) ul;
+			if (!FEligible(exfid) || 0 == m_rgrgulpFired[eqc][exfid])
+			{
+				continue;
+			}
+
+			os
+				<< ulClass << ","
+				<< m_rgulpOptimizations[eqc] << ","
+				<< CXformFactory::Pxff()->Pxf(exfid)->SzId() << ","
+				<< m_rgrgulpFired[eqc][exfid] << ","
+				<< m_rgrgulpUseful[eqc][exfid] << ","
+				<< FLowUtility(eqc, exfid) << std::endl;
+		}
+	}
+	os << "[OPT]: <End Xform Utility>" << std::endl;
+
+	return os;
+}
+
+// EOF
@@ -85,6 +85,9 @@ namespace gpos
 		// move file
 		void Move(const CHAR *szOld, const CHAR *szNew);
 
+		// rename file, atomically replacing any file at the new path
+		void Rename(const CHAR *szOld, const CHAR *szNew);
+
 		// delete file
 		void Unlink(const CHAR *szPath);
 
@@ -219,6 +219,8 @@ namespace gpos
 
 				if (fDeleted)
 				{
+					UllExchangeAdd((volatile ULLONG *) &m_ullCacheSize, -pce->Pmp()->UllTotalAllocatedSize());
+
 					// delete cache entry
 					DestroyCacheEntry(pce);
 				}
@@ -384,6 +386,12 @@ namespace gpos
 
 		public:
 
+			// function called on the objects of the cache by Visit
+			typedef void (*VisitFuncPtr)(T pVal, void *pvArg);
+
+			// function selecting the entries removed by Invalidate
+			typedef BOOL (*MatchFuncPtr)(const K pKey, const void *pvArg);
+
 			// ctor
 			CCache
 				(
@@ -480,6 +488,95 @@ namespace gpos
 				return m_fEvictionFactor;
 			}
 
+			// removes the entries whose keys match; entries in use are marked
+			// for deletion, so lookups no longer find them, and are removed
+			// when their last accessor releases them; returns the number of
+			// entries invalidated
+			ULONG UlInvalidate(MatchFuncPtr pfuncMatch, const void *pvArg)
+			{
+				GPOS_ASSERT(NULL != pfuncMatch);
+
+				ULONG ulInvalidated = 0;
+
+				CCacheHashtableIter chtit(m_sht);
+				BOOL fAdvanced = false;
+				while (fAdvanced || chtit.FAdvance())
+				{
+					fAdvanced = false;
+					CCacheHashTableEntry *pceRemoved = NULL;
+
+					// scope for CCacheHashtableIterAccessor
+					{
+						CCacheHashtableIterAccessor shtitacc(chtit);
+						CCacheHashTableEntry *pce = shtitacc.Pt();
+						if (NULL == pce || pce->FMarkedForDeletion() || !pfuncMatch(pce->PKey(), pvArg))
+						{
+							continue;
+						}
+
+						pce->MarkForDeletion();
+						ulInvalidated++;
+
+						// as in eviction, the iterator accessor does not add a reference
+						if (EXPECTED_REF_COUNT_FOR_DELETE == pce->UlRefCount())
+						{
+							// removing the entry advances the iterator
+							shtitacc.Remove(pce);
+							fAdvanced = true;
+
+							UllExchangeAdd((volatile ULLONG *) &m_ullCacheSize, -pce->Pmp()->UllTotalAllocatedSize());
+							pceRemoved = pce;
+						}
+					}
+
+					if (NULL != pceRemoved)
+					{
+						DestroyCacheEntry(pceRemoved);
+					}
+				}
+
+				return ulInvalidated;
+			}
+
+			// calls the given function on each object in the cache; an entry is
+			// pinned while the function runs on its object, and no hashtable
+			// lock is held, so the function may access the cache
+			void Visit(VisitFuncPtr pfuncVisit, void *pvArg)
+			{
+				GPOS_ASSERT(NULL != pfuncVisit);
+
+				CCacheHashtableIter chtit(m_sht);
+				while (chtit.FAdvance())
+				{
+					CCacheHashTableEntry *pce = NULL;
+
+					// scope for CCacheHashtableIterAccessor
+					{
+						CCacheHashtableIterAccessor shtitacc(chtit);
+						pce = shtitacc.Pt();
+						if (NULL == pce || pce->FMarkedForDeletion())
+						{
+							continue;
+						}
+
+						pce->IncRefCount();
+					}
+
+					GPOS_TRY
+					{
+						pfuncVisit(pce->PVal(), pvArg);
+					}
+					GPOS_CATCH_EX(ex)
+					{
+						ReleaseEntry(pce);
+						GPOS_RETHROW(ex);
+					}
+					GPOS_CATCH_END;
+
+					ReleaseEntry(pce);
+				}
+			}
+
     }; //  CCache
 
 	// invalid key
@@ -37,6 +37,9 @@ namespace gpos
 			// ctors
 			CWStringConst(const WCHAR *wszBuf);
 			CWStringConst(IMemoryPool *pmp, const WCHAR *wszBuf);
+
+			// ctor taking ownership of a buffer allocated with GPOS_NEW_ARRAY
+			CWStringConst(WCHAR *wszBuf, ULONG ulLength);
 			
 			// shallow copy ctor
 			CWStringConst(const CWStringConst&);
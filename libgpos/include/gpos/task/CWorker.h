@@ -103,6 +103,13 @@ namespace gpos
 				return m_ulThreadId;
 			}
 
+			// is this a thread of the worker pool; the thread executing
+			// gpos_exec puts its worker on its own stack with id 0
+			BOOL FPoolWorker() const
+			{
+				return 0 != m_ulThreadId;
+			}
+
 			// worker identification
 			inline
 			CWorkerId Wid() const
@@ -228,6 +228,20 @@ namespace gpos
 				return UlWorkers() - m_event.CWaiters();
 			}
 
+			// number of workers that may still pick up a task without waiting
+			// for a running task to finish
+			ULONG UlWorkersIdle() const
+			{
+				const ULONG ulWorkersMax = m_ulWorkersMax;
+				const ULONG ulRunning = UlWorkersRunning();
+				if (ulRunning >= ulWorkersMax)
+				{
+					return 0;
+				}
+
+				return ulWorkersMax - ulRunning;
+			}
+
 			// set min number of workers
 			void SetWorkersMin(volatile ULONG ulWorkersMin);
 
@@ -308,11 +308,19 @@ CWStringTest::EresUnittest_Initialize()
 	// constant string initialization
 	CWStringConst *pcstr1 = GPOS_NEW(pmp) CWStringConst(GPOS_WSZ_LIT("123"));
 	GPOS_ASSERT(pcstr1->FEquals(&cstr1));
+
+	// constant string taking over an allocated buffer
+	WCHAR *wsz = GPOS_NEW_ARRAY(pmp, WCHAR, 4);
+	clib::WszWcsNCpy(wsz, GPOS_WSZ_LIT("123"), 4);
+	CWStringConst *pcstr2 = GPOS_NEW(pmp) CWStringConst(wsz, 3 /*ulLength*/);
+	GPOS_ASSERT(pcstr2->FEquals(&cstr1));
+	GPOS_ASSERT(wsz == pcstr2->Wsz());
 	
 	// cleanup
 	GPOS_DELETE(pstr1);
 	GPOS_DELETE(pstr2);
 	GPOS_DELETE(pcstr1);
+	GPOS_DELETE(pcstr2);
 	
 #endif // #ifdef GPOS_DEBUG
 	return GPOS_OK;
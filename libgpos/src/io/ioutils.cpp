@@ -344,6 +344,40 @@ gpos::ioutils::Move
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		ioutils::Rename
+//
+//	@doc:
+//		Rename file from old path to new path; any file currently mapped to
+//		new path is replaced atomically, so that readers open either the
+//		old or the new file
+//
+//---------------------------------------------------------------------------
+void
+gpos::ioutils::Rename
+	(
+	const CHAR *szOld,
+	const CHAR *szNew
+	)
+{
+	GPOS_ASSERT_NO_SPINLOCK;
+	GPOS_ASSERT(NULL != szOld);
+	GPOS_ASSERT(NULL != szNew);
+	GPOS_ASSERT(FFile(szOld));
+
+	INT iRes = -1;
+
+	// rename file and check to simulate I/O error
+	GPOS_CHECK_SIM_IO_ERR(&iRes, rename(szOld, szNew));
+
+	if (0 != iRes)
+	{
+		GPOS_RAISE(CException::ExmaSystem, CException::ExmiIOError, errno);
+	}
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		ioutils::Unlink
@@ -82,6 +82,33 @@ CWStringConst::CWStringConst
 	GPOS_ASSERT(FValid());
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CWStringConst::CWStringConst
+//
+//	@doc:
+//		Initializes a constant string with a buffer of the given length
+//		allocated with GPOS_NEW_ARRAY; the string takes ownership of the
+//		buffer instead of copying it
+//
+//---------------------------------------------------------------------------
+CWStringConst::CWStringConst
+	(
+	WCHAR *wszBuf,
+	ULONG ulLength
+	)
+	:
+	CWStringBase
+		(
+		ulLength,
+		true // fOwnsMemory
+		),
+	m_wszBuf(wszBuf)
+{
+	GPOS_ASSERT(NULL != wszBuf);
+	GPOS_ASSERT(FValid());
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CWStringConst::CWStringConst
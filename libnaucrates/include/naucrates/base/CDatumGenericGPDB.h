@@ -58,6 +58,10 @@ class CDatumGenericGPDB : public IDatumGeneric
 		// private copy ctor
 		CDatumGenericGPDB(const CDatumGenericGPDB &);
 
+		// position of the character following the one at the given position
+		static
+		ULONG UlNextChar(const BYTE *pba, ULONG ulLen, ULONG ulPos);
+
 	public:
 
 		// ctor
@@ -183,6 +187,10 @@ class CDatumGenericGPDB : public IDatumGeneric
 		virtual
 		CDouble DTrailingWildcardSelectivity(const BYTE *pba, ULONG ulPos) const;
 
+		// does datum match the given LIKE pattern
+		virtual
+		BOOL FLikeMatch(const IDatum *pdatumPattern) const;
+
 		// selectivities needed for LIKE predicate statistics evaluation
 		static
 		const CDouble DDefaultFixedCharSelectivity;
@@ -145,6 +145,18 @@ namespace gpnaucrates
 			virtual
 			CDouble DLikePredicateScaleFactor() const = 0;
 
+			// does datum match the given LIKE pattern
+			virtual
+			BOOL FLikeMatch
+				(
+				const IDatum * // pdatumPattern
+				)
+				const
+			{
+				// LIKE is not evaluated on datums by default
+				return false;
+			}
+
 			// supports statistical comparisons based on the byte array representation of datum
 			virtual
 			BOOL FSupportsBinaryComp(const IDatum *pdatum) const = 0;
@@ -0,0 +1,164 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CDXLParallelParser.h
+//
+//	@doc:
+//		Parser of DXL documents parsing the metadata objects of a document
+//		on worker tasks
+//---------------------------------------------------------------------------
+#ifndef GPDXL_CDXLParallelParser_H
+#define GPDXL_CDXLParallelParser_H
+
+#include "gpos/base.h"
+
+#include "naucrates/md/IMDCacheObject.h"
+
+namespace gpdxl
+{
+	using namespace gpos;
+	using namespace gpmd;
+
+	// fwd decl
+	class CParseHandlerDXL;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CDXLParallelParser
+	//
+	//	@doc:
+	//		Metadata responses and minidumps hold many independent metadata
+	//		objects. A pre-scan of the document text locates the elements of
+	//		its metadata section; these are split into contiguous chunks,
+	//		which are wrapped into documents of their own and parsed on worker
+	//		tasks, while the rest of the document, with an empty metadata
+	//		section, is parsed on the current task. The objects of the chunks
+	//		are then added to the metadata section in document order, so the
+	//		result does not depend on the order the tasks run in. The tasks
+	//		allocate the objects in the pool of the caller, so a pool that is
+	//		not thread-safe is parsed serially.
+	//
+	//---------------------------------------------------------------------------
+	class CDXLParallelParser
+	{
+		private:
+
+			// kinds of markup found by the pre-scan
+			enum EMarkup
+			{
+				EmarkupStartTag,
+				EmarkupEndTag,
+				EmarkupEmptyTag,
+				EmarkupOther		// comments, processing instructions, etc.
+			};
+
+			// location of the metadata section in a document
+			struct SMetadataSection
+			{
+				// end of the start tag of the root element
+				const CHAR *m_szRootEnd;
+
+				// name of the root element and its length
+				const CHAR *m_szRootName;
+				ULONG m_ulRootNameLength;
+
+				// start and end of the content of the metadata element
+				const CHAR *m_szContent;
+				const CHAR *m_szContentEnd;
+
+				// number of top-level elements in the content
+				ULONG m_ulElements;
+			};
+
+			// argument of a task parsing a chunk of metadata elements
+			struct SParseTaskArg
+			{
+				// memory pool of parsed objects
+				IMemoryPool *m_pmp;
+
+				// document wrapping the chunk
+				CHAR *m_szDXL;
+
+				// parsed objects
+				DrgPimdobj *m_pdrgpmdobj;
+			};
+
+			// maximum number of tasks parsing metadata chunks
+			static
+			const ULONG ulParseTasksMax;
+
+			// end of the markup starting at the given position, NULL if the
+			// markup is not terminated
+			static
+			const CHAR *SzMarkupEnd(const CHAR *sz, EMarkup *pemarkup);
+
+			// does the tag at the given position have the given name
+			static
+			BOOL FTagName(const CHAR *szTag, const CHAR *szName);
+
+			// locate the metadata section of a document
+			static
+			BOOL FLocateMetadata(const CHAR *szDXL, SMetadataSection *psect);
+
+			// scan the top-level elements of the metadata section, recording
+			// the start of the given number of chunks of about equal size;
+			// returns the end of the content, NULL if it cannot be split
+			static
+			const CHAR *SzScanElements
+				(
+				const CHAR *szContent,
+				ULONG *pulElements,
+				ULONG ulContentLength,
+				ULONG ulChunks,
+				const CHAR **rgszChunk
+				);
+
+			// length of a document holding the given metadata elements,
+			// including the terminating null character
+			static
+			ULONG UlChunkLength(const CHAR *szDXL, const SMetadataSection *psect, const CHAR *szStart, const CHAR *szEnd);
+
+			// write a document holding the given metadata elements into the
+			// given buffer, returning the position after it
+			static
+			CHAR *SzWriteChunk
+				(
+				CHAR *szOut,
+				const CHAR *szDXL,
+				const SMetadataSection *psect,
+				const CHAR *szStart,
+				const CHAR *szEnd
+				);
+
+			// build the document without the content of the metadata section
+			static
+			CHAR *SzWithoutMetadata(IMemoryPool *pmp, const CHAR *szDXL, const SMetadataSection *psect);
+
+			// task parsing a chunk of metadata elements
+			static
+			void *PvParseChunk(void *pv);
+
+		public:
+
+			// minimum number of metadata elements for parsing in parallel
+			static
+			const ULONG ulParallelElementsMin;
+
+			// parse a DXL document, parsing the elements of its metadata
+			// section on worker tasks if there are at least the given number
+			static
+			CParseHandlerDXL *PphdxlParse
+				(
+				IMemoryPool *pmp,
+				const CHAR *szDXL,
+				ULONG ulElementsMin
+				);
+
+	}; // class CDXLParallelParser
+}
+
+#endif // !GPDXL_CDXLParallelParser_H
+
+// EOF
@@ -18,6 +18,7 @@
 #include "gpos/string/CWStringDynamic.h"
 
 #include "naucrates/dxl/operators/CDXLNode.h"
+#include "naucrates/dxl/xml/CDXLSinkStream.h"
 #include "naucrates/dxl/xml/dxltokens.h"
 
 #include "naucrates/md/CMDIdGPDB.h"
@@ -54,6 +55,19 @@ namespace gpdxl
 	class CQueryToDXLResult;
 	
 	typedef CDynamicPtrArray<CStatistics, CleanupRelease> DrgPstats;
+
+	// arguments of a task validating a DXL document
+	struct SValidateDXLArg
+	{
+		// document to validate
+		const CHAR *m_szDXL;
+
+		// external schema location
+		const CHAR *m_szXSDPath;
+
+		// output: does the document conform to the schema
+		BOOL m_fValid;
+	};
 	
 	//---------------------------------------------------------------------------
 	//	@class:
@@ -68,6 +82,10 @@ namespace gpdxl
 			
 		private:
 
+			// decode a Xerces UTF-16 string into a new wide character array
+			static
+			WCHAR *WszFromXMLCh(IMemoryPool *pmp, const XMLCh *xmlsz, ULONG *pulLength = NULL);
+
 			// same as above but with a wide string parameter for the DXL document
 			static 
 			CParseHandlerDXL *PphdxlParseDXL
@@ -81,6 +99,40 @@ namespace gpdxl
 			static void SerializeHeader(IMemoryPool *, CXMLSerializer *);
 			static void SerializeFooter(CXMLSerializer *);
 
+			// serialize a DXL query tree using the given serializer
+			static
+			void SerializeQuery
+				(
+				IMemoryPool *pmp,
+				CXMLSerializer *pxmlser,
+				const CDXLNode *pdxlnQuery,
+				const DrgPdxln *pdrgpdxlnQueryOutput,
+				const DrgPdxln *pdrgpdxlnCTE,
+				BOOL fDocumentHeaderFooter
+				);
+
+			// serialize a plan using the given serializer
+			static
+			void SerializePlan
+				(
+				IMemoryPool *pmp,
+				CXMLSerializer *pxmlser,
+				const CDXLNode *pdxln,
+				ULLONG ullPlanId,
+				ULLONG ullPlanSpaceSize,
+				BOOL fDocumentHeaderFooter
+				);
+
+			// serialize metadata objects using the given serializer
+			static
+			void SerializeMetadata
+				(
+				IMemoryPool *pmp,
+				CXMLSerializer *pxmlser,
+				const DrgPimdobj *pdrgpmdobj,
+				BOOL fDocumentHeaderFooter
+				);
+
 		public:
 			
 			// helper routine which initializes and starts the xerces parser, 
@@ -168,6 +220,45 @@ namespace gpdxl
 				const CHAR *szXSDPath
 				);
 			
+			// replay a binary DXL document to the DXL parse handlers and
+			// return the top-level parse handler
+			static
+			CParseHandlerDXL *PphdxlParseBinaryDXL
+				(
+				IMemoryPool *,
+				const BYTE *pba,
+				ULONG ulLength
+				);
+
+			// parse a binary DXL document containing a DXL plan
+			static
+			CDXLNode *PdxlnParseBinaryPlan
+				(
+				IMemoryPool *,
+				const BYTE *pba,
+				ULONG ulLength,
+				ULLONG *pullPlanId,
+				ULLONG *pullPlanSpaceSize
+				);
+
+			// parse a binary DXL document representing a query
+			static
+			CQueryToDXLResult *PdxlnParseBinaryDXLQuery
+				(
+				IMemoryPool *,
+				const BYTE *pba,
+				ULONG ulLength
+				);
+
+			// parse a list of metadata objects from a binary DXL document
+			static
+			DrgPimdobj *PdrgpmdobjParseBinaryDXL
+				(
+				IMemoryPool *,
+				const BYTE *pba,
+				ULONG ulLength
+				);
+
 			// parse mdid from a metadata document
 			static 
 			IMDId *PmdidParseDXL
@@ -231,6 +322,10 @@ namespace gpdxl
 				const CHAR *szXSDPath				
 				);
 
+			// task validating an XML document against the DXL schema
+			static
+			void *PvValidateDXL(void *pv);
+
 			// serialize a DXL query tree into DXL Document
 			static 
 			void SerializeQuery
@@ -265,6 +360,20 @@ namespace gpdxl
 				BOOL fIndent
 				);
 
+			// serialize a plan into DXL written in UTF-8 to the given sink
+			static
+			void SerializePlan
+				(
+				IMemoryPool *pmp,
+				PfDXLSink *pfsink,
+				void *pvSinkArg,
+				const CDXLNode *pdxln,
+				ULLONG ullPlanId,
+				ULLONG ullPlanSpaceSize,
+				BOOL fDocumentHeaderFooter = true,
+				BOOL fIndent = false
+				);
+
 			static 
 			CWStringDynamic *PstrSerializeStatistics
 				(
@@ -340,6 +449,37 @@ namespace gpdxl
 				BOOL fIndent
 				);
 			
+			// serialize a DXL query tree into a binary DXL document
+			static
+			BYTE *PbaSerializeQuery
+				(
+				IMemoryPool *pmp,
+				const CDXLNode *pdxlnQuery,
+				const DrgPdxln *pdrgpdxlnQueryOutput,
+				const DrgPdxln *pdrgpdxlnCTE,
+				ULONG *pulLength
+				);
+
+			// serialize a plan into a binary DXL document
+			static
+			BYTE *PbaSerializePlan
+				(
+				IMemoryPool *pmp,
+				const CDXLNode *pdxln,
+				ULLONG ullPlanId,
+				ULLONG ullPlanSpaceSize,
+				ULONG *pulLength
+				);
+
+			// serialize a list of metadata objects into a binary DXL document
+			static
+			BYTE *PbaSerializeMetadata
+				(
+				IMemoryPool *pmp,
+				const DrgPimdobj *pdrgpmdobj,
+				ULONG *pulLength
+				);
+
 			// serialize optimizer configuration
 			static
 			void SerializeOptimizerConfig
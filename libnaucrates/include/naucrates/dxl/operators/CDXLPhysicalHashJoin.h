@@ -42,16 +42,25 @@ namespace gpdxl
 	class CDXLPhysicalHashJoin : public CDXLPhysicalJoin
 	{
 		private:
+			// does the join build a runtime filter applied to its outer (probe) side
+			BOOL m_fRuntimeFilter;
+
 			// private copy ctor
 			CDXLPhysicalHashJoin(const CDXLPhysicalHashJoin&);
 
 		public:
 			// ctor/dtor
-			CDXLPhysicalHashJoin(IMemoryPool *pmp, EdxlJoinType edxljt);
+			CDXLPhysicalHashJoin(IMemoryPool *pmp, EdxlJoinType edxljt, BOOL fRuntimeFilter);
 			
 			// accessors
 			Edxlopid Edxlop() const;
 			const CWStringConst *PstrOpName() const;
+
+			// does the join build a runtime filter applied to its outer (probe) side
+			BOOL FRuntimeFilter() const
+			{
+				return m_fRuntimeFilter;
+			}
 			
 			// serialize operator in DXL format
 			virtual
@@ -73,6 +73,11 @@ namespace gpdxl
 			
 			// array of parse handlers for child elements
 			DrgPph *m_pdrgpph;
+
+			// token string of an element name, or the name itself if it is
+			// not a token
+			static
+			const XMLCh *XmlszName(const XMLCh *xmlszLocalname);
 			
 		protected:
 			// memory pool to create DXL objects in
@@ -0,0 +1,90 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CParseHandlerExtendedStats.h
+//
+//	@doc:
+//		SAX parse handler class for parsing multi-column statistics of a
+//		relation stats object
+//---------------------------------------------------------------------------
+
+#ifndef GPDXL_CParseHandlerExtendedStats_H
+#define GPDXL_CParseHandlerExtendedStats_H
+
+#include "gpos/base.h"
+#include "naucrates/dxl/parser/CParseHandlerBase.h"
+
+// fwd decl
+namespace gpmd
+{
+	class CDXLExtendedStats;
+}
+
+namespace gpdxl
+{
+	using namespace gpos;
+	using namespace gpmd;
+	using namespace gpnaucrates;
+
+	XERCES_CPP_NAMESPACE_USE
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CParseHandlerExtendedStats
+	//
+	//	@doc:
+	//		Parse handler class for multi-column statistics of relation stats
+	//		objects
+	//
+	//---------------------------------------------------------------------------
+	class CParseHandlerExtendedStats : public CParseHandlerBase
+	{
+		private:
+
+			// dxl extended stats object
+			CDXLExtendedStats *m_pdxlextstats;
+
+			// private copy ctor
+			CParseHandlerExtendedStats(const CParseHandlerExtendedStats&);
+
+			// process the start of an element
+			void StartElement
+				(
+				const XMLCh* const xmlszUri, 		// URI of element's namespace
+ 				const XMLCh* const xmlszLocalname,	// local part of element's name
+				const XMLCh* const xmlszQname,		// element's qname
+				const Attributes& attr				// element's attributes
+				);
+
+			// process the end of an element
+			void EndElement
+				(
+				const XMLCh* const xmlszUri, 		// URI of element's namespace
+				const XMLCh* const xmlszLocalname,	// local part of element's name
+				const XMLCh* const xmlszQname		// element's qname
+				);
+
+		public:
+
+			// ctor
+			CParseHandlerExtendedStats
+				(
+				IMemoryPool *pmp,
+				CParseHandlerManager *pphm,
+				CParseHandlerBase *pphRoot
+				);
+
+			// dtor
+			virtual
+			~CParseHandlerExtendedStats();
+
+			// returns the constructed extended stats
+			CDXLExtendedStats *Pdxlextstats() const;
+	};
+}
+
+#endif // !GPDXL_CParseHandlerExtendedStats_H
+
+// EOF
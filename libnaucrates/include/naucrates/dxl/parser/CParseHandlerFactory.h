@@ -13,7 +13,6 @@
 #define GPDXL_CParseHandlerFactory_H
 
 #include "gpos/base.h"
-#include "gpos/common/CHashMap.h"
 
 #include "naucrates/exception.h"
 #include "naucrates/dxl/operators/CDXLPhysical.h"
@@ -32,23 +31,6 @@ namespace gpdxl
 	// fwd decl
 	class CDXLTokens;
 	
-	const ULONG ulHashMapSize = 128;
-	
-	// function for hashing xerces strings
-	inline 
-	ULONG UlHashXMLStr(const XMLCh *xmlsz)
-	{
-		return (ULONG) XMLString::hash(xmlsz, ulHashMapSize);
-	}
-	
-	// function for equality on xerces strings
-	inline 
-	BOOL FEqualXMLStr(const XMLCh *xmlsz1, const XMLCh *xmlsz2)
-	{
-		return (0 == XMLString::compareString(xmlsz1, xmlsz2));
-	}
-
-	
 	//---------------------------------------------------------------------------
 	//	@class:
 	//		CParseHandlerFactory
@@ -60,9 +42,6 @@ namespace gpdxl
 	class CParseHandlerFactory
 	{
 		
-		typedef CHashMap<const XMLCh, PfParseHandlerOpCreator, UlHashXMLStr, FEqualXMLStr,
-			CleanupNULL, CleanupNULL > HMXMLStrPfPHCreator;
-
 		// pair of DXL token type and the corresponding parse handler
 		struct SParseHandlerMapping
 		{
@@ -74,9 +53,10 @@ namespace gpdxl
 		};
 		
 		private:
-			// mappings DXL token -> ParseHandler creator
+			// mappings DXL token -> ParseHandler creator, indexed by the token
+			// ids element names resolve to
 			static 
-			HMXMLStrPfPHCreator *m_phmPHCreators;
+			PfParseHandlerOpCreator *m_rgpfphopc[EdxltokenSentinel];
 
 			static 
 			void AddMapping(Edxltoken edxltok, PfParseHandlerOpCreator *pfphopc);
@@ -243,6 +223,24 @@ namespace gpdxl
 				CParseHandlerBase *pphRoot
 				);
 
+			// construct a multi-column statistics parse handler
+			static
+			CParseHandlerBase *PphExtendedStats
+				(
+				IMemoryPool *pmp,
+				CParseHandlerManager *pphm,
+				CParseHandlerBase *pphRoot
+				);
+
+			// construct a HyperLogLog sketch parse handler
+			static
+			CParseHandlerBase *PphHLLSketch
+				(
+				IMemoryPool *pmp,
+				CParseHandlerManager *pphm,
+				CParseHandlerBase *pphRoot
+				);
+
 			// construct an MD type parse handler
 			static
 			CParseHandlerBase *PphMDGPDBType
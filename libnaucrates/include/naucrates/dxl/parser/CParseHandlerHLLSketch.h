@@ -0,0 +1,96 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CParseHandlerHLLSketch.h
+//
+//	@doc:
+//		SAX parse handler class for parsing the HyperLogLog sketch of a
+//		column stats object
+//---------------------------------------------------------------------------
+
+#ifndef GPDXL_CParseHandlerHLLSketch_H
+#define GPDXL_CParseHandlerHLLSketch_H
+
+#include "gpos/base.h"
+#include "naucrates/dxl/parser/CParseHandlerBase.h"
+
+// fwd decl
+namespace gpmd
+{
+	class CDXLHLLSketch;
+}
+
+namespace gpdxl
+{
+	using namespace gpos;
+	using namespace gpmd;
+	using namespace gpnaucrates;
+
+	XERCES_CPP_NAMESPACE_USE
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CParseHandlerHLLSketch
+	//
+	//	@doc:
+	//		Parse handler class for HyperLogLog sketches of column stats objects
+	//
+	//---------------------------------------------------------------------------
+	class CParseHandlerHLLSketch : public CParseHandlerBase
+	{
+		private:
+
+			// dxl sketch object
+			CDXLHLLSketch *m_pdxlhllsketch;
+
+			// private copy ctor
+			CParseHandlerHLLSketch(const CParseHandlerHLLSketch&);
+
+			// process the start of an element
+			void StartElement
+				(
+				const XMLCh* const xmlszUri, 		// URI of element's namespace
+ 				const XMLCh* const xmlszLocalname,	// local part of element's name
+				const XMLCh* const xmlszQname,		// element's qname
+				const Attributes& attr				// element's attributes
+				);
+
+			// process the end of an element
+			void EndElement
+				(
+				const XMLCh* const xmlszUri, 		// URI of element's namespace
+				const XMLCh* const xmlszLocalname,	// local part of element's name
+				const XMLCh* const xmlszQname		// element's qname
+				);
+
+		public:
+
+			// smallest and largest supported precision
+			static
+			const ULONG ulPrecisionMin;
+
+			static
+			const ULONG ulPrecisionMax;
+
+			// ctor
+			CParseHandlerHLLSketch
+				(
+				IMemoryPool *pmp,
+				CParseHandlerManager *pphm,
+				CParseHandlerBase *pphRoot
+				);
+
+			// dtor
+			virtual
+			~CParseHandlerHLLSketch();
+
+			// returns the constructed sketch
+			CDXLHLLSketch *Pdxlhllsketch() const;
+	};
+}
+
+#endif // !GPDXL_CParseHandlerHLLSketch_H
+
+// EOF
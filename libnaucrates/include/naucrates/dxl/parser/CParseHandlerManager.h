@@ -18,6 +18,7 @@
 #include "gpos/common/CStack.h"
 
 #include "naucrates/dxl/parser/CParseHandlerBase.h"
+#include "naucrates/dxl/xml/CDXLAttributes.h"
 
 #include <xercesc/sax2/SAX2XMLReader.hpp>
 
@@ -49,7 +50,8 @@ namespace gpdxl
 			// the memory manager used for parsing the current document
 			CDXLMemoryManager *m_pmm;
 			
-			// parser object responsible for parsing the current XML document
+			// parser object responsible for parsing the current XML document;
+			// NULL for documents replayed from the binary format
 			SAX2XMLReader *m_pxmlreader;
 			
 			// current parse handler
@@ -58,12 +60,18 @@ namespace gpdxl
 			// stack of parse handlers
 			PHStack *m_pphstack;
 		
+			// attributes of the element being parsed, with resolved names
+			CDXLAttributes *m_pdxlattrs;
+
 			// steps since last check for aborts
 			ULONG m_ulIterLastCFA;
 			
 			// check for aborts at regular intervals
 			void CheckForAborts();
 
+			// register the current handler with the SAX reader
+			void SetHandlers();
+
 			// private copy ctor
 			CParseHandlerManager(const CParseHandlerManager &);
 			
@@ -104,6 +112,15 @@ namespace gpdxl
 			
 			// Returns the current parse handler if one exists; used for debugging purposes
 			const CParseHandlerBase *PphCurrent();
+
+			// Returns the handler receiving the events of the current document
+			CParseHandlerBase *PphActive();
+
+			// attributes of the element being parsed
+			CDXLAttributes *Pdxlattrs()
+			{
+				return m_pdxlattrs;
+			}
 			
 	};
 }
@@ -15,6 +15,12 @@
 #include "gpos/base.h"
 #include "naucrates/dxl/parser/CParseHandlerMetadataObject.h"
 
+// fwd decl
+namespace gpmd
+{
+	class CMDIdRelStats;
+}
+
 namespace gpdxl
 {
 	using namespace gpos;
@@ -34,7 +40,19 @@ namespace gpdxl
 	class CParseHandlerRelStats : public CParseHandlerMetadataObject
 	{
 		private:
-		
+
+			// metadata id of the object
+			CMDIdRelStats *m_pmdidRelStats;
+
+			// table name
+			CMDName *m_pmdname;
+
+			// number of rows
+			CDouble m_dRows;
+
+			// flag to indicate if input relation is empty
+			BOOL m_fEmpty;
+
 			// private copy ctor
 			CParseHandlerRelStats(const CParseHandlerRelStats&);
 
@@ -38,6 +38,8 @@
 #include "naucrates/dxl/parser/CParseHandlerRelStats.h"
 #include "naucrates/dxl/parser/CParseHandlerColStats.h"
 #include "naucrates/dxl/parser/CParseHandlerColStatsBucket.h"
+#include "naucrates/dxl/parser/CParseHandlerExtendedStats.h"
+#include "naucrates/dxl/parser/CParseHandlerHLLSketch.h"
 #include "naucrates/dxl/parser/CParseHandlerMDCast.h"
 #include "naucrates/dxl/parser/CParseHandlerMDScCmp.h"
 #include "naucrates/dxl/parser/CParseHandlerMDArrayCoerceCast.h"
@@ -0,0 +1,156 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CDXLAttributes.h
+//
+//	@doc:
+//		Attributes of a DXL element with names resolved to DXL tokens
+//---------------------------------------------------------------------------
+#ifndef GPDXL_CDXLAttributes_H
+#define GPDXL_CDXLAttributes_H
+
+#include "gpos/base.h"
+
+#include "naucrates/dxl/xml/dxltokens.h"
+
+#include <xercesc/sax2/Attributes.hpp>
+
+namespace gpdxl
+{
+	using namespace gpos;
+
+	XERCES_CPP_NAMESPACE_USE
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CDXLAttributes
+	//
+	//	@doc:
+	//		View of the attributes of the element being parsed, which resolves
+	//		each attribute name to its DXL token once per element. Parse
+	//		handlers look up attributes by token strings, which are then found
+	//		by comparing addresses instead of comparing the strings of all
+	//		attributes of the element.
+	//
+	//---------------------------------------------------------------------------
+	class CDXLAttributes : public Attributes
+	{
+		private:
+
+			// memory pool
+			IMemoryPool *m_pmp;
+
+			// attributes of the current element -- not owned
+			const Attributes *m_pattrs;
+
+			// token strings of the attribute names, NULL for names that are
+			// not tokens
+			const XMLCh **m_rgxmlszName;
+
+			// number of attributes
+			ULONG m_ulLength;
+
+			// size of the name array
+			ULONG m_ulCapacity;
+
+			// private copy ctor
+			CDXLAttributes(const CDXLAttributes &);
+
+			// find the attribute whose name resolved to the given token string
+			BOOL FFindToken(const XMLCh *xmlszToken, XMLSize_t *pulIndex) const;
+
+		public:
+
+			// ctor
+			explicit
+			CDXLAttributes(IMemoryPool *pmp);
+
+			// dtor
+			virtual
+			~CDXLAttributes();
+
+			// resolve the names of the attributes of a new element
+			void Reset(const Attributes *pattrs);
+
+			// Attributes interface functions
+
+			virtual
+			XMLSize_t getLength() const
+			{
+				return m_ulLength;
+			}
+
+			virtual
+			const XMLCh *getURI(const XMLSize_t ulIndex) const
+			{
+				return m_pattrs->getURI(ulIndex);
+			}
+
+			virtual
+			const XMLCh *getLocalName(const XMLSize_t ulIndex) const
+			{
+				return m_pattrs->getLocalName(ulIndex);
+			}
+
+			virtual
+			const XMLCh *getQName(const XMLSize_t ulIndex) const
+			{
+				return m_pattrs->getQName(ulIndex);
+			}
+
+			virtual
+			const XMLCh *getType(const XMLSize_t ulIndex) const
+			{
+				return m_pattrs->getType(ulIndex);
+			}
+
+			virtual
+			const XMLCh *getValue(const XMLSize_t ulIndex) const
+			{
+				return m_pattrs->getValue(ulIndex);
+			}
+
+			virtual
+			bool getIndex(const XMLCh *const xmlszUri, const XMLCh *const xmlszLocalPart, XMLSize_t &ulIndex) const
+			{
+				return m_pattrs->getIndex(xmlszUri, xmlszLocalPart, ulIndex);
+			}
+
+			virtual
+			int getIndex(const XMLCh *const xmlszUri, const XMLCh *const xmlszLocalPart) const
+			{
+				return m_pattrs->getIndex(xmlszUri, xmlszLocalPart);
+			}
+
+			virtual
+			bool getIndex(const XMLCh *const xmlszQName, XMLSize_t &ulIndex) const;
+
+			virtual
+			int getIndex(const XMLCh *const xmlszQName) const;
+
+			virtual
+			const XMLCh *getType(const XMLCh *const xmlszUri, const XMLCh *const xmlszLocalPart) const
+			{
+				return m_pattrs->getType(xmlszUri, xmlszLocalPart);
+			}
+
+			virtual
+			const XMLCh *getType(const XMLCh *const xmlszQName) const;
+
+			virtual
+			const XMLCh *getValue(const XMLCh *const xmlszUri, const XMLCh *const xmlszLocalPart) const
+			{
+				return m_pattrs->getValue(xmlszUri, xmlszLocalPart);
+			}
+
+			virtual
+			const XMLCh *getValue(const XMLCh *const xmlszQName) const;
+
+	}; // class CDXLAttributes
+}
+
+#endif // !GPDXL_CDXLAttributes_H
+
+// EOF
@@ -0,0 +1,77 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CDXLBinaryFormat.h
+//
+//	@doc:
+//		Constants of the binary encoding of DXL documents
+//---------------------------------------------------------------------------
+#ifndef GPDXL_CDXLBinaryFormat_H
+#define GPDXL_CDXLBinaryFormat_H
+
+#include "gpos/base.h"
+
+namespace gpdxl
+{
+	using namespace gpos;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CDXLBinaryFormat
+	//
+	//	@doc:
+	//		Binary DXL documents carry the same elements and attributes as XML
+	//		DXL documents. A document starts with the magic bytes "DXLB", the
+	//		format version and the hash of the DXL token table, followed by a
+	//		record for each element start, attribute and element end, and an
+	//		end of document record.
+	//
+	//		Unsigned integers are written as variable-length base-128 numbers,
+	//		least significant group first. Names are written as DXL token ids,
+	//		or inline for names that are not tokens. Strings are written as the
+	//		number of bytes of their UTF-8 encoding followed by those bytes.
+	//
+	//---------------------------------------------------------------------------
+	class CDXLBinaryFormat
+	{
+		public:
+
+			// document header
+			enum EHeader
+			{
+				EhdrMagic0 = 'D',
+				EhdrMagic1 = 'X',
+				EhdrMagic2 = 'L',
+				EhdrMagic3 = 'B',
+
+				// version of the record layout
+				EhdrVersion = 1
+			};
+
+			// record tags
+			enum ERecord
+			{
+				ErecEnd = 0,			// end of document
+				ErecOpenElement,		// namespace name, element name
+				ErecAttribute,			// attribute name, value string
+				ErecCloseElement,		// no payload
+
+				ErecSentinel
+			};
+
+			// name encodings; any larger number is a token id offset by EnameToken
+			enum EName
+			{
+				EnameNone = 0,			// no name, e.g., no namespace
+				EnameInline,			// string follows
+				EnameToken
+			};
+
+	}; // class CDXLBinaryFormat
+}
+
+#endif // !GPDXL_CDXLBinaryFormat_H
+
+// EOF
@@ -0,0 +1,260 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CDXLBinaryReader.h
+//
+//	@doc:
+//		Reader replaying binary DXL documents to DXL parse handlers
+//---------------------------------------------------------------------------
+#ifndef GPDXL_CDXLBinaryReader_H
+#define GPDXL_CDXLBinaryReader_H
+
+#include "gpos/base.h"
+#include "gpos/common/CDynamicPtrArray.h"
+
+#include "naucrates/dxl/xml/CDXLBinaryFormat.h"
+
+#include <xercesc/sax2/Attributes.hpp>
+
+namespace gpdxl
+{
+	using namespace gpos;
+
+	XERCES_CPP_NAMESPACE_USE
+
+	// fwd decl
+	class CParseHandlerManager;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CDXLBinaryReader
+	//
+	//	@doc:
+	//		Decodes a document written by CDXLBinarySerializer and hands its
+	//		elements and attributes to the active parse handler as SAX events,
+	//		so the parse handlers of XML documents build the DXL objects.
+	//		Decoded strings live in a buffer used as a stack: the names of open
+	//		elements stay until the element is closed, attribute values only
+	//		until the start of the element has been handled.
+	//
+	//---------------------------------------------------------------------------
+	class CDXLBinaryReader
+	{
+		private:
+
+			// name of an element or attribute
+			struct SName
+			{
+				// token string, NULL if the name was decoded into the buffer
+				const XMLCh *m_xmlszToken;
+
+				// offset of the decoded name in the buffer
+				ULONG m_ulOffset;
+			};
+
+			// attribute of the element being opened
+			struct SAttribute
+			{
+				// attribute name
+				SName m_name;
+
+				// offset of the decoded value in the buffer
+				ULONG m_ulOffset;
+
+				// name and value handed to the parse handler
+				const XMLCh *m_xmlszName;
+				const XMLCh *m_xmlszValue;
+			};
+
+			// open element
+			struct SElement
+			{
+				// size of the buffer before the element was opened
+				ULONG m_ulBufferStart;
+
+				// is the element name qualified by a namespace
+				BOOL m_fNamespace;
+
+				// namespace prefix
+				SName m_nameNamespace;
+
+				// local name
+				SName m_name;
+
+				// offset of the qualified name in the buffer
+				ULONG m_ulQnameOffset;
+			};
+
+			typedef CDynamicPtrArray<SAttribute, CleanupDelete> DrgPattr;
+			typedef CDynamicPtrArray<SElement, CleanupDelete> DrgPelem;
+
+			//---------------------------------------------------------------------------
+			//	@class:
+			//		CAttributes
+			//
+			//	@doc:
+			//		Xerces view of the attributes of the element being opened
+			//
+			//---------------------------------------------------------------------------
+			class CAttributes : public Attributes
+			{
+				private:
+
+					// attributes, entries beyond the length are unused
+					const DrgPattr *m_pdrgpattr;
+
+					// number of attributes
+					ULONG m_ulLength;
+
+					// private copy ctor
+					CAttributes(const CAttributes &);
+
+				public:
+
+					// ctor
+					CAttributes(const DrgPattr *pdrgpattr, ULONG ulLength)
+						:
+						m_pdrgpattr(pdrgpattr),
+						m_ulLength(ulLength)
+					{}
+
+					// dtor
+					virtual
+					~CAttributes()
+					{}
+
+					// Attributes interface functions
+
+					virtual
+					XMLSize_t getLength() const
+					{
+						return m_ulLength;
+					}
+
+					virtual
+					const XMLCh *getURI(const XMLSize_t ulIndex) const;
+
+					virtual
+					const XMLCh *getLocalName(const XMLSize_t ulIndex) const;
+
+					virtual
+					const XMLCh *getQName(const XMLSize_t ulIndex) const;
+
+					virtual
+					const XMLCh *getType(const XMLSize_t ulIndex) const;
+
+					virtual
+					const XMLCh *getValue(const XMLSize_t ulIndex) const;
+
+					virtual
+					bool getIndex(const XMLCh *const xmlszUri, const XMLCh *const xmlszLocalPart, XMLSize_t &ulIndex) const;
+
+					virtual
+					int getIndex(const XMLCh *const xmlszUri, const XMLCh *const xmlszLocalPart) const;
+
+					virtual
+					bool getIndex(const XMLCh *const xmlszQName, XMLSize_t &ulIndex) const;
+
+					virtual
+					int getIndex(const XMLCh *const xmlszQName) const;
+
+					virtual
+					const XMLCh *getType(const XMLCh *const xmlszUri, const XMLCh *const xmlszLocalPart) const;
+
+					virtual
+					const XMLCh *getType(const XMLCh *const xmlszQName) const;
+
+					virtual
+					const XMLCh *getValue(const XMLCh *const xmlszUri, const XMLCh *const xmlszLocalPart) const;
+
+					virtual
+					const XMLCh *getValue(const XMLCh *const xmlszQName) const;
+
+			}; // class CAttributes
+
+			// memory pool
+			IMemoryPool *m_pmp;
+
+			// document -- not owned
+			const BYTE *m_pba;
+
+			// size of the document
+			ULONG m_ulLength;
+
+			// position of the next byte to read
+			ULONG m_ulPos;
+
+			// buffer for decoded strings
+			XMLCh *m_xmlszBuffer;
+
+			// number of characters used in the buffer
+			ULONG m_ulBufferLength;
+
+			// size of the buffer
+			ULONG m_ulBufferCapacity;
+
+			// attributes of the element being opened; entries are reused
+			DrgPattr *m_pdrgpattr;
+
+			// stack of open elements; entries are reused
+			DrgPelem *m_pdrgpelem;
+
+			// number of open elements
+			ULONG m_ulDepth;
+
+			// private copy ctor
+			CDXLBinaryReader(const CDXLBinaryReader &);
+
+			// raise an exception for a malformed document
+			static
+			void RaiseMalformed();
+
+			// make room for the given number of characters in the buffer
+			void Reserve(ULONG ulChars);
+
+			// read a single byte
+			BYTE ByteRead();
+
+			// read an unsigned integer
+			ULONG UlRead();
+
+			// read a string and append it to the buffer
+			void ReadString();
+
+			// read a name; returns false if no name was written
+			BOOL FReadName(SName *pname);
+
+			// string of the given name
+			const XMLCh *XmlszName(const SName &name) const;
+
+			// append the qualified name of an element to the buffer
+			void AppendQname(const SElement *pelem);
+
+			// read and validate the document header
+			void ReadHeader();
+
+			// replay an element start and its attributes
+			void OpenElement(CParseHandlerManager *pphm);
+
+			// replay an element end
+			void CloseElement(CParseHandlerManager *pphm);
+
+		public:
+
+			// ctor
+			CDXLBinaryReader(IMemoryPool *pmp, const BYTE *pba, ULONG ulLength);
+
+			// dtor
+			~CDXLBinaryReader();
+
+			// replay the document to the parse handlers of the given manager
+			void Parse(CParseHandlerManager *pphm);
+
+	}; // class CDXLBinaryReader
+}
+
+#endif // !GPDXL_CDXLBinaryReader_H
+
+// EOF
@@ -0,0 +1,140 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CDXLBinarySerializer.h
+//
+//	@doc:
+//		Serializer writing DXL documents in binary format
+//---------------------------------------------------------------------------
+#ifndef GPDXL_CDXLBinarySerializer_H
+#define GPDXL_CDXLBinarySerializer_H
+
+#include "gpos/base.h"
+#include "gpos/string/CWStringDynamic.h"
+
+#include "naucrates/dxl/xml/CXMLSerializer.h"
+#include "naucrates/dxl/xml/CDXLBinaryFormat.h"
+
+namespace gpdxl
+{
+	using namespace gpos;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CDXLBinarySerializer
+	//
+	//	@doc:
+	//		Serializer writing the elements and attributes of DXL objects in the
+	//		binary format described in CDXLBinaryFormat into a byte buffer;
+	//		DXL objects serialize themselves into it as they do into XML
+	//
+	//---------------------------------------------------------------------------
+	class CDXLBinarySerializer : public CXMLSerializer
+	{
+		private:
+
+			// document buffer
+			BYTE *m_pba;
+
+			// number of bytes written to the buffer
+			ULONG m_ulLength;
+
+			// size of the buffer
+			ULONG m_ulCapacity;
+
+			// buffer for formatting attribute values
+			CWStringDynamic m_strValue;
+
+			// private copy ctor
+			CDXLBinarySerializer(const CDXLBinarySerializer &);
+
+			// make room for the given number of bytes
+			void Reserve(ULONG ulBytes);
+
+			// write a single byte
+			void WriteByte(BYTE b);
+
+			// write an unsigned integer
+			void WriteUl(ULONG ul);
+
+			// write a string of wide characters
+			void WriteString(const WCHAR *wsz, ULONG ulLength);
+
+			// write a string of characters
+			void WriteString(const CHAR *sz);
+
+			// write an element or attribute name
+			void WriteName(const CWStringBase *pstr);
+
+			// write an attribute whose value was formatted into the value buffer
+			void WriteFormattedAttribute(const CWStringBase *pstrAttr);
+
+		public:
+
+			// ctor
+			explicit
+			CDXLBinarySerializer(IMemoryPool *pmp);
+
+			// dtor
+			virtual
+			~CDXLBinarySerializer();
+
+			// starts a document
+			virtual
+			void StartDocument();
+
+			// opens a new element with the given name
+			virtual
+			void OpenElement(const CWStringBase *pstrNamespace, const CWStringBase *pstrElem);
+
+			// closes the element with the given name
+			virtual
+			void CloseElement(const CWStringBase *pstrNamespace, const CWStringBase *pstrElem);
+
+			// adds a string-valued attribute
+			virtual
+			void AddAttribute(const CWStringBase *pstrAttr, const CWStringBase *pstrValue);
+
+			// adds a character string attribute
+			virtual
+			void AddAttribute(const CWStringBase *pstrAttr, const CHAR *szValue);
+
+			// adds an unsigned integer-valued attribute
+			virtual
+			void AddAttribute(const CWStringBase *pstrAttr, ULONG ulValue);
+
+			// adds an unsigned long integer attribute
+			virtual
+			void AddAttribute(const CWStringBase *pstrAttr, ULLONG ullValue);
+
+			// adds an integer-valued attribute
+			virtual
+			void AddAttribute(const CWStringBase *pstrAttr, INT iValue);
+
+			// adds an integer-valued attribute
+			virtual
+			void AddAttribute(const CWStringBase *pstrAttr, LINT lValue);
+
+			// adds a boolean attribute
+			virtual
+			void AddAttribute(const CWStringBase *pstrAttr, BOOL fValue);
+
+			// add a double-valued attribute
+			virtual
+			void AddAttribute(const CWStringBase *pstrAttr, CDouble dValue);
+
+			// add a byte array attribute
+			virtual
+			void AddAttribute(const CWStringBase *pstrAttr, BOOL fNull, const BYTE *pba, ULONG ulLen);
+
+			// end the document and return it; the caller owns the returned array
+			BYTE *PbaDocument(ULONG *pulLength);
+
+	}; // class CDXLBinarySerializer
+}
+
+#endif // !GPDXL_CDXLBinarySerializer_H
+
+// EOF
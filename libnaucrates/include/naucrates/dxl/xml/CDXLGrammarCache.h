@@ -0,0 +1,107 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CDXLGrammarCache.h
+//
+//	@doc:
+//		Process-wide cache of compiled XSD grammars for validating DXL
+//		documents
+//---------------------------------------------------------------------------
+#ifndef GPDXL_CDXLGrammarCache_H
+#define GPDXL_CDXLGrammarCache_H
+
+#include "gpos/base.h"
+#include "gpos/sync/CMutex.h"
+
+#include <xercesc/sax2/SAX2XMLReader.hpp>
+#include <xercesc/framework/XMLGrammarPool.hpp>
+
+namespace gpdxl
+{
+	using namespace gpos;
+
+	XERCES_CPP_NAMESPACE_USE
+
+	// fwd decl
+	class CDXLMemoryManager;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CDXLGrammarCache
+	//
+	//	@doc:
+	//		Compiling the DXL schema takes far longer than validating a typical
+	//		document against it. The cache compiles the schemas of an external
+	//		schema location once per process into a Xerces grammar pool, which
+	//		is then locked: a locked pool is immutable and may be shared by
+	//		readers on all threads. Readers created by the cache use the
+	//		compiled grammars instead of loading the schema on each parse.
+	//
+	//---------------------------------------------------------------------------
+	class CDXLGrammarCache
+	{
+		private:
+
+			// compiled grammars of an external schema location
+			struct SEntry
+			{
+				// external schema location, as given by the caller
+				CHAR *m_szXSDPath;
+
+				// external schema location handed to readers
+				XMLCh *m_xmlszXSDPath;
+
+				// locked pool holding the compiled grammars
+				XMLGrammarPool *m_pgrpool;
+
+				// next entry
+				SEntry *m_pentryNext;
+			};
+
+			// memory pool for entries
+			static
+			IMemoryPool *m_pmp;
+
+			// memory manager for compiled grammars
+			static
+			CDXLMemoryManager *m_pmm;
+
+			// mutex serializing lookups and the compilation of grammars
+			static
+			CMutexOS *m_pmutex;
+
+			// list of entries; entries are only removed at termination
+			static
+			SEntry *m_pentryFirst;
+
+			// compile the grammars of the given external schema location
+			static
+			SEntry *PentryCompile(const CHAR *szXSDPath);
+
+			// find or compile the grammars of the given external schema location
+			static
+			const SEntry *Pentry(const CHAR *szXSDPath);
+
+		public:
+
+			// initialize the cache
+			static
+			void Init(IMemoryPool *pmp);
+
+			// release the compiled grammars
+			static
+			void Terminate();
+
+			// create a reader; if an external schema location is given, the
+			// reader validates documents against the cached grammars
+			static
+			SAX2XMLReader *PxmlreaderCreate(CDXLMemoryManager *pmm, const CHAR *szXSDPath);
+
+	}; // class CDXLGrammarCache
+}
+
+#endif // !GPDXL_CDXLGrammarCache_H
+
+// EOF
@@ -0,0 +1,108 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CDXLSinkStream.h
+//
+//	@doc:
+//		Output stream writing UTF-8 text to a caller-supplied sink
+//---------------------------------------------------------------------------
+#ifndef GPDXL_CDXLSinkStream_H
+#define GPDXL_CDXLSinkStream_H
+
+#include "gpos/base.h"
+#include "gpos/io/COstream.h"
+
+// size of the buffer collecting output before it is handed to the sink
+#define GPDXL_SINK_STREAM_BUFFER_SIZE (8 * 1024)
+
+namespace gpdxl
+{
+	using namespace gpos;
+
+	// function receiving the bytes of a document as they are written
+	typedef void (PfDXLSink) (void *pvSinkArg, const BYTE *pb, ULONG ulLength);
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CDXLSinkStream
+	//
+	//	@doc:
+	//		Output stream encoding the text written to it in UTF-8 into a buffer
+	//		of bounded size, and handing the buffer to a sink function whenever
+	//		it fills up; the document is never held in memory as a whole.
+	//		Flush must be called once the document is complete.
+	//
+	//---------------------------------------------------------------------------
+	class CDXLSinkStream : public COstream
+	{
+		private:
+
+			// memory pool
+			IMemoryPool *m_pmp;
+
+			// sink function
+			PfDXLSink *m_pfsink;
+
+			// argument passed to the sink function
+			void *m_pvSinkArg;
+
+			// output buffer
+			BYTE *m_pb;
+
+			// number of bytes in the buffer
+			ULONG m_ulLength;
+
+			// total number of bytes handed to the sink
+			ULLONG m_ullBytesWritten;
+
+			// private copy ctor
+			CDXLSinkStream(const CDXLSinkStream &);
+
+			// append the UTF-8 encoding of a character to the buffer
+			void Append(WCHAR wc);
+
+		public:
+
+			// please see comments in COstream.h for an explanation
+			using COstream::operator <<;
+
+			// ctor
+			CDXLSinkStream(IMemoryPool *pmp, PfDXLSink *pfsink, void *pvSinkArg);
+
+			// dtor
+			virtual
+			~CDXLSinkStream();
+
+			// hand the buffered bytes to the sink
+			void Flush();
+
+			// total number of bytes written, including those still buffered
+			ULLONG UllBytesWritten() const
+			{
+				return m_ullBytesWritten + m_ulLength;
+			}
+
+			// implement << operator on wide char array
+			virtual
+			IOstream& operator<< (const WCHAR *wsz);
+
+			// implement << operator on char array
+			virtual
+			IOstream& operator<< (const CHAR *sz);
+
+			// implement << operator on wide char
+			virtual
+			IOstream& operator<< (const WCHAR wc);
+
+			// implement << operator on char
+			virtual
+			IOstream& operator<< (const CHAR c);
+
+	}; // class CDXLSinkStream
+}
+
+#endif // !GPDXL_CDXLSinkStream_H
+
+// EOF
@@ -41,8 +41,9 @@ namespace gpdxl
 			// memory pool
 			IMemoryPool *m_pmp;
 			
-			// output stream for writing out the xml document
-			IOstream &m_os;
+			// output stream for writing out the xml document; NULL for
+			// serializers writing documents in a different format
+			IOstream *m_pos;
 						
 			// should XML document be indented
 			BOOL m_fIndent;
@@ -69,6 +70,32 @@ namespace gpdxl
 			static
 			void WriteEscaped(IOstream &os, const CWStringBase *pstr);
 			
+		protected:
+
+			// ctor for serializers writing documents in a different format
+			explicit
+			CXMLSerializer
+				(
+				IMemoryPool *pmp
+				)
+				:
+				m_pmp(pmp),
+				m_pos(NULL),
+				m_fIndent(false),
+				m_strstackElems(NULL),
+				m_fOpenTag(false),
+				m_ulLevel(0),
+				m_ulIterLastCFA(0)
+			{
+				m_strstackElems = GPOS_NEW(m_pmp) StrStack(m_pmp);
+			}
+
+			// push an element on the stack of open elements and check for aborts
+			void PushElement(const CWStringBase *pstrElem);
+
+			// pop the given element from the stack of open elements
+			void PopElement(const CWStringBase *pstrElem);
+
 		public:
 			// ctor/dtor
 			CXMLSerializer
@@ -79,7 +106,7 @@ namespace gpdxl
 				)
 				:
 				m_pmp(pmp),
-				m_os(os),
+				m_pos(&os),
 				m_fIndent(fIndent),
 				m_strstackElems(NULL),
 				m_fOpenTag(false),
@@ -89,6 +116,7 @@ namespace gpdxl
 				m_strstackElems = GPOS_NEW(m_pmp) StrStack(m_pmp);
 			}
 			
+			virtual
 			~CXMLSerializer();
 			
 			// get underlying memory pool
@@ -98,39 +126,51 @@ namespace gpdxl
 			}
 
 			// starts an XML document
+			virtual
 			void StartDocument();
 			
 			// opens a new element with the given name
+			virtual
 			void OpenElement(const CWStringBase *pstrNamespace, const CWStringBase *pstrElem);
 			
 			// closes the element with the given name
+			virtual
 			void CloseElement(const CWStringBase *pstrNamespace, const CWStringBase *pstrElem);
 			
 			// adds a string-valued attribute
+			virtual
 			void AddAttribute(const CWStringBase *pstrAttr, const CWStringBase *pstrValue);
 			
 			// adds a character string attribute
+			virtual
 			void AddAttribute(const CWStringBase *pstrAttr, const CHAR *szValue);
 
 			// adds an unsigned integer-valued attribute
+			virtual
 			void AddAttribute(const CWStringBase *pstrAttr, ULONG ulValue);
 			
 			// adds an unsigned long integer attribute
+			virtual
 			void AddAttribute(const CWStringBase *pstrAttr, ULLONG ullValue);
 
 			// adds an integer-valued attribute
+			virtual
 			void AddAttribute(const CWStringBase *pstrAttr, INT iValue);
 			
 			// adds an integer-valued attribute
+			virtual
 			void AddAttribute(const CWStringBase *pstrAttr, LINT lValue);
 
 			// adds a boolean attribute
+			virtual
 			void AddAttribute(const CWStringBase *pstrAttr, BOOL fValue);
 			
 			// add a double-valued attribute
+			virtual
 			void AddAttribute(const CWStringBase *pstrAttr, CDouble dValue);
 
 			// add a byte array attribute
+			virtual
 			void AddAttribute(const CWStringBase *pstrAttr, BOOL fNull, const BYTE *pba, ULONG ulLen);
 	};
 	
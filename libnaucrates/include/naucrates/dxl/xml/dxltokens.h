@@ -50,6 +50,7 @@ namespace gpdxl
 		EdxltokenDampingFactorFilter,
 		EdxltokenDampingFactorJoin,
 		EdxltokenDampingFactorGroupBy,
+		EdxltokenMaxHistogramBuckets,
 		EdxltokenCTEConfig,
 		EdxltokenCTEInliningCutoff,
 		EdxltokenCostModelConfig,
@@ -282,6 +283,7 @@ namespace gpdxl
 		EdxltokenJoinLeftAntiSemiJoinNotIn,
 		
 		EdxltokenMergeJoinUniqueOuter,
+		EdxltokenHashJoinRuntimeFilter,
 		
 		EdxltokenAggStrategy,
 		EdxltokenAggStrategyPlain,
@@ -434,6 +436,8 @@ namespace gpdxl
 		EdxltokenRelationStats,
 		EdxltokenColumnStats,
 		EdxltokenColumnStatsBucket,
+		EdxltokenExtendedStats,
+		EdxltokenHLLSketch,
 		EdxltokenEmptyRelation,
 		EdxltokenIsByValue,
 		EdxltokenIsNull,
@@ -676,6 +680,9 @@ namespace gpdxl
 		EdxltokenStatsBucketUpperBound,
 		EdxltokenStatsFrequency,
 		EdxltokenStatsDistinct,
+		EdxltokenStatsDependencyDegree,
+		EdxltokenHLLPrecision,
+		EdxltokenHLLRegisters,
 		EdxltokenStatsBoundClosed,
 
 		// search strategy
@@ -755,6 +762,7 @@ namespace gpdxl
 			// element for mapping Edxltoken to XML string
 			struct SXMLStrMapElem
 			{
+				// id of the first token with the same string
 				Edxltoken m_edxlt;
 				XMLCh *m_xmlsz;
 				
@@ -794,6 +802,45 @@ namespace gpdxl
 			static
 			SXMLStrMapElem *m_pxmlszmap;
 
+			// map of token strings to token ids, keyed by the address of the
+			// CWStringConst tokens
+			typedef CHashMap<CWStringBase, ULONG, gpos::UlHashPtr<CWStringBase>, gpos::FEqualPtr<CWStringBase>,
+					CleanupNULL<CWStringBase>, CleanupDelete<ULONG> > HMStrToken;
+
+			static
+			HMStrToken *m_phmstrtoken;
+
+			// bucket of the perfect hash of token strings; the strings hashed to
+			// a bucket are placed in its slots by a hash function seeded for
+			// the bucket, so that no two strings share a slot
+			struct SHashBucket
+			{
+				// first slot of the bucket
+				ULONG m_ulOffset;
+
+				// number of slots
+				ULONG m_ulSlots;
+
+				// seed of the hash function placing strings in slots
+				ULONG m_ulSeed;
+			};
+
+			// buckets of the perfect hash
+			static
+			SHashBucket *m_phashbucket;
+
+			// number of buckets
+			static
+			ULONG m_ulHashBuckets;
+
+			// token ids in the slots of all buckets
+			static
+			Edxltoken *m_pedxltokenSlots;
+
+			// hash of all token strings in token id order
+			static
+			ULONG m_ulTokensHash;
+
 			// memory pool -- not owned
 			static
 			IMemoryPool *m_pmp;
@@ -805,15 +852,42 @@ namespace gpdxl
 			// create a string in Xerces XMLCh* format
 			static 
 			XMLCh *XmlstrFromWsz(const WCHAR *wsz);
+
+			// seeded hash of a Xerces string
+			static
+			ULONG UlHashXmlstr(const XMLCh *xmlsz, ULONG ulSeed);
+
+			// build the perfect hash of token strings
+			static
+			void InitHash();
 			
 		public:
 			
-			// retrieve a token in CWStringConst and XMLCh* format, respectively
+			// retrieve a token in CWStringConst and XMLCh* format, respectively;
+			// tokens sharing a string share the same XMLCh* string
 			static 
 			const CWStringConst *PstrToken(Edxltoken edxltoken);
 			
 			static 
 			const XMLCh *XmlstrToken(Edxltoken edxltoken);
+
+			// token id of a string retrieved with PstrToken, or EdxltokenSentinel
+			// for any other string
+			static
+			Edxltoken EdxltokenLookup(const CWStringBase *pstr);
+
+			// token id of a Xerces string, or EdxltokenSentinel if the string is
+			// not a token; tokens sharing a string resolve to the first of them
+			static
+			Edxltoken EdxltokenFromXmlstr(const XMLCh *xmlsz);
+
+			// hash of all token strings; token ids are only meaningful to readers
+			// of documents written with the same hash
+			static
+			ULONG UlTokensHash()
+			{
+				return m_ulTokensHash;
+			}
 		
 			// initialize constants. Must be called before constants are accessed.
 			static 
@@ -75,6 +75,7 @@ namespace gpdxl
 		ExmiOptimizerError,
 		ExmiNoAvailableMemory,
 		ExmiInvalidComparisonTypeCode,
+		ExmiDXLBinaryParseError,
 
 		ExmiDXLSentinel
 	};
@@ -70,6 +70,9 @@ namespace gpmd
 			// is column statistics missing in the database
 			BOOL m_fColStatsMissing;
 
+			// HyperLogLog sketch of the column values, may be NULL
+			CDXLHLLSketch *m_pdxlhllsketch;
+
 			// DXL string for object
 			CWStringDynamic *m_pstr;
 			
@@ -88,7 +91,8 @@ namespace gpmd
 				CDouble dDistinctRemain,
 				CDouble dFreqRemain,
 				DrgPdxlbucket *pdrgpdxlbucket,
-				BOOL fColStatsMissing
+				BOOL fColStatsMissing,
+				CDXLHLLSketch *pdxlhllsketch = NULL
 				);
 			
 			// dtor
@@ -147,6 +151,13 @@ namespace gpmd
 			virtual
 			const CDXLBucket *Pdxlbucket(ULONG ul) const;
 
+			// HyperLogLog sketch of the column values
+			virtual
+			const CDXLHLLSketch *Pdxlhllsketch() const
+			{
+				return m_pdxlhllsketch;
+			}
+
 			// serialize column stats in DXL format
 			virtual 
 			void Serialize(gpdxl::CXMLSerializer *) const;
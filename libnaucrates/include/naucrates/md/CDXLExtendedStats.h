@@ -0,0 +1,110 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CDXLExtendedStats.h
+//
+//	@doc:
+//		Class representing multi-column statistics in DXL relation stats
+//---------------------------------------------------------------------------
+#ifndef GPMD_CDXLExtendedStats_H
+#define GPMD_CDXLExtendedStats_H
+
+#include "gpos/base.h"
+#include "gpos/common/CDouble.h"
+#include "gpos/common/CDynamicPtrArray.h"
+#include "gpos/common/CRefCount.h"
+
+namespace gpdxl
+{
+	class CXMLSerializer;
+}
+
+namespace gpmd
+{
+	using namespace gpos;
+	using namespace gpdxl;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CDXLExtendedStats
+	//
+	//	@doc:
+	//		Statistics on a set of correlated columns of a relation, identified
+	//		by their attribute numbers: the number of distinct value combinations
+	//		of the columns, and the degree to which the last column is
+	//		functionally determined by the other columns; a degree of 1 means
+	//		that the last column is fully determined, 0 that the columns are
+	//		independent, and a number of distinct values of 0 that it is unknown
+	//
+	//---------------------------------------------------------------------------
+	class CDXLExtendedStats : public CRefCount
+	{
+		private:
+
+			// memory pool
+			IMemoryPool *m_pmp;
+
+			// attribute numbers of the columns
+			DrgPi *m_pdrgpiAttno;
+
+			// number of distinct value combinations
+			CDouble m_dDistinct;
+
+			// functional dependency degree of last column on the other columns
+			CDouble m_dDependency;
+
+			// private copy ctor
+			CDXLExtendedStats(const CDXLExtendedStats &);
+
+		public:
+
+			// ctor
+			CDXLExtendedStats
+				(
+				IMemoryPool *pmp,
+				DrgPi *pdrgpiAttno,
+				CDouble dDistinct,
+				CDouble dDependency
+				);
+
+			// dtor
+			virtual
+			~CDXLExtendedStats();
+
+			// attribute numbers of the columns
+			const DrgPi *PdrgpiAttno() const
+			{
+				return m_pdrgpiAttno;
+			}
+
+			// number of distinct value combinations
+			CDouble DDistinct() const
+			{
+				return m_dDistinct;
+			}
+
+			// functional dependency degree
+			CDouble DDependency() const
+			{
+				return m_dDependency;
+			}
+
+			// serialize extended stats in DXL format
+			void Serialize(gpdxl::CXMLSerializer *pxmlser) const;
+
+#ifdef GPOS_DEBUG
+			// debug print of the extended stats
+			void DebugPrint(IOstream &os) const;
+#endif
+
+	};
+
+	// array of dxl extended stats
+	typedef CDynamicPtrArray<CDXLExtendedStats, CleanupRelease> DrgPdxlextstats;
+}
+
+#endif // !GPMD_CDXLExtendedStats_H
+
+// EOF
@@ -0,0 +1,97 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CDXLHLLSketch.h
+//
+//	@doc:
+//		Class representing a HyperLogLog sketch in DXL column stats
+//---------------------------------------------------------------------------
+#ifndef GPMD_CDXLHLLSketch_H
+#define GPMD_CDXLHLLSketch_H
+
+#include "gpos/base.h"
+#include "gpos/common/CRefCount.h"
+
+namespace gpdxl
+{
+	class CXMLSerializer;
+}
+
+namespace gpmd
+{
+	using namespace gpos;
+	using namespace gpdxl;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CDXLHLLSketch
+	//
+	//	@doc:
+	//		HyperLogLog sketch of the values of a column: 2^precision one-byte
+	//		registers, each holding the maximum rank of the hashes mapped to it
+	//
+	//---------------------------------------------------------------------------
+	class CDXLHLLSketch : public CRefCount
+	{
+		private:
+
+			// number of hash bits used to select a register
+			ULONG m_ulPrecision;
+
+			// registers
+			BYTE *m_pbaRegisters;
+
+			// number of registers
+			ULONG m_ulRegisters;
+
+			// private copy ctor
+			CDXLHLLSketch(const CDXLHLLSketch &);
+
+		public:
+
+			// ctor, takes ownership of the registers
+			CDXLHLLSketch
+				(
+				ULONG ulPrecision,
+				BYTE *pbaRegisters,
+				ULONG ulRegisters
+				);
+
+			// dtor
+			virtual
+			~CDXLHLLSketch();
+
+			// number of hash bits used to select a register
+			ULONG UlPrecision() const
+			{
+				return m_ulPrecision;
+			}
+
+			// registers
+			const BYTE *PbaRegisters() const
+			{
+				return m_pbaRegisters;
+			}
+
+			// number of registers
+			ULONG UlRegisters() const
+			{
+				return m_ulRegisters;
+			}
+
+			// serialize sketch in DXL format
+			void Serialize(gpdxl::CXMLSerializer *pxmlser) const;
+
+#ifdef GPOS_DEBUG
+			// debug print of the sketch
+			void DebugPrint(IOstream &os) const;
+#endif
+
+	};
+}
+
+#endif // !GPMD_CDXLHLLSketch_H
+
+// EOF
@@ -59,6 +59,9 @@ namespace gpmd
 			// flag to indicate if input relation is empty
 			BOOL m_fEmpty;
 
+			// multi-column statistics
+			DrgPdxlextstats *m_pdrgpdxlextstats;
+
 			// DXL string for object
 			CWStringDynamic *m_pstr;
 			
@@ -73,7 +76,8 @@ namespace gpmd
 				CMDIdRelStats *pmdidRelStats,
 				CMDName *pmdname,
 				CDouble dRows,
-				BOOL fEmpty
+				BOOL fEmpty,
+				DrgPdxlextstats *pdrgpdxlextstats = NULL
 				);
 			
 			virtual
@@ -102,6 +106,14 @@ namespace gpmd
 				return m_fEmpty;
 			}
 
+			// number of multi-column statistics objects
+			virtual
+			ULONG UlExtendedStats() const;
+
+			// multi-column statistics object at given position
+			virtual
+			const CDXLExtendedStats *Pdxlextstats(ULONG ul) const;
+
 			// serialize relation stats in DXL format given a serializer object
 			virtual 
 			void Serialize(gpdxl::CXMLSerializer *) const;
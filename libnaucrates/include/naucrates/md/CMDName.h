@@ -25,7 +25,9 @@ namespace gpmd
 	//		CMDName
 	//
 	//	@doc:
-	//		Class for representing metadata names.
+	//		Class for representing metadata names. Names are wide character
+	//		strings; names read from DXL documents are decoded directly from
+	//		UTF-16 when they are parsed.
 	//
 	//---------------------------------------------------------------------------
 	class CMDName
@@ -37,9 +37,43 @@ namespace gpmd
 	class CMDProviderMemory : public IMDProvider
 	{
 		protected:
-	
-			// hash map of serialized MD objects indexed by their MD id 
-			typedef CHashMap<IMDId, CWStringDynamic, 
+
+			// metadata object held by the provider, together with its DXL
+			// string and binary DXL document
+			struct SMDObject
+			{
+				// metadata object
+				IMDCacheObject *m_pmdobj;
+
+				// DXL string of the object
+				CWStringDynamic *m_pstr;
+
+				// binary DXL document of the object
+				BYTE *m_pba;
+
+				// length of the binary DXL document
+				ULONG m_ulLength;
+
+				// ctor
+				SMDObject(IMDCacheObject *pmdobj, CWStringDynamic *pstr, BYTE *pba, ULONG ulLength)
+					:
+					m_pmdobj(pmdobj),
+					m_pstr(pstr),
+					m_pba(pba),
+					m_ulLength(ulLength)
+				{}
+
+				// dtor
+				~SMDObject()
+				{
+					m_pmdobj->Release();
+					GPOS_DELETE(m_pstr);
+					GPOS_DELETE_ARRAY(m_pba);
+				}
+			};
+
+			// hash map of MD objects indexed by their MD id
+			typedef CHashMap<IMDId, SMDObject,
 							IMDId::UlHashMDId, IMDId::FEqualMDId,
 							CleanupRelease, CleanupDelete> MDMap;
 			
@@ -48,6 +82,10 @@ namespace gpmd
 			
 			// load MD objects in the hash map
 			void LoadMetadataObjectsFromArray(IMemoryPool *pmp, DrgPimdobj *pdrgpmdobj);
+
+			// dummy statistics object for an mdid missing in the provider
+			static
+			IMDCacheObject *PimdobjDummyStats(IMemoryPool *pmp, IMDId *pmdid);
 			
 			// private copy ctor
 			CMDProviderMemory(const CMDProviderMemory&);
@@ -67,6 +105,11 @@ namespace gpmd
 			// returns the DXL string of the requested metadata object
 			virtual 
 			CWStringBase *PstrObject(IMemoryPool *pmp, CMDAccessor *pmda, IMDId *pmdid) const;
+
+			// returns the requested metadata object, built in the given memory
+			// pool unless the provider shares its objects
+			virtual
+			IMDCacheObject *Pimdobj(IMemoryPool *pmp, CMDAccessor *pmda, IMDId *pmdid) const;
 			
 			// return the mdid for the specified system id and type
 			virtual
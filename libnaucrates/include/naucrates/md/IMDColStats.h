@@ -18,6 +18,7 @@
 
 #include "naucrates/md/IMDCacheObject.h"
 #include "naucrates/md/CDXLBucket.h"
+#include "naucrates/md/CDXLHLLSketch.h"
 
 namespace gpmd
 {
@@ -70,6 +71,10 @@ namespace gpmd
 			// get the bucket at the given position
 			virtual
 			const CDXLBucket *Pdxlbucket(ULONG ul) const = 0;
+
+			// HyperLogLog sketch of the column values, NULL if not available
+			virtual
+			const CDXLHLLSketch *Pdxlhllsketch() const = 0;
 	};
 }
 
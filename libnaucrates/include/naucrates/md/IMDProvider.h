@@ -20,6 +20,7 @@
 #include "gpos/string/CWStringBase.h"
 #include "gpos/string/CWStringConst.h"
 
+#include "naucrates/md/IMDCacheObject.h"
 #include "naucrates/md/IMDId.h"
 #include "naucrates/md/IMDType.h"
 #include "naucrates/md/IMDFunction.h"
@@ -28,6 +29,9 @@ namespace gpmd
 {
 	using namespace gpos;
 
+	// fwd decl
+	class CMDRequest;
+
 	//---------------------------------------------------------------------------
 	//	@class:
 	//		IMDProvider
@@ -56,6 +60,49 @@ namespace gpmd
 			virtual 
 			CWStringBase *PstrObject(IMemoryPool *pmp, CMDAccessor *pmda, IMDId *pmdid) const = 0;
 
+			// returns the requested metadata object, or NULL if the provider only
+			// supplies its DXL string; the caller receives a reference to the
+			// object, which is allocated in the given memory pool unless the
+			// provider shares its objects
+			virtual
+			IMDCacheObject *Pimdobj
+				(
+				IMemoryPool *, // pmp
+				CMDAccessor *, // pmda
+				IMDId * // pmdid
+				)
+				const
+			{
+				return NULL;
+			}
+
+			// returns true if objects supplied through Pimdobj are shared with the
+			// provider and other callers rather than built in the given memory
+			// pool; shared objects bypass the MD cache, which frees cached
+			// objects together with the memory pool they were built in
+			virtual
+			BOOL FSharesObjects() const
+			{
+				return false;
+			}
+
+			// returns the DXL strings of the metadata objects of a request in a
+			// single round trip, one string per requested mdid and in request
+			// order; an empty string marks an object the provider did not
+			// supply. Returns NULL if the provider does not batch requests, in
+			// which case objects are fetched one by one when first used.
+			virtual
+			DrgPstr *PdrgpstrObjects
+				(
+				IMemoryPool *, // pmp
+				CMDAccessor *, // pmda
+				CMDRequest * // pmdr
+				)
+				const
+			{
+				return NULL;
+			}
+
 			// return the mdid for the specified system id and type
 			virtual 
 			IMDId *Pmdid(IMemoryPool *pmp, CSystemId sysid, IMDType::ETypeInfo eti) const = 0;
@@ -18,6 +18,7 @@
 #include "gpos/common/CDouble.h"
 
 #include "naucrates/md/IMDCacheObject.h"
+#include "naucrates/md/CDXLExtendedStats.h"
 
 namespace gpmd
 {
@@ -50,6 +51,14 @@ namespace gpmd
 			// is statistics on an empty input
 			virtual
 			BOOL FEmpty() const = 0;
+
+			// number of multi-column statistics objects
+			virtual
+			ULONG UlExtendedStats() const = 0;
+
+			// multi-column statistics object at given position
+			virtual
+			const CDXLExtendedStats *Pdxlextstats(ULONG ul) const = 0;
 	};
 }
 
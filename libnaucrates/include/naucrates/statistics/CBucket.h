@@ -195,6 +195,12 @@ namespace gpnaucrates
 			// return a copy of the bucket with updated frequency based on the new total number of rows
 			CBucket *PbucketUpdateFrequency(IMemoryPool *pmp, CDouble dRowsOld, CDouble dRowsNew);
 
+			// return a bucket spanning this bucket and the adjacent bucket that follows it
+			CBucket *PbucketMergeAdjacent(IMemoryPool *pmp, const CBucket *pbucketNext) const;
+
+			// frequency misplaced by merging with the adjacent bucket that follows this bucket
+			CDouble DMergeAdjacentError(const CBucket *pbucketNext) const;
+
 			// Merge with another bucket and return leftovers
 			CBucket *PbucketMerge
 					(
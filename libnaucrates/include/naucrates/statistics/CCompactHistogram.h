@@ -0,0 +1,288 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CCompactHistogram.h
+//
+//	@doc:
+//		Columnar representation of histogram buckets
+//---------------------------------------------------------------------------
+#ifndef GPNAUCRATES_CCompactHistogram_H
+#define GPNAUCRATES_CCompactHistogram_H
+
+#include "gpos/base.h"
+#include "gpos/common/CRefCount.h"
+
+#include "naucrates/statistics/CBucket.h"
+
+namespace gpnaucrates
+{
+	using namespace gpos;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CCompactHistogram
+	//
+	//	@doc:
+	//		Struct-of-arrays copy of the buckets of a histogram; bucket bounds
+	//		are stored as their statistics mapping in contiguous arrays so that
+	//		kernels over bounds run without virtual datum comparisons; only
+	//		histograms whose bounds are all compared through the same numeric
+	//		mapping can be represented, others keep using the bucket array
+	//
+	//---------------------------------------------------------------------------
+	class CCompactHistogram : public CRefCount
+	{
+		public:
+
+			// statistics mapping used to compare bucket bounds
+			enum EMapping
+			{
+				EmLint = 0,		// LINT mapping, stored exactly as a double
+				EmDouble,		// double mapping
+
+				EmSentinel
+			};
+
+			// intersection of a pair of buckets computed by the equality join kernel;
+			// bounds of the intersection are bounds of the input buckets
+			struct SBucketIntersection
+			{
+				// index of bucket in first histogram
+				ULONG m_ul1;
+
+				// index of bucket in second histogram
+				ULONG m_ul2;
+
+				// is lower bound taken from bucket in first histogram
+				BOOL m_fLowerFrom1;
+
+				// is upper bound taken from bucket in first histogram
+				BOOL m_fUpperFrom1;
+
+				// is lower bound closed
+				BOOL m_fLowerClosed;
+
+				// is upper bound closed
+				BOOL m_fUpperClosed;
+
+				// frequency of intersection
+				DOUBLE m_dFrequency;
+
+				// number of distinct values of intersection
+				DOUBLE m_dDistinct;
+			};
+
+		private:
+
+			// memory pool
+			IMemoryPool *m_pmp;
+
+			// number of buckets
+			const ULONG m_ulBuckets;
+
+			// mapping of bucket bounds
+			const EMapping m_em;
+
+			// lower bounds
+			DOUBLE *m_rgdLower;
+
+			// upper bounds
+			DOUBLE *m_rgdUpper;
+
+			// is lower bound closed
+			BOOL *m_rgfLowerClosed;
+
+			// is upper bound closed
+			BOOL *m_rgfUpperClosed;
+
+			// bucket frequencies
+			DOUBLE *m_rgdFrequency;
+
+			// bucket number of distinct values
+			DOUBLE *m_rgdDistinct;
+
+			// private ctor
+			CCompactHistogram(IMemoryPool *pmp, ULONG ulBuckets, EMapping em);
+
+			// private copy ctor
+			CCompactHistogram(const CCompactHistogram &);
+
+			// map given datum to a double, return false if datum is not mappable
+			static
+			BOOL FMap(IDatum *pdatum, EMapping *pem, DOUBLE *pd);
+
+			// compare mapped values, return 0 if equal, -1 if first is smaller and 1 otherwise
+			static
+			INT ICompare(DOUBLE d1, DOUBLE d2);
+
+			// distance between mapped values, see IDatumStatisticsMappable::DStatsDistance
+			static
+			CDouble DDistance
+				(
+				DOUBLE d1,
+				DOUBLE d2
+				)
+			{
+				return CDouble(d1 - d2);
+			}
+
+			// is given bucket a singleton
+			BOOL FSingleton
+				(
+				ULONG ul
+				)
+				const
+			{
+				return CDouble(m_rgdLower[ul]) == CDouble(m_rgdUpper[ul]);
+			}
+
+			// width of given bucket, see CBucket::DWidth
+			CDouble DWidth(ULONG ul) const;
+
+			// does given bucket subsume bucket of other histogram, see CBucket::FSubsumes
+			BOOL FSubsumes(ULONG ul, const CCompactHistogram *pchist, ULONG ulOther) const;
+
+			// does given bucket intersect bucket of other histogram, see CBucket::FIntersects
+			BOOL FIntersects(ULONG ul, const CCompactHistogram *pchist, ULONG ulOther) const;
+
+			// intersect given bucket with bucket of other histogram, see CBucket::PbucketIntersect
+			void Intersect
+				(
+				ULONG ul,
+				const CCompactHistogram *pchist,
+				ULONG ulOther,
+				SBucketIntersection *pbi,
+				CDouble *pdFreqIntersect1,
+				CDouble *pdFreqIntersect2
+				)
+				const;
+
+		public:
+
+			// dtor
+			virtual
+			~CCompactHistogram();
+
+			// number of buckets
+			ULONG UlBuckets() const
+			{
+				return m_ulBuckets;
+			}
+
+			// mapping of bucket bounds
+			EMapping Em() const
+			{
+				return m_em;
+			}
+
+			// lower bound of given bucket
+			DOUBLE DLower
+				(
+				ULONG ul
+				)
+				const
+			{
+				GPOS_ASSERT(ul < m_ulBuckets);
+				return m_rgdLower[ul];
+			}
+
+			// upper bound of given bucket
+			DOUBLE DUpper
+				(
+				ULONG ul
+				)
+				const
+			{
+				GPOS_ASSERT(ul < m_ulBuckets);
+				return m_rgdUpper[ul];
+			}
+
+			// is lower bound of given bucket closed
+			BOOL FLowerClosed
+				(
+				ULONG ul
+				)
+				const
+			{
+				GPOS_ASSERT(ul < m_ulBuckets);
+				return m_rgfLowerClosed[ul];
+			}
+
+			// is upper bound of given bucket closed
+			BOOL FUpperClosed
+				(
+				ULONG ul
+				)
+				const
+			{
+				GPOS_ASSERT(ul < m_ulBuckets);
+				return m_rgfUpperClosed[ul];
+			}
+
+			// frequency of given bucket
+			DOUBLE DFrequency
+				(
+				ULONG ul
+				)
+				const
+			{
+				GPOS_ASSERT(ul < m_ulBuckets);
+				return m_rgdFrequency[ul];
+			}
+
+			// number of distinct values of given bucket
+			DOUBLE DDistinct
+				(
+				ULONG ul
+				)
+				const
+			{
+				GPOS_ASSERT(ul < m_ulBuckets);
+				return m_rgdDistinct[ul];
+			}
+
+			// map given point to the representation of bucket bounds,
+			// return false if point cannot be compared with compact bounds
+			BOOL FMap(const CPoint *ppoint, DOUBLE *pd) const;
+
+			// is given mapped value after the upper bound of given bucket
+			BOOL FAfter(ULONG ul, DOUBLE d) const;
+
+			// is given mapped value before the lower bound of given bucket
+			BOOL FBefore(ULONG ul, DOUBLE d) const;
+
+			// does given bucket contain mapped value
+			BOOL FContains(ULONG ul, DOUBLE d) const;
+
+			// index of first bucket whose upper bound is not before mapped value;
+			// returns number of buckets if value is after all buckets
+			ULONG UlFirstNotAfter(DOUBLE d) const;
+
+			// sum of bucket frequencies
+			DOUBLE DFrequency() const;
+
+			// equality join of buckets with buckets of another histogram in a
+			// single merge pass; the intersections are written to given array,
+			// which must have room for the sum of bucket counts of both
+			// histograms; returns number of intersections
+			ULONG UlJoinEquality
+				(
+				const CCompactHistogram *pchist,
+				SBucketIntersection *rgbi,
+				CDouble *pdFreqJoinBuckets1,
+				CDouble *pdFreqJoinBuckets2
+				)
+				const;
+
+			// create compact copy of given buckets, return NULL if bounds cannot be mapped
+			static
+			CCompactHistogram *PchistCreate(IMemoryPool *pmp, const DrgPbucket *pdrgpbucket);
+
+	}; // class CCompactHistogram
+}
+
+#endif // !GPNAUCRATES_CCompactHistogram_H
+
+// EOF
@@ -0,0 +1,100 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CHLLSketch.h
+//
+//	@doc:
+//		HyperLogLog sketch of the values of a column
+//---------------------------------------------------------------------------
+#ifndef GPNAUCRATES_CHLLSketch_H
+#define GPNAUCRATES_CHLLSketch_H
+
+#include "gpos/base.h"
+#include "gpos/common/CDouble.h"
+#include "gpos/common/CHashMap.h"
+#include "gpos/common/CHashMapIter.h"
+#include "gpos/common/CRefCount.h"
+
+namespace gpnaucrates
+{
+	using namespace gpos;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CHLLSketch
+	//
+	//	@doc:
+	//		HyperLogLog sketch of the values of a column, as collected by the
+	//		database: 2^precision one-byte registers holding the maximum rank of
+	//		the hashes mapped to each register; sketches of the same precision
+	//		are merged by taking the register-wise maximum, which gives the
+	//		sketch of the union of the values; sketches are immutable and
+	//		shared between statistics objects
+	//
+	//---------------------------------------------------------------------------
+	class CHLLSketch : public CRefCount
+	{
+		private:
+
+			// number of hash bits used to select a register
+			ULONG m_ulPrecision;
+
+			// registers
+			BYTE *m_pbaRegisters;
+
+			// number of registers
+			ULONG m_ulRegisters;
+
+			// estimated number of distinct values
+			CDouble m_dDistinct;
+
+			// private copy ctor
+			CHLLSketch(const CHLLSketch &);
+
+			// estimate the number of distinct values from the registers
+			CDouble DEstimate() const;
+
+		public:
+
+			// ctor, takes ownership of the 2^precision registers
+			CHLLSketch(ULONG ulPrecision, BYTE *pbaRegisters);
+
+			// dtor
+			virtual
+			~CHLLSketch();
+
+			// number of hash bits used to select a register
+			ULONG UlPrecision() const
+			{
+				return m_ulPrecision;
+			}
+
+			// estimated number of distinct values
+			CDouble DDistinct() const
+			{
+				return m_dDistinct;
+			}
+
+			// sketch of the union of the values of this and the given sketch;
+			// returns NULL if the sketches have different precisions
+			CHLLSketch *PhllMerge(IMemoryPool *pmp, const CHLLSketch *phll) const;
+
+			// print function
+			IOstream &OsPrint(IOstream &os) const;
+
+	}; // class CHLLSketch
+
+	// hash map from column id to sketch
+	typedef CHashMap<ULONG, CHLLSketch, gpos::UlHash<ULONG>, gpos::FEqual<ULONG>,
+					CleanupDelete<ULONG>, CleanupRelease<CHLLSketch> > HMUlHLL;
+
+	// iterator
+	typedef CHashMapIter<ULONG, CHLLSketch, gpos::UlHash<ULONG>, gpos::FEqual<ULONG>,
+					CleanupDelete<ULONG>, CleanupRelease<CHLLSketch> > HMIterUlHLL;
+}
+
+#endif // !GPNAUCRATES_CHLLSketch_H
+
+// EOF
@@ -12,7 +12,9 @@
 #define GPNAUCRATES_CHistogram_H
 
 #include "gpos/base.h"
+#include "gpos/common/CRefCount.h"
 #include "naucrates/statistics/CBucket.h"
+#include "naucrates/statistics/CCompactHistogram.h"
 #include "naucrates/statistics/CStatsPred.h"
 
 namespace gpopt
@@ -31,9 +33,12 @@ namespace gpnaucrates
 	//		CHistogram
 	//
 	//	@doc:
+	//		Histogram of a column; histograms are shared between statistics
+	//		objects and must not be modified once they are added to a
+	//		histogram map, except through copy-on-write
 	//
 	//---------------------------------------------------------------------------
-	class CHistogram
+	class CHistogram : public CRefCount
 	{
 
 		private:
@@ -64,12 +69,21 @@ namespace gpnaucrates
 			// is column statistics missing in the database
 			BOOL m_fColStatsMissing;
 
+			// columnar copy of buckets, built on demand to speed up repeated filters
+			CCompactHistogram *m_pchist;
+
 			// private copy ctor
 			CHistogram(const CHistogram &);
 
 			// private assignment operator
 			CHistogram& operator=(const CHistogram &);
 
+			// index of the only bucket that can contain given point, found using compact buckets
+			BOOL FCandidateBucket(const CPoint *ppoint, ULONG *pulBucketIdx) const;
+
+			// release compact buckets after bucket frequencies or NDVs have changed
+			void ReleaseCompact();
+
 			// return an array buckets after applying equality filter on the histogram buckets
 			DrgPbucket *PdrgppbucketEqual(IMemoryPool *pmp, CPoint *ppoint) const;
 
@@ -97,6 +111,17 @@ namespace gpnaucrates
 			// equality join
 			CHistogram *PhistJoinEquality(IMemoryPool *pmp, const CHistogram *phist) const;
 
+			// align buckets of an equality join using compact buckets
+			void JoinEqualityCompact
+				(
+				IMemoryPool *pmp,
+				const CHistogram *phist,
+				DrgPbucket *pdrgppbucketJoin,
+				CDouble *pdFreqJoinBuckets1,
+				CDouble *pdFreqJoinBuckets2
+				)
+				const;
+
 			// construct a new histogram for an INDF join predicate
 			CHistogram *PhistJoinINDF(IMemoryPool *pmp, const CHistogram *phist) const;
 
@@ -131,6 +156,30 @@ namespace gpnaucrates
 				ULONG ulEnd
 				);
 
+			// restore the order of a min-heap of adjacent bucket pairs, keyed by
+			// the error of merging each pair, after the entry at the given
+			// position changed; positions of pairs in the heap are kept up to date
+			static
+			void RestoreMergeHeap
+				(
+				ULONG *rgulHeap,
+				ULONG *rgulPos,
+				const DOUBLE *rgdError,
+				ULONG ulSize,
+				ULONG ulPos
+				);
+
+			// remove the entry at the given position from a min-heap of adjacent bucket pairs
+			static
+			void RemoveFromMergeHeap
+				(
+				ULONG *rgulHeap,
+				ULONG *rgulPos,
+				const DOUBLE *rgdError,
+				ULONG *pulSize,
+				ULONG ulPos
+				);
+
 			// check if we can compute NDVRemain for JOIN histogram for the given input histograms
 			static
 			BOOL FCanComputeJoinNDVRemain(const CHistogram *phist1, const CHistogram *phist2);
@@ -199,6 +248,19 @@ namespace gpnaucrates
 						)
 						const;
 
+			// can the buckets be matched against the given LIKE pattern
+			BOOL FSupportsLikeFilter(const IDatum *pdatumPattern) const;
+
+			// filter by a LIKE pattern and normalize
+			CHistogram *PhistLikeFilterNormalized
+						(
+						IMemoryPool *pmp,
+						const IDatum *pdatumPattern,
+						CDouble dDefaultScaleFactor,
+						CDouble *pdScaleFactor
+						)
+						const;
+
 			// join with another histogram
 			CHistogram *PhistJoin
 						(
@@ -380,6 +442,21 @@ namespace gpnaucrates
 			~CHistogram()
 			{
 				m_pdrgppbucket->Release();
+				CRefCount::SafeRelease(m_pchist);
+			}
+
+			// build compact buckets if histogram has enough buckets to benefit
+			// from them; histogram must not be shared yet
+			void BuildCompact(IMemoryPool *pmp);
+
+			// histogram with compact buckets if it has enough buckets to benefit
+			// from them; compact buckets are built on a copy, never on this histogram
+			CHistogram *PhistCompact(IMemoryPool *pmp);
+
+			// compact buckets accessor, NULL if not built
+			const CCompactHistogram *Pchist() const
+			{
+				return m_pchist;
 			}
 
 			// normalize histogram and return scaling factor
@@ -436,6 +513,13 @@ namespace gpnaucrates
 			// cap the total number of distinct values (NDVs) in buckets to the number of rows
 			void CapNDVs(CDouble dRows);
 
+			// scale the number of distinct non-null values in buckets and remainder to the given number
+			void ScaleNDVs(CDouble dDistinct);
+
+			// merge adjacent buckets until there are at most the given number of buckets;
+			// return a bound on the frequency misplaced by merging
+			CDouble DCapBuckets(IMemoryPool *pmp, ULONG ulMaxBuckets);
+
 			// is comparison type supported for filters
 			static
 			BOOL FSupportsFilter(CStatsPred::EStatsCmpType escmpt);
@@ -469,6 +553,9 @@ namespace gpnaucrates
 
 			// default frequency of NDV remain
 			static const CDouble DDefaultNDVFreqRemain;
+
+			// minimum number of buckets for building compact buckets
+			static const ULONG UlMinBucketsCompact;
 	}; // class CHistogram
 
 }
@@ -45,6 +45,80 @@ namespace gpnaucrates
 	{
 		public:
 
+			// per-column histogram derivations that can run on worker tasks
+			enum EHistogramOp
+			{
+				EhopCapNDVs = 0,	// cap NDVs to the number of rows
+				EhopGroupBy,		// group by and normalize
+
+				EhopSentinel
+			};
+
+		private:
+
+			// maximum number of worker tasks deriving histograms of one operator
+			static
+			const ULONG ulHistogramTasksMax;
+
+			// arguments of a worker task deriving a range of column histograms
+			struct SHistogramTaskArg
+			{
+				// memory pool of derived histograms
+				IMemoryPool *m_pmp;
+
+				// derivation to apply
+				EHistogramOp m_ehop;
+
+				// number of input rows
+				DOUBLE m_dRows;
+
+				// input histograms
+				CHistogram **m_rgphistInput;
+
+				// derived histograms
+				CHistogram **m_rgphistOutput;
+
+				// first histogram of the range
+				ULONG m_ulStart;
+
+				// end of the range
+				ULONG m_ulEnd;
+			};
+
+			// derive the histograms in the range of given task arguments
+			static
+			void DeriveHistogramRange(const SHistogramTaskArg *pharg);
+
+			// worker task function deriving a range of histograms
+			static
+			void *PvDeriveHistograms(void *pv);
+
+			// derive the histograms of given task arguments, on worker tasks if possible
+			static
+			void DeriveHistogramsOnTasks(IMemoryPool *pmp, CStatisticsConfig *pstatsconf, const SHistogramTaskArg *pharg);
+
+		public:
+
+			// derive histograms of columns; derivations run on idle workers of the
+			// pool when the number of histograms reaches the configured threshold
+			// and the caller is not a pool worker itself
+			static
+			void DeriveHistograms
+				(
+				IMemoryPool *pmp,
+				CStatisticsConfig *pstatsconf,
+				EHistogramOp ehop,
+				CDouble dRows,
+				ULONG ulHists,
+				CHistogram **rgphistInput,
+				CHistogram **rgphistOutput
+				);
+
+			// cap the number of buckets of a derived histogram to the configured
+			// maximum; takes ownership of the given histogram and returns the capped one
+			static
+			CHistogram *PhistCapBuckets(IMemoryPool *pmp, CStatisticsConfig *pstatsconf, CHistogram *phist);
+
 			// helper method to append histograms from one map to the other
 			static
 			void AddHistograms(IMemoryPool *pmp, HMUlHist *phmulhistSrc, HMUlHist *phmulhistDest);
@@ -0,0 +1,129 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMultiColumnStats.h
+//
+//	@doc:
+//		Statistics on a set of correlated columns
+//---------------------------------------------------------------------------
+#ifndef GPNAUCRATES_CMultiColumnStats_H
+#define GPNAUCRATES_CMultiColumnStats_H
+
+#include "gpos/base.h"
+#include "gpos/common/CBitSet.h"
+#include "gpos/common/CDouble.h"
+#include "gpos/common/CRefCount.h"
+
+#include "gpopt/base/CColRef.h"
+
+namespace gpnaucrates
+{
+	using namespace gpos;
+	using namespace gpopt;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CMultiColumnStats
+	//
+	//	@doc:
+	//		Number of distinct value combinations of a set of columns and the
+	//		degree to which the last column is functionally determined by the
+	//		other columns, as given by the extended statistics of a relation;
+	//		both are properties of the base relation and are bounded by the
+	//		per-column statistics of the statistics object they are used in, so
+	//		objects are immutable and shared between statistics objects
+	//
+	//---------------------------------------------------------------------------
+	class CMultiColumnStats : public CRefCount
+	{
+		private:
+
+			// column ids, the last column is the dependent one
+			DrgPul *m_pdrgpulColId;
+
+			// set of column ids
+			CBitSet *m_pbsColId;
+
+			// number of distinct value combinations, zero if unknown
+			CDouble m_dDistinct;
+
+			// functional dependency degree of last column on the other columns
+			CDouble m_dDependency;
+
+			// private copy ctor
+			CMultiColumnStats(const CMultiColumnStats &);
+
+		public:
+
+			// ctor
+			CMultiColumnStats
+				(
+				IMemoryPool *pmp,
+				DrgPul *pdrgpulColId,
+				CDouble dDistinct,
+				CDouble dDependency
+				);
+
+			// dtor
+			virtual
+			~CMultiColumnStats();
+
+			// column ids
+			const DrgPul *PdrgpulColId() const
+			{
+				return m_pdrgpulColId;
+			}
+
+			// set of column ids
+			const CBitSet *PbsColId() const
+			{
+				return m_pbsColId;
+			}
+
+			// number of columns
+			ULONG UlColumns() const
+			{
+				return m_pdrgpulColId->UlLength();
+			}
+
+			// id of the dependent column
+			ULONG UlColIdDependent() const
+			{
+				return *(*m_pdrgpulColId)[m_pdrgpulColId->UlLength() - 1];
+			}
+
+			// number of distinct value combinations
+			CDouble DDistinct() const
+			{
+				return m_dDistinct;
+			}
+
+			// is the number of distinct value combinations known
+			BOOL FHasDistinct() const
+			{
+				return CDouble(0.0) < m_dDistinct;
+			}
+
+			// functional dependency degree
+			CDouble DDependency() const
+			{
+				return m_dDependency;
+			}
+
+			// copy with remapped column ids; returns NULL if any column is not mapped
+			CMultiColumnStats *PmcstatsCopyWithRemap(IMemoryPool *pmp, HMUlCr *phmulcr) const;
+
+			// print function
+			IOstream &OsPrint(IOstream &os) const;
+
+	}; // class CMultiColumnStats
+
+	// array of multi-column statistics
+	typedef CDynamicPtrArray<CMultiColumnStats, CleanupRelease> DrgPmcstats;
+}
+
+#endif // !GPNAUCRATES_CMultiColumnStats_H
+
+// EOF
@@ -21,6 +21,8 @@
 #include "naucrates/statistics/CStatsPredLike.h"
 #include "naucrates/statistics/CStatsPredUnsupported.h"
 #include "naucrates/statistics/CUpperBoundNDVs.h"
+#include "naucrates/statistics/CMultiColumnStats.h"
+#include "naucrates/statistics/CHLLSketch.h"
 
 #include "naucrates/statistics/CHistogram.h"
 #include "gpos/common/CBitSet.h"
@@ -110,6 +112,12 @@ namespace gpnaucrates
 			// mutex for locking entry when accessing hashmap from source id -> upper bound of source cardinality
 			CMutex m_mutexCardUpperBoundAccess;
 
+			// statistics on sets of correlated columns
+			DrgPmcstats *m_pdrgpmcstats;
+
+			// hashmap from column id to sketch of the column values
+			HMUlHLL *m_phmulhll;
+
 			// the default value for operators that have no cardinality estimation risk
 			static
 			const ULONG ulStatsEstimationNoRisk;
@@ -117,6 +125,14 @@ namespace gpnaucrates
 			// helper method to copy stats on columns that are not excluded by bitset
 			void AddNotExcludedHistograms(IMemoryPool *pmp, CBitSet *pbsExcludedColIds, HMUlHist *phmulhist) const;
 
+			// share the multi-column statistics of given statistics object whose
+			// columns all have histograms in this object
+			void AddMultiColumnStats(const CStatistics *pstatsSrc);
+
+			// share the sketches of given statistics object on columns that
+			// have histograms in this object
+			void AddHLLSketches(IMemoryPool *pmp, const CStatistics *pstatsSrc);
+
 			// main driver to generate join stats
 			virtual
 			CStatistics *PstatsJoinDriver
@@ -131,7 +147,7 @@ namespace gpnaucrates
 
 			// cap the total number of distinct values (NDV) in buckets to the number of rows
 			static
-			void CapNDVs(CDouble dRows, HMUlHist *phmulhist);
+			void CapNDVs(IMemoryPool *pmp, CStatisticsConfig *pstatsconf, CDouble dRows, HMUlHist *phmulhist);
 
 			// create a new hash map of histograms from the results of the inner join and the histograms of the outer child
 			static
@@ -311,6 +327,28 @@ namespace gpnaucrates
 			virtual
 			CDouble DNDV(const CColRef *pcr);
 
+			// statistics on sets of correlated columns
+			const DrgPmcstats *Pdrgpmcstats() const
+			{
+				return m_pdrgpmcstats;
+			}
+
+			// add statistics on a set of correlated columns, takes ownership
+			void AddMultiColumnStats(CMultiColumnStats *pmcstats);
+
+			// look up the sketch of the values of a particular column
+			const CHLLSketch *Phll
+								(
+								ULONG ulColId
+								)
+								const
+			{
+				return m_phmulhll->PtLookup(&ulColId);
+			}
+
+			// add the sketch of the values of a column, takes ownership
+			void AddHLLSketch(IMemoryPool *pmp, ULONG ulColId, CHLLSketch *phll);
+
 			// look up the width of a particular column
 			virtual
 			const CDouble *PdWidth(ULONG ulColId) const;
@@ -415,6 +453,11 @@ namespace gpnaucrates
 			virtual
 			IStatistics *PstatsCopyWithRemap(IMemoryPool *pmp, HMUlCr *phmulcr, BOOL fMustExist) const;
 
+			// copy stats keeping histograms only for the given columns;
+			// widths of all columns are kept
+			virtual
+			IStatistics *PstatsPruneHistograms(IMemoryPool *pmp, CColRefSet *pcrsHist) const;
+
 			// return the set of column references we have stats for
 			virtual
 			CColRefSet *Pcrs(IMemoryPool *pmp) const;
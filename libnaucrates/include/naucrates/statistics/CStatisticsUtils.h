@@ -21,7 +21,9 @@
 #include "gpopt/engine/CStatisticsConfig.h"
 
 #include "naucrates/statistics/CStatsPredUtils.h"
+#include "naucrates/statistics/CStatsPredConj.h"
 #include "naucrates/statistics/CStatsPredDisj.h"
+#include "naucrates/statistics/CMultiColumnStats.h"
 #include "naucrates/statistics/CStatsPredUnsupported.h"
 
 #include "naucrates/base/IDatum.h"
@@ -190,6 +192,22 @@ namespace gpnaucrates
 			static
 			CDouble DMaxNdv(const CStatistics *pstats,const DrgPul *pdrgpulGrpCol);
 
+			// return the multi-column statistics with known number of distinct
+			// value combinations covering the most columns of the given set
+			static
+			const CMultiColumnStats *PmcstatsLargestSubset(const CStatistics *pstats, const CBitSet *pbsColIds);
+
+			// add the number of distinct value combinations of the columns covered
+			// by multi-column statistics, and return the columns not covered
+			static
+			DrgPul *PdrgpulAddJointNdvs
+					(
+					IMemoryPool *pmp,
+					const CStatistics *pstatsInput,
+					const DrgPul *pdrgpulColIds,
+					DrgPdouble *pdrgpdNDV // output array of NDV
+					);
+
 		public:
 
 			// get the next data point for generating new bucket boundary
@@ -373,6 +391,45 @@ namespace gpnaucrates
 			static
 			CDouble DNumOfDistinctVal(CStatisticsConfig *pstatsconf, DrgPdouble *pdrgpdNDV);
 
+			// return the number of distinct value combinations of the columns of the
+			// given multi-column statistics, bounded by the given statistics object
+			static
+			CDouble DJointNdv(const CStatistics *pstats, const CMultiColumnStats *pmcstats);
+
+			// estimate the number of distinct value combinations of the given columns
+			static
+			CDouble DNdvCombinations
+					(
+					IMemoryPool *pmp,
+					CStatisticsConfig *pstatsconf,
+					const CStatistics *pstats,
+					const DrgPul *pdrgpulColIds
+					);
+
+			// correct the scale factor of a conjunctive filter for functional
+			// dependencies between the filtered columns
+			static
+			CDouble DScaleFactorDependencies
+					(
+					IMemoryPool *pmp,
+					const CStatistics *pstats,
+					CStatsPredConj *pstatspredConj,
+					CDouble dScaleFactor
+					);
+
+			// return the scale factors of join predicates, combining the factors of
+			// predicates on columns covered by multi-column statistics
+			static
+			DrgPdouble *PdrgpdJoinScaleFactorsMultiColumn
+					(
+					IMemoryPool *pmp,
+					CStatisticsConfig *pstatsconf,
+					const CStatistics *pstatsOuter,
+					const CStatistics *pstatsInner,
+					DrgPstatspredjoin *pdrgpstatspredjoin,
+					DrgPdouble *pdrgpdScaleFactor
+					);
+
 			// return the mapping between the table column used for grouping to the logical operator id where it was defined.
 			// If the grouping column is not a table column then the logical op id is initialized to ULONG_MAX
 			static
@@ -421,6 +478,7 @@ namespace gpnaucrates
 			void AddGrpColStats
 					(
 					IMemoryPool *pmp,
+					CStatisticsConfig *pstatsconf,
 					const CStatistics *pstatsInput,
 					CColRefSet *pcrsGrpCols,
 					HMUlHist *phmulhistOutput,
@@ -0,0 +1,169 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CStatsFilterCache.h
+//
+//	@doc:
+//		Cache of statistics derived for filters during an optimization
+//---------------------------------------------------------------------------
+#ifndef GPNAUCRATES_CStatsFilterCache_H
+#define GPNAUCRATES_CStatsFilterCache_H
+
+#include "gpos/base.h"
+#include "gpos/common/CHashMap.h"
+#include "gpos/sync/CMutex.h"
+
+#include "naucrates/statistics/IStatistics.h"
+
+// maximum number of filters cached per query
+#define GPNAUCRATES_STATS_FILTER_CACHE_MAX_ENTRIES 4096
+
+namespace gpnaucrates
+{
+	using namespace gpos;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CStatsFilterCache
+	//
+	//	@doc:
+	//		Per-query memoization of filter statistics; the same predicates on
+	//		the same input statistics are derived once per group alternative,
+	//		so results are cached by input statistics object and predicate;
+	//		callers may change the statistics they get, e.g., their estimation
+	//		risk, so they get copies of the cached results, which share their
+	//		histograms. Keys hold references to the input statistics, so the
+	//		number of cached filters is bounded.
+	//
+	//---------------------------------------------------------------------------
+	class CStatsFilterCache
+	{
+		private:
+
+			//---------------------------------------------------------------------------
+			//	@class:
+			//		CKey
+			//
+			//	@doc:
+			//		Cache key; holds references to the input statistics, which
+			//		are compared by identity, and to the predicate, which is
+			//		compared by value
+			//
+			//---------------------------------------------------------------------------
+			class CKey
+			{
+				private:
+
+					// input statistics
+					IStatistics *m_pstats;
+
+					// filter predicate
+					CStatsPred *m_pstatspred;
+
+					// are NDVs capped to the number of output rows
+					BOOL m_fCapNdvs;
+
+					// cached hash value
+					ULONG m_ulHash;
+
+					// private copy ctor
+					CKey(const CKey &);
+
+				public:
+
+					// ctor
+					CKey(IStatistics *pstats, CStatsPred *pstatspred, BOOL fCapNdvs);
+
+					// dtor
+					~CKey();
+
+					// hash function
+					static
+					ULONG UlHash(const CKey *pkey);
+
+					// equality function
+					static
+					BOOL FEqual(const CKey *pkeyFst, const CKey *pkeySnd);
+
+			}; // class CKey
+
+			// map from cache key to derived statistics
+			typedef CHashMap<CKey, IStatistics, CKey::UlHash, CKey::FEqual,
+						CleanupDelete<CKey>, CleanupRelease<IStatistics> > HMKeyStats;
+
+			// memory pool of cached statistics
+			IMemoryPool *m_pmp;
+
+			// cached statistics
+			HMKeyStats *m_phmkeystats;
+
+			// mutex protecting the map
+			CMutex m_mutex;
+
+			// maximum number of cached filters
+			ULONG m_ulMaxEntries;
+
+			// number of lookups
+			ULONG_PTR m_ulpLookups;
+
+			// number of lookups that found derived statistics
+			ULONG_PTR m_ulpHits;
+
+			// private copy ctor
+			CStatsFilterCache(const CStatsFilterCache &);
+
+		public:
+
+			// ctor
+			explicit
+			CStatsFilterCache(IMemoryPool *pmp, ULONG ulMaxEntries = GPNAUCRATES_STATS_FILTER_CACHE_MAX_ENTRIES);
+
+			// dtor
+			~CStatsFilterCache();
+
+			// derive statistics of given filter on given input statistics,
+			// or return statistics derived for an identical filter before
+			IStatistics *PstatsFilter
+				(
+				IMemoryPool *pmp,
+				IStatistics *pstats,
+				CStatsPred *pstatspred,
+				BOOL fCapNdvs
+				);
+
+			// number of lookups
+			ULONG_PTR UlpLookups() const
+			{
+				return m_ulpLookups;
+			}
+
+			// number of lookups that found derived statistics
+			ULONG_PTR UlpHits() const
+			{
+				return m_ulpHits;
+			}
+
+			// number of cached filters
+			ULONG UlEntries() const
+			{
+				return m_phmkeystats->UlEntries();
+			}
+
+			// reset lookup and hit counters, e.g., at the start of a search stage
+			void ResetCounters()
+			{
+				m_ulpLookups = 0;
+				m_ulpHits = 0;
+			}
+
+			// print lookup and hit counters
+			IOstream &OsPrint(IOstream &os) const;
+
+	}; // class CStatsFilterCache
+}
+
+#endif // !GPNAUCRATES_CStatsFilterCache_H
+
+// EOF
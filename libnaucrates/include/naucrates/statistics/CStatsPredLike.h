@@ -12,6 +12,7 @@
 #define GPNAUCRATES_CStatsPredLike_H
 
 #include "gpos/base.h"
+#include "naucrates/base/IDatum.h"
 #include "naucrates/md/IMDType.h"
 #include "naucrates/statistics/CStatsPred.h"
 
@@ -52,6 +53,9 @@ namespace gpnaucrates
 			// default scale factor
 			CDouble m_dDefaultScaleFactor;
 
+			// pattern matched by the column, NULL if the column is the pattern
+			IDatum *m_pdatumPattern;
+
 		public:
 
 			// ctor
@@ -60,7 +64,8 @@ namespace gpnaucrates
 				ULONG ulColId,
 				CExpression *pexprLeft,
 				CExpression *pexprRight,
-				CDouble dDefaultScaleFactor
+				CDouble dDefaultScaleFactor,
+				IDatum *pdatumPattern = NULL
 				);
 
 			// dtor
@@ -96,6 +101,12 @@ namespace gpnaucrates
 			virtual
 			CDouble DDefaultScaleFactor() const;
 
+			// pattern matched by the column
+			const IDatum *PdatumPattern() const
+			{
+				return m_pdatumPattern;
+			}
+
 			// conversion function
 			static
 			CStatsPredLike *PstatspredConvert
@@ -215,6 +215,14 @@ namespace gpopt
 			static
 			BOOL FUnsupportedPredOnDefinedCol(CStatsPred *pstatspred);
 
+			// hash of a statistics filter, combining the hashes of its components
+			static
+			ULONG UlHash(const CStatsPred *pstatspred);
+
+			// are the given statistics filters identical, including the order of their components
+			static
+			BOOL FEqual(const CStatsPred *pstatspredFst, const CStatsPred *pstatspredSnd);
+
 	}; // class CStatsPredUtils
 }
 
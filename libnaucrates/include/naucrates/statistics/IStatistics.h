@@ -41,11 +41,11 @@ namespace gpnaucrates
 
 	// hash map from column id to a histogram
 	typedef CHashMap<ULONG, CHistogram, gpos::UlHash<ULONG>, gpos::FEqual<ULONG>,
-					CleanupDelete<ULONG>, CleanupDelete<CHistogram> > HMUlHist;
+					CleanupDelete<ULONG>, CleanupRelease<CHistogram> > HMUlHist;
 
 	// iterator
 	typedef CHashMapIter<ULONG, CHistogram, gpos::UlHash<ULONG>, gpos::FEqual<ULONG>,
-					CleanupDelete<ULONG>, CleanupDelete<CHistogram> > HMIterUlHist;
+					CleanupDelete<ULONG>, CleanupRelease<CHistogram> > HMIterUlHist;
 
 	// hash map from column ULONG to CDouble
 	typedef CHashMap<ULONG, CDouble, gpos::UlHash<ULONG>, gpos::FEqual<ULONG>,
@@ -252,6 +252,10 @@ namespace gpnaucrates
 			virtual
 			IStatistics *PstatsCopyWithRemap(IMemoryPool *pmp, HMUlCr *phmulcr, BOOL fMustExist = true) const = 0;
 
+			// copy stats keeping histograms only for the given columns
+			virtual
+			IStatistics *PstatsPruneHistograms(IMemoryPool *pmp, CColRefSet *pcrsHist) const = 0;
+
 			// return a set of column references we have stats for
 			virtual
 			CColRefSet *Pcrs(IMemoryPool *pmp) const = 0;
@@ -71,6 +71,9 @@ namespace gpos
 		// print MEMO during property enforcement process
 		EopttracePrintMemoEnforcement = 101015,
 
+		// print per-xform profile of calls, bindings, results, time, memo growth and plan impact
+		EopttracePrintXformProfile = 101016,
+
 		///////////////////////////////////////////////////////
 		////////////////// transformations flags //////////////
 		///////////////////////////////////////////////////////
@@ -166,6 +169,12 @@ namespace gpos
 		// create constraint intervals from array expressions in preprocessing
 		EopttraceArrayConstraints = 103026,
 
+		// skip join reordering xforms that rarely contribute to final plans of similar queries
+		EopttraceEnableAdaptiveXformBudget = 103027,
+
+		// plan runtime filters from hash join inner keys applied to the outer child
+		EopttraceEnableRuntimeFilter = 103028,
+
 		///////////////////////////////////////////////////////
 		///////////////////// statistics flags ////////////////
 		//////////////////////////////////////////////////////
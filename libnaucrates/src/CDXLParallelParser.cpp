@@ -0,0 +1,599 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CDXLParallelParser.cpp
+//
+//	@doc:
+//		Implementation of the parser of DXL documents parsing metadata
+//		objects on worker tasks
+//---------------------------------------------------------------------------
+
+#include "gpos/common/CAutoP.h"
+#include "gpos/common/CAutoRg.h"
+#include "gpos/task/CAutoTaskProxy.h"
+#include "gpos/task/CWorker.h"
+
+#include "naucrates/dxl/CDXLParallelParser.h"
+#include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/parser/CParseHandlerDXL.h"
+
+#include <algorithm>
+
+using namespace gpos;
+using namespace gpdxl;
+
+// metadata section and its elements that are not metadata objects
+#define GPDXL_METADATA_TAG		"dxl:Metadata"
+#define GPDXL_MDID_TAG			"dxl:Mdid"
+
+// metadata section wrapping the elements of a chunk
+#define GPDXL_METADATA_OPEN		"<" GPDXL_METADATA_TAG ">"
+#define GPDXL_METADATA_CLOSE	"</" GPDXL_METADATA_TAG "></"
+
+// maximum number of tasks parsing metadata chunks
+const ULONG CDXLParallelParser::ulParseTasksMax = 8;
+
+// minimum number of metadata elements for parsing in parallel
+const ULONG CDXLParallelParser::ulParallelElementsMin = 128;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLParallelParser::SzMarkupEnd
+//
+//	@doc:
+//		End of the markup starting at the given position, NULL if the markup
+//		is not terminated; quoted attribute values may contain '>'
+//
+//---------------------------------------------------------------------------
+const CHAR *
+CDXLParallelParser::SzMarkupEnd
+	(
+	const CHAR *sz,
+	EMarkup *pemarkup
+	)
+{
+	GPOS_ASSERT('<' == *sz);
+
+	const CHAR *szTerminator = NULL;
+	if (0 == clib::IStrNCmp(sz, "<!--", 4))
+	{
+		szTerminator = "-->";
+	}
+	else if (0 == clib::IStrNCmp(sz, "<![CDATA[", 9))
+	{
+		szTerminator = "]]>";
+	}
+	else if ('?' == sz[1])
+	{
+		szTerminator = "?>";
+	}
+
+	if (NULL != szTerminator)
+	{
+		*pemarkup = EmarkupOther;
+
+		const ULONG ulLength = clib::UlStrLen(szTerminator);
+		for (sz += 2; '\0' != *sz; sz++)
+		{
+			if (0 == clib::IStrNCmp(sz, szTerminator, ulLength))
+			{
+				return sz + ulLength;
+			}
+		}
+
+		return NULL;
+	}
+
+	*pemarkup = EmarkupStartTag;
+	if ('/' == sz[1])
+	{
+		*pemarkup = EmarkupEndTag;
+	}
+	else if ('!' == sz[1])
+	{
+		*pemarkup = EmarkupOther;
+	}
+
+	CHAR chQuote = '\0';
+	for (sz++; '\0' != *sz; sz++)
+	{
+		if ('\0' != chQuote)
+		{
+			if (chQuote == *sz)
+			{
+				chQuote = '\0';
+			}
+		}
+		else if ('"' == *sz || '\'' == *sz)
+		{
+			chQuote = *sz;
+		}
+		else if ('>' == *sz)
+		{
+			if (EmarkupStartTag == *pemarkup && '/' == sz[-1])
+			{
+				*pemarkup = EmarkupEmptyTag;
+			}
+
+			return sz + 1;
+		}
+	}
+
+	return NULL;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLParallelParser::FTagName
+//
+//	@doc:
+//		Does the tag at the given position have the given name
+//
+//---------------------------------------------------------------------------
+BOOL
+CDXLParallelParser::FTagName
+	(
+	const CHAR *szTag,
+	const CHAR *szName
+	)
+{
+	GPOS_ASSERT('<' == *szTag);
+
+	const ULONG ulLength = clib::UlStrLen(szName);
+	if (0 != clib::IStrNCmp(szTag + 1, szName, ulLength))
+	{
+		return false;
+	}
+
+	CHAR ch = szTag[1 + ulLength];
+	return ' ' == ch || '\t' == ch || '\r' == ch || '\n' == ch || '>' == ch || '/' == ch;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLParallelParser::FLocateMetadata
+//
+//	@doc:
+//		Locate the root element and the metadata section of a document;
+//		returns false if the document has no metadata section whose
+//		elements can be split
+//
+//---------------------------------------------------------------------------
+BOOL
+CDXLParallelParser::FLocateMetadata
+	(
+	const CHAR *szDXL,
+	SMetadataSection *psect
+	)
+{
+	psect->m_szRootEnd = NULL;
+	psect->m_szRootName = NULL;
+	psect->m_ulRootNameLength = 0;
+	psect->m_szContent = NULL;
+	psect->m_szContentEnd = NULL;
+	psect->m_ulElements = 0;
+
+	ULONG ulDepth = 0;
+	for (const CHAR *sz = clib::SzStrChr(szDXL, '<'); NULL != sz; )
+	{
+		EMarkup emarkup = EmarkupOther;
+		const CHAR *szEnd = SzMarkupEnd(sz, &emarkup);
+		if (NULL == szEnd)
+		{
+			return false;
+		}
+
+		if (EmarkupEndTag == emarkup)
+		{
+			// the metadata section must precede the end of the root element
+			if (1 >= ulDepth)
+			{
+				return false;
+			}
+			ulDepth--;
+		}
+		else if (EmarkupOther != emarkup)
+		{
+			if (NULL == psect->m_szRootEnd)
+			{
+				if (EmarkupEmptyTag == emarkup)
+				{
+					return false;
+				}
+
+				psect->m_szRootEnd = szEnd;
+				psect->m_szRootName = sz + 1;
+				for (CHAR ch = *psect->m_szRootName;
+					' ' != ch && '\t' != ch && '\r' != ch && '\n' != ch && '>' != ch && '/' != ch;
+					ch = psect->m_szRootName[++psect->m_ulRootNameLength])
+				{}
+			}
+			else if (FTagName(sz, GPDXL_METADATA_TAG))
+			{
+				if (EmarkupEmptyTag == emarkup)
+				{
+					return false;
+				}
+
+				psect->m_szContent = szEnd;
+				psect->m_szContentEnd = SzScanElements(szEnd, &psect->m_ulElements, 0 /*ulContentLength*/, 0 /*ulChunks*/, NULL /*rgszChunk*/);
+
+				return NULL != psect->m_szContentEnd;
+			}
+
+			if (EmarkupStartTag == emarkup)
+			{
+				ulDepth++;
+			}
+		}
+
+		sz = clib::SzStrChr(szEnd, '<');
+	}
+
+	return false;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLParallelParser::SzScanElements
+//
+//	@doc:
+//		Scan the top-level elements of the metadata section. An element
+//		starts the next chunk once the content preceding it reaches the
+//		share of that chunk, so chunks hold about the same number of bytes.
+//		Returns the end of the content, or NULL if it cannot be split
+//
+//---------------------------------------------------------------------------
+const CHAR *
+CDXLParallelParser::SzScanElements
+	(
+	const CHAR *szContent,
+	ULONG *pulElements,
+	ULONG ulContentLength,
+	ULONG ulChunks,
+	const CHAR **rgszChunk
+	)
+{
+	GPOS_ASSERT_IMP(0 < ulChunks, NULL != rgszChunk);
+
+	*pulElements = 0;
+	ULONG ulDepth = 0;
+	ULONG ulChunk = 0;
+	for (const CHAR *sz = clib::SzStrChr(szContent, '<'); NULL != sz; )
+	{
+		EMarkup emarkup = EmarkupOther;
+		const CHAR *szEnd = SzMarkupEnd(sz, &emarkup);
+		if (NULL == szEnd)
+		{
+			return NULL;
+		}
+
+		if (EmarkupEndTag == emarkup)
+		{
+			if (0 == ulDepth)
+			{
+				// end of the metadata section
+				return sz;
+			}
+			ulDepth--;
+		}
+		else if (EmarkupOther != emarkup)
+		{
+			if (0 == ulDepth)
+			{
+				// metadata ids are collected by the metadata section itself
+				if (FTagName(sz, GPDXL_MDID_TAG))
+				{
+					return NULL;
+				}
+
+				ULLONG ullOffset = (ULLONG) (sz - szContent);
+				while (ulChunk + 1 < ulChunks && ullOffset * ulChunks >= (ULLONG) (ulChunk + 1) * ulContentLength)
+				{
+					ulChunk++;
+					rgszChunk[ulChunk] = sz;
+				}
+
+				(*pulElements)++;
+			}
+
+			if (EmarkupStartTag == emarkup)
+			{
+				ulDepth++;
+			}
+		}
+
+		sz = clib::SzStrChr(szEnd, '<');
+	}
+
+	return NULL;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLParallelParser::UlChunkLength
+//
+//	@doc:
+//		Length of a document holding the given metadata elements, including
+//		the terminating null character
+//
+//---------------------------------------------------------------------------
+ULONG
+CDXLParallelParser::UlChunkLength
+	(
+	const CHAR *szDXL,
+	const SMetadataSection *psect,
+	const CHAR *szStart,
+	const CHAR *szEnd
+	)
+{
+	return (ULONG) (psect->m_szRootEnd - szDXL) +
+			clib::UlStrLen(GPDXL_METADATA_OPEN) +
+			(ULONG) (szEnd - szStart) +
+			clib::UlStrLen(GPDXL_METADATA_CLOSE) +
+			psect->m_ulRootNameLength +
+			2; // closing bracket and null character
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLParallelParser::SzWriteChunk
+//
+//	@doc:
+//		Write a document holding the given metadata elements into the given
+//		buffer: the prolog and the start tag of the root element of the
+//		original document, a metadata section with the elements, and the
+//		end tags. Returns the position after the terminating null character.
+//
+//---------------------------------------------------------------------------
+CHAR *
+CDXLParallelParser::SzWriteChunk
+	(
+	CHAR *szOut,
+	const CHAR *szDXL,
+	const SMetadataSection *psect,
+	const CHAR *szStart,
+	const CHAR *szEnd
+	)
+{
+	const ULONG ulPrologLength = (ULONG) (psect->m_szRootEnd - szDXL);
+	(void) clib::PvMemCpy(szOut, szDXL, ulPrologLength);
+	szOut += ulPrologLength;
+
+	const ULONG ulOpenLength = clib::UlStrLen(GPDXL_METADATA_OPEN);
+	(void) clib::PvMemCpy(szOut, GPDXL_METADATA_OPEN, ulOpenLength);
+	szOut += ulOpenLength;
+
+	(void) clib::PvMemCpy(szOut, szStart, (ULONG) (szEnd - szStart));
+	szOut += szEnd - szStart;
+
+	const ULONG ulCloseLength = clib::UlStrLen(GPDXL_METADATA_CLOSE);
+	(void) clib::PvMemCpy(szOut, GPDXL_METADATA_CLOSE, ulCloseLength);
+	szOut += ulCloseLength;
+
+	(void) clib::PvMemCpy(szOut, psect->m_szRootName, psect->m_ulRootNameLength);
+	szOut += psect->m_ulRootNameLength;
+
+	*szOut++ = '>';
+	*szOut++ = '\0';
+
+	return szOut;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLParallelParser::SzWithoutMetadata
+//
+//	@doc:
+//		Copy of the document with an empty metadata section
+//
+//---------------------------------------------------------------------------
+CHAR *
+CDXLParallelParser::SzWithoutMetadata
+	(
+	IMemoryPool *pmp,
+	const CHAR *szDXL,
+	const SMetadataSection *psect
+	)
+{
+	const ULONG ulHeadLength = (ULONG) (psect->m_szContent - szDXL);
+	const ULONG ulTailLength = clib::UlStrLen(psect->m_szContentEnd);
+
+	CHAR *sz = GPOS_NEW_ARRAY(pmp, CHAR, ulHeadLength + ulTailLength + 1);
+	(void) clib::PvMemCpy(sz, szDXL, ulHeadLength);
+	(void) clib::PvMemCpy(sz + ulHeadLength, psect->m_szContentEnd, ulTailLength + 1);
+
+	return sz;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLParallelParser::PvParseChunk
+//
+//	@doc:
+//		Task parsing a chunk of metadata elements
+//
+//---------------------------------------------------------------------------
+void *
+CDXLParallelParser::PvParseChunk
+	(
+	void *pv
+	)
+{
+	GPOS_ASSERT(NULL != pv);
+
+	SParseTaskArg *parg = reinterpret_cast<SParseTaskArg *>(pv);
+
+	CAutoP<CParseHandlerDXL> a_pphdxl(CDXLUtils::PphdxlParseDXL(parg->m_pmp, parg->m_szDXL, NULL /*szXSDPath*/));
+	parg->m_pdrgpmdobj = a_pphdxl.Pt()->Pdrgpmdobj();
+	parg->m_pdrgpmdobj->AddRef();
+
+	return NULL;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLParallelParser::PphdxlParse
+//
+//	@doc:
+//		Parse a DXL document; if its metadata section has at least the
+//		given number of elements, there are idle workers to parse them, the
+//		current task does not run on a pool worker itself and the memory
+//		pool may be shared by tasks, the elements are parsed on worker tasks
+//		in chunks while the rest of the document is parsed on the current
+//		task
+//
+//---------------------------------------------------------------------------
+CParseHandlerDXL *
+CDXLParallelParser::PphdxlParse
+	(
+	IMemoryPool *pmp,
+	const CHAR *szDXL,
+	ULONG ulElementsMin
+	)
+{
+	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(NULL != szDXL);
+
+	// a task running on a pool worker parses the document itself, as waiting
+	// for nested tasks could block the workers those tasks need
+	CWorkerPoolManager *pwpm = CWorkerPoolManager::Pwpm();
+	CWorker *pwrkr = CWorker::PwrkrSelf();
+	ULONG ulTasksMax = 0;
+	if (NULL == pwrkr || !pwrkr->FPoolWorker())
+	{
+		ulTasksMax = std::min(ulParseTasksMax, pwpm->UlWorkersIdle());
+	}
+
+	// the objects of all chunks are allocated in the given pool
+	SMetadataSection sect;
+	if (2 > ulTasksMax ||
+		!pmp->FThreadSafe() ||
+		!FLocateMetadata(szDXL, &sect) ||
+		sect.m_ulElements < std::max(ulElementsMin, (ULONG) 2))
+	{
+		return CDXLUtils::PphdxlParseDXL(pmp, szDXL, NULL /*szXSDPath*/);
+	}
+
+	const ULONG ulTasks = std::min(ulTasksMax, sect.m_ulElements);
+
+	// split the elements into chunks of about equal size
+	CAutoRg<const CHAR *> a_rgszChunk;
+	a_rgszChunk = GPOS_NEW_ARRAY(pmp, const CHAR *, ulTasks + 1);
+	for (ULONG ul = 0; ul <= ulTasks; ul++)
+	{
+		a_rgszChunk[ul] = NULL;
+	}
+	a_rgszChunk[0] = sect.m_szContent;
+
+	ULONG ulElements = 0;
+#ifdef GPOS_DEBUG
+	const CHAR *szContentEnd =
+#endif // GPOS_DEBUG
+	SzScanElements(sect.m_szContent, &ulElements, (ULONG) (sect.m_szContentEnd - sect.m_szContent), ulTasks, a_rgszChunk.Rgt());
+	GPOS_ASSERT(szContentEnd == sect.m_szContentEnd);
+	GPOS_ASSERT(ulElements == sect.m_ulElements);
+
+	ULONG ulLength = 0;
+	for (ULONG ul = 1; ul <= ulTasks; ul++)
+	{
+		if (NULL == a_rgszChunk[ul])
+		{
+			a_rgszChunk[ul] = sect.m_szContentEnd;
+		}
+		ulLength += UlChunkLength(szDXL, &sect, a_rgszChunk[ul - 1], a_rgszChunk[ul]);
+	}
+
+	// the documents of all chunks share one buffer
+	CAutoRg<CHAR> a_szChunks;
+	a_szChunks = GPOS_NEW_ARRAY(pmp, CHAR, ulLength);
+
+	CAutoRg<SParseTaskArg> a_rgarg;
+	a_rgarg = GPOS_NEW_ARRAY(pmp, SParseTaskArg, ulTasks);
+
+	CHAR *sz = a_szChunks.Rgt();
+	for (ULONG ul = 0; ul < ulTasks; ul++)
+	{
+		a_rgarg[ul].m_pmp = pmp;
+		a_rgarg[ul].m_szDXL = NULL;
+		a_rgarg[ul].m_pdrgpmdobj = NULL;
+
+		if (a_rgszChunk[ul] != a_rgszChunk[ul + 1])
+		{
+			a_rgarg[ul].m_szDXL = sz;
+			sz = SzWriteChunk(sz, szDXL, &sect, a_rgszChunk[ul], a_rgszChunk[ul + 1]);
+		}
+	}
+
+	CAutoRg<CHAR> a_szRest;
+	a_szRest = SzWithoutMetadata(pmp, szDXL, &sect);
+
+	CAutoRg<CTask*> a_rgptsk;
+	a_rgptsk = GPOS_NEW_ARRAY(pmp, CTask*, ulTasks);
+
+	CAutoP<CParseHandlerDXL> a_pphdxl;
+	GPOS_TRY
+	{
+		CAutoTaskProxy atp(pmp, pwpm);
+
+		ULONG ulScheduled = 0;
+		for (ULONG ul = 0; ul < ulTasks; ul++)
+		{
+			if (NULL != a_rgarg[ul].m_szDXL)
+			{
+				a_rgptsk[ulScheduled] = atp.PtskCreate(PvParseChunk, &a_rgarg[ul]);
+				atp.Schedule(a_rgptsk[ulScheduled]);
+				ulScheduled++;
+			}
+		}
+
+		// parse the rest of the document while the tasks parse the chunks
+		a_pphdxl = CDXLUtils::PphdxlParseDXL(pmp, a_szRest.Rgt(), NULL /*szXSDPath*/);
+
+		// errors of tasks are propagated to the current task
+		for (ULONG ul = 0; ul < ulScheduled; ul++)
+		{
+			CTask *ptsk = NULL;
+			atp.WaitAny(&ptsk);
+		}
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		for (ULONG ul = 0; ul < ulTasks; ul++)
+		{
+			CRefCount::SafeRelease(a_rgarg[ul].m_pdrgpmdobj);
+		}
+
+		GPOS_RETHROW(ex);
+	}
+	GPOS_CATCH_END;
+
+	// add the objects of the chunks to the metadata section in document order
+	DrgPimdobj *pdrgpmdobj = a_pphdxl.Pt()->Pdrgpmdobj();
+	GPOS_ASSERT(NULL != pdrgpmdobj && 0 == pdrgpmdobj->UlLength());
+
+	for (ULONG ul = 0; ul < ulTasks; ul++)
+	{
+		DrgPimdobj *pdrgpmdobjChunk = a_rgarg[ul].m_pdrgpmdobj;
+		if (NULL == pdrgpmdobjChunk)
+		{
+			continue;
+		}
+
+		const ULONG ulObjects = pdrgpmdobjChunk->UlLength();
+		for (ULONG ulObj = 0; ulObj < ulObjects; ulObj++)
+		{
+			IMDCacheObject *pimdobj = (*pdrgpmdobjChunk)[ulObj];
+			pimdobj->AddRef();
+			pdrgpmdobj->Append(pimdobj);
+		}
+
+		pdrgpmdobjChunk->Release();
+	}
+
+	return a_pphdxl.PtReset();
+}
+
+// EOF
@@ -17,6 +17,7 @@
 #include "gpos/io/ioutils.h"
 #include "gpos/io/CFileReader.h"
 #include "gpos/io/COstreamString.h"
+#include "gpos/memory/CAutoMemoryPool.h"
 #include "gpos/task/CAutoTraceFlag.h"
 #include "gpos/task/CWorker.h"
 
@@ -25,6 +26,7 @@
 #include "gpopt/optimizer/COptimizerConfig.h"
 
 #include "naucrates/base/CQueryToDXLResult.h"
+#include "naucrates/dxl/CDXLParallelParser.h"
 #include "naucrates/dxl/CDXLUtils.h"
 #include "naucrates/dxl/parser/CParseHandlerDXL.h"
 #include "naucrates/dxl/parser/CParseHandlerPlan.h"
@@ -32,6 +34,9 @@
 #include "naucrates/dxl/parser/CParseHandlerFactory.h"
 #include "naucrates/dxl/parser/CParseHandlerManager.h"
 #include "naucrates/dxl/parser/CParseHandlerDummy.h"
+#include "naucrates/dxl/xml/CDXLBinaryReader.h"
+#include "naucrates/dxl/xml/CDXLBinarySerializer.h"
+#include "naucrates/dxl/xml/CDXLGrammarCache.h"
 #include "naucrates/dxl/xml/CDXLMemoryManager.h"
 #include "naucrates/dxl/xml/CXMLSerializer.h"
 #include "gpopt/mdcache/CMDAccessor.h"
@@ -82,29 +87,14 @@ CDXLUtils::PphdxlParseDXL
 
 	// setup own memory manager
 	CDXLMemoryManager *pmm = GPOS_NEW(pmp) CDXLMemoryManager(pmp);
-	SAX2XMLReader* pxmlreader = XMLReaderFactory::createXMLReader(pmm);
+
+	// validating readers use the cached grammars of the schema
+	SAX2XMLReader* pxmlreader = CDXLGrammarCache::PxmlreaderCreate(pmm, szXSDPath);
 	
 #ifdef GPOS_DEBUG
 	CWorker::PwrkrSelf()->ResetTimeSlice();
 #endif // GPOS_DEBUG
 
-	XMLCh *xmlszXSDPath = NULL;
-	
-	if (NULL != szXSDPath)
-	{
-		// setup XSD validation
-		pxmlreader->setFeature(XMLUni::fgSAX2CoreValidation, true);
-		pxmlreader->setFeature(XMLUni::fgXercesDynamic, false);
-		pxmlreader->setFeature(XMLUni::fgSAX2CoreNameSpaces, true);
-		pxmlreader->setFeature(XMLUni::fgXercesSchema, true);
-		
-		pxmlreader->setFeature(XMLUni::fgXercesSchemaFullChecking, true);
-		pxmlreader->setFeature(XMLUni::fgSAX2CoreNameSpacePrefixes, true);
-		
-		xmlszXSDPath = XMLString::transcode(szXSDPath, pmm);
-		pxmlreader->setProperty(XMLUni::fgXercesSchemaExternalSchemaLocation, (void*) xmlszXSDPath);
-	}
-			
 	CParseHandlerManager *pphm = GPOS_NEW(pmp) CParseHandlerManager(pmm, pxmlreader);
 
 	CParseHandlerDXL *pphdxl = CParseHandlerFactory::Pphdxl(pmp, pphm);
@@ -155,7 +145,6 @@ CDXLUtils::PphdxlParseDXL
 	delete pmbis;
 	GPOS_DELETE(pphm);
 	GPOS_DELETE(pmm);
-	delete xmlszXSDPath;
 
 	// reset time slice counter as unloading deleting Xerces SAX2 readers seems to take a lot of time (OPT-491)
 #ifdef GPOS_DEBUG
@@ -195,24 +184,8 @@ CDXLUtils::PphdxlParseDXLFile
 		CAutoTraceFlag atf(EtraceSimulateOOM, false);
 		CAutoTraceFlag atf2(EtraceSimulateAbort, false);
 
-		pxmlreader = XMLReaderFactory::createXMLReader(&mm);
-	}
-	
-	XMLCh *xmlszXSDPath = NULL;
-	
-	if (NULL != szXSDPath)
-	{
-		// setup XSD validation
-		pxmlreader->setFeature(XMLUni::fgSAX2CoreValidation, true);
-		pxmlreader->setFeature(XMLUni::fgXercesDynamic, false);
-		pxmlreader->setFeature(XMLUni::fgSAX2CoreNameSpaces, true);
-		pxmlreader->setFeature(XMLUni::fgXercesSchema, true);
-		
-		pxmlreader->setFeature(XMLUni::fgXercesSchemaFullChecking, true);
-		pxmlreader->setFeature(XMLUni::fgSAX2CoreNameSpacePrefixes, true);
-		
-		xmlszXSDPath = XMLString::transcode(szXSDPath, &mm);
-		pxmlreader->setProperty(XMLUni::fgXercesSchemaExternalSchemaLocation, (void*) xmlszXSDPath);
+		// validating readers use the cached grammars of the schema
+		pxmlreader = CDXLGrammarCache::PxmlreaderCreate(&mm, szXSDPath);
 	}
 
 	CParseHandlerManager phm(&mm, pxmlreader);
@@ -237,7 +210,6 @@ CDXLUtils::PphdxlParseDXLFile
 	{
 		GPOS_DELETE(pph);
 		delete pxmlreader;
-		delete[] xmlszXSDPath;
 		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLXercesParseError);
 
 		return NULL;
@@ -246,7 +218,6 @@ CDXLUtils::PphdxlParseDXLFile
 	{
 		GPOS_DELETE(pph);
 		delete pxmlreader;
-		delete[] xmlszXSDPath;
 		
 		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLXercesParseError);
 
@@ -256,7 +227,6 @@ CDXLUtils::PphdxlParseDXLFile
 	{
 		GPOS_DELETE(pph);
 		delete pxmlreader;
-		delete[] xmlszXSDPath;
 		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLXercesParseError);
 
 		return NULL;
@@ -271,9 +241,7 @@ CDXLUtils::PphdxlParseDXLFile
 #ifdef GPOS_DEBUG
     CWorker::PwrkrSelf()->ResetTimeSlice();
 #endif // GPOS_DEBUG
-    
-	delete[] xmlszXSDPath;
-	
+
 	return pph;
 }
 
@@ -438,6 +406,7 @@ CDXLUtils::PdxlnParseScalarExpr
 //		Parse a list of metadata objects from the given DXL string.
 //		If a non-empty XSD schema location is provided, the DXL is validated against
 //		that schema, and an exception is thrown if the DXL does not conform.
+//		Without validation, large lists are parsed on worker tasks.
 //
 //---------------------------------------------------------------------------
 DrgPimdobj *
@@ -451,7 +420,15 @@ CDXLUtils::PdrgpmdobjParseDXL
 	GPOS_ASSERT(NULL != pmp);
 
 	// create and install a parse handler for the DXL document
-	CParseHandlerDXL *pphdxl = PphdxlParseDXL(pmp, szDXL, szXSDPath);
+	CParseHandlerDXL *pphdxl = NULL;
+	if (NULL == szXSDPath)
+	{
+		pphdxl = CDXLParallelParser::PphdxlParse(pmp, szDXL, CDXLParallelParser::ulParallelElementsMin);
+	}
+	else
+	{
+		pphdxl = PphdxlParseDXL(pmp, szDXL, szXSDPath);
+	}
 	CAutoP<CParseHandlerDXL> a_pphdxl(pphdxl);
 	
 	// collect metadata objects from dxl parse handler
@@ -461,6 +438,141 @@ CDXLUtils::PdrgpmdobjParseDXL
 	return pdrgpmdobj;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::PphdxlParseBinaryDXL
+//
+//	@doc:
+//		Replay the given binary DXL document to the DXL parse handlers and
+//		return the top-level parser
+//
+//---------------------------------------------------------------------------
+CParseHandlerDXL *
+CDXLUtils::PphdxlParseBinaryDXL
+	(
+	IMemoryPool *pmp,
+	const BYTE *pba,
+	ULONG ulLength
+	)
+{
+	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(NULL != pba);
+
+	CDXLMemoryManager mm(pmp);
+	CParseHandlerManager phm(&mm, NULL /*pxmlreader*/);
+	CParseHandlerDXL *pphdxl = CParseHandlerFactory::Pphdxl(pmp, &phm);
+	CAutoP<CParseHandlerDXL> a_pphdxl(pphdxl);
+
+	phm.ActivateParseHandler(pphdxl);
+
+	CDXLBinaryReader binreader(pmp, pba, ulLength);
+	binreader.Parse(&phm);
+
+	GPOS_CHECK_ABORT;
+
+	return a_pphdxl.PtReset();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::PdxlnParseBinaryPlan
+//
+//	@doc:
+//		Parse a binary DXL document into a DXL plan tree
+//
+//---------------------------------------------------------------------------
+CDXLNode *
+CDXLUtils::PdxlnParseBinaryPlan
+	(
+	IMemoryPool *pmp,
+	const BYTE *pba,
+	ULONG ulLength,
+	ULLONG *pullPlanId,
+	ULLONG *pullPlanSpaceSize
+	)
+{
+	GPOS_ASSERT(NULL != pullPlanId);
+	GPOS_ASSERT(NULL != pullPlanSpaceSize);
+
+	CAutoP<CParseHandlerDXL> a_pphdxl(PphdxlParseBinaryDXL(pmp, pba, ulLength));
+
+	CDXLNode *pdxlnRoot = a_pphdxl->PdxlnPlan();
+	*pullPlanId = a_pphdxl->UllPlanId();
+	*pullPlanSpaceSize = a_pphdxl->UllPlanSpaceSize();
+
+	GPOS_ASSERT(NULL != pdxlnRoot);
+
+#ifdef GPOS_DEBUG
+	pdxlnRoot->Pdxlop()->AssertValid(pdxlnRoot, true /* fValidateChildren */);
+#endif
+
+	pdxlnRoot->AddRef();
+
+	return pdxlnRoot;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::PdxlnParseBinaryDXLQuery
+//
+//	@doc:
+//		Parse a binary DXL document representing a query
+//
+//---------------------------------------------------------------------------
+CQueryToDXLResult *
+CDXLUtils::PdxlnParseBinaryDXLQuery
+	(
+	IMemoryPool *pmp,
+	const BYTE *pba,
+	ULONG ulLength
+	)
+{
+	CAutoP<CParseHandlerDXL> a_pphdxl(PphdxlParseBinaryDXL(pmp, pba, ulLength));
+
+	CDXLNode *pdxlnRoot = a_pphdxl->PdxlnQuery();
+	GPOS_ASSERT(NULL != pdxlnRoot);
+
+#ifdef GPOS_DEBUG
+	pdxlnRoot->Pdxlop()->AssertValid(pdxlnRoot, true /* fValidateChildren */);
+#endif
+
+	pdxlnRoot->AddRef();
+
+	DrgPdxln *pdrgpdxlnQO = a_pphdxl->PdrgpdxlnOutputCols();
+	GPOS_ASSERT(NULL != pdrgpdxlnQO);
+	pdrgpdxlnQO->AddRef();
+
+	DrgPdxln *pdrgpdxlnCTE = a_pphdxl->PdrgpdxlnCTE();
+	GPOS_ASSERT(NULL != pdrgpdxlnCTE);
+	pdrgpdxlnCTE->AddRef();
+
+	return GPOS_NEW(pmp) CQueryToDXLResult(pdxlnRoot, pdrgpdxlnQO, pdrgpdxlnCTE);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::PdrgpmdobjParseBinaryDXL
+//
+//	@doc:
+//		Parse a list of metadata objects from a binary DXL document
+//
+//---------------------------------------------------------------------------
+DrgPimdobj *
+CDXLUtils::PdrgpmdobjParseBinaryDXL
+	(
+	IMemoryPool *pmp,
+	const BYTE *pba,
+	ULONG ulLength
+	)
+{
+	CAutoP<CParseHandlerDXL> a_pphdxl(PphdxlParseBinaryDXL(pmp, pba, ulLength));
+
+	DrgPimdobj *pdrgpmdobj = a_pphdxl->Pdrgpmdobj();
+	pdrgpmdobj->AddRef();
+
+	return pdrgpmdobj;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLUtils::PmdidParseDXL
@@ -851,27 +963,10 @@ CDXLUtils::ValidateDXL
 		// we need to disable OOM simulation here, otherwise xerces throws ABORT signal
 		CAutoTraceFlag atf(EtraceSimulateOOM, false);
 		CAutoTraceFlag atf2(EtraceSimulateAbort, false);
-		pxmlreader = XMLReaderFactory::createXMLReader(pmm);
+		pxmlreader = CDXLGrammarCache::PxmlreaderCreate(pmm, szXSDPath);
 		GPOS_CHECK_ABORT;
 	}
 	
-	// setup XSD validation
-	pxmlreader->setFeature(XMLUni::fgSAX2CoreValidation, true);
-	pxmlreader->setFeature(XMLUni::fgXercesDynamic, false);
-	pxmlreader->setFeature(XMLUni::fgSAX2CoreNameSpaces, true);
-	pxmlreader->setFeature(XMLUni::fgXercesSchema, true);
-	
-	pxmlreader->setFeature(XMLUni::fgXercesSchemaFullChecking, true);
-	pxmlreader->setFeature(XMLUni::fgSAX2CoreNameSpacePrefixes, true);
-	
-	{
-		CAutoTraceFlag atf(EtraceSimulateOOM, false);
-
-		CAutoP<XMLCh> a_xmlszXSDPath;
-		a_xmlszXSDPath = XMLString::transcode(szXSDPath, pmm);
-		pxmlreader->setProperty(XMLUni::fgXercesSchemaExternalSchemaLocation, (void*) a_xmlszXSDPath.Pt());
-	}
-	
 	CParseHandlerDummy phdummy(pmm);
 	pxmlreader->setContentHandler(&phdummy);
 	pxmlreader->setErrorHandler(&phdummy);
@@ -918,6 +1013,52 @@ CDXLUtils::ValidateDXL
 	delete pmbis;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::PvValidateDXL
+//
+//	@doc:
+//		Task validating a DXL document against an XSD schema, for
+//		diagnostics that need not hold up parsing the document; records
+//		whether the document is valid instead of raising an exception.
+//		The task uses its own memory pool.
+//
+//---------------------------------------------------------------------------
+void *
+CDXLUtils::PvValidateDXL
+	(
+	void *pv
+	)
+{
+	GPOS_ASSERT(NULL != pv);
+
+	SValidateDXLArg *parg = reinterpret_cast<SValidateDXLArg *>(pv);
+	parg->m_fValid = false;
+
+	// a failed validation does not release all Xerces objects; these go
+	// away with the task's own memory pool
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcNone);
+
+	GPOS_TRY
+	{
+		ValidateDXL(amp.Pmp(), parg->m_szDXL, parg->m_szXSDPath);
+		parg->m_fValid = true;
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		if (!GPOS_MATCH_EX(ex, gpdxl::ExmaDXL, gpdxl::ExmiDXLValidationError) &&
+			!GPOS_MATCH_EX(ex, gpdxl::ExmaDXL, gpdxl::ExmiDXLXercesParseError))
+		{
+			GPOS_RETHROW(ex);
+		}
+
+		GPOS_RESET_EX;
+	}
+	GPOS_CATCH_END;
+
+	return NULL;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLUtils::SerializeQuery
@@ -945,41 +1086,7 @@ CDXLUtils::SerializeQuery
 
 	CXMLSerializer xmlser(pmp, os, fIndent);
 
-	if (fSerializeHeaderFooter)
-	{
-		SerializeHeader(pmp, &xmlser);
-	}
-	
-	xmlser.OpenElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenQuery));
-
-	// serialize the query output columns
-	xmlser.OpenElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenQueryOutput));
-	for (ULONG ul = 0; ul < pdrgpdxlnQueryOutput->UlLength(); ++ul)
-	{
-		CDXLNode *pdxlnScId = (*pdrgpdxlnQueryOutput)[ul];
-		pdxlnScId->SerializeToDXL(&xmlser);
-	}
-	xmlser.CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenQueryOutput));
-
-	// serialize the CTE list
-	xmlser.OpenElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenCTEList));
-	const ULONG ulCTEs = pdrgpdxlnCTE->UlLength();
-	for (ULONG ul = 0; ul < ulCTEs; ++ul)
-	{
-		CDXLNode *pdxlnCTE = (*pdrgpdxlnCTE)[ul];
-		pdxlnCTE->SerializeToDXL(&xmlser);
-	}
-	xmlser.CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenCTEList));
-
-	
-	pdxlnQuery->SerializeToDXL(&xmlser);
-
-	xmlser.CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenQuery));
-	
-	if (fSerializeHeaderFooter)
-	{
-		SerializeFooter(&xmlser);
-	}
+	SerializeQuery(pmp, &xmlser, pdxlnQuery, pdrgpdxlnQueryOutput, pdrgpdxlnCTE, fSerializeHeaderFooter);
 }
 
 
@@ -1037,27 +1144,38 @@ CDXLUtils::SerializePlan
 	CAutoTimer at("\n[OPT]: DXL Plan Serialization Time", GPOS_FTRACE(EopttracePrintOptimizationStatistics));
 
 	CXMLSerializer xmlser(pmp, os, fIndent);
-	
-	if (fSerializeHeaderFooter)
-	{
-		SerializeHeader(pmp, &xmlser);
-	}
-	
-	xmlser.OpenElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenPlan));
-
-	// serialize plan id and space size attributes
 
-	xmlser.AddAttribute(CDXLTokens::PstrToken(EdxltokenPlanId), ullPlanId);
-	xmlser.AddAttribute(CDXLTokens::PstrToken(EdxltokenPlanSpaceSize), ullPlanSpaceSize);
+	SerializePlan(pmp, &xmlser, pdxln, ullPlanId, ullPlanSpaceSize, fSerializeHeaderFooter);
+}
 
-	pdxln->SerializeToDXL(&xmlser);
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::SerializePlan
+//
+//	@doc:
+//		Serialize a DXL tree into a DXL document encoded in UTF-8, handing
+//		the document to the given sink in chunks of bounded size as it is
+//		written
+//
+//---------------------------------------------------------------------------
+void
+CDXLUtils::SerializePlan
+	(
+	IMemoryPool *pmp,
+	PfDXLSink *pfsink,
+	void *pvSinkArg,
+	const CDXLNode *pdxln,
+	ULLONG ullPlanId,
+	ULLONG ullPlanSpaceSize,
+	BOOL fSerializeHeaderFooter,
+	BOOL fIndent
+	)
+{
+	GPOS_ASSERT(NULL != pfsink);
 
-	xmlser.CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenPlan));
-	
-	if (fSerializeHeaderFooter)
-	{
-		SerializeFooter(&xmlser);
-	}
+	CDXLSinkStream os(pmp, pfsink, pvSinkArg);
+	SerializePlan(pmp, os, pdxln, ullPlanId, ullPlanSpaceSize, fSerializeHeaderFooter, fIndent);
+	os.Flush();
 }
 
 //---------------------------------------------------------------------------
@@ -1084,28 +1202,7 @@ CDXLUtils::SerializeMetadata
 
 	CXMLSerializer xmlser(pmp, os, fIndent);
 
-	if (fSerializeHeaderFooter)
-	{
-		SerializeHeader(pmp, &xmlser);
-	}
-	
-	xmlser.OpenElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenMetadata));
-
-
-	for (ULONG ul = 0; ul < pdrgpmdobj->UlLength(); ul++)
-	{
-		IMDCacheObject *pimdobj = (*pdrgpmdobj)[ul];
-		pimdobj->Serialize(&xmlser);
-	}
-
-	xmlser.CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenMetadata));
-
-	if (fSerializeHeaderFooter)
-	{
-		SerializeFooter(&xmlser);
-	}
-	
-	return;
+	SerializeMetadata(pmp, &xmlser, pdrgpmdobj, fSerializeHeaderFooter);
 }
 
 //---------------------------------------------------------------------------
@@ -1199,6 +1296,7 @@ CDXLUtils::SerializeOptimizerConfig
 	xmlser.AddAttribute(CDXLTokens::PstrToken(EdxltokenDampingFactorFilter), pstatsconf->DDampingFactorFilter());
 	xmlser.AddAttribute(CDXLTokens::PstrToken(EdxltokenDampingFactorJoin), pstatsconf->DDampingFactorJoin());
 	xmlser.AddAttribute(CDXLTokens::PstrToken(EdxltokenDampingFactorGroupBy), pstatsconf->DDampingFactorGroupBy());
+	xmlser.AddAttribute(CDXLTokens::PstrToken(EdxltokenMaxHistogramBuckets), pstatsconf->UlMaxHistogramBuckets());
 	xmlser.CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenStatisticsConfig));
 
 	xmlser.OpenElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenCTEConfig));
@@ -1595,6 +1693,230 @@ CDXLUtils::PstrSerializeScalarExpr
 	return pstr;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::SerializeQuery
+//
+//	@doc:
+//		Serialize a DXL Query tree using the given serializer
+//
+//---------------------------------------------------------------------------
+void
+CDXLUtils::SerializeQuery
+	(
+	IMemoryPool *pmp,
+	CXMLSerializer *pxmlser,
+	const CDXLNode *pdxlnQuery,
+	const DrgPdxln *pdrgpdxlnQueryOutput,
+	const DrgPdxln *pdrgpdxlnCTE,
+	BOOL fSerializeHeaderFooter
+	)
+{
+	GPOS_ASSERT(NULL != pxmlser);
+
+	if (fSerializeHeaderFooter)
+	{
+		SerializeHeader(pmp, pxmlser);
+	}
+	
+	pxmlser->OpenElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenQuery));
+
+	// serialize the query output columns
+	pxmlser->OpenElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenQueryOutput));
+	for (ULONG ul = 0; ul < pdrgpdxlnQueryOutput->UlLength(); ++ul)
+	{
+		CDXLNode *pdxlnScId = (*pdrgpdxlnQueryOutput)[ul];
+		pdxlnScId->SerializeToDXL(pxmlser);
+	}
+	pxmlser->CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenQueryOutput));
+
+	// serialize the CTE list
+	pxmlser->OpenElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenCTEList));
+	const ULONG ulCTEs = pdrgpdxlnCTE->UlLength();
+	for (ULONG ul = 0; ul < ulCTEs; ++ul)
+	{
+		CDXLNode *pdxlnCTE = (*pdrgpdxlnCTE)[ul];
+		pdxlnCTE->SerializeToDXL(pxmlser);
+	}
+	pxmlser->CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenCTEList));
+
+	
+	pdxlnQuery->SerializeToDXL(pxmlser);
+
+	pxmlser->CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenQuery));
+	
+	if (fSerializeHeaderFooter)
+	{
+		SerializeFooter(pxmlser);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::SerializePlan
+//
+//	@doc:
+//		Serialize a DXL plan tree using the given serializer
+//
+//---------------------------------------------------------------------------
+void
+CDXLUtils::SerializePlan
+	(
+	IMemoryPool *pmp,
+	CXMLSerializer *pxmlser,
+	const CDXLNode *pdxln,
+	ULLONG ullPlanId,
+	ULLONG ullPlanSpaceSize,
+	BOOL fSerializeHeaderFooter
+	)
+{
+	GPOS_ASSERT(NULL != pxmlser);
+
+	if (fSerializeHeaderFooter)
+	{
+		SerializeHeader(pmp, pxmlser);
+	}
+	
+	pxmlser->OpenElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenPlan));
+
+	// serialize plan id and space size attributes
+
+	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenPlanId), ullPlanId);
+	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenPlanSpaceSize), ullPlanSpaceSize);
+
+	pdxln->SerializeToDXL(pxmlser);
+
+	pxmlser->CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenPlan));
+	
+	if (fSerializeHeaderFooter)
+	{
+		SerializeFooter(pxmlser);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::SerializeMetadata
+//
+//	@doc:
+//		Serialize a list of MD objects using the given serializer
+//
+//---------------------------------------------------------------------------
+void
+CDXLUtils::SerializeMetadata
+	(
+	IMemoryPool *pmp,
+	CXMLSerializer *pxmlser,
+	const DrgPimdobj *pdrgpmdobj,
+	BOOL fSerializeHeaderFooter
+	)
+{
+	GPOS_ASSERT(NULL != pxmlser);
+
+	if (fSerializeHeaderFooter)
+	{
+		SerializeHeader(pmp, pxmlser);
+	}
+	
+	pxmlser->OpenElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenMetadata));
+
+
+	for (ULONG ul = 0; ul < pdrgpmdobj->UlLength(); ul++)
+	{
+		IMDCacheObject *pimdobj = (*pdrgpmdobj)[ul];
+		pimdobj->Serialize(pxmlser);
+	}
+
+	pxmlser->CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenMetadata));
+
+	if (fSerializeHeaderFooter)
+	{
+		SerializeFooter(pxmlser);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::PbaSerializeQuery
+//
+//	@doc:
+//		Serialize a DXL Query tree into a binary DXL document; the caller
+//		owns the returned array
+//
+//---------------------------------------------------------------------------
+BYTE *
+CDXLUtils::PbaSerializeQuery
+	(
+	IMemoryPool *pmp,
+	const CDXLNode *pdxlnQuery,
+	const DrgPdxln *pdrgpdxlnQueryOutput,
+	const DrgPdxln *pdrgpdxlnCTE,
+	ULONG *pulLength
+	)
+{
+	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(NULL != pdxlnQuery && NULL != pdrgpdxlnQueryOutput);
+
+	CDXLBinarySerializer binser(pmp);
+	SerializeQuery(pmp, &binser, pdxlnQuery, pdrgpdxlnQueryOutput, pdrgpdxlnCTE, true /*fSerializeHeaderFooter*/);
+
+	return binser.PbaDocument(pulLength);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::PbaSerializePlan
+//
+//	@doc:
+//		Serialize a DXL plan tree into a binary DXL document; the caller
+//		owns the returned array
+//
+//---------------------------------------------------------------------------
+BYTE *
+CDXLUtils::PbaSerializePlan
+	(
+	IMemoryPool *pmp,
+	const CDXLNode *pdxln,
+	ULLONG ullPlanId,
+	ULLONG ullPlanSpaceSize,
+	ULONG *pulLength
+	)
+{
+	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(NULL != pdxln);
+
+	CDXLBinarySerializer binser(pmp);
+	SerializePlan(pmp, &binser, pdxln, ullPlanId, ullPlanSpaceSize, true /*fSerializeHeaderFooter*/);
+
+	return binser.PbaDocument(pulLength);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::PbaSerializeMetadata
+//
+//	@doc:
+//		Serialize a list of MD objects into a binary DXL document; the
+//		caller owns the returned array
+//
+//---------------------------------------------------------------------------
+BYTE *
+CDXLUtils::PbaSerializeMetadata
+	(
+	IMemoryPool *pmp,
+	const DrgPimdobj *pdrgpmdobj,
+	ULONG *pulLength
+	)
+{
+	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(NULL != pdrgpmdobj);
+
+	CDXLBinarySerializer binser(pmp);
+	SerializeMetadata(pmp, &binser, pdrgpmdobj, true /*fSerializeHeaderFooter*/);
+
+	return binser.PbaDocument(pulLength);
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLUtils::SerializeHeader
@@ -1648,6 +1970,62 @@ CDXLUtils::SerializeFooter
 	pxmlser->CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenDXLMessage));
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::WszFromXMLCh
+//
+//	@doc:
+//		Decode a Xerces UTF-16 string into a null-terminated wide character
+//		array allocated in the given memory pool. Surrogate pairs are combined
+//		where wide characters hold full code points; unpaired surrogates are
+//		replaced by U+FFFD. The number of decoded characters is returned in
+//		the optional output argument.
+//
+//---------------------------------------------------------------------------
+WCHAR *
+CDXLUtils::WszFromXMLCh
+	(
+	IMemoryPool *pmp,
+	const XMLCh *xmlsz,
+	ULONG *pulLength
+	)
+{
+	GPOS_ASSERT(NULL != xmlsz);
+
+	// a code point never takes more wide characters than UTF-16 code units
+	const ULONG ulUnits = (ULONG) XMLString::stringLen(xmlsz);
+	WCHAR *wsz = GPOS_NEW_ARRAY(pmp, WCHAR, ulUnits + 1);
+
+	ULONG ulChars = 0;
+	for (ULONG ul = 0; ul < ulUnits; ul++)
+	{
+		ULONG ulCodePoint = (ULONG) xmlsz[ul];
+		if (GPOS_SIZEOF(WCHAR) > 2 && 0xD800 <= ulCodePoint && 0xDFFF >= ulCodePoint)
+		{
+			ULONG ulLow = (ul + 1 < ulUnits) ? (ULONG) xmlsz[ul + 1] : 0;
+			if (0xDBFF >= ulCodePoint && 0xDC00 <= ulLow && 0xDFFF >= ulLow)
+			{
+				ulCodePoint = 0x10000 + ((ulCodePoint - 0xD800) << 10) + (ulLow - 0xDC00);
+				ul++;
+			}
+			else
+			{
+				ulCodePoint = 0xFFFD;
+			}
+		}
+
+		wsz[ulChars++] = (WCHAR) ulCodePoint;
+	}
+	wsz[ulChars] = WCHAR_EOS;
+
+	if (NULL != pulLength)
+	{
+		*pulLength = ulChars;
+	}
+
+	return wsz;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLUtils::PstrFromXMLCh
@@ -1669,19 +2047,14 @@ CDXLUtils::PstrFromXMLCh
 	GPOS_ASSERT(NULL != xmlsz);
 	
 	IMemoryPool *pmp = pmm->Pmp();
-	
-	{
-		CAutoTraceFlag atf(EtraceSimulateOOM, false);
-		CHAR *sz = XMLString::transcode(xmlsz, pmm);
 
-		CWStringDynamic *pstr = GPOS_NEW(pmp) CWStringDynamic(pmp);
-		pstr->AppendFormat(GPOS_WSZ_LIT("%s"), sz);
-	
-		// cleanup temporary buffer
-		XMLString::release(&sz, pmm);
-	
-		return pstr;
-	}
+	CAutoRg<WCHAR> a_wsz;
+	a_wsz = WszFromXMLCh(pmp, xmlsz);
+
+	CWStringDynamic *pstr = GPOS_NEW(pmp) CWStringDynamic(pmp);
+	pstr->AppendWideCharArray(a_wsz.Rgt());
+
+	return pstr;
 }
 
 
@@ -1801,12 +2174,21 @@ CDXLUtils::PmdnameFromXmlsz
 {
 	GPOS_ASSERT(NULL != xmlsz);
 	
-	CHAR *sz = XMLString::transcode(xmlsz, pmm);
-	CMDName *pmdname = PmdnameFromSz(pmm->Pmp(), sz);
-	
-	// cleanup temporary buffer
-	XMLString::release(&sz, pmm);
-	
+	IMemoryPool *pmp = pmm->Pmp();
+
+	// decode the name straight into wide characters, avoiding the detour
+	// through the multi-byte encoding of the current locale; the name
+	// string takes over the decoded buffer
+	ULONG ulLength = 0;
+	CAutoRg<WCHAR> a_wsz;
+	a_wsz = WszFromXMLCh(pmp, xmlsz, &ulLength);
+
+	CAutoP<CWStringConst> a_pstr(GPOS_NEW(pmp) CWStringConst(a_wsz.Rgt(), ulLength));
+	(void) a_wsz.RgtReset();
+
+	CMDName *pmdname = GPOS_NEW(pmp) CMDName(a_pstr.Pt(), true /*fOwnsMemory*/);
+	(void) a_pstr.PtReset();
+
 	return pmdname;
 }
 
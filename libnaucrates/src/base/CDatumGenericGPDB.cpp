@@ -592,6 +592,122 @@ CDatumGenericGPDB::DTrailingWildcardSelectivity
 	return CDouble(1.0);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDatumGenericGPDB::UlNextChar
+//
+//	@doc:
+//		Return the position of the character following the one at the given
+//		position, skipping the continuation bytes of multi-byte UTF-8
+//		characters
+//
+//---------------------------------------------------------------------------
+ULONG
+CDatumGenericGPDB::UlNextChar
+	(
+	const BYTE *pba,
+	ULONG ulLen,
+	ULONG ulPos
+	)
+{
+	ulPos++;
+	while (ulPos < ulLen && 0x80 == (pba[ulPos] & 0xC0))
+	{
+		ulPos++;
+	}
+
+	return ulPos;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDatumGenericGPDB::FLikeMatch
+//
+//	@doc:
+//		Does the datum match the given LIKE pattern; % matches any sequence
+//		of characters, _ any single character, and a backslash quotes the
+//		next pattern character
+//
+//---------------------------------------------------------------------------
+BOOL
+CDatumGenericGPDB::FLikeMatch
+	(
+	const IDatum *pdatumPattern
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pdatumPattern);
+
+	if (FNull() || pdatumPattern->FNull())
+	{
+		return false;
+	}
+
+	const BYTE *pba = this->PbaVal();
+	const ULONG ulLen = this->UlSize();
+	const BYTE *pbaPattern = pdatumPattern->PbaVal();
+	const ULONG ulLenPattern = pdatumPattern->UlSize();
+
+	ULONG ulPos = GPDB_DATUM_HDRSZ;
+	ULONG ulPosPattern = GPDB_DATUM_HDRSZ;
+
+	// positions to resume from when the characters after the last % fail to match
+	ULONG ulPosPatternWildcard = ULONG_MAX;
+	ULONG ulPosWildcard = 0;
+
+	while (ulPos < ulLen)
+	{
+		if (ulPosPattern < ulLenPattern && '%' == pbaPattern[ulPosPattern])
+		{
+			ulPosPattern++;
+			ulPosPatternWildcard = ulPosPattern;
+			ulPosWildcard = ulPos;
+			continue;
+		}
+
+		if (ulPosPattern < ulLenPattern && '_' == pbaPattern[ulPosPattern])
+		{
+			ulPosPattern++;
+			ulPos = UlNextChar(pba, ulLen, ulPos);
+			continue;
+		}
+
+		if (ulPosPattern < ulLenPattern)
+		{
+			ULONG ulPosLiteral = ulPosPattern;
+			if ('\\' == pbaPattern[ulPosLiteral] && ulPosLiteral + 1 < ulLenPattern)
+			{
+				ulPosLiteral++;
+			}
+
+			if (pbaPattern[ulPosLiteral] == pba[ulPos])
+			{
+				ulPosPattern = ulPosLiteral + 1;
+				ulPos++;
+				continue;
+			}
+		}
+
+		if (ULONG_MAX == ulPosPatternWildcard)
+		{
+			return false;
+		}
+
+		// let the last % absorb one more character
+		ulPosWildcard = UlNextChar(pba, ulLen, ulPosWildcard);
+		ulPos = ulPosWildcard;
+		ulPosPattern = ulPosPatternWildcard;
+	}
+
+	// the rest of the pattern must match the empty string
+	while (ulPosPattern < ulLenPattern && '%' == pbaPattern[ulPosPattern])
+	{
+		ulPosPattern++;
+	}
+
+	return ulPosPattern == ulLenPattern;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDatumGenericGPDB::FStatsEqualBinary
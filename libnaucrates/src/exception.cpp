@@ -235,7 +235,13 @@ gpdxl::EresExceptionInit
 					CException::ExsevError,
 					GPOS_WSZ_WSZLEN("Invalid comparison type code. Valid values are Eq, NEq, LT, LEq, GT, GEq."),
 					0,
-					GPOS_WSZ_WSZLEN("Invalid comparison type code. Valid values are Eq, NEq, LT, LEq, GT, GEq."))
+					GPOS_WSZ_WSZLEN("Invalid comparison type code. Valid values are Eq, NEq, LT, LEq, GT, GEq.")),
+
+			CMessage(CException(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError),
+					CException::ExsevError,
+					GPOS_WSZ_WSZLEN("Malformed binary DXL document"),
+					0,
+					GPOS_WSZ_WSZLEN("Malformed binary DXL document"))
 
 	};
 
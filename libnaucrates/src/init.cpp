@@ -14,6 +14,7 @@
 
 #include "naucrates/exception.h"
 #include "naucrates/init.h"
+#include "naucrates/dxl/xml/CDXLGrammarCache.h"
 #include "naucrates/dxl/xml/CDXLMemoryManager.h"
 #include "naucrates/dxl/xml/dxltokens.h"
 #include "naucrates/dxl/parser/CParseHandlerFactory.h"
@@ -81,6 +82,9 @@ void InitDXL()
 
 	// initialize parse handler mappings
 	CParseHandlerFactory::Init(pmpDXL);
+
+	// initialize cache of compiled schemas
+	CDXLGrammarCache::Init(pmpDXL);
 }
 
 
@@ -104,6 +108,9 @@ void ShutdownDXL()
 
 	GPOS_ASSERT(NULL != pmpXerces);
 
+	// compiled schemas are Xerces objects
+	CDXLGrammarCache::Terminate();
+
 	XMLPlatformUtils::Terminate();
 
 	CDXLTokens::Terminate();
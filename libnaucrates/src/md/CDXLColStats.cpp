@@ -42,7 +42,8 @@ CDXLColStats::CDXLColStats
 	CDouble dDistinctRemain,
 	CDouble dFreqRemain,
 	DrgPdxlbucket *pdrgpdxlbucket,
-	BOOL fColStatsMissing
+	BOOL fColStatsMissing,
+	CDXLHLLSketch *pdxlhllsketch
 	)
 	:
 	m_pmp(pmp),
@@ -53,7 +54,8 @@ CDXLColStats::CDXLColStats
 	m_dDistinctRemain(dDistinctRemain),
 	m_dFreqRemain(dFreqRemain),
 	m_pdrgpdxlbucket(pdrgpdxlbucket),
-	m_fColStatsMissing(fColStatsMissing)
+	m_fColStatsMissing(fColStatsMissing),
+	m_pdxlhllsketch(pdxlhllsketch)
 {
 	GPOS_ASSERT(pmdidColStats->FValid());
 	GPOS_ASSERT(NULL != pdrgpdxlbucket);
@@ -74,6 +76,7 @@ CDXLColStats::~CDXLColStats()
 	GPOS_DELETE(m_pstr);
 	m_pmdidColStats->Release();
 	m_pdrgpdxlbucket->Release();
+	CRefCount::SafeRelease(m_pdxlhllsketch);
 }
 
 //---------------------------------------------------------------------------
@@ -187,6 +190,11 @@ CDXLColStats::Serialize
 
 		GPOS_CHECK_ABORT;
 	}
+
+	if (NULL != m_pdxlhllsketch)
+	{
+		m_pdxlhllsketch->Serialize(pxmlser);
+	}
 	
 	pxmlser->CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), 
 						CDXLTokens::PstrToken(EdxltokenColumnStats));
@@ -221,6 +229,11 @@ CDXLColStats::DebugPrint
 		const CDXLBucket *pdxlbucket = Pdxlbucket(ul);
 		pdxlbucket->DebugPrint(os);
 	}
+
+	if (NULL != m_pdxlhllsketch)
+	{
+		m_pdxlhllsketch->DebugPrint(os);
+	}
 }
 
 #endif // GPOS_DEBUG
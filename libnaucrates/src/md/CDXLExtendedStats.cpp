@@ -0,0 +1,122 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CDXLExtendedStats.cpp
+//
+//	@doc:
+//		Implementation of the class for representing multi-column statistics
+//		in DXL relation stats
+//---------------------------------------------------------------------------
+
+#include "gpos/string/CWStringDynamic.h"
+
+#include "naucrates/md/CDXLExtendedStats.h"
+#include "naucrates/dxl/xml/CXMLSerializer.h"
+#include "naucrates/dxl/CDXLUtils.h"
+
+using namespace gpdxl;
+using namespace gpmd;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtendedStats::CDXLExtendedStats
+//
+//	@doc:
+//		Constructor
+//
+//---------------------------------------------------------------------------
+CDXLExtendedStats::CDXLExtendedStats
+	(
+	IMemoryPool *pmp,
+	DrgPi *pdrgpiAttno,
+	CDouble dDistinct,
+	CDouble dDependency
+	)
+	:
+	m_pmp(pmp),
+	m_pdrgpiAttno(pdrgpiAttno),
+	m_dDistinct(dDistinct),
+	m_dDependency(dDependency)
+{
+	GPOS_ASSERT(NULL != pdrgpiAttno);
+	GPOS_ASSERT(1 < pdrgpiAttno->UlLength());
+	GPOS_ASSERT(m_dDistinct >= 0.0);
+	GPOS_ASSERT(m_dDependency >= 0.0 && m_dDependency <= 1.0);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtendedStats::~CDXLExtendedStats
+//
+//	@doc:
+//		Destructor
+//
+//---------------------------------------------------------------------------
+CDXLExtendedStats::~CDXLExtendedStats()
+{
+	m_pdrgpiAttno->Release();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtendedStats::Serialize
+//
+//	@doc:
+//		Serialize extended stats in DXL format
+//
+//---------------------------------------------------------------------------
+void
+CDXLExtendedStats::Serialize
+	(
+	CXMLSerializer *pxmlser
+	)
+	const
+{
+	pxmlser->OpenElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix),
+						CDXLTokens::PstrToken(EdxltokenExtendedStats));
+
+	CWStringDynamic *pstrAttnos = CDXLUtils::PstrSerialize(m_pmp, m_pdrgpiAttno);
+	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenColumns), pstrAttnos);
+	GPOS_DELETE(pstrAttnos);
+
+	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenStatsDistinct), m_dDistinct);
+	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenStatsDependencyDegree), m_dDependency);
+
+	pxmlser->CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix),
+						CDXLTokens::PstrToken(EdxltokenExtendedStats));
+}
+
+#ifdef GPOS_DEBUG
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLExtendedStats::DebugPrint
+//
+//	@doc:
+//		Debug print of the extended stats object
+//
+//---------------------------------------------------------------------------
+void
+CDXLExtendedStats::DebugPrint
+	(
+	IOstream &os
+	)
+	const
+{
+	os << "Columns: (";
+	const ULONG ulCols = m_pdrgpiAttno->UlLength();
+	for (ULONG ul = 0; ul < ulCols; ul++)
+	{
+		if (0 < ul)
+		{
+			os << ", ";
+		}
+		os << *(*m_pdrgpiAttno)[ul];
+	}
+	os << "), Distinct: " << m_dDistinct << ", Dependency: " << m_dDependency << std::endl;
+}
+
+#endif // GPOS_DEBUG
+
+// EOF
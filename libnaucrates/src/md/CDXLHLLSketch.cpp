@@ -0,0 +1,102 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CDXLHLLSketch.cpp
+//
+//	@doc:
+//		Implementation of the class for representing a HyperLogLog sketch
+//		in DXL column stats
+//---------------------------------------------------------------------------
+
+#include "naucrates/md/CDXLHLLSketch.h"
+#include "naucrates/dxl/xml/CXMLSerializer.h"
+#include "naucrates/dxl/xml/dxltokens.h"
+
+using namespace gpdxl;
+using namespace gpmd;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLHLLSketch::CDXLHLLSketch
+//
+//	@doc:
+//		Constructor
+//
+//---------------------------------------------------------------------------
+CDXLHLLSketch::CDXLHLLSketch
+	(
+	ULONG ulPrecision,
+	BYTE *pbaRegisters,
+	ULONG ulRegisters
+	)
+	:
+	m_ulPrecision(ulPrecision),
+	m_pbaRegisters(pbaRegisters),
+	m_ulRegisters(ulRegisters)
+{
+	GPOS_ASSERT(NULL != pbaRegisters);
+	GPOS_ASSERT((ULONG(1) << ulPrecision) == ulRegisters);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLHLLSketch::~CDXLHLLSketch
+//
+//	@doc:
+//		Destructor
+//
+//---------------------------------------------------------------------------
+CDXLHLLSketch::~CDXLHLLSketch()
+{
+	GPOS_DELETE_ARRAY(m_pbaRegisters);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLHLLSketch::Serialize
+//
+//	@doc:
+//		Serialize sketch in DXL format; registers are Base64 encoded
+//
+//---------------------------------------------------------------------------
+void
+CDXLHLLSketch::Serialize
+	(
+	CXMLSerializer *pxmlser
+	)
+	const
+{
+	pxmlser->OpenElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix),
+						CDXLTokens::PstrToken(EdxltokenHLLSketch));
+
+	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenHLLPrecision), m_ulPrecision);
+	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenHLLRegisters), false /*fNull*/, m_pbaRegisters, m_ulRegisters);
+
+	pxmlser->CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix),
+						CDXLTokens::PstrToken(EdxltokenHLLSketch));
+}
+
+#ifdef GPOS_DEBUG
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLHLLSketch::DebugPrint
+//
+//	@doc:
+//		Debug print of the sketch
+//
+//---------------------------------------------------------------------------
+void
+CDXLHLLSketch::DebugPrint
+	(
+	IOstream &os
+	)
+	const
+{
+	os << "HLL sketch: precision " << m_ulPrecision << ", " << m_ulRegisters << " registers" << std::endl;
+}
+
+#endif // GPOS_DEBUG
+
+// EOF
@@ -26,7 +26,8 @@ using namespace gpmd;
 //		CDXLRelStats::CDXLRelStats
 //
 //	@doc:
-//		Constructs a metadata relation
+//		Constructs a metadata relation; relation stats without multi-column
+//		statistics can be created by passing a NULL array
 //
 //---------------------------------------------------------------------------
 CDXLRelStats::CDXLRelStats
@@ -35,16 +36,22 @@ CDXLRelStats::CDXLRelStats
 	CMDIdRelStats *pmdidRelStats,
 	CMDName *pmdname,
 	CDouble dRows,
-	BOOL fEmpty
+	BOOL fEmpty,
+	DrgPdxlextstats *pdrgpdxlextstats
 	)
 	:
 	m_pmp(pmp),
 	m_pmdidRelStats(pmdidRelStats),
 	m_pmdname(pmdname),
 	m_dRows(dRows),
-	m_fEmpty(fEmpty)
+	m_fEmpty(fEmpty),
+	m_pdrgpdxlextstats(pdrgpdxlextstats)
 {
 	GPOS_ASSERT(pmdidRelStats->FValid());
+	if (NULL == m_pdrgpdxlextstats)
+	{
+		m_pdrgpdxlextstats = GPOS_NEW(m_pmp) DrgPdxlextstats(m_pmp);
+	}
 	m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
 }
 
@@ -61,6 +68,7 @@ CDXLRelStats::~CDXLRelStats()
 	GPOS_DELETE(m_pmdname);
 	GPOS_DELETE(m_pstr);
 	m_pmdidRelStats->Release();
+	m_pdrgpdxlextstats->Release();
 }
 
 //---------------------------------------------------------------------------
@@ -119,6 +127,38 @@ CDXLRelStats::DRows() const
 	return m_dRows;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLRelStats::UlExtendedStats
+//
+//	@doc:
+//		Returns the number of multi-column statistics objects
+//
+//---------------------------------------------------------------------------
+ULONG
+CDXLRelStats::UlExtendedStats() const
+{
+	return m_pdrgpdxlextstats->UlLength();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLRelStats::Pdxlextstats
+//
+//	@doc:
+//		Returns the multi-column statistics object at the given position
+//
+//---------------------------------------------------------------------------
+const CDXLExtendedStats *
+CDXLRelStats::Pdxlextstats
+	(
+	ULONG ul
+	)
+	const
+{
+	return (*m_pdrgpdxlextstats)[ul];
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLRelStats::Serialize
@@ -141,6 +181,12 @@ CDXLRelStats::Serialize
 	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenRows), m_dRows);
 	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenEmptyRelation), m_fEmpty);
 
+	const ULONG ulExtStats = m_pdrgpdxlextstats->UlLength();
+	for (ULONG ul = 0; ul < ulExtStats; ul++)
+	{
+		(*m_pdrgpdxlextstats)[ul]->Serialize(pxmlser);
+	}
+
 	pxmlser->CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), 
 						CDXLTokens::PstrToken(EdxltokenRelationStats));
 
@@ -174,6 +220,12 @@ CDXLRelStats::DebugPrint
 	os << "Rows: " << DRows() << std::endl;
 
 	os << "Empty: " << FEmpty() << std::endl;
+
+	const ULONG ulExtStats = m_pdrgpdxlextstats->UlLength();
+	for (ULONG ul = 0; ul < ulExtStats; ul++)
+	{
+		(*m_pdrgpdxlextstats)[ul]->DebugPrint(os);
+	}
 }
 
 #endif // GPOS_DEBUG
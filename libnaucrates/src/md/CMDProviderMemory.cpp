@@ -15,6 +15,7 @@
 #include "gpos/task/CWorker.h"
 #include "gpos/common/CAutoP.h"
 #include "gpos/common/CAutoRef.h"
+#include "gpos/common/CAutoRg.h"
 #include "gpos/error/CAutoTrace.h"
 
 #include "naucrates/md/CMDProviderMemory.h"
@@ -118,19 +119,34 @@ CMDProviderMemory::LoadMetadataObjectsFromArray
 		pmdidKey->AddRef();
 		CAutoRef<IMDId> a_pmdidKey;
 		a_pmdidKey = pmdidKey;
-		
+
+		// keep the DXL string for callers asking for it, and the binary DXL
+		// document for building copies of the object without parsing DXL
+		CAutoRef<DrgPimdobj> a_pdrgpmdobjSingle;
+		a_pdrgpmdobjSingle = GPOS_NEW(pmp) DrgPimdobj(pmp);
+		pmdobj->AddRef();
+		a_pdrgpmdobjSingle->Append(pmdobj);
+
+		ULONG ulLength = 0;
+		CAutoRg<BYTE> a_pba;
+		a_pba = CDXLUtils::PbaSerializeMetadata(pmp, a_pdrgpmdobjSingle.Pt(), &ulLength);
+
 		CAutoP<CWStringDynamic> a_pstr;
 		a_pstr = CDXLUtils::PstrSerializeMDObj(pmp, pmdobj, true /*fSerializeHeaders*/, false /*findent*/);
-		
+
+		pmdobj->AddRef();
+		CAutoP<SMDObject> a_pmdobjEntry;
+		a_pmdobjEntry = GPOS_NEW(pmp) SMDObject(pmdobj, a_pstr.PtReset(), a_pba.RgtReset(), ulLength);
+
 		GPOS_CHECK_ABORT;
-		BOOL fInserted = m_pmdmap->FInsert(pmdidKey, a_pstr.Pt());
+		BOOL fInserted = m_pmdmap->FInsert(pmdidKey, a_pmdobjEntry.Pt());
 		if (!fInserted)
 		{
 			
 			GPOS_RAISE(gpdxl::ExmaMD, gpdxl::ExmiMDCacheEntryDuplicate, pmdidKey->Wsz());
 		}
 		(void) a_pmdidKey.PtReset();
-		(void) a_pstr.PtReset();
+		(void) a_pmdobjEntry.PtReset();
 	}
 	
 	// safely completed loading
@@ -150,6 +166,49 @@ CMDProviderMemory::~CMDProviderMemory()
 	CRefCount::SafeRelease(m_pmdmap);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDProviderMemory::PimdobjDummyStats
+//
+//	@doc:
+//		Relstats and colstats are special as they may not exist in the
+//		metadata file. Provider must return dummy objects in this case.
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+CMDProviderMemory::PimdobjDummyStats
+	(
+	IMemoryPool *pmp,
+	IMDId *pmdid
+	)
+{
+	switch(pmdid->Emdidt())
+	{
+		case IMDId::EmdidRelStats:
+		{
+			pmdid->AddRef();
+			return CDXLRelStats::PdxlrelstatsDummy(pmp, pmdid);
+		}
+		case IMDId::EmdidColStats:
+		{
+			CAutoP<CWStringDynamic> a_pstr;
+			a_pstr = GPOS_NEW(pmp) CWStringDynamic(pmp, pmdid->Wsz());
+			CAutoP<CMDName> a_pmdname;
+			a_pmdname = GPOS_NEW(pmp) CMDName(pmp, a_pstr.Pt());
+			pmdid->AddRef();
+			CDXLColStats *pdxlcolstats = CDXLColStats::PdxlcolstatsDummy(pmp, pmdid, a_pmdname.Pt(), CStatistics::DDefaultColumnWidth /* dWidth */);
+			a_pmdname.PtReset();
+			return pdxlcolstats;
+		}
+		default:
+		{
+			GPOS_RAISE(gpdxl::ExmaMD, gpdxl::ExmiMDCacheEntryNotFound, pmdid->Wsz());
+		}
+	}
+
+	return NULL;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDProviderMemory::PstrObject
@@ -169,56 +228,60 @@ CMDProviderMemory::PstrObject
 {
 	GPOS_ASSERT(NULL != m_pmdmap);
 
-	const CWStringDynamic *pstrObj = m_pmdmap->PtLookup(pmdid);
-	
-	// result string
-	CAutoP<CWStringDynamic> a_pstrResult;
+	const SMDObject *pmdobjEntry = m_pmdmap->PtLookup(pmdid);
+	if (NULL != pmdobjEntry)
+	{
+		// copy string into result
+		return GPOS_NEW(pmp) CWStringDynamic(pmp, pmdobjEntry->m_pstr->Wsz());
+	}
 
-	a_pstrResult = NULL;
-	
-	if (NULL == pstrObj)
+	CAutoRef<IMDCacheObject> a_pmdobj;
+	a_pmdobj = PimdobjDummyStats(pmp, pmdid);
+
+	return CDXLUtils::PstrSerializeMDObj(pmp, a_pmdobj.Pt(), true /*fSerializeHeaders*/, false /*findent*/);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDProviderMemory::Pimdobj
+//
+//	@doc:
+//		Returns the requested object; unless the provider shares its
+//		objects, the object is restored from its binary DXL document into
+//		the provided memory pool, so that the accessor can cache it
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+CMDProviderMemory::Pimdobj
+	(
+	IMemoryPool *pmp,
+	CMDAccessor *, //pmda
+	IMDId *pmdid
+	)
+	const
+{
+	GPOS_ASSERT(NULL != m_pmdmap);
+
+	const SMDObject *pmdobjEntry = m_pmdmap->PtLookup(pmdid);
+	if (NULL == pmdobjEntry)
 	{
-		// Relstats and colstats are special as they may not
-		// exist in the metadata file. Provider must return dummy objects
-		// in this case.
-		switch(pmdid->Emdidt())
-		{
-			case IMDId::EmdidRelStats:
-			{
-				pmdid->AddRef();
-				CAutoRef<CDXLRelStats> a_pdxlrelstats;
-				a_pdxlrelstats = CDXLRelStats::PdxlrelstatsDummy(pmp, pmdid);
-				a_pstrResult = CDXLUtils::PstrSerializeMDObj(pmp, a_pdxlrelstats.Pt(), true /*fSerializeHeaders*/, false /*findent*/);
-				break;
-			}
-			case IMDId::EmdidColStats:
-			{
-				CAutoP<CWStringDynamic> a_pstr;
-				a_pstr = GPOS_NEW(pmp) CWStringDynamic(pmp, pmdid->Wsz());
-				CAutoP<CMDName> a_pmdname;
-				a_pmdname = GPOS_NEW(pmp) CMDName(pmp, a_pstr.Pt());
-				pmdid->AddRef();
-				CAutoRef<CDXLColStats> a_pdxlcolstats;
-				a_pdxlcolstats = CDXLColStats::PdxlcolstatsDummy(pmp, pmdid, a_pmdname.Pt(), CStatistics::DDefaultColumnWidth /* dWidth */);
-				a_pmdname.PtReset();
-				a_pstrResult = CDXLUtils::PstrSerializeMDObj(pmp, a_pdxlcolstats.Pt(), true /*fSerializeHeaders*/, false /*findent*/);
-				break;
-			}
-			default:
-			{
-				GPOS_RAISE(gpdxl::ExmaMD, gpdxl::ExmiMDCacheEntryNotFound, pmdid->Wsz());
-			}
-		}
+		return PimdobjDummyStats(pmp, pmdid);
 	}
-	else
+
+	if (FSharesObjects())
 	{
-		// copy string into result
-		a_pstrResult = GPOS_NEW(pmp) CWStringDynamic(pmp, pstrObj->Wsz());
+		pmdobjEntry->m_pmdobj->AddRef();
+		return pmdobjEntry->m_pmdobj;
 	}
-	
-	GPOS_ASSERT(NULL != a_pstrResult.Pt());
-	
-	return a_pstrResult.PtReset();
+
+	CAutoRef<DrgPimdobj> a_pdrgpmdobj;
+	a_pdrgpmdobj = CDXLUtils::PdrgpmdobjParseBinaryDXL(pmp, pmdobjEntry->m_pba, pmdobjEntry->m_ulLength);
+	GPOS_ASSERT(1 == a_pdrgpmdobj->UlLength());
+
+	IMDCacheObject *pmdobj = (*a_pdrgpmdobj)[0];
+	pmdobj->AddRef();
+
+	return pmdobj;
 }
 
 //---------------------------------------------------------------------------
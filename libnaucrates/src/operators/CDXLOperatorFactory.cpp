@@ -146,8 +146,22 @@ CDXLOperatorFactory::PdxlopHashJoin
 									);
 	
 	EdxlJoinType edxljt = EdxljtParseJoinType(xmlszJoinType, CDXLTokens::PstrToken(EdxltokenPhysicalHashJoin));
+
+	BOOL fRuntimeFilter = false;
+
+	const XMLCh *xmlszRuntimeFilter = attrs.getValue(CDXLTokens::XmlstrToken(EdxltokenHashJoinRuntimeFilter));
+	if (NULL != xmlszRuntimeFilter)
+	{
+		fRuntimeFilter = FValueFromXmlstr
+						(
+						pmm,
+						xmlszRuntimeFilter,
+						EdxltokenHashJoinRuntimeFilter,
+						EdxltokenPhysicalHashJoin
+						);
+	}
 	
-	return GPOS_NEW(pmp) CDXLPhysicalHashJoin(pmp, edxljt);
+	return GPOS_NEW(pmp) CDXLPhysicalHashJoin(pmp, edxljt, fRuntimeFilter);
 }
 
 //---------------------------------------------------------------------------
@@ -28,11 +28,14 @@ using namespace gpdxl;
 CDXLPhysicalHashJoin::CDXLPhysicalHashJoin
 	(
 	IMemoryPool *pmp,
-	EdxlJoinType edxljt
+	EdxlJoinType edxljt,
+	BOOL fRuntimeFilter
 	)
 	:
-	CDXLPhysicalJoin(pmp, edxljt)
+	CDXLPhysicalJoin(pmp, edxljt),
+	m_fRuntimeFilter(fRuntimeFilter)
 {
+	GPOS_ASSERT_IMP(fRuntimeFilter, EdxljtInner == edxljt || EdxljtIn == edxljt);
 }
 
 //---------------------------------------------------------------------------
@@ -85,6 +88,11 @@ CDXLPhysicalHashJoin::SerializeToDXL
 	pxmlser->OpenElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), pstrElemName);
 	
 	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenJoinType), PstrJoinTypeName());
+
+	if (m_fRuntimeFilter)
+	{
+		pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenHashJoinRuntimeFilter), m_fRuntimeFilter);
+	}
 	
 	// serialize properties
 	pdxln->SerializePropertiesToDXL(pxmlser);
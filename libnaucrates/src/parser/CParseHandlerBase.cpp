@@ -13,6 +13,7 @@
 #include "naucrates/dxl/parser/CParseHandlerBase.h"
 #include "naucrates/dxl/parser/CParseHandlerManager.h"
 #include "naucrates/dxl/xml/CDXLMemoryManager.h"
+#include "naucrates/dxl/xml/dxltokens.h"
 
 
 using namespace gpdxl;
@@ -112,7 +113,9 @@ CParseHandlerBase::ReplaceParseHandler
 //		CParseHandlerBase::startElement
 //
 //	@doc:
-//		Invoked by Xerces to process an opening tag
+//		Invoked by Xerces to process an opening tag. Element and attribute
+//		names are resolved to token strings, which the parse handlers
+//		compare with their tokens by address
 //
 //---------------------------------------------------------------------------
 void
@@ -124,7 +127,18 @@ CParseHandlerBase::startElement
 		const Attributes& attrs
 	)
 {
-	StartElement(xmlszUri, xmlszLocalname, xmlszQname, attrs);
+	GPOS_ASSERT(NULL != m_pphm);
+
+	CDXLAttributes *pdxlattrs = m_pphm->Pdxlattrs();
+	if (&attrs == pdxlattrs)
+	{
+		// element passed on by another parse handler, names are resolved
+		StartElement(xmlszUri, xmlszLocalname, xmlszQname, attrs);
+		return;
+	}
+
+	pdxlattrs->Reset(&attrs);
+	StartElement(xmlszUri, XmlszName(xmlszLocalname), xmlszQname, *pdxlattrs);
 }
 
 //---------------------------------------------------------------------------
@@ -143,7 +157,31 @@ CParseHandlerBase::endElement
 		const XMLCh* const xmlszQname
 	)
 {
-	EndElement(xmlszUri, xmlszLocalname, xmlszQname);
+	EndElement(xmlszUri, XmlszName(xmlszLocalname), xmlszQname);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerBase::XmlszName
+//
+//	@doc:
+//		Token string of an element name, or the name itself if it is not a
+//		token
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CParseHandlerBase::XmlszName
+	(
+	const XMLCh *xmlszLocalname
+	)
+{
+	Edxltoken edxltoken = CDXLTokens::EdxltokenFromXmlstr(xmlszLocalname);
+	if (EdxltokenSentinel == edxltoken)
+	{
+		return xmlszLocalname;
+	}
+
+	return CDXLTokens::XmlstrToken(edxltoken);
 }
 
 //---------------------------------------------------------------------------
@@ -14,6 +14,7 @@
 
 #include "naucrates/dxl/parser/CParseHandlerColStats.h"
 #include "naucrates/dxl/parser/CParseHandlerColStatsBucket.h"
+#include "naucrates/dxl/parser/CParseHandlerHLLSketch.h"
 #include "naucrates/dxl/parser/CParseHandlerFactory.h"
 #include "naucrates/dxl/parser/CParseHandlerManager.h"
 
@@ -127,6 +128,15 @@ CParseHandlerColStats::StartElement
 		m_pphm->ActivateParseHandler(pphStatsBucket);	
 		pphStatsBucket->startElement(xmlszUri, xmlszLocalname, xmlszQname, attrs);
 	}
+	else if (0 == XMLString::compareString(CDXLTokens::XmlstrToken(EdxltokenHLLSketch), xmlszLocalname))
+	{
+		// sketch of the column values
+		CParseHandlerBase *pphHLLSketch = CParseHandlerFactory::Pph(m_pmp, CDXLTokens::XmlstrToken(EdxltokenHLLSketch), m_pphm, this);
+		this->Append(pphHLLSketch);
+
+		m_pphm->ActivateParseHandler(pphHLLSketch);
+		pphHLLSketch->startElement(xmlszUri, xmlszLocalname, xmlszQname, attrs);
+	}
 	else
 	{
 		CWStringDynamic *pstr = CDXLUtils::PstrFromXMLCh(m_pphm->Pmm(), xmlszLocalname);
@@ -156,12 +166,22 @@ CParseHandlerColStats::EndElement
 		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLUnexpectedTag, pstr->Wsz());
 	}
 
-	// get histogram buckets from child parse handlers
+	// get histogram buckets and the optional sketch from child parse handlers
 	
 	DrgPdxlbucket *pdrgpdxlbucket = GPOS_NEW(m_pmp) DrgPdxlbucket(m_pmp);
+	CDXLHLLSketch *pdxlhllsketch = NULL;
 	
 	for (ULONG ul = 0; ul < this->UlLength(); ul++)
 	{
+		CParseHandlerHLLSketch *pphHLLSketch = dynamic_cast<CParseHandlerHLLSketch *>((*this)[ul]);
+		if (NULL != pphHLLSketch)
+		{
+			CRefCount::SafeRelease(pdxlhllsketch);
+			pdxlhllsketch = pphHLLSketch->Pdxlhllsketch();
+			pdxlhllsketch->AddRef();
+			continue;
+		}
+
 		CParseHandlerColStatsBucket *pphBucket = dynamic_cast<CParseHandlerColStatsBucket *>((*this)[ul]);
 				
 		CDXLBucket *pdxlbucket = pphBucket->Pdxlbucket();
@@ -180,7 +200,8 @@ CParseHandlerColStats::EndElement
 							m_dDistinctRemain,
 							m_dFreqRemain,
 							pdrgpdxlbucket,
-							m_fColStatsMissing
+							m_fColStatsMissing,
+							pdxlhllsketch
 							);
 	
 	// deactivate handler
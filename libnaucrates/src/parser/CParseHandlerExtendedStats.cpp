@@ -0,0 +1,179 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CParseHandlerExtendedStats.cpp
+//
+//	@doc:
+//		Implementation of the SAX parse handler class for parsing multi-column
+//		statistics of a relation stats object
+//---------------------------------------------------------------------------
+
+#include "naucrates/md/CDXLExtendedStats.h"
+
+#include "naucrates/dxl/parser/CParseHandlerExtendedStats.h"
+#include "naucrates/dxl/parser/CParseHandlerFactory.h"
+#include "naucrates/dxl/parser/CParseHandlerManager.h"
+
+#include "naucrates/dxl/operators/CDXLOperatorFactory.h"
+
+using namespace gpdxl;
+using namespace gpmd;
+using namespace gpnaucrates;
+
+XERCES_CPP_NAMESPACE_USE
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerExtendedStats::CParseHandlerExtendedStats
+//
+//	@doc:
+//		Constructor
+//
+//---------------------------------------------------------------------------
+CParseHandlerExtendedStats::CParseHandlerExtendedStats
+	(
+	IMemoryPool *pmp,
+	CParseHandlerManager *pphm,
+	CParseHandlerBase *pphRoot
+	)
+	:
+	CParseHandlerBase(pmp, pphm, pphRoot),
+	m_pdxlextstats(NULL)
+{
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerExtendedStats::~CParseHandlerExtendedStats
+//
+//	@doc:
+//		Destructor
+//
+//---------------------------------------------------------------------------
+CParseHandlerExtendedStats::~CParseHandlerExtendedStats()
+{
+	CRefCount::SafeRelease(m_pdxlextstats);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerExtendedStats::Pdxlextstats
+//
+//	@doc:
+//		The extended stats constructed by the parse handler
+//
+//---------------------------------------------------------------------------
+CDXLExtendedStats *
+CParseHandlerExtendedStats::Pdxlextstats() const
+{
+	return m_pdxlextstats;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerExtendedStats::StartElement
+//
+//	@doc:
+//		Invoked by Xerces to process an opening tag
+//
+//---------------------------------------------------------------------------
+void
+CParseHandlerExtendedStats::StartElement
+	(
+	const XMLCh* const , // xmlszUri,
+	const XMLCh* const xmlszLocalname,
+	const XMLCh* const , // xmlszQname,
+	const Attributes& attrs
+	)
+{
+	if (0 != XMLString::compareString(CDXLTokens::XmlstrToken(EdxltokenExtendedStats), xmlszLocalname))
+	{
+		CWStringDynamic *pstr = CDXLUtils::PstrFromXMLCh(m_pphm->Pmm(), xmlszLocalname);
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLUnexpectedTag, pstr->Wsz());
+	}
+
+	// parse attribute numbers of the columns
+	const XMLCh *xmlszAttnos = CDXLOperatorFactory::XmlstrFromAttrs(attrs, EdxltokenColumns, EdxltokenExtendedStats);
+	DrgPi *pdrgpiAttno = CDXLOperatorFactory::PdrgpiFromXMLCh(m_pphm->Pmm(), xmlszAttnos, EdxltokenColumns, EdxltokenExtendedStats);
+
+	if (2 > pdrgpiAttno->UlLength())
+	{
+		pdrgpiAttno->Release();
+		GPOS_RAISE
+			(
+			gpdxl::ExmaDXL,
+			gpdxl::ExmiDXLInvalidAttributeValue,
+			CDXLTokens::PstrToken(EdxltokenColumns)->Wsz(),
+			CDXLTokens::PstrToken(EdxltokenExtendedStats)->Wsz()
+			);
+	}
+
+	// number of distinct values and dependency degree are optional
+	CDouble dDistinct(0.0);
+	const XMLCh *xmlszDistinct = attrs.getValue(CDXLTokens::XmlstrToken(EdxltokenStatsDistinct));
+	if (NULL != xmlszDistinct)
+	{
+		dDistinct = CDXLOperatorFactory::DValueFromXmlstr(m_pphm->Pmm(), xmlszDistinct, EdxltokenStatsDistinct, EdxltokenExtendedStats);
+	}
+
+	CDouble dDependency(0.0);
+	const XMLCh *xmlszDependency = attrs.getValue(CDXLTokens::XmlstrToken(EdxltokenStatsDependencyDegree));
+	if (NULL != xmlszDependency)
+	{
+		dDependency = CDXLOperatorFactory::DValueFromXmlstr(m_pphm->Pmm(), xmlszDependency, EdxltokenStatsDependencyDegree, EdxltokenExtendedStats);
+	}
+
+	Edxltoken edxltokenInvalid = EdxltokenSentinel;
+	if (0.0 > dDistinct)
+	{
+		edxltokenInvalid = EdxltokenStatsDistinct;
+	}
+	else if (0.0 > dDependency || 1.0 < dDependency)
+	{
+		edxltokenInvalid = EdxltokenStatsDependencyDegree;
+	}
+
+	if (EdxltokenSentinel != edxltokenInvalid)
+	{
+		pdrgpiAttno->Release();
+		GPOS_RAISE
+			(
+			gpdxl::ExmaDXL,
+			gpdxl::ExmiDXLInvalidAttributeValue,
+			CDXLTokens::PstrToken(edxltokenInvalid)->Wsz(),
+			CDXLTokens::PstrToken(EdxltokenExtendedStats)->Wsz()
+			);
+	}
+
+	m_pdxlextstats = GPOS_NEW(m_pmp) CDXLExtendedStats(m_pmp, pdrgpiAttno, dDistinct, dDependency);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerExtendedStats::EndElement
+//
+//	@doc:
+//		Invoked by Xerces to process a closing tag
+//
+//---------------------------------------------------------------------------
+void
+CParseHandlerExtendedStats::EndElement
+	(
+	const XMLCh* const, // xmlszUri,
+	const XMLCh* const xmlszLocalname,
+	const XMLCh* const // xmlszQname
+	)
+{
+	if (0 != XMLString::compareString(CDXLTokens::XmlstrToken(EdxltokenExtendedStats), xmlszLocalname))
+	{
+		CWStringDynamic *pstr = CDXLUtils::PstrFromXMLCh(m_pphm->Pmm(), xmlszLocalname);
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLUnexpectedTag, pstr->Wsz());
+	}
+
+	// deactivate handler
+	m_pphm->DeactivateHandler();
+}
+
+// EOF
@@ -23,8 +23,8 @@ using namespace gpdxl;
 
 XERCES_CPP_NAMESPACE_USE
 
-CParseHandlerFactory::HMXMLStrPfPHCreator *
-CParseHandlerFactory::m_phmPHCreators = NULL;
+PfParseHandlerOpCreator *
+CParseHandlerFactory::m_rgpfphopc[EdxltokenSentinel];
 
 //---------------------------------------------------------------------------
 //	@function:
@@ -41,16 +41,12 @@ CParseHandlerFactory::AddMapping
 	PfParseHandlerOpCreator *pfphopc
 	)
 {
-	GPOS_ASSERT(NULL != m_phmPHCreators);
-	const XMLCh *xmlszTok = CDXLTokens::XmlstrToken(edxltok);
-	GPOS_ASSERT(NULL != xmlszTok);
-	
-#ifdef GPOS_DEBUG
-	BOOL fInserted = 
-#endif
-	m_phmPHCreators->FInsert(xmlszTok, pfphopc);
-	
-	GPOS_ASSERT(fInserted);
+	// tokens sharing a string are registered under the id the string resolves to
+	Edxltoken edxltoken = CDXLTokens::EdxltokenFromXmlstr(CDXLTokens::XmlstrToken(edxltok));
+	GPOS_ASSERT(EdxltokenSentinel != edxltoken);
+	GPOS_ASSERT(NULL == m_rgpfphopc[edxltoken]);
+
+	m_rgpfphopc[edxltoken] = pfphopc;
 }
 
 //---------------------------------------------------------------------------
@@ -64,12 +60,15 @@ CParseHandlerFactory::AddMapping
 void
 CParseHandlerFactory::Init
 	(
-	IMemoryPool *pmp
+	IMemoryPool * // pmp
 	)
 {
-	m_phmPHCreators = GPOS_NEW(pmp) HMXMLStrPfPHCreator(pmp, ulHashMapSize);
-	
-	// array mapping XML Token -> Parse Handler Creator mappings to hashmap
+	for (ULONG ul = 0; ul < EdxltokenSentinel; ul++)
+	{
+		m_rgpfphopc[ul] = NULL;
+	}
+
+	// array mapping XML Token -> Parse Handler Creator mappings to token ids
 	SParseHandlerMapping rgParseHandlers[] =
 	{
 			{EdxltokenPlan, &PphPlan},
@@ -101,6 +100,8 @@ CParseHandlerFactory::Init
 			{EdxltokenMetadataColumn, &PphMetadataColumn},
 			{EdxltokenColumnDefaultValue, &PphColumnDefaultValueExpr},
 			{EdxltokenColumnStatsBucket, &PphColStatsBucket},
+			{EdxltokenExtendedStats, &PphExtendedStats},
+			{EdxltokenHLLSketch, &PphHLLSketch},
 			{EdxltokenGPDBCast, &PphMDCast},
 			{EdxltokenGPDBMDScCmp, &PphMDScCmp},
 			{EdxltokenGPDBArrayCoerceCast, &PphMDArrayCoerceCast},
@@ -319,9 +320,12 @@ CParseHandlerFactory::Pph
 	CParseHandlerBase *pphRoot
 	)
 {
-	GPOS_ASSERT(NULL != m_phmPHCreators);
-
-	PfParseHandlerOpCreator *phoc = m_phmPHCreators->PtLookup(xmlszName);
+	Edxltoken edxltoken = CDXLTokens::EdxltokenFromXmlstr(xmlszName);
+	PfParseHandlerOpCreator *phoc = NULL;
+	if (EdxltokenSentinel != edxltoken)
+	{
+		phoc = m_rgpfphopc[edxltoken];
+	}
 
 	if (phoc != NULL)
 	{
@@ -685,6 +689,46 @@ CParseHandlerFactory::PphColStatsBucket
 	return GPOS_NEW(pmp) CParseHandlerColStatsBucket(pmp, pphm, pphRoot);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerFactory::PphExtendedStats
+//
+//	@doc:
+//		Creates a parse handler for parsing multi-column statistics of a
+//		relation stats object
+//
+//---------------------------------------------------------------------------
+CParseHandlerBase *
+CParseHandlerFactory::PphExtendedStats
+	(
+	IMemoryPool *pmp,
+	CParseHandlerManager *pphm,
+	CParseHandlerBase *pphRoot
+	)
+{
+	return GPOS_NEW(pmp) CParseHandlerExtendedStats(pmp, pphm, pphRoot);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerFactory::PphHLLSketch
+//
+//	@doc:
+//		Creates a parse handler for parsing the HyperLogLog sketch of a
+//		column stats object
+//
+//---------------------------------------------------------------------------
+CParseHandlerBase *
+CParseHandlerFactory::PphHLLSketch
+	(
+	IMemoryPool *pmp,
+	CParseHandlerManager *pphm,
+	CParseHandlerBase *pphRoot
+	)
+{
+	return GPOS_NEW(pmp) CParseHandlerHLLSketch(pmp, pphm, pphRoot);
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CParseHandlerFactory::PphMDGPDBType
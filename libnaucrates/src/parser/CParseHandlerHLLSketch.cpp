@@ -0,0 +1,158 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CParseHandlerHLLSketch.cpp
+//
+//	@doc:
+//		Implementation of the SAX parse handler class for parsing the
+//		HyperLogLog sketch of a column stats object
+//---------------------------------------------------------------------------
+
+#include "naucrates/md/CDXLHLLSketch.h"
+
+#include "naucrates/dxl/parser/CParseHandlerHLLSketch.h"
+#include "naucrates/dxl/parser/CParseHandlerFactory.h"
+#include "naucrates/dxl/parser/CParseHandlerManager.h"
+
+#include "naucrates/dxl/operators/CDXLOperatorFactory.h"
+
+using namespace gpdxl;
+using namespace gpmd;
+using namespace gpnaucrates;
+
+XERCES_CPP_NAMESPACE_USE
+
+// smallest and largest supported precision
+const ULONG CParseHandlerHLLSketch::ulPrecisionMin = 4;
+const ULONG CParseHandlerHLLSketch::ulPrecisionMax = 18;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerHLLSketch::CParseHandlerHLLSketch
+//
+//	@doc:
+//		Constructor
+//
+//---------------------------------------------------------------------------
+CParseHandlerHLLSketch::CParseHandlerHLLSketch
+	(
+	IMemoryPool *pmp,
+	CParseHandlerManager *pphm,
+	CParseHandlerBase *pphRoot
+	)
+	:
+	CParseHandlerBase(pmp, pphm, pphRoot),
+	m_pdxlhllsketch(NULL)
+{
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerHLLSketch::~CParseHandlerHLLSketch
+//
+//	@doc:
+//		Destructor
+//
+//---------------------------------------------------------------------------
+CParseHandlerHLLSketch::~CParseHandlerHLLSketch()
+{
+	CRefCount::SafeRelease(m_pdxlhllsketch);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerHLLSketch::Pdxlhllsketch
+//
+//	@doc:
+//		The sketch constructed by the parse handler
+//
+//---------------------------------------------------------------------------
+CDXLHLLSketch *
+CParseHandlerHLLSketch::Pdxlhllsketch() const
+{
+	return m_pdxlhllsketch;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerHLLSketch::StartElement
+//
+//	@doc:
+//		Invoked by Xerces to process an opening tag
+//
+//---------------------------------------------------------------------------
+void
+CParseHandlerHLLSketch::StartElement
+	(
+	const XMLCh* const , // xmlszUri,
+	const XMLCh* const xmlszLocalname,
+	const XMLCh* const , // xmlszQname,
+	const Attributes& attrs
+	)
+{
+	if (0 != XMLString::compareString(CDXLTokens::XmlstrToken(EdxltokenHLLSketch), xmlszLocalname))
+	{
+		CWStringDynamic *pstr = CDXLUtils::PstrFromXMLCh(m_pphm->Pmm(), xmlszLocalname);
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLUnexpectedTag, pstr->Wsz());
+	}
+
+	ULONG ulPrecision = CDXLOperatorFactory::UlValueFromAttrs(m_pphm->Pmm(), attrs, EdxltokenHLLPrecision, EdxltokenHLLSketch);
+	if (ulPrecisionMin > ulPrecision || ulPrecisionMax < ulPrecision)
+	{
+		GPOS_RAISE
+			(
+			gpdxl::ExmaDXL,
+			gpdxl::ExmiDXLInvalidAttributeValue,
+			CDXLTokens::PstrToken(EdxltokenHLLPrecision)->Wsz(),
+			CDXLTokens::PstrToken(EdxltokenHLLSketch)->Wsz()
+			);
+	}
+
+	// registers are Base64 encoded, one byte per register
+	const XMLCh *xmlszRegisters = CDXLOperatorFactory::XmlstrFromAttrs(attrs, EdxltokenHLLRegisters, EdxltokenHLLSketch);
+	ULONG ulRegisters = 0;
+	BYTE *pbaRegisters = CDXLUtils::PbaFromBase64XMLStr(m_pphm->Pmm(), xmlszRegisters, &ulRegisters);
+	if (NULL == pbaRegisters || (ULONG(1) << ulPrecision) != ulRegisters)
+	{
+		GPOS_DELETE_ARRAY(pbaRegisters);
+		GPOS_RAISE
+			(
+			gpdxl::ExmaDXL,
+			gpdxl::ExmiDXLInvalidAttributeValue,
+			CDXLTokens::PstrToken(EdxltokenHLLRegisters)->Wsz(),
+			CDXLTokens::PstrToken(EdxltokenHLLSketch)->Wsz()
+			);
+	}
+
+	m_pdxlhllsketch = GPOS_NEW(m_pmp) CDXLHLLSketch(ulPrecision, pbaRegisters, ulRegisters);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerHLLSketch::EndElement
+//
+//	@doc:
+//		Invoked by Xerces to process a closing tag
+//
+//---------------------------------------------------------------------------
+void
+CParseHandlerHLLSketch::EndElement
+	(
+	const XMLCh* const, // xmlszUri,
+	const XMLCh* const xmlszLocalname,
+	const XMLCh* const // xmlszQname
+	)
+{
+	if (0 != XMLString::compareString(CDXLTokens::XmlstrToken(EdxltokenHLLSketch), xmlszLocalname))
+	{
+		CWStringDynamic *pstr = CDXLUtils::PstrFromXMLCh(m_pphm->Pmm(), xmlszLocalname);
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLUnexpectedTag, pstr->Wsz());
+	}
+
+	// deactivate handler
+	m_pphm->DeactivateHandler();
+}
+
+// EOF
@@ -35,9 +35,11 @@ CParseHandlerManager::CParseHandlerManager
 	m_pmm(pmm),
 	m_pxmlreader(pxmlreader),
 	m_pphCurrent(NULL),
+	m_pdxlattrs(NULL),
 	m_ulIterLastCFA(0)
 {
 	m_pphstack = GPOS_NEW(pmm->Pmp()) PHStack(pmm->Pmp());
+	m_pdxlattrs = GPOS_NEW(pmm->Pmp()) CDXLAttributes(pmm->Pmp());
 }
 
 //---------------------------------------------------------------------------
@@ -51,6 +53,7 @@ CParseHandlerManager::CParseHandlerManager
 CParseHandlerManager::~CParseHandlerManager()
 {
 	GPOS_DELETE(m_pphstack);
+	GPOS_DELETE(m_pdxlattrs);
 }
 
 
@@ -76,8 +79,7 @@ CParseHandlerManager::ActivateParseHandler(CParseHandlerBase *pph)
 	GPOS_ASSERT(NULL != pph);
 	
 	m_pphCurrent = pph;
-	m_pxmlreader->setContentHandler(pph);
-	m_pxmlreader->setErrorHandler(pph);
+	SetHandlers();
 }
 
 //---------------------------------------------------------------------------
@@ -106,8 +108,7 @@ CParseHandlerManager::ReplaceHandler
 	}
 	
 	m_pphCurrent = pph;
-	m_pxmlreader->setContentHandler(pph);	
-	m_pxmlreader->setErrorHandler(pph);
+	SetHandlers();
 }
 
 
@@ -137,8 +138,7 @@ CParseHandlerManager::DeactivateHandler()
 		m_pphCurrent = NULL;
 	}
 	
-	m_pxmlreader->setContentHandler(m_pphCurrent);
-	m_pxmlreader->setErrorHandler(m_pphCurrent);
+	SetHandlers();
 }
 
 //---------------------------------------------------------------------------
@@ -155,6 +155,39 @@ CParseHandlerManager::PphCurrent()
 	return m_pphCurrent;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerManager::PphActive
+//
+//	@doc:
+//		Returns the handler receiving the events of documents that are not
+//		parsed by a SAX reader
+//
+//---------------------------------------------------------------------------
+CParseHandlerBase *
+CParseHandlerManager::PphActive()
+{
+	return m_pphCurrent;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerManager::SetHandlers
+//
+//	@doc:
+//		Register the current handler with the SAX reader, if any
+//
+//---------------------------------------------------------------------------
+void
+CParseHandlerManager::SetHandlers()
+{
+	if (NULL != m_pxmlreader)
+	{
+		m_pxmlreader->setContentHandler(m_pphCurrent);
+		m_pxmlreader->setErrorHandler(m_pphCurrent);
+	}
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CParseHandlerManager::CheckForAborts
@@ -13,6 +13,7 @@
 #include "naucrates/md/CDXLRelStats.h"
 
 #include "naucrates/dxl/parser/CParseHandlerRelStats.h"
+#include "naucrates/dxl/parser/CParseHandlerExtendedStats.h"
 #include "naucrates/dxl/parser/CParseHandlerFactory.h"
 #include "naucrates/dxl/parser/CParseHandlerManager.h"
 
@@ -39,7 +40,11 @@ CParseHandlerRelStats::CParseHandlerRelStats
 	CParseHandlerBase *pphRoot
 	)
 	:
-	CParseHandlerMetadataObject(pmp, pphm, pphRoot)
+	CParseHandlerMetadataObject(pmp, pphm, pphRoot),
+	m_pmdidRelStats(NULL),
+	m_pmdname(NULL),
+	m_dRows(0.0),
+	m_fEmpty(false)
 {
 }
 
@@ -54,12 +59,26 @@ CParseHandlerRelStats::CParseHandlerRelStats
 void
 CParseHandlerRelStats::StartElement
 	(
-	const XMLCh* const , // xmlszUri,
+	const XMLCh* const xmlszUri,
 	const XMLCh* const xmlszLocalname,
-	const XMLCh* const , // xmlszQname,
+	const XMLCh* const xmlszQname,
 	const Attributes& attrs
 	)
 {
+	if (0 == XMLString::compareString(CDXLTokens::XmlstrToken(EdxltokenExtendedStats), xmlszLocalname))
+	{
+		// new multi-column statistics object
+		GPOS_ASSERT(NULL != m_pmdname);
+
+		CParseHandlerBase *pphExtStats = CParseHandlerFactory::Pph(m_pmp, CDXLTokens::XmlstrToken(EdxltokenExtendedStats), m_pphm, this);
+		this->Append(pphExtStats);
+
+		m_pphm->ActivateParseHandler(pphExtStats);
+		pphExtStats->startElement(xmlszUri, xmlszLocalname, xmlszQname, attrs);
+
+		return;
+	}
+
 	if(0 != XMLString::compareString(CDXLTokens::XmlstrToken(EdxltokenRelationStats), xmlszLocalname))
 	{
 		CWStringDynamic *pstr = CDXLUtils::PstrFromXMLCh(m_pphm->Pmm(), xmlszLocalname);
@@ -77,29 +96,29 @@ CParseHandlerRelStats::StartElement
 	CWStringDynamic *pstrTableName = CDXLUtils::PstrFromXMLCh(m_pphm->Pmm(), xmlszTableName);
 	
 	// create a copy of the string in the CMDName constructor
-	CMDName *pmdname = GPOS_NEW(m_pmp) CMDName(m_pmp, pstrTableName);
+	m_pmdname = GPOS_NEW(m_pmp) CMDName(m_pmp, pstrTableName);
 	
 	GPOS_DELETE(pstrTableName);
 	
 
 	// parse metadata id info
 	IMDId *pmdid = CDXLOperatorFactory::PmdidFromAttrs(m_pphm->Pmm(), attrs, EdxltokenMdid, EdxltokenRelationStats);
+	m_pmdidRelStats = CMDIdRelStats::PmdidConvert(pmdid);
 	
 	// parse rows
 
-	CDouble dRows = CDXLOperatorFactory::DValueFromAttrs
-											(
-											m_pphm->Pmm(),
-											attrs,
-											EdxltokenRows,
-											EdxltokenRelationStats
-											);
+	m_dRows = CDXLOperatorFactory::DValueFromAttrs
+										(
+										m_pphm->Pmm(),
+										attrs,
+										EdxltokenRows,
+										EdxltokenRelationStats
+										);
 	
-	BOOL fEmpty = false;
 	const XMLCh *xmlszEmpty = attrs.getValue(CDXLTokens::XmlstrToken(EdxltokenEmptyRelation));
 	if (NULL != xmlszEmpty)
 	{
-		fEmpty = CDXLOperatorFactory::FValueFromXmlstr
+		m_fEmpty = CDXLOperatorFactory::FValueFromXmlstr
 										(
 										m_pphm->Pmm(),
 										xmlszEmpty,
@@ -107,8 +126,6 @@ CParseHandlerRelStats::StartElement
 										EdxltokenStatsDerivedRelation
 										);
 	}
-
-	m_pimdobj = GPOS_NEW(m_pmp) CDXLRelStats(m_pmp, CMDIdRelStats::PmdidConvert(pmdid), pmdname, dRows, fEmpty);
 }
 
 //---------------------------------------------------------------------------
@@ -133,6 +150,20 @@ CParseHandlerRelStats::EndElement
 		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLUnexpectedTag, pstr->Wsz());
 	}
 
+	// get multi-column statistics from child parse handlers
+	DrgPdxlextstats *pdrgpdxlextstats = GPOS_NEW(m_pmp) DrgPdxlextstats(m_pmp);
+	for (ULONG ul = 0; ul < this->UlLength(); ul++)
+	{
+		CParseHandlerExtendedStats *pphExtStats = dynamic_cast<CParseHandlerExtendedStats *>((*this)[ul]);
+
+		CDXLExtendedStats *pdxlextstats = pphExtStats->Pdxlextstats();
+		pdxlextstats->AddRef();
+
+		pdrgpdxlextstats->Append(pdxlextstats);
+	}
+
+	m_pimdobj = GPOS_NEW(m_pmp) CDXLRelStats(m_pmp, m_pmdidRelStats, m_pmdname, m_dRows, m_fEmpty, pdrgpdxlextstats);
+
 	// deactivate handler
 	m_pphm->DeactivateHandler();
 }
@@ -85,8 +85,17 @@ CParseHandlerStatisticsConfig::StartElement
 	CDouble dDampingFactorFilter = CDXLOperatorFactory::DValueFromAttrs(m_pphm->Pmm(), attrs, EdxltokenDampingFactorFilter, EdxltokenStatisticsConfig);
 	CDouble dDampingFactorJoin = CDXLOperatorFactory::DValueFromAttrs(m_pphm->Pmm(), attrs, EdxltokenDampingFactorJoin, EdxltokenStatisticsConfig);
 	CDouble dDampingFactorGroupBy = CDXLOperatorFactory::DValueFromAttrs(m_pphm->Pmm(), attrs, EdxltokenDampingFactorGroupBy, EdxltokenStatisticsConfig);
-
-	m_pstatsconf = GPOS_NEW(m_pmp) CStatisticsConfig(m_pmp, dDampingFactorFilter, dDampingFactorJoin, dDampingFactorGroupBy);
+	ULONG ulMaxHistogramBuckets = CDXLOperatorFactory::UlValueFromAttrs(m_pphm->Pmm(), attrs, EdxltokenMaxHistogramBuckets, EdxltokenStatisticsConfig, true /*fOptional*/, CStatisticsConfig::ulMaxHistogramBucketsDefault);
+
+	m_pstatsconf = GPOS_NEW(m_pmp) CStatisticsConfig
+								(
+								m_pmp,
+								dDampingFactorFilter,
+								dDampingFactorJoin,
+								dDampingFactorGroupBy,
+								CStatisticsConfig::ulParallelHistogramsThresholdDefault,
+								ulMaxHistogramBuckets
+								);
 }
 
 //---------------------------------------------------------------------------
@@ -468,6 +468,76 @@ CBucket::PbucketCopy
 	return GPOS_NEW(pmp) CBucket(m_ppointLower, m_ppointUpper, m_fLowerClosed, m_fUpperClosed, m_dFrequency, m_dDistinct);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CBucket::PbucketMergeAdjacent
+//
+//	@doc:
+//		Return a bucket spanning this bucket, the adjacent bucket that
+//		follows it and the gap between them, if any; frequencies and
+//		number of distinct values of the two buckets are added up
+//
+//---------------------------------------------------------------------------
+CBucket *
+CBucket::PbucketMergeAdjacent
+	(
+	IMemoryPool *pmp,
+	const CBucket *pbucketNext
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pbucketNext);
+	GPOS_ASSERT(m_ppointUpper->FLessThanOrEqual(pbucketNext->PpLower()));
+
+	m_ppointLower->AddRef();
+	pbucketNext->PpUpper()->AddRef();
+
+	CDouble dFrequency = std::min(DOUBLE(1.0), (m_dFrequency + pbucketNext->DFrequency()).DVal());
+
+	return GPOS_NEW(pmp) CBucket
+						(
+						m_ppointLower,
+						pbucketNext->PpUpper(),
+						m_fLowerClosed,
+						pbucketNext->FUpperClosed(),
+						dFrequency,
+						m_dDistinct + pbucketNext->DDistinct()
+						);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBucket::DMergeAdjacentError
+//
+//	@doc:
+//		Frequency misplaced by merging with the adjacent bucket that follows
+//		this bucket: the merged bucket spreads the combined frequency evenly
+//		over both buckets and the gap between them, so the error is the
+//		difference between the frequency it assigns to each of these ranges
+//		and their actual frequency
+//
+//---------------------------------------------------------------------------
+CDouble
+CBucket::DMergeAdjacentError
+	(
+	const CBucket *pbucketNext
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pbucketNext);
+
+	CDouble dWidth = DWidth();
+	CDouble dWidthNext = pbucketNext->DWidth();
+	CDouble dGap = std::max(DOUBLE(0.0), pbucketNext->PpLower()->DDistance(m_ppointUpper).DVal());
+	CDouble dFrequency = m_dFrequency + pbucketNext->DFrequency();
+
+	CDouble dDensity = dFrequency / (dWidth + dGap + dWidthNext);
+
+	return (m_dFrequency - dDensity * dWidth).FpAbs() +
+			dDensity * dGap +
+			(pbucketNext->DFrequency() - dDensity * dWidthNext).FpAbs();
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CBucket::PbucketUpdateFrequency
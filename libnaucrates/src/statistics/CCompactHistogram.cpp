@@ -0,0 +1,688 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CCompactHistogram.cpp
+//
+//	@doc:
+//		Implementation of columnar histogram buckets
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+
+#include "naucrates/base/IDatumStatisticsMappable.h"
+#include "naucrates/statistics/CCompactHistogram.h"
+
+using namespace gpnaucrates;
+
+// largest LINT magnitude that is exactly representable as a double
+#define GPNAUCRATES_COMPACT_HIST_MAX_LINT (((LINT) 1) << 53)
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCompactHistogram::CCompactHistogram
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CCompactHistogram::CCompactHistogram
+	(
+	IMemoryPool *pmp,
+	ULONG ulBuckets,
+	EMapping em
+	)
+	:
+	m_pmp(pmp),
+	m_ulBuckets(ulBuckets),
+	m_em(em),
+	m_rgdLower(NULL),
+	m_rgdUpper(NULL),
+	m_rgfLowerClosed(NULL),
+	m_rgfUpperClosed(NULL),
+	m_rgdFrequency(NULL),
+	m_rgdDistinct(NULL)
+{
+	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(EmSentinel > em);
+
+	// allocate at least one element per array to avoid empty allocations
+	const ULONG ulSize = std::max(ulBuckets, (ULONG) 1);
+	m_rgdLower = GPOS_NEW_ARRAY(m_pmp, DOUBLE, ulSize);
+	m_rgdUpper = GPOS_NEW_ARRAY(m_pmp, DOUBLE, ulSize);
+	m_rgfLowerClosed = GPOS_NEW_ARRAY(m_pmp, BOOL, ulSize);
+	m_rgfUpperClosed = GPOS_NEW_ARRAY(m_pmp, BOOL, ulSize);
+	m_rgdFrequency = GPOS_NEW_ARRAY(m_pmp, DOUBLE, ulSize);
+	m_rgdDistinct = GPOS_NEW_ARRAY(m_pmp, DOUBLE, ulSize);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCompactHistogram::~CCompactHistogram
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CCompactHistogram::~CCompactHistogram()
+{
+	GPOS_DELETE_ARRAY(m_rgdLower);
+	GPOS_DELETE_ARRAY(m_rgdUpper);
+	GPOS_DELETE_ARRAY(m_rgfLowerClosed);
+	GPOS_DELETE_ARRAY(m_rgfUpperClosed);
+	GPOS_DELETE_ARRAY(m_rgdFrequency);
+	GPOS_DELETE_ARRAY(m_rgdDistinct);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCompactHistogram::FMap
+//
+//	@doc:
+//		Map given datum to a double; the mapping mirrors the one used by
+//		IDatumStatisticsMappable comparisons, i.e., binary comparison takes
+//		precedence over LINT mapping, which takes precedence over double
+//		mapping; datums compared in binary form are not mappable
+//
+//---------------------------------------------------------------------------
+BOOL
+CCompactHistogram::FMap
+	(
+	IDatum *pdatum,
+	EMapping *pem,
+	DOUBLE *pd
+	)
+{
+	GPOS_ASSERT(NULL != pdatum);
+	GPOS_ASSERT(NULL != pem);
+	GPOS_ASSERT(NULL != pd);
+
+	if (pdatum->FNull() || !pdatum->FStatsMappable() || pdatum->FSupportsBinaryComp(pdatum))
+	{
+		return false;
+	}
+
+	const IDatumStatisticsMappable *pdatumsm = dynamic_cast<const IDatumStatisticsMappable *>(pdatum);
+	if (NULL == pdatumsm)
+	{
+		return false;
+	}
+
+	if (pdatumsm->FHasStatsLINTMapping())
+	{
+		LINT l = pdatumsm->LStatsMapping();
+		if (GPNAUCRATES_COMPACT_HIST_MAX_LINT < l || -GPNAUCRATES_COMPACT_HIST_MAX_LINT > l)
+		{
+			return false;
+		}
+
+		*pem = EmLint;
+		*pd = (DOUBLE) l;
+
+		return true;
+	}
+
+	if (pdatumsm->FHasStatsDoubleMapping())
+	{
+		*pem = EmDouble;
+		*pd = pdatumsm->DStatsMapping().DVal();
+
+		return true;
+	}
+
+	return false;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCompactHistogram::FMap
+//
+//	@doc:
+//		Map given point to the representation of bucket bounds
+//
+//---------------------------------------------------------------------------
+BOOL
+CCompactHistogram::FMap
+	(
+	const CPoint *ppoint,
+	DOUBLE *pd
+	)
+	const
+{
+	GPOS_ASSERT(NULL != ppoint);
+
+	EMapping em = EmSentinel;
+	return FMap(ppoint->Pdatum(), &em, pd) && em == m_em;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCompactHistogram::FAfter
+//
+//	@doc:
+//		Is given mapped value after the upper bound of given bucket,
+//		see CBucket::FAfter
+//
+//---------------------------------------------------------------------------
+BOOL
+CCompactHistogram::FAfter
+	(
+	ULONG ul,
+	DOUBLE d
+	)
+	const
+{
+	GPOS_ASSERT(ul < m_ulBuckets);
+
+	if (m_rgfUpperClosed[ul])
+	{
+		return CDouble(m_rgdUpper[ul]) < CDouble(d);
+	}
+
+	return CDouble(m_rgdUpper[ul]) <= CDouble(d);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCompactHistogram::FBefore
+//
+//	@doc:
+//		Is given mapped value before the lower bound of given bucket,
+//		see CBucket::FBefore
+//
+//---------------------------------------------------------------------------
+BOOL
+CCompactHistogram::FBefore
+	(
+	ULONG ul,
+	DOUBLE d
+	)
+	const
+{
+	GPOS_ASSERT(ul < m_ulBuckets);
+
+	if (m_rgfLowerClosed[ul])
+	{
+		return CDouble(m_rgdLower[ul]) > CDouble(d);
+	}
+
+	return CDouble(m_rgdLower[ul]) >= CDouble(d);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCompactHistogram::FContains
+//
+//	@doc:
+//		Does given bucket contain mapped value, see CBucket::FContains
+//
+//---------------------------------------------------------------------------
+BOOL
+CCompactHistogram::FContains
+	(
+	ULONG ul,
+	DOUBLE d
+	)
+	const
+{
+	GPOS_ASSERT(ul < m_ulBuckets);
+
+	CDouble dLower(m_rgdLower[ul]);
+	CDouble dUpper(m_rgdUpper[ul]);
+	CDouble dValue(d);
+
+	// special case for singleton bucket
+	if (dLower == dUpper)
+	{
+		return dLower == dValue;
+	}
+
+	if ((m_rgfLowerClosed[ul] && dLower == dValue) || (m_rgfUpperClosed[ul] && dUpper == dValue))
+	{
+		return true;
+	}
+
+	return dLower < dValue && dUpper > dValue;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCompactHistogram::UlFirstNotAfter
+//
+//	@doc:
+//		Binary search for the first bucket whose upper bound is not before
+//		the given mapped value; since buckets are ordered and do not overlap,
+//		the buckets preceding the returned index lie entirely before the
+//		value, and the value can only be contained in the returned bucket
+//
+//---------------------------------------------------------------------------
+ULONG
+CCompactHistogram::UlFirstNotAfter
+	(
+	DOUBLE d
+	)
+	const
+{
+	ULONG ulLow = 0;
+	ULONG ulHigh = m_ulBuckets;
+	while (ulLow < ulHigh)
+	{
+		ULONG ulMid = ulLow + (ulHigh - ulLow) / 2;
+		if (FAfter(ulMid, d))
+		{
+			ulLow = ulMid + 1;
+		}
+		else
+		{
+			ulHigh = ulMid;
+		}
+	}
+
+	return ulLow;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCompactHistogram::DFrequency
+//
+//	@doc:
+//		Sum of bucket frequencies
+//
+//---------------------------------------------------------------------------
+DOUBLE
+CCompactHistogram::DFrequency() const
+{
+	DOUBLE dFrequency = 0.0;
+	for (ULONG ul = 0; ul < m_ulBuckets; ul++)
+	{
+		dFrequency += m_rgdFrequency[ul];
+	}
+
+	return dFrequency;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCompactHistogram::ICompare
+//
+//	@doc:
+//		Compare mapped values using the precision of CDouble
+//
+//---------------------------------------------------------------------------
+INT
+CCompactHistogram::ICompare
+	(
+	DOUBLE d1,
+	DOUBLE d2
+	)
+{
+	CDouble dFirst(d1);
+	CDouble dSecond(d2);
+
+	if (dFirst == dSecond)
+	{
+		return 0;
+	}
+
+	if (dFirst < dSecond)
+	{
+		return -1;
+	}
+
+	return 1;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCompactHistogram::DWidth
+//
+//	@doc:
+//		Width of given bucket
+//
+//---------------------------------------------------------------------------
+CDouble
+CCompactHistogram::DWidth
+	(
+	ULONG ul
+	)
+	const
+{
+	if (FSingleton(ul))
+	{
+		return CDouble(1.0);
+	}
+
+	return DDistance(m_rgdUpper[ul], m_rgdLower[ul]);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCompactHistogram::FSubsumes
+//
+//	@doc:
+//		Does given bucket subsume bucket of other histogram; as in
+//		CBucket::FSubsumes, bounds are compared by value only
+//
+//---------------------------------------------------------------------------
+BOOL
+CCompactHistogram::FSubsumes
+	(
+	ULONG ul,
+	const CCompactHistogram *pchist,
+	ULONG ulOther
+	)
+	const
+{
+	if (FSingleton(ul) && pchist->FSingleton(ulOther))
+	{
+		return 0 == ICompare(m_rgdLower[ul], pchist->m_rgdLower[ulOther]);
+	}
+
+	if (pchist->FSingleton(ulOther))
+	{
+		return FContains(ul, pchist->m_rgdLower[ulOther]);
+	}
+
+	return 0 >= ICompare(m_rgdLower[ul], pchist->m_rgdLower[ulOther]) &&
+			0 <= ICompare(m_rgdUpper[ul], pchist->m_rgdUpper[ulOther]);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCompactHistogram::FIntersects
+//
+//	@doc:
+//		Does given bucket intersect bucket of other histogram
+//
+//---------------------------------------------------------------------------
+BOOL
+CCompactHistogram::FIntersects
+	(
+	ULONG ul,
+	const CCompactHistogram *pchist,
+	ULONG ulOther
+	)
+	const
+{
+	const BOOL fSingleton = FSingleton(ul);
+	const BOOL fSingletonOther = pchist->FSingleton(ulOther);
+
+	if (fSingleton && fSingletonOther)
+	{
+		return 0 == ICompare(m_rgdLower[ul], pchist->m_rgdLower[ulOther]);
+	}
+
+	if (fSingleton)
+	{
+		return pchist->FContains(ulOther, m_rgdLower[ul]);
+	}
+
+	if (fSingletonOther)
+	{
+		return FContains(ul, pchist->m_rgdLower[ulOther]);
+	}
+
+	if (FSubsumes(ul, pchist, ulOther) || pchist->FSubsumes(ulOther, this, ul))
+	{
+		return true;
+	}
+
+	// compare lower bound of one bucket to upper bound of the other,
+	// see CBucket::ICompareLowerBoundToUpperBound
+	DOUBLE dLower = pchist->m_rgdLower[ulOther];
+	BOOL fLowerClosed = pchist->m_rgfLowerClosed[ulOther];
+	DOUBLE dUpper = m_rgdUpper[ul];
+	BOOL fUpperClosed = m_rgfUpperClosed[ul];
+	if (0 < ICompare(m_rgdLower[ul], pchist->m_rgdLower[ulOther]))
+	{
+		// current bucket starts after the other bucket
+		dLower = m_rgdLower[ul];
+		fLowerClosed = m_rgfLowerClosed[ul];
+		dUpper = pchist->m_rgdUpper[ulOther];
+		fUpperClosed = pchist->m_rgfUpperClosed[ulOther];
+	}
+
+	INT iRes = ICompare(dLower, dUpper);
+	if (0 == iRes)
+	{
+		return fLowerClosed && fUpperClosed;
+	}
+
+	return 0 > iRes;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCompactHistogram::Intersect
+//
+//	@doc:
+//		Intersect given bucket with bucket of other histogram and return
+//		the frequency of each of the buckets that intersects; the arithmetic
+//		follows CBucket::PbucketIntersect step by step so that results
+//		are identical
+//
+//---------------------------------------------------------------------------
+void
+CCompactHistogram::Intersect
+	(
+	ULONG ul,
+	const CCompactHistogram *pchist,
+	ULONG ulOther,
+	SBucketIntersection *pbi,
+	CDouble *pdFreqIntersect1,
+	CDouble *pdFreqIntersect2
+	)
+	const
+{
+	GPOS_ASSERT(FIntersects(ul, pchist, ulOther));
+
+	pbi->m_ul1 = ul;
+	pbi->m_ul2 = ulOther;
+
+	// maximum of lower bounds and minimum of upper bounds
+	pbi->m_fLowerFrom1 = 0 <= ICompare(m_rgdLower[ul], pchist->m_rgdLower[ulOther]);
+	pbi->m_fUpperFrom1 = 0 >= ICompare(m_rgdUpper[ul], pchist->m_rgdUpper[ulOther]);
+	DOUBLE dNewLower = pbi->m_fLowerFrom1 ? m_rgdLower[ul] : pchist->m_rgdLower[ulOther];
+	DOUBLE dNewUpper = pbi->m_fUpperFrom1 ? m_rgdUpper[ul] : pchist->m_rgdUpper[ulOther];
+
+	pbi->m_fLowerClosed = true;
+	pbi->m_fUpperClosed = true;
+
+	CDouble dDistanceNew = 1.0;
+	if (0 != ICompare(dNewLower, dNewUpper))
+	{
+		pbi->m_fLowerClosed = m_rgfLowerClosed[ul];
+		pbi->m_fUpperClosed = m_rgfUpperClosed[ul];
+
+		if (0 == ICompare(dNewLower, pchist->m_rgdLower[ulOther]))
+		{
+			pbi->m_fLowerClosed = pchist->m_rgfLowerClosed[ulOther];
+			if (0 == ICompare(dNewLower, m_rgdLower[ul]))
+			{
+				pbi->m_fLowerClosed = m_rgfLowerClosed[ul] && pchist->m_rgfLowerClosed[ulOther];
+			}
+		}
+
+		if (0 == ICompare(dNewUpper, pchist->m_rgdUpper[ulOther]))
+		{
+			pbi->m_fUpperClosed = pchist->m_rgfUpperClosed[ulOther];
+			if (0 == ICompare(dNewUpper, m_rgdUpper[ul]))
+			{
+				pbi->m_fUpperClosed = m_rgfUpperClosed[ul] && pchist->m_rgfUpperClosed[ulOther];
+			}
+		}
+
+		dDistanceNew = DDistance(dNewUpper, dNewLower);
+	}
+
+	CDouble dRatio1 = dDistanceNew / DWidth(ul);
+	CDouble dRatio2 = dDistanceNew / pchist->DWidth(ulOther);
+
+	// edge case
+	if (FSingleton(ul) && pchist->FSingleton(ulOther))
+	{
+		dRatio1 = CDouble(1.0);
+		dRatio2 = CDouble(1.0);
+	}
+
+	const DOUBLE dDistinct1 = dRatio1.DVal() * CDouble(m_rgdDistinct[ul]).DVal();
+	const DOUBLE dDistinct2 = dRatio2.DVal() * CDouble(pchist->m_rgdDistinct[ulOther]).DVal();
+
+	CDouble dFreqIntersect1 = dRatio1 * CDouble(m_rgdFrequency[ul]);
+	CDouble dFreqIntersect2 = dRatio2 * CDouble(pchist->m_rgdFrequency[ulOther]);
+
+	CDouble dFrequencyNew(dFreqIntersect1 * dFreqIntersect2 * DOUBLE(1.0) / std::max(dDistinct1, dDistinct2));
+
+	pbi->m_dFrequency = dFrequencyNew.DVal();
+	pbi->m_dDistinct = CDouble(std::min(dDistinct1, dDistinct2)).DVal();
+
+	*pdFreqIntersect1 = dFreqIntersect1;
+	*pdFreqIntersect2 = dFreqIntersect2;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCompactHistogram::UlJoinEquality
+//
+//	@doc:
+//		Merge buckets of both histograms in order of their upper bounds,
+//		intersecting overlapping pairs; this is the bucket alignment of
+//		CHistogram::PhistJoinEquality without allocating points or buckets
+//
+//---------------------------------------------------------------------------
+ULONG
+CCompactHistogram::UlJoinEquality
+	(
+	const CCompactHistogram *pchist,
+	SBucketIntersection *rgbi,
+	CDouble *pdFreqJoinBuckets1,
+	CDouble *pdFreqJoinBuckets2
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pchist);
+	GPOS_ASSERT(NULL != rgbi);
+	GPOS_ASSERT(m_em == pchist->m_em);
+
+	CDouble dFreqJoinBuckets1(0.0);
+	CDouble dFreqJoinBuckets2(0.0);
+
+	ULONG ulResults = 0;
+	ULONG ul1 = 0;
+	ULONG ul2 = 0;
+	while (ul1 < m_ulBuckets && ul2 < pchist->m_ulBuckets)
+	{
+		if (FIntersects(ul1, pchist, ul2))
+		{
+			CDouble dFreqIntersect1(0.0);
+			CDouble dFreqIntersect2(0.0);
+			Intersect(ul1, pchist, ul2, &rgbi[ulResults], &dFreqIntersect1, &dFreqIntersect2);
+			ulResults++;
+
+			dFreqJoinBuckets1 = dFreqJoinBuckets1 + dFreqIntersect1;
+			dFreqJoinBuckets2 = dFreqJoinBuckets2 + dFreqIntersect2;
+
+			INT iRes = ICompare(m_rgdUpper[ul1], pchist->m_rgdUpper[ul2]);
+			if (0 == iRes)
+			{
+				ul1++;
+				ul2++;
+			}
+			else if (0 > iRes)
+			{
+				ul1++;
+			}
+			else
+			{
+				ul2++;
+			}
+		}
+		else if (0 >= ICompare(m_rgdUpper[ul1], pchist->m_rgdLower[ul2]))
+		{
+			// bucket of this histogram is before bucket of other histogram
+			ul1++;
+		}
+		else
+		{
+			ul2++;
+		}
+	}
+
+	*pdFreqJoinBuckets1 = dFreqJoinBuckets1;
+	*pdFreqJoinBuckets2 = dFreqJoinBuckets2;
+
+	return ulResults;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCompactHistogram::PchistCreate
+//
+//	@doc:
+//		Create compact copy of given buckets; returns NULL if any bound
+//		cannot be mapped, or bounds use different mappings
+//
+//---------------------------------------------------------------------------
+CCompactHistogram *
+CCompactHistogram::PchistCreate
+	(
+	IMemoryPool *pmp,
+	const DrgPbucket *pdrgpbucket
+	)
+{
+	GPOS_ASSERT(NULL != pdrgpbucket);
+
+	const ULONG ulBuckets = pdrgpbucket->UlLength();
+	if (0 == ulBuckets)
+	{
+		return NULL;
+	}
+
+	// all bounds must share the mapping of the first lower bound
+	EMapping em = EmSentinel;
+	DOUBLE dFirst = 0.0;
+	if (!FMap((*pdrgpbucket)[0]->PpLower()->Pdatum(), &em, &dFirst))
+	{
+		return NULL;
+	}
+
+	CCompactHistogram *pchist = GPOS_NEW(pmp) CCompactHistogram(pmp, ulBuckets, em);
+	for (ULONG ul = 0; ul < ulBuckets; ul++)
+	{
+		CBucket *pbucket = (*pdrgpbucket)[ul];
+		EMapping emLower = EmSentinel;
+		EMapping emUpper = EmSentinel;
+		if (!FMap(pbucket->PpLower()->Pdatum(), &emLower, &pchist->m_rgdLower[ul]) ||
+			!FMap(pbucket->PpUpper()->Pdatum(), &emUpper, &pchist->m_rgdUpper[ul]) ||
+			em != emLower || em != emUpper)
+		{
+			pchist->Release();
+			return NULL;
+		}
+
+		pchist->m_rgfLowerClosed[ul] = pbucket->FLowerClosed();
+		pchist->m_rgfUpperClosed[ul] = pbucket->FUpperClosed();
+		pchist->m_rgdFrequency[ul] = pbucket->DFrequency().DVal();
+		pchist->m_rgdDistinct[ul] = pbucket->DDistinct().DVal();
+	}
+
+	return pchist;
+}
+
+// EOF
@@ -0,0 +1,165 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CHLLSketch.cpp
+//
+//	@doc:
+//		Implementation of HyperLogLog sketches of column values
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+
+#include "naucrates/statistics/CHLLSketch.h"
+
+using namespace gpnaucrates;
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHLLSketch::CHLLSketch
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CHLLSketch::CHLLSketch
+	(
+	ULONG ulPrecision,
+	BYTE *pbaRegisters
+	)
+	:
+	m_ulPrecision(ulPrecision),
+	m_pbaRegisters(pbaRegisters),
+	m_ulRegisters(ULONG(1) << ulPrecision),
+	m_dDistinct(0.0)
+{
+	GPOS_ASSERT(4 <= ulPrecision && 31 > ulPrecision);
+	GPOS_ASSERT(NULL != pbaRegisters);
+
+	m_dDistinct = DEstimate();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHLLSketch::~CHLLSketch
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CHLLSketch::~CHLLSketch()
+{
+	GPOS_DELETE_ARRAY(m_pbaRegisters);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHLLSketch::DEstimate
+//
+//	@doc:
+//		Estimate the number of distinct values as the bias corrected
+//		harmonic mean of 2^register over all registers; small cardinalities,
+//		where some registers are still zero, are estimated by linear counting
+//
+//---------------------------------------------------------------------------
+CDouble
+CHLLSketch::DEstimate() const
+{
+	DOUBLE dRegisters = (DOUBLE) m_ulRegisters;
+
+	DOUBLE dAlpha = 0.7213 / (1.0 + 1.079 / dRegisters);
+	if (16 == m_ulRegisters)
+	{
+		dAlpha = 0.673;
+	}
+	else if (32 == m_ulRegisters)
+	{
+		dAlpha = 0.697;
+	}
+	else if (64 == m_ulRegisters)
+	{
+		dAlpha = 0.709;
+	}
+
+	DOUBLE dSum = 0.0;
+	ULONG ulZeros = 0;
+	for (ULONG ul = 0; ul < m_ulRegisters; ul++)
+	{
+		ULONG ulRank = std::min((ULONG) m_pbaRegisters[ul], (ULONG) 63);
+		dSum += 1.0 / (DOUBLE) (ULLONG(1) << ulRank);
+		if (0 == ulRank)
+		{
+			ulZeros++;
+		}
+	}
+
+	DOUBLE dEstimate = dAlpha * dRegisters * dRegisters / dSum;
+	if (0 < ulZeros && dEstimate <= 2.5 * dRegisters)
+	{
+		// linear counting: m * ln(m / zeros)
+		const DOUBLE dLn2 = 0.6931471805599453;
+		dEstimate = dRegisters * CDouble(dRegisters / (DOUBLE) ulZeros).FpLog2().DVal() * dLn2;
+	}
+
+	return CDouble(dEstimate);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHLLSketch::PhllMerge
+//
+//	@doc:
+//		Sketch of the union of the values of this and the given sketch
+//
+//---------------------------------------------------------------------------
+CHLLSketch *
+CHLLSketch::PhllMerge
+	(
+	IMemoryPool *pmp,
+	const CHLLSketch *phll
+	)
+	const
+{
+	GPOS_ASSERT(NULL != phll);
+
+	if (m_ulPrecision != phll->m_ulPrecision)
+	{
+		return NULL;
+	}
+
+	BYTE *pbaRegisters = GPOS_NEW_ARRAY(pmp, BYTE, m_ulRegisters);
+	for (ULONG ul = 0; ul < m_ulRegisters; ul++)
+	{
+		pbaRegisters[ul] = std::max(m_pbaRegisters[ul], phll->m_pbaRegisters[ul]);
+	}
+
+	return GPOS_NEW(pmp) CHLLSketch(m_ulPrecision, pbaRegisters);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHLLSketch::OsPrint
+//
+//	@doc:
+//		Print function
+//
+//---------------------------------------------------------------------------
+IOstream &
+CHLLSketch::OsPrint
+	(
+	IOstream &os
+	)
+	const
+{
+	os << "precision = " << m_ulPrecision << ", distinct = " << m_dDistinct;
+
+	return os;
+}
+
+// EOF
@@ -17,6 +17,7 @@
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
 #include "gpos/common/syslibwrapper.h"
+#include "gpos/common/CAutoRg.h"
 
 #include "naucrates/statistics/CStatistics.h"
 #include "naucrates/statistics/CStatisticsUtils.h"
@@ -47,6 +48,9 @@ const CDouble CHistogram::DDefaultNDVRemain(0.0);
 // default frequency of NDV remain
 const CDouble CHistogram::DDefaultNDVFreqRemain(0.0);
 
+// minimum number of buckets for building compact buckets
+const ULONG CHistogram::UlMinBucketsCompact(16);
+
 // sample size used to estimate skew
 #define GPOPT_SKEW_SAMPLE_SIZE 1000
 
@@ -65,7 +69,8 @@ CHistogram::CHistogram
 	m_fSkewMeasured(false),
 	m_dSkew(1.0),
 	m_fNDVScaled(false),
-	m_fColStatsMissing(false)
+	m_fColStatsMissing(false),
+	m_pchist(NULL)
 {
 	GPOS_ASSERT(NULL != pdrgppbucket);
 }
@@ -89,7 +94,8 @@ CHistogram::CHistogram
 	m_fSkewMeasured(false),
 	m_dSkew(1.0),
 	m_fNDVScaled(false),
-	m_fColStatsMissing(fColStatsMissing)
+	m_fColStatsMissing(fColStatsMissing),
+	m_pchist(NULL)
 {
 	GPOS_ASSERT(m_pdrgppbucket);
 	GPOS_ASSERT(CDouble(0.0) <= dNullFreq);
@@ -151,6 +157,80 @@ CHistogram::OsPrint
 	return os;
 }
 
+// build compact buckets; filtering a histogram repeatedly, e.g., with the
+// points of an IN list, then locates the affected bucket by binary search;
+// histograms are shared by statistics objects and by tasks deriving statistics
+// concurrently, so compact buckets are only built before a histogram is shared
+void
+CHistogram::BuildCompact
+	(
+	IMemoryPool *pmp
+	)
+{
+	GPOS_ASSERT(1 == UlpRefCount() && "Building compact buckets of a shared histogram");
+
+	if (NULL != m_pchist || !m_fWellDefined || UlMinBucketsCompact > m_pdrgppbucket->UlLength())
+	{
+		return;
+	}
+
+	m_pchist = CCompactHistogram::PchistCreate(pmp, m_pdrgppbucket);
+}
+
+// histogram with compact buckets built on a copy owned by the caller; returns
+// this histogram if it already has compact buckets or would not benefit from them
+CHistogram *
+CHistogram::PhistCompact
+	(
+	IMemoryPool *pmp
+	)
+{
+	if (NULL != m_pchist || !m_fWellDefined || UlMinBucketsCompact > m_pdrgppbucket->UlLength())
+	{
+		AddRef();
+
+		return this;
+	}
+
+	CHistogram *phistCompact = PhistCopy(pmp);
+	phistCompact->BuildCompact(pmp);
+
+	return phistCompact;
+}
+
+// release compact buckets
+void
+CHistogram::ReleaseCompact()
+{
+	CRefCount::SafeRelease(m_pchist);
+	m_pchist = NULL;
+}
+
+// find the only bucket that can contain given point using compact buckets;
+// all buckets before the returned index lie entirely before the point;
+// returns false if there are no compact buckets or point cannot be mapped
+BOOL
+CHistogram::FCandidateBucket
+	(
+	const CPoint *ppoint,
+	ULONG *pulBucketIdx
+	)
+	const
+{
+	GPOS_ASSERT(NULL != ppoint);
+	GPOS_ASSERT(NULL != pulBucketIdx);
+
+	DOUBLE d = 0.0;
+	if (NULL == m_pchist || !m_pchist->FMap(ppoint, &d))
+	{
+		return false;
+	}
+
+	*pulBucketIdx = m_pchist->UlFirstNotAfter(d);
+
+	return true;
+}
+
 // check if histogram is empty
 BOOL
 CHistogram::FEmpty
@@ -175,7 +255,17 @@ CHistogram::PhistLessThanOrLessThanEqual
 	DrgPbucket *pdrgppbucketNew = GPOS_NEW(pmp) DrgPbucket(pmp);
 	const ULONG ulNumBuckets = m_pdrgppbucket->UlLength();
 
-	for (ULONG ulBucketIdx = 0; ulBucketIdx < ulNumBuckets; ulBucketIdx++)
+	// buckets before the candidate bucket qualify as a whole
+	ULONG ulFirst = 0;
+	if (FCandidateBucket(ppoint, &ulFirst))
+	{
+		for (ULONG ulBucketIdx = 0; ulBucketIdx < ulFirst; ulBucketIdx++)
+		{
+			pdrgppbucketNew->Append((*m_pdrgppbucket)[ulBucketIdx]->PbucketCopy(pmp));
+		}
+	}
+
+	for (ULONG ulBucketIdx = ulFirst; ulBucketIdx < ulNumBuckets; ulBucketIdx++)
 	{
 		CBucket *pbucket = (*m_pdrgppbucket)[ulBucketIdx];
 		if (pbucket->FBefore(ppoint))
@@ -230,11 +320,15 @@ CHistogram::PdrgppbucketNEqual
 	const ULONG ulNumBuckets = m_pdrgppbucket->UlLength();
 	bool fPointNull = ppoint->Pdatum()->FNull();
 
+	// only the candidate bucket, if known, needs to be checked for containment
+	ULONG ulCandidate = 0;
+	BOOL fCandidate = FCandidateBucket(ppoint, &ulCandidate);
+
 	for (ULONG ulBucketIdx = 0; ulBucketIdx < ulNumBuckets; ulBucketIdx++)
 	{
 		CBucket *pbucket = (*m_pdrgppbucket)[ulBucketIdx];
 
-		if (pbucket->FContains(ppoint) && !fPointNull)
+		if ((!fCandidate || ulCandidate == ulBucketIdx) && pbucket->FContains(ppoint) && !fPointNull)
 		{
 			CBucket *pbucketLT = pbucket->PbucketScaleUpper(pmp, ppoint, false /*fIncludeUpper */);
 			if (NULL != pbucketLT)
@@ -313,10 +407,18 @@ CHistogram::PdrgppbucketEqual
 		return pdrgppbucket;
 	}
 
-	const ULONG ulNumBuckets = m_pdrgppbucket->UlLength();
+	ULONG ulNumBuckets = m_pdrgppbucket->UlLength();
 	ULONG ulBucketIdx = 0;
 
-	for (ulBucketIdx = 0; ulBucketIdx < ulNumBuckets; ulBucketIdx++)
+	// only the candidate bucket, if known, can contain the point
+	ULONG ulCandidate = 0;
+	if (FCandidateBucket(ppoint, &ulCandidate))
+	{
+		ulBucketIdx = ulCandidate;
+		ulNumBuckets = std::min(ulNumBuckets, ulCandidate + 1);
+	}
+
+	for (; ulBucketIdx < ulNumBuckets; ulBucketIdx++)
 	{
 		CBucket *pbucket = (*m_pdrgppbucket)[ulBucketIdx];
 
@@ -438,9 +540,11 @@ CHistogram::PhistGreaterThanOrGreaterThanEqual
 	DrgPbucket *pdrgppbucketNew = GPOS_NEW(pmp) DrgPbucket(pmp);
 	const ULONG ulNumBuckets = m_pdrgppbucket->UlLength();
 
-	// find first bucket that contains ppoint
+	// find first bucket that contains ppoint, skipping buckets that lie
+	// entirely before the point if compact buckets are available
 	ULONG ulBucketIdx = 0;
-	for (ulBucketIdx = 0; ulBucketIdx < ulNumBuckets; ulBucketIdx++)
+	(void) FCandidateBucket(ppoint, &ulBucketIdx);
+	for (; ulBucketIdx < ulNumBuckets; ulBucketIdx++)
 	{
 		CBucket *pbucket = (*m_pdrgppbucket)[ulBucketIdx];
 		if (pbucket->FBefore(ppoint))
@@ -553,6 +657,7 @@ CHistogram::CapNDVs
 	}
 
 	m_fNDVScaled = true;
+	ReleaseCompact();
 
 	CDouble dScaleRatio = (dRows / dDistinct).DVal();
 	for (ULONG ul = 0; ul < ulBuckets; ul++)
@@ -565,6 +670,272 @@ CHistogram::CapNDVs
 	m_dDistinctRemain = m_dDistinctRemain * dScaleRatio;
 }
 
+// scale the number of distinct non-null values in buckets and remainder to
+// the given number, e.g. one that was estimated more accurately elsewhere;
+// unlike capping, this does not mark the NDVs as scaled by an operator;
+// for integral types, a bucket never gets more NDVs than values in its range
+void
+CHistogram::ScaleNDVs
+	(
+	CDouble dDistinct
+	)
+{
+	const ULONG ulBuckets = m_pdrgppbucket->UlLength();
+	BOOL fIntegral = false;
+	if (0 < ulBuckets)
+	{
+		IMDType::ETypeInfo eti = (*m_pdrgppbucket)[0]->PpLower()->Pdatum()->Eti();
+		fIntegral = (IMDType::EtiInt2 == eti || IMDType::EtiInt4 == eti ||
+					IMDType::EtiInt8 == eti || IMDType::EtiOid == eti);
+	}
+
+	CDouble dDistinctNonNull = m_dDistinctRemain;
+	for (ULONG ul = 0; ul < ulBuckets; ul++)
+	{
+		dDistinctNonNull = dDistinctNonNull + (*m_pdrgppbucket)[ul]->DDistinct();
+	}
+
+	if (CStatistics::DEpsilon >= dDistinctNonNull)
+	{
+		// nothing to scale
+		return;
+	}
+
+	ReleaseCompact();
+
+	CDouble dScaleRatio = dDistinct / dDistinctNonNull;
+	for (ULONG ul = 0; ul < ulBuckets; ul++)
+	{
+		CBucket *pbucket = (*m_pdrgppbucket)[ul];
+		DOUBLE dDistinctBucket = std::max(CHistogram::DMinDistinct.DVal(), (pbucket->DDistinct() * dScaleRatio).DVal());
+		if (fIntegral)
+		{
+			// number of integers in the bucket range, excluding open bounds
+			DOUBLE dValues = 1.0;
+			if (!pbucket->FSingleton())
+			{
+				dValues = pbucket->DWidth().DVal() + 1.0;
+				dValues = dValues - (pbucket->FLowerClosed() ? 0.0 : 1.0) - (pbucket->FUpperClosed() ? 0.0 : 1.0);
+			}
+			dDistinctBucket = std::min(dDistinctBucket, std::max(CHistogram::DMinDistinct.DVal(), dValues));
+		}
+		pbucket->SetDistinct(dDistinctBucket);
+	}
+
+	m_dDistinctRemain = m_dDistinctRemain * dScaleRatio;
+}
+
+// merge adjacent buckets until there are at most the given number of buckets;
+// each step merges the pair of adjacent buckets that misplaces the least
+// frequency when the combined frequency is spread evenly over the merged
+// bucket, so that frequencies and NDVs of the histogram are preserved while
+// the accumulated error, which is returned, bounds the change in selectivity
+// of any range predicate
+CDouble
+CHistogram::DCapBuckets
+	(
+	IMemoryPool *pmp,
+	ULONG ulMaxBuckets
+	)
+{
+	GPOS_ASSERT(0 < ulMaxBuckets);
+
+	ULONG ulBuckets = m_pdrgppbucket->UlLength();
+	if (ulBuckets <= ulMaxBuckets)
+	{
+		return CDouble(0.0);
+	}
+
+	ReleaseCompact();
+	m_fSkewMeasured = false;
+
+	// buckets are merged in an array of copies linked to their neighbors;
+	// each bucket that has a successor starts a pair, and pairs are kept in
+	// a min-heap by the error of merging them, so that each merge takes
+	// logarithmic time
+	CAutoRg<CBucket *> a_rgpbucket;
+	a_rgpbucket = GPOS_NEW_ARRAY(pmp, CBucket *, ulBuckets);
+	CAutoRg<ULONG> a_rgulPrev;
+	a_rgulPrev = GPOS_NEW_ARRAY(pmp, ULONG, ulBuckets);
+	CAutoRg<ULONG> a_rgulNext;
+	a_rgulNext = GPOS_NEW_ARRAY(pmp, ULONG, ulBuckets);
+	CAutoRg<DOUBLE> a_rgdError;
+	a_rgdError = GPOS_NEW_ARRAY(pmp, DOUBLE, ulBuckets);
+	CAutoRg<ULONG> a_rgulHeap;
+	a_rgulHeap = GPOS_NEW_ARRAY(pmp, ULONG, ulBuckets);
+	CAutoRg<ULONG> a_rgulPos;
+	a_rgulPos = GPOS_NEW_ARRAY(pmp, ULONG, ulBuckets);
+
+	for (ULONG ul = 0; ul < ulBuckets; ul++)
+	{
+		a_rgpbucket[ul] = (*m_pdrgppbucket)[ul]->PbucketCopy(pmp);
+		a_rgulPrev[ul] = (0 == ul) ? ULONG_MAX : ul - 1;
+		a_rgulNext[ul] = (ul + 1 == ulBuckets) ? ULONG_MAX : ul + 1;
+		a_rgulHeap[ul] = ul;
+		a_rgulPos[ul] = ul;
+	}
+	for (ULONG ul = 0; ul + 1 < ulBuckets; ul++)
+	{
+		a_rgdError[ul] = a_rgpbucket[ul]->DMergeAdjacentError(a_rgpbucket[ul + 1]).DVal();
+	}
+
+	// pairs are added to the heap one by one; the last bucket does not start a pair
+	ULONG ulHeapSize = 0;
+	a_rgulPos[ulBuckets - 1] = ULONG_MAX;
+	while (ulHeapSize + 1 < ulBuckets)
+	{
+		ulHeapSize++;
+		RestoreMergeHeap(a_rgulHeap.Rgt(), a_rgulPos.Rgt(), a_rgdError.Rgt(), ulHeapSize, ulHeapSize - 1);
+	}
+
+	CDouble dError(0.0);
+	while (ulBuckets > ulMaxBuckets)
+	{
+		const ULONG ulLeft = a_rgulHeap[0];
+		const ULONG ulRight = a_rgulNext[ulLeft];
+		GPOS_ASSERT(ULONG_MAX != ulRight);
+
+		dError = dError + a_rgdError[ulLeft];
+		CBucket *pbucketMerged = a_rgpbucket[ulLeft]->PbucketMergeAdjacent(pmp, a_rgpbucket[ulRight]);
+		GPOS_DELETE(a_rgpbucket[ulLeft]);
+		GPOS_DELETE(a_rgpbucket[ulRight]);
+		a_rgpbucket[ulLeft] = pbucketMerged;
+		a_rgpbucket[ulRight] = NULL;
+
+		// unlink the right bucket and drop the pair it started
+		a_rgulNext[ulLeft] = a_rgulNext[ulRight];
+		if (ULONG_MAX != a_rgulNext[ulRight])
+		{
+			a_rgulPrev[a_rgulNext[ulRight]] = ulLeft;
+		}
+		if (ULONG_MAX != a_rgulPos[ulRight])
+		{
+			RemoveFromMergeHeap(a_rgulHeap.Rgt(), a_rgulPos.Rgt(), a_rgdError.Rgt(), &ulHeapSize, a_rgulPos[ulRight]);
+		}
+		ulBuckets--;
+
+		// only the errors of merging with the new bucket have changed
+		if (ULONG_MAX != a_rgulNext[ulLeft])
+		{
+			a_rgdError[ulLeft] = pbucketMerged->DMergeAdjacentError(a_rgpbucket[a_rgulNext[ulLeft]]).DVal();
+			RestoreMergeHeap(a_rgulHeap.Rgt(), a_rgulPos.Rgt(), a_rgdError.Rgt(), ulHeapSize, a_rgulPos[ulLeft]);
+		}
+		else
+		{
+			RemoveFromMergeHeap(a_rgulHeap.Rgt(), a_rgulPos.Rgt(), a_rgdError.Rgt(), &ulHeapSize, a_rgulPos[ulLeft]);
+		}
+
+		const ULONG ulPrev = a_rgulPrev[ulLeft];
+		if (ULONG_MAX != ulPrev)
+		{
+			a_rgdError[ulPrev] = a_rgpbucket[ulPrev]->DMergeAdjacentError(pbucketMerged).DVal();
+			RestoreMergeHeap(a_rgulHeap.Rgt(), a_rgulPos.Rgt(), a_rgdError.Rgt(), ulHeapSize, a_rgulPos[ulPrev]);
+		}
+	}
+
+	// the first bucket is never merged into its predecessor, so the list starts there
+	DrgPbucket *pdrgppbucket = GPOS_NEW(pmp) DrgPbucket(pmp, ulBuckets);
+	for (ULONG ul = 0; ULONG_MAX != ul; ul = a_rgulNext[ul])
+	{
+		pdrgppbucket->Append(a_rgpbucket[ul]);
+	}
+	GPOS_ASSERT(ulBuckets == pdrgppbucket->UlLength());
+
+	m_pdrgppbucket->Release();
+	m_pdrgppbucket = pdrgppbucket;
+
+	return dError;
+}
+
+// restore the order of a min-heap of adjacent bucket pairs after the entry at
+// the given position changed, all other entries being in heap order; pairs
+// with equal errors are ordered by their position in the histogram so that
+// the leftmost of them is merged first
+void
+CHistogram::RestoreMergeHeap
+	(
+	ULONG *rgulHeap,
+	ULONG *rgulPos,
+	const DOUBLE *rgdError,
+	ULONG ulSize,
+	ULONG ulPos
+	)
+{
+	GPOS_ASSERT(ulPos < ulSize);
+
+	const ULONG ulPair = rgulHeap[ulPos];
+
+	// sift up
+	while (0 < ulPos)
+	{
+		const ULONG ulParent = (ulPos - 1) / 2;
+		const ULONG ulPairParent = rgulHeap[ulParent];
+		if (rgdError[ulPairParent] < rgdError[ulPair] ||
+			(rgdError[ulPairParent] == rgdError[ulPair] && ulPairParent < ulPair))
+		{
+			break;
+		}
+
+		rgulHeap[ulPos] = ulPairParent;
+		rgulPos[ulPairParent] = ulPos;
+		ulPos = ulParent;
+	}
+
+	// sift down
+	while (2 * ulPos + 1 < ulSize)
+	{
+		ULONG ulChild = 2 * ulPos + 1;
+		if (ulChild + 1 < ulSize)
+		{
+			const ULONG ulPairLeft = rgulHeap[ulChild];
+			const ULONG ulPairRight = rgulHeap[ulChild + 1];
+			if (rgdError[ulPairRight] < rgdError[ulPairLeft] ||
+				(rgdError[ulPairRight] == rgdError[ulPairLeft] && ulPairRight < ulPairLeft))
+			{
+				ulChild++;
+			}
+		}
+
+		const ULONG ulPairChild = rgulHeap[ulChild];
+		if (rgdError[ulPair] < rgdError[ulPairChild] ||
+			(rgdError[ulPair] == rgdError[ulPairChild] && ulPair < ulPairChild))
+		{
+			break;
+		}
+
+		rgulHeap[ulPos] = ulPairChild;
+		rgulPos[ulPairChild] = ulPos;
+		ulPos = ulChild;
+	}
+
+	rgulHeap[ulPos] = ulPair;
+	rgulPos[ulPair] = ulPos;
+}
+
+// remove the entry at the given position from a min-heap of adjacent bucket pairs
+void
+CHistogram::RemoveFromMergeHeap
+	(
+	ULONG *rgulHeap,
+	ULONG *rgulPos,
+	const DOUBLE *rgdError,
+	ULONG *pulSize,
+	ULONG ulPos
+	)
+{
+	GPOS_ASSERT(ulPos < *pulSize);
+
+	rgulPos[rgulHeap[ulPos]] = ULONG_MAX;
+	(*pulSize)--;
+	if (ulPos < *pulSize)
+	{
+		// move the last entry into the hole and restore the heap order
+		rgulHeap[ulPos] = rgulHeap[*pulSize];
+		rgulPos[rgulHeap[ulPos]] = ulPos;
+		RestoreMergeHeap(rgulHeap, rgulPos, rgdError, *pulSize, ulPos);
+	}
+}
+
 // sum of frequencies is approx 1.0
 BOOL
 CHistogram::FNormalized
@@ -634,6 +1005,85 @@ CHistogram::PhistFilterNormalized
 	return phistAfter;
 }
 
+// can the buckets be matched against the given LIKE pattern; this needs
+// bucket bounds of a string type that can be compared by their bytes
+BOOL
+CHistogram::FSupportsLikeFilter
+	(
+	const IDatum *pdatumPattern
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pdatumPattern);
+
+	if (!FWellDefined() || 0 == UlBuckets() || pdatumPattern->FNull() || !pdatumPattern->FSupportLikePredicate())
+	{
+		return false;
+	}
+
+	const IDatum *pdatum = (*m_pdrgppbucket)[0]->PpLower()->Pdatum();
+
+	return pdatum->FSupportsBinaryComp(pdatumPattern) && pdatumPattern->FSupportsBinaryComp(pdatum);
+}
+
+// filter by a LIKE pattern and normalize; the most common values, which are
+// singleton buckets, are matched against the pattern, and the default
+// selectivity of the pattern applies to the other buckets and to the values
+// not covered by buckets. Range buckets are never dropped: text histograms
+// are sorted in the collation order of the column, which is not known here,
+// so a range bucket may hold matching values whatever its bounds are.
+CHistogram *
+CHistogram::PhistLikeFilterNormalized
+	(
+	IMemoryPool *pmp,
+	const IDatum *pdatumPattern,
+	CDouble dDefaultScaleFactor,
+	CDouble *pdScaleFactor
+	)
+	const
+{
+	GPOS_ASSERT(FSupportsLikeFilter(pdatumPattern));
+	GPOS_ASSERT(CDouble(1.0) <= dDefaultScaleFactor);
+
+	const CDouble dDefaultSelectivity = CDouble(1.0) / dDefaultScaleFactor;
+
+	DrgPbucket *pdrgppbucketNew = GPOS_NEW(pmp) DrgPbucket(pmp);
+	const ULONG ulBuckets = m_pdrgppbucket->UlLength();
+	for (ULONG ul = 0; ul < ulBuckets; ul++)
+	{
+		CBucket *pbucket = (*m_pdrgppbucket)[ul];
+
+		CDouble dSelectivity = dDefaultSelectivity;
+		if (pbucket->FSingleton())
+		{
+			dSelectivity = pbucket->PpLower()->Pdatum()->FLikeMatch(pdatumPattern) ? 1.0 : 0.0;
+		}
+
+		if (CStatistics::DEpsilon < dSelectivity)
+		{
+			CBucket *pbucketNew = pbucket->PbucketCopy(pmp);
+			pbucketNew->SetFrequency(pbucket->DFrequency() * dSelectivity);
+			pbucketNew->SetDistinct(std::max(CHistogram::DMinDistinct.DVal(), (pbucket->DDistinct() * dSelectivity).DVal()));
+			pdrgppbucketNew->Append(pbucketNew);
+		}
+	}
+
+	// nulls never match a LIKE pattern
+	CHistogram *phistAfter = GPOS_NEW(pmp) CHistogram
+										(
+										pdrgppbucketNew,
+										true /* fWellDefined */,
+										CDouble(0.0) /* dNullFreq */,
+										m_dDistinctRemain * dDefaultSelectivity,
+										m_dFreqRemain * dDefaultSelectivity
+										);
+
+	*pdScaleFactor = phistAfter->DNormalize();
+	GPOS_ASSERT(phistAfter->FValid());
+
+	return phistAfter;
+}
+
 // construct new histogram by joining with another and normalize
 // output histogram. If the join is not an equality join the function
 // returns an empty histogram
@@ -738,7 +1188,7 @@ CHistogram::DInEqualityJoinScaleFactor
 								dRowsOther,
 								&dScaleFactor
 								);
-	GPOS_DELETE(phistJoin);
+	phistJoin->Release();
 
 	CDouble dCartesianProduct = dRows * dRowsOther;
 
@@ -990,6 +1440,7 @@ CHistogram::DNormalize()
 	}
 
 	CDouble dScaleFactor = std::max(DOUBLE(1.0), (CDouble(1.0) / DFrequency()).DVal());
+	ReleaseCompact();
 
 	for (ULONG ul = 0; ul < m_pdrgppbucket->UlLength(); ul++)
 	{
@@ -1030,6 +1481,13 @@ CHistogram::PhistCopy
 		phistCopy->SetNDVScaled();
 	}
 
+	// copied buckets are identical, share their compact form
+	if (NULL != m_pchist)
+	{
+		m_pchist->AddRef();
+		phistCopy->m_pchist = m_pchist;
+	}
+
 	return phistCopy;
 }
 
@@ -1141,49 +1599,57 @@ CHistogram::PhistJoinEquality
 								);
 	}
 
-	while (ul1 < ulBuckets1 && ul2 < ulBuckets2)
+	if (NULL != m_pchist && NULL != phist->m_pchist && m_pchist->Em() == phist->m_pchist->Em())
 	{
-		CBucket *pbucket1 = (*m_pdrgppbucket)[ul1];
-		CBucket *pbucket2 = (*phist->m_pdrgppbucket)[ul2];
-
-		if (pbucket1->FIntersects(pbucket2))
+		// align buckets using the compact bucket arrays
+		JoinEqualityCompact(pmp, phist, pdrgppbucketJoin, &dFreqJoinBuckets1, &dFreqJoinBuckets2);
+	}
+	else
+	{
+		while (ul1 < ulBuckets1 && ul2 < ulBuckets2)
 		{
-			CDouble dFreqIntersect1(0.0);
-			CDouble dFreqIntersect2(0.0);
+			CBucket *pbucket1 = (*m_pdrgppbucket)[ul1];
+			CBucket *pbucket2 = (*phist->m_pdrgppbucket)[ul2];
+
+			if (pbucket1->FIntersects(pbucket2))
+			{
+				CDouble dFreqIntersect1(0.0);
+				CDouble dFreqIntersect2(0.0);
 
-			CBucket *pbucketNew = pbucket1->PbucketIntersect(pmp, pbucket2, &dFreqIntersect1, &dFreqIntersect2);
-			pdrgppbucketJoin->Append(pbucketNew);
+				CBucket *pbucketNew = pbucket1->PbucketIntersect(pmp, pbucket2, &dFreqIntersect1, &dFreqIntersect2);
+				pdrgppbucketJoin->Append(pbucketNew);
 
-			dFreqJoinBuckets1 = dFreqJoinBuckets1 + dFreqIntersect1;
-			dFreqJoinBuckets2 = dFreqJoinBuckets2 + dFreqIntersect2;
+				dFreqJoinBuckets1 = dFreqJoinBuckets1 + dFreqIntersect1;
+				dFreqJoinBuckets2 = dFreqJoinBuckets2 + dFreqIntersect2;
 
-			INT iRes = CBucket::ICompareUpperBounds(pbucket1, pbucket2);
-			if (0 == iRes)
-			{
-				// both ubs are equal
-				ul1++;
-				ul2++;
+				INT iRes = CBucket::ICompareUpperBounds(pbucket1, pbucket2);
+				if (0 == iRes)
+				{
+					// both ubs are equal
+					ul1++;
+					ul2++;
+				}
+				else if (1 > iRes)
+				{
+					// pbucket1's ub is smaller than that of the ub of pbucket2
+					ul1++;
+				}
+				else
+				{
+					ul2++;
+				}
 			}
-			else if (1 > iRes)
+			else if (pbucket1->FBefore(pbucket2))
 			{
-				// pbucket1's ub is smaller than that of the ub of pbucket2
+				// buckets do not intersect there one bucket is before the other
 				ul1++;
 			}
 			else
 			{
+				GPOS_ASSERT(pbucket2->FBefore(pbucket1));
 				ul2++;
 			}
 		}
-		else if (pbucket1->FBefore(pbucket2))
-		{
-			// buckets do not intersect there one bucket is before the other
-			ul1++;
-		}
-		else
-		{
-			GPOS_ASSERT(pbucket2->FBefore(pbucket1));
-			ul2++;
-		}
 	}
 
 	ComputeJoinNDVRemainInfo
@@ -1200,6 +1666,54 @@ CHistogram::PhistJoinEquality
 	return GPOS_NEW(pmp) CHistogram(pdrgppbucketJoin, true /*fWellDefined*/, 0.0 /*dNullFreq*/, dDistinctRemain, dFreqRemain);
 }
 
+// align buckets of an equality join using compact buckets of both histograms;
+// bounds of the resulting buckets are shared with the input buckets
+void
+CHistogram::JoinEqualityCompact
+	(
+	IMemoryPool *pmp,
+	const CHistogram *phist,
+	DrgPbucket *pdrgppbucketJoin,
+	CDouble *pdFreqJoinBuckets1,
+	CDouble *pdFreqJoinBuckets2
+	)
+	const
+{
+	GPOS_ASSERT(NULL != m_pchist);
+	GPOS_ASSERT(NULL != phist->m_pchist);
+
+	const ULONG ulMaxResults = m_pchist->UlBuckets() + phist->m_pchist->UlBuckets();
+	CCompactHistogram::SBucketIntersection *rgbi = GPOS_NEW_ARRAY(pmp, CCompactHistogram::SBucketIntersection, ulMaxResults);
+	const ULONG ulResults = m_pchist->UlJoinEquality(phist->m_pchist, rgbi, pdFreqJoinBuckets1, pdFreqJoinBuckets2);
+
+	for (ULONG ul = 0; ul < ulResults; ul++)
+	{
+		const CCompactHistogram::SBucketIntersection &bi = rgbi[ul];
+		CBucket *pbucket1 = (*m_pdrgppbucket)[bi.m_ul1];
+		CBucket *pbucket2 = (*phist->m_pdrgppbucket)[bi.m_ul2];
+
+		CPoint *ppLower = bi.m_fLowerFrom1 ? pbucket1->PpLower() : pbucket2->PpLower();
+		CPoint *ppUpper = bi.m_fUpperFrom1 ? pbucket1->PpUpper() : pbucket2->PpUpper();
+		ppLower->AddRef();
+		ppUpper->AddRef();
+
+		pdrgppbucketJoin->Append
+							(
+							GPOS_NEW(pmp) CBucket
+										(
+										ppLower,
+										ppUpper,
+										bi.m_fLowerClosed,
+										bi.m_fUpperClosed,
+										CDouble(bi.m_dFrequency),
+										CDouble(bi.m_dDistinct)
+										)
+							);
+	}
+
+	GPOS_DELETE_ARRAY(rgbi);
+}
+
 // construct a new histogram for an INDF join predicate
 CHistogram *
 CHistogram::PhistJoinINDF
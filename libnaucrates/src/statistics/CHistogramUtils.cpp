@@ -14,16 +14,234 @@
 #include "naucrates/statistics/CStatisticsUtils.h"
 #include "naucrates/statistics/CScaleFactorUtils.h"
 
+#include "gpos/common/CAutoRg.h"
 #include "gpos/common/CBitSet.h"
 #include "gpos/memory/CAutoMemoryPool.h"
+#include "gpos/task/CAutoTaskProxy.h"
+#include "gpos/task/CWorker.h"
 
 #include "gpopt/base/CColumnFactory.h"
+#include "gpopt/base/COptCtxt.h"
 
 #include "gpopt/engine/CStatisticsConfig.h"
 #include "gpopt/optimizer/COptimizerConfig.h"
 
 using namespace gpopt;
 
+// maximum number of worker tasks deriving histograms of one operator
+const ULONG CHistogramUtils::ulHistogramTasksMax = 8;
+
+// derive histograms of columns; the derived histogram of each input histogram is
+// returned in the same position of the output array, which holds a new reference;
+// if a derivation fails, no output histograms are returned
+void
+CHistogramUtils::DeriveHistograms
+	(
+	IMemoryPool *pmp,
+	CStatisticsConfig *pstatsconf,
+	EHistogramOp ehop,
+	CDouble dRows,
+	ULONG ulHists,
+	CHistogram **rgphistInput,
+	CHistogram **rgphistOutput
+	)
+{
+	GPOS_ASSERT(NULL != pstatsconf);
+	GPOS_ASSERT(EhopSentinel > ehop);
+	GPOS_ASSERT_IMP(0 < ulHists, NULL != rgphistInput && NULL != rgphistOutput);
+
+	SHistogramTaskArg harg = {pmp, ehop, dRows.DVal(), rgphistInput, rgphistOutput, 0, ulHists};
+
+	for (ULONG ul = 0; ul < ulHists; ul++)
+	{
+		rgphistOutput[ul] = NULL;
+	}
+
+	GPOS_TRY
+	{
+		DeriveHistogramsOnTasks(pmp, pstatsconf, &harg);
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		// release the histograms derived by the tasks that did not fail
+		for (ULONG ul = 0; ul < ulHists; ul++)
+		{
+			CRefCount::SafeRelease(rgphistOutput[ul]);
+			rgphistOutput[ul] = NULL;
+		}
+
+		GPOS_RETHROW(ex);
+	}
+	GPOS_CATCH_END;
+}
+
+// derive histograms on worker tasks if there are enough of them to be worth
+// it; a task running on a pool worker derives them itself, as waiting for
+// nested tasks could block the workers those tasks need
+void
+CHistogramUtils::DeriveHistogramsOnTasks
+	(
+	IMemoryPool *pmp,
+	CStatisticsConfig *pstatsconf,
+	const SHistogramTaskArg *pharg
+	)
+{
+	const ULONG ulHists = pharg->m_ulEnd;
+
+	CWorkerPoolManager *pwpm = CWorkerPoolManager::Pwpm();
+	CWorker *pwrkr = CWorker::PwrkrSelf();
+	if (ulHists < pstatsconf->UlParallelHistogramsThreshold() ||
+		(NULL != pwrkr && pwrkr->FPoolWorker()))
+	{
+		DeriveHistogramRange(pharg);
+
+		return;
+	}
+
+	const ULONG ulTasks = std::min(ulHistogramTasksMax, std::min(pwpm->UlWorkersIdle(), ulHists));
+	if (2 > ulTasks)
+	{
+		DeriveHistogramRange(pharg);
+
+		return;
+	}
+
+	CAutoRg<SHistogramTaskArg> a_rgharg;
+	a_rgharg = GPOS_NEW_ARRAY(pmp, SHistogramTaskArg, ulTasks);
+
+	CAutoRg<CTask*> a_rgptsk;
+	a_rgptsk = GPOS_NEW_ARRAY(pmp, CTask*, ulTasks);
+
+	// each task derives a contiguous range of histograms into its own positions of
+	// the output array, so the result does not depend on the order tasks run in;
+	// the task proxy waits for all tasks before an error leaves this scope
+	CAutoTaskProxy atp(pmp, pwpm);
+
+	for (ULONG ul = 0; ul < ulTasks; ul++)
+	{
+		a_rgharg[ul] = *pharg;
+		a_rgharg[ul].m_ulStart = ul * ulHists / ulTasks;
+		a_rgharg[ul].m_ulEnd = (ul + 1) * ulHists / ulTasks;
+
+		a_rgptsk[ul] = atp.PtskCreate(PvDeriveHistograms, &a_rgharg[ul]);
+
+		// histogram derivation needs the optimizer context in task local storage
+		a_rgptsk[ul]->Tls().Reset(pmp);
+		a_rgptsk[ul]->Tls().Store(COptCtxt::PoctxtFromTLS());
+	}
+
+	for (ULONG ul = 0; ul < ulTasks; ul++)
+	{
+		atp.Schedule(a_rgptsk[ul]);
+	}
+
+	// errors of tasks are propagated to the current task
+	for (ULONG ul = 0; ul < ulTasks; ul++)
+	{
+		CTask *ptsk = NULL;
+		atp.WaitAny(&ptsk);
+	}
+}
+
+// worker task function deriving a range of histograms
+void *
+CHistogramUtils::PvDeriveHistograms
+	(
+	void *pv
+	)
+{
+	GPOS_ASSERT(NULL != pv);
+
+	DeriveHistogramRange(reinterpret_cast<SHistogramTaskArg *>(pv));
+
+	return NULL;
+}
+
+// derive the histograms in the range of given task arguments
+void
+CHistogramUtils::DeriveHistogramRange
+	(
+	const SHistogramTaskArg *pharg
+	)
+{
+	GPOS_ASSERT(NULL != pharg);
+
+	for (ULONG ul = pharg->m_ulStart; ul < pharg->m_ulEnd; ul++)
+	{
+		GPOS_CHECK_ABORT;
+
+		CHistogram *phist = pharg->m_rgphistInput[ul];
+		GPOS_ASSERT(NULL != phist);
+
+		CHistogram *phistOutput = NULL;
+		switch (pharg->m_ehop)
+		{
+			case EhopCapNDVs:
+				// histograms shared with other statistics objects are copied before capping;
+				// a histogram held by a single map entry is not visible to other tasks
+				if (1 < phist->UlpRefCount())
+				{
+					phistOutput = phist->PhistCopy(pharg->m_pmp);
+				}
+				else
+				{
+					phist->AddRef();
+					phistOutput = phist;
+				}
+				phistOutput->CapNDVs(pharg->m_dRows);
+				break;
+
+			case EhopGroupBy:
+			{
+				CDouble dDistinct(CHistogram::DMinDistinct);
+				phistOutput = phist->PhistGroupByNormalized(pharg->m_pmp, pharg->m_dRows, &dDistinct);
+				if (phist->FScaledNDV())
+				{
+					phistOutput->SetNDVScaled();
+				}
+				break;
+			}
+
+			default:
+				GPOS_ASSERT(!"Invalid histogram derivation");
+		}
+
+		pharg->m_rgphistOutput[ul] = phistOutput;
+	}
+}
+
+// cap the number of buckets of a derived histogram to the configured
+// maximum by merging adjacent buckets; takes ownership of the given
+// histogram, which is copied before merging when it is shared
+CHistogram *
+CHistogramUtils::PhistCapBuckets
+	(
+	IMemoryPool *pmp,
+	CStatisticsConfig *pstatsconf,
+	CHistogram *phist
+	)
+{
+	GPOS_ASSERT(NULL != pstatsconf);
+	GPOS_ASSERT(NULL != phist);
+
+	const ULONG ulMaxBuckets = pstatsconf->UlMaxHistogramBuckets();
+	if (phist->UlBuckets() <= ulMaxBuckets)
+	{
+		return phist;
+	}
+
+	if (1 < phist->UlpRefCount())
+	{
+		CHistogram *phistCopy = phist->PhistCopy(pmp);
+		phist->Release();
+		phist = phistCopy;
+	}
+
+	(void) phist->DCapBuckets(pmp, ulMaxBuckets);
+
+	return phist;
+}
+
 // append given histograms to current object
 void
 CHistogramUtils::AddHistograms
@@ -170,7 +388,7 @@ CHistogramUtils::PhistPointFilter
 CHistogram *
 CHistogramUtils::PhistUnsupportedPred
 	(
-	IMemoryPool *pmp,
+	IMemoryPool *, // pmp
 	CStatsPredUnsupported *pstatspred,
 	CBitSet *pbsFilterColIds,
 	CHistogram *phistBefore,
@@ -187,9 +405,9 @@ CHistogramUtils::PhistUnsupportedPred
 	// note column id
 	(void) pbsFilterColIds->FExchangeSet(ulColId);
 
-	// generate after histogram
-	CHistogram *phistAfter = phistBefore->PhistCopy(pmp);
-	GPOS_ASSERT(NULL != phistAfter);
+	// predicate does not change the histogram, share it
+	phistBefore->AddRef();
+	CHistogram *phistAfter = phistBefore;
 
 	*pdScaleFactorLast = *pdScaleFactorLast * pstatspred->DScaleFactor();
 	*pulColIdLast = ulColId;
@@ -217,10 +435,26 @@ CHistogramUtils::PhistLikeFilter
 
 	// note column id
 	(void) pbsFilterColIds->FExchangeSet(ulColId);
-	CHistogram *phistAfter = phistBefore->PhistCopy(pmp);
+	*pulColIdLast = ulColId;
+
+	const IDatum *pdatumPattern = pstatspred->PdatumPattern();
+	if (NULL != pdatumPattern && phistBefore->FSupportsLikeFilter(pdatumPattern))
+	{
+		// match the pattern against the buckets
+		CDouble dScaleFactorLocal(1.0);
+		CHistogram *phistAfter = phistBefore->PhistLikeFilterNormalized(pmp, pdatumPattern, pstatspred->DDefaultScaleFactor(), &dScaleFactorLocal);
+
+		GPOS_ASSERT(DOUBLE(1.0) <= dScaleFactorLocal.DVal());
+		*pdScaleFactorLast = *pdScaleFactorLast * dScaleFactorLocal;
+
+		return phistAfter;
+	}
+
+	// predicate does not change the histogram, share it
+	phistBefore->AddRef();
+	CHistogram *phistAfter = phistBefore;
 
 	*pdScaleFactorLast = *pdScaleFactorLast * pstatspred->DDefaultScaleFactor();
-	*pulColIdLast = ulColId;
 
 	return phistAfter;
 }
@@ -333,12 +567,11 @@ CHistogramUtils::PhmulhistApplyConjFilter
 		if (CStatsPred::EsptDisj != pstatspredChild->Espt())
 		{
 			GPOS_ASSERT(ULONG_MAX != ulColId);
-			phistBefore = phmulhistResult->PtLookup(&ulColId)->PhistCopy(pmp);
+			phistBefore = phmulhistResult->PtLookup(&ulColId);
 			GPOS_ASSERT(NULL != phistBefore);
 
 			CHistogram *phistResult = NULL;
 			phistResult = CHistogramUtils::PhistSimpleFilter(pmp, pstatspredChild, pbsFilterColIds, phistBefore, &dScaleFactorLast, &ulColIdLast);
-			GPOS_DELETE(phistBefore);
 
 			GPOS_ASSERT(NULL != phistResult);
 
@@ -352,7 +585,7 @@ CHistogramUtils::PhmulhistApplyConjFilter
 			}
 
 			CStatisticsUtils::AddHistogram(pmp, ulColId, phistResult, phmulhistResult, true /* fReplaceOld */);
-			GPOS_DELETE(phistResult);
+			phistResult->Release();
 		}
 		else
 		{
@@ -448,6 +681,9 @@ CHistogramUtils::PhmulhistApplyDisjFilter
 
 	HMUlHist *phmulhistResultDisj = GPOS_NEW(pmp) HMUlHist(pmp);
 
+	// compact copies of input histograms filtered by point predicates
+	HMUlHist *phmulhistCompact = GPOS_NEW(pmp) HMUlHist(pmp);
+
 	CHistogram *phistPrev = NULL;
 	ULONG ulColIdPrev = ULONG_MAX;
 	CDouble dScaleFactorPrev(dRowsInput);
@@ -498,6 +734,23 @@ CHistogramUtils::PhmulhistApplyDisjFilter
 		if (fPredSimple)
 		{
 			GPOS_ASSERT(NULL != phist);
+			if (CStatsPred::EsptPoint == pstatspredChild->Espt() && 1 < ulFilters)
+			{
+				// the same input histogram is filtered by each disjunct, e.g., by
+				// each point of an IN list; locate buckets by binary search in a
+				// compact copy, as the input histogram may be shared
+				CHistogram *phistCompact = phmulhistCompact->PtLookup(&ulColId);
+				if (NULL == phistCompact)
+				{
+					phistCompact = phist->PhistCompact(pmp);
+#ifdef GPOS_DEBUG
+					BOOL fResult =
+#endif // GPOS_DEBUG
+					phmulhistCompact->FInsert(GPOS_NEW(pmp) ULONG(ulColId), phistCompact);
+					GPOS_ASSERT(fResult);
+				}
+				phist = phistCompact;
+			}
 			phistDisjChildCol = CHistogramUtils::PhistSimpleFilter(pmp, pstatspredChild, pbsFilterColIds, phist, &dScaleFactorChild, &ulColIdPrev);
 
 			CHistogram *phistInput = phmulhistInput->PtLookup(&ulColId);
@@ -526,7 +779,8 @@ CHistogramUtils::PhmulhistApplyDisjFilter
 			if (fColIdPresent)
 			{
 				// conjunction or disjunction uses only a single column
-				phistDisjChildCol = phmulhistChild->PtLookup(&ulColId)->PhistCopy(pmp);
+				phistDisjChildCol = phmulhistChild->PtLookup(&ulColId);
+				phistDisjChildCol->AddRef();
 			}
 		}
 
@@ -548,10 +802,11 @@ CHistogramUtils::PhmulhistApplyDisjFilter
 				// statistics operation already conducted on this column
 				CDouble dRowOutput(0.0);
 				CHistogram *phistNew = phistPrev->PhistUnionNormalized(pmp, dRowsCumulative, phistDisjChildCol, dRowsDisjChild, &dRowOutput);
+				phistNew = PhistCapBuckets(pmp, pstatsconf, phistNew);
 				dRowsCumulative = dRowOutput;
 
-				GPOS_DELETE(phistPrev);
-				GPOS_DELETE(phistDisjChildCol);
+				phistPrev->Release();
+				phistDisjChildCol->Release();
 				phistPrev = phistNew;
 			}
 
@@ -609,6 +864,7 @@ CHistogramUtils::PhmulhistApplyDisjFilter
 	// clean up
 	pdrgpdScaleFactor->Release();
 	pbsFilterColIds->Release();
+	phmulhistCompact->Release();
 
 	return phmulhistResultDisj;
 }
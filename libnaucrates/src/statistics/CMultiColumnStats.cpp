@@ -0,0 +1,137 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMultiColumnStats.cpp
+//
+//	@doc:
+//		Implementation of statistics on a set of correlated columns
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+
+#include "naucrates/statistics/CMultiColumnStats.h"
+
+using namespace gpnaucrates;
+using namespace gpopt;
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMultiColumnStats::CMultiColumnStats
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CMultiColumnStats::CMultiColumnStats
+	(
+	IMemoryPool *pmp,
+	DrgPul *pdrgpulColId,
+	CDouble dDistinct,
+	CDouble dDependency
+	)
+	:
+	m_pdrgpulColId(pdrgpulColId),
+	m_pbsColId(NULL),
+	m_dDistinct(dDistinct),
+	m_dDependency(dDependency)
+{
+	GPOS_ASSERT(NULL != pdrgpulColId);
+	GPOS_ASSERT(1 < pdrgpulColId->UlLength());
+	GPOS_ASSERT(CDouble(0.0) <= dDistinct);
+	GPOS_ASSERT(CDouble(0.0) <= dDependency && CDouble(1.0) >= dDependency);
+
+	m_pbsColId = GPOS_NEW(pmp) CBitSet(pmp);
+	const ULONG ulCols = pdrgpulColId->UlLength();
+	for (ULONG ul = 0; ul < ulCols; ul++)
+	{
+		(void) m_pbsColId->FExchangeSet(*(*pdrgpulColId)[ul]);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMultiColumnStats::~CMultiColumnStats
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CMultiColumnStats::~CMultiColumnStats()
+{
+	m_pdrgpulColId->Release();
+	m_pbsColId->Release();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMultiColumnStats::PmcstatsCopyWithRemap
+//
+//	@doc:
+//		Copy with remapped column ids; returns NULL if any column is not mapped
+//
+//---------------------------------------------------------------------------
+CMultiColumnStats *
+CMultiColumnStats::PmcstatsCopyWithRemap
+	(
+	IMemoryPool *pmp,
+	HMUlCr *phmulcr
+	)
+	const
+{
+	GPOS_ASSERT(NULL != phmulcr);
+
+	DrgPul *pdrgpulColId = GPOS_NEW(pmp) DrgPul(pmp);
+	const ULONG ulCols = m_pdrgpulColId->UlLength();
+	for (ULONG ul = 0; ul < ulCols; ul++)
+	{
+		ULONG ulColId = *(*m_pdrgpulColId)[ul];
+		const CColRef *pcrNew = phmulcr->PtLookup(&ulColId);
+		if (NULL == pcrNew)
+		{
+			pdrgpulColId->Release();
+			return NULL;
+		}
+
+		pdrgpulColId->Append(GPOS_NEW(pmp) ULONG(pcrNew->UlId()));
+	}
+
+	return GPOS_NEW(pmp) CMultiColumnStats(pmp, pdrgpulColId, m_dDistinct, m_dDependency);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMultiColumnStats::OsPrint
+//
+//	@doc:
+//		Print function
+//
+//---------------------------------------------------------------------------
+IOstream &
+CMultiColumnStats::OsPrint
+	(
+	IOstream &os
+	)
+	const
+{
+	os << "{";
+	const ULONG ulCols = m_pdrgpulColId->UlLength();
+	for (ULONG ul = 0; ul < ulCols; ul++)
+	{
+		if (0 < ul)
+		{
+			os << ", ";
+		}
+		os << *(*m_pdrgpulColId)[ul];
+	}
+	os << "}: distinct = " << m_dDistinct << ", dependency = " << m_dDependency;
+
+	return os;
+}
+
+// EOF
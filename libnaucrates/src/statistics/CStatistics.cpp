@@ -16,6 +16,7 @@
 
 #include "naucrates/statistics/CScaleFactorUtils.h"
 
+#include "gpos/common/CAutoRg.h"
 #include "gpos/common/CBitSet.h"
 #include "gpos/sync/CAutoMutex.h"
 #include "gpos/memory/CAutoMemoryPool.h"
@@ -72,7 +73,9 @@ CStatistics::CStatistics
 	m_fEmpty(fEmpty),
 	m_dRebinds(1.0), // by default, a stats object is rebound to parameters only once
 	m_ulNumPredicates(ulNumPredicates),
-	m_pdrgpubndvs(NULL)
+	m_pdrgpubndvs(NULL),
+	m_pdrgpmcstats(NULL),
+	m_phmulhll(NULL)
 {
 	GPOS_ASSERT(NULL != m_phmulhist);
 	GPOS_ASSERT(NULL != m_phmuldoubleWidth);
@@ -81,6 +84,10 @@ CStatistics::CStatistics
 	// hash map for source id -> max source cardinality mapping
 	m_pdrgpubndvs = GPOS_NEW(pmp) DrgPubndvs(pmp);
 
+	m_pdrgpmcstats = GPOS_NEW(pmp) DrgPmcstats(pmp);
+
+	m_phmulhll = GPOS_NEW(pmp) HMUlHLL(pmp);
+
 	m_pstatsconf = COptCtxt::PoctxtFromTLS()->Poconf()->Pstatsconf();
 }
 
@@ -90,6 +97,8 @@ CStatistics::~CStatistics()
 	m_phmulhist->Release();
 	m_phmuldoubleWidth->Release();
 	m_pdrgpubndvs->Release();
+	m_pdrgpmcstats->Release();
+	m_phmulhll->Release();
 }
 
 // look up the width of a particular column
@@ -104,20 +113,69 @@ CStatistics::PdWidth
 }
 
 
-//	cap the total number of distinct values (NDVs) in buckets to the number of rows
+//	cap the total number of distinct values (NDVs) in buckets to the number of rows;
+//	histograms shared with other statistics objects are copied before capping
 void
 CStatistics::CapNDVs
 	(
+	IMemoryPool *pmp,
+	CStatisticsConfig *pstatsconf,
 	CDouble dRows,
 	HMUlHist *phmulhist
 	)
 {
 	GPOS_ASSERT(NULL != phmulhist);
+
+	const ULONG ulHists = phmulhist->UlEntries();
+	if (0 == ulHists)
+	{
+		return;
+	}
+
+	CAutoRg<ULONG> a_rgulColId;
+	a_rgulColId = GPOS_NEW_ARRAY(pmp, ULONG, ulHists);
+
+	CAutoRg<CHistogram *> a_rgphistInput;
+	a_rgphistInput = GPOS_NEW_ARRAY(pmp, CHistogram *, ulHists);
+
+	CAutoRg<CHistogram *> a_rgphistOutput;
+	a_rgphistOutput = GPOS_NEW_ARRAY(pmp, CHistogram *, ulHists);
+
+	// collect the histograms to cap
+	ULONG ulCapped = 0;
 	HMIterUlHist hmiterulhist(phmulhist);
 	while (hmiterulhist.FAdvance())
 	{
 		CHistogram *phist = const_cast<CHistogram *>(hmiterulhist.Pt());
-		phist->CapNDVs(dRows);
+		if (dRows >= phist->DDistinct())
+		{
+			// no need for capping
+			continue;
+		}
+
+		a_rgulColId[ulCapped] = *(hmiterulhist.Pk());
+		a_rgphistInput[ulCapped] = phist;
+		ulCapped++;
+	}
+
+	CHistogramUtils::DeriveHistograms
+		(
+		pmp,
+		pstatsconf,
+		CHistogramUtils::EhopCapNDVs,
+		dRows,
+		ulCapped,
+		a_rgphistInput.Rgt(),
+		a_rgphistOutput.Rgt()
+		);
+
+	for (ULONG ul = 0; ul < ulCapped; ul++)
+	{
+#ifdef GPOS_DEBUG
+		BOOL fRes =
+#endif
+		phmulhist->FReplace(&a_rgulColId[ul], a_rgphistOutput[ul]);
+		GPOS_ASSERT(fRes);
 	}
 }
 
@@ -173,6 +231,9 @@ CStatistics::PstatsFilter
 											pstatspred,
 											&dScaleFactor
 											);
+
+			// predicates on functionally dependent columns are not independent
+			dScaleFactor = CStatisticsUtils::DScaleFactorDependencies(pmp, this, pstatspred, dScaleFactor);
 		}
 
 		GPOS_ASSERT(DMinRows.DVal() <= dScaleFactor.DVal());
@@ -185,7 +246,7 @@ CStatistics::PstatsFilter
 
 	if (fCapNdvs)
 	{
-		CapNDVs(dRowsFilter, phmulhistNew);
+		CapNDVs(pmp, m_pstatsconf, dRowsFilter, phmulhistNew);
 	}
 
 	CStatistics *pstatsFilter = GPOS_NEW(pmp) CStatistics
@@ -197,6 +258,7 @@ CStatistics::PstatsFilter
 												FEmpty(),
 												m_ulNumPredicates + ulNumPredicates
 												);
+	pstatsFilter->AddMultiColumnStats(this);
 
 	// since the filter operation is reductive, we choose the bounding method that takes
 	// the minimum of the cardinality upper bound of the source column (in the input hash map)
@@ -243,6 +305,22 @@ CStatistics::OsPrint
 		const CUpperBoundNDVs *pubndv = (*m_pdrgpubndvs)[ul];
 		pubndv->OsPrint(os);
 	}
+
+	const ULONG ulMCStats = m_pdrgpmcstats->UlLength();
+	for (ULONG ul = 0; ul < ulMCStats; ul++)
+	{
+		os << "Multi-column stats ";
+		(*m_pdrgpmcstats)[ul]->OsPrint(os);
+		os << std::endl;
+	}
+
+	HMIterUlHLL hmiterulhll(m_phmulhll);
+	while (hmiterulhll.FAdvance())
+	{
+		os << "Col" << *(hmiterulhll.Pk()) << " sketch: ";
+		hmiterulhll.Pt()->OsPrint(os);
+		os << std::endl;
+	}
 	os << "StatsEstimationRisk = " << UlStatsEstimationRisk() << std::endl;
 	os << "}" << std::endl;
 
@@ -541,17 +619,40 @@ CStatistics::PstatsJoinDriver
 
 		fEmptyOutput = FEmptyJoinStats(FEmpty(), fEmptyOutput, fLASJ, phist1, phist2, phist1After);
 
+		// joins of overlapping histograms may split buckets
+		phist1After = CHistogramUtils::PhistCapBuckets(pmp, m_pstatsconf, phist1After);
+		if (NULL != phist2After)
+		{
+			phist2After = CHistogramUtils::PhistCapBuckets(pmp, m_pstatsconf, phist2After);
+		}
+
 		CStatisticsUtils::AddHistogram(pmp, ulColId1, phist1After, phmulhistJoin);
 		if (!fSemiJoin)
 		{
 			CStatisticsUtils::AddHistogram(pmp, ulColId2, phist2After, phmulhistJoin);
 		}
-		GPOS_DELETE(phist1After);
-		GPOS_DELETE(phist2After);
+		phist1After->Release();
+		CRefCount::SafeRelease(phist2After);
 
 		pdrgpd->Append(GPOS_NEW(pmp) CDouble(dScaleFactorLocal));
 	}
 
+	if (!fSemiJoin)
+	{
+		// predicates on correlated columns are not independent
+		DrgPdouble *pdrgpdMultiColumn = CStatisticsUtils::PdrgpdJoinScaleFactorsMultiColumn
+										(
+										pmp,
+										m_pstatsconf,
+										this,
+										pstatsOther,
+										pdrgpstatspredjoin,
+										pdrgpd
+										);
+		pdrgpd->Release();
+		pdrgpd = pdrgpdMultiColumn;
+	}
+
 	CDouble dRowsJoin = DJoinCardinality(m_pstatsconf, m_dRows, pstatsOther->m_dRows, pdrgpd, esjt);
 	if (fEmptyOutput)
 	{
@@ -579,6 +680,11 @@ CStatistics::PstatsJoinDriver
 											fEmptyOutput,
 											m_ulNumPredicates
 											);
+	pstatsJoin->AddMultiColumnStats(this);
+	if (!fSemiJoin)
+	{
+		pstatsJoin->AddMultiColumnStats(pstatsOther);
+	}
 
 	// In the output statistics object, the upper bound source cardinality of the join column
 	// cannot be greater than the upper bound source cardinality information maintained in the input
@@ -729,6 +835,8 @@ CStatistics::PstatsLOJ
 										FEmpty(),
 										m_ulNumPredicates
 										);
+	pstatsLOJ->AddMultiColumnStats(this);
+	pstatsLOJ->AddMultiColumnStats(pstatsInnerSide);
 
 	// In the output statistics object, the upper bound source cardinality of the join column
 	// cannot be greater than the upper bound source cardinality information maintained in the input
@@ -805,8 +913,9 @@ CStatistics::PhmulhistLOJ
 			{
 				// union the buckets from the inner join and LASJ to get the LOJ buckets
 				CHistogram *phistLOJ = phistLASJ->PhistUnionAllNormalized(pmp, dRowsLASJ, phistInnerJoin, dRowsInnerJoin);
+				phistLOJ = CHistogramUtils::PhistCapBuckets(pmp, pstatsOuter->m_pstatsconf, phistLOJ);
 				CStatisticsUtils::AddHistogram(pmp, ulColId, phistLOJ, phmulhistLOJ);
-				GPOS_DELETE(phistLOJ);
+				phistLOJ->Release();
 			}
 			else
 			{
@@ -875,8 +984,8 @@ CStatistics::AddHistogramsLOJInner
 		CHistogram *phistLOJ = phistInnerJoin->PhistUnionAllNormalized(pmp, dRowsInnerJoin, phistNull, dRowsLASJ);
 		CStatisticsUtils::AddHistogram(pmp, ulColId, phistLOJ, phmulhistLOJ);
 
-		GPOS_DELETE(phistNull);
-		GPOS_DELETE(phistLOJ);
+		phistNull->Release();
+		phistLOJ->Release();
 	}
 }
 
@@ -963,7 +1072,8 @@ CStatistics::LASJoinHistograms
 		// anti-semi join should give the full outer side.
 		// use 1.0 as scale factor if anti semi join
 		*pdScaleFactor = 1.0;
-		*pphist1 = phist1->PhistCopy(pmp);
+		phist1->AddRef();
+		*pphist1 = phist1;
 		*pphist2 = NULL;
 
 		return;
@@ -994,9 +1104,10 @@ CStatistics::LASJoinHistograms
 	}
 
 	// not supported join operator or missing stats,
-	// copy input histograms and use default scale factor
+	// share input histograms and use default scale factor
 	*pdScaleFactor = CDouble(CScaleFactorUtils::DDefaultScaleFactorJoin);
-	*pphist1 = phist1->PhistCopy(pmp);
+	phist1->AddRef();
+	*pphist1 = phist1;
 	*pphist2 = NULL;
 }
 
@@ -1080,16 +1191,18 @@ CStatistics::InnerJoinHistograms
 		// just the scale factors.
 
 		GPOS_ASSERT(phistJoin->FEmpty());
-		GPOS_DELETE(phistJoin);
+		phistJoin->Release();
 			
 		// TODO:  Feb 21 2014, for all join condition except for "=" join predicate 
 		// we currently do not compute new histograms for the join columns
 	}
 
 	// not supported join operator or missing histograms,
-	// copy input histograms and use default scale factor
-	*pphist1 = phist1->PhistCopy(pmp);
-	*pphist2 = phist2->PhistCopy(pmp);
+	// share input histograms and use default scale factor
+	phist1->AddRef();
+	*pphist1 = phist1;
+	phist2->AddRef();
+	*pphist2 = phist2;
 }
 
 // helper for joining histograms
@@ -1227,8 +1340,8 @@ CStatistics::PstatsGroupBy
 
 		// add statistical information of columns (1) used to compute the cardinality of the aggregate
 		// and (2) the grouping columns that are computed
-		CStatisticsUtils::AddGrpColStats(pmp, this, pcrsGrpColsForStats, phmulhist, phmuldoubleWidth);
-		CStatisticsUtils::AddGrpColStats(pmp, this, pcrsGrpColComputed, phmulhist, phmuldoubleWidth);
+		CStatisticsUtils::AddGrpColStats(pmp, m_pstatsconf, this, pcrsGrpColsForStats, phmulhist, phmuldoubleWidth);
+		CStatisticsUtils::AddGrpColStats(pmp, m_pstatsconf, this, pcrsGrpColComputed, phmulhist, phmuldoubleWidth);
 
 		DrgPdouble *pdrgpdNDV = CStatisticsUtils::PdrgPdoubleNDV(pmp, m_pstatsconf, this, pcrsGrpColsForStats, pbsKeys);
 		CDouble dGroups = CStatisticsUtils::DNumOfDistinctVal(m_pstatsconf, pdrgpdNDV);
@@ -1242,6 +1355,8 @@ CStatistics::PstatsGroupBy
 
 		// create a new stats object for the output
 		pstatsAgg = GPOS_NEW(pmp) CStatistics(pmp, phmulhist, phmuldoubleWidth, dRowsAgg, FEmpty());
+		pstatsAgg->AddMultiColumnStats(this);
+		pstatsAgg->AddHLLSketches(pmp, this);
 	}
 
 	// In the output statistics object, the upper bound source cardinality of the grouping column
@@ -1333,7 +1448,8 @@ CStatistics::PstatsProject
 		}
 		else
 		{
-			phmulhistNew->FInsert(GPOS_NEW(pmp) ULONG(ulColId), phist->PhistCopy(pmp));
+			phist->AddRef();
+			phmulhistNew->FInsert(GPOS_NEW(pmp) ULONG(ulColId), phist);
 		}
 
 		// look up width
@@ -1362,6 +1478,8 @@ CStatistics::PstatsProject
 											FEmpty(),
 											m_ulNumPredicates
 											);
+	pstatsProject->AddMultiColumnStats(this);
+	pstatsProject->AddHLLSketches(pmp, this);
 
 	// In the output statistics object, the upper bound source cardinality of the project column
 	// is equivalent the estimate project cardinality.
@@ -1453,6 +1571,9 @@ CStatistics::PstatsUnionAll
 	// column ids on which widths are to be computed
 	HMUlDouble *phmuldoubleWidth = GPOS_NEW(pmp) HMUlDouble(pmp);
 
+	// sketches of output columns merged from the sketches of both inputs
+	HMUlHLL *phmulhllNew = GPOS_NEW(pmp) HMUlHLL(pmp);
+
 	BOOL fEmptyUnionAll = FEmpty() && pistatsOther->FEmpty();
 	CColumnFactory *pcf = COptCtxt::PoctxtFromTLS()->Pcf();
 	CDouble dRowsUnionAll = DMinRows;
@@ -1477,8 +1598,28 @@ CStatistics::PstatsUnionAll
 			if (phistInput1->FWellDefined() || phistInput2->FWellDefined())
 			{
 				CHistogram *phistOutput = phistInput1->PhistUnionAllNormalized(pmp, DRows(), phistInput2, pstatsOther->DRows());
+				phistOutput = CHistogramUtils::PhistCapBuckets(pmp, m_pstatsconf, phistOutput);
+
+				// the merged sketch of both inputs counts the distinct values of
+				// the union accurately, where merging histograms can only guess
+				// how many values the inputs share
+				const CHLLSketch *phllInput1 = Phll(ulColIdInput1);
+				const CHLLSketch *phllInput2 = pstatsOther->Phll(ulColIdInput2);
+				CHLLSketch *phllOutput = NULL;
+				if (NULL != phllInput1 && NULL != phllInput2)
+				{
+					phllOutput = phllInput1->PhllMerge(pmp, phllInput2);
+				}
+
+				if (NULL != phllOutput)
+				{
+					CDouble dRowsOutput = DRows() + pstatsOther->DRows();
+					phistOutput->ScaleNDVs(std::min(phllOutput->DDistinct().DVal(), dRowsOutput.DVal()));
+					phmulhllNew->FInsert(GPOS_NEW(pmp) ULONG(ulColIdOutput), phllOutput);
+				}
+
 				CStatisticsUtils::AddHistogram(pmp, ulColIdOutput, phistOutput, phmulhistNew);
-				GPOS_DELETE(phistOutput);
+				phistOutput->Release();
 			}
 			else
 			{
@@ -1514,6 +1655,15 @@ CStatistics::PstatsUnionAll
 											0 /* m_ulNumPredicates */
 											);
 
+	HMIterUlHLL hmiterulhll(phmulhllNew);
+	while (hmiterulhll.FAdvance())
+	{
+		CHLLSketch *phll = const_cast<CHLLSketch *>(hmiterulhll.Pt());
+		phll->AddRef();
+		pstatsUnionAll->AddHLLSketch(pmp, *(hmiterulhll.Pk()), phll);
+	}
+	phmulhllNew->Release();
+
 	// In the output statistics object, the upper bound source cardinality of the UNION ALL column
 	// is the estimate union all cardinality.
 
@@ -1566,6 +1716,7 @@ CStatistics::PstatsLimit
 											FEmpty(),
 											m_ulNumPredicates
 											);
+	pstatsLimit->AddMultiColumnStats(this);
 
 	// In the output statistics object, the upper bound source cardinality of the join column
 	// cannot be greater than the upper bound source cardinality information maintained in the input
@@ -1621,6 +1772,9 @@ CStatistics::AppendStats
 
 	AddWidthInfo(pmp, pstats->m_phmuldoubleWidth, m_phmuldoubleWidth);
 	GPOS_CHECK_ABORT;
+
+	AddMultiColumnStats(pstats);
+	AddHLLSketches(pmp, pstats);
 }
 
 // copy statistics object
@@ -1664,6 +1818,13 @@ CStatistics::PstatsScale
 												FEmpty(),
 												m_ulNumPredicates
 												);
+	pstatsScaled->AddMultiColumnStats(this);
+	if (CDouble(1.0) <= dFactor)
+	{
+		// scaling up keeps the set of values of each column, while scaling
+		// down may drop values that are still counted in the sketches
+		pstatsScaled->AddHLLSketches(pmp, this);
+	}
 
 	// In the output statistics object, the upper bound source cardinality of the scaled column
 	// cannot be greater than the the upper bound source cardinality information maintained in the input
@@ -1677,6 +1838,55 @@ CStatistics::PstatsScale
 	return pstatsScaled;
 }
 
+//	copy statistics object keeping histograms only for the given columns; widths
+//	of the other columns are kept since they are still needed for costing
+IStatistics *
+CStatistics::PstatsPruneHistograms
+	(
+	IMemoryPool *pmp,
+	CColRefSet *pcrsHist
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pcrsHist);
+
+	HMUlHist *phmulhistNew = GPOS_NEW(pmp) HMUlHist(pmp);
+	HMUlDouble *phmuldoubleNew = GPOS_NEW(pmp) HMUlDouble(pmp);
+
+	CColRefSetIter crsi(*pcrsHist);
+	while (crsi.FAdvance())
+	{
+		ULONG ulColId = crsi.Pcr()->UlId();
+		const CHistogram *phist = m_phmulhist->PtLookup(&ulColId);
+		if (NULL != phist)
+		{
+			CStatisticsUtils::AddHistogram(pmp, ulColId, phist, phmulhistNew);
+		}
+	}
+
+	AddWidthInfo(pmp, m_phmuldoubleWidth, phmuldoubleNew);
+	GPOS_CHECK_ABORT;
+
+	CStatistics *pstatsPruned = GPOS_NEW(pmp) CStatistics
+												(
+												pmp,
+												phmulhistNew,
+												phmuldoubleNew,
+												m_dRows,
+												FEmpty(),
+												m_ulNumPredicates
+												);
+	pstatsPruned->SetRebinds(m_dRebinds);
+	pstatsPruned->SetStatsEstimationRisk(m_ulStatsEstimationRisk);
+	pstatsPruned->AddMultiColumnStats(this);
+	pstatsPruned->AddHLLSketches(pmp, this);
+
+	// the pruned statistics have the same cardinality as this object
+	ComputeCardUpperBounds(pmp, pstatsPruned, m_dRows, CStatistics::EcbmInputSourceMaxCard /* ecbm */);
+
+	return pstatsPruned;
+}
+
 //	copy statistics object with re-mapped column ids
 IStatistics *
 CStatistics::PstatsCopyWithRemap
@@ -1722,6 +1932,30 @@ CStatistics::PstatsCopyWithRemap
 	 	}
 	}
 
+	// copy the multi-column statistics whose columns are all re-mapped
+	const ULONG ulMCStats = m_pdrgpmcstats->UlLength();
+	for (ULONG ul = 0; ul < ulMCStats; ul++)
+	{
+		CMultiColumnStats *pmcstatsCopy = (*m_pdrgpmcstats)[ul]->PmcstatsCopyWithRemap(pmp, phmulcr);
+		if (NULL != pmcstatsCopy)
+		{
+			pstatsCopy->AddMultiColumnStats(pmcstatsCopy);
+		}
+	}
+
+	// share the sketches of re-mapped columns
+	HMIterUlCr hmiterulcr(phmulcr);
+	while (hmiterulcr.FAdvance())
+	{
+		ULONG ulColIdSrc = *(hmiterulcr.Pk());
+		CHLLSketch *phll = m_phmulhll->PtLookup(&ulColIdSrc);
+		if (NULL != phll && NULL == pstatsCopy->Phll(hmiterulcr.Pt()->UlId()))
+		{
+			phll->AddRef();
+			pstatsCopy->AddHLLSketch(pmp, hmiterulcr.Pt()->UlId(), phll);
+		}
+	}
+
 	return pstatsCopy;
 }
 
@@ -1915,6 +2149,100 @@ CStatistics::AddCardUpperBound
 	m_pdrgpubndvs->Append(pubndv);
 }
 
+// add statistics on a set of correlated columns
+void
+CStatistics::AddMultiColumnStats
+	(
+	CMultiColumnStats *pmcstats
+	)
+{
+	GPOS_ASSERT(NULL != pmcstats);
+
+	m_pdrgpmcstats->Append(pmcstats);
+}
+
+// share the multi-column statistics of given statistics object whose columns
+// all have histograms in this object; multi-column statistics are immutable
+// and bounded by the histograms they are used with, so they can be shared
+// as is by statistics objects derived from the given one
+void
+CStatistics::AddMultiColumnStats
+	(
+	const CStatistics *pstatsSrc
+	)
+{
+	GPOS_ASSERT(NULL != pstatsSrc);
+
+	const ULONG ulMCStats = pstatsSrc->m_pdrgpmcstats->UlLength();
+	for (ULONG ul = 0; ul < ulMCStats; ul++)
+	{
+		CMultiColumnStats *pmcstats = (*pstatsSrc->m_pdrgpmcstats)[ul];
+
+		BOOL fAdd = true;
+		const DrgPul *pdrgpulColId = pmcstats->PdrgpulColId();
+		const ULONG ulCols = pdrgpulColId->UlLength();
+		for (ULONG ulCol = 0; fAdd && ulCol < ulCols; ulCol++)
+		{
+			fAdd = (NULL != Phist(*(*pdrgpulColId)[ulCol]));
+		}
+
+		const ULONG ulMCStatsOwn = m_pdrgpmcstats->UlLength();
+		for (ULONG ulOwn = 0; fAdd && ulOwn < ulMCStatsOwn; ulOwn++)
+		{
+			fAdd = ((*m_pdrgpmcstats)[ulOwn] != pmcstats);
+		}
+
+		if (fAdd)
+		{
+			pmcstats->AddRef();
+			m_pdrgpmcstats->Append(pmcstats);
+		}
+	}
+}
+
+// add the sketch of the values of a column
+void
+CStatistics::AddHLLSketch
+	(
+	IMemoryPool *pmp,
+	ULONG ulColId,
+	CHLLSketch *phll
+	)
+{
+	GPOS_ASSERT(NULL != phll);
+
+#ifdef GPOS_DEBUG
+	BOOL fResult =
+#endif // GPOS_DEBUG
+	m_phmulhll->FInsert(GPOS_NEW(pmp) ULONG(ulColId), phll);
+	GPOS_ASSERT(fResult);
+}
+
+// share the sketches of given statistics object on columns that have
+// histograms in this object; callers only share sketches of columns whose
+// set of values is unchanged, since a sketch cannot be filtered
+void
+CStatistics::AddHLLSketches
+	(
+	IMemoryPool *pmp,
+	const CStatistics *pstatsSrc
+	)
+{
+	GPOS_ASSERT(NULL != pstatsSrc);
+
+	HMIterUlHLL hmiterulhll(pstatsSrc->m_phmulhll);
+	while (hmiterulhll.FAdvance())
+	{
+		ULONG ulColId = *(hmiterulhll.Pk());
+		if (NULL != Phist(ulColId) && NULL == Phll(ulColId))
+		{
+			CHLLSketch *phll = const_cast<CHLLSketch *>(hmiterulhll.Pt());
+			phll->AddRef();
+			AddHLLSketch(pmp, ulColId, phll);
+		}
+	}
+}
+
 // return the dxl representation of the statistics object
 CDXLStatsDerivedRelation *
 CStatistics::Pdxlstatsderrel
@@ -10,7 +10,9 @@
 //---------------------------------------------------------------------------
 
 #include "gpos/base.h"
+#include "gpos/common/CAutoRg.h"
 
+#include "gpopt/base/COptCtxt.h"
 #include "gpopt/base/CUtils.h"
 #include "gpopt/base/CColRefTable.h"
 #include "gpopt/base/CColRefSetIter.h"
@@ -28,8 +30,10 @@
 #include "naucrates/statistics/CStatsPredDisj.h"
 #include "naucrates/statistics/CStatsPredConj.h"
 #include "naucrates/statistics/CStatsPredLike.h"
+#include "naucrates/statistics/CStatsPredPoint.h"
 #include "naucrates/statistics/CScaleFactorUtils.h"
 #include "naucrates/statistics/CHistogram.h"
+#include "naucrates/statistics/CHistogramUtils.h"
 
 #include "naucrates/md/IMDScalarOp.h"
 #include "naucrates/md/IMDType.h"
@@ -725,7 +729,7 @@ CStatisticsUtils::UpdateDisjStatistics
 												&dRowOutput
 												);
 
-			GPOS_DELETE(phistPrev);
+			phistPrev->Release();
 			phistPrev = phistNew;
 		}
 
@@ -739,7 +743,7 @@ CStatisticsUtils::UpdateDisjStatistics
 			);
 	}
 
-	GPOS_DELETE(phistPrev);
+	CRefCount::SafeRelease(phistPrev);
 }
 
 //---------------------------------------------------------------------------
@@ -830,7 +834,8 @@ CStatisticsUtils::PbsNonUpdatableHistForDisj
 //		CStatisticsUtils::AddHistogram
 //
 //	@doc:
-//		Add histogram to histogram map if not already present.
+//		Add histogram to histogram map if not already present; the
+//		histogram is shared with the map rather than copied
 //
 //---------------------------------------------------------------------------
 void
@@ -845,20 +850,24 @@ CStatisticsUtils::AddHistogram
 {
 	GPOS_ASSERT(NULL != phist);
 
+	// histograms in a map are immutable, so the map can hold a reference to given histogram
+	CHistogram *phistShared = const_cast<CHistogram *>(phist);
 	if (NULL == phmulhist->PtLookup(&ulColId))
 	{
+		phistShared->AddRef();
 #ifdef GPOS_DEBUG
 		BOOL fRes =
 #endif
-		phmulhist->FInsert(GPOS_NEW(pmp) ULONG(ulColId), phist->PhistCopy(pmp));
+		phmulhist->FInsert(GPOS_NEW(pmp) ULONG(ulColId), phistShared);
 		GPOS_ASSERT(fRes);
 	}
 	else if (fReplaceOld)
 	{
+		phistShared->AddRef();
 #ifdef GPOS_DEBUG
 		BOOL fRes =
 #endif
-		phmulhist->FReplace(&ulColId, phist->PhistCopy(pmp));
+		phmulhist->FReplace(&ulColId, phistShared);
 		GPOS_ASSERT(fRes);
 	}
 }
@@ -993,7 +1002,7 @@ CStatisticsUtils::PhmulhistMergeAfterDisjChild
 					true /* fReplaceOld */
 					);
 
-				GPOS_DELETE(phistMergeResult);
+				phistMergeResult->Release();
 			}
 
 			GPOS_CHECK_ABORT;
@@ -1198,8 +1207,9 @@ CStatisticsUtils::PstatsFilter
 	// extract local filter
 	CStatsPred *pstatspred = CStatsPredUtils::PstatspredExtract(pmp, pexprScalarLocal, pcrsOuterRefs);
 
-	// derive stats based on local filter
-	IStatistics *pstatsResult = pstatsChild->PstatsFilter(pmp, pstatspred, fCapNdvs);
+	// derive stats based on local filter; child statistics are shared by all
+	// alternatives of the child group, so filters derived on them are cached
+	IStatistics *pstatsResult = COptCtxt::PoctxtFromTLS()->Pstatsfcache()->PstatsFilter(pmp, pstatsChild, pstatspred, fCapNdvs);
 	pstatspred->Release();
 
 	if (exprhdl.FHasOuterRefs() && 0 < pdrgpstatOuter->UlLength())
@@ -1836,6 +1846,404 @@ CStatisticsUtils::DMaxNdv
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsUtils::PmcstatsLargestSubset
+//
+//	@doc:
+//		Return the multi-column statistics with known number of distinct
+//		value combinations that cover the most columns of the given set,
+//		or NULL if there is none
+//---------------------------------------------------------------------------
+const CMultiColumnStats *
+CStatisticsUtils::PmcstatsLargestSubset
+	(
+	const CStatistics *pstats,
+	const CBitSet *pbsColIds
+	)
+{
+	GPOS_ASSERT(NULL != pstats);
+	GPOS_ASSERT(NULL != pbsColIds);
+
+	const DrgPmcstats *pdrgpmcstats = pstats->Pdrgpmcstats();
+	const CMultiColumnStats *pmcstatsLargest = NULL;
+	const ULONG ulSize = pdrgpmcstats->UlLength();
+	for (ULONG ul = 0; ul < ulSize; ul++)
+	{
+		const CMultiColumnStats *pmcstats = (*pdrgpmcstats)[ul];
+		if (pmcstats->FHasDistinct() &&
+			pbsColIds->FSubset(pmcstats->PbsColId()) &&
+			(NULL == pmcstatsLargest || pmcstatsLargest->UlColumns() < pmcstats->UlColumns()))
+		{
+			pmcstatsLargest = pmcstats;
+		}
+	}
+
+	return pmcstatsLargest;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsUtils::DJointNdv
+//
+//	@doc:
+//		Return the number of distinct value combinations of the columns of
+//		the given multi-column statistics in the given statistics object;
+//		the stored number was collected on the base relation, so it is
+//		bounded by the product of the current NDVs of the columns and the
+//		number of rows, and it is at least the largest of the NDVs
+//---------------------------------------------------------------------------
+CDouble
+CStatisticsUtils::DJointNdv
+	(
+	const CStatistics *pstats,
+	const CMultiColumnStats *pmcstats
+	)
+{
+	GPOS_ASSERT(NULL != pstats);
+	GPOS_ASSERT(NULL != pmcstats);
+	GPOS_ASSERT(pmcstats->FHasDistinct());
+
+	const DrgPul *pdrgpulColId = pmcstats->PdrgpulColId();
+	CDouble dNdvProduct(1.0);
+	const ULONG ulCols = pdrgpulColId->UlLength();
+	for (ULONG ul = 0; ul < ulCols; ul++)
+	{
+		CDouble dNdv = DDefaultDistinctVals(pstats->DRows());
+		const CHistogram *phist = pstats->Phist(*(*pdrgpulColId)[ul]);
+		if (NULL != phist && !phist->FEmpty())
+		{
+			dNdv = phist->DDistinct();
+		}
+		dNdvProduct = dNdvProduct * dNdv;
+	}
+
+	CDouble dJointNdv = std::min
+							(
+							pmcstats->DDistinct().DVal(),
+							std::min(dNdvProduct.DVal(), pstats->DRows().DVal())
+							);
+
+	return std::max(dJointNdv.DVal(), DMaxNdv(pstats, pdrgpulColId).DVal());
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsUtils::PdrgpulAddJointNdvs
+//
+//	@doc:
+//		Add the number of distinct value combinations of the sets of given
+//		columns that are covered by multi-column statistics, preferring the
+//		statistics on the most columns, and return the columns that are
+//		not covered
+//---------------------------------------------------------------------------
+DrgPul *
+CStatisticsUtils::PdrgpulAddJointNdvs
+	(
+	IMemoryPool *pmp,
+	const CStatistics *pstatsInput,
+	const DrgPul *pdrgpulColIds,
+	DrgPdouble *pdrgpdNDV // output array of ndvs
+	)
+{
+	GPOS_ASSERT(NULL != pstatsInput);
+	GPOS_ASSERT(NULL != pdrgpulColIds);
+	GPOS_ASSERT(NULL != pdrgpdNDV);
+
+	CBitSet *pbsColIds = GPOS_NEW(pmp) CBitSet(pmp);
+	const ULONG ulCols = pdrgpulColIds->UlLength();
+	for (ULONG ul = 0; ul < ulCols; ul++)
+	{
+		(void) pbsColIds->FExchangeSet(*(*pdrgpulColIds)[ul]);
+	}
+
+	const CMultiColumnStats *pmcstats = PmcstatsLargestSubset(pstatsInput, pbsColIds);
+	while (NULL != pmcstats)
+	{
+		pdrgpdNDV->Append(GPOS_NEW(pmp) CDouble(DJointNdv(pstatsInput, pmcstats)));
+		pbsColIds->Difference(pmcstats->PbsColId());
+		pmcstats = PmcstatsLargestSubset(pstatsInput, pbsColIds);
+	}
+
+	DrgPul *pdrgpulNotCovered = GPOS_NEW(pmp) DrgPul(pmp);
+	for (ULONG ul = 0; ul < ulCols; ul++)
+	{
+		ULONG ulColId = *(*pdrgpulColIds)[ul];
+		if (pbsColIds->FBit(ulColId))
+		{
+			pdrgpulNotCovered->Append(GPOS_NEW(pmp) ULONG(ulColId));
+		}
+	}
+	pbsColIds->Release();
+
+	return pdrgpulNotCovered;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsUtils::DNdvCombinations
+//
+//	@doc:
+//		Estimate the number of distinct value combinations of the given
+//		columns, using multi-column statistics where available
+//---------------------------------------------------------------------------
+CDouble
+CStatisticsUtils::DNdvCombinations
+	(
+	IMemoryPool *pmp,
+	CStatisticsConfig *pstatsconf,
+	const CStatistics *pstats,
+	const DrgPul *pdrgpulColIds
+	)
+{
+	GPOS_ASSERT(NULL != pstats);
+	GPOS_ASSERT(NULL != pdrgpulColIds);
+
+	DrgPdouble *pdrgpdNDV = GPOS_NEW(pmp) DrgPdouble(pmp);
+	DrgPul *pdrgpulNotCovered = PdrgpulAddJointNdvs(pmp, pstats, pdrgpulColIds, pdrgpdNDV);
+	AddNdvForAllGrpCols(pmp, pstats, pdrgpulNotCovered, pdrgpdNDV);
+
+	CDouble dNdv = std::min
+						(
+						std::max
+							(
+							CStatistics::DMinRows.DVal(),
+							DNumOfDistinctVal(pstatsconf, pdrgpdNDV).DVal()
+							),
+						pstats->DRows().DVal()
+						);
+
+	pdrgpulNotCovered->Release();
+	pdrgpdNDV->Release();
+
+	return dNdv;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsUtils::DScaleFactorDependencies
+//
+//	@doc:
+//		Correct the scale factor of a conjunction of equality predicates
+//		for functional dependencies between the filtered columns; the
+//		selectivity of equality on columns A and B, where B depends on A
+//		with degree d, is sel(A) * (d + (1 - d) * sel(B)) instead of
+//		sel(A) * sel(B), and it is never less than the selectivity of the
+//		most selective predicate
+//---------------------------------------------------------------------------
+CDouble
+CStatisticsUtils::DScaleFactorDependencies
+	(
+	IMemoryPool *pmp,
+	const CStatistics *pstats,
+	CStatsPredConj *pstatspredConj,
+	CDouble dScaleFactor
+	)
+{
+	GPOS_ASSERT(NULL != pstats);
+	GPOS_ASSERT(NULL != pstatspredConj);
+
+	const DrgPmcstats *pdrgpmcstats = pstats->Pdrgpmcstats();
+	if (0 == pdrgpmcstats->UlLength())
+	{
+		return dScaleFactor;
+	}
+
+	// columns with more than one predicate
+	CBitSet *pbsColIdsSeen = GPOS_NEW(pmp) CBitSet(pmp);
+	CBitSet *pbsColIdsMultiple = GPOS_NEW(pmp) CBitSet(pmp);
+	const ULONG ulFilters = pstatspredConj->UlFilters();
+	for (ULONG ul = 0; ul < ulFilters; ul++)
+	{
+		ULONG ulColId = pstatspredConj->Pstatspred(ul)->UlColId();
+		if (ULONG_MAX != ulColId && pbsColIdsSeen->FExchangeSet(ulColId))
+		{
+			(void) pbsColIdsMultiple->FExchangeSet(ulColId);
+		}
+	}
+
+	// scale factors of single equality predicates on columns with histograms
+	HMUlDouble *phmuldoubleScaleFactor = GPOS_NEW(pmp) HMUlDouble(pmp);
+	for (ULONG ul = 0; ul < ulFilters; ul++)
+	{
+		CStatsPred *pstatspred = pstatspredConj->Pstatspred(ul);
+		ULONG ulColId = pstatspred->UlColId();
+		if (CStatsPred::EsptPoint != pstatspred->Espt() || pbsColIdsMultiple->FBit(ulColId))
+		{
+			continue;
+		}
+
+		CStatsPredPoint *pstatspredPoint = CStatsPredPoint::PstatspredConvert(pstatspred);
+		const CHistogram *phist = pstats->Phist(ulColId);
+		if (CStatsPred::EstatscmptEq != pstatspredPoint->Escmpt() || NULL == phist || phist->FEmpty())
+		{
+			continue;
+		}
+
+		CDouble dScaleFactorCol(1.0);
+		CHistogram *phistAfter = phist->PhistFilterNormalized(pmp, CStatsPred::EstatscmptEq, pstatspredPoint->Ppoint(), &dScaleFactorCol);
+		phistAfter->Release();
+
+#ifdef GPOS_DEBUG
+		BOOL fResult =
+#endif // GPOS_DEBUG
+		phmuldoubleScaleFactor->FInsert(GPOS_NEW(pmp) ULONG(ulColId), GPOS_NEW(pmp) CDouble(dScaleFactorCol));
+		GPOS_ASSERT(fResult);
+	}
+	pbsColIdsSeen->Release();
+	pbsColIdsMultiple->Release();
+
+	CDouble dScaleFactorResult = dScaleFactor;
+	const ULONG ulSize = pdrgpmcstats->UlLength();
+	for (ULONG ul = 0; ul < ulSize; ul++)
+	{
+		const CMultiColumnStats *pmcstats = (*pdrgpmcstats)[ul];
+		CDouble dDependency = pmcstats->DDependency();
+		if (CDouble(0.0) == dDependency)
+		{
+			continue;
+		}
+
+		const DrgPul *pdrgpulColId = pmcstats->PdrgpulColId();
+		CDouble dScaleFactorMax(1.0);
+		BOOL fCovered = true;
+		for (ULONG ulCol = 0; fCovered && ulCol < pdrgpulColId->UlLength(); ulCol++)
+		{
+			const CDouble *pdScaleFactorCol = phmuldoubleScaleFactor->PtLookup((*pdrgpulColId)[ulCol]);
+			fCovered = (NULL != pdScaleFactorCol);
+			if (fCovered)
+			{
+				dScaleFactorMax = std::max(dScaleFactorMax.DVal(), pdScaleFactorCol->DVal());
+			}
+		}
+
+		if (!fCovered)
+		{
+			continue;
+		}
+
+		ULONG ulColIdDependent = pmcstats->UlColIdDependent();
+		CDouble dScaleFactorDependent = *(phmuldoubleScaleFactor->PtLookup(&ulColIdDependent));
+
+		// undo the selectivity of the dependent column for the dependent fraction of rows
+		CDouble dScaleFactorCorrected = dScaleFactorResult / (dDependency * dScaleFactorDependent + CDouble(1.0) - dDependency);
+		dScaleFactorResult = std::max(dScaleFactorCorrected.DVal(), dScaleFactorMax.DVal());
+	}
+	phmuldoubleScaleFactor->Release();
+
+	return std::min(dScaleFactor.DVal(), dScaleFactorResult.DVal());
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsUtils::PdrgpdJoinScaleFactorsMultiColumn
+//
+//	@doc:
+//		Return the scale factors of the given join predicates, where the
+//		factors of equality predicates on a set of columns covered by
+//		multi-column statistics on either side are replaced by a single
+//		factor: the larger of the numbers of distinct value combinations of
+//		the columns on both sides, bounded by the product of the replaced
+//		factors
+//---------------------------------------------------------------------------
+DrgPdouble *
+CStatisticsUtils::PdrgpdJoinScaleFactorsMultiColumn
+	(
+	IMemoryPool *pmp,
+	CStatisticsConfig *pstatsconf,
+	const CStatistics *pstatsOuter,
+	const CStatistics *pstatsInner,
+	DrgPstatspredjoin *pdrgpstatspredjoin,
+	DrgPdouble *pdrgpdScaleFactor
+	)
+{
+	GPOS_ASSERT(NULL != pstatsOuter);
+	GPOS_ASSERT(NULL != pstatsInner);
+	GPOS_ASSERT(NULL != pdrgpstatspredjoin);
+	GPOS_ASSERT(NULL != pdrgpdScaleFactor);
+	GPOS_ASSERT(pdrgpstatspredjoin->UlLength() == pdrgpdScaleFactor->UlLength());
+
+	const ULONG ulJoinConds = pdrgpstatspredjoin->UlLength();
+	if (2 > ulJoinConds ||
+		(0 == pstatsOuter->Pdrgpmcstats()->UlLength() && 0 == pstatsInner->Pdrgpmcstats()->UlLength()))
+	{
+		pdrgpdScaleFactor->AddRef();
+		return pdrgpdScaleFactor;
+	}
+
+	DrgPdouble *pdrgpdResult = GPOS_NEW(pmp) DrgPdouble(pmp);
+
+	// indexes of predicates whose scale factors have been replaced
+	CBitSet *pbsReplaced = GPOS_NEW(pmp) CBitSet(pmp);
+	for (ULONG ulSide = 0; ulSide < 2; ulSide++)
+	{
+		BOOL fOuter = (0 == ulSide);
+		const CStatistics *pstats = fOuter ? pstatsOuter : pstatsInner;
+		const CStatistics *pstatsOther = fOuter ? pstatsInner : pstatsOuter;
+
+		while (true)
+		{
+			// columns of this side in the equality predicates not replaced yet
+			CBitSet *pbsColIds = GPOS_NEW(pmp) CBitSet(pmp);
+			for (ULONG ul = 0; ul < ulJoinConds; ul++)
+			{
+				CStatsPredJoin *pstatsjoin = (*pdrgpstatspredjoin)[ul];
+				if (!pbsReplaced->FBit(ul) && CStatsPred::EstatscmptEq == pstatsjoin->Escmpt())
+				{
+					(void) pbsColIds->FExchangeSet(fOuter ? pstatsjoin->UlColId1() : pstatsjoin->UlColId2());
+				}
+			}
+
+			const CMultiColumnStats *pmcstats = PmcstatsLargestSubset(pstats, pbsColIds);
+			pbsColIds->Release();
+			if (NULL == pmcstats)
+			{
+				break;
+			}
+
+			DrgPul *pdrgpulColIdsOther = GPOS_NEW(pmp) DrgPul(pmp);
+			CDouble dScaleFactorProduct(1.0);
+			for (ULONG ul = 0; ul < ulJoinConds; ul++)
+			{
+				CStatsPredJoin *pstatsjoin = (*pdrgpstatspredjoin)[ul];
+				ULONG ulColId = fOuter ? pstatsjoin->UlColId1() : pstatsjoin->UlColId2();
+				if (!pbsReplaced->FBit(ul) &&
+					CStatsPred::EstatscmptEq == pstatsjoin->Escmpt() &&
+					pmcstats->PbsColId()->FBit(ulColId))
+				{
+					(void) pbsReplaced->FExchangeSet(ul);
+					dScaleFactorProduct = dScaleFactorProduct * *(*pdrgpdScaleFactor)[ul];
+					pdrgpulColIdsOther->Append(GPOS_NEW(pmp) ULONG(fOuter ? pstatsjoin->UlColId2() : pstatsjoin->UlColId1()));
+				}
+			}
+
+			CDouble dNdv = DJointNdv(pstats, pmcstats);
+			CDouble dNdvOther = DNdvCombinations(pmp, pstatsconf, pstatsOther, pdrgpulColIdsOther);
+			pdrgpulColIdsOther->Release();
+
+			CDouble dScaleFactor = std::min(std::max(dNdv.DVal(), dNdvOther.DVal()), dScaleFactorProduct.DVal());
+			pdrgpdResult->Append(GPOS_NEW(pmp) CDouble(std::max(1.0, dScaleFactor.DVal())));
+		}
+	}
+
+	for (ULONG ul = 0; ul < ulJoinConds; ul++)
+	{
+		if (!pbsReplaced->FBit(ul))
+		{
+			pdrgpdResult->Append(GPOS_NEW(pmp) CDouble(*(*pdrgpdScaleFactor)[ul]));
+		}
+	}
+	pbsReplaced->Release();
+
+	return pdrgpdResult;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CStatisticsUtils::DMaxGroupsFromSource
@@ -1862,8 +2270,12 @@ CStatisticsUtils::DMaxGroupsFromSource
 	CColRef *pcrFirst = pcf->PcrLookup(*(*pdrgpulPerSrc)[0]);
 	CDouble dUpperBoundNDVs = pstatsInput->DUpperBoundNDVs(pcrFirst);
 
+	// columns covered by multi-column statistics contribute the number of
+	// their distinct value combinations instead of their individual NDVs
 	DrgPdouble *pdrgpdNDV = GPOS_NEW(pmp) DrgPdouble(pmp);
-	AddNdvForAllGrpCols(pmp, pstatsInput, pdrgpulPerSrc, pdrgpdNDV);
+	DrgPul *pdrgpulNotCovered = PdrgpulAddJointNdvs(pmp, pstatsInput, pdrgpulPerSrc, pdrgpdNDV);
+	AddNdvForAllGrpCols(pmp, pstatsInput, pdrgpulNotCovered, pdrgpdNDV);
+	pdrgpulNotCovered->Release();
 
 	// take the minimum of (a) the estimated number of groups from the columns of this source,
 	// (b) input rows, and (c) cardinality upper bound for the given source in the
@@ -1979,41 +2391,55 @@ CStatisticsUtils::DNumOfDistinctVal
 //		CStatisticsUtils::AddGrpColStats
 //
 //	@doc:
-//		Add the statistics (histogram and width) of the grouping columns
+//		Add the statistics (histogram and width) of the grouping columns;
+//		histograms of many grouping columns are derived on the worker pool
 //---------------------------------------------------------------------------
 void
 CStatisticsUtils::AddGrpColStats
 	(
 	IMemoryPool *pmp,
+	CStatisticsConfig *pstatsconf,
 	const CStatistics *pstatsInput,
 	CColRefSet *pcrsGrpCols,
 	HMUlHist *phmulhistOutput,
 	HMUlDouble *phmuldoubleWidthOutput
 	)
 {
+	GPOS_ASSERT(NULL != pstatsconf);
 	GPOS_ASSERT(NULL != pstatsInput);
 	GPOS_ASSERT(NULL != pcrsGrpCols);
 	GPOS_ASSERT(NULL != phmulhistOutput);
 	GPOS_ASSERT(NULL != phmuldoubleWidthOutput);
 
+	const ULONG ulGrpCols = pcrsGrpCols->CElements();
+	if (0 == ulGrpCols)
+	{
+		return;
+	}
+
+	CAutoRg<ULONG> a_rgulColId;
+	a_rgulColId = GPOS_NEW_ARRAY(pmp, ULONG, ulGrpCols);
+
+	CAutoRg<CHistogram *> a_rgphistInput;
+	a_rgphistInput = GPOS_NEW_ARRAY(pmp, CHistogram *, ulGrpCols);
+
+	CAutoRg<CHistogram *> a_rgphistOutput;
+	a_rgphistOutput = GPOS_NEW_ARRAY(pmp, CHistogram *, ulGrpCols);
+
 	// iterate over grouping columns
+	ULONG ulHists = 0;
 	CColRefSetIter crsi(*pcrsGrpCols);
 	while (crsi.FAdvance())
 	{
 		CColRef *pcr = crsi.Pcr();
 		ULONG ulGrpColId = pcr->UlId();
 
-		CDouble dDistVals(CHistogram::DMinDistinct);
 		const CHistogram *phist = pstatsInput->Phist(ulGrpColId);
 		if (NULL != phist)
 		{
-			CHistogram *phistAfter = phist->PhistGroupByNormalized(pmp, pstatsInput->DRows(), &dDistVals);
-			if (phist->FScaledNDV())
-			{
-				phistAfter->SetNDVScaled();
-			}
-			AddHistogram(pmp, ulGrpColId, phistAfter, phmulhistOutput);
-			GPOS_DELETE(phistAfter);
+			a_rgulColId[ulHists] = ulGrpColId;
+			a_rgphistInput[ulHists] = const_cast<CHistogram *>(phist);
+			ulHists++;
 		}
 
 		const CDouble *pdWidth = pstatsInput->PdWidth(ulGrpColId);
@@ -2022,6 +2448,23 @@ CStatisticsUtils::AddGrpColStats
 			phmuldoubleWidthOutput->FInsert(GPOS_NEW(pmp) ULONG(ulGrpColId), GPOS_NEW(pmp) CDouble(*pdWidth));
 		}
 	}
+
+	CHistogramUtils::DeriveHistograms
+		(
+		pmp,
+		pstatsconf,
+		CHistogramUtils::EhopGroupBy,
+		pstatsInput->DRows(),
+		ulHists,
+		a_rgphistInput.Rgt(),
+		a_rgphistOutput.Rgt()
+		);
+
+	for (ULONG ul = 0; ul < ulHists; ul++)
+	{
+		AddHistogram(pmp, a_rgulColId[ul], a_rgphistOutput[ul], phmulhistOutput);
+		a_rgphistOutput[ul]->Release();
+	}
 }
 
 
@@ -0,0 +1,271 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CStatsFilterCache.cpp
+//
+//	@doc:
+//		Implementation of the cache of filter statistics
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/sync/CAutoMutex.h"
+#include "gpos/sync/atomic.h"
+
+#include "naucrates/statistics/CStatsFilterCache.h"
+#include "naucrates/statistics/CStatsPredConj.h"
+#include "naucrates/statistics/CStatsPredDisj.h"
+#include "naucrates/statistics/CStatsPredUtils.h"
+
+using namespace gpnaucrates;
+using namespace gpopt;
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatsFilterCache::CKey::CKey
+//
+//	@doc:
+//		Ctor; takes ownership of given references
+//
+//---------------------------------------------------------------------------
+CStatsFilterCache::CKey::CKey
+	(
+	IStatistics *pstats,
+	CStatsPred *pstatspred,
+	BOOL fCapNdvs
+	)
+	:
+	m_pstats(pstats),
+	m_pstatspred(pstatspred),
+	m_fCapNdvs(fCapNdvs),
+	m_ulHash(0)
+{
+	GPOS_ASSERT(NULL != pstats);
+	GPOS_ASSERT(NULL != pstatspred);
+
+	m_ulHash = gpos::UlCombineHashes(gpos::UlHashPtr<IStatistics>(pstats), CStatsPredUtils::UlHash(pstatspred));
+	m_ulHash = gpos::UlCombineHashes(m_ulHash, gpos::UlHash<BOOL>(&fCapNdvs));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatsFilterCache::CKey::~CKey
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CStatsFilterCache::CKey::~CKey()
+{
+	m_pstats->Release();
+	m_pstatspred->Release();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatsFilterCache::CKey::UlHash
+//
+//	@doc:
+//		Hash function
+//
+//---------------------------------------------------------------------------
+ULONG
+CStatsFilterCache::CKey::UlHash
+	(
+	const CKey *pkey
+	)
+{
+	return pkey->m_ulHash;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatsFilterCache::CKey::FEqual
+//
+//	@doc:
+//		Equality function
+//
+//---------------------------------------------------------------------------
+BOOL
+CStatsFilterCache::CKey::FEqual
+	(
+	const CKey *pkeyFst,
+	const CKey *pkeySnd
+	)
+{
+	return pkeyFst->m_pstats == pkeySnd->m_pstats &&
+			pkeyFst->m_fCapNdvs == pkeySnd->m_fCapNdvs &&
+			pkeyFst->m_ulHash == pkeySnd->m_ulHash &&
+			CStatsPredUtils::FEqual(pkeyFst->m_pstatspred, pkeySnd->m_pstatspred);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatsFilterCache::CStatsFilterCache
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CStatsFilterCache::CStatsFilterCache
+	(
+	IMemoryPool *pmp,
+	ULONG ulMaxEntries
+	)
+	:
+	m_pmp(pmp),
+	m_phmkeystats(NULL),
+	m_ulMaxEntries(ulMaxEntries),
+	m_ulpLookups(0),
+	m_ulpHits(0)
+{
+	GPOS_ASSERT(NULL != pmp);
+
+	m_phmkeystats = GPOS_NEW(m_pmp) HMKeyStats(m_pmp);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatsFilterCache::~CStatsFilterCache
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CStatsFilterCache::~CStatsFilterCache()
+{
+	m_phmkeystats->Release();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatsFilterCache::PstatsFilter
+//
+//	@doc:
+//		Derive statistics of given filter on given input statistics, or
+//		copy statistics derived for an identical filter before; only
+//		statistics derived in the memory pool of the cache are cached,
+//		since statistics in other pools may not outlive the cache; once the
+//		cache is full, further filters are derived without caching them
+//
+//---------------------------------------------------------------------------
+IStatistics *
+CStatsFilterCache::PstatsFilter
+	(
+	IMemoryPool *pmp,
+	IStatistics *pstats,
+	CStatsPred *pstatspred,
+	BOOL fCapNdvs
+	)
+{
+	GPOS_ASSERT(NULL != pstats);
+	GPOS_ASSERT(NULL != pstatspred);
+
+	if (pmp != m_pmp)
+	{
+		return pstats->PstatsFilter(pmp, pstatspred, fCapNdvs);
+	}
+
+	// filters sort their components on column ids before derivation;
+	// sort them here so that the key does not depend on extraction order
+	if (CStatsPred::EsptConj == pstatspred->Espt())
+	{
+		CStatsPredConj::PstatspredConvert(pstatspred)->Sort();
+	}
+	else if (CStatsPred::EsptDisj == pstatspred->Espt())
+	{
+		CStatsPredDisj::PstatspredConvert(pstatspred)->Sort();
+	}
+
+	pstats->AddRef();
+	pstatspred->AddRef();
+	CKey *pkey = GPOS_NEW(m_pmp) CKey(pstats, pstatspred, fCapNdvs);
+
+	(void) UlpExchangeAdd(&m_ulpLookups, 1);
+	IStatistics *pstatsResult = NULL;
+	{
+		CAutoMutex am(m_mutex);
+		am.Lock();
+
+		pstatsResult = m_phmkeystats->PtLookup(pkey);
+		if (NULL != pstatsResult)
+		{
+			pstatsResult->AddRef();
+		}
+	}
+
+	if (NULL != pstatsResult)
+	{
+		(void) UlpExchangeAdd(&m_ulpHits, 1);
+		GPOS_DELETE(pkey);
+
+		IStatistics *pstatsCopy = pstatsResult->PstatsCopy(pmp);
+		pstatsResult->Release();
+
+		return pstatsCopy;
+	}
+
+	pstatsResult = pstats->PstatsFilter(pmp, pstatspred, fCapNdvs);
+
+	BOOL fInserted = false;
+	{
+		CAutoMutex am(m_mutex);
+		am.Lock();
+
+		if (m_phmkeystats->UlEntries() < m_ulMaxEntries)
+		{
+			fInserted = m_phmkeystats->FInsert(pkey, pstatsResult);
+		}
+	}
+
+	if (!fInserted)
+	{
+		// cache is full, or an identical filter was derived concurrently
+		GPOS_DELETE(pkey);
+
+		return pstatsResult;
+	}
+
+	// the cache keeps the derived statistics, the caller gets a copy
+	return pstatsResult->PstatsCopy(pmp);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatsFilterCache::OsPrint
+//
+//	@doc:
+//		Print lookup and hit counters
+//
+//---------------------------------------------------------------------------
+IOstream &
+CStatsFilterCache::OsPrint
+	(
+	IOstream &os
+	)
+	const
+{
+	DOUBLE dHitRate = 0.0;
+	if (0 < m_ulpLookups)
+	{
+		dHitRate = 100.0 * (DOUBLE) m_ulpHits / (DOUBLE) m_ulpLookups;
+	}
+
+	os
+		<< m_ulpLookups << " lookups"
+		<< ", " << m_ulpHits << " hits"
+		<< ", " << dHitRate << "% hit rate";
+
+	return os;
+}
+
+// EOF
@@ -29,13 +29,15 @@ CStatsPredLike::CStatsPredLike
 	ULONG ulColId,
 	CExpression *pexprLeft,
 	CExpression *pexprRight,
-	CDouble dDefaultScaleFactor
+	CDouble dDefaultScaleFactor,
+	IDatum *pdatumPattern
 	)
 	:
 	CStatsPred(ulColId),
 	m_pexprLeft(pexprLeft),
 	m_pexprRight(pexprRight),
-	m_dDefaultScaleFactor(dDefaultScaleFactor)
+	m_dDefaultScaleFactor(dDefaultScaleFactor),
+	m_pdatumPattern(pdatumPattern)
 {
 	GPOS_ASSERT(ULONG_MAX != ulColId);
 	GPOS_ASSERT(NULL != pexprLeft);
@@ -55,6 +57,7 @@ CStatsPredLike::~CStatsPredLike()
 {
 	m_pexprLeft->Release();
 	m_pexprRight->Release();
+	CRefCount::SafeRelease(m_pdatumPattern);
 }
 
 //---------------------------------------------------------------------------
@@ -30,6 +30,8 @@
 #include "naucrates/statistics/CStatistics.h"
 #include "naucrates/statistics/CStatsPredDisj.h"
 #include "naucrates/statistics/CStatsPredConj.h"
+#include "naucrates/statistics/CStatsPredPoint.h"
+#include "naucrates/statistics/CStatsPredUnsupported.h"
 
 using namespace gpopt;
 using namespace gpmd;
@@ -881,10 +883,25 @@ CStatsPredUtils::PstatspredLike
 		dDefaultScaleFactor = pdatumLiteral->DLikePredicateScaleFactor();
 	}
 
+	// the histogram of the column can be matched against the literal only if
+	// the literal is the pattern, i.e. the column is on the left hand side
+	IDatum *pdatumPattern = NULL;
+	CExpression *pexprLeftNoCast = pexprLeft;
+	if (COperator::EopScalarCast == pexprLeft->Pop()->Eopid())
+	{
+		pexprLeftNoCast = (*pexprLeft)[0];
+	}
+
+	if (pexprLeftNoCast == pexprScIdent)
+	{
+		pdatumLiteral->AddRef();
+		pdatumPattern = pdatumLiteral;
+	}
+
 	pexprLeft->AddRef();
 	pexprRight->AddRef();
 
-	return GPOS_NEW(pmp) CStatsPredLike(ulColId, pexprLeft, pexprRight, dDefaultScaleFactor);
+	return GPOS_NEW(pmp) CStatsPredLike(ulColId, pexprLeft, pexprRight, dDefaultScaleFactor, pdatumPattern);
 }
 
 
@@ -1286,4 +1303,174 @@ CStatsPredUtils::FUnsupportedPredOnDefinedCol
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatsPredUtils::UlHash
+//
+//	@doc:
+//		Hash of a statistics filter, combining the hashes of its components
+//
+//---------------------------------------------------------------------------
+ULONG
+CStatsPredUtils::UlHash
+	(
+	const CStatsPred *pstatspred
+	)
+{
+	GPOS_CHECK_STACK_SIZE;
+	GPOS_ASSERT(NULL != pstatspred);
+
+	CStatsPred *pstatspredNonConst = const_cast<CStatsPred *>(pstatspred);
+	ULONG ulHash = gpos::UlCombineHashes(pstatspred->Espt(), pstatspred->UlColId());
+	switch (pstatspred->Espt())
+	{
+		case CStatsPred::EsptPoint:
+		{
+			CStatsPredPoint *pstatspredPoint = CStatsPredPoint::PstatspredConvert(pstatspredNonConst);
+			ulHash = gpos::UlCombineHashes(ulHash, pstatspredPoint->Escmpt());
+			return gpos::UlCombineHashes(ulHash, pstatspredPoint->Ppoint()->Pdatum()->UlHash());
+		}
+
+		case CStatsPred::EsptConj:
+		case CStatsPred::EsptDisj:
+		{
+			DrgPstatspred *pdrgpstatspred = NULL;
+			if (CStatsPred::EsptConj == pstatspred->Espt())
+			{
+				pdrgpstatspred = CStatsPredConj::PstatspredConvert(pstatspredNonConst)->Pdrgpstatspred();
+			}
+			else
+			{
+				pdrgpstatspred = CStatsPredDisj::PstatspredConvert(pstatspredNonConst)->Pdrgpstatspred();
+			}
+
+			const ULONG ulFilters = pdrgpstatspred->UlLength();
+			for (ULONG ul = 0; ul < ulFilters; ul++)
+			{
+				ulHash = gpos::UlCombineHashes(ulHash, UlHash((*pdrgpstatspred)[ul]));
+			}
+			return ulHash;
+		}
+
+		case CStatsPred::EsptLike:
+		{
+			CStatsPredLike *pstatspredLike = CStatsPredLike::PstatspredConvert(pstatspredNonConst);
+			ulHash = gpos::UlCombineHashes(ulHash, CExpression::UlHash(pstatspredLike->PexprLeft()));
+			return gpos::UlCombineHashes(ulHash, CExpression::UlHash(pstatspredLike->PexprRight()));
+		}
+
+		case CStatsPred::EsptUnsupported:
+		{
+			CStatsPredUnsupported *pstatspredUnsupported = CStatsPredUnsupported::PstatspredConvert(pstatspredNonConst);
+			return gpos::UlCombineHashes(ulHash, pstatspredUnsupported->Estatscmptype());
+		}
+
+		default:
+			GPOS_ASSERT(!"Unexpected statistics filter type");
+			return ulHash;
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatsPredUtils::FEqual
+//
+//	@doc:
+//		Are the given statistics filters identical; components of
+//		conjunctions and disjunctions are compared in order
+//
+//---------------------------------------------------------------------------
+BOOL
+CStatsPredUtils::FEqual
+	(
+	const CStatsPred *pstatspredFst,
+	const CStatsPred *pstatspredSnd
+	)
+{
+	GPOS_CHECK_STACK_SIZE;
+	GPOS_ASSERT(NULL != pstatspredFst);
+	GPOS_ASSERT(NULL != pstatspredSnd);
+
+	if (pstatspredFst == pstatspredSnd)
+	{
+		return true;
+	}
+
+	if (pstatspredFst->Espt() != pstatspredSnd->Espt() || pstatspredFst->UlColId() != pstatspredSnd->UlColId())
+	{
+		return false;
+	}
+
+	CStatsPred *pstatspredFstNonConst = const_cast<CStatsPred *>(pstatspredFst);
+	CStatsPred *pstatspredSndNonConst = const_cast<CStatsPred *>(pstatspredSnd);
+	switch (pstatspredFst->Espt())
+	{
+		case CStatsPred::EsptPoint:
+		{
+			CStatsPredPoint *pstatspredPointFst = CStatsPredPoint::PstatspredConvert(pstatspredFstNonConst);
+			CStatsPredPoint *pstatspredPointSnd = CStatsPredPoint::PstatspredConvert(pstatspredSndNonConst);
+
+			return pstatspredPointFst->Escmpt() == pstatspredPointSnd->Escmpt() &&
+					pstatspredPointFst->Ppoint()->Pdatum()->FMatch(pstatspredPointSnd->Ppoint()->Pdatum());
+		}
+
+		case CStatsPred::EsptConj:
+		case CStatsPred::EsptDisj:
+		{
+			DrgPstatspred *pdrgpstatspredFst = NULL;
+			DrgPstatspred *pdrgpstatspredSnd = NULL;
+			if (CStatsPred::EsptConj == pstatspredFst->Espt())
+			{
+				pdrgpstatspredFst = CStatsPredConj::PstatspredConvert(pstatspredFstNonConst)->Pdrgpstatspred();
+				pdrgpstatspredSnd = CStatsPredConj::PstatspredConvert(pstatspredSndNonConst)->Pdrgpstatspred();
+			}
+			else
+			{
+				pdrgpstatspredFst = CStatsPredDisj::PstatspredConvert(pstatspredFstNonConst)->Pdrgpstatspred();
+				pdrgpstatspredSnd = CStatsPredDisj::PstatspredConvert(pstatspredSndNonConst)->Pdrgpstatspred();
+			}
+
+			const ULONG ulFilters = pdrgpstatspredFst->UlLength();
+			if (ulFilters != pdrgpstatspredSnd->UlLength())
+			{
+				return false;
+			}
+
+			for (ULONG ul = 0; ul < ulFilters; ul++)
+			{
+				if (!FEqual((*pdrgpstatspredFst)[ul], (*pdrgpstatspredSnd)[ul]))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		case CStatsPred::EsptLike:
+		{
+			CStatsPredLike *pstatspredLikeFst = CStatsPredLike::PstatspredConvert(pstatspredFstNonConst);
+			CStatsPredLike *pstatspredLikeSnd = CStatsPredLike::PstatspredConvert(pstatspredSndNonConst);
+
+			return pstatspredLikeFst->DDefaultScaleFactor() == pstatspredLikeSnd->DDefaultScaleFactor() &&
+					CUtils::FEqual(pstatspredLikeFst->PexprLeft(), pstatspredLikeSnd->PexprLeft()) &&
+					CUtils::FEqual(pstatspredLikeFst->PexprRight(), pstatspredLikeSnd->PexprRight());
+		}
+
+		case CStatsPred::EsptUnsupported:
+		{
+			CStatsPredUnsupported *pstatspredUnsupportedFst = CStatsPredUnsupported::PstatspredConvert(pstatspredFstNonConst);
+			CStatsPredUnsupported *pstatspredUnsupportedSnd = CStatsPredUnsupported::PstatspredConvert(pstatspredSndNonConst);
+
+			return pstatspredUnsupportedFst->Estatscmptype() == pstatspredUnsupportedSnd->Estatscmptype() &&
+					pstatspredUnsupportedFst->DScaleFactor() == pstatspredUnsupportedSnd->DScaleFactor();
+		}
+
+		default:
+			GPOS_ASSERT(!"Unexpected statistics filter type");
+			return false;
+	}
+}
+
+
 // EOF
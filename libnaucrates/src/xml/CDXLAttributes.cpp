@@ -0,0 +1,229 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CDXLAttributes.cpp
+//
+//	@doc:
+//		Implementation of the view of DXL element attributes with names
+//		resolved to DXL tokens
+//---------------------------------------------------------------------------
+
+#include "naucrates/dxl/xml/CDXLAttributes.h"
+
+#include <algorithm>
+
+using namespace gpdxl;
+
+XERCES_CPP_NAMESPACE_USE
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLAttributes::CDXLAttributes
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CDXLAttributes::CDXLAttributes
+	(
+	IMemoryPool *pmp
+	)
+	:
+	m_pmp(pmp),
+	m_pattrs(NULL),
+	m_rgxmlszName(NULL),
+	m_ulLength(0),
+	m_ulCapacity(0)
+{
+	GPOS_ASSERT(NULL != pmp);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLAttributes::~CDXLAttributes
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CDXLAttributes::~CDXLAttributes()
+{
+	GPOS_DELETE_ARRAY(m_rgxmlszName);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLAttributes::Reset
+//
+//	@doc:
+//		Make the view refer to the attributes of a new element and resolve
+//		their names to token strings
+//
+//---------------------------------------------------------------------------
+void
+CDXLAttributes::Reset
+	(
+	const Attributes *pattrs
+	)
+{
+	GPOS_ASSERT(NULL != pattrs);
+	GPOS_ASSERT(this != pattrs);
+
+	m_pattrs = pattrs;
+	m_ulLength = (ULONG) pattrs->getLength();
+
+	if (m_ulLength > m_ulCapacity)
+	{
+		GPOS_DELETE_ARRAY(m_rgxmlszName);
+		m_rgxmlszName = NULL;
+		m_ulCapacity = std::max(m_ulLength, 2 * m_ulCapacity);
+		m_rgxmlszName = GPOS_NEW_ARRAY(m_pmp, const XMLCh *, m_ulCapacity);
+	}
+
+	for (ULONG ul = 0; ul < m_ulLength; ul++)
+	{
+		Edxltoken edxltoken = CDXLTokens::EdxltokenFromXmlstr(pattrs->getQName(ul));
+		m_rgxmlszName[ul] = NULL;
+		if (EdxltokenSentinel != edxltoken)
+		{
+			m_rgxmlszName[ul] = CDXLTokens::XmlstrToken(edxltoken);
+		}
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLAttributes::FFindToken
+//
+//	@doc:
+//		Find the attribute whose name resolved to the given token string
+//
+//---------------------------------------------------------------------------
+BOOL
+CDXLAttributes::FFindToken
+	(
+	const XMLCh *xmlszToken,
+	XMLSize_t *pulIndex
+	)
+	const
+{
+	for (ULONG ul = 0; ul < m_ulLength; ul++)
+	{
+		if (m_rgxmlszName[ul] == xmlszToken)
+		{
+			*pulIndex = ul;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLAttributes::getIndex
+//
+//	@doc:
+//		Index of the attribute with the given name; token strings, which
+//		parse handlers use for lookups, match by address, other strings
+//		are resolved to tokens first
+//
+//---------------------------------------------------------------------------
+bool
+CDXLAttributes::getIndex
+	(
+	const XMLCh *const xmlszQName,
+	XMLSize_t &ulIndex
+	)
+	const
+{
+	if (FFindToken(xmlszQName, &ulIndex))
+	{
+		return true;
+	}
+
+	Edxltoken edxltoken = CDXLTokens::EdxltokenFromXmlstr(xmlszQName);
+	if (EdxltokenSentinel == edxltoken)
+	{
+		return m_pattrs->getIndex(xmlszQName, ulIndex);
+	}
+
+	const XMLCh *xmlszToken = CDXLTokens::XmlstrToken(edxltoken);
+	return xmlszToken != xmlszQName && FFindToken(xmlszToken, &ulIndex);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLAttributes::getIndex
+//
+//	@doc:
+//		Index of the attribute with the given name, or -1
+//
+//---------------------------------------------------------------------------
+int
+CDXLAttributes::getIndex
+	(
+	const XMLCh *const xmlszQName
+	)
+	const
+{
+	XMLSize_t ulIndex = 0;
+	if (!getIndex(xmlszQName, ulIndex))
+	{
+		return -1;
+	}
+
+	return (int) ulIndex;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLAttributes::getType
+//
+//	@doc:
+//		Type of the attribute with the given name
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLAttributes::getType
+	(
+	const XMLCh *const xmlszQName
+	)
+	const
+{
+	XMLSize_t ulIndex = 0;
+	if (!getIndex(xmlszQName, ulIndex))
+	{
+		return NULL;
+	}
+
+	return m_pattrs->getType(ulIndex);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLAttributes::getValue
+//
+//	@doc:
+//		Value of the attribute with the given name
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLAttributes::getValue
+	(
+	const XMLCh *const xmlszQName
+	)
+	const
+{
+	XMLSize_t ulIndex = 0;
+	if (!getIndex(xmlszQName, ulIndex))
+	{
+		return NULL;
+	}
+
+	return m_pattrs->getValue(ulIndex);
+}
+
+// EOF
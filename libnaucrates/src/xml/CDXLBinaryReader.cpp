@@ -0,0 +1,861 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CDXLBinaryReader.cpp
+//
+//	@doc:
+//		Implementation of the reader replaying binary DXL documents
+//---------------------------------------------------------------------------
+
+#include "gpos/common/clibwrapper.h"
+
+#include "naucrates/exception.h"
+#include "naucrates/dxl/parser/CParseHandlerManager.h"
+#include "naucrates/dxl/xml/CDXLBinaryReader.h"
+#include "naucrates/dxl/xml/dxltokens.h"
+
+#include <xercesc/util/XMLString.hpp>
+#include <xercesc/util/XMLUniDefs.hpp>
+
+using namespace gpdxl;
+
+XERCES_CPP_NAMESPACE_USE
+
+// initial size of the string buffer
+#define GPDXL_BINARY_READER_BUFFER_SIZE 1024
+
+// attribute namespace and type reported to parse handlers
+static const XMLCh xmlszEmpty[] = { chNull };
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::CAttributes::getURI
+//
+//	@doc:
+//		Attributes of DXL documents have no namespace
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::CAttributes::getURI
+	(
+	const XMLSize_t ulIndex
+	)
+	const
+{
+	if (ulIndex >= m_ulLength)
+	{
+		return NULL;
+	}
+
+	return xmlszEmpty;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::CAttributes::getLocalName
+//
+//	@doc:
+//		Name of the attribute at the given index
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::CAttributes::getLocalName
+	(
+	const XMLSize_t ulIndex
+	)
+	const
+{
+	if (ulIndex >= m_ulLength)
+	{
+		return NULL;
+	}
+
+	return (*m_pdrgpattr)[(ULONG) ulIndex]->m_xmlszName;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::CAttributes::getQName
+//
+//	@doc:
+//		Qualified name of the attribute at the given index, which is the
+//		same as its local name
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::CAttributes::getQName
+	(
+	const XMLSize_t ulIndex
+	)
+	const
+{
+	return getLocalName(ulIndex);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::CAttributes::getType
+//
+//	@doc:
+//		Attribute types are not recorded in binary documents
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::CAttributes::getType
+	(
+	const XMLSize_t ulIndex
+	)
+	const
+{
+	if (ulIndex >= m_ulLength)
+	{
+		return NULL;
+	}
+
+	return xmlszEmpty;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::CAttributes::getValue
+//
+//	@doc:
+//		Value of the attribute at the given index
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::CAttributes::getValue
+	(
+	const XMLSize_t ulIndex
+	)
+	const
+{
+	if (ulIndex >= m_ulLength)
+	{
+		return NULL;
+	}
+
+	return (*m_pdrgpattr)[(ULONG) ulIndex]->m_xmlszValue;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::CAttributes::getIndex
+//
+//	@doc:
+//		Index of the attribute with the given name; parse handlers look up
+//		attributes by token strings, which match by address when the
+//		attribute name was written as a token
+//
+//---------------------------------------------------------------------------
+bool
+CDXLBinaryReader::CAttributes::getIndex
+	(
+	const XMLCh *const xmlszQName,
+	XMLSize_t &ulIndex
+	)
+	const
+{
+	for (ULONG ul = 0; ul < m_ulLength; ul++)
+	{
+		if ((*m_pdrgpattr)[ul]->m_xmlszName == xmlszQName)
+		{
+			ulIndex = ul;
+			return true;
+		}
+	}
+
+	for (ULONG ul = 0; ul < m_ulLength; ul++)
+	{
+		if (0 == XMLString::compareString((*m_pdrgpattr)[ul]->m_xmlszName, xmlszQName))
+		{
+			ulIndex = ul;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::CAttributes::getIndex
+//
+//	@doc:
+//		Index of the attribute with the given name, or -1
+//
+//---------------------------------------------------------------------------
+int
+CDXLBinaryReader::CAttributes::getIndex
+	(
+	const XMLCh *const xmlszQName
+	)
+	const
+{
+	XMLSize_t ulIndex = 0;
+	if (!getIndex(xmlszQName, ulIndex))
+	{
+		return -1;
+	}
+
+	return (int) ulIndex;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::CAttributes::getIndex
+//
+//	@doc:
+//		Index of the attribute with the given namespace and local name
+//
+//---------------------------------------------------------------------------
+bool
+CDXLBinaryReader::CAttributes::getIndex
+	(
+	const XMLCh *const xmlszUri,
+	const XMLCh *const xmlszLocalPart,
+	XMLSize_t &ulIndex
+	)
+	const
+{
+	if (NULL != xmlszUri && chNull != xmlszUri[0])
+	{
+		return false;
+	}
+
+	return getIndex(xmlszLocalPart, ulIndex);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::CAttributes::getIndex
+//
+//	@doc:
+//		Index of the attribute with the given namespace and local name, or -1
+//
+//---------------------------------------------------------------------------
+int
+CDXLBinaryReader::CAttributes::getIndex
+	(
+	const XMLCh *const xmlszUri,
+	const XMLCh *const xmlszLocalPart
+	)
+	const
+{
+	XMLSize_t ulIndex = 0;
+	if (!getIndex(xmlszUri, xmlszLocalPart, ulIndex))
+	{
+		return -1;
+	}
+
+	return (int) ulIndex;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::CAttributes::getType
+//
+//	@doc:
+//		Type of the attribute with the given namespace and local name
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::CAttributes::getType
+	(
+	const XMLCh *const xmlszUri,
+	const XMLCh *const xmlszLocalPart
+	)
+	const
+{
+	XMLSize_t ulIndex = 0;
+	if (!getIndex(xmlszUri, xmlszLocalPart, ulIndex))
+	{
+		return NULL;
+	}
+
+	return getType(ulIndex);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::CAttributes::getType
+//
+//	@doc:
+//		Type of the attribute with the given name
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::CAttributes::getType
+	(
+	const XMLCh *const xmlszQName
+	)
+	const
+{
+	XMLSize_t ulIndex = 0;
+	if (!getIndex(xmlszQName, ulIndex))
+	{
+		return NULL;
+	}
+
+	return getType(ulIndex);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::CAttributes::getValue
+//
+//	@doc:
+//		Value of the attribute with the given namespace and local name
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::CAttributes::getValue
+	(
+	const XMLCh *const xmlszUri,
+	const XMLCh *const xmlszLocalPart
+	)
+	const
+{
+	XMLSize_t ulIndex = 0;
+	if (!getIndex(xmlszUri, xmlszLocalPart, ulIndex))
+	{
+		return NULL;
+	}
+
+	return getValue(ulIndex);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::CAttributes::getValue
+//
+//	@doc:
+//		Value of the attribute with the given name
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::CAttributes::getValue
+	(
+	const XMLCh *const xmlszQName
+	)
+	const
+{
+	XMLSize_t ulIndex = 0;
+	if (!getIndex(xmlszQName, ulIndex))
+	{
+		return NULL;
+	}
+
+	return getValue(ulIndex);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::CDXLBinaryReader
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CDXLBinaryReader::CDXLBinaryReader
+	(
+	IMemoryPool *pmp,
+	const BYTE *pba,
+	ULONG ulLength
+	)
+	:
+	m_pmp(pmp),
+	m_pba(pba),
+	m_ulLength(ulLength),
+	m_ulPos(0),
+	m_xmlszBuffer(NULL),
+	m_ulBufferLength(0),
+	m_ulBufferCapacity(GPDXL_BINARY_READER_BUFFER_SIZE),
+	m_pdrgpattr(NULL),
+	m_pdrgpelem(NULL),
+	m_ulDepth(0)
+{
+	GPOS_ASSERT(NULL != pba);
+
+	m_xmlszBuffer = GPOS_NEW_ARRAY(m_pmp, XMLCh, m_ulBufferCapacity);
+	m_pdrgpattr = GPOS_NEW(m_pmp) DrgPattr(m_pmp);
+	m_pdrgpelem = GPOS_NEW(m_pmp) DrgPelem(m_pmp);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::~CDXLBinaryReader
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CDXLBinaryReader::~CDXLBinaryReader()
+{
+	GPOS_DELETE_ARRAY(m_xmlszBuffer);
+	m_pdrgpattr->Release();
+	m_pdrgpelem->Release();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::RaiseMalformed
+//
+//	@doc:
+//		Raise an exception for a malformed document
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryReader::RaiseMalformed()
+{
+	GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLBinaryParseError);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::Reserve
+//
+//	@doc:
+//		Grow the string buffer so that the given number of characters can
+//		be appended
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryReader::Reserve
+	(
+	ULONG ulChars
+	)
+{
+	if (m_ulBufferLength + ulChars <= m_ulBufferCapacity)
+	{
+		return;
+	}
+
+	ULONG ulCapacity = m_ulBufferCapacity;
+	while (m_ulBufferLength + ulChars > ulCapacity)
+	{
+		ulCapacity = 2 * ulCapacity;
+	}
+
+	XMLCh *xmlsz = GPOS_NEW_ARRAY(m_pmp, XMLCh, ulCapacity);
+	(void) clib::PvMemCpy(xmlsz, m_xmlszBuffer, m_ulBufferLength * sizeof(XMLCh));
+	GPOS_DELETE_ARRAY(m_xmlszBuffer);
+
+	m_xmlszBuffer = xmlsz;
+	m_ulBufferCapacity = ulCapacity;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::ByteRead
+//
+//	@doc:
+//		Read a single byte
+//
+//---------------------------------------------------------------------------
+BYTE
+CDXLBinaryReader::ByteRead()
+{
+	if (m_ulPos >= m_ulLength)
+	{
+		RaiseMalformed();
+	}
+
+	return m_pba[m_ulPos++];
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::UlRead
+//
+//	@doc:
+//		Read an unsigned integer written in groups of 7 bits
+//
+//---------------------------------------------------------------------------
+ULONG
+CDXLBinaryReader::UlRead()
+{
+	ULONG ul = 0;
+	for (ULONG ulShift = 0; ulShift < 32; ulShift += 7)
+	{
+		BYTE b = ByteRead();
+		ul |= ((ULONG) (b & 0x7f)) << ulShift;
+		if (0 == (b & 0x80))
+		{
+			return ul;
+		}
+	}
+
+	RaiseMalformed();
+	return 0;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::ReadString
+//
+//	@doc:
+//		Read a UTF-8 string and append it to the buffer as a null-terminated
+//		UTF-16 string
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryReader::ReadString()
+{
+	const ULONG ulBytes = UlRead();
+	if (ulBytes > m_ulLength - m_ulPos)
+	{
+		RaiseMalformed();
+	}
+
+	// every byte yields at most one UTF-16 unit
+	Reserve(ulBytes + 1);
+
+	const ULONG ulEnd = m_ulPos + ulBytes;
+	while (m_ulPos < ulEnd)
+	{
+		BYTE b = m_pba[m_ulPos++];
+		ULONG ulChar = 0;
+		ULONG ulContinuation = 0;
+		if (0 == (b & 0x80))
+		{
+			ulChar = b;
+		}
+		else if (0xc0 == (b & 0xe0))
+		{
+			ulChar = b & 0x1f;
+			ulContinuation = 1;
+		}
+		else if (0xe0 == (b & 0xf0))
+		{
+			ulChar = b & 0x0f;
+			ulContinuation = 2;
+		}
+		else if (0xf0 == (b & 0xf8))
+		{
+			ulChar = b & 0x07;
+			ulContinuation = 3;
+		}
+		else
+		{
+			RaiseMalformed();
+		}
+
+		for (ULONG ul = 0; ul < ulContinuation; ul++)
+		{
+			if (m_ulPos >= ulEnd || 0x80 != (m_pba[m_ulPos] & 0xc0))
+			{
+				RaiseMalformed();
+			}
+			ulChar = (ulChar << 6) | (m_pba[m_ulPos++] & 0x3f);
+		}
+
+		if (0x10000 > ulChar)
+		{
+			m_xmlszBuffer[m_ulBufferLength++] = (XMLCh) ulChar;
+		}
+		else if (0x10ffff >= ulChar)
+		{
+			// surrogate pair
+			ulChar -= 0x10000;
+			m_xmlszBuffer[m_ulBufferLength++] = (XMLCh) (0xd800 | (ulChar >> 10));
+			m_xmlszBuffer[m_ulBufferLength++] = (XMLCh) (0xdc00 | (ulChar & 0x3ff));
+		}
+		else
+		{
+			RaiseMalformed();
+		}
+	}
+
+	m_xmlszBuffer[m_ulBufferLength++] = chNull;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::FReadName
+//
+//	@doc:
+//		Read a name; returns false if no name was written
+//
+//---------------------------------------------------------------------------
+BOOL
+CDXLBinaryReader::FReadName
+	(
+	SName *pname
+	)
+{
+	GPOS_ASSERT(NULL != pname);
+
+	const ULONG ulName = UlRead();
+
+	pname->m_xmlszToken = NULL;
+	pname->m_ulOffset = 0;
+
+	if (CDXLBinaryFormat::EnameNone == ulName)
+	{
+		return false;
+	}
+
+	if (CDXLBinaryFormat::EnameInline == ulName)
+	{
+		pname->m_ulOffset = m_ulBufferLength;
+		ReadString();
+		return true;
+	}
+
+	const ULONG ulToken = ulName - CDXLBinaryFormat::EnameToken;
+	if (EdxltokenSentinel <= ulToken)
+	{
+		RaiseMalformed();
+	}
+
+	pname->m_xmlszToken = CDXLTokens::XmlstrToken((Edxltoken) ulToken);
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::XmlszName
+//
+//	@doc:
+//		String of the given name; names in the buffer move when it grows
+//
+//---------------------------------------------------------------------------
+const XMLCh *
+CDXLBinaryReader::XmlszName
+	(
+	const SName &name
+	)
+	const
+{
+	if (NULL != name.m_xmlszToken)
+	{
+		return name.m_xmlszToken;
+	}
+
+	return m_xmlszBuffer + name.m_ulOffset;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::AppendQname
+//
+//	@doc:
+//		Append the qualified name of an element, "prefix:name", to the buffer
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryReader::AppendQname
+	(
+	const SElement *pelem
+	)
+{
+	ULONG ulPrefixLength = 0;
+	if (pelem->m_fNamespace)
+	{
+		ulPrefixLength = (ULONG) XMLString::stringLen(XmlszName(pelem->m_nameNamespace));
+	}
+	const ULONG ulNameLength = (ULONG) XMLString::stringLen(XmlszName(pelem->m_name));
+
+	Reserve(ulPrefixLength + ulNameLength + 2);
+
+	if (pelem->m_fNamespace)
+	{
+		(void) clib::PvMemCpy(m_xmlszBuffer + m_ulBufferLength, XmlszName(pelem->m_nameNamespace), ulPrefixLength * sizeof(XMLCh));
+		m_ulBufferLength += ulPrefixLength;
+		m_xmlszBuffer[m_ulBufferLength++] = chColon;
+	}
+
+	(void) clib::PvMemCpy(m_xmlszBuffer + m_ulBufferLength, XmlszName(pelem->m_name), ulNameLength * sizeof(XMLCh));
+	m_ulBufferLength += ulNameLength;
+	m_xmlszBuffer[m_ulBufferLength++] = chNull;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::ReadHeader
+//
+//	@doc:
+//		Read the document header and check that the document was written
+//		in this format version with the same token table
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryReader::ReadHeader()
+{
+	if (CDXLBinaryFormat::EhdrMagic0 != ByteRead() ||
+		CDXLBinaryFormat::EhdrMagic1 != ByteRead() ||
+		CDXLBinaryFormat::EhdrMagic2 != ByteRead() ||
+		CDXLBinaryFormat::EhdrMagic3 != ByteRead() ||
+		CDXLBinaryFormat::EhdrVersion != UlRead() ||
+		CDXLTokens::UlTokensHash() != UlRead())
+	{
+		RaiseMalformed();
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::OpenElement
+//
+//	@doc:
+//		Read an element start with the attributes following it and hand it
+//		to the active parse handler
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryReader::OpenElement
+	(
+	CParseHandlerManager *pphm
+	)
+{
+	if (m_ulDepth == m_pdrgpelem->UlLength())
+	{
+		m_pdrgpelem->Append(GPOS_NEW(m_pmp) SElement());
+	}
+	SElement *pelem = (*m_pdrgpelem)[m_ulDepth];
+	m_ulDepth++;
+
+	pelem->m_ulBufferStart = m_ulBufferLength;
+	pelem->m_fNamespace = FReadName(&pelem->m_nameNamespace);
+	if (!FReadName(&pelem->m_name))
+	{
+		RaiseMalformed();
+	}
+	pelem->m_ulQnameOffset = m_ulBufferLength;
+	AppendQname(pelem);
+
+	const ULONG ulNamesEnd = m_ulBufferLength;
+
+	ULONG ulAttrs = 0;
+	while (m_ulPos < m_ulLength && CDXLBinaryFormat::ErecAttribute == m_pba[m_ulPos])
+	{
+		m_ulPos++;
+
+		if (ulAttrs == m_pdrgpattr->UlLength())
+		{
+			m_pdrgpattr->Append(GPOS_NEW(m_pmp) SAttribute());
+		}
+		SAttribute *pattr = (*m_pdrgpattr)[ulAttrs];
+		ulAttrs++;
+
+		if (!FReadName(&pattr->m_name))
+		{
+			RaiseMalformed();
+		}
+		pattr->m_ulOffset = m_ulBufferLength;
+		ReadString();
+	}
+
+	// the buffer does not grow any more, so strings can be handed out
+	for (ULONG ul = 0; ul < ulAttrs; ul++)
+	{
+		SAttribute *pattr = (*m_pdrgpattr)[ul];
+		pattr->m_xmlszName = XmlszName(pattr->m_name);
+		pattr->m_xmlszValue = m_xmlszBuffer + pattr->m_ulOffset;
+	}
+
+	CParseHandlerBase *pph = pphm->PphActive();
+	if (NULL == pph)
+	{
+		RaiseMalformed();
+	}
+
+	CAttributes attrs(m_pdrgpattr, ulAttrs);
+	pph->startElement
+			(
+			pelem->m_fNamespace ? CDXLTokens::XmlstrToken(EdxltokenNamespaceURI) : xmlszEmpty,
+			XmlszName(pelem->m_name),
+			m_xmlszBuffer + pelem->m_ulQnameOffset,
+			attrs
+			);
+
+	// attribute values are no longer needed
+	m_ulBufferLength = ulNamesEnd;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::CloseElement
+//
+//	@doc:
+//		Hand the end of the innermost open element to the active parse handler
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryReader::CloseElement
+	(
+	CParseHandlerManager *pphm
+	)
+{
+	if (0 == m_ulDepth)
+	{
+		RaiseMalformed();
+	}
+
+	m_ulDepth--;
+	const SElement *pelem = (*m_pdrgpelem)[m_ulDepth];
+
+	CParseHandlerBase *pph = pphm->PphActive();
+	if (NULL == pph)
+	{
+		RaiseMalformed();
+	}
+
+	pph->endElement
+			(
+			pelem->m_fNamespace ? CDXLTokens::XmlstrToken(EdxltokenNamespaceURI) : xmlszEmpty,
+			XmlszName(pelem->m_name),
+			m_xmlszBuffer + pelem->m_ulQnameOffset
+			);
+
+	m_ulBufferLength = pelem->m_ulBufferStart;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinaryReader::Parse
+//
+//	@doc:
+//		Replay the document to the parse handlers of the given manager
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinaryReader::Parse
+	(
+	CParseHandlerManager *pphm
+	)
+{
+	GPOS_ASSERT(NULL != pphm);
+
+	ReadHeader();
+
+	while (true)
+	{
+		switch (ByteRead())
+		{
+			case CDXLBinaryFormat::ErecOpenElement:
+				OpenElement(pphm);
+				break;
+
+			case CDXLBinaryFormat::ErecCloseElement:
+				CloseElement(pphm);
+				break;
+
+			case CDXLBinaryFormat::ErecEnd:
+				if (0 != m_ulDepth || m_ulPos != m_ulLength)
+				{
+					RaiseMalformed();
+				}
+				return;
+
+			default:
+				// attribute outside of an element start or unknown record
+				RaiseMalformed();
+		}
+	}
+}
+
+// EOF
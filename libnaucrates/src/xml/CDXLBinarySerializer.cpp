@@ -0,0 +1,557 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CDXLBinarySerializer.cpp
+//
+//	@doc:
+//		Implementation of the serializer writing DXL documents in binary format
+//---------------------------------------------------------------------------
+
+#include "gpos/common/clibwrapper.h"
+
+#include "naucrates/dxl/xml/CDXLBinarySerializer.h"
+#include "naucrates/dxl/xml/dxltokens.h"
+
+using namespace gpdxl;
+
+// initial size of the document buffer
+#define GPDXL_BINARY_BUFFER_SIZE 1024
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::CDXLBinarySerializer
+//
+//	@doc:
+//		Ctor; writes the document header
+//
+//---------------------------------------------------------------------------
+CDXLBinarySerializer::CDXLBinarySerializer
+	(
+	IMemoryPool *pmp
+	)
+	:
+	CXMLSerializer(pmp),
+	m_pba(NULL),
+	m_ulLength(0),
+	m_ulCapacity(GPDXL_BINARY_BUFFER_SIZE),
+	m_strValue(pmp)
+{
+	m_pba = GPOS_NEW_ARRAY(pmp, BYTE, m_ulCapacity);
+
+	WriteByte(CDXLBinaryFormat::EhdrMagic0);
+	WriteByte(CDXLBinaryFormat::EhdrMagic1);
+	WriteByte(CDXLBinaryFormat::EhdrMagic2);
+	WriteByte(CDXLBinaryFormat::EhdrMagic3);
+	WriteUl(CDXLBinaryFormat::EhdrVersion);
+	WriteUl(CDXLTokens::UlTokensHash());
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::~CDXLBinarySerializer
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CDXLBinarySerializer::~CDXLBinarySerializer()
+{
+	GPOS_DELETE_ARRAY(m_pba);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::Reserve
+//
+//	@doc:
+//		Grow the buffer so that the given number of bytes can be written
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::Reserve
+	(
+	ULONG ulBytes
+	)
+{
+	if (m_ulLength + ulBytes <= m_ulCapacity)
+	{
+		return;
+	}
+
+	ULONG ulCapacity = m_ulCapacity;
+	while (m_ulLength + ulBytes > ulCapacity)
+	{
+		ulCapacity = 2 * ulCapacity;
+	}
+
+	BYTE *pba = GPOS_NEW_ARRAY(Pmp(), BYTE, ulCapacity);
+	(void) clib::PvMemCpy(pba, m_pba, m_ulLength);
+	GPOS_DELETE_ARRAY(m_pba);
+
+	m_pba = pba;
+	m_ulCapacity = ulCapacity;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::WriteByte
+//
+//	@doc:
+//		Write a single byte
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::WriteByte
+	(
+	BYTE b
+	)
+{
+	Reserve(1);
+	m_pba[m_ulLength++] = b;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::WriteUl
+//
+//	@doc:
+//		Write an unsigned integer in groups of 7 bits, least significant
+//		group first; the high bit of a byte is set if more bytes follow
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::WriteUl
+	(
+	ULONG ul
+	)
+{
+	while (0x80 <= ul)
+	{
+		WriteByte((BYTE) (0x80 | (ul & 0x7f)));
+		ul = ul >> 7;
+	}
+	WriteByte((BYTE) ul);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::WriteString
+//
+//	@doc:
+//		Write a string of wide characters in UTF-8
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::WriteString
+	(
+	const WCHAR *wsz,
+	ULONG ulLength
+	)
+{
+	ULONG ulBytes = 0;
+	for (ULONG ul = 0; ul < ulLength; ul++)
+	{
+		ULONG ulChar = (ULONG) wsz[ul];
+		if (0x80 > ulChar)
+		{
+			ulBytes += 1;
+		}
+		else if (0x800 > ulChar)
+		{
+			ulBytes += 2;
+		}
+		else if (0x10000 > ulChar)
+		{
+			ulBytes += 3;
+		}
+		else
+		{
+			ulBytes += 4;
+		}
+	}
+
+	WriteUl(ulBytes);
+	Reserve(ulBytes);
+
+	for (ULONG ul = 0; ul < ulLength; ul++)
+	{
+		ULONG ulChar = (ULONG) wsz[ul];
+		if (0x80 > ulChar)
+		{
+			m_pba[m_ulLength++] = (BYTE) ulChar;
+		}
+		else if (0x800 > ulChar)
+		{
+			m_pba[m_ulLength++] = (BYTE) (0xc0 | (ulChar >> 6));
+			m_pba[m_ulLength++] = (BYTE) (0x80 | (ulChar & 0x3f));
+		}
+		else if (0x10000 > ulChar)
+		{
+			m_pba[m_ulLength++] = (BYTE) (0xe0 | (ulChar >> 12));
+			m_pba[m_ulLength++] = (BYTE) (0x80 | ((ulChar >> 6) & 0x3f));
+			m_pba[m_ulLength++] = (BYTE) (0x80 | (ulChar & 0x3f));
+		}
+		else
+		{
+			m_pba[m_ulLength++] = (BYTE) (0xf0 | (ulChar >> 18));
+			m_pba[m_ulLength++] = (BYTE) (0x80 | ((ulChar >> 12) & 0x3f));
+			m_pba[m_ulLength++] = (BYTE) (0x80 | ((ulChar >> 6) & 0x3f));
+			m_pba[m_ulLength++] = (BYTE) (0x80 | (ulChar & 0x3f));
+		}
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::WriteString
+//
+//	@doc:
+//		Write a string of characters, which are assumed to be UTF-8 encoded
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::WriteString
+	(
+	const CHAR *sz
+	)
+{
+	const ULONG ulBytes = clib::UlStrLen(sz);
+
+	WriteUl(ulBytes);
+	Reserve(ulBytes);
+	(void) clib::PvMemCpy(m_pba + m_ulLength, sz, ulBytes);
+	m_ulLength += ulBytes;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::WriteName
+//
+//	@doc:
+//		Write an element or attribute name as a token id, or inline if the
+//		name is not a token
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::WriteName
+	(
+	const CWStringBase *pstr
+	)
+{
+	if (NULL == pstr)
+	{
+		WriteUl(CDXLBinaryFormat::EnameNone);
+		return;
+	}
+
+	Edxltoken edxltoken = CDXLTokens::EdxltokenLookup(pstr);
+	if (EdxltokenSentinel == edxltoken)
+	{
+		WriteUl(CDXLBinaryFormat::EnameInline);
+		WriteString(pstr->Wsz(), pstr->UlLength());
+		return;
+	}
+
+	WriteUl(CDXLBinaryFormat::EnameToken + (ULONG) edxltoken);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::WriteFormattedAttribute
+//
+//	@doc:
+//		Write an attribute whose value was formatted into the value buffer
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::WriteFormattedAttribute
+	(
+	const CWStringBase *pstrAttr
+	)
+{
+	AddAttribute(pstrAttr, &m_strValue);
+	m_strValue.Reset();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::StartDocument
+//
+//	@doc:
+//		The document header is written on construction
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::StartDocument()
+{
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::OpenElement
+//
+//	@doc:
+//		Write an element start record
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::OpenElement
+	(
+	const CWStringBase *pstrNamespace,
+	const CWStringBase *pstrElem
+	)
+{
+	GPOS_ASSERT(NULL != pstrElem);
+
+	PushElement(pstrElem);
+
+	WriteByte(CDXLBinaryFormat::ErecOpenElement);
+	WriteName(pstrNamespace);
+	WriteName(pstrElem);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::CloseElement
+//
+//	@doc:
+//		Write an element end record
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::CloseElement
+	(
+	const CWStringBase *, // pstrNamespace
+	const CWStringBase *pstrElem
+	)
+{
+	GPOS_ASSERT(NULL != pstrElem);
+
+	PopElement(pstrElem);
+
+	WriteByte(CDXLBinaryFormat::ErecCloseElement);
+
+	GPOS_CHECK_ABORT;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::AddAttribute
+//
+//	@doc:
+//		Write an attribute record
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::AddAttribute
+	(
+	const CWStringBase *pstrAttr,
+	const CWStringBase *pstrValue
+	)
+{
+	GPOS_ASSERT(NULL != pstrAttr);
+	GPOS_ASSERT(NULL != pstrValue);
+
+	WriteByte(CDXLBinaryFormat::ErecAttribute);
+	WriteName(pstrAttr);
+	WriteString(pstrValue->Wsz(), pstrValue->UlLength());
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::AddAttribute
+//
+//	@doc:
+//		Write an attribute record with a character string value
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::AddAttribute
+	(
+	const CWStringBase *pstrAttr,
+	const CHAR *szValue
+	)
+{
+	GPOS_ASSERT(NULL != pstrAttr);
+	GPOS_ASSERT(NULL != szValue);
+
+	WriteByte(CDXLBinaryFormat::ErecAttribute);
+	WriteName(pstrAttr);
+	WriteString(szValue);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::AddAttribute
+//
+//	@doc:
+//		Write an attribute record with a ULONG value; numbers are formatted as
+//		in XML documents so that parse handlers read both formats alike
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::AddAttribute
+	(
+	const CWStringBase *pstrAttr,
+	ULONG ulValue
+	)
+{
+	m_strValue.AppendFormat(GPOS_WSZ_LIT("%u"), ulValue);
+	WriteFormattedAttribute(pstrAttr);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::AddAttribute
+//
+//	@doc:
+//		Write an attribute record with a ULLONG value
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::AddAttribute
+	(
+	const CWStringBase *pstrAttr,
+	ULLONG ullValue
+	)
+{
+	m_strValue.AppendFormat(GPOS_WSZ_LIT("%llu"), ullValue);
+	WriteFormattedAttribute(pstrAttr);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::AddAttribute
+//
+//	@doc:
+//		Write an attribute record with an INT value
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::AddAttribute
+	(
+	const CWStringBase *pstrAttr,
+	INT iValue
+	)
+{
+	m_strValue.AppendFormat(GPOS_WSZ_LIT("%d"), iValue);
+	WriteFormattedAttribute(pstrAttr);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::AddAttribute
+//
+//	@doc:
+//		Write an attribute record with an LINT value
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::AddAttribute
+	(
+	const CWStringBase *pstrAttr,
+	LINT lValue
+	)
+{
+	m_strValue.AppendFormat(GPOS_WSZ_LIT("%lld"), lValue);
+	WriteFormattedAttribute(pstrAttr);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::AddAttribute
+//
+//	@doc:
+//		Write an attribute record with a BOOL value
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::AddAttribute
+	(
+	const CWStringBase *pstrAttr,
+	BOOL fValue
+	)
+{
+	if (fValue)
+	{
+		AddAttribute(pstrAttr, CDXLTokens::PstrToken(EdxltokenTrue));
+	}
+	else
+	{
+		AddAttribute(pstrAttr, CDXLTokens::PstrToken(EdxltokenFalse));
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::AddAttribute
+//
+//	@doc:
+//		Write an attribute record with a CDouble value
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::AddAttribute
+	(
+	const CWStringBase *pstrAttr,
+	CDouble dValue
+	)
+{
+	m_strValue.AppendFormat(GPOS_WSZ_LIT("%f"), dValue.DVal());
+	WriteFormattedAttribute(pstrAttr);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::AddAttribute
+//
+//	@doc:
+//		Write an attribute record with a byte array value, encoded as in XML
+//		documents
+//
+//---------------------------------------------------------------------------
+void
+CDXLBinarySerializer::AddAttribute
+	(
+	const CWStringBase *pstrAttr,
+	BOOL fNull,
+	const BYTE *pba,
+	ULONG ulLen
+	)
+{
+	CXMLSerializer::AddAttribute(pstrAttr, fNull, pba, ulLen);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLBinarySerializer::PbaDocument
+//
+//	@doc:
+//		Write the end of document record and return the document; the
+//		caller owns the returned array, and no more records may be written
+//
+//---------------------------------------------------------------------------
+BYTE *
+CDXLBinarySerializer::PbaDocument
+	(
+	ULONG *pulLength
+	)
+{
+	GPOS_ASSERT(NULL != pulLength);
+	GPOS_ASSERT(NULL != m_pba);
+
+	WriteByte(CDXLBinaryFormat::ErecEnd);
+
+	BYTE *pba = m_pba;
+	*pulLength = m_ulLength;
+
+	m_pba = NULL;
+	m_ulLength = 0;
+	m_ulCapacity = 0;
+
+	return pba;
+}
+
+// EOF
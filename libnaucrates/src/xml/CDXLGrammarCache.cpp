@@ -0,0 +1,294 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CDXLGrammarCache.cpp
+//
+//	@doc:
+//		Implementation of the process-wide cache of compiled XSD grammars
+//---------------------------------------------------------------------------
+
+#include "gpos/common/CAutoP.h"
+#include "gpos/common/CAutoRg.h"
+#include "gpos/sync/CAutoMutex.h"
+#include "gpos/task/CAutoTraceFlag.h"
+
+#include "naucrates/exception.h"
+#include "naucrates/dxl/parser/CParseHandlerDummy.h"
+#include "naucrates/dxl/xml/CDXLGrammarCache.h"
+#include "naucrates/dxl/xml/CDXLMemoryManager.h"
+#include "naucrates/traceflags/traceflags.h"
+
+#include <xercesc/sax2/XMLReaderFactory.hpp>
+#include <xercesc/internal/XMLGrammarPoolImpl.hpp>
+#include <xercesc/validators/common/Grammar.hpp>
+#include <xercesc/util/XMLString.hpp>
+#include <xercesc/util/XMLUni.hpp>
+
+using namespace gpdxl;
+
+// static member initialization
+IMemoryPool *
+CDXLGrammarCache::m_pmp = NULL;
+
+CDXLMemoryManager *
+CDXLGrammarCache::m_pmm = NULL;
+
+CMutexOS *
+CDXLGrammarCache::m_pmutex = NULL;
+
+CDXLGrammarCache::SEntry *
+CDXLGrammarCache::m_pentryFirst = NULL;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLGrammarCache::Init
+//
+//	@doc:
+//		Initialize the cache; grammars are compiled when first used
+//
+//---------------------------------------------------------------------------
+void
+CDXLGrammarCache::Init
+	(
+	IMemoryPool *pmp
+	)
+{
+	GPOS_ASSERT(NULL == m_pmp);
+
+	m_pmp = pmp;
+	m_pmm = GPOS_NEW(pmp) CDXLMemoryManager(pmp);
+	m_pmutex = GPOS_NEW(pmp) CMutexOS();
+	m_pentryFirst = NULL;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLGrammarCache::Terminate
+//
+//	@doc:
+//		Release the compiled grammars; must be called before Xerces is
+//		terminated
+//
+//---------------------------------------------------------------------------
+void
+CDXLGrammarCache::Terminate()
+{
+	while (NULL != m_pentryFirst)
+	{
+		SEntry *pentry = m_pentryFirst;
+		m_pentryFirst = pentry->m_pentryNext;
+
+		delete pentry->m_pgrpool;
+		XMLString::release(&pentry->m_xmlszXSDPath, m_pmm);
+		GPOS_DELETE_ARRAY(pentry->m_szXSDPath);
+		GPOS_DELETE(pentry);
+	}
+
+	GPOS_DELETE(m_pmutex);
+	GPOS_DELETE(m_pmm);
+	m_pmutex = NULL;
+	m_pmm = NULL;
+	m_pmp = NULL;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLGrammarCache::PentryCompile
+//
+//	@doc:
+//		Compile the schemas of an external schema location, a list of
+//		namespace and schema location pairs, into a new grammar pool, and
+//		lock the pool
+//
+//---------------------------------------------------------------------------
+CDXLGrammarCache::SEntry *
+CDXLGrammarCache::PentryCompile
+	(
+	const CHAR *szXSDPath
+	)
+{
+	// we need to disable OOM simulation here, otherwise xerces throws ABORT signal
+	CAutoTraceFlag atf(EtraceSimulateOOM, false);
+	CAutoTraceFlag atf2(EtraceSimulateAbort, false);
+
+	const ULONG ulLength = clib::UlStrLen(szXSDPath);
+
+	CAutoP<SEntry> a_pentry(GPOS_NEW(m_pmp) SEntry);
+	a_pentry->m_szXSDPath = NULL;
+	a_pentry->m_xmlszXSDPath = NULL;
+	a_pentry->m_pgrpool = NULL;
+	a_pentry->m_pentryNext = NULL;
+
+	CAutoRg<CHAR> a_szXSDPath;
+	a_szXSDPath = GPOS_NEW_ARRAY(m_pmp, CHAR, ulLength + 1);
+	(void) clib::PvMemCpy(a_szXSDPath.Rgt(), szXSDPath, ulLength + 1);
+
+	// a scratch copy of the location list, split into its items in place
+	CAutoRg<CHAR> a_szItems;
+	a_szItems = GPOS_NEW_ARRAY(m_pmp, CHAR, ulLength + 1);
+	(void) clib::PvMemCpy(a_szItems.Rgt(), szXSDPath, ulLength + 1);
+
+	XMLGrammarPool *pgrpool = new(m_pmm) XMLGrammarPoolImpl(m_pmm);
+	SAX2XMLReader *pxmlreader = XMLReaderFactory::createXMLReader(m_pmm, pgrpool);
+
+	pxmlreader->setFeature(XMLUni::fgSAX2CoreNameSpaces, true);
+	pxmlreader->setFeature(XMLUni::fgXercesSchema, true);
+	pxmlreader->setFeature(XMLUni::fgXercesSchemaFullChecking, true);
+
+	CParseHandlerDummy phdummy(m_pmm);
+	pxmlreader->setErrorHandler(&phdummy);
+
+	BOOL fLoaded = true;
+	GPOS_TRY
+	{
+		// every second item of the list is a schema location
+		ULONG ulItem = 0;
+		CHAR *sz = a_szItems.Rgt();
+		while ('\0' != *sz)
+		{
+			while (' ' == *sz || '\t' == *sz || '\r' == *sz || '\n' == *sz)
+			{
+				sz++;
+			}
+
+			CHAR *szItem = sz;
+			while ('\0' != *sz && ' ' != *sz && '\t' != *sz && '\r' != *sz && '\n' != *sz)
+			{
+				sz++;
+			}
+
+			if (szItem == sz)
+			{
+				break;
+			}
+
+			if ('\0' != *sz)
+			{
+				*sz++ = '\0';
+			}
+
+			if (1 == ulItem++ % 2)
+			{
+				try
+				{
+					fLoaded = fLoaded && (NULL != pxmlreader->loadGrammar(szItem, Grammar::SchemaGrammarType, true /*toCache*/));
+				}
+				catch (const XMLException&)
+				{
+					fLoaded = false;
+				}
+				catch (const SAXException&)
+				{
+					fLoaded = false;
+				}
+			}
+		}
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		delete pxmlreader;
+		delete pgrpool;
+
+		GPOS_RETHROW(ex);
+	}
+	GPOS_CATCH_END;
+
+	delete pxmlreader;
+
+	if (!fLoaded)
+	{
+		delete pgrpool;
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLXercesParseError);
+	}
+
+	// from now on the pool is immutable and can be shared by all readers
+	pgrpool->lockPool();
+
+	a_pentry->m_pgrpool = pgrpool;
+	a_pentry->m_xmlszXSDPath = XMLString::transcode(szXSDPath, m_pmm);
+	a_pentry->m_szXSDPath = a_szXSDPath.RgtReset();
+
+	return a_pentry.PtReset();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLGrammarCache::Pentry
+//
+//	@doc:
+//		Find the compiled grammars of the given external schema location,
+//		compiling them on first use
+//
+//---------------------------------------------------------------------------
+const CDXLGrammarCache::SEntry *
+CDXLGrammarCache::Pentry
+	(
+	const CHAR *szXSDPath
+	)
+{
+	GPOS_ASSERT(NULL != m_pmutex && "grammar cache is not initialized");
+
+	CAutoMutex am(*m_pmutex);
+	am.Lock();
+
+	for (SEntry *pentry = m_pentryFirst; NULL != pentry; pentry = pentry->m_pentryNext)
+	{
+		if (0 == clib::IStrCmp(pentry->m_szXSDPath, szXSDPath))
+		{
+			return pentry;
+		}
+	}
+
+	SEntry *pentry = PentryCompile(szXSDPath);
+	pentry->m_pentryNext = m_pentryFirst;
+	m_pentryFirst = pentry;
+
+	return pentry;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLGrammarCache::PxmlreaderCreate
+//
+//	@doc:
+//		Create a reader with the given memory manager; if an external schema
+//		location is given, the reader validates documents against the cached
+//		grammars of that location
+//
+//---------------------------------------------------------------------------
+SAX2XMLReader *
+CDXLGrammarCache::PxmlreaderCreate
+	(
+	CDXLMemoryManager *pmm,
+	const CHAR *szXSDPath
+	)
+{
+	GPOS_ASSERT(NULL != pmm);
+
+	if (NULL == szXSDPath)
+	{
+		return XMLReaderFactory::createXMLReader(pmm);
+	}
+
+	const SEntry *pentry = Pentry(szXSDPath);
+	SAX2XMLReader *pxmlreader = XMLReaderFactory::createXMLReader(pmm, pentry->m_pgrpool);
+
+	// setup XSD validation
+	pxmlreader->setFeature(XMLUni::fgSAX2CoreValidation, true);
+	pxmlreader->setFeature(XMLUni::fgXercesDynamic, false);
+	pxmlreader->setFeature(XMLUni::fgSAX2CoreNameSpaces, true);
+	pxmlreader->setFeature(XMLUni::fgXercesSchema, true);
+
+	pxmlreader->setFeature(XMLUni::fgXercesSchemaFullChecking, true);
+	pxmlreader->setFeature(XMLUni::fgSAX2CoreNameSpacePrefixes, true);
+
+	// grammars were compiled into the locked pool and are looked up there
+	pxmlreader->setFeature(XMLUni::fgXercesUseCachedGrammarInParse, true);
+	pxmlreader->setProperty(XMLUni::fgXercesSchemaExternalSchemaLocation, (void*) pentry->m_xmlszXSDPath);
+
+	return pxmlreader;
+}
+
+// EOF
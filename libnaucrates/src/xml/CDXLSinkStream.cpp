@@ -0,0 +1,231 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CDXLSinkStream.cpp
+//
+//	@doc:
+//		Implementation of the output stream writing UTF-8 text to a sink
+//---------------------------------------------------------------------------
+
+#include "naucrates/dxl/xml/CDXLSinkStream.h"
+
+using namespace gpdxl;
+
+// maximum length of the UTF-8 encoding of a character
+#define GPDXL_UTF8_MAX_BYTES 4
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLSinkStream::CDXLSinkStream
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CDXLSinkStream::CDXLSinkStream
+	(
+	IMemoryPool *pmp,
+	PfDXLSink *pfsink,
+	void *pvSinkArg
+	)
+	:
+	COstream(),
+	m_pmp(pmp),
+	m_pfsink(pfsink),
+	m_pvSinkArg(pvSinkArg),
+	m_pb(NULL),
+	m_ulLength(0),
+	m_ullBytesWritten(0)
+{
+	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(NULL != pfsink);
+
+	m_pb = GPOS_NEW_ARRAY(m_pmp, BYTE, GPDXL_SINK_STREAM_BUFFER_SIZE);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLSinkStream::~CDXLSinkStream
+//
+//	@doc:
+//		Dtor; bytes that were not flushed are discarded
+//
+//---------------------------------------------------------------------------
+CDXLSinkStream::~CDXLSinkStream()
+{
+	GPOS_DELETE_ARRAY(m_pb);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLSinkStream::Flush
+//
+//	@doc:
+//		Hand the buffered bytes to the sink
+//
+//---------------------------------------------------------------------------
+void
+CDXLSinkStream::Flush()
+{
+	if (0 == m_ulLength)
+	{
+		return;
+	}
+
+	ULONG ulLength = m_ulLength;
+	m_ulLength = 0;
+	m_ullBytesWritten += ulLength;
+
+	m_pfsink(m_pvSinkArg, m_pb, ulLength);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLSinkStream::Append
+//
+//	@doc:
+//		Append the UTF-8 encoding of a character to the buffer, flushing
+//		the buffer first if the encoding may not fit; characters that are
+//		not valid code points are replaced by U+FFFD
+//
+//---------------------------------------------------------------------------
+void
+CDXLSinkStream::Append
+	(
+	WCHAR wc
+	)
+{
+	if (GPDXL_SINK_STREAM_BUFFER_SIZE - m_ulLength < GPDXL_UTF8_MAX_BYTES)
+	{
+		Flush();
+	}
+
+	ULONG ulCodePoint = (ULONG) wc;
+	if (0x10FFFF < ulCodePoint || (0xD800 <= ulCodePoint && 0xDFFF >= ulCodePoint))
+	{
+		ulCodePoint = 0xFFFD;
+	}
+
+	BYTE *pb = m_pb + m_ulLength;
+	if (0x80 > ulCodePoint)
+	{
+		pb[0] = (BYTE) ulCodePoint;
+		m_ulLength += 1;
+	}
+	else if (0x800 > ulCodePoint)
+	{
+		pb[0] = (BYTE) (0xC0 | (ulCodePoint >> 6));
+		pb[1] = (BYTE) (0x80 | (ulCodePoint & 0x3F));
+		m_ulLength += 2;
+	}
+	else if (0x10000 > ulCodePoint)
+	{
+		pb[0] = (BYTE) (0xE0 | (ulCodePoint >> 12));
+		pb[1] = (BYTE) (0x80 | ((ulCodePoint >> 6) & 0x3F));
+		pb[2] = (BYTE) (0x80 | (ulCodePoint & 0x3F));
+		m_ulLength += 3;
+	}
+	else
+	{
+		pb[0] = (BYTE) (0xF0 | (ulCodePoint >> 18));
+		pb[1] = (BYTE) (0x80 | ((ulCodePoint >> 12) & 0x3F));
+		pb[2] = (BYTE) (0x80 | ((ulCodePoint >> 6) & 0x3F));
+		pb[3] = (BYTE) (0x80 | (ulCodePoint & 0x3F));
+		m_ulLength += 4;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLSinkStream::operator<<
+//
+//	@doc:
+//		WCHAR array write thru
+//
+//---------------------------------------------------------------------------
+IOstream&
+CDXLSinkStream::operator <<
+	(
+	const WCHAR *wsz
+	)
+{
+	GPOS_ASSERT(NULL != wsz);
+
+	for (; L'\0' != *wsz; wsz++)
+	{
+		Append(*wsz);
+	}
+
+	return *this;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLSinkStream::operator<<
+//
+//	@doc:
+//		CHAR array write thru; character strings are written unchanged
+//
+//---------------------------------------------------------------------------
+IOstream&
+CDXLSinkStream::operator <<
+	(
+	const CHAR *sz
+	)
+{
+	GPOS_ASSERT(NULL != sz);
+
+	for (; '\0' != *sz; sz++)
+	{
+		(*this) << *sz;
+	}
+
+	return *this;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLSinkStream::operator<<
+//
+//	@doc:
+//		WCHAR write thru
+//
+//---------------------------------------------------------------------------
+IOstream&
+CDXLSinkStream::operator <<
+	(
+	const WCHAR wc
+	)
+{
+	Append(wc);
+
+	return *this;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLSinkStream::operator<<
+//
+//	@doc:
+//		CHAR write thru
+//
+//---------------------------------------------------------------------------
+IOstream&
+CDXLSinkStream::operator <<
+	(
+	const CHAR c
+	)
+{
+	if (GPDXL_SINK_STREAM_BUFFER_SIZE == m_ulLength)
+	{
+		Flush();
+	}
+
+	m_pb[m_ulLength++] = (BYTE) c;
+
+	return *this;
+}
+
+// EOF
@@ -31,6 +31,59 @@ CXMLSerializer::~CXMLSerializer()
 	GPOS_DELETE(m_strstackElems);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CXMLSerializer::PushElement
+//
+//	@doc:
+//		Push an element on the stack of open elements and check for aborts
+//		at regular intervals
+//
+//---------------------------------------------------------------------------
+void
+CXMLSerializer::PushElement
+	(
+	const CWStringBase *pstrElem
+	)
+{
+	m_ulIterLastCFA++;
+	
+	if (GPDXL_SERIALIZE_CFA_FREQUENCY < m_ulIterLastCFA)
+	{
+		GPOS_CHECK_ABORT;
+		m_ulIterLastCFA = 0;
+	}
+	
+	// put element on the stack
+	m_strstackElems->Push(pstrElem);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXMLSerializer::PopElement
+//
+//	@doc:
+//		Pop the given element from the stack of open elements
+//
+//---------------------------------------------------------------------------
+void
+CXMLSerializer::PopElement
+	(
+	const CWStringBase *
+#ifdef GPOS_DEBUG
+	pstrElem
+#endif // GPOS_DEBUG
+	)
+{
+	// assert element is on top of the stack
+#ifdef GPOS_DEBUG
+	const CWStringBase *strOpenElem = 
+#endif
+	m_strstackElems->Pop();
+	
+	GPOS_ASSERT(strOpenElem->FEquals(pstrElem));
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CXMLSerializer::StartDocument
@@ -43,10 +96,10 @@ void
 CXMLSerializer::StartDocument()
 {
 	GPOS_ASSERT(m_strstackElems->FEmpty());
-	m_os << CDXLTokens::PstrToken(EdxltokenXMLDocHeader)->Wsz();
+	*m_pos << CDXLTokens::PstrToken(EdxltokenXMLDocHeader)->Wsz();
 	if (m_fIndent)
 	{
-		m_os << std::endl;
+		*m_pos << std::endl;
 	}
 }
 
@@ -67,37 +120,28 @@ CXMLSerializer::OpenElement
 {
 	GPOS_ASSERT(NULL != pstrElem);
 	
-	m_ulIterLastCFA++;
-	
-	if (GPDXL_SERIALIZE_CFA_FREQUENCY < m_ulIterLastCFA)
-	{
-		GPOS_CHECK_ABORT;
-		m_ulIterLastCFA = 0;
-	}
-	
-	// put element on the stack
-	m_strstackElems->Push(pstrElem);
+	PushElement(pstrElem);
 	
 	// write the closing bracket for the previous element if necessary and add indentation
 	if (m_fOpenTag)
 	{
-		m_os << CDXLTokens::PstrToken(EdxltokenBracketCloseTag)->Wsz(); // >
+		*m_pos << CDXLTokens::PstrToken(EdxltokenBracketCloseTag)->Wsz(); // >
 		if (m_fIndent)
 		{
-			m_os << std::endl;
+			*m_pos << std::endl;
 		}
 	}
 	
 	Indent();
 	
 	// write element to stream
-	m_os << CDXLTokens::PstrToken(EdxltokenBracketOpenTag)->Wsz();			// <
+	*m_pos << CDXLTokens::PstrToken(EdxltokenBracketOpenTag)->Wsz();			// <
 	
 	if(NULL != pstrNamespace)
 	{
-		m_os << pstrNamespace->Wsz() << CDXLTokens::PstrToken(EdxltokenColon)->Wsz();	// "namespace:"
+		*m_pos << pstrNamespace->Wsz() << CDXLTokens::PstrToken(EdxltokenColon)->Wsz();	// "namespace:"
 	}
-	m_os << pstrElem->Wsz();
+	*m_pos << pstrElem->Wsz();
 	
 	m_fOpenTag = true;
 	m_ulLevel++;
@@ -123,21 +167,15 @@ CXMLSerializer::CloseElement
 	
 	m_ulLevel--;
 	
-	// assert element is on top of the stack
-#ifdef GPOS_DEBUG
-	const CWStringBase *strOpenElem = 
-#endif
-	m_strstackElems->Pop();
-	
-	GPOS_ASSERT(strOpenElem->FEquals(pstrElem));
+	PopElement(pstrElem);
 	
 	if (m_fOpenTag)
 	{
 		// singleton element with no children - close the element with "/>"
-		m_os << CDXLTokens::PstrToken(EdxltokenBracketCloseSingletonTag)->Wsz();	// />
+		*m_pos << CDXLTokens::PstrToken(EdxltokenBracketCloseSingletonTag)->Wsz();	// />
 		if (m_fIndent)
 		{
-			m_os << std::endl;
+			*m_pos << std::endl;
 		}
 		m_fOpenTag = false;
 	}
@@ -147,15 +185,15 @@ CXMLSerializer::CloseElement
 		Indent();
 		
 		// write closing tag for element to stream
-		m_os << CDXLTokens::PstrToken(EdxltokenBracketOpenEndTag)->Wsz();		// </
+		*m_pos << CDXLTokens::PstrToken(EdxltokenBracketOpenEndTag)->Wsz();		// </
 		if(NULL != pstrNamespace)
 		{
-			m_os << pstrNamespace->Wsz() << CDXLTokens::PstrToken(EdxltokenColon)->Wsz();	// "namespace:"
+			*m_pos << pstrNamespace->Wsz() << CDXLTokens::PstrToken(EdxltokenColon)->Wsz();	// "namespace:"
 		}
-		m_os << pstrElem->Wsz() << CDXLTokens::PstrToken(EdxltokenBracketCloseTag)->Wsz(); // >
+		*m_pos << pstrElem->Wsz() << CDXLTokens::PstrToken(EdxltokenBracketCloseTag)->Wsz(); // >
 		if (m_fIndent)
 		{
-			m_os << std::endl;
+			*m_pos << std::endl;
 		}
 	}
 
@@ -182,12 +220,12 @@ CXMLSerializer::AddAttribute
 	GPOS_ASSERT(NULL != pstrValue);
 
 	GPOS_ASSERT(m_fOpenTag);
-	m_os << CDXLTokens::PstrToken(EdxltokenSpace)->Wsz()
+	*m_pos << CDXLTokens::PstrToken(EdxltokenSpace)->Wsz()
 		 << pstrAttr->Wsz()
 		 << CDXLTokens::PstrToken(EdxltokenEq)->Wsz()		// = 
 		 <<  CDXLTokens::PstrToken(EdxltokenQuote)->Wsz();	// "
-	WriteEscaped(m_os, pstrValue);
-	m_os << CDXLTokens::PstrToken(EdxltokenQuote)->Wsz();	// "
+	WriteEscaped(*m_pos, pstrValue);
+	*m_pos << CDXLTokens::PstrToken(EdxltokenQuote)->Wsz();	// "
 }
 
 //---------------------------------------------------------------------------
@@ -209,7 +247,7 @@ CXMLSerializer::AddAttribute
 	GPOS_ASSERT(NULL != szValue);
 
 	GPOS_ASSERT(m_fOpenTag);
-	m_os << CDXLTokens::PstrToken(EdxltokenSpace)->Wsz()
+	*m_pos << CDXLTokens::PstrToken(EdxltokenSpace)->Wsz()
 		 << pstrAttr->Wsz()
 		 << CDXLTokens::PstrToken(EdxltokenEq)->Wsz()		// = 
 		 << CDXLTokens::PstrToken(EdxltokenQuote)->Wsz()	// "
@@ -236,7 +274,7 @@ CXMLSerializer::AddAttribute
 	GPOS_ASSERT(NULL != pstrAttr);
 
 	GPOS_ASSERT(m_fOpenTag);
-	m_os << CDXLTokens::PstrToken(EdxltokenSpace)->Wsz()
+	*m_pos << CDXLTokens::PstrToken(EdxltokenSpace)->Wsz()
 		 << pstrAttr->Wsz()
 		 << CDXLTokens::PstrToken(EdxltokenEq)->Wsz()		// = 
 		 << CDXLTokens::PstrToken(EdxltokenQuote)->Wsz()	// \"
@@ -263,7 +301,7 @@ CXMLSerializer::AddAttribute
 	GPOS_ASSERT(NULL != pstrAttr);
 
 	GPOS_ASSERT(m_fOpenTag);
-	m_os << CDXLTokens::PstrToken(EdxltokenSpace)->Wsz()
+	*m_pos << CDXLTokens::PstrToken(EdxltokenSpace)->Wsz()
 		 << pstrAttr->Wsz()
 		 << CDXLTokens::PstrToken(EdxltokenEq)->Wsz()		// =
 		 << CDXLTokens::PstrToken(EdxltokenQuote)->Wsz()	// \"
@@ -290,7 +328,7 @@ CXMLSerializer::AddAttribute
 	GPOS_ASSERT(NULL != pstrAttr);
 
 	GPOS_ASSERT(m_fOpenTag);
-	m_os << CDXLTokens::PstrToken(EdxltokenSpace)->Wsz()
+	*m_pos << CDXLTokens::PstrToken(EdxltokenSpace)->Wsz()
 		 << pstrAttr->Wsz()
 		 << CDXLTokens::PstrToken(EdxltokenEq)->Wsz()		// = 
 		 << CDXLTokens::PstrToken(EdxltokenQuote)->Wsz()	// \"
@@ -317,7 +355,7 @@ CXMLSerializer::AddAttribute
 	GPOS_ASSERT(NULL != pstrAttr);
 
 	GPOS_ASSERT(m_fOpenTag);
-	m_os << CDXLTokens::PstrToken(EdxltokenSpace)->Wsz()
+	*m_pos << CDXLTokens::PstrToken(EdxltokenSpace)->Wsz()
 		 << pstrAttr->Wsz()
 		 << CDXLTokens::PstrToken(EdxltokenEq)->Wsz()		// =
 		 << CDXLTokens::PstrToken(EdxltokenQuote)->Wsz()	// \"
@@ -344,7 +382,7 @@ CXMLSerializer::AddAttribute
 	GPOS_ASSERT(NULL != pstrAttr);
 
 	GPOS_ASSERT(m_fOpenTag);
-	m_os << CDXLTokens::PstrToken(EdxltokenSpace)->Wsz()
+	*m_pos << CDXLTokens::PstrToken(EdxltokenSpace)->Wsz()
 		 << pstrAttr->Wsz()
 		 << CDXLTokens::PstrToken(EdxltokenEq)->Wsz()		// = 
 		 << CDXLTokens::PstrToken(EdxltokenQuote)->Wsz()	// \"
@@ -401,7 +439,7 @@ CXMLSerializer::Indent()
 	
 	for (ULONG ul = 0; ul < m_ulLevel; ul++)
 	{
-		m_os << CDXLTokens::PstrToken(EdxltokenIndent)->Wsz();
+		*m_pos << CDXLTokens::PstrToken(EdxltokenIndent)->Wsz();
 	}
 }
 
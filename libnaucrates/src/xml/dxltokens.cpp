@@ -25,12 +25,27 @@ CDXLTokens::m_pstrmap = NULL;
 CDXLTokens::SXMLStrMapElem *
 CDXLTokens::m_pxmlszmap = NULL;
 
+CDXLTokens::HMStrToken *
+CDXLTokens::m_phmstrtoken = NULL;
+
+ULONG
+CDXLTokens::m_ulTokensHash = 0;
+
 IMemoryPool *
 CDXLTokens::m_pmp =  NULL;
 
 CDXLMemoryManager *
 CDXLTokens::m_pmm = NULL;
 
+CDXLTokens::SHashBucket *
+CDXLTokens::m_phashbucket = NULL;
+
+ULONG
+CDXLTokens::m_ulHashBuckets = 0;
+
+Edxltoken *
+CDXLTokens::m_pedxltokenSlots = NULL;
+
 
 //---------------------------------------------------------------------------
 //	@function:
@@ -73,6 +88,7 @@ CDXLTokens::Init
 			{EdxltokenDampingFactorFilter, GPOS_WSZ_LIT("DampingFactorFilter")},
 			{EdxltokenDampingFactorJoin, GPOS_WSZ_LIT("DampingFactorJoin")},
 			{EdxltokenDampingFactorGroupBy, GPOS_WSZ_LIT("DampingFactorGroupBy")},
+			{EdxltokenMaxHistogramBuckets, GPOS_WSZ_LIT("MaxHistogramBuckets")},
 			{EdxltokenCTEConfig, GPOS_WSZ_LIT("CTEConfig")},
 			{EdxltokenCTEInliningCutoff, GPOS_WSZ_LIT("CTEInliningCutoff")},
 			{EdxltokenCostModelConfig, GPOS_WSZ_LIT("CostModelConfig")},
@@ -283,6 +299,7 @@ CDXLTokens::Init
 			{EdxltokenJoinLeftAntiSemiJoinNotIn, GPOS_WSZ_LIT("LeftAntiSemiJoinNotIn")},
 			
 			{EdxltokenMergeJoinUniqueOuter, GPOS_WSZ_LIT("UniqueOuter")},
+			{EdxltokenHashJoinRuntimeFilter, GPOS_WSZ_LIT("RuntimeFilter")},
 
 			{EdxltokenWindowLeadingBoundary, GPOS_WSZ_LIT("LeadingBoundary")},
 			{EdxltokenWindowTrailingBoundary, GPOS_WSZ_LIT("TrailingBoundary")},
@@ -474,6 +491,8 @@ CDXLTokens::Init
 			{EdxltokenRelationStats, GPOS_WSZ_LIT("RelationStatistics")},
 			{EdxltokenColumnStats, GPOS_WSZ_LIT("ColumnStatistics")},
 			{EdxltokenColumnStatsBucket, GPOS_WSZ_LIT("StatsBucket")},
+			{EdxltokenExtendedStats, GPOS_WSZ_LIT("ExtendedStatistics")},
+			{EdxltokenHLLSketch, GPOS_WSZ_LIT("HLLSketch")},
 			{EdxltokenEmptyRelation, GPOS_WSZ_LIT("EmptyRelation")},
 			
 			{EdxltokenIsByValue, GPOS_WSZ_LIT("IsByValue")},
@@ -699,6 +718,9 @@ CDXLTokens::Init
 			{EdxltokenStatsBucketUpperBound, GPOS_WSZ_LIT("UpperBound")},
 			{EdxltokenStatsFrequency, GPOS_WSZ_LIT("Frequency")},
 			{EdxltokenStatsDistinct, GPOS_WSZ_LIT("DistinctValues")},
+			{EdxltokenStatsDependencyDegree, GPOS_WSZ_LIT("DependencyDegree")},
+			{EdxltokenHLLPrecision, GPOS_WSZ_LIT("Precision")},
+			{EdxltokenHLLRegisters, GPOS_WSZ_LIT("Registers")},
 			{EdxltokenStatsBoundClosed, GPOS_WSZ_LIT("Closed")},
 
 			{EdxltokenSearchStrategy, GPOS_WSZ_LIT("SearchStrategy")},
@@ -728,6 +750,152 @@ CDXLTokens::Init
 		m_pstrmap[mapelem.m_edxlt].m_pstr = GPOS_NEW(m_pmp) CWStringConst(m_pmp, mapelem.m_wsz);
 		m_pxmlszmap[mapelem.m_edxlt].m_xmlsz = XmlstrFromWsz(mapelem.m_wsz);
 	}
+
+	m_phmstrtoken = GPOS_NEW(m_pmp) HMStrToken(m_pmp);
+	m_ulTokensHash = 0;
+	for (ULONG ul = 0; ul < EdxltokenSentinel; ul++)
+	{
+		CWStringConst *pstr = m_pstrmap[ul].m_pstr;
+		if (NULL == pstr)
+		{
+			continue;
+		}
+
+#ifdef GPOS_DEBUG
+		BOOL fInserted =
+#endif // GPOS_DEBUG
+		m_phmstrtoken->FInsert(pstr, GPOS_NEW(m_pmp) ULONG(ul));
+		GPOS_ASSERT(fInserted);
+
+		// hash characters one at a time so that the hash does not depend on
+		// the width of wide characters
+		m_ulTokensHash = gpos::UlCombineHashes(m_ulTokensHash, ul);
+		const WCHAR *wsz = pstr->Wsz();
+		for (ULONG ulChar = 0; ulChar < pstr->UlLength(); ulChar++)
+		{
+			m_ulTokensHash = gpos::UlCombineHashes(m_ulTokensHash, (ULONG) wsz[ulChar]);
+		}
+	}
+
+	InitHash();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLTokens::InitHash
+//
+//	@doc:
+//		Build a perfect hash of the token strings: the first-level hash
+//		distributes the strings over as many buckets as there are tokens,
+//		and the k strings of a bucket are placed in k*k slots by a hash
+//		function whose seed is searched for until no two strings of the
+//		bucket share a slot. Resolving a string then costs two hash
+//		computations and a single string comparison.
+//
+//---------------------------------------------------------------------------
+void
+CDXLTokens::InitHash()
+{
+	m_ulHashBuckets = 0;
+	for (ULONG ul = 0; ul < EdxltokenSentinel; ul++)
+	{
+		if (NULL != m_pxmlszmap[ul].m_xmlsz)
+		{
+			m_ulHashBuckets++;
+		}
+	}
+	GPOS_ASSERT(0 < m_ulHashBuckets);
+
+	m_phashbucket = GPOS_NEW_ARRAY(m_pmp, SHashBucket, m_ulHashBuckets);
+
+	// chains of the distinct token strings of each bucket
+	ULONG *pulHead = GPOS_NEW_ARRAY(m_pmp, ULONG, m_ulHashBuckets);
+	ULONG *pulNext = GPOS_NEW_ARRAY(m_pmp, ULONG, EdxltokenSentinel);
+	for (ULONG ul = 0; ul < m_ulHashBuckets; ul++)
+	{
+		m_phashbucket[ul].m_ulOffset = 0;
+		m_phashbucket[ul].m_ulSlots = 0;
+		m_phashbucket[ul].m_ulSeed = 0;
+		pulHead[ul] = EdxltokenSentinel;
+	}
+
+	for (ULONG ul = 0; ul < EdxltokenSentinel; ul++)
+	{
+		const XMLCh *xmlsz = m_pxmlszmap[ul].m_xmlsz;
+		if (NULL == xmlsz)
+		{
+			continue;
+		}
+
+		ULONG ulBucket = UlHashXmlstr(xmlsz, 0 /*ulSeed*/) % m_ulHashBuckets;
+
+		// tokens with the string of an earlier token resolve to that token
+		ULONG ulFirst = pulHead[ulBucket];
+		while (EdxltokenSentinel != ulFirst && !XMLString::equals(xmlsz, m_pxmlszmap[ulFirst].m_xmlsz))
+		{
+			ulFirst = pulNext[ulFirst];
+		}
+
+		if (EdxltokenSentinel != ulFirst)
+		{
+			m_pxmlszmap[ul].m_edxlt = (Edxltoken) ulFirst;
+			continue;
+		}
+
+		m_pxmlszmap[ul].m_edxlt = (Edxltoken) ul;
+		pulNext[ul] = pulHead[ulBucket];
+		pulHead[ulBucket] = ul;
+		m_phashbucket[ulBucket].m_ulSlots++;
+	}
+
+	// a bucket with k strings gets k*k slots
+	ULONG ulSlots = 0;
+	for (ULONG ul = 0; ul < m_ulHashBuckets; ul++)
+	{
+		SHashBucket *phashbucket = &m_phashbucket[ul];
+		phashbucket->m_ulOffset = ulSlots;
+		phashbucket->m_ulSlots = phashbucket->m_ulSlots * phashbucket->m_ulSlots;
+		ulSlots += phashbucket->m_ulSlots;
+	}
+
+	m_pedxltokenSlots = GPOS_NEW_ARRAY(m_pmp, Edxltoken, ulSlots);
+	for (ULONG ul = 0; ul < ulSlots; ul++)
+	{
+		m_pedxltokenSlots[ul] = EdxltokenSentinel;
+	}
+
+	for (ULONG ulBucket = 0; ulBucket < m_ulHashBuckets; ulBucket++)
+	{
+		SHashBucket *phashbucket = &m_phashbucket[ulBucket];
+		Edxltoken *pedxltoken = m_pedxltokenSlots + phashbucket->m_ulOffset;
+
+		BOOL fPlaced = (0 == phashbucket->m_ulSlots);
+		while (!fPlaced)
+		{
+			phashbucket->m_ulSeed++;
+			GPOS_ASSERT(0 != phashbucket->m_ulSeed);
+
+			fPlaced = true;
+			for (ULONG ul = pulHead[ulBucket]; fPlaced && EdxltokenSentinel != ul; ul = pulNext[ul])
+			{
+				ULONG ulSlot = UlHashXmlstr(m_pxmlszmap[ul].m_xmlsz, phashbucket->m_ulSeed) % phashbucket->m_ulSlots;
+				fPlaced = (EdxltokenSentinel == pedxltoken[ulSlot]);
+				pedxltoken[ulSlot] = (Edxltoken) ul;
+			}
+
+			if (!fPlaced)
+			{
+				// strings collide for this seed, clear the bucket and try the next
+				for (ULONG ul = 0; ul < phashbucket->m_ulSlots; ul++)
+				{
+					pedxltoken[ul] = EdxltokenSentinel;
+				}
+			}
+		}
+	}
+
+	GPOS_DELETE_ARRAY(pulHead);
+	GPOS_DELETE_ARRAY(pulNext);
 }
 
 //---------------------------------------------------------------------------
@@ -741,6 +909,9 @@ CDXLTokens::Init
 void
 CDXLTokens::Terminate()
 {
+	m_phmstrtoken->Release();
+	GPOS_DELETE_ARRAY(m_phashbucket);
+	GPOS_DELETE_ARRAY(m_pedxltokenSlots);
 	GPOS_DELETE_ARRAY(m_pstrmap);
 	GPOS_DELETE_ARRAY(m_pxmlszmap);
 	GPOS_DELETE(m_pmm);
@@ -784,13 +955,111 @@ CDXLTokens::XmlstrToken
 	)
 {
 	GPOS_ASSERT(NULL != m_pxmlszmap && "Token map not initialized yet");
-	
-	const XMLCh *xmlsz = m_pxmlszmap[edxltoken].m_xmlsz;
+	GPOS_ASSERT(EdxltokenSentinel != m_pxmlszmap[edxltoken].m_edxlt);
+
+	// tokens sharing a string return the string of the first of them, so
+	// that equal token strings can be compared by address
+	const XMLCh *xmlsz = m_pxmlszmap[m_pxmlszmap[edxltoken].m_edxlt].m_xmlsz;
 	GPOS_ASSERT(NULL != xmlsz);
 	
 	return xmlsz;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLTokens::EdxltokenFromXmlstr
+//
+//	@doc:
+//		Returns the token id of the given string, or EdxltokenSentinel if it
+//		is not a token string. Tokens sharing a string resolve to the first
+//		of them, the one whose string XmlstrToken returns for all of them.
+//
+//---------------------------------------------------------------------------
+Edxltoken
+CDXLTokens::EdxltokenFromXmlstr
+	(
+	const XMLCh *xmlsz
+	)
+{
+	GPOS_ASSERT(NULL != m_phashbucket && "Token map not initialized yet");
+	GPOS_ASSERT(NULL != xmlsz);
+
+	const SHashBucket *phashbucket = &m_phashbucket[UlHashXmlstr(xmlsz, 0 /*ulSeed*/) % m_ulHashBuckets];
+	if (0 == phashbucket->m_ulSlots)
+	{
+		return EdxltokenSentinel;
+	}
+
+	ULONG ulSlot = phashbucket->m_ulOffset + UlHashXmlstr(xmlsz, phashbucket->m_ulSeed) % phashbucket->m_ulSlots;
+	Edxltoken edxltoken = m_pedxltokenSlots[ulSlot];
+	if (EdxltokenSentinel == edxltoken || !XMLString::equals(xmlsz, m_pxmlszmap[edxltoken].m_xmlsz))
+	{
+		return EdxltokenSentinel;
+	}
+
+	return edxltoken;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLTokens::UlHashXmlstr
+//
+//	@doc:
+//		FNV-1a hash of a Xerces string, starting from the given seed. The low
+//		bits of FNV-1a only depend on the low bits of the characters, so the
+//		hash is finalized by mixing the high bits into the low bits; strings
+//		would otherwise collide modulo a power of two for every seed.
+//
+//---------------------------------------------------------------------------
+ULONG
+CDXLTokens::UlHashXmlstr
+	(
+	const XMLCh *xmlsz,
+	ULONG ulSeed
+	)
+{
+	ULONG ulHash = 2166136261U ^ ulSeed;
+	for (; 0 != *xmlsz; xmlsz++)
+	{
+		ulHash = (ulHash ^ (ULONG) *xmlsz) * 16777619U;
+	}
+
+	ulHash ^= ulHash >> 16;
+	ulHash *= 0x85ebca6bU;
+	ulHash ^= ulHash >> 13;
+	ulHash *= 0xc2b2ae35U;
+	ulHash ^= ulHash >> 16;
+
+	return ulHash;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLTokens::EdxltokenLookup
+//
+//	@doc:
+//		Returns the token id of a string retrieved with PstrToken, or
+//		EdxltokenSentinel for any other string, even one with the same
+//		characters as a token
+//
+//---------------------------------------------------------------------------
+Edxltoken
+CDXLTokens::EdxltokenLookup
+	(
+	const CWStringBase *pstr
+	)
+{
+	GPOS_ASSERT(NULL != m_phmstrtoken && "Token map not initialized yet");
+
+	const ULONG *pul = m_phmstrtoken->PtLookup(pstr);
+	if (NULL == pul)
+	{
+		return EdxltokenSentinel;
+	}
+
+	return (Edxltoken) *pul;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLTokens::XmlstrFromWsz
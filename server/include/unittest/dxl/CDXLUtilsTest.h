@@ -37,6 +37,9 @@ namespace gpdxl
 			static GPOS_RESULT EresUnittest_SerializeQuery();
 			static GPOS_RESULT EresUnittest_SerializePlan();
 			static GPOS_RESULT EresUnittest_Encoding();
+			static GPOS_RESULT EresUnittest_SerializePlanToSink();
+			static GPOS_RESULT EresUnittest_SinkStreamEncoding();
+			static GPOS_RESULT EresUnittest_NameFromXMLCh();
 
 	}; // class CDXLUtilsTest
 }
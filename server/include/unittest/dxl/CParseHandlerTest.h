@@ -89,6 +89,18 @@ namespace gpdxl
 			static
 			GPOS_RESULT EresParseAndSerializeScalarExpr(IMemoryPool *, const CHAR *, BOOL fValidate);
 
+			// test round-tripping plans through the binary DXL format
+			static
+			GPOS_RESULT EresParseAndSerializeBinaryPlan(IMemoryPool *, const CHAR *, BOOL fValidate);
+
+			// test round-tripping queries through the binary DXL format
+			static
+			GPOS_RESULT EresParseAndSerializeBinaryQuery(IMemoryPool *, const CHAR *, BOOL fValidate);
+
+			// test round-tripping metadata through the binary DXL format
+			static
+			GPOS_RESULT EresParseAndSerializeBinaryMetadata(IMemoryPool *, const CHAR *, BOOL fValidate);
+
 		public:
 
 			// unittests
@@ -138,6 +150,30 @@ namespace gpdxl
 			static 
 			GPOS_RESULT EresUnittest_RunAllNegativeTests();
 
+			// run all plan, query and metadata tests through the binary DXL format
+			static
+			GPOS_RESULT EresUnittest_BinaryRoundTrip();
+
+			// test that binary DXL documents with a wrong header are rejected
+			static
+			GPOS_RESULT EresUnittest_ErrBinaryHeader();
+
+			// test resolving element and attribute names to DXL tokens
+			static
+			GPOS_RESULT EresUnittest_TokenLookup();
+
+			// measure the parsing throughput of the plan, query and metadata files
+			static
+			GPOS_RESULT EresUnittest_ParseThroughput();
+
+			// test parsing the metadata of documents on worker tasks
+			static
+			GPOS_RESULT EresUnittest_ParallelParse();
+
+			// test validating documents on background tasks
+			static
+			GPOS_RESULT EresUnittest_ValidateInBackground();
+
 	}; // class CParseHandlerTest
 }
 
@@ -102,6 +102,14 @@ namespace gpnaucrates
 			static
 			DrgPstatspredjoin *PdrgpstatspredjoinNullableCols(IMemoryPool *pmp);
 
+			// helper method to generate a synthetic int4 histogram with gaps, singletons and mixed bound closedness
+			static
+			CHistogram *PhistSynthetic(IMemoryPool *pmp, ULONG ulBuckets, INT iStart, INT iWidth);
+
+			// helper method to check that equality join of given histograms gives the same result with compact buckets
+			static
+			GPOS_RESULT EresJoinCompact(IMemoryPool *pmp, const CHistogram *phist1, const CHistogram *phist2);
+
 		public:
 
 			// unittests
@@ -116,6 +124,14 @@ namespace gpnaucrates
 			static
 			GPOS_RESULT EresUnittest_Join();
 
+			// equality join using compact buckets
+			static
+			GPOS_RESULT EresUnittest_JoinCompact();
+
+			// microbenchmark of equality join with and without compact buckets
+			static
+			GPOS_RESULT EresUnittest_JoinCompactPerf();
+
 	}; // class CJoinCardinalityTest
 }
 
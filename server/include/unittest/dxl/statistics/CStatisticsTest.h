@@ -120,6 +120,25 @@ namespace gpnaucrates
 				FnPstatspredDisj *m_pf;
 			}; // SStatsFilterSTestCase
 
+			// arguments of a worker task deriving histograms
+			struct SDeriveHistogramsTaskArg
+			{
+				// memory pool
+				IMemoryPool *m_pmp;
+
+				// statistics configuration
+				CStatisticsConfig *m_pstatsconf;
+
+				// number of histograms
+				ULONG m_ulHists;
+
+				// input histograms
+				CHistogram **m_rgphistInput;
+
+				// derived histograms
+				CHistogram **m_rgphistOutput;
+			}; // SDeriveHistogramsTaskArg
+
 			// test case for union all evaluation
 			struct SStatsUnionAllSTestCase
 			{
@@ -230,6 +249,42 @@ namespace gpnaucrates
 				ULONG ulVals
 				);
 
+			// generate statistics on two columns, optionally with multi-column statistics
+			static
+			CStatistics *PstatsMultiColumn
+				(
+				IMemoryPool *pmp,
+				ULONG ulColId1,
+				ULONG ulColId2,
+				BOOL fMultiColumn,
+				CDouble dDependency
+				);
+
+			// generate a text datum of the given string
+			static
+			IDatum *PdatumText(IMemoryPool *pmp, const CHAR *sz);
+
+			// generate a text bucket with the given bounds
+			static
+			CBucket *PbucketText
+				(
+				IMemoryPool *pmp,
+				const CHAR *szLower,
+				const CHAR *szUpper,
+				CDouble dFrequency,
+				CDouble dDistinct
+				);
+
+			// generate a sketch of the integers in the given range
+			static
+			CHLLSketch *PhllSequence
+				(
+				IMemoryPool *pmp,
+				ULONG ulPrecision,
+				ULONG ulFirst,
+				ULONG ulLast
+				);
+
 			// example filter
 			static
 			DrgPstatspred *Pdrgpstatspred1(IMemoryPool *pmp);
@@ -380,10 +435,49 @@ namespace gpnaucrates
 			static
 			GPOS_RESULT EresUnittest_CHistogramBool();
 
+			static
+			GPOS_RESULT EresUnittest_CHistogramCompact();
+
+			// LIKE filters on text histograms
+			static
+			GPOS_RESULT EresUnittest_CHistogramLike();
+
 			// statistics basic tests
 			static
 			GPOS_RESULT EresUnittest_CStatisticsBasic();
 
+			// sharing of histograms between statistics objects
+			static
+			GPOS_RESULT EresUnittest_CStatisticsShareHistograms();
+
+			// derivation of histograms on worker tasks
+			static
+			GPOS_RESULT EresUnittest_DeriveHistogramsParallel();
+
+			// worker task function deriving histograms
+			static
+			void *PvDeriveHistograms(void *pv);
+
+			// pruning histograms of columns that are not required
+			static
+			GPOS_RESULT EresUnittest_CStatisticsPruneHistograms();
+
+			// capping the number of histogram buckets
+			static
+			GPOS_RESULT EresUnittest_CHistogramCapBuckets();
+
+			// cache of filter statistics
+			static
+			GPOS_RESULT EresUnittest_CStatsFilterCache();
+
+			// multi-column statistics
+			static
+			GPOS_RESULT EresUnittest_CStatisticsMultiColumn();
+
+			// sketches of the distinct values of columns
+			static
+			GPOS_RESULT EresUnittest_CHLLSketch();
+
 			// basic statistics parsing
 			static
 			GPOS_RESULT EresUnittest_CStatisticsBasicsFromDXL();
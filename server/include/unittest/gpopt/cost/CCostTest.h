@@ -33,6 +33,10 @@ namespace gpopt
 			static
 			void TestParams(IMemoryPool *pmp, BOOL fCalibrated);
 
+			// generate an inner hash join of two tables on a single equality predicate
+			static
+			CExpression *PexprInnerHashJoin(IMemoryPool *pmp);
+
 		public:
 
 			// unittests
@@ -43,6 +47,8 @@ namespace gpopt
 			static GPOS_RESULT EresUnittest_Parsing();
 			static GPOS_RESULT EresUnittest_ParsingWithException();
 			static GPOS_RESULT EresUnittest_SetParams();
+			static GPOS_RESULT EresUnittest_RuntimeFilterSelectivity();
+			static GPOS_RESULT EresUnittest_RuntimeFilterCost();
 
 	}; // class CCostTest
 }
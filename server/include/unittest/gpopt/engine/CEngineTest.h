@@ -21,6 +21,11 @@
 
 namespace gpopt
 {
+	// fwd declarations
+	class CBinding;
+	class CBindingHandle;
+	class CGroup;
+	class CXform;
 
 	//---------------------------------------------------------------------------
 	//	@class:
@@ -44,6 +49,26 @@ namespace gpopt
 			static
 			GPOS_RESULT EresTestEngine(Pfpexpr rgpf[], ULONG ulSize);
 
+			// check if two bindings consist of the same operators and group expressions
+			static
+			BOOL FEqualBindings(CExpression *pexprFst, CExpression *pexprSnd);
+
+			// compare bindings of given binding object with bindings extracted without sharing
+			static
+			void CheckBindings(IMemoryPool *pmp, CGroup *pgroup, CBinding *pbinding, CBitSet *pbsVisited);
+
+			// check if a lazy binding binds the same group expressions as an extracted binding
+			static
+			BOOL FEqualBindings(CExpression *pexpr, const CBindingHandle &bh);
+
+			// check if two xform results have the same operators and derived columns
+			static
+			BOOL FEqualResults(CExpression *pexprFst, CExpression *pexprSnd);
+
+			// compare lazy bindings of a group expression and their results with extracted bindings
+			static
+			void CheckLazyBindings(IMemoryPool *pmp, CGroupExpression *pgexpr, CXform *pxform);
+
 #endif // GPOS_DEBUG
 
 			// counter used to mark last successful test
@@ -65,6 +90,10 @@ namespace gpopt
 			static
 			GPOS_RESULT EresUnittest_Basic();
 
+			// test skipping low-utility xforms under the default strategy
+			static
+			GPOS_RESULT EresUnittest_AdaptiveXforms();
+
 			// helper function for optimizing deep join trees
 			static
 			GPOS_RESULT EresOptimize
@@ -118,6 +147,10 @@ namespace gpopt
 			static
 			GPOS_RESULT EresUnittest_BuildMemoWithCTE();
 
+			// test of sharing first bindings of child groups
+			static
+			GPOS_RESULT EresUnittest_Bindings();
+
 #endif // GPOS_DEBUG
 
 	}; // class CEngineTest
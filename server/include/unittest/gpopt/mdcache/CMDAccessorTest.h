@@ -17,6 +17,8 @@
 
 #include "gpopt/mdcache/CMDAccessor.h"
 
+#include "naucrates/md/CMDProviderMemory.h"
+
 namespace gpopt
 {
 	using namespace gpos;
@@ -46,6 +48,107 @@ namespace gpopt
 			
 			// cache task function pointer
 			typedef void * (*TaskFuncPtr)(void *);
+
+			// save a snapshot of the MD cache and restore objects from it
+			static
+			GPOS_RESULT EresSnapshot(IMemoryPool *pmp, const CHAR *szFileName);
+
+			// restore objects from a snapshot with a corrupt record
+			static
+			GPOS_RESULT EresSnapshotCorrupt(IMemoryPool *pmp, const CHAR *szFileName);
+
+			// look up objects in the MD cache; returns the number of objects
+			// requested from the provider
+			static
+			ULONG UlLookup(IMemoryPool *pmp, IMDId *pmdidRel, IMDId *pmdidType);
+
+			//---------------------------------------------------------------------------
+			//	@class:
+			//		CMDProviderBatch
+			//
+			//	@doc:
+			//		File-based provider serving requests for DXL strings in batches,
+			//		and counting the requests it serves
+			//
+			//---------------------------------------------------------------------------
+			class CMDProviderBatch : public CMDProviderMemory
+			{
+				private:
+
+					// number of batched requests
+					mutable ULONG m_ulBatches;
+
+					// number of requests for single objects
+					mutable ULONG m_ulObjects;
+
+					// private copy ctor
+					CMDProviderBatch(const CMDProviderBatch &);
+
+				public:
+
+					// ctor
+					CMDProviderBatch(IMemoryPool *pmp, const CHAR *szFileName);
+
+					// returns the DXL string of the requested metadata object
+					virtual
+					CWStringBase *PstrObject(IMemoryPool *pmp, CMDAccessor *pmda, IMDId *pmdid) const;
+
+					// objects are only supplied as DXL strings
+					virtual
+					IMDCacheObject *Pimdobj(IMemoryPool *pmp, CMDAccessor *pmda, IMDId *pmdid) const;
+
+					// returns the DXL strings of the metadata objects of a request
+					virtual
+					DrgPstr *PdrgpstrObjects(IMemoryPool *pmp, CMDAccessor *pmda, CMDRequest *pmdr) const;
+
+					// number of batched requests
+					ULONG UlBatches() const
+					{
+						return m_ulBatches;
+					}
+
+					// number of requests for single objects
+					ULONG UlObjects() const
+					{
+						return m_ulObjects;
+					}
+			};
+
+			//---------------------------------------------------------------------------
+			//	@class:
+			//		CMDProviderShared
+			//
+			//	@doc:
+			//		File-based provider sharing the objects it holds with the
+			//		accessor instead of having them cached
+			//
+			//---------------------------------------------------------------------------
+			class CMDProviderShared : public CMDProviderMemory
+			{
+				private:
+
+					// private copy ctor
+					CMDProviderShared(const CMDProviderShared &);
+
+				public:
+
+					// ctor
+					CMDProviderShared
+						(
+						IMemoryPool *pmp,
+						const CHAR *szFileName
+						)
+						:
+						CMDProviderMemory(pmp, szFileName)
+					{}
+
+					// objects are shared with the accessor
+					virtual
+					BOOL FSharesObjects() const
+					{
+						return true;
+					}
+			};
 			
 			// structure for passing parameters to task functions
 			struct SMDCacheTaskParams
@@ -77,6 +180,10 @@ namespace gpopt
 			static GPOS_RESULT EresUnittest_IndexPartConstraint();
 			static GPOS_RESULT EresUnittest_Cast();
 			static GPOS_RESULT EresUnittest_ScCmp();
+			static GPOS_RESULT EresUnittest_Prefetch();
+			static GPOS_RESULT EresUnittest_SharedObjects();
+			static GPOS_RESULT EresUnittest_Snapshot();
+			static GPOS_RESULT EresUnittest_Invalidate();
 
 			static GPOS_RESULT EresUnittest_ConcurrentAccessSingleMDA();
 			static GPOS_RESULT EresUnittest_ConcurrentAccessMultipleMDA();
@@ -27,12 +27,19 @@ namespace gpopt
 	class CMiniDumperDXLTest
 	{
 
+		private:
+
+			// round-trip the query, plan and metadata of a minidump through
+			// the binary DXL format
+			static GPOS_RESULT EresBinaryRoundTrip(gpos::IMemoryPool *pmp, const CHAR *szFileName);
+
 		public:
 
 			// unittests
 			static GPOS_RESULT EresUnittest();
 			static GPOS_RESULT EresUnittest_Basic();
 			static GPOS_RESULT EresUnittest_Load();
+			static GPOS_RESULT EresUnittest_BinaryRoundTrip();
 
 	}; // class CMiniDumperDXLTest
 }
@@ -32,6 +32,9 @@ namespace gpopt
 			// unittests
 			static GPOS_RESULT EresUnittest();
 			static GPOS_RESULT EresUnittest_Basic();
+			static GPOS_RESULT EresUnittest_PatternIndex();
+			static GPOS_RESULT EresUnittest_Utility();
+			static GPOS_RESULT EresUnittest_Profile();
 			
 	}; // class CXformFactoryTest
 	
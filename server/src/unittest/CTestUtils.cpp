@@ -60,6 +60,7 @@
 #include "gpopt/mdcache/CMDCache.h"
 #include "gpopt/minidump/CMinidumperUtils.h"
 #include "gpopt/operators/ops.h"
+#include "gpopt/xforms/CXformProfile.h"
 #include "gpopt/xforms/CXformUtils.h"
 #include "gpopt/translate/CTranslatorDXLToExpr.h"
 #include "gpopt/translate/CTranslatorExprToDXL.h"
@@ -3670,6 +3671,14 @@ CTestUtils::EresRunMinidumps
 		}
 	}
 
+	if (GPOS_FTRACE(EopttracePrintXformProfile))
+	{
+		// print xform profile aggregated over all minidumps run so far
+		CAutoMemoryPool amp;
+		CAutoTrace at(amp.Pmp());
+		at.Os() << "Aggregated xform profile:" << std::endl << *CXformProfile::PxfprofAggregate();
+	}
+
 	*pulTestCounter = 0;
 	return eres;
 }
@@ -20,7 +20,9 @@
 #include "naucrates/base/CQueryToDXLResult.h"
 #include "naucrates/dxl/CDXLUtils.h"
 #include "naucrates/dxl/xml/CDXLMemoryManager.h"
+#include "naucrates/dxl/xml/CDXLSinkStream.h"
 #include "naucrates/dxl/xml/CXMLSerializer.h"
+#include "naucrates/md/CMDName.h"
 
 #include "unittest/dxl/CDXLUtilsTest.h"
 
@@ -34,6 +36,44 @@ using namespace gpdxl;
 static const char *szQueryFile = "../data/dxl/expressiontests/TableScanQuery.xml";
 static const char *szPlanFile = "../data/dxl/expressiontests/TableScanPlan.xml";
 
+// buffer collecting the output of a DXL sink
+struct SSinkBuffer
+{
+	// collected bytes
+	BYTE *m_pb;
+
+	// number of collected bytes
+	ULONG m_ulLength;
+
+	// size of the buffer
+	ULONG m_ulCapacity;
+
+	// number of chunks received
+	ULONG m_ulChunks;
+
+	// size of the largest chunk received
+	ULONG m_ulMaxChunk;
+};
+
+// sink appending its input to an SSinkBuffer
+static
+void
+SinkAppend
+	(
+	void *pvSinkArg,
+	const BYTE *pb,
+	ULONG ulLength
+	)
+{
+	SSinkBuffer *psinkbuf = (SSinkBuffer *) pvSinkArg;
+	GPOS_RTL_ASSERT(psinkbuf->m_ulLength + ulLength <= psinkbuf->m_ulCapacity);
+
+	(void) clib::PvMemCpy(psinkbuf->m_pb + psinkbuf->m_ulLength, pb, ulLength);
+	psinkbuf->m_ulLength += ulLength;
+	psinkbuf->m_ulChunks++;
+	psinkbuf->m_ulMaxChunk = std::max(psinkbuf->m_ulMaxChunk, ulLength);
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLUtilsTest::EresUnittest
@@ -50,6 +90,9 @@ CDXLUtilsTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_SerializeQuery),
 		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_SerializePlan),
 		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_Encoding),
+		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_SerializePlanToSink),
+		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_SinkStreamEncoding),
+		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_NameFromXMLCh),
 		};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -161,6 +204,164 @@ CDXLUtilsTest::EresUnittest_SerializePlan()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtilsTest::EresUnittest_SerializePlanToSink
+//
+//	@doc:
+//		Serializing a plan to a sink produces the same document as
+//		serializing it to a stream, handed over in chunks of bounded size
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CDXLUtilsTest::EresUnittest_SerializePlanToSink()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// read DXL file
+	CHAR *szDXL = CDXLUtils::SzRead(pmp, szPlanFile);
+
+	ULLONG ullPlanId = ULLONG_MAX;
+	ULLONG ullPlanSpaceSize = ULLONG_MAX;
+	CDXLNode *pdxln = CDXLUtils::PdxlnParsePlan(pmp, szDXL, NULL /*szXSDPath*/, &ullPlanId, &ullPlanSpaceSize);
+
+	GPOS_RESULT eres = GPOS_OK;
+	BOOL rgfIndentation[] = {true, false};
+	for (ULONG ulIndent = 0; GPOS_OK == eres && ulIndent < GPOS_ARRAY_SIZE(rgfIndentation); ulIndent++)
+	{
+		CWStringDynamic str(pmp);
+		COstreamString oss(&str);
+		CDXLUtils::SerializePlan(pmp, oss, pdxln, ullPlanId, ullPlanSpaceSize, true /*fDocumentHeaderFooter*/, rgfIndentation[ulIndent]);
+
+		// the plan only has ASCII characters, each written as a single byte
+		SSinkBuffer sinkbuf;
+		sinkbuf.m_ulCapacity = str.UlLength();
+		sinkbuf.m_pb = GPOS_NEW_ARRAY(pmp, BYTE, sinkbuf.m_ulCapacity);
+		sinkbuf.m_ulLength = 0;
+		sinkbuf.m_ulChunks = 0;
+		sinkbuf.m_ulMaxChunk = 0;
+
+		CDXLUtils::SerializePlan(pmp, &SinkAppend, &sinkbuf, pdxln, ullPlanId, ullPlanSpaceSize, true /*fDocumentHeaderFooter*/, rgfIndentation[ulIndent]);
+
+		if (sinkbuf.m_ulLength != str.UlLength() || GPDXL_SINK_STREAM_BUFFER_SIZE < sinkbuf.m_ulMaxChunk)
+		{
+			eres = GPOS_FAILED;
+		}
+
+		for (ULONG ul = 0; GPOS_OK == eres && ul < sinkbuf.m_ulLength; ul++)
+		{
+			if ((WCHAR) sinkbuf.m_pb[ul] != str.Wsz()[ul])
+			{
+				eres = GPOS_FAILED;
+			}
+		}
+
+		GPOS_DELETE_ARRAY(sinkbuf.m_pb);
+	}
+
+	// cleanup
+	pdxln->Release();
+	GPOS_DELETE_ARRAY(szDXL);
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtilsTest::EresUnittest_SinkStreamEncoding
+//
+//	@doc:
+//		Characters written to a sink stream are encoded in UTF-8, and the
+//		buffer is handed to the sink whenever it fills up
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CDXLUtilsTest::EresUnittest_SinkStreamEncoding()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	const ULONG ulRepeat = GPDXL_SINK_STREAM_BUFFER_SIZE;
+	const WCHAR wsz[] = {L'a', (WCHAR) 0xE9, (WCHAR) 0x20AC, (WCHAR) 0x1F600, L'\0'};
+	const BYTE rgbExpected[] = {0x61, 0xC3, 0xA9, 0xE2, 0x82, 0xAC, 0xF0, 0x9F, 0x98, 0x80};
+
+	SSinkBuffer sinkbuf;
+	sinkbuf.m_ulCapacity = ulRepeat * GPOS_ARRAY_SIZE(rgbExpected);
+	sinkbuf.m_pb = GPOS_NEW_ARRAY(pmp, BYTE, sinkbuf.m_ulCapacity);
+	sinkbuf.m_ulLength = 0;
+	sinkbuf.m_ulChunks = 0;
+	sinkbuf.m_ulMaxChunk = 0;
+
+	// scope for stream
+	{
+		CDXLSinkStream os(pmp, &SinkAppend, &sinkbuf);
+		for (ULONG ul = 0; ul < ulRepeat; ul++)
+		{
+			os << wsz;
+		}
+		os.Flush();
+	}
+
+	GPOS_RESULT eres = GPOS_OK;
+	if (sinkbuf.m_ulLength != sinkbuf.m_ulCapacity || GPDXL_SINK_STREAM_BUFFER_SIZE < sinkbuf.m_ulMaxChunk || 1 >= sinkbuf.m_ulChunks)
+	{
+		eres = GPOS_FAILED;
+	}
+
+	for (ULONG ul = 0; GPOS_OK == eres && ul < sinkbuf.m_ulLength; ul++)
+	{
+		if (rgbExpected[ul % GPOS_ARRAY_SIZE(rgbExpected)] != sinkbuf.m_pb[ul])
+		{
+			eres = GPOS_FAILED;
+		}
+	}
+
+	GPOS_DELETE_ARRAY(sinkbuf.m_pb);
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtilsTest::EresUnittest_NameFromXMLCh
+//
+//	@doc:
+//		Names are decoded from UTF-16 Xerces strings into wide characters,
+//		combining surrogate pairs and replacing unpaired surrogates
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CDXLUtilsTest::EresUnittest_NameFromXMLCh()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CAutoP<CDXLMemoryManager> a_pmm(GPOS_NEW(pmp) CDXLMemoryManager(pmp));
+
+	const XMLCh xmlsz[] = {0x61, 0xE9, 0x20AC, 0xD83D, 0xDE00, 0xDC00, 0x62, 0};
+
+	// wide characters hold either code points or UTF-16 code units
+	const WCHAR wszCodePoints[] = {L'a', (WCHAR) 0xE9, (WCHAR) 0x20AC, (WCHAR) 0x1F600, (WCHAR) 0xFFFD, L'b', L'\0'};
+	const WCHAR *wszExpected = wszCodePoints;
+	if (2 == GPOS_SIZEOF(WCHAR))
+	{
+		wszExpected = (const WCHAR *) xmlsz;
+	}
+	CWStringConst strExpected(wszExpected);
+
+	CAutoP<CWStringDynamic> a_pstr(CDXLUtils::PstrFromXMLCh(a_pmm.Pt(), xmlsz));
+	CAutoP<CMDName> a_pmdname(CDXLUtils::PmdnameFromXmlsz(a_pmm.Pt(), xmlsz));
+
+	if (!a_pstr->FEquals(&strExpected) || !a_pmdname->Pstr()->FEquals(&strExpected))
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLUtilsTest::EresUnittest_Encoding
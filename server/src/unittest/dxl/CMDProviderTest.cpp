@@ -133,6 +133,18 @@ CMDProviderTest::TestMDLookup
 	GPOS_ASSERT(NULL != pimdobj1 && pmdid1->FEquals(pimdobj1->Pmdid()));
 	GPOS_ASSERT(NULL != pimdobj2 && pmdid2->FEquals(pimdobj2->Pmdid()));
 
+	// objects are built in the caller's memory pool without DXL parsing,
+	// and each call returns a new copy
+	IMDCacheObject *pimdobjCopy1 = pmdp->Pimdobj(pmp, amda.Pmda(), pmdid1);
+	IMDCacheObject *pimdobjCopy2 = pmdp->Pimdobj(pmp, amda.Pmda(), pmdid1);
+
+	GPOS_ASSERT(NULL != pimdobjCopy1 && pmdid1->FEquals(pimdobjCopy1->Pmdid()));
+	GPOS_ASSERT(NULL != pimdobjCopy2 && pmdid1->FEquals(pimdobjCopy2->Pmdid()));
+	GPOS_ASSERT(pimdobjCopy1 != pimdobjCopy2);
+
+	pimdobjCopy1->Release();
+	pimdobjCopy2->Release();
+
 	// cleanup
 	pmdid1->Release();
 	pmdid2->Release();
@@ -8,16 +8,23 @@
 //	@doc:
 //		Tests parsing DXL documents into DXL trees.
 //---------------------------------------------------------------------------
+#include "gpos/common/CAutoP.h"
+#include "gpos/common/CAutoRg.h"
+#include "gpos/common/CWallClock.h"
 #include "gpos/error/CException.h"
 #include "gpos/error/CAutoTrace.h"
 #include "gpos/error/CMessage.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
+#include "gpos/task/CAutoTaskProxy.h"
 
 #include "naucrates/exception.h"
 #include "naucrates/base/CQueryToDXLResult.h"
 #include "naucrates/dxl/xml/CXMLSerializer.h"
+#include "naucrates/dxl/xml/CDXLMemoryManager.h"
+#include "naucrates/dxl/parser/CParseHandlerDXL.h"
 #include "naucrates/dxl/operators/CDXLNode.h"
+#include "naucrates/dxl/CDXLParallelParser.h"
 #include "naucrates/dxl/CDXLUtils.h"
 
 #include "gpopt/eval/CConstExprEvaluatorDefault.h"
@@ -84,6 +91,7 @@ CParseHandlerTest::m_rgszPlanDXLFileNames[] =
 		"../data/dxl/parse_tests/q72-BitmapBoolOp.xml",
 		"../data/dxl/parse_tests/q74-DirectDispatchInfo.xml",
 		"../data/dxl/parse_tests/q76-ValuesScan.xml",
+		"../data/dxl/parse_tests/q77-HJ-RuntimeFilter.xml",
  	};
 
 // files for tests involving dxl representation of queries
@@ -202,6 +210,20 @@ CParseHandlerTest::EresUnittest()
 
 		// tests that should throw an exception
 		GPOS_UNITTEST_FUNC(CParseHandlerTest::EresUnittest_RunAllNegativeTests),
+
+		// tests of the binary DXL format
+		GPOS_UNITTEST_FUNC(CParseHandlerTest::EresUnittest_BinaryRoundTrip),
+		GPOS_UNITTEST_FUNC_THROW
+			(
+			CParseHandlerTest::EresUnittest_ErrBinaryHeader,
+			gpdxl::ExmaDXL,
+			gpdxl::ExmiDXLBinaryParseError
+			),
+
+		GPOS_UNITTEST_FUNC(CParseHandlerTest::EresUnittest_TokenLookup),
+		GPOS_UNITTEST_FUNC(CParseHandlerTest::EresUnittest_ParseThroughput),
+		GPOS_UNITTEST_FUNC(CParseHandlerTest::EresUnittest_ParallelParse),
+		GPOS_UNITTEST_FUNC(CParseHandlerTest::EresUnittest_ValidateInBackground),
 		};
 
 	// skip OOM and Abort simulation for this test, it takes hours
@@ -434,6 +456,576 @@ CParseHandlerTest::EresUnittest_RunAllNegativeTests()
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerTest::EresUnittest_BinaryRoundTrip
+//
+//	@doc:
+//		Run the plan, query and metadata tests through the binary DXL format
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CParseHandlerTest::EresUnittest_BinaryRoundTrip()
+{
+	if (GPOS_OK != EresUnittest_RunAllPositiveTests
+					(
+					m_rgszPlanDXLFileNames,
+					GPOS_ARRAY_SIZE(m_rgszPlanDXLFileNames),
+					&EresParseAndSerializeBinaryPlan,
+					false/* fValidate */
+					))
+	{
+		return GPOS_FAILED;
+	}
+
+	if (GPOS_OK != EresUnittest_RunAllPositiveTests
+					(
+					m_rgszQueryDXLFileNames,
+					GPOS_ARRAY_SIZE(m_rgszQueryDXLFileNames),
+					&EresParseAndSerializeBinaryQuery,
+					false/* fValidate */
+					))
+	{
+		return GPOS_FAILED;
+	}
+
+	return EresUnittest_RunAllPositiveTests
+		(
+		m_rgszMetadataDXLFileNames,
+		GPOS_ARRAY_SIZE(m_rgszMetadataDXLFileNames),
+		&EresParseAndSerializeBinaryMetadata,
+		false/* fValidate */
+		);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerTest::EresUnittest_ErrBinaryHeader
+//
+//	@doc:
+//		Parsing a binary DXL document with an unknown format version must
+//		raise an exception
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CParseHandlerTest::EresUnittest_ErrBinaryHeader()
+{
+	// create own memory pool
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcNone);
+	IMemoryPool *pmp = amp.Pmp();
+
+	CHAR *szDXL = CDXLUtils::SzRead(pmp, m_rgszMetadataDXLFileNames[0]);
+	DrgPimdobj *pdrgpmdobj = CDXLUtils::PdrgpmdobjParseDXL(pmp, szDXL, NULL /*szXSDPath*/);
+
+	ULONG ulLength = 0;
+	BYTE *pba = CDXLUtils::PbaSerializeMetadata(pmp, pdrgpmdobj, &ulLength);
+
+	// the version follows the four magic bytes
+	GPOS_ASSERT(4 < ulLength);
+	pba[4]++;
+
+	// function call should throw an exception
+	(void) CDXLUtils::PdrgpmdobjParseBinaryDXL(pmp, pba, ulLength);
+
+	return GPOS_FAILED;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerTest::EresUnittest_TokenLookup
+//
+//	@doc:
+//		Token strings resolve to token ids; tokens sharing a string resolve
+//		to the same id and share the same XMLCh* string
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CParseHandlerTest::EresUnittest_TokenLookup()
+{
+	// create own memory pool
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcNone);
+	IMemoryPool *pmp = amp.Pmp();
+	CDXLMemoryManager mm(pmp);
+
+	// groups of tokens sharing a string, first token of each group first
+	Edxltoken rgedxltoken[][3] =
+		{
+		{EdxltokenPlan, EdxltokenPlan, EdxltokenPlan},
+		{EdxltokenPhysicalSort, EdxltokenSpoolSort, EdxltokenSpoolSort},
+		{EdxltokenColDescr, EdxltokenColumn, EdxltokenColumn},
+		{EdxltokenScalarPartBoundLower, EdxltokenStatsBucketLowerBound, EdxltokenCostParamLowerBound},
+		};
+
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgedxltoken); ul++)
+	{
+		Edxltoken edxltokenFirst = rgedxltoken[ul][0];
+		const XMLCh *xmlszFirst = CDXLTokens::XmlstrToken(edxltokenFirst);
+
+		for (ULONG ulToken = 0; ulToken < GPOS_ARRAY_SIZE(rgedxltoken[ul]); ulToken++)
+		{
+			const XMLCh *xmlsz = CDXLTokens::XmlstrToken(rgedxltoken[ul][ulToken]);
+			if (xmlsz != xmlszFirst || edxltokenFirst != CDXLTokens::EdxltokenFromXmlstr(xmlsz))
+			{
+				return GPOS_FAILED;
+			}
+		}
+
+		// a copy of the token string resolves to the same token
+		CHAR *sz = XMLString::transcode(xmlszFirst, &mm);
+		XMLCh *xmlszCopy = XMLString::transcode(sz, &mm);
+		Edxltoken edxltoken = CDXLTokens::EdxltokenFromXmlstr(xmlszCopy);
+		XMLString::release(&xmlszCopy, &mm);
+		XMLString::release(&sz, &mm);
+
+		if (edxltokenFirst != edxltoken)
+		{
+			return GPOS_FAILED;
+		}
+	}
+
+	const CHAR *rgsz[] = {"", "Plan ", "plan", "NotADXLToken"};
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgsz); ul++)
+	{
+		XMLCh *xmlsz = XMLString::transcode(rgsz[ul], &mm);
+		Edxltoken edxltoken = CDXLTokens::EdxltokenFromXmlstr(xmlsz);
+		XMLString::release(&xmlsz, &mm);
+
+		if (EdxltokenSentinel != edxltoken)
+		{
+			return GPOS_FAILED;
+		}
+	}
+
+	return GPOS_OK;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerTest::EresUnittest_ParseThroughput
+//
+//	@doc:
+//		Microbenchmark of parsing the plan, query and metadata files; reports
+//		the parsing throughput in MB/s
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CParseHandlerTest::EresUnittest_ParseThroughput()
+{
+	// create own memory pool
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcNone);
+	IMemoryPool *pmp = amp.Pmp();
+
+	const ULONG ulIterations = 10;
+
+	const CHAR **rgrgszFileNames[] =
+		{
+		m_rgszPlanDXLFileNames,
+		m_rgszQueryDXLFileNames,
+		m_rgszMetadataDXLFileNames,
+		};
+
+	const ULONG rgulFiles[] =
+		{
+		GPOS_ARRAY_SIZE(m_rgszPlanDXLFileNames),
+		GPOS_ARRAY_SIZE(m_rgszQueryDXLFileNames),
+		GPOS_ARRAY_SIZE(m_rgszMetadataDXLFileNames),
+		};
+
+	ULLONG ullBytes = 0;
+	ULONG ulTime = 0;
+	for (ULONG ulKind = 0; ulKind < GPOS_ARRAY_SIZE(rgulFiles); ulKind++)
+	{
+		for (ULONG ulFile = 0; ulFile < rgulFiles[ulKind]; ulFile++)
+		{
+			CHAR *szDXL = CDXLUtils::SzRead(pmp, rgrgszFileNames[ulKind][ulFile]);
+
+			// scope for clock
+			{
+				CWallClock clock;
+				for (ULONG ul = 0; ul < ulIterations; ul++)
+				{
+					CParseHandlerDXL *pphdxl = CDXLUtils::PphdxlParseDXL(pmp, szDXL, NULL /*szXSDPath*/);
+					GPOS_DELETE(pphdxl);
+
+					GPOS_CHECK_ABORT;
+				}
+				ulTime += clock.UlElapsedMS();
+			}
+
+			ullBytes += ulIterations * (ULLONG) clib::UlStrLen(szDXL);
+			GPOS_DELETE_ARRAY(szDXL);
+		}
+	}
+
+	DOUBLE dMB = (DOUBLE) ullBytes / (1024.0 * 1024.0);
+	GPOS_TRACE_FORMAT
+		(
+		"\t\t* parsed %.2f MB in %dms: %.2f MB/s",
+		dMB,
+		ulTime,
+		dMB * 1000.0 / (DOUBLE) std::max(ulTime, (ULONG) 1)
+		);
+
+	return GPOS_OK;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerTest::EresUnittest_ParallelParse
+//
+//	@doc:
+//		Verifies that parsing the metadata of a metadata file and a minidump
+//		on worker tasks yields the same objects, in the same order, as
+//		parsing them serially, and that a pool which is not thread-safe
+//		falls back to parsing serially
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CParseHandlerTest::EresUnittest_ParallelParse()
+{
+	// create own memory pool
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcNone);
+	IMemoryPool *pmp = amp.Pmp();
+
+	const CHAR *rgszFileNames[] =
+		{
+		"../data/dxl/parse_tests/q26-Metadata.xml",
+		"../data/dxl/minidump/AddEqualityPredicates.mdp",
+		};
+
+	for (ULONG ulFile = 0; ulFile < GPOS_ARRAY_SIZE(rgszFileNames); ulFile++)
+	{
+		CAutoRg<CHAR> a_szDXL;
+		a_szDXL = CDXLUtils::SzRead(pmp, rgszFileNames[ulFile]);
+
+		CAutoP<CParseHandlerDXL> a_pphdxlSerial;
+		a_pphdxlSerial = CDXLUtils::PphdxlParseDXL(pmp, a_szDXL.Rgt(), NULL /*szXSDPath*/);
+
+		// split even the smallest metadata sections
+		CAutoP<CParseHandlerDXL> a_pphdxlParallel;
+		a_pphdxlParallel = CDXLParallelParser::PphdxlParse(pmp, a_szDXL.Rgt(), 1 /*ulElementsMin*/);
+
+		CAutoP<CWStringDynamic> a_pstrSerial;
+		a_pstrSerial = CDXLUtils::PstrSerializeMetadata(pmp, a_pphdxlSerial.Pt()->Pdrgpmdobj(), false /*fDocumentHeaderFooter*/, false /*fIndent*/);
+
+		CAutoP<CWStringDynamic> a_pstrParallel;
+		a_pstrParallel = CDXLUtils::PstrSerializeMetadata(pmp, a_pphdxlParallel.Pt()->Pdrgpmdobj(), false /*fDocumentHeaderFooter*/, false /*fIndent*/);
+
+		if (0 == a_pphdxlSerial.Pt()->Pdrgpmdobj()->UlLength() ||
+			!a_pstrSerial.Pt()->FEquals(a_pstrParallel.Pt()))
+		{
+			return GPOS_FAILED;
+		}
+
+		DrgPsysid *pdrgpsysidSerial = a_pphdxlSerial.Pt()->Pdrgpsysid();
+		DrgPsysid *pdrgpsysidParallel = a_pphdxlParallel.Pt()->Pdrgpsysid();
+		if ((NULL == pdrgpsysidSerial) != (NULL == pdrgpsysidParallel))
+		{
+			return GPOS_FAILED;
+		}
+
+		if (NULL != pdrgpsysidSerial)
+		{
+			const ULONG ulSysids = pdrgpsysidSerial->UlLength();
+			if (ulSysids != pdrgpsysidParallel->UlLength())
+			{
+				return GPOS_FAILED;
+			}
+
+			for (ULONG ul = 0; ul < ulSysids; ul++)
+			{
+				if (!(*pdrgpsysidSerial)[ul]->FEquals(*(*pdrgpsysidParallel)[ul]))
+				{
+					return GPOS_FAILED;
+				}
+			}
+		}
+
+		GPOS_CHECK_ABORT;
+	}
+
+	// a pool that is not thread-safe is not shared with worker tasks, the
+	// document is parsed serially instead
+	CAutoMemoryPool ampSerial(CAutoMemoryPool::ElcNone, CMemoryPoolManager::EatTracker, false /*fThreadSafe*/);
+	IMemoryPool *pmpSerial = ampSerial.Pmp();
+
+	CAutoRg<CHAR> a_szDXL;
+	a_szDXL = CDXLUtils::SzRead(pmpSerial, rgszFileNames[0]);
+
+	CAutoP<CParseHandlerDXL> a_pphdxl;
+	a_pphdxl = CDXLParallelParser::PphdxlParse(pmpSerial, a_szDXL.Rgt(), 1 /*ulElementsMin*/);
+	if (0 == a_pphdxl.Pt()->Pdrgpmdobj()->UlLength())
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerTest::EresUnittest_ValidateInBackground
+//
+//	@doc:
+//		Validate the plan files and an invalid document on concurrent tasks
+//		sharing the cached schema grammar
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CParseHandlerTest::EresUnittest_ValidateInBackground()
+{
+	// create own memory pool
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcNone);
+	IMemoryPool *pmp = amp.Pmp();
+
+	const CHAR *szInvalid =
+		"<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+		"<dxl:DXLMessage xmlns:dxl=\"http://greenplum.com/dxl/2010/12/\"><dxl:NoSuchElement/></dxl:DXLMessage>";
+
+	const ULONG ulFiles = GPOS_ARRAY_SIZE(m_rgszPlanDXLFileNames);
+	const ULONG ulTasks = ulFiles + 1;
+
+	CAutoRg<CHAR *> a_rgszDXL;
+	a_rgszDXL = GPOS_NEW_ARRAY(pmp, CHAR *, ulFiles);
+
+	CAutoRg<SValidateDXLArg> a_rgarg;
+	a_rgarg = GPOS_NEW_ARRAY(pmp, SValidateDXLArg, ulTasks);
+
+	for (ULONG ul = 0; ul < ulTasks; ul++)
+	{
+		a_rgarg[ul].m_szDXL = szInvalid;
+		if (ul < ulFiles)
+		{
+			a_rgszDXL[ul] = CDXLUtils::SzRead(pmp, m_rgszPlanDXLFileNames[ul]);
+			a_rgarg[ul].m_szDXL = a_rgszDXL[ul];
+		}
+
+		a_rgarg[ul].m_szXSDPath = CTestUtils::m_szXSDPath;
+		a_rgarg[ul].m_fValid = false;
+	}
+
+	// scope for ATP
+	{
+		CAutoTaskProxy atp(pmp, CWorkerPoolManager::Pwpm());
+
+		CAutoRg<CTask *> a_rgptsk;
+		a_rgptsk = GPOS_NEW_ARRAY(pmp, CTask *, ulTasks);
+
+		for (ULONG ul = 0; ul < ulTasks; ul++)
+		{
+			a_rgptsk[ul] = atp.PtskCreate(CDXLUtils::PvValidateDXL, &a_rgarg[ul]);
+			atp.Schedule(a_rgptsk[ul]);
+		}
+
+		for (ULONG ul = 0; ul < ulTasks; ul++)
+		{
+			atp.Wait(a_rgptsk[ul]);
+			GPOS_CHECK_ABORT;
+		}
+	}
+
+	GPOS_RESULT eres = GPOS_OK;
+	for (ULONG ul = 0; ul < ulTasks; ul++)
+	{
+		if (a_rgarg[ul].m_fValid != (ul < ulFiles))
+		{
+			eres = GPOS_FAILED;
+		}
+	}
+
+	for (ULONG ul = 0; ul < ulFiles; ul++)
+	{
+		GPOS_DELETE_ARRAY(a_rgszDXL[ul]);
+	}
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerTest::EresParseAndSerializeBinaryPlan
+//
+//	@doc:
+//		Verifies that a plan parsed from the given DXL file, written in the
+//		binary format and parsed back, serializes to the same string
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CParseHandlerTest::EresParseAndSerializeBinaryPlan
+	(
+	IMemoryPool *pmp,
+	const CHAR *szDXLFileName,
+	BOOL // fValidate
+	)
+{
+	CHAR *szDXL = CDXLUtils::SzRead(pmp, szDXLFileName);
+
+	ULLONG ullPlanId = ULLONG_MAX;
+	ULLONG ullPlanSpaceSize = ULLONG_MAX;
+	CDXLNode *pdxln = CDXLUtils::PdxlnParsePlan(pmp, szDXL, NULL /*szXSDPath*/, &ullPlanId, &ullPlanSpaceSize);
+
+	ULONG ulLength = 0;
+	BYTE *pba = CDXLUtils::PbaSerializePlan(pmp, pdxln, ullPlanId, ullPlanSpaceSize, &ulLength);
+	pdxln->Release();
+
+	GPOS_CHECK_ABORT;
+
+	ullPlanId = ULLONG_MAX;
+	ullPlanSpaceSize = ULLONG_MAX;
+	CDXLNode *pdxlnBinary = CDXLUtils::PdxlnParseBinaryPlan(pmp, pba, ulLength, &ullPlanId, &ullPlanSpaceSize);
+
+	CWStringDynamic strPlan(pmp);
+	COstreamString osPlan(&strPlan);
+	CDXLUtils::SerializePlan(pmp, osPlan, pdxlnBinary, ullPlanId, ullPlanSpaceSize, true /*fSerializeHeaderFooter*/, true /*fIndent*/);
+
+	CWStringDynamic dstrExpected(pmp);
+	dstrExpected.AppendFormat(GPOS_WSZ_LIT("%s"), szDXL);
+
+	GPOS_RESULT eres = GPOS_OK;
+	if (!dstrExpected.FEquals(&strPlan))
+	{
+		GPOS_TRACE(strPlan.Wsz());
+		eres = GPOS_FAILED;
+	}
+
+	// cleanup
+	pdxlnBinary->Release();
+	GPOS_DELETE_ARRAY(pba);
+	GPOS_DELETE_ARRAY(szDXL);
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerTest::EresParseAndSerializeBinaryQuery
+//
+//	@doc:
+//		Verifies that a query parsed from the given DXL file, written in the
+//		binary format and parsed back, serializes to the same string
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CParseHandlerTest::EresParseAndSerializeBinaryQuery
+	(
+	IMemoryPool *pmp,
+	const CHAR *szDXLFileName,
+	BOOL // fValidate
+	)
+{
+	CHAR *szDXL = CDXLUtils::SzRead(pmp, szDXLFileName);
+
+	CQueryToDXLResult *pq2dxlresult = CDXLUtils::PdxlnParseDXLQuery(pmp, szDXL, NULL /*szXSDPath*/);
+
+	ULONG ulLength = 0;
+	BYTE *pba = CDXLUtils::PbaSerializeQuery
+							(
+							pmp,
+							pq2dxlresult->Pdxln(),
+							pq2dxlresult->PdrgpdxlnOutputCols(),
+							pq2dxlresult->PdrgpdxlnCTE(),
+							&ulLength
+							);
+	GPOS_DELETE(pq2dxlresult);
+
+	GPOS_CHECK_ABORT;
+
+	CQueryToDXLResult *pq2dxlresultBinary = CDXLUtils::PdxlnParseBinaryDXLQuery(pmp, pba, ulLength);
+
+	CWStringDynamic wstrQuery(pmp);
+	COstreamString osQuery(&wstrQuery);
+	CDXLUtils::SerializeQuery
+				(
+				pmp,
+				osQuery,
+				pq2dxlresultBinary->Pdxln(),
+				pq2dxlresultBinary->PdrgpdxlnOutputCols(),
+				pq2dxlresultBinary->PdrgpdxlnCTE(),
+				true /*fSerializeHeaderFooter*/,
+				true /*fIndent*/
+				);
+
+	// compare with the XML round trip, which may normalize the document
+	CQueryToDXLResult *pq2dxlresultXML = CDXLUtils::PdxlnParseDXLQuery(pmp, szDXL, NULL /*szXSDPath*/);
+	CWStringDynamic wstrExpected(pmp);
+	COstreamString osExpected(&wstrExpected);
+	CDXLUtils::SerializeQuery
+				(
+				pmp,
+				osExpected,
+				pq2dxlresultXML->Pdxln(),
+				pq2dxlresultXML->PdrgpdxlnOutputCols(),
+				pq2dxlresultXML->PdrgpdxlnCTE(),
+				true /*fSerializeHeaderFooter*/,
+				true /*fIndent*/
+				);
+
+	GPOS_RESULT eres = GPOS_OK;
+	if (!wstrExpected.FEquals(&wstrQuery))
+	{
+		GPOS_TRACE(wstrQuery.Wsz());
+		eres = GPOS_FAILED;
+	}
+
+	// cleanup
+	GPOS_DELETE(pq2dxlresultXML);
+	GPOS_DELETE(pq2dxlresultBinary);
+	GPOS_DELETE_ARRAY(pba);
+	GPOS_DELETE_ARRAY(szDXL);
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerTest::EresParseAndSerializeBinaryMetadata
+//
+//	@doc:
+//		Verifies that metadata objects parsed from the given DXL file,
+//		written in the binary format and parsed back, serialize to the
+//		same string
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CParseHandlerTest::EresParseAndSerializeBinaryMetadata
+	(
+	IMemoryPool *pmp,
+	const CHAR *szDXLFileName,
+	BOOL // fValidate
+	)
+{
+	CHAR *szDXL = CDXLUtils::SzRead(pmp, szDXLFileName);
+
+	DrgPimdobj *pdrgpmdobj = CDXLUtils::PdrgpmdobjParseDXL(pmp, szDXL, NULL /*szXSDPath*/);
+
+	ULONG ulLength = 0;
+	BYTE *pba = CDXLUtils::PbaSerializeMetadata(pmp, pdrgpmdobj, &ulLength);
+	pdrgpmdobj->Release();
+
+	GPOS_CHECK_ABORT;
+
+	DrgPimdobj *pdrgpmdobjBinary = CDXLUtils::PdrgpmdobjParseBinaryDXL(pmp, pba, ulLength);
+	CWStringDynamic *pstr = CDXLUtils::PstrSerializeMetadata(pmp, pdrgpmdobjBinary, true /*fSerializeHeaderFooter*/, true /*fIndent*/);
+
+	CWStringDynamic dstrExpected(pmp);
+	dstrExpected.AppendFormat(GPOS_WSZ_LIT("%s"), szDXL);
+
+	GPOS_RESULT eres = GPOS_OK;
+	if (!dstrExpected.FEquals(pstr))
+	{
+		GPOS_TRACE(pstr->Wsz());
+		eres = GPOS_FAILED;
+	}
+
+	// cleanup
+	pdrgpmdobjBinary->Release();
+	GPOS_DELETE(pstr);
+	GPOS_DELETE_ARRAY(pba);
+	GPOS_DELETE_ARRAY(szDXL);
+
+	return eres;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CParseHandlerTest::EresParseAndSerializePlan
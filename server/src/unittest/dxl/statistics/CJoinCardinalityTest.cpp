@@ -15,6 +15,7 @@
 
 #include <stdint.h>
 
+#include "gpos/common/CWallClock.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
 
@@ -36,6 +37,8 @@ CJoinCardinalityTest::EresUnittest()
 		{
 		GPOS_UNITTEST_FUNC(CJoinCardinalityTest::EresUnittest_Join),
 		GPOS_UNITTEST_FUNC(CJoinCardinalityTest::EresUnittest_JoinNDVRemain),
+		GPOS_UNITTEST_FUNC(CJoinCardinalityTest::EresUnittest_JoinCompact),
+		GPOS_UNITTEST_FUNC(CJoinCardinalityTest::EresUnittest_JoinCompactPerf),
 		};
 
 	// run tests with shared optimization context first
@@ -170,7 +173,7 @@ CJoinCardinalityTest::EresUnittest_JoinNDVRemain()
 			eres = GPOS_FAILED;
 		}
 
-		GPOS_DELETE(phistJoin);
+		phistJoin->Release();
 	}
 	// clean up
 	phmulhist->Release();
@@ -289,6 +292,229 @@ CJoinCardinalityTest::EresUnittest_Join()
 	return GPOS_OK;
 }
 
+//	equality join using compact buckets must give the same histogram as
+//	aligning buckets one pair at a time
+GPOS_RESULT
+CJoinCardinalityTest::EresUnittest_JoinCompact()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+	CMDAccessor *pmda = COptCtxt::PoctxtFromTLS()->Pmda();
+
+	// histograms of fact and dimension table columns
+	CHAR *szDXLInput = CDXLUtils::SzRead(pmp, "../data/dxl/statistics/Join-Statistics-Input.xml");
+	DrgPdxlstatsderrel *pdrgpdxlstatsderrel = CDXLUtils::PdrgpdxlstatsderrelParseDXL(pmp, szDXLInput, NULL);
+	DrgPstats *pdrgpstat = CDXLUtils::PdrgpstatsTranslateStats(pmp, pmda, pdrgpdxlstatsderrel);
+	pdrgpdxlstatsderrel->Release();
+	GPOS_ASSERT(2 == pdrgpstat->UlLength());
+
+	ULONG rgulColIds1[] = {16, 54, 53, 0};
+	ULONG rgulColIds2[] = {31, 32};
+
+	GPOS_RESULT eres = GPOS_OK;
+	for (ULONG ul1 = 0; ul1 < GPOS_ARRAY_SIZE(rgulColIds1) && GPOS_OK == eres; ul1++)
+	{
+		for (ULONG ul2 = 0; ul2 < GPOS_ARRAY_SIZE(rgulColIds2) && GPOS_OK == eres; ul2++)
+		{
+			const CHistogram *phist1 = (*pdrgpstat)[0]->Phist(rgulColIds1[ul1]);
+			const CHistogram *phist2 = (*pdrgpstat)[1]->Phist(rgulColIds2[ul2]);
+			eres = EresJoinCompact(pmp, phist1, phist2);
+		}
+	}
+
+	// synthetic histograms that partially overlap
+	INT rgiShapes[][3] =
+	{
+		// buckets, start, width
+		{20, 0, 10},
+		{20, 5, 10},
+		{40, 0, 3},
+		{16, 100, 25},
+		{64, -50, 7},
+	};
+
+	const ULONG ulShapes = GPOS_ARRAY_SIZE(rgiShapes);
+	for (ULONG ul1 = 0; ul1 < ulShapes && GPOS_OK == eres; ul1++)
+	{
+		for (ULONG ul2 = 0; ul2 < ulShapes && GPOS_OK == eres; ul2++)
+		{
+			CHistogram *phist1 = PhistSynthetic(pmp, rgiShapes[ul1][0], rgiShapes[ul1][1], rgiShapes[ul1][2]);
+			CHistogram *phist2 = PhistSynthetic(pmp, rgiShapes[ul2][0], rgiShapes[ul2][1], rgiShapes[ul2][2]);
+			eres = EresJoinCompact(pmp, phist1, phist2);
+			phist1->Release();
+			phist2->Release();
+		}
+	}
+
+	// clean up
+	pdrgpstat->Release();
+	GPOS_DELETE_ARRAY(szDXLInput);
+
+	return eres;
+}
+
+//	microbenchmark of equality join with and without compact buckets
+GPOS_RESULT
+CJoinCardinalityTest::EresUnittest_JoinCompactPerf()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	const ULONG ulIterations = 100;
+
+	CHistogram *phist1 = PhistSynthetic(pmp, 250, 0, 40);
+	CHistogram *phist2 = PhistSynthetic(pmp, 250, 17, 40);
+	CHistogram *phistCompact1 = phist1->PhistCopy(pmp);
+	CHistogram *phistCompact2 = phist2->PhistCopy(pmp);
+	phistCompact1->BuildCompact(pmp);
+	phistCompact2->BuildCompact(pmp);
+
+	ULONG ulTimeBuckets = 0;
+	ULONG ulTimeCompact = 0;
+
+	// scope for clock
+	{
+		CWallClock clock;
+		for (ULONG ul = 0; ul < ulIterations; ul++)
+		{
+			CHistogram *phistJoin = phist1->PhistJoin(pmp, CStatsPred::EstatscmptEq, phist2);
+			phistJoin->Release();
+		}
+		ulTimeBuckets = clock.UlElapsedMS();
+	}
+
+	// scope for clock
+	{
+		CWallClock clock;
+		for (ULONG ul = 0; ul < ulIterations; ul++)
+		{
+			CHistogram *phistJoin = phistCompact1->PhistJoin(pmp, CStatsPred::EstatscmptEq, phistCompact2);
+			phistJoin->Release();
+		}
+		ulTimeCompact = clock.UlElapsedMS();
+	}
+
+	GPOS_TRACE_FORMAT
+		(
+		"\t\t* %d joins of %d buckets:  buckets: %dms   compact: %dms",
+		ulIterations,
+		phist1->UlBuckets(),
+		ulTimeBuckets,
+		ulTimeCompact
+		);
+
+	// clean up
+	phist1->Release();
+	phist2->Release();
+	phistCompact1->Release();
+	phistCompact2->Release();
+
+	return GPOS_OK;
+}
+
+//	helper method to generate a synthetic int4 histogram; every fourth bucket
+//	is followed by a gap, every third bucket is a singleton, and every fifth
+//	bucket has an open lower bound and a closed upper bound
+CHistogram *
+CJoinCardinalityTest::PhistSynthetic
+	(
+	IMemoryPool *pmp,
+	ULONG ulBuckets,
+	INT iStart,
+	INT iWidth
+	)
+{
+	GPOS_ASSERT(1 < iWidth);
+
+	DrgPbucket *pdrgppbucket = GPOS_NEW(pmp) DrgPbucket(pmp);
+	CDouble dFrequency = CDouble(1.0) / CDouble(ulBuckets + 1);
+	INT iLower = iStart;
+	for (ULONG ul = 0; ul < ulBuckets; ul++)
+	{
+		CBucket *pbucket = NULL;
+		if (2 == ul % 3)
+		{
+			pbucket = CCardinalityTestUtils::PbucketInteger(pmp, iLower, iLower, true, true, dFrequency, 1.0);
+		}
+		else
+		{
+			BOOL fLowerClosed = (0 != ul % 5);
+			pbucket = CCardinalityTestUtils::PbucketInteger(pmp, iLower, iLower + iWidth, fLowerClosed, !fLowerClosed, dFrequency, CDouble(iWidth / 2));
+		}
+		pdrgppbucket->Append(pbucket);
+
+		iLower = iLower + iWidth + 1;
+		if (0 == ul % 4)
+		{
+			iLower = iLower + iWidth / 2;
+		}
+	}
+
+	return GPOS_NEW(pmp) CHistogram(pdrgppbucket, true, 0.0 /*dNullFreq*/, 10.0 /*dDistinctRemain*/, dFrequency /*dFreqRemain*/);
+}
+
+//	helper method to check that equality join of given histograms gives the same result with compact buckets
+GPOS_RESULT
+CJoinCardinalityTest::EresJoinCompact
+	(
+	IMemoryPool *pmp,
+	const CHistogram *phist1,
+	const CHistogram *phist2
+	)
+{
+	CHistogram *phistCompact1 = phist1->PhistCopy(pmp);
+	CHistogram *phistCompact2 = phist2->PhistCopy(pmp);
+	phistCompact1->BuildCompact(pmp);
+	phistCompact2->BuildCompact(pmp);
+	GPOS_RTL_ASSERT(NULL != phistCompact1->Pchist() || CHistogram::UlMinBucketsCompact > phist1->UlBuckets());
+	GPOS_RTL_ASSERT(NULL != phistCompact2->Pchist() || CHistogram::UlMinBucketsCompact > phist2->UlBuckets());
+
+	CHistogram *phistJoin = phist1->PhistJoin(pmp, CStatsPred::EstatscmptEq, phist2);
+	CHistogram *phistJoinCompact = phistCompact1->PhistJoin(pmp, CStatsPred::EstatscmptEq, phistCompact2);
+
+	BOOL fEqual =
+		phistJoin->UlBuckets() == phistJoinCompact->UlBuckets() &&
+		phistJoin->DDistinctRemain() == phistJoinCompact->DDistinctRemain() &&
+		phistJoin->DFreqRemain() == phistJoinCompact->DFreqRemain();
+
+	for (ULONG ul = 0; fEqual && ul < phistJoin->UlBuckets(); ul++)
+	{
+		CBucket *pbucket = (*phistJoin->Pdrgpbucket())[ul];
+		CBucket *pbucketCompact = (*phistJoinCompact->Pdrgpbucket())[ul];
+
+		fEqual =
+			pbucket->PpLower()->FEqual(pbucketCompact->PpLower()) &&
+			pbucket->PpUpper()->FEqual(pbucketCompact->PpUpper()) &&
+			pbucket->FLowerClosed() == pbucketCompact->FLowerClosed() &&
+			pbucket->FUpperClosed() == pbucketCompact->FUpperClosed() &&
+			pbucket->DFrequency() == pbucketCompact->DFrequency() &&
+			pbucket->DDistinct() == pbucketCompact->DDistinct();
+	}
+
+	if (!fEqual)
+	{
+		CAutoTrace at(pmp);
+		at.Os() << "Join Histogram" << std::endl;
+		phistJoin->OsPrint(at.Os());
+		at.Os() << "Join Histogram using compact buckets" << std::endl;
+		phistJoinCompact->OsPrint(at.Os());
+	}
+
+	phistCompact1->Release();
+	phistCompact2->Release();
+	phistJoin->Release();
+	phistJoinCompact->Release();
+
+	if (!fEqual)
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
 //	helper method to generate a single join predicate
 DrgPstatspredjoin *
 CJoinCardinalityTest::PdrgpstatspredjoinSingleJoinPredicate
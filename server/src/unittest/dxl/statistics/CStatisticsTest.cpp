@@ -15,20 +15,28 @@
 
 #include <stdint.h>
 
+#include "gpos/common/CAutoRef.h"
+#include "gpos/common/CAutoRg.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
+#include "gpos/task/CAutoTaskProxy.h"
 
 #include "naucrates/statistics/CPoint.h"
 #include "naucrates/statistics/CBucket.h"
 #include "naucrates/statistics/CHistogram.h"
+#include "naucrates/statistics/CHLLSketch.h"
 #include "naucrates/statistics/CStatistics.h"
 #include "naucrates/statistics/CStatisticsUtils.h"
+#include "naucrates/statistics/CHistogramUtils.h"
+#include "naucrates/statistics/CStatsFilterCache.h"
+#include "naucrates/statistics/CStatsPredUtils.h"
 
 #include "naucrates/base/CDatumGenericGPDB.h"
 #include "naucrates/base/CDatumInt4GPDB.h"
 #include "naucrates/base/CDatumBoolGPDB.h"
 
 #include "gpopt/base/CQueryContext.h"
+#include "gpopt/engine/CStatisticsConfig.h"
 #include "gpopt/eval/CConstExprEvaluatorDefault.h"
 #include "gpopt/operators/CLogicalInnerJoin.h"
 #include "gpopt/operators/CScalarProjectElement.h"
@@ -102,7 +110,14 @@ CStatisticsTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CBucketDifference),
 		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CHistogramInt4),
 		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CHistogramBool),
+		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CHistogramCompact),
+		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CHistogramLike),
 		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CStatisticsBasic),
+		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CStatisticsShareHistograms),
+		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_DeriveHistogramsParallel),
+		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CStatisticsPruneHistograms),
+		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CHistogramCapBuckets),
+		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CStatsFilterCache),
 		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CStatisticsBasicsFromDXL),
 		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CStatisticsBasicsFromDXLNumeric),
 		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_UnionAll),
@@ -117,7 +132,9 @@ CStatisticsTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CStatisticsNestedPred),
 		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_SortInt4MCVs),
 		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_MergeHistMCV),
-		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CStatisticsAccumulateCard)
+		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CStatisticsAccumulateCard),
+		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CStatisticsMultiColumn),
+		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_CHLLSketch)
 		};
 
 	// tests that use separate optimization contexts
@@ -863,18 +880,18 @@ CStatisticsTest::EresUnittest_CHistogramInt4()
 	ppoint3->Release();
 	ppoint4->Release();
 	ppoint5->Release();
-	GPOS_DELETE(phist);
-	GPOS_DELETE(phist0);
-	GPOS_DELETE(phist1);
-	GPOS_DELETE(phist2);
-	GPOS_DELETE(phist3);
-	GPOS_DELETE(phist4);
-	GPOS_DELETE(phist5);
-	GPOS_DELETE(phist6);
-	GPOS_DELETE(phist7);
-	GPOS_DELETE(phist8);
-	GPOS_DELETE(phist9);
-	GPOS_DELETE(phist10);
+	phist->Release();
+	phist0->Release();
+	phist1->Release();
+	phist2->Release();
+	phist3->Release();
+	phist4->Release();
+	phist5->Release();
+	phist6->Release();
+	phist7->Release();
+	phist8->Release();
+	phist9->Release();
+	phist10->Release();
 
 	return GPOS_OK;
 }
@@ -911,8 +928,275 @@ CStatisticsTest::EresUnittest_CHistogramBool()
 
 	// clean up
 	ppoint1->Release();
-	GPOS_DELETE(phist);
-	GPOS_DELETE(phist1);
+	phist->Release();
+	phist1->Release();
+
+	return GPOS_OK;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsTest::EresUnittest_CHistogramCompact
+//
+//	@doc:
+//		Filtering a histogram using compact buckets must produce the same
+//		histogram as filtering using the bucket array
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CStatisticsTest::EresUnittest_CHistogramCompact()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// generate histogram of the form [0, 8), [10, 18), ... [190, 198), [200, 200]
+	// with gaps between buckets and tuples not covered by buckets
+	DrgPbucket *pdrgppbucket = GPOS_NEW(pmp) DrgPbucket(pmp);
+	for (ULONG ulIdx = 0; ulIdx < 20; ulIdx++)
+	{
+		INT iLower = INT(ulIdx * 10);
+		pdrgppbucket->Append(CCardinalityTestUtils::PbucketIntegerClosedLowerBound(pmp, iLower, iLower + 8, 0.04, 4.0));
+	}
+	pdrgppbucket->Append(CCardinalityTestUtils::PbucketIntegerClosedLowerBound(pmp, 200, 200, 0.05, 1.0));
+	CHistogram *phist = GPOS_NEW(pmp) CHistogram(pdrgppbucket, true, 0.05 /*dNullFreq*/, 5.0 /*dDistinctRemain*/, 0.1 /*dFreqRemain*/);
+
+	// compact buckets are built on a copy, the histogram itself is left unchanged
+	CHistogram *phistCompact = phist->PhistCompact(pmp);
+	GPOS_RTL_ASSERT(phist != phistCompact);
+	GPOS_RTL_ASSERT(NULL == phist->Pchist());
+	GPOS_RTL_ASSERT(NULL != phistCompact->Pchist());
+	GPOS_RTL_ASSERT(phist->UlBuckets() == phistCompact->Pchist()->UlBuckets());
+
+	// a histogram that has compact buckets already is returned as is
+	CHistogram *phistCompactAgain = phistCompact->PhistCompact(pmp);
+	GPOS_RTL_ASSERT(phistCompact == phistCompactAgain);
+	phistCompactAgain->Release();
+
+	CStatsPred::EStatsCmpType rgescmpt[] =
+		{
+		CStatsPred::EstatscmptEq,
+		CStatsPred::EstatscmptNEq,
+		CStatsPred::EstatscmptL,
+		CStatsPred::EstatscmptLEq,
+		CStatsPred::EstatscmptG,
+		CStatsPred::EstatscmptGEq,
+		CStatsPred::EstatscmptIDF,
+		CStatsPred::EstatscmptINDF
+		};
+
+	for (INT i = -5; i <= 205; i++)
+	{
+		CPoint *ppoint = CTestUtils::PpointInt4(pmp, i);
+		for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgescmpt); ul++)
+		{
+			CDouble dScaleFactor(0.0);
+			CDouble dScaleFactorCompact(0.0);
+			CHistogram *phistAfter = phist->PhistFilterNormalized(pmp, rgescmpt[ul], ppoint, &dScaleFactor);
+			CHistogram *phistAfterCompact = phistCompact->PhistFilterNormalized(pmp, rgescmpt[ul], ppoint, &dScaleFactorCompact);
+
+			GPOS_RTL_ASSERT(phistAfter->UlBuckets() == phistAfterCompact->UlBuckets());
+			GPOS_RTL_ASSERT(dScaleFactor == dScaleFactorCompact);
+			GPOS_RTL_ASSERT(phistAfter->DFrequency() == phistAfterCompact->DFrequency());
+			GPOS_RTL_ASSERT(phistAfter->DDistinct() == phistAfterCompact->DDistinct());
+
+			phistAfter->Release();
+			phistAfterCompact->Release();
+		}
+		ppoint->Release();
+	}
+
+	// normalizing changes bucket frequencies and discards compact buckets
+	(void) phistCompact->DNormalize();
+	GPOS_RTL_ASSERT(NULL == phistCompact->Pchist());
+
+	// clean up
+	phist->Release();
+	phistCompact->Release();
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsTest::PdatumText
+//
+//	@doc:
+//		Generate a text datum of the given string, preceded by the header
+//		of GPDB datums
+//
+//---------------------------------------------------------------------------
+IDatum *
+CStatisticsTest::PdatumText
+	(
+	IMemoryPool *pmp,
+	const CHAR *sz
+	)
+{
+	const ULONG ulLen = clib::UlStrLen(sz);
+	BYTE *pba = GPOS_NEW_ARRAY(pmp, BYTE, GPDB_DATUM_HDRSZ + ulLen);
+	(void) clib::PvMemSet(pba, 0, GPDB_DATUM_HDRSZ);
+	(void) clib::PvMemCpy(pba + GPDB_DATUM_HDRSZ, sz, ulLen);
+
+	IDatum *pdatum = GPOS_NEW(pmp) CDatumGenericGPDB
+									(
+									pmp,
+									GPOS_NEW(pmp) CMDIdGPDB(CMDIdGPDB::m_mdidText),
+									pba,
+									GPDB_DATUM_HDRSZ + ulLen,
+									false /* fNull */,
+									0 /* lValue */,
+									0 /* dValue */
+									);
+	GPOS_DELETE_ARRAY(pba);
+
+	return pdatum;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsTest::PbucketText
+//
+//	@doc:
+//		Generate a closed text bucket with the given bounds
+//
+//---------------------------------------------------------------------------
+CBucket *
+CStatisticsTest::PbucketText
+	(
+	IMemoryPool *pmp,
+	const CHAR *szLower,
+	const CHAR *szUpper,
+	CDouble dFrequency,
+	CDouble dDistinct
+	)
+{
+	CPoint *ppointLower = GPOS_NEW(pmp) CPoint(PdatumText(pmp, szLower));
+	CPoint *ppointUpper = GPOS_NEW(pmp) CPoint(PdatumText(pmp, szUpper));
+
+	return GPOS_NEW(pmp) CBucket(ppointLower, ppointUpper, true /* fLowerClosed */, true /* fUpperClosed */, dFrequency, dDistinct);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsTest::EresUnittest_CHistogramLike
+//
+//	@doc:
+//		LIKE filters match the most common values of a text histogram
+//		against the pattern and keep every range bucket with the default
+//		selectivity of the pattern
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CStatisticsTest::EresUnittest_CHistogramLike()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// pattern matching on datums
+	IDatum *pdatumValue = PdatumText(pmp, "log-50%");
+	IDatum *rgpdatumPattern[] =
+		{
+		PdatumText(pmp, "log-%"),
+		PdatumText(pmp, "%-5_\\%"),
+		PdatumText(pmp, "log-50"),
+		PdatumText(pmp, "log-_"),
+		PdatumText(pmp, "%"),
+		PdatumText(pmp, "m%"),
+		};
+	BOOL rgfMatch[] = {true, true, false, false, true, false};
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgpdatumPattern); ul++)
+	{
+		GPOS_RTL_ASSERT(rgfMatch[ul] == pdatumValue->FLikeMatch(rgpdatumPattern[ul]));
+		rgpdatumPattern[ul]->Release();
+	}
+	pdatumValue->Release();
+
+	// histogram with most common values as singletons and two range buckets
+	DrgPbucket *pdrgppbucket = GPOS_NEW(pmp) DrgPbucket(pmp);
+	pdrgppbucket->Append(PbucketText(pmp, "apple", "apple", 0.2, 1.0));
+	pdrgppbucket->Append(PbucketText(pmp, "banana", "banana", 0.1, 1.0));
+	pdrgppbucket->Append(PbucketText(pmp, "c", "d", 0.3, 30.0));
+	pdrgppbucket->Append(PbucketText(pmp, "log-a", "log-z", 0.2, 20.0));
+	pdrgppbucket->Append(PbucketText(pmp, "zebra", "zebra", 0.1, 1.0));
+	CHistogram *phist = GPOS_NEW(pmp) CHistogram(pdrgppbucket, true /* fWellDefined */, 0.1 /* dNullFreq */, 0.0 /* dDistinctRemain */, 0.0 /* dFreqRemain */);
+
+	// a prefix pattern drops the most common values it does not match, range
+	// buckets keep the default selectivity of the pattern
+	IDatum *pdatumPattern = PdatumText(pmp, "ban%");
+	GPOS_RTL_ASSERT(phist->FSupportsLikeFilter(pdatumPattern));
+	CDouble dScaleFactor(1.0);
+	CDouble dDefaultScaleFactor = pdatumPattern->DLikePredicateScaleFactor();
+	CHistogram *phistAfter = phist->PhistLikeFilterNormalized(pmp, pdatumPattern, dDefaultScaleFactor, &dScaleFactor);
+	CDouble dSelectivity = CDouble(0.1) + CDouble(0.5) / dDefaultScaleFactor;
+	GPOS_RTL_ASSERT((dScaleFactor - CDouble(1.0) / dSelectivity).FpAbs() < CStatistics::DEpsilon);
+	GPOS_RTL_ASSERT(3 == phistAfter->UlBuckets());
+	phistAfter->Release();
+	pdatumPattern->Release();
+
+	// a range bucket whose bounds share the prefix is not assumed to match
+	// completely, as values sorting between them need not have the prefix
+	pdatumPattern = PdatumText(pmp, "log-%");
+	dDefaultScaleFactor = pdatumPattern->DLikePredicateScaleFactor();
+	phistAfter = phist->PhistLikeFilterNormalized(pmp, pdatumPattern, dDefaultScaleFactor, &dScaleFactor);
+	dSelectivity = CDouble(0.5) / dDefaultScaleFactor;
+	GPOS_RTL_ASSERT((dScaleFactor - CDouble(1.0) / dSelectivity).FpAbs() < CStatistics::DEpsilon);
+	GPOS_RTL_ASSERT(2 == phistAfter->UlBuckets());
+	phistAfter->Release();
+	pdatumPattern->Release();
+
+	// without a prefix, range buckets get the default selectivity of the pattern
+	pdatumPattern = PdatumText(pmp, "%an%");
+	dDefaultScaleFactor = pdatumPattern->DLikePredicateScaleFactor();
+	phistAfter = phist->PhistLikeFilterNormalized(pmp, pdatumPattern, dDefaultScaleFactor, &dScaleFactor);
+	dSelectivity = CDouble(0.1) + CDouble(0.5) / dDefaultScaleFactor;
+	GPOS_RTL_ASSERT((dScaleFactor - CDouble(1.0) / dSelectivity).FpAbs() < CStatistics::DEpsilon);
+	phistAfter->Release();
+	pdatumPattern->Release();
+
+	phist->Release();
+
+	// most common values sorted in a case-insensitive collation order, which
+	// differs from their byte order; no bucket may be skipped
+	pdrgppbucket = GPOS_NEW(pmp) DrgPbucket(pmp);
+	pdrgppbucket->Append(PbucketText(pmp, "apple", "apple", 0.2, 1.0));
+	pdrgppbucket->Append(PbucketText(pmp, "banana", "banana", 0.2, 1.0));
+	pdrgppbucket->Append(PbucketText(pmp, "Cherry", "Cherry", 0.3, 1.0));
+	pdrgppbucket->Append(PbucketText(pmp, "date", "date", 0.2, 1.0));
+	phist = GPOS_NEW(pmp) CHistogram(pdrgppbucket, true /* fWellDefined */, 0.0 /* dNullFreq */, 10.0 /* dDistinctRemain */, 0.1 /* dFreqRemain */);
+
+	pdatumPattern = PdatumText(pmp, "ban%");
+	dDefaultScaleFactor = pdatumPattern->DLikePredicateScaleFactor();
+	phistAfter = phist->PhistLikeFilterNormalized(pmp, pdatumPattern, dDefaultScaleFactor, &dScaleFactor);
+	dSelectivity = CDouble(0.2) + CDouble(0.1) / dDefaultScaleFactor;
+	GPOS_RTL_ASSERT(1 == phistAfter->UlBuckets());
+	GPOS_RTL_ASSERT((dScaleFactor - CDouble(1.0) / dSelectivity).FpAbs() < CStatistics::DEpsilon);
+	phistAfter->Release();
+	pdatumPattern->Release();
+
+	phist->Release();
+
+	// range buckets whose bounds are in byte order; under a case-insensitive
+	// collation, values starting with 'B' sort between the lowercase bounds,
+	// so no range bucket may be dropped
+	pdrgppbucket = GPOS_NEW(pmp) DrgPbucket(pmp);
+	pdrgppbucket->Append(PbucketText(pmp, "a", "c", 0.5, 10.0));
+	pdrgppbucket->Append(PbucketText(pmp, "d", "f", 0.5, 10.0));
+	phist = GPOS_NEW(pmp) CHistogram(pdrgppbucket, true /* fWellDefined */, 0.0 /* dNullFreq */, 0.0 /* dDistinctRemain */, 0.0 /* dFreqRemain */);
+
+	pdatumPattern = PdatumText(pmp, "B%");
+	dDefaultScaleFactor = pdatumPattern->DLikePredicateScaleFactor();
+	phistAfter = phist->PhistLikeFilterNormalized(pmp, pdatumPattern, dDefaultScaleFactor, &dScaleFactor);
+	GPOS_RTL_ASSERT(2 == phistAfter->UlBuckets());
+	GPOS_RTL_ASSERT((dScaleFactor - dDefaultScaleFactor).FpAbs() < CStatistics::DEpsilon);
+	phistAfter->Release();
+	pdatumPattern->Release();
+
+	phist->Release();
 
 	return GPOS_OK;
 }
@@ -1676,6 +1960,729 @@ CStatisticsTest::EresUnittest_CStatisticsBasic()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsTest::EresUnittest_CStatisticsShareHistograms
+//
+//	@doc:
+//		Copied, scaled and re-mapped statistics share the histograms of the
+//		original statistics; capping NDVs after a filter copies a shared
+//		histogram before modifying it
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CStatisticsTest::EresUnittest_CStatisticsShareHistograms()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CColumnFactory *pcf = COptCtxt::PoctxtFromTLS()->Pcf();
+	const IMDTypeInt4 *pmdtypeint4 = COptCtxt::PoctxtFromTLS()->Pmda()->PtMDType<IMDTypeInt4>();
+
+	// two int4 columns with 37 distinct values each
+	HMUlHist *phmulhist = GPOS_NEW(pmp) HMUlHist(pmp);
+	phmulhist->FInsert(GPOS_NEW(pmp) ULONG(1), CCardinalityTestUtils::PhistExampleInt4(pmp));
+	phmulhist->FInsert(GPOS_NEW(pmp) ULONG(2), CCardinalityTestUtils::PhistExampleInt4(pmp));
+
+	HMUlDouble *phmuldoubleWidth = GPOS_NEW(pmp) HMUlDouble(pmp);
+	phmuldoubleWidth->FInsert(GPOS_NEW(pmp) ULONG(1), GPOS_NEW(pmp) CDouble(4.0));
+	phmuldoubleWidth->FInsert(GPOS_NEW(pmp) ULONG(2), GPOS_NEW(pmp) CDouble(4.0));
+
+	CStatistics *pstats = GPOS_NEW(pmp) CStatistics(pmp, phmulhist, phmuldoubleWidth, 1000.0 /* dRows */, false /* fEmpty */);
+	const CHistogram *phist1 = pstats->Phist(1);
+	CDouble dDistinct1 = phist1->DDistinct();
+
+	// copy and scale share histograms
+	CStatistics *pstatsCopy = CStatistics::PstatsConvert(pstats->PstatsCopy(pmp));
+	CStatistics *pstatsScaled = CStatistics::PstatsConvert(pstats->PstatsScale(pmp, CDouble(2.0)));
+	GPOS_RTL_ASSERT(phist1 == pstatsCopy->Phist(1));
+	GPOS_RTL_ASSERT(phist1 == pstatsScaled->Phist(1));
+	GPOS_RTL_ASSERT(pstatsScaled->DRows() == CDouble(2000.0));
+
+	// re-mapping column 1 to a new column shares its histogram under the new column id
+	CColRef *pcrNew = pcf->PcrCreate(pmdtypeint4);
+	HMUlCr *phmulcr = GPOS_NEW(pmp) HMUlCr(pmp);
+	(void) phmulcr->FInsert(GPOS_NEW(pmp) ULONG(1), pcrNew);
+	CStatistics *pstatsRemap = CStatistics::PstatsConvert(pstats->PstatsCopyWithRemap(pmp, phmulcr, true /*fMustExist*/));
+	GPOS_RTL_ASSERT(phist1 == pstatsRemap->Phist(pcrNew->UlId()));
+
+	// a filter on column 2 caps NDVs of column 1 in the output without modifying the input
+	CStatsPredPoint *pstatspred = GPOS_NEW(pmp) CStatsPredPoint(2, CStatsPred::EstatscmptEq, CTestUtils::PpointInt4(pmp, 5));
+	DrgPstatspred *pdrgpstatspred = GPOS_NEW(pmp) DrgPstatspred(pmp);
+	pdrgpstatspred->Append(pstatspred);
+	CStatsPredConj *pstatspredConj = GPOS_NEW(pmp) CStatsPredConj(pdrgpstatspred);
+	CStatistics *pstatsFilter = pstats->PstatsFilter(pmp, pstatspredConj, true /* fCapNdvs */);
+
+	const CHistogram *phist1Filter = pstatsFilter->Phist(1);
+	GPOS_RTL_ASSERT(pstatsFilter->DRows() < dDistinct1);
+	GPOS_RTL_ASSERT(phist1 != phist1Filter);
+	GPOS_RTL_ASSERT(phist1Filter->DDistinct() < dDistinct1);
+	GPOS_RTL_ASSERT(phist1->DDistinct() == dDistinct1);
+	GPOS_RTL_ASSERT(phist1 == pstatsCopy->Phist(1));
+
+	pstats->Release();
+	pstatsCopy->Release();
+	pstatsScaled->Release();
+	pstatsRemap->Release();
+	pstatsFilter->Release();
+	pstatspredConj->Release();
+	phmulcr->Release();
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsTest::EresUnittest_DeriveHistogramsParallel
+//
+//	@doc:
+//		Histograms derived on worker tasks must be identical to histograms
+//		derived serially
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CStatisticsTest::EresUnittest_DeriveHistogramsParallel()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	const ULONG ulHists = 200;
+	CAutoRef<CStatisticsConfig> a_pstatsconfSerial;
+	a_pstatsconfSerial = GPOS_NEW(pmp) CStatisticsConfig(pmp, 0.75, 0.01, 0.75, ULONG_MAX /*ulParallelHistogramsThreshold*/);
+	CAutoRef<CStatisticsConfig> a_pstatsconfParallel;
+	a_pstatsconfParallel = GPOS_NEW(pmp) CStatisticsConfig(pmp, 0.75, 0.01, 0.75, 1 /*ulParallelHistogramsThreshold*/);
+
+	CAutoRg<CHistogram *> a_rgphistInput;
+	a_rgphistInput = GPOS_NEW_ARRAY(pmp, CHistogram *, ulHists);
+	CAutoRg<CHistogram *> a_rgphistSerial;
+	a_rgphistSerial = GPOS_NEW_ARRAY(pmp, CHistogram *, ulHists);
+	CAutoRg<CHistogram *> a_rgphistParallel;
+	a_rgphistParallel = GPOS_NEW_ARRAY(pmp, CHistogram *, ulHists);
+
+	for (ULONG ul = 0; ul < ulHists; ul++)
+	{
+		a_rgphistInput[ul] = CCardinalityTestUtils::PhistExampleInt4(pmp);
+	}
+
+	// group by
+	CHistogramUtils::DeriveHistograms(pmp, a_pstatsconfSerial.Pt(), CHistogramUtils::EhopGroupBy, 1000.0, ulHists, a_rgphistInput.Rgt(), a_rgphistSerial.Rgt());
+	CHistogramUtils::DeriveHistograms(pmp, a_pstatsconfParallel.Pt(), CHistogramUtils::EhopGroupBy, 1000.0, ulHists, a_rgphistInput.Rgt(), a_rgphistParallel.Rgt());
+	for (ULONG ul = 0; ul < ulHists; ul++)
+	{
+		GPOS_RTL_ASSERT(a_rgphistSerial[ul]->UlBuckets() == a_rgphistParallel[ul]->UlBuckets());
+		GPOS_RTL_ASSERT(a_rgphistSerial[ul]->DDistinct() == a_rgphistParallel[ul]->DDistinct());
+		GPOS_RTL_ASSERT(a_rgphistSerial[ul]->DFrequency() == a_rgphistParallel[ul]->DFrequency());
+
+		a_rgphistParallel[ul]->Release();
+	}
+
+	// a task running on a pool worker derives the histograms itself instead
+	// of waiting for nested tasks
+	CAutoRg<CHistogram *> a_rgphistNested;
+	a_rgphistNested = GPOS_NEW_ARRAY(pmp, CHistogram *, ulHists);
+	SDeriveHistogramsTaskArg dharg = {pmp, a_pstatsconfParallel.Pt(), ulHists, a_rgphistInput.Rgt(), a_rgphistNested.Rgt()};
+	{
+		CAutoTaskProxy atp(pmp, CWorkerPoolManager::Pwpm());
+		CTask *ptsk = atp.PtskCreate(PvDeriveHistograms, &dharg);
+		atp.Schedule(ptsk);
+		atp.Wait(ptsk);
+	}
+
+	for (ULONG ul = 0; ul < ulHists; ul++)
+	{
+		GPOS_RTL_ASSERT(a_rgphistSerial[ul]->UlBuckets() == a_rgphistNested[ul]->UlBuckets());
+		GPOS_RTL_ASSERT(a_rgphistSerial[ul]->DDistinct() == a_rgphistNested[ul]->DDistinct());
+		GPOS_RTL_ASSERT(a_rgphistSerial[ul]->DFrequency() == a_rgphistNested[ul]->DFrequency());
+
+		a_rgphistSerial[ul]->Release();
+		a_rgphistNested[ul]->Release();
+	}
+
+	// capping NDVs copies the shared histograms and caps the others in place
+	const CDouble dDistinct = a_rgphistInput[0]->DDistinct();
+	const CDouble dRows = dDistinct / 4;
+	for (ULONG ul = 0; ul < ulHists; ul += 2)
+	{
+		a_rgphistInput[ul]->AddRef();
+	}
+
+	CHistogramUtils::DeriveHistograms(pmp, a_pstatsconfParallel.Pt(), CHistogramUtils::EhopCapNDVs, dRows, ulHists, a_rgphistInput.Rgt(), a_rgphistParallel.Rgt());
+	const CDouble dDistinctCapped = a_rgphistParallel[0]->DDistinct();
+	for (ULONG ul = 0; ul < ulHists; ul++)
+	{
+		BOOL fShared = (0 == ul % 2);
+		GPOS_RTL_ASSERT(fShared == (a_rgphistInput[ul] != a_rgphistParallel[ul]));
+		GPOS_RTL_ASSERT(fShared == (dDistinct == a_rgphistInput[ul]->DDistinct()));
+		GPOS_RTL_ASSERT(a_rgphistParallel[ul]->DDistinct() < dDistinct);
+		GPOS_RTL_ASSERT(dDistinctCapped == a_rgphistParallel[ul]->DDistinct());
+
+		a_rgphistParallel[ul]->Release();
+		if (fShared)
+		{
+			a_rgphistInput[ul]->Release();
+		}
+		a_rgphistInput[ul]->Release();
+	}
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsTest::PvDeriveHistograms
+//
+//	@doc:
+//		Worker task function grouping histograms by
+//
+//---------------------------------------------------------------------------
+void *
+CStatisticsTest::PvDeriveHistograms
+	(
+	void *pv
+	)
+{
+	SDeriveHistogramsTaskArg *pdharg = reinterpret_cast<SDeriveHistogramsTaskArg *>(pv);
+	CHistogramUtils::DeriveHistograms
+		(
+		pdharg->m_pmp,
+		pdharg->m_pstatsconf,
+		CHistogramUtils::EhopGroupBy,
+		1000.0,
+		pdharg->m_ulHists,
+		pdharg->m_rgphistInput,
+		pdharg->m_rgphistOutput
+		);
+
+	return NULL;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsTest::EresUnittest_CStatisticsPruneHistograms
+//
+//	@doc:
+//		Pruning statistics keeps histograms of the given columns and widths
+//		of all columns
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CStatisticsTest::EresUnittest_CStatisticsPruneHistograms()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CColumnFactory *pcf = COptCtxt::PoctxtFromTLS()->Pcf();
+	const IMDTypeInt4 *pmdtypeint4 = COptCtxt::PoctxtFromTLS()->Pmda()->PtMDType<IMDTypeInt4>();
+	CColRef *pcr1 = pcf->PcrCreate(pmdtypeint4);
+	CColRef *pcr2 = pcf->PcrCreate(pmdtypeint4);
+
+	HMUlHist *phmulhist = GPOS_NEW(pmp) HMUlHist(pmp);
+	phmulhist->FInsert(GPOS_NEW(pmp) ULONG(pcr1->UlId()), CCardinalityTestUtils::PhistExampleInt4(pmp));
+	phmulhist->FInsert(GPOS_NEW(pmp) ULONG(pcr2->UlId()), CCardinalityTestUtils::PhistExampleInt4(pmp));
+
+	HMUlDouble *phmuldoubleWidth = GPOS_NEW(pmp) HMUlDouble(pmp);
+	phmuldoubleWidth->FInsert(GPOS_NEW(pmp) ULONG(pcr1->UlId()), GPOS_NEW(pmp) CDouble(4.0));
+	phmuldoubleWidth->FInsert(GPOS_NEW(pmp) ULONG(pcr2->UlId()), GPOS_NEW(pmp) CDouble(4.0));
+
+	CStatistics *pstats = GPOS_NEW(pmp) CStatistics(pmp, phmulhist, phmuldoubleWidth, 1000.0 /* dRows */, false /* fEmpty */);
+
+	CColRefSet *pcrsHist = GPOS_NEW(pmp) CColRefSet(pmp);
+	pcrsHist->Include(pcr1);
+	CStatistics *pstatsPruned = CStatistics::PstatsConvert(pstats->PstatsPruneHistograms(pmp, pcrsHist));
+
+	GPOS_RTL_ASSERT(pstats->Phist(pcr1->UlId()) == pstatsPruned->Phist(pcr1->UlId()));
+	GPOS_RTL_ASSERT(NULL == pstatsPruned->Phist(pcr2->UlId()));
+	GPOS_RTL_ASSERT(NULL != pstatsPruned->PdWidth(pcr2->UlId()));
+	GPOS_RTL_ASSERT(pstats->DWidth() == pstatsPruned->DWidth());
+	GPOS_RTL_ASSERT(pstats->DRows() == pstatsPruned->DRows());
+
+	pcrsHist->Release();
+	pstatsPruned->Release();
+	pstats->Release();
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsTest::EresUnittest_CHistogramCapBuckets
+//
+//	@doc:
+//		Capping the number of buckets preserves frequency and NDVs, and the
+//		selectivity of range predicates changes at most by the returned bound
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CStatisticsTest::EresUnittest_CHistogramCapBuckets()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// buckets [10i, 10i + 10) whose frequencies repeat in runs of 8 buckets
+	const ULONG ulBuckets = 400;
+	DrgPbucket *pdrgppbucket = GPOS_NEW(pmp) DrgPbucket(pmp);
+	for (ULONG ul = 0; ul < ulBuckets; ul++)
+	{
+		CDouble dFrequency = CDouble(1 + (ul / 8) % 4) / (2.5 * ulBuckets);
+		pdrgppbucket->Append(CCardinalityTestUtils::PbucketIntegerClosedLowerBound(pmp, 10 * ul, 10 * ul + 10, dFrequency, 10.0));
+	}
+	CHistogram *phist = GPOS_NEW(pmp) CHistogram(pdrgppbucket);
+
+	// fewer buckets than the budget
+	CHistogram *phistCopy = phist->PhistCopy(pmp);
+	GPOS_RTL_ASSERT(CDouble(0.0) == phistCopy->DCapBuckets(pmp, ulBuckets));
+	GPOS_RTL_ASSERT(ulBuckets == phistCopy->UlBuckets());
+	phistCopy->Release();
+
+	// merging runs of buckets with equal frequencies misplaces no frequency
+	phistCopy = phist->PhistCopy(pmp);
+	GPOS_RTL_ASSERT(CStatistics::DEpsilon > phistCopy->DCapBuckets(pmp, ulBuckets / 8));
+	GPOS_RTL_ASSERT(ulBuckets / 8 == phistCopy->UlBuckets());
+	phistCopy->Release();
+
+	const ULONG rgulMaxBuckets[] = {40, 10, 4, 1};
+	const INT rgiConst[] = {5, 125, 1003, 2401, 3999};
+	CDouble dErrorPrev(0.0);
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgulMaxBuckets); ul++)
+	{
+		phistCopy = phist->PhistCopy(pmp);
+		CDouble dError = phistCopy->DCapBuckets(pmp, rgulMaxBuckets[ul]);
+
+		GPOS_RTL_ASSERT(rgulMaxBuckets[ul] == phistCopy->UlBuckets());
+		GPOS_RTL_ASSERT(CStatistics::DEpsilon > (phist->DFrequency() - phistCopy->DFrequency()).FpAbs());
+		GPOS_RTL_ASSERT(CStatistics::DEpsilon > (phist->DDistinct() - phistCopy->DDistinct()).FpAbs());
+
+		// smaller budgets continue the same sequence of merges
+		GPOS_RTL_ASSERT(dErrorPrev <= dError);
+		dErrorPrev = dError;
+
+		for (ULONG ulConst = 0; ulConst < GPOS_ARRAY_SIZE(rgiConst); ulConst++)
+		{
+			CPoint *ppoint = CTestUtils::PpointInt4(pmp, rgiConst[ulConst]);
+			CHistogram *phistFilter = phist->PhistFilter(pmp, CStatsPred::EstatscmptL, ppoint);
+			CHistogram *phistFilterCapped = phistCopy->PhistFilter(pmp, CStatsPred::EstatscmptL, ppoint);
+
+			GPOS_RTL_ASSERT((phistFilter->DFrequency() - phistFilterCapped->DFrequency()).FpAbs() <= dError + CStatistics::DEpsilon);
+
+			phistFilter->Release();
+			phistFilterCapped->Release();
+			ppoint->Release();
+		}
+
+		phistCopy->Release();
+	}
+
+	// shared histograms are copied before capping
+	CAutoRef<CStatisticsConfig> a_pstatsconf;
+	a_pstatsconf = GPOS_NEW(pmp) CStatisticsConfig
+								(
+								pmp,
+								0.75,
+								0.01,
+								0.75,
+								CStatisticsConfig::ulParallelHistogramsThresholdDefault,
+								50 /*ulMaxHistogramBuckets*/
+								);
+	phist->AddRef();
+	CHistogram *phistCapped = CHistogramUtils::PhistCapBuckets(pmp, a_pstatsconf.Pt(), phist);
+	GPOS_RTL_ASSERT(phist != phistCapped);
+	GPOS_RTL_ASSERT(ulBuckets == phist->UlBuckets());
+	GPOS_RTL_ASSERT(50 == phistCapped->UlBuckets());
+
+	phistCapped->Release();
+	phist->Release();
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsTest::EresUnittest_CStatsFilterCache
+//
+//	@doc:
+//		Filters identical to a cached filter on the same input statistics
+//		return the cached statistics
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CStatisticsTest::EresUnittest_CStatsFilterCache()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	HMUlHist *phmulhist = GPOS_NEW(pmp) HMUlHist(pmp);
+	phmulhist->FInsert(GPOS_NEW(pmp) ULONG(1), CCardinalityTestUtils::PhistExampleInt4(pmp));
+	phmulhist->FInsert(GPOS_NEW(pmp) ULONG(2), CCardinalityTestUtils::PhistExampleInt4(pmp));
+
+	HMUlDouble *phmuldoubleWidth = GPOS_NEW(pmp) HMUlDouble(pmp);
+	phmuldoubleWidth->FInsert(GPOS_NEW(pmp) ULONG(1), GPOS_NEW(pmp) CDouble(4.0));
+	phmuldoubleWidth->FInsert(GPOS_NEW(pmp) ULONG(2), GPOS_NEW(pmp) CDouble(4.0));
+
+	CStatistics *pstats = GPOS_NEW(pmp) CStatistics(pmp, phmulhist, phmuldoubleWidth, 1000.0 /* dRows */, false /* fEmpty */);
+
+	// two identical filters (col2 = 5 AND col1 < 20) with their components in
+	// different order, and a filter with a different constant
+	INT rgiConst[] = {20, 20, 30};
+	CStatsPred *rgpstatspred[GPOS_ARRAY_SIZE(rgiConst)];
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgiConst); ul++)
+	{
+		CStatsPred *pstatspredEq = GPOS_NEW(pmp) CStatsPredPoint(2, CStatsPred::EstatscmptEq, CTestUtils::PpointInt4(pmp, 5));
+		CStatsPred *pstatspredL = GPOS_NEW(pmp) CStatsPredPoint(1, CStatsPred::EstatscmptL, CTestUtils::PpointInt4(pmp, rgiConst[ul]));
+
+		DrgPstatspred *pdrgpstatspred = GPOS_NEW(pmp) DrgPstatspred(pmp);
+		if (0 == ul)
+		{
+			pdrgpstatspred->Append(pstatspredEq);
+			pdrgpstatspred->Append(pstatspredL);
+		}
+		else
+		{
+			pdrgpstatspred->Append(pstatspredL);
+			pdrgpstatspred->Append(pstatspredEq);
+		}
+		rgpstatspred[ul] = GPOS_NEW(pmp) CStatsPredConj(pdrgpstatspred);
+	}
+
+	CStatsFilterCache *pstatsfcache = GPOS_NEW(pmp) CStatsFilterCache(pmp);
+	IStatistics *pstats0 = pstatsfcache->PstatsFilter(pmp, pstats, rgpstatspred[0], true /* fCapNdvs */);
+	IStatistics *pstats1 = pstatsfcache->PstatsFilter(pmp, pstats, rgpstatspred[1], true /* fCapNdvs */);
+	IStatistics *pstats2 = pstatsfcache->PstatsFilter(pmp, pstats, rgpstatspred[2], true /* fCapNdvs */);
+	IStatistics *pstats3 = pstatsfcache->PstatsFilter(pmp, pstats, rgpstatspred[0], false /* fCapNdvs */);
+
+	// components are sorted on column ids when filters are looked up
+	GPOS_RTL_ASSERT(CStatsPredUtils::FEqual(rgpstatspred[0], rgpstatspred[1]));
+	GPOS_RTL_ASSERT(CStatsPredUtils::UlHash(rgpstatspred[0]) == CStatsPredUtils::UlHash(rgpstatspred[1]));
+	GPOS_RTL_ASSERT(!CStatsPredUtils::FEqual(rgpstatspred[0], rgpstatspred[2]));
+
+	GPOS_RTL_ASSERT(pstats0->DRows() == pstats1->DRows());
+	GPOS_RTL_ASSERT(pstats0->DRows() == pstats3->DRows());
+	GPOS_RTL_ASSERT(4 == pstatsfcache->UlpLookups());
+	GPOS_RTL_ASSERT(1 == pstatsfcache->UlpHits());
+	GPOS_RTL_ASSERT(3 == pstatsfcache->UlEntries());
+
+	// callers get their own copies, so setting the estimation risk of one
+	// does not affect the others
+	pstats0->SetStatsEstimationRisk(7);
+	IStatistics *pstats4 = pstatsfcache->PstatsFilter(pmp, pstats, rgpstatspred[0], true /* fCapNdvs */);
+	GPOS_RTL_ASSERT(pstats0 != pstats1);
+	GPOS_RTL_ASSERT(7 != pstats1->UlStatsEstimationRisk());
+	GPOS_RTL_ASSERT(7 != pstats4->UlStatsEstimationRisk());
+
+	// counters can be reset, e.g., for each search stage
+	pstatsfcache->ResetCounters();
+	GPOS_RTL_ASSERT(0 == pstatsfcache->UlpLookups());
+	GPOS_RTL_ASSERT(0 == pstatsfcache->UlpHits());
+
+	pstats0->Release();
+	pstats1->Release();
+	pstats2->Release();
+	pstats3->Release();
+	pstats4->Release();
+	GPOS_DELETE(pstatsfcache);
+
+	// a full cache derives further filters without caching them
+	pstatsfcache = GPOS_NEW(pmp) CStatsFilterCache(pmp, 1 /* ulMaxEntries */);
+	pstats0 = pstatsfcache->PstatsFilter(pmp, pstats, rgpstatspred[0], true /* fCapNdvs */);
+	pstats2 = pstatsfcache->PstatsFilter(pmp, pstats, rgpstatspred[2], true /* fCapNdvs */);
+	pstats3 = pstatsfcache->PstatsFilter(pmp, pstats, rgpstatspred[2], true /* fCapNdvs */);
+	GPOS_RTL_ASSERT(1 == pstatsfcache->UlEntries());
+	GPOS_RTL_ASSERT(0 == pstatsfcache->UlpHits());
+
+	pstats0->Release();
+	pstats2->Release();
+	pstats3->Release();
+	GPOS_DELETE(pstatsfcache);
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgiConst); ul++)
+	{
+		rgpstatspred[ul]->Release();
+	}
+	pstats->Release();
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsTest::PstatsMultiColumn
+//
+//	@doc:
+//		Generate statistics on two columns with identical histograms and,
+//		optionally, multi-column statistics on both columns
+//
+//---------------------------------------------------------------------------
+CStatistics *
+CStatisticsTest::PstatsMultiColumn
+	(
+	IMemoryPool *pmp,
+	ULONG ulColId1,
+	ULONG ulColId2,
+	BOOL fMultiColumn,
+	CDouble dDependency
+	)
+{
+	HMUlHist *phmulhist = GPOS_NEW(pmp) HMUlHist(pmp);
+	phmulhist->FInsert(GPOS_NEW(pmp) ULONG(ulColId1), CCardinalityTestUtils::PhistExampleInt4(pmp));
+	phmulhist->FInsert(GPOS_NEW(pmp) ULONG(ulColId2), CCardinalityTestUtils::PhistExampleInt4(pmp));
+
+	HMUlDouble *phmuldoubleWidth = GPOS_NEW(pmp) HMUlDouble(pmp);
+	phmuldoubleWidth->FInsert(GPOS_NEW(pmp) ULONG(ulColId1), GPOS_NEW(pmp) CDouble(4.0));
+	phmuldoubleWidth->FInsert(GPOS_NEW(pmp) ULONG(ulColId2), GPOS_NEW(pmp) CDouble(4.0));
+
+	CStatistics *pstats = GPOS_NEW(pmp) CStatistics(pmp, phmulhist, phmuldoubleWidth, 1000.0 /* dRows */, false /* fEmpty */);
+	if (fMultiColumn)
+	{
+		DrgPul *pdrgpulColId = GPOS_NEW(pmp) DrgPul(pmp);
+		pdrgpulColId->Append(GPOS_NEW(pmp) ULONG(ulColId1));
+		pdrgpulColId->Append(GPOS_NEW(pmp) ULONG(ulColId2));
+		pstats->AddMultiColumnStats(GPOS_NEW(pmp) CMultiColumnStats(pmp, pdrgpulColId, 40.0 /* dDistinct */, dDependency));
+	}
+
+	return pstats;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsTest::EresUnittest_CStatisticsMultiColumn
+//
+//	@doc:
+//		Multi-column statistics correct the estimates of grouping, filters
+//		and joins on correlated columns
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CStatisticsTest::EresUnittest_CStatisticsMultiColumn()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CStatisticsConfig *pstatsconf = CStatisticsConfig::PstatsconfDefault(pmp);
+
+	CStatistics *pstats = PstatsMultiColumn(pmp, 1, 2, true /* fMultiColumn */, 1.0 /* dDependency */);
+	CStatistics *pstatsNoMC = PstatsMultiColumn(pmp, 1, 2, false /* fMultiColumn */, 0.0 /* dDependency */);
+
+	// the number of distinct value combinations is taken from the multi-column statistics
+	DrgPul *pdrgpulColId = GPOS_NEW(pmp) DrgPul(pmp);
+	pdrgpulColId->Append(GPOS_NEW(pmp) ULONG(1));
+	pdrgpulColId->Append(GPOS_NEW(pmp) ULONG(2));
+	CDouble dNdv = CStatisticsUtils::DNdvCombinations(pmp, pstatsconf, pstats, pdrgpulColId);
+	CDouble dNdvNoMC = CStatisticsUtils::DNdvCombinations(pmp, pstatsconf, pstatsNoMC, pdrgpulColId);
+	GPOS_RTL_ASSERT(CDouble(40.0) == dNdv);
+	GPOS_RTL_ASSERT(dNdv < dNdvNoMC);
+	pdrgpulColId->Release();
+
+	// col2 is fully determined by col1, so (col1 = 5 AND col2 = 5) is as selective as col1 = 5
+	DrgPstatspred *pdrgpstatspredConj = GPOS_NEW(pmp) DrgPstatspred(pmp);
+	pdrgpstatspredConj->Append(GPOS_NEW(pmp) CStatsPredPoint(1, CStatsPred::EstatscmptEq, CTestUtils::PpointInt4(pmp, 5)));
+	pdrgpstatspredConj->Append(GPOS_NEW(pmp) CStatsPredPoint(2, CStatsPred::EstatscmptEq, CTestUtils::PpointInt4(pmp, 5)));
+	CStatsPred *pstatspredConj = GPOS_NEW(pmp) CStatsPredConj(pdrgpstatspredConj);
+
+	DrgPstatspred *pdrgpstatspredSingle = GPOS_NEW(pmp) DrgPstatspred(pmp);
+	pdrgpstatspredSingle->Append(GPOS_NEW(pmp) CStatsPredPoint(1, CStatsPred::EstatscmptEq, CTestUtils::PpointInt4(pmp, 5)));
+	CStatsPred *pstatspredSingle = GPOS_NEW(pmp) CStatsPredConj(pdrgpstatspredSingle);
+
+	IStatistics *pstatsConj = pstats->PstatsFilter(pmp, pstatspredConj, true /* fCapNdvs */);
+	IStatistics *pstatsConjNoMC = pstatsNoMC->PstatsFilter(pmp, pstatspredConj, true /* fCapNdvs */);
+	IStatistics *pstatsSingle = pstats->PstatsFilter(pmp, pstatspredSingle, true /* fCapNdvs */);
+	GPOS_RTL_ASSERT(pstatsConj->DRows() == pstatsSingle->DRows());
+	GPOS_RTL_ASSERT(pstatsConjNoMC->DRows() < pstatsConj->DRows());
+
+	// multi-column statistics are kept by derived statistics
+	GPOS_RTL_ASSERT(1 == CStatistics::PstatsConvert(pstatsConj)->Pdrgpmcstats()->UlLength());
+
+	// the join on both correlated columns matches as many rows as there are
+	// distinct value combinations
+	CStatistics *pstatsInner = PstatsMultiColumn(pmp, 3, 4, true /* fMultiColumn */, 0.0 /* dDependency */);
+	CStatistics *pstatsInnerNoMC = PstatsMultiColumn(pmp, 3, 4, false /* fMultiColumn */, 0.0 /* dDependency */);
+	DrgPstatspredjoin *pdrgpstatspredjoin = GPOS_NEW(pmp) DrgPstatspredjoin(pmp);
+	pdrgpstatspredjoin->Append(GPOS_NEW(pmp) CStatsPredJoin(1, CStatsPred::EstatscmptEq, 3));
+	pdrgpstatspredjoin->Append(GPOS_NEW(pmp) CStatsPredJoin(2, CStatsPred::EstatscmptEq, 4));
+
+	IStatistics *pstatsJoin = pstats->PstatsInnerJoin(pmp, pstatsInner, pdrgpstatspredjoin);
+	IStatistics *pstatsJoinNoMC = pstatsNoMC->PstatsInnerJoin(pmp, pstatsInnerNoMC, pdrgpstatspredjoin);
+	GPOS_RTL_ASSERT(pstatsJoinNoMC->DRows() < pstatsJoin->DRows());
+	GPOS_RTL_ASSERT(2 == CStatistics::PstatsConvert(pstatsJoin)->Pdrgpmcstats()->UlLength());
+
+	// clean up
+	pstatsJoin->Release();
+	pstatsJoinNoMC->Release();
+	pdrgpstatspredjoin->Release();
+	pstatsInner->Release();
+	pstatsInnerNoMC->Release();
+	pstatsConj->Release();
+	pstatsConjNoMC->Release();
+	pstatsSingle->Release();
+	pstatspredConj->Release();
+	pstatspredSingle->Release();
+	pstats->Release();
+	pstatsNoMC->Release();
+	pstatsconf->Release();
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsTest::PhllSequence
+//
+//	@doc:
+//		Generate a sketch of the integers in the given range the way the
+//		host computes it: the leading bits of the hash of a value select
+//		a register, which keeps the maximum rank of the first set bit in
+//		the remaining bits
+//
+//---------------------------------------------------------------------------
+CHLLSketch *
+CStatisticsTest::PhllSequence
+	(
+	IMemoryPool *pmp,
+	ULONG ulPrecision,
+	ULONG ulFirst,
+	ULONG ulLast
+	)
+{
+	const ULONG ulRegisters = 1 << ulPrecision;
+	BYTE *pbaRegisters = GPOS_NEW_ARRAY(pmp, BYTE, ulRegisters);
+	for (ULONG ul = 0; ul < ulRegisters; ul++)
+	{
+		pbaRegisters[ul] = 0;
+	}
+
+	for (ULONG ulVal = ulFirst; ulVal <= ulLast; ulVal++)
+	{
+		// splitmix64 finalizer
+		ULLONG ullHash = (ULLONG) ulVal + 0x9E3779B97F4A7C15ULL;
+		ullHash = (ullHash ^ (ullHash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		ullHash = (ullHash ^ (ullHash >> 27)) * 0x94D049BB133111EBULL;
+		ullHash = ullHash ^ (ullHash >> 31);
+
+		ULONG ulRegister = (ULONG) (ullHash >> (64 - ulPrecision));
+		ULLONG ullRest = ullHash << ulPrecision;
+		ULONG ulRank = 1;
+		while (ulRank <= 64 - ulPrecision && 0 == (ullRest & (((ULLONG) 1) << 63)))
+		{
+			ullRest = ullRest << 1;
+			ulRank++;
+		}
+
+		if (pbaRegisters[ulRegister] < ulRank)
+		{
+			pbaRegisters[ulRegister] = (BYTE) ulRank;
+		}
+	}
+
+	return GPOS_NEW(pmp) CHLLSketch(ulPrecision, pbaRegisters);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsTest::EresUnittest_CHLLSketch
+//
+//	@doc:
+//		Sketches estimate the number of distinct values of a column, and
+//		merged sketches that of the union of columns, which union all uses
+//		instead of guessing how many values its inputs share
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CStatisticsTest::EresUnittest_CHLLSketch()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// two overlapping ranges of 1000 values each
+	CHLLSketch *phll1 = PhllSequence(pmp, 12 /* ulPrecision */, 0, 999);
+	CHLLSketch *phll2 = PhllSequence(pmp, 12 /* ulPrecision */, 500, 1499);
+	GPOS_RTL_ASSERT(900.0 < phll1->DDistinct().DVal() && 1100.0 > phll1->DDistinct().DVal());
+	GPOS_RTL_ASSERT(900.0 < phll2->DDistinct().DVal() && 1100.0 > phll2->DDistinct().DVal());
+
+	CHLLSketch *phllMerged = phll1->PhllMerge(pmp, phll2);
+	GPOS_RTL_ASSERT(NULL != phllMerged);
+	GPOS_RTL_ASSERT(1350.0 < phllMerged->DDistinct().DVal() && 1650.0 > phllMerged->DDistinct().DVal());
+
+	// sketches of different precisions cannot be merged
+	CHLLSketch *phllCoarse = PhllSequence(pmp, 10 /* ulPrecision */, 0, 999);
+	GPOS_RTL_ASSERT(NULL == phll1->PhllMerge(pmp, phllCoarse));
+	phllCoarse->Release();
+
+	// union all takes the number of distinct values from the merged sketches
+	CStatistics *pstats1 = PstatsMultiColumn(pmp, 1, 2, false /* fMultiColumn */, 0.0 /* dDependency */);
+	CStatistics *pstats2 = PstatsMultiColumn(pmp, 3, 4, false /* fMultiColumn */, 0.0 /* dDependency */);
+	pstats1->AddHLLSketch(pmp, 1, phll1);
+	pstats2->AddHLLSketch(pmp, 3, phll2);
+
+	DrgPul *pdrgpulOutput = GPOS_NEW(pmp) DrgPul(pmp);
+	pdrgpulOutput->Append(GPOS_NEW(pmp) ULONG(5));
+	DrgPul *pdrgpulInput1 = GPOS_NEW(pmp) DrgPul(pmp);
+	pdrgpulInput1->Append(GPOS_NEW(pmp) ULONG(1));
+	DrgPul *pdrgpulInput2 = GPOS_NEW(pmp) DrgPul(pmp);
+	pdrgpulInput2->Append(GPOS_NEW(pmp) ULONG(3));
+
+	CStatistics *pstatsUnionAll = pstats1->PstatsUnionAll(pmp, pstats2, pdrgpulOutput, pdrgpulInput1, pdrgpulInput2);
+	const CHistogram *phistOutput = pstatsUnionAll->Phist(5);
+	GPOS_RTL_ASSERT(NULL != pstatsUnionAll->Phll(5));
+	GPOS_RTL_ASSERT(phllMerged->DDistinct() == pstatsUnionAll->Phll(5)->DDistinct());
+
+	CDouble dDistinctError = (phistOutput->DDistinct() - phllMerged->DDistinct()).FpAbs();
+	GPOS_RTL_ASSERT(dDistinctError < CDouble(0.05) * phllMerged->DDistinct());
+
+	// sketches are kept by copies and scaling up, but dropped when scaling
+	// down since rows removed may take values with them
+	IStatistics *pstatsCopy = pstats1->PstatsCopy(pmp);
+	IStatistics *pstatsScaledUp = pstats1->PstatsScale(pmp, CDouble(2.0));
+	IStatistics *pstatsScaledDown = pstats1->PstatsScale(pmp, CDouble(1.0) / pstats1->DRows());
+	GPOS_RTL_ASSERT(NULL != CStatistics::PstatsConvert(pstatsCopy)->Phll(1));
+	GPOS_RTL_ASSERT(NULL != CStatistics::PstatsConvert(pstatsScaledUp)->Phll(1));
+	GPOS_RTL_ASSERT(NULL == CStatistics::PstatsConvert(pstatsScaledDown)->Phll(1));
+	pstatsCopy->Release();
+	pstatsScaledUp->Release();
+	pstatsScaledDown->Release();
+
+	// scaling NDVs of an integer histogram never puts more NDVs in a bucket
+	// than there are integers in its range
+	CHistogram *phistInt4 = CCardinalityTestUtils::PhistExampleInt4(pmp);
+	phistInt4->ScaleNDVs(CDouble(1000.0));
+	const ULONG ulBuckets = phistInt4->UlBuckets();
+	for (ULONG ul = 0; ul < ulBuckets; ul++)
+	{
+		const CBucket *pbucket = (*phistInt4->Pdrgpbucket())[ul];
+		CDouble dValues = pbucket->FSingleton() ? CDouble(1.0) : pbucket->DWidth();
+		GPOS_RTL_ASSERT(pbucket->DDistinct() <= dValues);
+	}
+
+	// base table histograms build their compact buckets after scaling, as
+	// scaling drops them
+	phistInt4->BuildCompact(pmp);
+	GPOS_RTL_ASSERT(NULL != phistInt4->Pchist() || CHistogram::UlMinBucketsCompact > ulBuckets);
+	phistInt4->ScaleNDVs(CDouble(500.0));
+	GPOS_RTL_ASSERT(NULL == phistInt4->Pchist());
+	phistInt4->Release();
+
+	// clean up
+	pstatsUnionAll->Release();
+	pstats1->Release();
+	pstats2->Release();
+	phllMerged->Release();
+
+	return GPOS_OK;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CStatisticsTest::PdrgpstatspredInteger
@@ -2470,7 +3477,7 @@ CStatisticsTest::EresUnittest_CHistogramValid()
 	CHistogram *phist =  GPOS_NEW(pmp) CHistogram(pdrgppbucket);
 
 	// create an auto object
-	CAutoP<CHistogram> ahist;
+	CAutoRef<CHistogram> ahist;
 	ahist = phist;
 
 	GPOS_RTL_ASSERT(phist->FValid() && "Histogram must be well formed");
@@ -2689,8 +3696,8 @@ CStatisticsTest::EresUnittest_Skew()
 		phist2->OsPrint(at.Os());
 	}
 
-	GPOS_DELETE(phist1);
-	GPOS_DELETE(phist2);
+	phist1->Release();
+	phist2->Release();
 
 	return GPOS_OK;
 }
@@ -2924,8 +3931,8 @@ CStatisticsTest::EresUnittest_MergeHistMCV()
 		GPOS_DELETE(pstrOutput);
 		pdrgpdxlstatsderrelMCV->Release();
 		pdrgpdxlstatsderrelHist->Release();
-		GPOS_DELETE(phistMCV);
-		GPOS_DELETE(phistHist);
+		phistMCV->Release();
+		phistHist->Release();
 		pdrgpstats->Release();
 
 		if (GPOS_OK != eres)
@@ -18,9 +18,12 @@
 #include "gpopt/minidump/CMinidumperUtils.h"
 #include "gpopt/optimizer/COptimizerConfig.h"
 #include "gpopt/operators/CLogicalInnerJoin.h"
+#include "gpopt/operators/CPhysicalInnerHashJoin.h"
+#include "gpopt/operators/CPhysicalLeftOuterHashJoin.h"
 
 #include "naucrates/dxl/CDXLUtils.h"
 #include "naucrates/dxl/parser/CParseHandlerDXL.h"
+#include "naucrates/statistics/CStatistics.h"
 
 #include "unittest/base.h"
 #include "unittest/gpopt/cost/CCostTest.h"
@@ -47,6 +50,8 @@ CCostTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CCostTest::EresUnittest_Params),
 		GPOS_UNITTEST_FUNC(CCostTest::EresUnittest_Parsing),
 		GPOS_UNITTEST_FUNC(EresUnittest_SetParams),
+		GPOS_UNITTEST_FUNC(CCostTest::EresUnittest_RuntimeFilterSelectivity),
+		GPOS_UNITTEST_FUNC(CCostTest::EresUnittest_RuntimeFilterCost),
 
 		// TODO: : re-enable test after resolving exception throwing problem on OSX
 		// GPOS_UNITTEST_FUNC_THROW(CCostTest::EresUnittest_ParsingWithException, gpdxl::ExmaDXL, gpdxl::ExmiDXLUnexpectedTag),
@@ -417,4 +422,178 @@ CCostTest::EresUnittest_SetParams()
 	return GPOS_OK;
 }
 
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostTest::PexprInnerHashJoin
+//
+//	@doc:
+//		Generate an inner hash join of two tables on a single equality
+//		predicate; join children are left as logical gets since costing
+//		only reads child info from the costing info object
+//
+//---------------------------------------------------------------------------
+CExpression *
+CCostTest::PexprInnerHashJoin
+	(
+	IMemoryPool *pmp
+	)
+{
+	CExpression *pexprOuter = CTestUtils::PexprLogicalGet(pmp);
+	const CColRef *pcrOuter = CDrvdPropRelational::Pdprel(pexprOuter->PdpDerive())->PcrsOutput()->PcrAny();
+	CExpression *pexprInner = CTestUtils::PexprLogicalGet(pmp);
+	const CColRef *pcrInner = CDrvdPropRelational::Pdprel(pexprInner->PdpDerive())->PcrsOutput()->PcrAny();
+	CExpression *pexprPred = CUtils::PexprScalarEqCmp(pmp, pcrOuter, pcrInner);
+
+	DrgPexpr *pdrgpexprOuterKeys = GPOS_NEW(pmp) DrgPexpr(pmp);
+	pdrgpexprOuterKeys->Append(CUtils::PexprScalarIdent(pmp, pcrOuter));
+	DrgPexpr *pdrgpexprInnerKeys = GPOS_NEW(pmp) DrgPexpr(pmp);
+	pdrgpexprInnerKeys->Append(CUtils::PexprScalarIdent(pmp, pcrInner));
+
+	return GPOS_NEW(pmp) CExpression
+						(
+						pmp,
+						GPOS_NEW(pmp) CPhysicalInnerHashJoin(pmp, pdrgpexprOuterKeys, pdrgpexprInnerKeys),
+						pexprOuter,
+						pexprInner,
+						pexprPred
+						);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostTest::EresUnittest_RuntimeFilterSelectivity
+//
+//	@doc:
+//		Test planning decision and selectivity of hash join runtime filters
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CCostTest::EresUnittest_RuntimeFilterSelectivity()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc(pmp, &mda, NULL, /* pceeval */ CTestUtils::Pcm(pmp));
+
+	CExpression *pexprHJ = PexprInnerHashJoin(pmp);
+	COperator *popHJ = pexprHJ->Pop();
+
+	// left outer hash join on the same keys
+	DrgPexpr *pdrgpexprOuterKeys = GPOS_NEW(pmp) DrgPexpr(pmp);
+	DrgPexpr *pdrgpexprInnerKeys = GPOS_NEW(pmp) DrgPexpr(pmp);
+	CExpression *pexprOuterKey = (*CPhysicalHashJoin::PopConvert(popHJ)->PdrgpexprOuterKeys())[0];
+	CExpression *pexprInnerKey = (*CPhysicalHashJoin::PopConvert(popHJ)->PdrgpexprInnerKeys())[0];
+	pexprOuterKey->AddRef();
+	pexprInnerKey->AddRef();
+	pdrgpexprOuterKeys->Append(pexprOuterKey);
+	pdrgpexprInnerKeys->Append(pexprInnerKey);
+	COperator *popLOJ = GPOS_NEW(pmp) CPhysicalLeftOuterHashJoin(pmp, pdrgpexprOuterKeys, pdrgpexprInnerKeys);
+
+	// a selective join with a small inner side
+	const DOUBLE dRowsOuter = 10000.0;
+	const DOUBLE dRowsInner = 100.0;
+	const DOUBLE dRows = 1000.0;
+
+	// runtime filters are disabled by default
+	GPOS_RTL_ASSERT(1.0 == CPhysicalHashJoin::DRuntimeFilterSelectivity(popHJ, false /*fOuterMotion*/, dRowsOuter, dRowsInner, dRows));
+
+	{
+		CAutoTraceFlag atf(EopttraceEnableRuntimeFilter, true /*fVal*/);
+
+		// filter passes outer rows that have a match
+		GPOS_RTL_ASSERT(dRows / dRowsOuter == CPhysicalHashJoin::DRuntimeFilterSelectivity(popHJ, false /*fOuterMotion*/, dRowsOuter, dRowsInner, dRows));
+
+		// a filter cannot cross a motion on the outer side
+		GPOS_RTL_ASSERT(1.0 == CPhysicalHashJoin::DRuntimeFilterSelectivity(popHJ, true /*fOuterMotion*/, dRowsOuter, dRowsInner, dRows));
+
+		// inner side is too large relative to the outer side
+		GPOS_RTL_ASSERT(1.0 == CPhysicalHashJoin::DRuntimeFilterSelectivity(popHJ, false /*fOuterMotion*/, dRowsOuter, dRowsOuter, dRows));
+
+		// most outer rows have a match
+		GPOS_RTL_ASSERT(1.0 == CPhysicalHashJoin::DRuntimeFilterSelectivity(popHJ, false /*fOuterMotion*/, dRowsOuter, dRowsInner, dRowsOuter));
+
+		// outer joins must preserve all outer rows
+		GPOS_RTL_ASSERT(1.0 == CPhysicalHashJoin::DRuntimeFilterSelectivity(popLOJ, false /*fOuterMotion*/, dRowsOuter, dRowsInner, dRows));
+	}
+
+	// clean up
+	popLOJ->Release();
+	pexprHJ->Release();
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostTest::EresUnittest_RuntimeFilterCost
+//
+//	@doc:
+//		Test that a runtime filter decided when costing lowers the cost of
+//		feeding outer tuples to a hash join
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CCostTest::EresUnittest_RuntimeFilterCost()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	ICostModel *pcm = GPOS_NEW(pmp) CCostModelGPDB(pmp, GPOPT_TEST_SEGMENTS);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc(pmp, &mda, NULL, /* pceeval */ pcm);
+
+	CExpression *pexprHJ = PexprInnerHashJoin(pmp);
+	CExpressionHandle exprhdl(pmp);
+	exprhdl.Attach(pexprHJ);
+
+	ICostModel::SCostingInfo ci(pmp, 2 /*ulChildren*/, GPOS_NEW(pmp) ICostModel::CCostingStats(CStatistics::PstatsEmpty(pmp)));
+	ci.SetRows(1000.0);
+	ci.SetWidth(16.0);
+	ci.SetRebinds(1.0);
+	ci.SetChildRows(0, 10000.0);
+	ci.SetChildRows(1, 100.0);
+	for (ULONG ul = 0; ul < 2; ul++)
+	{
+		ci.SetChildWidth(ul, 8.0);
+		ci.SetChildRebinds(ul, 1.0);
+		ci.SetChildCost(ul, 100.0);
+	}
+
+	CCost costNoFilter = pcm->Cost(exprhdl, &ci);
+
+	ci.SetRuntimeFilterSelectivity(0.1);
+	CCost costFilter = pcm->Cost(exprhdl, &ci);
+
+	{
+		CAutoTrace at(pmp);
+		at.Os() << "Hash join cost without runtime filter: " << costNoFilter << std::endl;
+		at.Os() << "Hash join cost with runtime filter: " << costFilter << std::endl;
+	}
+
+	// only the width-dependent cost of feeding filtered outer tuples is saved,
+	// children costs are not changed
+	GPOS_RTL_ASSERT(costFilter < costNoFilter);
+	GPOS_RTL_ASSERT(costFilter.DVal() > 200.0);
+
+	// clean up
+	pexprHJ->Release();
+
+	return GPOS_OK;
+}
+
 // EOF
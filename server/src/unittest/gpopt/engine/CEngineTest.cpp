@@ -14,10 +14,15 @@
 #include "gpopt/base/CColRefSetIter.h"
 #include "gpopt/engine/CEngine.h"
 #include "gpopt/eval/CConstExprEvaluatorDefault.h"
+#include "gpopt/search/CBinding.h"
+#include "gpopt/search/CBindingHandle.h"
 #include "gpopt/search/CGroup.h"
 #include "gpopt/search/CGroupProxy.h"
 #include "gpopt/mdcache/CMDCache.h"
 #include "gpopt/operators/ops.h"
+#include "gpopt/xforms/CXformFactory.h"
+#include "gpopt/xforms/CXformProfile.h"
+#include "gpopt/xforms/CXformUtility.h"
 
 #include "unittest/base.h"
 #include "unittest/gpopt/engine/CEngineTest.h"
@@ -40,6 +45,7 @@ CEngineTest::EresUnittest()
 	CUnittest rgut[] =
 	{
 		GPOS_UNITTEST_FUNC(EresUnittest_Basic),
+		GPOS_UNITTEST_FUNC(EresUnittest_AdaptiveXforms),
 #ifdef GPOS_DEBUG
 		GPOS_UNITTEST_FUNC(EresUnittest_BuildMemo),
 		GPOS_UNITTEST_FUNC(EresUnittest_AppendStats),
@@ -50,6 +56,7 @@ CEngineTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(EresUnittest_BuildMemoWithWindowing),
 		GPOS_UNITTEST_FUNC(EresUnittest_BuildMemoLargeJoins),
 		GPOS_UNITTEST_FUNC(EresUnittest_BuildMemoWithCTE),
+		GPOS_UNITTEST_FUNC(EresUnittest_Bindings),
 #endif // GPOS_DEBUG
 	};
 
@@ -122,6 +129,87 @@ CEngineTest::EresUnittest_Basic()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::EresUnittest_AdaptiveXforms
+//
+//	@doc:
+//		Under the default search strategy, a join reordering xform that
+//		never contributed to plans of similar queries is not applied once
+//		its utility statistics are trusted, and a plan is still found
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CEngineTest::EresUnittest_AdaptiveXforms()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CAutoTraceFlag atf(EopttraceEnableAdaptiveXformBudget, true);
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc
+					(
+					pmp,
+					&mda,
+					NULL, /* pceeval */
+					CTestUtils::Pcm(pmp)
+					);
+
+	CXformUtility *pxfutil = CXformUtility::Pxfutil();
+	pxfutil->Reset();
+
+	// join commutativity fires in every optimization but never contributes
+	// to a plan
+	CXformProfile xfprof;
+	xfprof.RecordTransform(CXform::ExfJoinCommutativity, 1 /*ulBindings*/, 1 /*ulResults*/, 0 /*ulTime*/);
+
+	GPOS_RESULT eres = GPOS_OK;
+	for (ULONG ulRun = 0; GPOS_OK == eres && ulRun < 2; ulRun++)
+	{
+		const BOOL fTrusted = (1 == ulRun);
+		if (fTrusted)
+		{
+			// the sample count is chosen so the next optimization is not
+			// a refresh that keeps all xforms
+			for (ULONG ul = 0; ul < 2 * GPOPT_XFORM_UTILITY_MIN_SAMPLES + 1; ul++)
+			{
+				pxfutil->Update(CXformUtility::EqcSmallJoins, xfprof);
+			}
+		}
+
+		CEngine eng(pmp);
+
+		CExpression *pexpr = CTestUtils::PexprLogicalJoin<CLogicalInnerJoin>(pmp);
+		CQueryContext *pqc = CTestUtils::PqcGenerate(pmp, pexpr);
+
+		eng.Init(pqc, NULL /*pdrgpss*/);
+		eng.Optimize();
+		CExpression *pexprPlan = eng.PexprExtractPlan();
+
+		// the xform is applied until its statistics are trusted
+		const BOOL fApplied = (0 < eng.Pxfprof()->UllAttempts(CXform::ExfJoinCommutativity));
+		if (NULL == pexprPlan || fTrusted == fApplied)
+		{
+			eres = GPOS_FAILED;
+		}
+
+		CRefCount::SafeRelease(pexprPlan);
+		pexpr->Release();
+		GPOS_DELETE(pqc);
+	}
+
+	pxfutil->Reset();
+
+	return eres;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CEngineTest::EresOptimize
@@ -727,7 +815,358 @@ CEngineTest::EresUnittest_BuildMemoWithCTE()
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::FEqualBindings
+//
+//	@doc:
+//		Check if two bindings consist of the same operators and group
+//		expressions
+//
+//---------------------------------------------------------------------------
+BOOL
+CEngineTest::FEqualBindings
+	(
+	CExpression *pexprFst,
+	CExpression *pexprSnd
+	)
+{
+	if (pexprFst->Pop() != pexprSnd->Pop() ||
+		pexprFst->Pgexpr() != pexprSnd->Pgexpr() ||
+		pexprFst->UlArity() != pexprSnd->UlArity())
+	{
+		return false;
+	}
+
+	const ULONG ulArity = pexprFst->UlArity();
+	for (ULONG ul = 0; ul < ulArity; ul++)
+	{
+		if (!FEqualBindings((*pexprFst)[ul], (*pexprSnd)[ul]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::CheckBindings
+//
+//	@doc:
+//		Check that the given binding object extracts the same bindings as
+//		a binding object that does not share first bindings of child groups,
+//		for all logical group expressions reachable from the given group and
+//		all xforms whose pattern root matches them
+//
+//---------------------------------------------------------------------------
+void
+CEngineTest::CheckBindings
+	(
+	IMemoryPool *pmp,
+	CGroup *pgroup,
+	CBinding *pbinding,
+	CBitSet *pbsVisited
+	)
+{
+	if (pbsVisited->FExchangeSet(pgroup->UlId()))
+	{
+		return;
+	}
+
+	// bound the number of compared bindings of exhaustive patterns
+	const ULONG ulBindingsMax = 1000;
+
+	CGroupExpression *pgexpr = NULL;
+	{
+		CGroupProxy gp(pgroup);
+		pgexpr = gp.PgexprFirst();
+	}
+
+	while (NULL != pgexpr)
+	{
+		const ULONG ulArity = pgexpr->UlArity();
+		for (ULONG ul = 0; ul < ulArity; ul++)
+		{
+			CheckBindings(pmp, (*pgexpr)[ul], pbinding, pbsVisited);
+		}
+
+		if (pgexpr->Pop()->FLogical())
+		{
+			CXformSetIter xsi(*CXformFactory::Pxff()->PxfsPatternRoot(pgexpr->Pop()->Eopid()));
+			while (xsi.FAdvance())
+			{
+				CExpression *pexprPattern = CXformFactory::Pxff()->Pxf(xsi.TBit())->PexprPattern();
+
+				CBinding bindingEager(false /*fShareFirstBindings*/);
+				CExpression *pexprShared = pbinding->PexprExtract(pmp, pgexpr, pexprPattern, NULL /*pexprLast*/);
+				CExpression *pexprEager = bindingEager.PexprExtract(pmp, pgexpr, pexprPattern, NULL /*pexprLast*/);
+
+				ULONG ulBindings = 0;
+				while (NULL != pexprShared && NULL != pexprEager && ulBindings < ulBindingsMax)
+				{
+					GPOS_RTL_ASSERT(FEqualBindings(pexprShared, pexprEager));
+					ulBindings++;
+
+					CExpression *pexprSharedLast = pexprShared;
+					CExpression *pexprEagerLast = pexprEager;
+					pexprShared = pbinding->PexprExtract(pmp, pgexpr, pexprPattern, pexprSharedLast);
+					pexprEager = bindingEager.PexprExtract(pmp, pgexpr, pexprPattern, pexprEagerLast);
+					pexprSharedLast->Release();
+					pexprEagerLast->Release();
+
+					GPOS_CHECK_ABORT;
+				}
+
+				GPOS_RTL_ASSERT((NULL == pexprShared) == (NULL == pexprEager));
+				CRefCount::SafeRelease(pexprShared);
+				CRefCount::SafeRelease(pexprEager);
+
+				CXform *pxform = CXformFactory::Pxff()->Pxf(xsi.TBit());
+				if (pxform->FLazyBinding())
+				{
+					CheckLazyBindings(pmp, pgexpr, pxform);
+				}
+			}
+		}
+
+		CGroupProxy gp(pgroup);
+		pgexpr = gp.PgexprNext(pgexpr);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::FEqualBindings
+//
+//	@doc:
+//		Check if a lazy binding binds the same group expressions as an
+//		extracted binding; groups bound as a whole are compared by their
+//		first group expression
+//
+//---------------------------------------------------------------------------
+BOOL
+CEngineTest::FEqualBindings
+	(
+	CExpression *pexpr,
+	const CBindingHandle &bh
+	)
+{
+	if (pexpr->Pop() != bh.Pop() || pexpr->Pgexpr() != bh.Pgexpr())
+	{
+		return false;
+	}
+
+	if (bh.FGroupBound())
+	{
+		return true;
+	}
+
+	const ULONG ulArity = pexpr->UlArity();
+	if (ulArity != bh.UlArity())
+	{
+		return false;
+	}
+
+	for (ULONG ul = 0; ul < ulArity; ul++)
+	{
+		if (!FEqualBindings((*pexpr)[ul], bh[ul]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::FEqualResults
+//
+//	@doc:
+//		Check if two xform results have the same operators and derived
+//		columns; scalar subtrees are compared by their used columns only
+//		since lazy bindings represent them by their groups
+//
+//---------------------------------------------------------------------------
+BOOL
+CEngineTest::FEqualResults
+	(
+	CExpression *pexprFst,
+	CExpression *pexprSnd
+	)
+{
+	if (pexprFst->Pop()->Eopid() != pexprSnd->Pop()->Eopid())
+	{
+		return false;
+	}
+
+	if (pexprFst->Pop()->FScalar())
+	{
+		return CDrvdPropScalar::Pdpscalar(pexprFst->PdpDerive())->PcrsUsed()->FEqual
+				(
+				CDrvdPropScalar::Pdpscalar(pexprSnd->PdpDerive())->PcrsUsed()
+				);
+	}
+
+	const ULONG ulArity = pexprFst->UlArity();
+	if (ulArity != pexprSnd->UlArity() ||
+		!CDrvdPropRelational::Pdprel(pexprFst->PdpDerive())->PcrsOutput()->FEqual
+			(
+			CDrvdPropRelational::Pdprel(pexprSnd->PdpDerive())->PcrsOutput()
+			))
+	{
+		return false;
+	}
+
+	for (ULONG ul = 0; ul < ulArity; ul++)
+	{
+		if (!FEqualResults((*pexprFst)[ul], (*pexprSnd)[ul]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::CheckLazyBindings
+//
+//	@doc:
+//		Check that lazy bindings of a group expression bind the same group
+//		expressions as extracted bindings, and that the xform produces the
+//		same results from both
+//
+//---------------------------------------------------------------------------
+void
+CEngineTest::CheckLazyBindings
+	(
+	IMemoryPool *pmp,
+	CGroupExpression *pgexpr,
+	CXform *pxform
+	)
+{
+	// bound the number of compared bindings of exhaustive patterns
+	const ULONG ulBindingsMax = 1000;
+
+	// results are only compared for promising xforms
+	CExpressionHandle exprhdl(pmp);
+	exprhdl.Attach(pgexpr);
+	exprhdl.DeriveProps(NULL /*pdpctxt*/);
+	const BOOL fPromising = (CXform::ExfpNone != pxform->Exfp(exprhdl));
+
+	CExpression *pexprPattern = pxform->PexprPattern();
+	CBinding binding;
+	CBindingHandle bh(pmp);
+
+	BOOL fBound = binding.FBindFirst(pgexpr, pexprPattern, &bh);
+	CExpression *pexpr = binding.PexprExtract(pmp, pgexpr, pexprPattern, NULL /*pexprLast*/);
+
+	ULONG ulBindings = 0;
+	while (fBound && NULL != pexpr && ulBindings < ulBindingsMax)
+	{
+		GPOS_RTL_ASSERT(FEqualBindings(pexpr, bh));
+		ulBindings++;
+
+		if (fPromising)
+		{
+			CXformContext *pxfctxt = GPOS_NEW(pmp) CXformContext(pmp);
+			CXformResult *pxfresExtracted = GPOS_NEW(pmp) CXformResult(pmp);
+			CXformResult *pxfresLazy = GPOS_NEW(pmp) CXformResult(pmp);
+
+			pxform->Transform(pxfctxt, pxfresExtracted, pexpr);
+			pxform->TransformBinding(pxfctxt, pxfresLazy, bh);
+
+			const ULONG ulResults = pxfresExtracted->Pdrgpexpr()->UlLength();
+			GPOS_RTL_ASSERT(ulResults == pxfresLazy->Pdrgpexpr()->UlLength());
+			for (ULONG ul = 0; ul < ulResults; ul++)
+			{
+				GPOS_RTL_ASSERT(FEqualResults((*pxfresExtracted->Pdrgpexpr())[ul], (*pxfresLazy->Pdrgpexpr())[ul]));
+			}
+
+			pxfresExtracted->Release();
+			pxfresLazy->Release();
+			pxfctxt->Release();
+		}
+
+		CExpression *pexprLast = pexpr;
+		fBound = binding.FBindNext(&bh);
+		pexpr = binding.PexprExtract(pmp, pgexpr, pexprPattern, pexprLast);
+		pexprLast->Release();
+
+		GPOS_CHECK_ABORT;
+	}
+
+	GPOS_RTL_ASSERT(ulBindingsMax == ulBindings || fBound == (NULL != pexpr));
+	CRefCount::SafeRelease(pexpr);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::EresUnittest_Bindings
+//
+//	@doc:
+//		Bindings extracted while sharing the first bindings of child groups
+//		must be the same as bindings extracted without sharing, including
+//		when the same binding object is used again after the memo grew;
+//		lazy bindings must bind the same group expressions and lead to the
+//		same xform results
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CEngineTest::EresUnittest_Bindings()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc
+					(
+					pmp,
+					&mda,
+					NULL,  /* pceeval */
+					CTestUtils::Pcm(pmp)
+					);
+
+	CEngine eng(pmp);
+
+	CExpression *pexpr = CTestUtils::PexprLogicalNAryJoin(pmp);
+	CQueryContext *pqc = CTestUtils::PqcGenerate(pmp, pexpr);
+	eng.Init(pqc, NULL /*pdrgpss*/);
+
+	// first bindings shared by the binding object before exploration must
+	// not be used once exploration added group expressions to the memo
+	CBinding binding;
+
+	CBitSet *pbsVisited = GPOS_NEW(pmp) CBitSet(pmp);
+	CheckBindings(pmp, eng.PgroupRoot(), &binding, pbsVisited);
+	pbsVisited->Release();
+
+	eng.Explore();
+
+	pbsVisited = GPOS_NEW(pmp) CBitSet(pmp);
+	CheckBindings(pmp, eng.PgroupRoot(), &binding, pbsVisited);
+	pbsVisited->Release();
+
+	pexpr->Release();
+	GPOS_DELETE(pqc);
+
+	return GPOS_OK;
+}
+
 #endif // GPOS_DEBUG
 
 // EOF
-
@@ -9,16 +9,23 @@
 //		Tests accessing objects from the metadata cache.
 //---------------------------------------------------------------------------
 
+#include "gpos/common/CAutoRg.h"
 #include "gpos/error/CAutoTrace.h"
 #include "gpos/string/CWStringDynamic.h"
 #include "gpos/io/COstreamString.h"
 
+#include "gpos/io/ioutils.h"
+#include "gpos/io/CFileDescriptor.h"
+#include "gpos/io/CFileReader.h"
+#include "gpos/io/CFileWriter.h"
 #include "gpos/memory/CCacheFactory.h"
+#include "gpos/string/CStringStatic.h"
 #include "gpos/task/CAutoTaskProxy.h"
 
 
 #include "naucrates/md/CMDProviderMemory.h"
 #include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/md/CMDRequest.h"
 #include "naucrates/md/IMDTypeInt4.h"
 #include "naucrates/md/IMDTypeBool.h"
 #include "naucrates/md/IMDTypeOid.h"
@@ -41,6 +48,8 @@
 #include "naucrates/base/IDatumOid.h"
 
 #include "gpopt/eval/CConstExprEvaluatorDefault.h"
+#include "gpopt/mdcache/CMDCache.h"
+#include "gpopt/mdcache/CMDSnapshot.h"
 #include "gpopt/optimizer/COptimizerConfig.h"
 
 #include "unittest/base.h"
@@ -86,6 +95,10 @@ CMDAccessorTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_IndexPartConstraint),
 		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_Cast),
 		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_ScCmp),
+		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_Prefetch),
+		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_SharedObjects),
+		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_Snapshot),
+		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_Invalidate),
 		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_ConcurrentAccessSingleMDA),
 		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_ConcurrentAccessMultipleMDA)
 		};
@@ -720,6 +733,537 @@ CMDAccessorTest::EresUnittest_ScCmp()
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessorTest::EresUnittest_Prefetch
+//
+//	@doc:
+//		Test fetching metadata objects from a provider in a batched request
+//		ahead of their lookup
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMDAccessorTest::EresUnittest_Prefetch()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// use a private cache so that no object is cached before the prefetch
+	CAutoP<CMDAccessor::MDCache> apcache;
+	apcache = CCacheFactory::PCacheCreate<gpopt::IMDCacheObject*, gpopt::CMDKey*>
+				(
+				true, // fUnique
+				0 /* unlimited cache quota */,
+				CMDKey::UlHashMDKey,
+				CMDKey::FEqualMDKey
+				);
+
+	CMDProviderBatch *pmdp = GPOS_NEW(pmp) CMDProviderBatch(pmp, CTestUtils::m_szMDFileName);
+	pmdp->AddRef();
+
+	GPOS_RESULT eres = GPOS_OK;
+	{
+		CMDAccessor mda(pmp, apcache.Pt(), CTestUtils::m_sysidDefault, pmdp);
+
+		DrgPmdid *pdrgpmdid = GPOS_NEW(pmp) DrgPmdid(pmp);
+		pdrgpmdid->Append(GPOS_NEW(pmp) CMDIdGPDB(GPOPT_MDCACHE_TEST_OID, 1 /* major version */, 1 /* minor version */));
+		pdrgpmdid->Append(GPOS_NEW(pmp) CMDIdGPDB(GPDB_INT4, 1, 0));
+		pdrgpmdid->Append(GPOS_NEW(pmp) CMDIdGPDB(GPDB_OP_INT4_LT, 1, 0));
+		pdrgpmdid->Append(GPOS_NEW(pmp) CMDIdGPDB(GPDB_AGG_AVG, 1, 0));
+		pdrgpmdid->Append(GPOS_NEW(pmp) CMDIdGPDB(GPDB_FUNC_TIMEOFDAY, 1, 0));
+
+		// duplicates are requested once
+		pdrgpmdid->Append(GPOS_NEW(pmp) CMDIdGPDB(GPDB_INT4, 1, 0));
+
+		mda.Prefetch(pdrgpmdid);
+
+		// objects are looked up without further requests to the provider
+		(void) mda.Pmdrel((*pdrgpmdid)[0]);
+		(void) mda.Pmdtype((*pdrgpmdid)[1]);
+		(void) mda.Pmdscop((*pdrgpmdid)[2]);
+		(void) mda.Pmdagg((*pdrgpmdid)[3]);
+		(void) mda.Pmdfunc((*pdrgpmdid)[4]);
+
+		// cached objects are not requested again
+		mda.Prefetch(pdrgpmdid);
+		pdrgpmdid->Release();
+
+		if (1 != pmdp->UlBatches() || 0 != pmdp->UlObjects())
+		{
+			eres = GPOS_FAILED;
+		}
+	}
+
+	pmdp->Release();
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessorTest::EresUnittest_SharedObjects
+//
+//	@doc:
+//		Test that objects supplied by a provider are cached unless the
+//		provider shares them with the accessor
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMDAccessorTest::EresUnittest_SharedObjects()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CMDIdGPDB *pmdidType = GPOS_NEW(pmp) CMDIdGPDB(GPDB_INT4, 1, 0);
+
+	GPOS_RESULT eres = GPOS_OK;
+	for (ULONG ul = 0; GPOS_OK == eres && ul < 2; ul++)
+	{
+		const BOOL fShared = (1 == ul);
+
+		// use a private cache so that no object is cached before the lookup
+		CAutoP<CMDAccessor::MDCache> apcache;
+		apcache = CCacheFactory::PCacheCreate<gpopt::IMDCacheObject*, gpopt::CMDKey*>
+					(
+					true, // fUnique
+					0 /* unlimited cache quota */,
+					CMDKey::UlHashMDKey,
+					CMDKey::FEqualMDKey
+					);
+
+		CMDProviderMemory *pmdp = NULL;
+		if (fShared)
+		{
+			pmdp = GPOS_NEW(pmp) CMDProviderShared(pmp, CTestUtils::m_szMDFileName);
+		}
+		else
+		{
+			pmdp = GPOS_NEW(pmp) CMDProviderMemory(pmp, CTestUtils::m_szMDFileName);
+		}
+		pmdp->AddRef();
+
+		{
+			CMDAccessor mda(pmp, apcache.Pt(), CTestUtils::m_sysidDefault, pmdp);
+
+			const IMDType *pmdtype = mda.Pmdtype(pmdidType);
+			IMDCacheObject *pimdobjProvider = pmdp->Pimdobj(pmp, &mda, pmdidType);
+
+			// shared objects are handed out as is and bypass the cache, other
+			// objects are built by the provider in the cache's memory pool
+			BOOL fSameObject = (static_cast<const IMDCacheObject *>(pmdtype) == pimdobjProvider);
+			BOOL fCached = (0 < apcache->UllTotalAllocatedSize());
+			if (fShared != fSameObject || fShared == fCached ||
+				!pmdtype->Pmdid()->FEquals(pimdobjProvider->Pmdid()))
+			{
+				eres = GPOS_FAILED;
+			}
+
+			pimdobjProvider->Release();
+		}
+
+		pmdp->Release();
+	}
+
+	pmdidType->Release();
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessorTest::EresUnittest_Snapshot
+//
+//	@doc:
+//		Test restoring metadata objects from a snapshot of the MD cache
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMDAccessorTest::EresUnittest_Snapshot()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// create snapshot file in new directory under /tmp
+	CHAR szPath[GPOS_FILE_NAME_BUF_SIZE];
+	CHAR szFile[GPOS_FILE_NAME_BUF_SIZE];
+
+	CStringStatic strPath(szPath, GPOS_ARRAY_SIZE(szPath));
+	CStringStatic strFile(szFile, GPOS_ARRAY_SIZE(szFile));
+
+	strPath.AppendBuffer("/tmp/gpopt_test_mdsnapshot.XXXXXX");
+	(void) ioutils::SzMkDTemp(szPath);
+
+	strFile.Append(&strPath);
+	strFile.AppendBuffer("/CMDAccessorTest");
+
+	GPOS_RESULT eres = GPOS_FAILED;
+	GPOS_TRY
+	{
+		eres = EresSnapshot(pmp, strFile.Sz());
+		if (GPOS_OK == eres)
+		{
+			eres = EresSnapshotCorrupt(pmp, strFile.Sz());
+		}
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		CMDCache::Reset();
+		if (ioutils::FPathExist(strFile.Sz()))
+		{
+			ioutils::Unlink(strFile.Sz());
+		}
+		ioutils::RmDir(strPath.Sz());
+
+		GPOS_RETHROW(ex);
+	}
+	GPOS_CATCH_END;
+
+	// drop the snapshot and the objects restored from it
+	CMDCache::Reset();
+	ioutils::Unlink(strFile.Sz());
+	ioutils::RmDir(strPath.Sz());
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessorTest::EresSnapshot
+//
+//	@doc:
+//		Cache objects, save a snapshot of the cache, and look the objects up
+//		in an empty cache with the snapshot loaded; objects in the snapshot
+//		must not be requested from the provider
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMDAccessorTest::EresSnapshot
+	(
+	IMemoryPool *pmp,
+	const CHAR *szFileName
+	)
+{
+	CMDCache::Reset();
+
+	CAutoRef<CMDIdGPDB> a_pmdidRel;
+	a_pmdidRel = GPOS_NEW(pmp) CMDIdGPDB(GPOPT_MDCACHE_TEST_OID, 1 /* major version */, 1 /* minor version */);
+	CAutoRef<CMDIdGPDB> a_pmdidRelChanged;
+	a_pmdidRelChanged = GPOS_NEW(pmp) CMDIdGPDB(GPOPT_MDCACHE_TEST_OID, 12 /* major version */, 1 /* minor version */);
+	CAutoRef<CMDIdGPDB> a_pmdidType;
+	a_pmdidType = GPOS_NEW(pmp) CMDIdGPDB(GPDB_INT4, 1, 0);
+
+	{
+		CMDProviderBatch *pmdp = GPOS_NEW(pmp) CMDProviderBatch(pmp, CTestUtils::m_szMDFileName);
+		CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+		(void) mda.Pmdrel(a_pmdidRel.Pt());
+		(void) mda.Pmdtype(a_pmdidType.Pt());
+
+		CMDCache::SaveSnapshot(szFileName);
+	}
+
+	CMDCache::Reset();
+	if (!CMDCache::FLoadSnapshot(szFileName))
+	{
+		return GPOS_FAILED;
+	}
+
+	CMDProviderBatch *pmdp = GPOS_NEW(pmp) CMDProviderBatch(pmp, CTestUtils::m_szMDFileName);
+	pmdp->AddRef();
+
+	GPOS_RESULT eres = GPOS_OK;
+	{
+		CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+		const IMDRelation *pmdrel = mda.Pmdrel(a_pmdidRel.Pt());
+		(void) mda.Pmdtype(a_pmdidType.Pt());
+		if (!pmdrel->Pmdid()->FEquals(a_pmdidRel.Pt()) || 0 != pmdp->UlObjects())
+		{
+			eres = GPOS_FAILED;
+		}
+
+		// a version of the object not in the snapshot is fetched from the provider
+		(void) mda.Pmdrel(a_pmdidRelChanged.Pt());
+		if (1 != pmdp->UlObjects())
+		{
+			eres = GPOS_FAILED;
+		}
+	}
+
+	pmdp->Release();
+
+	// objects restored from the snapshot are in the cache now
+	if (0 != UlLookup(pmp, a_pmdidRel.Pt(), a_pmdidType.Pt()))
+	{
+		eres = GPOS_FAILED;
+	}
+
+	// invalidated objects are fetched from the provider rather than restored
+	// from the snapshot again
+	(void) CMDCache::UlInvalidate(a_pmdidType.Pt());
+	(void) CMDCache::UlInvalidateRelation(a_pmdidRel.Pt());
+	if (CMDCache::Psnapshot()->FContains(a_pmdidType.Pt()) ||
+		CMDCache::Psnapshot()->FContains(a_pmdidRel.Pt()) ||
+		2 != UlLookup(pmp, a_pmdidRel.Pt(), a_pmdidType.Pt()))
+	{
+		eres = GPOS_FAILED;
+	}
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessorTest::EresSnapshotCorrupt
+//
+//	@doc:
+//		Save a snapshot of the cache and corrupt the binary DXL document of
+//		its last record; the object of that record must be fetched from the
+//		provider instead, and its record invalidated
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMDAccessorTest::EresSnapshotCorrupt
+	(
+	IMemoryPool *pmp,
+	const CHAR *szFileName
+	)
+{
+	CMDCache::Reset();
+
+	CAutoRef<CMDIdGPDB> a_pmdidRel;
+	a_pmdidRel = GPOS_NEW(pmp) CMDIdGPDB(GPOPT_MDCACHE_TEST_OID, 1 /* major version */, 1 /* minor version */);
+	CAutoRef<CMDIdGPDB> a_pmdidType;
+	a_pmdidType = GPOS_NEW(pmp) CMDIdGPDB(GPDB_INT4, 1, 0);
+
+	(void) UlLookup(pmp, a_pmdidRel.Pt(), a_pmdidType.Pt());
+	CMDCache::SaveSnapshot(szFileName);
+
+	// flip the last byte of the snapshot
+	const ULONG ulLength = (ULONG) ioutils::UllFileSize(szFileName);
+	CAutoRg<BYTE> a_pba(GPOS_NEW_ARRAY(pmp, BYTE, ulLength));
+	{
+		CFileReader fr;
+		fr.Open(szFileName);
+		(void) fr.UlpRead(a_pba.Rgt(), ulLength);
+		fr.Close();
+	}
+	a_pba[ulLength - 1] = ~a_pba[ulLength - 1];
+	{
+		CFileWriter fw;
+		fw.Open(szFileName, S_IRUSR | S_IWUSR);
+		fw.Write(a_pba.Rgt(), ulLength);
+		fw.Close();
+	}
+
+	CMDCache::Reset();
+	if (!CMDCache::FLoadSnapshot(szFileName))
+	{
+		return GPOS_FAILED;
+	}
+
+	// only the object of the corrupt record is fetched from the provider
+	GPOS_RESULT eres = GPOS_OK;
+	if (1 != UlLookup(pmp, a_pmdidRel.Pt(), a_pmdidType.Pt()) ||
+		1 != (ULONG) CMDCache::Psnapshot()->FContains(a_pmdidRel.Pt()) + (ULONG) CMDCache::Psnapshot()->FContains(a_pmdidType.Pt()))
+	{
+		eres = GPOS_FAILED;
+	}
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessorTest::EresUnittest_Invalidate
+//
+//	@doc:
+//		Test invalidating entries of the MD cache; invalidated objects must be
+//		requested from the provider again
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMDAccessorTest::EresUnittest_Invalidate()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CMDCache::Reset();
+
+	CAutoRef<CMDIdGPDB> a_pmdidRel;
+	a_pmdidRel = GPOS_NEW(pmp) CMDIdGPDB(GPOPT_MDCACHE_TEST_OID, 1 /* major version */, 1 /* minor version */);
+	CAutoRef<CMDIdGPDB> a_pmdidRelChanged;
+	a_pmdidRelChanged = GPOS_NEW(pmp) CMDIdGPDB(GPOPT_MDCACHE_TEST_OID, 12 /* major version */, 1 /* minor version */);
+	CAutoRef<CMDIdGPDB> a_pmdidType;
+	a_pmdidType = GPOS_NEW(pmp) CMDIdGPDB(GPDB_INT4, 1, 0);
+
+	GPOS_RESULT eres = GPOS_OK;
+
+	// fill the cache, then look the objects up again without invalidation
+	(void) UlLookup(pmp, a_pmdidRel.Pt(), a_pmdidType.Pt());
+	if (0 != UlLookup(pmp, a_pmdidRel.Pt(), a_pmdidType.Pt()))
+	{
+		eres = GPOS_FAILED;
+	}
+
+	// invalidate a single object
+	if (1 != CMDCache::UlInvalidate(a_pmdidType.Pt()) ||
+		1 != UlLookup(pmp, a_pmdidRel.Pt(), a_pmdidType.Pt()))
+	{
+		eres = GPOS_FAILED;
+	}
+
+	// a newer version of the relation supersedes the cached one
+	if (0 != CMDCache::UlInvalidateStale(a_pmdidRel.Pt()) ||
+		1 != CMDCache::UlInvalidateStale(a_pmdidRelChanged.Pt()) ||
+		1 != UlLookup(pmp, a_pmdidRel.Pt(), a_pmdidType.Pt()))
+	{
+		eres = GPOS_FAILED;
+	}
+
+	// invalidate the relation and its dependent objects
+	if (0 == CMDCache::UlInvalidateRelation(a_pmdidRel.Pt()) ||
+		1 != UlLookup(pmp, a_pmdidRel.Pt(), a_pmdidType.Pt()))
+	{
+		eres = GPOS_FAILED;
+	}
+
+	// invalidate all objects of the source system
+	if (2 > CMDCache::UlInvalidateSystem(CTestUtils::m_sysidDefault) ||
+		2 != UlLookup(pmp, a_pmdidRel.Pt(), a_pmdidType.Pt()))
+	{
+		eres = GPOS_FAILED;
+	}
+
+	CMDCache::Reset();
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessorTest::UlLookup
+//
+//	@doc:
+//		Look up a relation and a type through a new accessor of the MD cache;
+//		returns the number of objects requested from the provider
+//
+//---------------------------------------------------------------------------
+ULONG
+CMDAccessorTest::UlLookup
+	(
+	IMemoryPool *pmp,
+	IMDId *pmdidRel,
+	IMDId *pmdidType
+	)
+{
+	CMDProviderBatch *pmdp = GPOS_NEW(pmp) CMDProviderBatch(pmp, CTestUtils::m_szMDFileName);
+	pmdp->AddRef();
+
+	{
+		CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+		(void) mda.Pmdrel(pmdidRel);
+		(void) mda.Pmdtype(pmdidType);
+	}
+
+	ULONG ulObjects = pmdp->UlObjects();
+	pmdp->Release();
+
+	return ulObjects;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessorTest::CMDProviderBatch::CMDProviderBatch
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CMDAccessorTest::CMDProviderBatch::CMDProviderBatch
+	(
+	IMemoryPool *pmp,
+	const CHAR *szFileName
+	)
+	:
+	CMDProviderMemory(pmp, szFileName),
+	m_ulBatches(0),
+	m_ulObjects(0)
+{}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessorTest::CMDProviderBatch::PstrObject
+//
+//	@doc:
+//		Returns the DXL string of the requested metadata object
+//
+//---------------------------------------------------------------------------
+CWStringBase *
+CMDAccessorTest::CMDProviderBatch::PstrObject
+	(
+	IMemoryPool *pmp,
+	CMDAccessor *pmda,
+	IMDId *pmdid
+	)
+	const
+{
+	m_ulObjects++;
+
+	return CMDProviderMemory::PstrObject(pmp, pmda, pmdid);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessorTest::CMDProviderBatch::Pimdobj
+//
+//	@doc:
+//		Objects are only supplied as DXL strings, as by a host provider
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+CMDAccessorTest::CMDProviderBatch::Pimdobj
+	(
+	IMemoryPool *, // pmp
+	CMDAccessor *, // pmda
+	IMDId * // pmdid
+	)
+	const
+{
+	return NULL;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessorTest::CMDProviderBatch::PdrgpstrObjects
+//
+//	@doc:
+//		Returns the DXL strings of the metadata objects of a request
+//
+//---------------------------------------------------------------------------
+DrgPstr *
+CMDAccessorTest::CMDProviderBatch::PdrgpstrObjects
+	(
+	IMemoryPool *pmp,
+	CMDAccessor *pmda,
+	CMDRequest *pmdr
+	)
+	const
+{
+	m_ulBatches++;
+
+	DrgPmdid *pdrgpmdid = pmdr->Pdrgpmdid();
+	DrgPstr *pdrgpstr = GPOS_NEW(pmp) DrgPstr(pmp);
+	const ULONG ulMdids = pdrgpmdid->UlLength();
+	for (ULONG ul = 0; ul < ulMdids; ul++)
+	{
+		pdrgpstr->Append(CMDProviderMemory::PstrObject(pmp, pmda, (*pdrgpmdid)[ul]));
+	}
+
+	return pdrgpstr;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDAccessorTest::EresUnittest_Negative
@@ -8,6 +8,7 @@
 //	@doc:
 //		Test for DXL-based minidumps
 //---------------------------------------------------------------------------
+#include "gpos/error/CAutoTrace.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/io/COstreamFile.h"
 #include "gpos/task/CAutoTraceFlag.h"
@@ -37,11 +38,34 @@
 #include "unittest/gpopt/translate/CTranslatorExprToDXLTest.h"
 #include "unittest/gpopt/CTestUtils.h"
 
+#include <dirent.h>
 #include <fstream>
 
 static
 const CHAR *szQueryFile= "../data/dxl/minidump/Query.xml";
 
+// directory of the minidumps round-tripped through the binary format
+static
+const CHAR *szMinidumpDir = "../data/dxl/minidump";
+
+// suffix of minidump files
+static
+const CHAR *szMinidumpSuffix = ".mdp";
+
+// array of file paths
+typedef CDynamicPtrArray<CHAR, CleanupDeleteRg<CHAR> > DrgPszFileName;
+
+// compare file paths in an array
+static
+INT IFileNameCmp
+	(
+	const void *pv1,
+	const void *pv2
+	)
+{
+	return clib::IStrCmp(*(const CHAR **) pv1, *(const CHAR **) pv2);
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMiniDumperDXLTest::EresUnittest
@@ -57,6 +81,7 @@ CMiniDumperDXLTest::EresUnittest()
 		{
 		GPOS_UNITTEST_FUNC(CMiniDumperDXLTest::EresUnittest_Basic),
 		GPOS_UNITTEST_FUNC(CMiniDumperDXLTest::EresUnittest_Load),
+		GPOS_UNITTEST_FUNC(CMiniDumperDXLTest::EresUnittest_BinaryRoundTrip),
 		};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -273,4 +298,220 @@ CMiniDumperDXLTest::EresUnittest_Load()
 	return eres;
 
 }
+
+//---------------------------------------------------------------------------
+//	@function:
+//		PdrgpszMinidumps
+//
+//	@doc:
+//		Paths of the minidump files in the minidump directory, sorted so
+//		that failures are reported in a stable order; returns NULL if the
+//		directory cannot be read
+//
+//---------------------------------------------------------------------------
+static
+DrgPszFileName *
+PdrgpszMinidumps
+	(
+	IMemoryPool *pmp
+	)
+{
+	DIR *pdir = opendir(szMinidumpDir);
+	if (NULL == pdir)
+	{
+		return NULL;
+	}
+
+	DrgPszFileName *pdrgpsz = GPOS_NEW(pmp) DrgPszFileName(pmp);
+
+	const ULONG ulDirLength = clib::UlStrLen(szMinidumpDir);
+	const ULONG ulSuffixLength = clib::UlStrLen(szMinidumpSuffix);
+	for (struct dirent *pdirent = readdir(pdir); NULL != pdirent; pdirent = readdir(pdir))
+	{
+		const ULONG ulLength = clib::UlStrLen(pdirent->d_name);
+		if (ulLength <= ulSuffixLength ||
+			0 != clib::IStrCmp(pdirent->d_name + ulLength - ulSuffixLength, szMinidumpSuffix))
+		{
+			continue;
+		}
+
+		// directory, separator, file name and terminating null character
+		CHAR *szPath = GPOS_NEW_ARRAY(pmp, CHAR, ulDirLength + ulLength + 2);
+		(void) clib::PvMemCpy(szPath, szMinidumpDir, ulDirLength);
+		szPath[ulDirLength] = '/';
+		(void) clib::PvMemCpy(szPath + ulDirLength + 1, pdirent->d_name, ulLength + 1);
+		pdrgpsz->Append(szPath);
+	}
+
+	(void) closedir(pdir);
+
+	pdrgpsz->Sort(IFileNameCmp);
+
+	return pdrgpsz;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMiniDumperDXLTest::EresUnittest_BinaryRoundTrip
+//
+//	@doc:
+//		Round-trip every minidump of the minidump directory through the
+//		binary DXL format
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMiniDumperDXLTest::EresUnittest_BinaryRoundTrip()
+{
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcExc);
+	IMemoryPool *pmp = amp.Pmp();
+
+	DrgPszFileName *pdrgpsz = PdrgpszMinidumps(pmp);
+	if (NULL == pdrgpsz || 0 == pdrgpsz->UlLength())
+	{
+		CRefCount::SafeRelease(pdrgpsz);
+
+		return GPOS_FAILED;
+	}
+
+	GPOS_RESULT eres = GPOS_OK;
+	const ULONG ulFiles = pdrgpsz->UlLength();
+	for (ULONG ul = 0; ul < ulFiles; ul++)
+	{
+		if (GPOS_OK != EresBinaryRoundTrip(pmp, (*pdrgpsz)[ul]))
+		{
+			CAutoTrace at(pmp);
+			at.Os() << "Binary DXL round trip failed for " << (*pdrgpsz)[ul];
+			eres = GPOS_FAILED;
+		}
+
+		GPOS_CHECK_ABORT;
+	}
+
+	pdrgpsz->Release();
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMiniDumperDXLTest::EresBinaryRoundTrip
+//
+//	@doc:
+//		Write the query, plan and metadata of the given minidump in the
+//		binary DXL format, parse them back, and check that they serialize
+//		to the same DXL as the loaded minidump
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMiniDumperDXLTest::EresBinaryRoundTrip
+	(
+	IMemoryPool *pmp,
+	const CHAR *szFileName
+	)
+{
+	CDXLMinidump *pdxlmd = CMinidumperUtils::PdxlmdLoad(pmp, szFileName);
+	GPOS_CHECK_ABORT;
+
+	GPOS_RESULT eres = GPOS_OK;
+
+	// query
+	ULONG ulLength = 0;
+	BYTE *pba = CDXLUtils::PbaSerializeQuery
+							(
+							pmp,
+							pdxlmd->PdxlnQuery(),
+							pdxlmd->PdrgpdxlnQueryOutput(),
+							pdxlmd->PdrgpdxlnCTE(),
+							&ulLength
+							);
+	CQueryToDXLResult *pq2dxlresult = CDXLUtils::PdxlnParseBinaryDXLQuery(pmp, pba, ulLength);
+	GPOS_DELETE_ARRAY(pba);
+
+	CWStringDynamic strQueryExpected(pmp);
+	COstreamString osQueryExpected(&strQueryExpected);
+	CDXLUtils::SerializeQuery
+				(
+				pmp,
+				osQueryExpected,
+				pdxlmd->PdxlnQuery(),
+				pdxlmd->PdrgpdxlnQueryOutput(),
+				pdxlmd->PdrgpdxlnCTE(),
+				true /*fSerializeHeaderFooter*/,
+				true /*fIndent*/
+				);
+
+	CWStringDynamic strQuery(pmp);
+	COstreamString osQuery(&strQuery);
+	CDXLUtils::SerializeQuery
+				(
+				pmp,
+				osQuery,
+				pq2dxlresult->Pdxln(),
+				pq2dxlresult->PdrgpdxlnOutputCols(),
+				pq2dxlresult->PdrgpdxlnCTE(),
+				true /*fSerializeHeaderFooter*/,
+				true /*fIndent*/
+				);
+	GPOS_DELETE(pq2dxlresult);
+
+	if (!strQueryExpected.FEquals(&strQuery))
+	{
+		GPOS_TRACE(strQuery.Wsz());
+		eres = GPOS_FAILED;
+	}
+
+	GPOS_CHECK_ABORT;
+
+	// plan; minidumps of failed optimizations hold none
+	if (NULL != pdxlmd->PdxlnPlan())
+	{
+		pba = CDXLUtils::PbaSerializePlan(pmp, pdxlmd->PdxlnPlan(), pdxlmd->UllPlanId(), pdxlmd->UllPlanSpaceSize(), &ulLength);
+		ULLONG ullPlanId = ULLONG_MAX;
+		ULLONG ullPlanSpaceSize = ULLONG_MAX;
+		CDXLNode *pdxlnPlan = CDXLUtils::PdxlnParseBinaryPlan(pmp, pba, ulLength, &ullPlanId, &ullPlanSpaceSize);
+		GPOS_DELETE_ARRAY(pba);
+
+		CWStringDynamic strPlanExpected(pmp);
+		COstreamString osPlanExpected(&strPlanExpected);
+		CDXLUtils::SerializePlan(pmp, osPlanExpected, pdxlmd->PdxlnPlan(), pdxlmd->UllPlanId(), pdxlmd->UllPlanSpaceSize(), true /*fSerializeHeaderFooter*/, true /*fIndent*/);
+
+		CWStringDynamic strPlan(pmp);
+		COstreamString osPlan(&strPlan);
+		CDXLUtils::SerializePlan(pmp, osPlan, pdxlnPlan, ullPlanId, ullPlanSpaceSize, true /*fSerializeHeaderFooter*/, true /*fIndent*/);
+		pdxlnPlan->Release();
+
+		if (!strPlanExpected.FEquals(&strPlan))
+		{
+			GPOS_TRACE(strPlan.Wsz());
+			eres = GPOS_FAILED;
+		}
+	}
+
+	GPOS_CHECK_ABORT;
+
+	// metadata
+	pba = CDXLUtils::PbaSerializeMetadata(pmp, pdxlmd->Pdrgpmdobj(), &ulLength);
+	DrgPimdobj *pdrgpmdobj = CDXLUtils::PdrgpmdobjParseBinaryDXL(pmp, pba, ulLength);
+	GPOS_DELETE_ARRAY(pba);
+
+	CWStringDynamic strMDExpected(pmp);
+	COstreamString osMDExpected(&strMDExpected);
+	CDXLUtils::SerializeMetadata(pmp, pdxlmd->Pdrgpmdobj(), osMDExpected, true /*fSerializeHeaderFooter*/, true /*fIndent*/);
+
+	CWStringDynamic strMD(pmp);
+	COstreamString osMD(&strMD);
+	CDXLUtils::SerializeMetadata(pmp, pdrgpmdobj, osMD, true /*fSerializeHeaderFooter*/, true /*fIndent*/);
+	pdrgpmdobj->Release();
+
+	if (!strMDExpected.FEquals(&strMD))
+	{
+		GPOS_TRACE(strMD.Wsz());
+		eres = GPOS_FAILED;
+	}
+
+	GPOS_DELETE(pdxlmd);
+
+	return eres;
+}
+
 // EOF
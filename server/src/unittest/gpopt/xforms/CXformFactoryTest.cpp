@@ -13,7 +13,11 @@
 #include "gpos/memory/CAutoMemoryPool.h"
 #include "gpos/test/CUnittest.h"
 
+#include "gpopt/base/CCostContext.h"
+#include "gpopt/search/CSearchStage.h"
 #include "gpopt/xforms/xforms.h"
+#include "gpopt/xforms/CXformProfile.h"
+#include "gpopt/xforms/CXformUtility.h"
 
 #include "unittest/gpopt/xforms/CXformFactoryTest.h"
 
@@ -33,7 +37,10 @@ CXformFactoryTest::EresUnittest()
 {
 	CUnittest rgut[] =
 	{
-		GPOS_UNITTEST_FUNC(CXformFactoryTest::EresUnittest_Basic)
+		GPOS_UNITTEST_FUNC(CXformFactoryTest::EresUnittest_Basic),
+		GPOS_UNITTEST_FUNC(CXformFactoryTest::EresUnittest_PatternIndex),
+		GPOS_UNITTEST_FUNC(CXformFactoryTest::EresUnittest_Utility),
+		GPOS_UNITTEST_FUNC(CXformFactoryTest::EresUnittest_Profile)
 	};
 	
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -74,6 +81,205 @@ CXformFactoryTest::EresUnittest_Basic()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformFactoryTest::EresUnittest_PatternIndex
+//
+//	@doc:
+//		check that xforms are indexed by the operator of their pattern root
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CXformFactoryTest::EresUnittest_PatternIndex()
+{
+	CXformFactory *pxff = CXformFactory::Pxff();
+
+	// every xform must be reachable from the operator of its pattern root
+	for (ULONG ul = 0; ul < CXform::ExfSentinel; ul++)
+	{
+		CXform::EXformId exfid = (CXform::EXformId) ul;
+		COperator *popRoot = pxff->Pxf(exfid)->PexprPattern()->Pop();
+		if (!popRoot->FPattern() && !pxff->PxfsPatternRoot(popRoot->Eopid())->FBit(exfid))
+		{
+			return GPOS_FAILED;
+		}
+	}
+
+	CXformSet *pxfsInnerJoin = pxff->PxfsPatternRoot(COperator::EopLogicalInnerJoin);
+	CXformSet *pxfsGet = pxff->PxfsPatternRoot(COperator::EopLogicalGet);
+
+	if (!pxfsInnerJoin->FBit(CXform::ExfJoinCommutativity) ||
+		!pxfsInnerJoin->FBit(CXform::ExfJoinAssociativity) ||
+		pxfsInnerJoin->FBit(CXform::ExfGet2TableScan) ||
+		!pxfsGet->FBit(CXform::ExfGet2TableScan) ||
+		pxfsGet->FBit(CXform::ExfJoinCommutativity))
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformFactoryTest::EresUnittest_Utility
+//
+//	@doc:
+//		Test that join reordering xforms which never contribute to final
+//		plans are deferred to a fallback stage of a copy of the search
+//		strategy
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CXformFactoryTest::EresUnittest_Utility()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CXformUtility *pxfutil = GPOS_NEW(pmp) CXformUtility();
+	CXformProfile *pxfprof = GPOS_NEW(pmp) CXformProfile();
+
+	// both xforms fire in every optimization but never contribute to a plan
+	pxfprof->RecordTransform(CXform::ExfJoinCommutativity, 1 /*ulBindings*/, 1 /*ulResults*/, 0 /*ulTime*/);
+	pxfprof->RecordTransform(CXform::ExfGet2TableScan, 1 /*ulBindings*/, 1 /*ulResults*/, 0 /*ulTime*/);
+
+	GPOS_RESULT eres = GPOS_OK;
+	for (ULONG ul = 0; ul < GPOPT_XFORM_UTILITY_MIN_SAMPLES; ul++)
+	{
+		if (pxfutil->FLowUtility(CXformUtility::EqcSmallJoins, CXform::ExfJoinCommutativity))
+		{
+			// not enough samples yet
+			eres = GPOS_FAILED;
+		}
+		pxfutil->Update(CXformUtility::EqcSmallJoins, *pxfprof);
+	}
+
+	// only join reordering xforms are eligible, and only in the sampled class
+	if (!pxfutil->FLowUtility(CXformUtility::EqcSmallJoins, CXform::ExfJoinCommutativity) ||
+		pxfutil->FLowUtility(CXformUtility::EqcSmallJoins, CXform::ExfGet2TableScan) ||
+		pxfutil->FLowUtility(CXformUtility::EqcLargeJoins, CXform::ExfJoinCommutativity))
+	{
+		eres = GPOS_FAILED;
+	}
+
+	// the only stage of the default strategy is split into a stage without
+	// low-utility xforms, which ends the search with any plan, and the full
+	// stage as a fallback
+	DrgPss *pdrgpss = CSearchStage::PdrgpssDefault(pmp);
+	DrgPss *pdrgpssNew = pxfutil->PdrgpssDeprioritize(pmp, CXformUtility::EqcSmallJoins, pdrgpss);
+	if (2 != pdrgpssNew->UlLength() ||
+		(*pdrgpssNew)[0]->Pxfs()->FBit(CXform::ExfJoinCommutativity) ||
+		!(*pdrgpssNew)[0]->Pxfs()->FBit(CXform::ExfJoinAssociativity) ||
+		GPOPT_INFINITE_COST != (*pdrgpssNew)[0]->CostThreshold() ||
+		!(*pdrgpssNew)[1]->Pxfs()->FBit(CXform::ExfJoinCommutativity) ||
+		(*pdrgpss)[0]->CostThreshold() != (*pdrgpssNew)[1]->CostThreshold())
+	{
+		eres = GPOS_FAILED;
+	}
+	pdrgpssNew->Release();
+
+	// low-utility xforms are removed from stages followed by a stage that
+	// applies them, leaving the given stages unchanged
+	CXformSet *pxfs = GPOS_NEW(pmp) CXformSet(pmp, *(*pdrgpss)[0]->Pxfs());
+	pdrgpss->Append(GPOS_NEW(pmp) CSearchStage(pxfs));
+	pdrgpssNew = pxfutil->PdrgpssDeprioritize(pmp, CXformUtility::EqcSmallJoins, pdrgpss);
+	if (3 != pdrgpssNew->UlLength() ||
+		(*pdrgpssNew)[0]->Pxfs()->FBit(CXform::ExfJoinCommutativity) ||
+		!(*pdrgpssNew)[0]->Pxfs()->FBit(CXform::ExfJoinAssociativity) ||
+		(*pdrgpssNew)[1]->Pxfs()->FBit(CXform::ExfJoinCommutativity) ||
+		!(*pdrgpssNew)[2]->Pxfs()->FBit(CXform::ExfJoinCommutativity) ||
+		!(*pdrgpss)[0]->Pxfs()->FBit(CXform::ExfJoinCommutativity))
+	{
+		eres = GPOS_FAILED;
+	}
+	pdrgpssNew->Release();
+
+	// periodically all xforms are kept to refresh the statistics
+	const ULONG ulUpdates = GPOPT_XFORM_UTILITY_REFRESH_PERIOD - GPOPT_XFORM_UTILITY_MIN_SAMPLES % GPOPT_XFORM_UTILITY_REFRESH_PERIOD;
+	for (ULONG ul = 0; ul < ulUpdates; ul++)
+	{
+		pxfutil->Update(CXformUtility::EqcSmallJoins, *pxfprof);
+	}
+	pdrgpssNew = pxfutil->PdrgpssDeprioritize(pmp, CXformUtility::EqcSmallJoins, pdrgpss);
+	if (pdrgpss->UlLength() != pdrgpssNew->UlLength() ||
+		!(*pdrgpssNew)[0]->Pxfs()->FBit(CXform::ExfJoinCommutativity))
+	{
+		eres = GPOS_FAILED;
+	}
+	pdrgpssNew->Release();
+	pdrgpss->Release();
+
+	GPOS_DELETE(pxfprof);
+	GPOS_DELETE(pxfutil);
+
+	return eres;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformFactoryTest::EresUnittest_Profile
+//
+//	@doc:
+//		Test that xform profile counters are recorded and merged without
+//		truncation
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CXformFactoryTest::EresUnittest_Profile()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// counts beyond the range of a signed 32-bit integer
+	const ULONG ulBindings = 3000000000u;
+	const ULLONG ullBindings = (ULLONG) ulBindings;
+
+	CXformProfile *pxfprof = GPOS_NEW(pmp) CXformProfile();
+	pxfprof->RecordTransform(CXform::ExfJoinCommutativity, ulBindings, 0 /*ulResults*/, 0 /*ulTime*/);
+	pxfprof->RecordTransform(CXform::ExfJoinCommutativity, ulBindings, 1 /*ulResults*/, 0 /*ulTime*/);
+	pxfprof->RecordTransform(CXform::ExfGet2TableScan, 1 /*ulBindings*/, 1 /*ulResults*/, 0 /*ulTime*/);
+
+	GPOS_RESULT eres = GPOS_OK;
+	if (2 != pxfprof->UllAttempts(CXform::ExfJoinCommutativity) ||
+		1 != pxfprof->UllCalls(CXform::ExfJoinCommutativity) ||
+		2 * ullBindings != pxfprof->UllBindings(CXform::ExfJoinCommutativity) ||
+		1 != pxfprof->UllAttempts(CXform::ExfGet2TableScan) ||
+		0 != pxfprof->UllAttempts(CXform::ExfJoinAssociativity))
+	{
+		eres = GPOS_FAILED;
+	}
+
+	// merging adds up counters of both profiles
+	CXformProfile *pxfprofMerged = GPOS_NEW(pmp) CXformProfile();
+	pxfprofMerged->RecordTransform(CXform::ExfJoinCommutativity, ulBindings, 1 /*ulResults*/, 0 /*ulTime*/);
+	pxfprofMerged->Merge(*pxfprof);
+	pxfprofMerged->Merge(*pxfprof);
+
+	if (5 != pxfprofMerged->UllAttempts(CXform::ExfJoinCommutativity) ||
+		3 != pxfprofMerged->UllCalls(CXform::ExfJoinCommutativity) ||
+		5 * ullBindings != pxfprofMerged->UllBindings(CXform::ExfJoinCommutativity) ||
+		2 != pxfprofMerged->UllAttempts(CXform::ExfGet2TableScan) ||
+		2 * ullBindings != pxfprof->UllBindings(CXform::ExfJoinCommutativity))
+	{
+		eres = GPOS_FAILED;
+	}
+
+	// reset clears all counters
+	pxfprofMerged->Reset();
+	if (0 != pxfprofMerged->UllAttempts(CXform::ExfJoinCommutativity) ||
+		0 != pxfprofMerged->UllBindings(CXform::ExfJoinCommutativity))
+	{
+		eres = GPOS_FAILED;
+	}
+
+	GPOS_DELETE(pxfprofMerged);
+	GPOS_DELETE(pxfprof);
+
+	return eres;
+}
+
 
 // EOF
 